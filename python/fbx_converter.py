@@ -2,8 +2,8 @@
 ForgePipeline FBX Converter
 
 Converts GLB meshes to FBX format for Unreal Engine import.
-Primary backend: pyassimp (Open Asset Import Library).
-Fallback backend: Blender CLI subprocess.
+Primary backend: native bf-convert binary (src/tools/bf-convert.cpp).
+Fallback backends: pyassimp (Open Asset Import Library), Blender CLI subprocess.
 """
 
 import os
@@ -30,16 +30,22 @@ def _cfg(section, key, default=None):
 
 
 class FbxConverter:
-    """Converts GLB meshes to FBX format using assimp (primary) or Blender (fallback)."""
+    """Converts GLB meshes to FBX format using bf-convert (primary), assimp or Blender (fallbacks)."""
 
     def __init__(self):
         self.backend = 'none'
         self.blender_path = None
+        self.native_path = None
         self._detect_backend()
 
     def _detect_backend(self):
         """Detect available conversion backend."""
-        preferred = _cfg('fbx_export', 'preferred_backend', 'assimp')
+        preferred = _cfg('fbx_export', 'preferred_backend', 'native')
+
+        # Try the native converter first (or if preferred)
+        if preferred == 'native' or preferred == 'auto':
+            if self._detect_native():
+                return
 
         # Try assimp first (or if preferred)
         if preferred == 'assimp' or preferred == 'auto':
@@ -76,9 +82,24 @@ class FbxConverter:
             except ImportError:
                 pass
 
-        logger.warning('[FBX] No FBX conversion backend available. Install pyassimp or Blender.')
+        # Native converter as last resort if another backend was preferred but not found
+        if preferred in ('assimp', 'blender') and self._detect_native():
+            return
+
+        logger.warning('[FBX] No FBX conversion backend available. Build bf-convert or install pyassimp or Blender.')
         self.backend = 'none'
 
+    def _detect_native(self):
+        """Find the bf-convert binary (configured path, then PATH)."""
+        configured_path = _cfg('fbx_export', 'native_path', None)
+        native_path = configured_path if configured_path and Path(configured_path).exists() else shutil.which('bf-convert')
+        if not native_path:
+            return False
+        self.native_path = native_path
+        self.backend = 'native'
+        logger.info(f'[FBX] Backend: native bf-convert at {self.native_path}')
+        return True
+
     def is_available(self):
         """Check if any conversion backend is available."""
         enabled = _cfg('fbx_export', 'enabled', True)
@@ -120,7 +141,9 @@ class FbxConverter:
         start = time.time()
 
         try:
-            if self.backend == 'assimp':
+            if self.backend == 'native':
+                result = self._convert_via_native(str(glb_path), str(fbx_path))
+            elif self.backend == 'assimp':
                 result = self._convert_via_assimp(str(glb_path), str(fbx_path))
             elif self.backend == 'blender':
                 result = self._convert_via_blender(str(glb_path), str(fbx_path))
@@ -233,6 +256,39 @@ class FbxConverter:
 
         return result
 
+    def _convert_via_native(self, glb_path, fbx_path):
+        """Primary: Use the bf-convert binary (binary FBX 7.4, Y-up declared for the importer)."""
+        result = {
+            'success': False,
+            'fbx_path': fbx_path,
+            'backend': 'native',
+            'error': None,
+        }
+
+        coord_system = _cfg('fbx_export', 'coordinate_system', 'unreal')
+        scale = _cfg('fbx_export', 'scale_factor', 100.0) if coord_system == 'unreal' else 1.0
+
+        try:
+            proc = subprocess.run(
+                [self.native_path, glb_path, fbx_path, '--scale', str(scale)],
+                capture_output=True,
+                text=True,
+                timeout=120,
+            )
+
+            if proc.returncode == 0 and Path(fbx_path).exists():
+                result['success'] = True
+            else:
+                stderr = proc.stderr[:500] if proc.stderr else 'No error output'
+                result['error'] = f'bf-convert exited with code {proc.returncode}: {stderr}'
+
+        except subprocess.TimeoutExpired:
+            result['error'] = 'bf-convert conversion timed out (120s)'
+        except FileNotFoundError:
+            result['error'] = f'bf-convert not found at: {self.native_path}'
+
+        return result
+
     def _convert_via_blender(self, glb_path, fbx_path):
         """Fallback: Use Blender CLI subprocess for conversion."""
         result = {
@@ -312,6 +368,9 @@ sys.exit(0)
         if self.backend == 'blender':
             status['blender_path'] = self.blender_path
 
+        if self.backend == 'native':
+            status['native_path'] = self.native_path
+
         if self.backend == 'assimp':
             try:
                 import pyassimp
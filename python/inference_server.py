@@ -535,12 +535,14 @@ async def extract_materials(
         # Split ORM channels if requested
         split_results = []
         if split_channels and extraction['textures']:
-            for tex_path in extraction['textures']:
-                # Look for metallicRoughness textures (packed ORM)
-                if 'metallicRoughness' in tex_path or 'metallic' in tex_path.lower():
-                    split_result = material_extractor.split_orm_texture(tex_path, str(texture_dir))
-                    if split_result['success']:
-                        split_results.append(split_result)
+            # Look for metallicRoughness textures (packed ORM); split them in one batch
+            orm_paths = [
+                tex_path for tex_path in extraction['textures']
+                if 'metallicRoughness' in tex_path or 'metallic' in tex_path.lower()
+            ]
+            for split_result in material_extractor.split_orm_textures(orm_paths, str(texture_dir)):
+                if split_result['success']:
+                    split_results.append(split_result)
 
         # Generate UE5 manifest
         manifest_result = material_extractor.generate_ue5_manifest(str(temp_glb), preset)
@@ -2,12 +2,15 @@
 ForgePipeline Material Extractor
 
 Extracts PBR textures from GLB files and generates UE5 material manifests.
-Uses pygltflib for GLB parsing and Pillow for texture channel splitting.
+Uses pygltflib for GLB parsing, and the native bf-texture tool (or Pillow when it is
+not installed) for texture channel splitting.
 """
 
 import os
 import json
+import shutil
 import logging
+import subprocess
 import yaml
 from pathlib import Path
 
@@ -26,6 +29,14 @@ def _cfg(section, key, default=None):
     return CONFIG.get(section, {}).get(key, default)
 
 
+def _native_texture_tool():
+    """Find the bf-texture binary (configured path, then PATH)."""
+    configured_path = _cfg('texture_ops', 'native_path', None)
+    if configured_path and Path(configured_path).exists():
+        return configured_path
+    return shutil.which('bf-texture')
+
+
 class MaterialExtractor:
     """Extracts PBR materials and textures from GLB files for UE5 import."""
 
@@ -48,7 +59,7 @@ class MaterialExtractor:
             self._pillow_available = True
             logger.info('[MATERIAL] Pillow available')
         except ImportError:
-            logger.warning('[MATERIAL] Pillow not installed. Channel splitting disabled.')
+            logger.warning('[MATERIAL] Pillow not installed. Channel splitting needs bf-texture.')
 
     def is_available(self):
         """Check if pygltflib is installed and material extraction is possible."""
@@ -206,6 +217,82 @@ class MaterialExtractor:
         Returns:
             dict with keys: success, ao_path, roughness_path, metallic_path, error
         """
+        return self.split_orm_textures([orm_path], output_dir)[0]
+
+    def split_orm_textures(self, orm_paths, output_dir):
+        """Split several packed ORM textures into <stem>_ao/_roughness/_metallic PNGs.
+
+        PNG inputs go to bf-texture in one call, which splits them concurrently;
+        anything it cannot handle (JPEG sources, a missing binary) goes through Pillow.
+
+        Args:
+            orm_paths: Paths to packed ORM textures
+            output_dir: Directory to write split channels
+
+        Returns:
+            list of split_orm_texture() result dicts, in input order
+        """
+        orm_paths = [Path(p) for p in orm_paths]
+        output_dir = Path(output_dir)
+        results = [None] * len(orm_paths)
+
+        binary = _native_texture_tool()
+        native_inputs = [p for p in orm_paths if p.suffix.lower() == '.png' and p.exists()]
+        if binary and native_inputs:
+            reports = self._split_native(binary, native_inputs, output_dir)
+            for i, path in enumerate(orm_paths):
+                report = reports.get(str(path))
+                if report is None:
+                    continue
+                if 'error' in report:
+                    logger.warning(f'[MATERIAL] bf-texture could not split {path.name}: {report["error"]}')
+                    continue
+                outputs = report['outputs']
+                results[i] = {
+                    'success': True,
+                    'ao_path': outputs['ao'],
+                    'roughness_path': outputs['roughness'],
+                    'metallic_path': outputs['metallic'],
+                    'error': None,
+                    'backend': 'native',
+                }
+                logger.info(f'[MATERIAL] Split ORM texture (native): {path.name} -> ao, roughness, metallic')
+
+        for i, path in enumerate(orm_paths):
+            if results[i] is None:
+                results[i] = self._split_orm_pillow(path, output_dir)
+        return results
+
+    def _split_native(self, binary, orm_paths, output_dir):
+        """Run bf-texture split over orm_paths. Returns {input path: JSON report}."""
+        output_dir.mkdir(parents=True, exist_ok=True)
+        command = [binary, 'split', *[str(p) for p in orm_paths], '-o', str(output_dir),
+                   '--level', str(_cfg('texture_ops', 'compression', 'fast'))]
+        try:
+            proc = subprocess.run(
+                command,
+                capture_output=True,
+                text=True,
+                timeout=_cfg('texture_ops', 'timeout_seconds', 120),
+            )
+        except (subprocess.TimeoutExpired, OSError) as e:
+            logger.warning(f'[MATERIAL] bf-texture failed ({e}), falling back to Pillow')
+            return {}
+
+        # Exit code 1 means some inputs failed; their reports still carry the error
+        reports = {}
+        for line in proc.stdout.splitlines():
+            try:
+                report = json.loads(line)
+            except ValueError:
+                continue
+            reports[report.get('input')] = report
+        if not reports:
+            logger.warning(f'[MATERIAL] bf-texture exited with code {proc.returncode}: {proc.stderr[:500]}')
+        return reports
+
+    def _split_orm_pillow(self, orm_path, output_dir):
+        """Split one ORM texture with Pillow (same result dict as split_orm_texture)."""
         result = {
             'success': False,
             'ao_path': None,
@@ -372,6 +459,7 @@ class MaterialExtractor:
             'available': self.is_available(),
             'pygltflib_installed': self._pygltflib_available,
             'pillow_installed': self._pillow_available,
+            'native_texture_tool': _native_texture_tool(),
             'presets': self.get_material_presets(),
         }
 
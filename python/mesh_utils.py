@@ -5,7 +5,10 @@ Basic mesh validation and info extraction for generated GLB files.
 """
 
 import os
+import json
+import shutil
 import logging
+import subprocess
 import yaml
 from pathlib import Path
 
@@ -24,9 +27,40 @@ def _cfg(section, key, default=None):
     return CONFIG.get(section, {}).get(key, default)
 
 
+def _native_validator():
+    """Find the bf-validate binary (configured path, then PATH)."""
+    configured_path = _cfg('validation', 'native_path', None)
+    if configured_path and Path(configured_path).exists():
+        return configured_path
+    return shutil.which('bf-validate')
+
+
+def _validate_native(binary, file_path, min_size):
+    """Run bf-validate on one file. Returns its report, or None if it did not produce one."""
+    texture_size = _cfg('texture_generation', 'default_resolution', 1024)
+    try:
+        proc = subprocess.run(
+            [binary, str(file_path), '--min-bytes', str(max(min_size, 1)), '--texture-size', str(texture_size)],
+            capture_output=True,
+            text=True,
+            timeout=60,
+        )
+        # Exit code 1 means the mesh is invalid; the report is still on stdout
+        if proc.returncode in (0, 1) and proc.stdout.strip():
+            return json.loads(proc.stdout.splitlines()[0])
+        logger.warning(f'[MESH] bf-validate exited with code {proc.returncode}: {proc.stderr[:500]}')
+    except (subprocess.TimeoutExpired, OSError, ValueError) as e:
+        logger.warning(f'[MESH] bf-validate failed ({e}), falling back to trimesh')
+    return None
+
+
 def validate_mesh(file_path):
     """Validate a generated mesh file.
 
+    Uses the native bf-validate binary when available (adds degenerate/non-manifold
+    edge counts, watertightness, UV range, overlap and texel density to the report),
+    otherwise trimesh.
+
     Args:
         file_path: Path to .glb or .gltf file.
 
@@ -56,6 +90,21 @@ def validate_mesh(file_path):
         result['errors'].append(f'File too small ({result["file_size_bytes"]} bytes)')
         return result
 
+    binary = _native_validator()
+    report = _validate_native(binary, file_path, min_size) if binary else None
+    if report is not None:
+        if not report['watertight']:
+            # Not an error for AI-generated meshes, just a note
+            logger.info(f'[MESH] Mesh is not watertight (normal for AI-generated)')
+        logger.info(
+            f'[MESH] Validated (native): {report["vertex_count"]} verts, '
+            f'{report["face_count"]} faces, '
+            f'{report["file_size_bytes"]} bytes, '
+            f'valid={report["valid"]}'
+        )
+        report['backend'] = 'native'
+        return report
+
     try:
         import trimesh
 
@@ -0,0 +1,593 @@
+// AssetCooker.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Content-addressed, incremental asset build cache with parallel batch cooking
+
+#pragma once
+
+#include "JobSystem.h"
+#include "Checksum.h"
+#include "QuoteSystem.h"
+#include "DebugWindow.h"
+#include "TestManagerNew.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+// Bump when the store layout or key derivation changes so old entries are ignored
+constexpr uint32_t COOK_STORE_VERSION = 2;
+constexpr const char* COOK_DEFAULT_STORE_DIR = "Cache/Cooked";
+
+// Read size when hashing or loading source files
+constexpr size_t COOK_READ_CHUNK = 64 * 1024;
+
+using CookBlob = std::vector<uint8_t>;
+
+// What a step sees. Outputs must depend only on `data`, `params` and the step version;
+// `sourcePath` is there for loaders that need a path (first stage only, empty after).
+struct CookInput {
+    const std::string& sourcePath;
+    const CookBlob& data;
+    const std::string& params;
+};
+
+// A transform step: fill `output` or return false with `error` set
+using CookFunction = std::function<bool(const CookInput& input, CookBlob& output, std::string& error)>;
+
+// One stage of a pipeline: a registered step name plus its parameter string
+struct CookStage {
+    std::string step;
+    std::string params;
+};
+
+struct CookRequest {
+    std::string sourcePath;
+    std::vector<CookStage> pipeline;
+};
+
+struct CookResult {
+    bool success = false;
+    uint64_t hash = 0;                    // Content hash of the final output
+    std::shared_ptr<const CookBlob> data; // Final output (null on failure)
+    size_t stepsRun = 0;                  // Stages executed; 0 means a pure cache lookup
+    std::string error;
+};
+
+struct CookStats {
+    size_t cooks = 0;
+    size_t stepsRun = 0;
+    size_t stepsCached = 0;
+    size_t bytesWritten = 0;
+};
+
+// AssetCooker runs pipelines of pure steps over source files with two on-disk tables:
+// - objects/: blobs named by the hash of their contents
+// - actions/: hash(step, step version, params, input hash) -> output hash
+// Cook() hashes the source, then walks the action table stage by stage. A fully
+// cached pipeline loads only the final blob; on the first miss it loads that stage's
+// input from the store and runs the remaining stages, recording each result. Changing
+// one stage's params therefore re-runs that stage and the ones after it, and a stage
+// whose output is unchanged lets the rest of the chain hit again.
+// CookAll() spreads independent requests over the JobSystem.
+class AssetCooker {
+public:
+    explicit AssetCooker(const std::string& storeDir = COOK_DEFAULT_STORE_DIR)
+        : mStoreDir(storeDir)
+        , mTempCounter(0)
+    {
+        DebugWindow::Instance().RegisterChannel("Cooker");
+    }
+
+    // Register (or replace) a step. Bump `version` whenever the step's output changes
+    // for the same input, otherwise stale results keep being served.
+    void RegisterStep(const std::string& name, uint32_t version, CookFunction function) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSteps[name] = Step{ version, std::move(function) };
+    }
+
+    bool HasStep(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mSteps.count(name) != 0;
+    }
+
+    CookResult Cook(const std::string& sourcePath, const std::vector<CookStage>& pipeline) {
+        CookResult result;
+        mCooks.fetch_add(1, std::memory_order_relaxed);
+
+        // Guard: nothing to run
+        if (pipeline.empty()) {
+            result.error = "empty pipeline";
+            return result;
+        }
+
+        std::vector<Step> steps;
+        steps.reserve(pipeline.size());
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (const CookStage& stage : pipeline) {
+                auto it = mSteps.find(stage.step);
+                if (it == mSteps.end()) {
+                    result.error = "unknown step '" + stage.step + "'";
+                    return result;
+                }
+                steps.push_back(it->second);
+            }
+        }
+
+        uint64_t sourceHash = 0;
+        if (!HashSourceFile(sourcePath, sourceHash)) {
+            result.error = "cannot read " + sourcePath;
+            return result;
+        }
+
+        // Follow recorded actions as far as they go
+        std::vector<uint64_t> inputHashes(pipeline.size() + 1, 0);
+        inputHashes[0] = sourceHash;
+        size_t firstMiss = pipeline.size();
+        for (size_t i = 0; i < pipeline.size(); ++i) {
+            if (!LookupAction(ActionKey(pipeline[i], steps[i].version, inputHashes[i]), inputHashes[i + 1])) {
+                firstMiss = i;
+                break;
+            }
+        }
+
+        auto blob = std::make_shared<CookBlob>();
+        bool loaded = firstMiss == pipeline.size()
+            ? ReadObject(inputHashes[firstMiss], *blob)
+            : (firstMiss == 0 ? ReadSourceFile(sourcePath, *blob) : ReadObject(inputHashes[firstMiss], *blob));
+
+        // A recorded object went missing or is damaged: rebuild the whole chain
+        if (!loaded && firstMiss != 0) {
+            DebugWindow::Instance().Post("Cooker", "Store entry missing, re-cooking " + sourcePath,
+                DebugWindow::DebugLevel::WARN);
+            firstMiss = 0;
+            loaded = ReadSourceFile(sourcePath, *blob);
+        }
+        if (!loaded) {
+            result.error = "cannot read " + sourcePath;
+            return result;
+        }
+        mStepsCached.fetch_add(firstMiss, std::memory_order_relaxed);
+
+        const std::string noPath;
+        for (size_t i = firstMiss; i < pipeline.size(); ++i) {
+            auto output = std::make_shared<CookBlob>();
+            std::string error;
+            CookInput input{ i == 0 ? sourcePath : noPath, *blob, pipeline[i].params };
+            if (!steps[i].function(input, *output, error)) {
+                result.error = pipeline[i].step + ": " + error;
+                QuoteSystem::Instance().Log("AssetCooker: " + sourcePath + " - " + result.error,
+                    QuoteSystem::MessageType::ERROR_MSG);
+                return result;
+            }
+
+            inputHashes[i + 1] = HashBytes(output->data(), output->size());
+            if (!WriteObject(inputHashes[i + 1], *output)) {
+                QuoteSystem::Instance().Log("AssetCooker: could not write to " + mStoreDir,
+                    QuoteSystem::MessageType::WARNING);
+            }
+            RecordAction(ActionKey(pipeline[i], steps[i].version, inputHashes[i]), inputHashes[i + 1]);
+            blob = std::move(output);
+            ++result.stepsRun;
+        }
+        mStepsRun.fetch_add(result.stepsRun, std::memory_order_relaxed);
+
+        if (result.stepsRun > 0) {
+            DebugWindow::Instance().Post("Cooker", "Cooked " + sourcePath + " (" + std::to_string(result.stepsRun) +
+                " of " + std::to_string(pipeline.size()) + " steps run)", DebugWindow::DebugLevel::INFO);
+        }
+        result.success = true;
+        result.hash = inputHashes[pipeline.size()];
+        result.data = std::move(blob);
+        return result;
+    }
+
+    // Cook independent requests in parallel; results line up with `requests`
+    std::vector<CookResult> CookAll(const std::vector<CookRequest>& requests, JobSystem& jobs = JobSystem::Instance()) {
+        std::vector<CookResult> results(requests.size());
+        jobs.ParallelFor(requests.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = Cook(requests[i].sourcePath, requests[i].pipeline);
+            }
+        });
+        return results;
+    }
+
+    CookStats GetStats() const {
+        CookStats stats;
+        stats.cooks = mCooks.load(std::memory_order_relaxed);
+        stats.stepsRun = mStepsRun.load(std::memory_order_relaxed);
+        stats.stepsCached = mStepsCached.load(std::memory_order_relaxed);
+        stats.bytesWritten = mBytesWritten.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    const std::string& GetStoreDir() const { return mStoreDir; }
+
+    // Forget in-memory lookups (the on-disk store is untouched)
+    void ClearMemory() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mActions.clear();
+        mSourceHashes.clear();
+    }
+
+    // Content hash of a blob (XXH3-64); use Xxh3 directly to hash in pieces
+    static uint64_t HashBytes(const uint8_t* data, size_t size) {
+        return Xxh3::Hash64(data, size);
+    }
+
+    // Cache hits, downstream-only recompute and parallel batches
+    static void RegisterTests();
+
+    // Prevent copy/move
+    AssetCooker(const AssetCooker&) = delete;
+    AssetCooker& operator=(const AssetCooker&) = delete;
+    AssetCooker(AssetCooker&&) = delete;
+    AssetCooker& operator=(AssetCooker&&) = delete;
+
+private:
+    struct Step {
+        uint32_t version = 0;
+        CookFunction function;
+    };
+
+    // Source hashes are memoized per path on (size, mtime) so re-imports in one session
+    // skip the read; any edit changes one of the two and forces a re-hash
+    struct SourceStamp {
+        uintmax_t size = 0;
+        std::filesystem::file_time_type modified;
+        uint64_t hash = 0;
+    };
+
+    struct RecordHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t hash;
+        uint64_t size;
+    };
+
+    static RecordHeader MakeHeader(const char* magic, uint64_t hash, uint64_t size) {
+        RecordHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, magic, 8);
+        header.version = COOK_STORE_VERSION;
+        header.hash = hash;
+        header.size = size;
+        return header;
+    }
+
+    static uint64_t ActionKey(const CookStage& stage, uint32_t stepVersion, uint64_t inputHash) {
+        uint32_t versions[2] = { COOK_STORE_VERSION, stepVersion };
+        Xxh3 key;
+        key.Update(stage.step.data(), stage.step.size());
+        key.Update(versions, sizeof(versions));
+        key.Update(&inputHash, sizeof(inputHash));
+        // Length prefix keeps ("ab", "c") and ("a", "bc") apart
+        uint64_t paramsSize = stage.params.size();
+        key.Update(&paramsSize, sizeof(paramsSize));
+        key.Update(stage.params.data(), stage.params.size());
+        return key.Finish();
+    }
+
+    // <store>/<table>/<first byte>/<hash>.<extension>
+    std::string StorePath(const char* table, uint64_t hash, const char* extension) const {
+        char directory[4];
+        char name[32];
+        std::snprintf(directory, sizeof(directory), "%02x", static_cast<unsigned>(hash >> 56));
+        std::snprintf(name, sizeof(name), "%016llx.%s", static_cast<unsigned long long>(hash), extension);
+        return (std::filesystem::path(mStoreDir) / table / directory / name).string();
+    }
+
+    bool HashSourceFile(const std::string& path, uint64_t& outHash) {
+        std::error_code ec;
+        uintmax_t size = std::filesystem::file_size(path, ec);
+        if (ec) {
+            return false;
+        }
+        std::filesystem::file_time_type modified = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto it = mSourceHashes.find(path);
+            if (it != mSourceHashes.end() && it->second.size == size && it->second.modified == modified) {
+                outHash = it->second.hash;
+                return true;
+            }
+        }
+
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        std::vector<char> chunk(COOK_READ_CHUNK);
+        Xxh3 running;
+        while (in) {
+            in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            running.Update(chunk.data(), static_cast<size_t>(in.gcount()));
+        }
+        uint64_t hash = running.Finish();
+        if (in.bad()) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSourceHashes[path] = SourceStamp{ size, modified, hash };
+        outHash = hash;
+        return true;
+    }
+
+    static bool ReadSourceFile(const std::string& path, CookBlob& out) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            return false;
+        }
+        std::streamoff size = in.tellg();
+        if (size < 0) {
+            return false;
+        }
+        out.resize(static_cast<size_t>(size));
+        in.seekg(0);
+        return out.empty() || static_cast<bool>(in.read(reinterpret_cast<char*>(out.data()), size));
+    }
+
+    bool LookupAction(uint64_t key, uint64_t& outHash) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto it = mActions.find(key);
+            if (it != mActions.end()) {
+                outHash = it->second;
+                return true;
+            }
+        }
+
+        std::ifstream in(StorePath("actions", key, "act"), std::ios::binary);
+        RecordHeader header;
+        RecordHeader expected = MakeHeader("BFACT\0\0\0", key, 0);
+        if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+            header.version != expected.version || header.hash != key ||
+            !in.read(reinterpret_cast<char*>(&outHash), sizeof(outHash))) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mActions[key] = outHash;
+        return true;
+    }
+
+    void RecordAction(uint64_t key, uint64_t outputHash) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mActions[key] = outputHash;
+        }
+        RecordHeader header = MakeHeader("BFACT\0\0\0", key, 0);
+        WriteRecord(StorePath("actions", key, "act"), header, reinterpret_cast<const uint8_t*>(&outputHash),
+                    sizeof(outputHash));
+    }
+
+    bool ReadObject(uint64_t hash, CookBlob& out) const {
+        std::ifstream in(StorePath("objects", hash, "obj"), std::ios::binary);
+        RecordHeader header;
+        RecordHeader expected = MakeHeader("BFCOOK\0\0", hash, 0);
+        if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+            header.version != expected.version || header.hash != hash) {
+            return false;
+        }
+
+        out.resize(static_cast<size_t>(header.size));
+        if (!out.empty() && !in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()))) {
+            return false;
+        }
+        // Anything after the payload means the file is not what the header claims
+        return in.peek() == std::char_traits<char>::eof();
+    }
+
+    bool WriteObject(uint64_t hash, const CookBlob& data) {
+        // Content-addressed: an existing object already holds these bytes
+        std::error_code ec;
+        std::string path = StorePath("objects", hash, "obj");
+        if (std::filesystem::exists(path, ec)) {
+            return true;
+        }
+        RecordHeader header = MakeHeader("BFCOOK\0\0", hash, data.size());
+        if (!WriteRecord(path, header, data.data(), data.size())) {
+            return false;
+        }
+        mBytesWritten.fetch_add(sizeof(header) + data.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    // Write-then-rename so readers never see a partial record. The temporary name is
+    // unique per writer, so threads cooking the same key cannot interleave bytes.
+    bool WriteRecord(const std::string& path, const RecordHeader& header, const uint8_t* payload, size_t size) {
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+        std::string temporary = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) +
+                                "." + std::to_string(mTempCounter.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                return false;
+            }
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(payload), static_cast<std::streamsize>(size));
+            if (!out) {
+                out.close();
+                std::filesystem::remove(temporary, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary, path, ec);
+        if (ec) {
+            std::filesystem::remove(temporary, ec);
+            return false;
+        }
+        return true;
+    }
+
+    std::string mStoreDir;
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, Step> mSteps;
+    std::unordered_map<uint64_t, uint64_t> mActions;
+    std::unordered_map<std::string, SourceStamp> mSourceHashes;
+    std::atomic<uint64_t> mTempCounter;
+    std::atomic<size_t> mCooks{0};
+    std::atomic<size_t> mStepsRun{0};
+    std::atomic<size_t> mStepsCached{0};
+    std::atomic<size_t> mBytesWritten{0};
+};
+
+inline void AssetCooker::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("AssetCooker");
+
+    // Scratch store plus a source file; removed again by the caller
+    struct Scratch {
+        std::filesystem::path dir;
+
+        explicit Scratch(const char* name) {
+            std::error_code ec;
+            dir = std::filesystem::temp_directory_path(ec) / name;
+            std::filesystem::remove_all(dir, ec);
+            std::filesystem::create_directories(dir, ec);
+        }
+
+        ~Scratch() {
+            std::error_code ec;
+            std::filesystem::remove_all(dir, ec);
+        }
+
+        std::string Write(const std::string& name, const std::string& contents) const {
+            std::string path = (dir / name).string();
+            std::ofstream(path, std::ios::binary | std::ios::trunc) << contents;
+            return path;
+        }
+    };
+
+    // "append" adds its params to the input; counts how often it really ran
+    auto registerAppend = [](AssetCooker& cooker, const std::string& name, std::atomic<size_t>& runs) {
+        cooker.RegisterStep(name, 1, [&runs](const CookInput& input, CookBlob& output, std::string&) {
+            runs.fetch_add(1);
+            output = input.data;
+            output.insert(output.end(), input.params.begin(), input.params.end());
+            return true;
+        });
+    };
+    auto asString = [](const CookResult& result) {
+        return result.data ? std::string(result.data->begin(), result.data->end()) : std::string();
+    };
+
+    tests.AddTest("AssetCooker", "Unchanged source is a cache lookup, across instances", [=]() {
+        Scratch scratch("brightforge_cook_lookup");
+        std::string source = scratch.Write("a.txt", "mesh");
+        std::string store = (scratch.dir / "store").string();
+        std::vector<CookStage> pipeline = { { "decode", "+d" }, { "optimize", "+o" } };
+
+        std::atomic<size_t> runs(0);
+        AssetCooker first(store);
+        registerAppend(first, "decode", runs);
+        registerAppend(first, "optimize", runs);
+        CookResult cold = first.Cook(source, pipeline);
+        CookResult warm = first.Cook(source, pipeline);
+        bool ok = cold.success && asString(cold) == "mesh+d+o" && cold.stepsRun == 2 &&
+                  warm.success && warm.stepsRun == 0 && warm.hash == cold.hash && runs == 2;
+
+        // A fresh cooker (new session) finds everything on disk
+        AssetCooker second(store);
+        registerAppend(second, "decode", runs);
+        registerAppend(second, "optimize", runs);
+        CookResult reloaded = second.Cook(source, pipeline);
+        ok = ok && reloaded.success && reloaded.stepsRun == 0 && asString(reloaded) == "mesh+d+o";
+
+        // New source bytes miss
+        source = scratch.Write("a.txt", "mesh v2");
+        CookResult edited = second.Cook(source, pipeline);
+        return ok && edited.stepsRun == 2 && asString(edited) == "mesh v2+d+o";
+    });
+
+    tests.AddTest("AssetCooker", "Parameter change recomputes only downstream steps", [=]() {
+        Scratch scratch("brightforge_cook_params");
+        std::string source = scratch.Write("a.txt", "x");
+        std::atomic<size_t> decodeRuns(0);
+        std::atomic<size_t> lodRuns(0);
+        std::atomic<size_t> compressRuns(0);
+        AssetCooker cooker((scratch.dir / "store").string());
+        registerAppend(cooker, "decode", decodeRuns);
+        registerAppend(cooker, "lod", lodRuns);
+        registerAppend(cooker, "compress", compressRuns);
+
+        CookResult base = cooker.Cook(source, { { "decode", "" }, { "lod", "1" }, { "compress", "" } });
+        CookResult lod2 = cooker.Cook(source, { { "decode", "" }, { "lod", "2" }, { "compress", "" } });
+        bool ok = base.success && lod2.success && lod2.stepsRun == 2 && asString(lod2) == "x2" &&
+                  decodeRuns == 1 && lodRuns == 2 && compressRuns == 2;
+
+        // Same final bytes as before: back to a full lookup
+        CookResult again = cooker.Cook(source, { { "decode", "" }, { "lod", "1" }, { "compress", "" } });
+        ok = ok && again.stepsRun == 0 && again.hash == base.hash;
+
+        // Bumping a step version invalidates that step and everything after it
+        cooker.RegisterStep("lod", 2, [&lodRuns](const CookInput& input, CookBlob& output, std::string&) {
+            lodRuns.fetch_add(1);
+            output = input.data;
+            return true;
+        });
+        CookResult bumped = cooker.Cook(source, { { "decode", "" }, { "lod", "1" }, { "compress", "" } });
+        return ok && bumped.stepsRun == 2 && asString(bumped) == "x" && decodeRuns == 1;
+    });
+
+    tests.AddTest("AssetCooker", "Batch cooks independent assets in parallel", [=]() {
+        Scratch scratch("brightforge_cook_batch");
+        std::atomic<size_t> runs(0);
+        AssetCooker cooker((scratch.dir / "store").string());
+        registerAppend(cooker, "decode", runs);
+        cooker.RegisterStep("fail", 1, [](const CookInput&, CookBlob&, std::string& error) {
+            error = "always";
+            return false;
+        });
+
+        std::vector<CookRequest> requests;
+        for (int i = 0; i < 16; ++i) {
+            requests.push_back({ scratch.Write("asset" + std::to_string(i), std::to_string(i)), { { "decode", "!" } } });
+        }
+        requests.push_back({ scratch.Write("bad", "?"), { { "fail", "" } } });
+        requests.push_back({ (scratch.dir / "missing").string(), { { "decode", "" } } });
+
+        JobSystem jobs(3);
+        std::vector<CookResult> results = cooker.CookAll(requests, jobs);
+        bool ok = results.size() == requests.size() && runs == 16;
+        for (int i = 0; i < 16 && ok; ++i) {
+            ok = results[i].success && asString(results[i]) == std::to_string(i) + "!";
+        }
+        ok = ok && !results[16].success && !results[17].success;
+
+        std::vector<CookResult> warm = cooker.CookAll(requests, jobs);
+        for (int i = 0; i < 16 && ok; ++i) {
+            ok = warm[i].success && warm[i].stepsRun == 0;
+        }
+        return ok && runs == 16;
+    });
+}
+
+// Note on usage:
+// Register steps once (name, version, pure function), then Cook(path, pipeline) or
+// CookAll(requests). SoftwareRenderService cooks meshes through "mesh.import" and
+// "mesh.cluster" (MeshCook.h). The store is safe to delete at any time; it only costs
+// a re-cook.
@@ -0,0 +1,643 @@
+// Checksum.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Streaming CRC32C (SSE4.2 / ARMv8 CRC with a slice-by-8 fallback) and XXH3-64 content hashing
+
+#pragma once
+
+#include "TestManagerNew.h"
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <nmmintrin.h>
+    #define BRIGHTFORGE_CHECKSUM_X86 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define BRIGHTFORGE_CHECKSUM_SSE2 1
+#endif
+#if defined(__ARM_FEATURE_CRC32)
+    #include <arm_acle.h>
+#endif
+
+// GCC/Clang compile the SSE4.2 path for that target only and pick it at runtime,
+// so the engine does not need -msse4.2 to get hardware CRC32C
+#if defined(BRIGHTFORGE_CHECKSUM_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define BRIGHTFORGE_TARGET_SSE42 __attribute__((target("sse4.2")))
+#else
+    #define BRIGHTFORGE_TARGET_SSE42
+#endif
+
+// Both hashes read input as little-endian, matching every platform the engine targets;
+// values are therefore stable across machines and safe to store on disk.
+
+// CRC32C (Castagnoli, reflected 0x82F63B78): the integrity check for stored bytes.
+// Incremental: Update() any number of times, Finish() at the end; the result equals
+// Compute() over the concatenation.
+class Crc32c {
+public:
+    Crc32c() : mState(0xFFFFFFFFu) {}
+
+    void Update(const void* data, size_t size) {
+        mState = Extend(mState, static_cast<const uint8_t*>(data), size);
+    }
+
+    uint32_t Finish() const { return ~mState; }
+    void Reset() { mState = 0xFFFFFFFFu; }
+
+    static uint32_t Compute(const void* data, size_t size) {
+        return ~Extend(0xFFFFFFFFu, static_cast<const uint8_t*>(data), size);
+    }
+
+    // True when Update() runs on the CPU's CRC32 instruction
+    static bool IsHardwareAccelerated() {
+#if defined(__ARM_FEATURE_CRC32)
+        return true;
+#elif defined(BRIGHTFORGE_CHECKSUM_X86)
+        static const bool supported = DetectSse42();
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    // Table-driven path; public so tests and benchmarks can compare it against hardware
+    static uint32_t ExtendSoftware(uint32_t state, const uint8_t* data, size_t size) {
+        const Tables& tables = GetTables();
+        while (size > 0 && (reinterpret_cast<uintptr_t>(data) & 7) != 0) {
+            state = tables.t[0][(state ^ *data++) & 0xFF] ^ (state >> 8);
+            --size;
+        }
+        while (size >= 8) {
+            uint32_t low;
+            uint32_t high;
+            std::memcpy(&low, data, 4);
+            std::memcpy(&high, data + 4, 4);
+            low ^= state;
+            state = tables.t[7][low & 0xFF] ^ tables.t[6][(low >> 8) & 0xFF] ^
+                    tables.t[5][(low >> 16) & 0xFF] ^ tables.t[4][low >> 24] ^
+                    tables.t[3][high & 0xFF] ^ tables.t[2][(high >> 8) & 0xFF] ^
+                    tables.t[1][(high >> 16) & 0xFF] ^ tables.t[0][high >> 24];
+            data += 8;
+            size -= 8;
+        }
+        while (size-- > 0) {
+            state = tables.t[0][(state ^ *data++) & 0xFF] ^ (state >> 8);
+        }
+        return state;
+    }
+
+private:
+    static constexpr uint32_t POLYNOMIAL = 0x82F63B78u;
+
+    uint32_t mState;
+
+    struct Tables {
+        uint32_t t[8][256];
+
+        Tables() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc >> 1) ^ ((crc & 1) ? POLYNOMIAL : 0);
+                }
+                t[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (int slice = 1; slice < 8; ++slice) {
+                    t[slice][i] = (t[slice - 1][i] >> 8) ^ t[0][t[slice - 1][i] & 0xFF];
+                }
+            }
+        }
+    };
+
+    static const Tables& GetTables() {
+        static const Tables tables;
+        return tables;
+    }
+
+    static uint32_t Extend(uint32_t state, const uint8_t* data, size_t size) {
+        if (size == 0) {
+            return state;
+        }
+#if defined(__ARM_FEATURE_CRC32)
+        return ExtendArm(state, data, size);
+#elif defined(BRIGHTFORGE_CHECKSUM_X86)
+        return IsHardwareAccelerated() ? ExtendSse42(state, data, size) : ExtendSoftware(state, data, size);
+#else
+        return ExtendSoftware(state, data, size);
+#endif
+    }
+
+#if defined(BRIGHTFORGE_CHECKSUM_X86)
+    static bool DetectSse42() {
+    #if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 20)) != 0;
+    #else
+        return __builtin_cpu_supports("sse4.2");
+    #endif
+    }
+
+    BRIGHTFORGE_TARGET_SSE42
+    static uint32_t ExtendSse42(uint32_t state, const uint8_t* data, size_t size) {
+        while (size > 0 && (reinterpret_cast<uintptr_t>(data) & 7) != 0) {
+            state = _mm_crc32_u8(state, *data++);
+            --size;
+        }
+    #if defined(__x86_64__) || defined(_M_X64)
+        uint64_t wide = state;
+        while (size >= 8) {
+            uint64_t word;
+            std::memcpy(&word, data, 8);
+            wide = _mm_crc32_u64(wide, word);
+            data += 8;
+            size -= 8;
+        }
+        state = static_cast<uint32_t>(wide);
+    #endif
+        while (size >= 4) {
+            uint32_t word;
+            std::memcpy(&word, data, 4);
+            state = _mm_crc32_u32(state, word);
+            data += 4;
+            size -= 4;
+        }
+        while (size-- > 0) {
+            state = _mm_crc32_u8(state, *data++);
+        }
+        return state;
+    }
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+    static uint32_t ExtendArm(uint32_t state, const uint8_t* data, size_t size) {
+        while (size >= 8) {
+            uint64_t word;
+            std::memcpy(&word, data, 8);
+            state = __crc32cd(state, word);
+            data += 8;
+            size -= 8;
+        }
+        while (size-- > 0) {
+            state = __crc32cb(state, *data++);
+        }
+        return state;
+    }
+#endif
+};
+
+// XXH3-64 (seed 0, default secret): the content hash for dedup and cache keys.
+// Outputs match the reference xxHash XXH3_64bits(). Incremental like Crc32c; Finish()
+// does not disturb the state, so a running hash can be read and then extended.
+class Xxh3 {
+public:
+    Xxh3() { Reset(); }
+
+    void Reset() {
+        InitAccumulators(mAcc);
+        mTotalSize = 0;
+        mBuffered = 0;
+        mStripesInBlock = 0;
+    }
+
+    void Update(const void* data, size_t size) {
+        const uint8_t* input = static_cast<const uint8_t*>(data);
+        mTotalSize += size;
+
+        if (mBuffered + size <= BUFFER_SIZE) {
+            if (size > 0) {
+                std::memcpy(mBuffer + mBuffered, input, size);
+            }
+            mBuffered += size;
+            return;
+        }
+
+        const uint8_t* const end = input + size;
+        if (mBuffered > 0) {
+            size_t fill = BUFFER_SIZE - mBuffered;
+            std::memcpy(mBuffer + mBuffered, input, fill);
+            input += fill;
+            ConsumeStripes(mBuffer, BUFFER_SIZE / STRIPE_SIZE);
+            mBuffered = 0;
+        }
+
+        // Stripes straight from the caller's memory; at least one byte always stays
+        // buffered so Finish() can build the final stripe
+        if (static_cast<size_t>(end - input) > BUFFER_SIZE) {
+            size_t stripes = (static_cast<size_t>(end - input) - 1) / STRIPE_SIZE;
+            ConsumeStripes(input, stripes);
+            input += stripes * STRIPE_SIZE;
+            std::memcpy(mBuffer + BUFFER_SIZE - STRIPE_SIZE, input - STRIPE_SIZE, STRIPE_SIZE);
+        }
+
+        mBuffered = static_cast<size_t>(end - input);
+        std::memcpy(mBuffer, input, mBuffered);
+    }
+
+    uint64_t Finish() const {
+        if (mTotalSize <= MIDSIZE_MAX) {
+            return Hash64(mBuffer, static_cast<size_t>(mTotalSize));
+        }
+
+        uint64_t acc[8];
+        std::memcpy(acc, mAcc, sizeof(acc));
+        size_t stripesInBlock = mStripesInBlock;
+        uint8_t lastStripe[STRIPE_SIZE];
+        const uint8_t* last;
+        if (mBuffered >= STRIPE_SIZE) {
+            size_t stripes = (mBuffered - 1) / STRIPE_SIZE;
+            ConsumeStripes(acc, stripesInBlock, mBuffer, stripes);
+            last = mBuffer + mBuffered - STRIPE_SIZE;
+        } else {
+            // Complete the stripe with the tail of the previous buffer
+            size_t catchUp = STRIPE_SIZE - mBuffered;
+            std::memcpy(lastStripe, mBuffer + BUFFER_SIZE - catchUp, catchUp);
+            std::memcpy(lastStripe + catchUp, mBuffer, mBuffered);
+            last = lastStripe;
+        }
+        Accumulate512(acc, last, SECRET + SECRET_SIZE - STRIPE_SIZE - LAST_STRIPE_OFFSET);
+        return MergeAccumulators(acc, SECRET + MERGE_OFFSET, mTotalSize * PRIME64_1);
+    }
+
+    static uint64_t Hash64(const void* data, size_t size) {
+        const uint8_t* input = static_cast<const uint8_t*>(data);
+        if (size <= 16) {
+            return HashUpTo16(input, size);
+        }
+        if (size <= 128) {
+            uint64_t acc = size * PRIME64_1;
+            if (size > 32) {
+                if (size > 64) {
+                    if (size > 96) {
+                        acc += Mix16(input + 48, SECRET + 96);
+                        acc += Mix16(input + size - 64, SECRET + 112);
+                    }
+                    acc += Mix16(input + 32, SECRET + 64);
+                    acc += Mix16(input + size - 48, SECRET + 80);
+                }
+                acc += Mix16(input + 16, SECRET + 32);
+                acc += Mix16(input + size - 32, SECRET + 48);
+            }
+            acc += Mix16(input, SECRET);
+            acc += Mix16(input + size - 16, SECRET + 16);
+            return Avalanche(acc);
+        }
+        if (size <= MIDSIZE_MAX) {
+            uint64_t acc = size * PRIME64_1;
+            size_t rounds = size / 16;
+            for (size_t i = 0; i < 8; ++i) {
+                acc += Mix16(input + 16 * i, SECRET + 16 * i);
+            }
+            acc = Avalanche(acc);
+            for (size_t i = 8; i < rounds; ++i) {
+                acc += Mix16(input + 16 * i, SECRET + 16 * (i - 8) + MIDSIZE_START_OFFSET);
+            }
+            acc += Mix16(input + size - 16, SECRET + SECRET_SIZE_MIN - MIDSIZE_LAST_OFFSET);
+            return Avalanche(acc);
+        }
+
+        uint64_t acc[8];
+        InitAccumulators(acc);
+        size_t blocks = (size - 1) / BLOCK_BYTES;
+        for (size_t b = 0; b < blocks; ++b) {
+            for (size_t s = 0; s < STRIPES_PER_BLOCK; ++s) {
+                Accumulate512(acc, input + b * BLOCK_BYTES + s * STRIPE_SIZE, SECRET + s * SECRET_CONSUME_RATE);
+            }
+            Scramble(acc, SECRET + SECRET_SIZE - STRIPE_SIZE);
+        }
+        size_t stripes = ((size - 1) - blocks * BLOCK_BYTES) / STRIPE_SIZE;
+        for (size_t s = 0; s < stripes; ++s) {
+            Accumulate512(acc, input + blocks * BLOCK_BYTES + s * STRIPE_SIZE, SECRET + s * SECRET_CONSUME_RATE);
+        }
+        Accumulate512(acc, input + size - STRIPE_SIZE, SECRET + SECRET_SIZE - STRIPE_SIZE - LAST_STRIPE_OFFSET);
+        return MergeAccumulators(acc, SECRET + MERGE_OFFSET, size * PRIME64_1);
+    }
+
+private:
+    static constexpr uint32_t PRIME32_1 = 0x9E3779B1u;
+    static constexpr uint32_t PRIME32_2 = 0x85EBCA77u;
+    static constexpr uint32_t PRIME32_3 = 0xC2B2AE3Du;
+    static constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ull;
+    static constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ull;
+    static constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ull;
+    static constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ull;
+    static constexpr uint64_t PRIME_MX1 = 0x165667919E3779F9ull;
+    static constexpr uint64_t PRIME_MX2 = 0x9FB21C651E98DF25ull;
+
+    static constexpr size_t SECRET_SIZE = 192;
+    static constexpr size_t SECRET_SIZE_MIN = 136;
+    static constexpr size_t STRIPE_SIZE = 64;
+    static constexpr size_t SECRET_CONSUME_RATE = 8;
+    static constexpr size_t STRIPES_PER_BLOCK = (SECRET_SIZE - STRIPE_SIZE) / SECRET_CONSUME_RATE;
+    static constexpr size_t BLOCK_BYTES = STRIPE_SIZE * STRIPES_PER_BLOCK;
+    static constexpr size_t MIDSIZE_MAX = 240;
+    static constexpr size_t MIDSIZE_START_OFFSET = 3;
+    static constexpr size_t MIDSIZE_LAST_OFFSET = 17;
+    static constexpr size_t LAST_STRIPE_OFFSET = 7;
+    static constexpr size_t MERGE_OFFSET = 11;
+    static constexpr size_t BUFFER_SIZE = 256;
+
+    static constexpr uint8_t SECRET[SECRET_SIZE] = {
+        0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+        0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+        0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+        0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+        0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+        0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+        0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+        0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+        0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+        0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+        0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+        0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+    };
+
+    uint64_t mAcc[8];
+    uint64_t mTotalSize;
+    size_t mBuffered;
+    size_t mStripesInBlock;
+    alignas(64) uint8_t mBuffer[BUFFER_SIZE];
+
+    static uint32_t Read32(const uint8_t* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static uint64_t Read64(const uint8_t* p) {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static uint64_t Rotl64(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    static uint32_t Swap32(uint32_t value) {
+        return ((value << 24) & 0xFF000000u) | ((value << 8) & 0x00FF0000u) |
+               ((value >> 8) & 0x0000FF00u) | ((value >> 24) & 0x000000FFu);
+    }
+
+    static uint64_t Swap64(uint64_t value) {
+        return (static_cast<uint64_t>(Swap32(static_cast<uint32_t>(value))) << 32) |
+               Swap32(static_cast<uint32_t>(value >> 32));
+    }
+
+    // Low and high halves of the 128-bit product, folded together
+    static uint64_t MulFold64(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        __uint128_t product = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        uint64_t high;
+        uint64_t low = _umul128(a, b, &high);
+        return low ^ high;
+#else
+        uint64_t aLow = a & 0xFFFFFFFFu;
+        uint64_t aHigh = a >> 32;
+        uint64_t bLow = b & 0xFFFFFFFFu;
+        uint64_t bHigh = b >> 32;
+        uint64_t lowLow = aLow * bLow;
+        uint64_t highLow = aHigh * bLow;
+        uint64_t lowHigh = aLow * bHigh;
+        uint64_t highHigh = aHigh * bHigh;
+        uint64_t cross = (lowLow >> 32) + (highLow & 0xFFFFFFFFu) + lowHigh;
+        uint64_t high = (highLow >> 32) + (cross >> 32) + highHigh;
+        uint64_t low = (cross << 32) | (lowLow & 0xFFFFFFFFu);
+        return low ^ high;
+#endif
+    }
+
+    static uint64_t Avalanche(uint64_t h) {
+        h ^= h >> 37;
+        h *= PRIME_MX1;
+        return h ^ (h >> 32);
+    }
+
+    static uint64_t Avalanche64(uint64_t h) {
+        h ^= h >> 33;
+        h *= PRIME64_2;
+        h ^= h >> 29;
+        h *= PRIME64_3;
+        return h ^ (h >> 32);
+    }
+
+    static uint64_t Rrmxmx(uint64_t h, uint64_t size) {
+        h ^= Rotl64(h, 49) ^ Rotl64(h, 24);
+        h *= PRIME_MX2;
+        h ^= (h >> 35) + size;
+        h *= PRIME_MX2;
+        return h ^ (h >> 28);
+    }
+
+    static uint64_t Mix16(const uint8_t* input, const uint8_t* secret) {
+        return MulFold64(Read64(input) ^ Read64(secret), Read64(input + 8) ^ Read64(secret + 8));
+    }
+
+    static uint64_t HashUpTo16(const uint8_t* input, size_t size) {
+        if (size > 8) {
+            uint64_t low = Read64(input) ^ (Read64(SECRET + 24) ^ Read64(SECRET + 32));
+            uint64_t high = Read64(input + size - 8) ^ (Read64(SECRET + 40) ^ Read64(SECRET + 48));
+            uint64_t acc = size + Swap64(low) + high + MulFold64(low, high);
+            return Avalanche(acc);
+        }
+        if (size >= 4) {
+            uint64_t combined = Read32(input + size - 4) + (static_cast<uint64_t>(Read32(input)) << 32);
+            return Rrmxmx(combined ^ (Read64(SECRET + 8) ^ Read64(SECRET + 16)), size);
+        }
+        if (size > 0) {
+            uint32_t combined = (static_cast<uint32_t>(input[0]) << 16) | (static_cast<uint32_t>(input[size >> 1]) << 24) |
+                                static_cast<uint32_t>(input[size - 1]) | (static_cast<uint32_t>(size) << 8);
+            return Avalanche64(combined ^ (Read32(SECRET) ^ Read32(SECRET + 4)));
+        }
+        return Avalanche64(Read64(SECRET + 56) ^ Read64(SECRET + 64));
+    }
+
+    static void InitAccumulators(uint64_t* acc) {
+        acc[0] = PRIME32_3;
+        acc[1] = PRIME64_1;
+        acc[2] = PRIME64_2;
+        acc[3] = PRIME64_3;
+        acc[4] = PRIME64_4;
+        acc[5] = PRIME32_2;
+        acc[6] = PRIME64_5;
+        acc[7] = PRIME32_1;
+    }
+
+    static void Accumulate512(uint64_t* acc, const uint8_t* input, const uint8_t* secret) {
+#if defined(BRIGHTFORGE_CHECKSUM_SSE2)
+        __m128i* lanes = reinterpret_cast<__m128i*>(acc);
+        for (int i = 0; i < 4; ++i) {
+            __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input) + i);
+            __m128i key = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+            __m128i dataKey = _mm_xor_si128(data, key);
+            __m128i dataKeyHigh = _mm_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1));
+            __m128i product = _mm_mul_epu32(dataKey, dataKeyHigh);
+            __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            __m128i sum = _mm_add_epi64(_mm_loadu_si128(lanes + i), swapped);
+            _mm_storeu_si128(lanes + i, _mm_add_epi64(product, sum));
+        }
+#else
+        for (int i = 0; i < 8; ++i) {
+            uint64_t data = Read64(input + 8 * i);
+            uint64_t dataKey = data ^ Read64(secret + 8 * i);
+            acc[i ^ 1] += data;
+            acc[i] += (dataKey & 0xFFFFFFFFu) * (dataKey >> 32);
+        }
+#endif
+    }
+
+    static void Scramble(uint64_t* acc, const uint8_t* secret) {
+#if defined(BRIGHTFORGE_CHECKSUM_SSE2)
+        __m128i* lanes = reinterpret_cast<__m128i*>(acc);
+        const __m128i prime = _mm_set1_epi32(static_cast<int>(PRIME32_1));
+        for (int i = 0; i < 4; ++i) {
+            __m128i value = _mm_loadu_si128(lanes + i);
+            value = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+            value = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+            __m128i high = _mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1));
+            __m128i productLow = _mm_mul_epu32(value, prime);
+            __m128i productHigh = _mm_mul_epu32(high, prime);
+            _mm_storeu_si128(lanes + i, _mm_add_epi64(productLow, _mm_slli_epi64(productHigh, 32)));
+        }
+#else
+        for (int i = 0; i < 8; ++i) {
+            uint64_t value = acc[i];
+            value ^= value >> 47;
+            value ^= Read64(secret + 8 * i);
+            acc[i] = value * PRIME32_1;
+        }
+#endif
+    }
+
+    static uint64_t MergeAccumulators(const uint64_t* acc, const uint8_t* secret, uint64_t start) {
+        uint64_t result = start;
+        for (int i = 0; i < 4; ++i) {
+            result += MulFold64(acc[2 * i] ^ Read64(secret + 16 * i), acc[2 * i + 1] ^ Read64(secret + 16 * i + 8));
+        }
+        return Avalanche(result);
+    }
+
+    // Stripes continue the block position across Update() calls; a full block scrambles
+    static void ConsumeStripes(uint64_t* acc, size_t& stripesInBlock, const uint8_t* input, size_t stripes) {
+        for (size_t s = 0; s < stripes; ++s) {
+            Accumulate512(acc, input + s * STRIPE_SIZE, SECRET + stripesInBlock * SECRET_CONSUME_RATE);
+            if (++stripesInBlock == STRIPES_PER_BLOCK) {
+                Scramble(acc, SECRET + SECRET_SIZE - STRIPE_SIZE);
+                stripesInBlock = 0;
+            }
+        }
+    }
+
+    void ConsumeStripes(const uint8_t* input, size_t stripes) {
+        ConsumeStripes(mAcc, mStripesInBlock, input, stripes);
+    }
+};
+
+// Test and benchmark registration for both checksums
+class Checksum {
+public:
+    // Reference vectors, streaming == one-shot, hardware == software
+    static void RegisterTests();
+    // Throughput of each hash over a buffer of `bytes`
+    static void RegisterBenchmarks(size_t bytes = 16u << 20);
+
+    Checksum() = delete;
+};
+
+inline void Checksum::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("Checksum");
+
+    tests.AddTest("Checksum", "CRC32C matches the reference vectors", []() {
+        // RFC 3720 B.4: 32 zero bytes, then "123456789"
+        uint8_t zeros[32] = {};
+        std::vector<uint8_t> data(100003);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<uint8_t>(i * 31 + (i >> 7));
+        }
+
+        bool ok = Crc32c::Compute(zeros, sizeof(zeros)) == 0x8A9136AAu &&
+                  Crc32c::Compute("123456789", 9) == 0xE3069283u && Crc32c::Compute("", 0) == 0;
+
+        // Unaligned starts and ragged splits must agree with the table path
+        for (size_t offset = 0; ok && offset < 9; ++offset) {
+            size_t size = data.size() - offset;
+            uint32_t expected = ~Crc32c::ExtendSoftware(0xFFFFFFFFu, data.data() + offset, size);
+            Crc32c running;
+            for (size_t at = 0; at < size; at += 1 + at % 977) {
+                running.Update(data.data() + offset + at, std::min<size_t>(1 + at % 977, size - at));
+            }
+            ok = Crc32c::Compute(data.data() + offset, size) == expected && running.Finish() == expected;
+        }
+        return ok;
+    });
+
+    // Values from the reference xxHash XXH3_64bits() over the pattern below
+    tests.AddTest("Checksum", "XXH3 matches the reference at every size class", []() {
+        std::vector<uint8_t> data(4096 + 300);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<uint8_t>((i * 2654435761u) >> 13);
+        }
+        const struct { size_t size; uint64_t hash; } vectors[] = {
+            { 0, 0x2D06800538D394C2ull },    { 1, 0xC44BDFF4074EECDBull },    { 3, 0xA1C4A8259B827291ull },
+            { 4, 0xBB4E3D89EE0B271Dull },    { 8, 0x79D02238B80E37B1ull },    { 9, 0xF64CECC4271FF461ull },
+            { 16, 0x222E9AEAD6BDDD51ull },   { 17, 0x47AAD6B375EB4BBAull },   { 100, 0xAD1E77FF670A2548ull },
+            { 129, 0x9E2414800F83768Aull },  { 240, 0xB714C5FD22744964ull },  { 241, 0xBC424A2C480DD281ull },
+            { 1025, 0xFE08E5A874D23FD2ull }, { 4396, 0x74F38674AA8694F2ull },
+        };
+        bool ok = true;
+        for (const auto& vector : vectors) {
+            ok = ok && Xxh3::Hash64(data.data(), vector.size) == vector.hash;
+        }
+
+        // Streaming in uneven pieces must reproduce the one-shot hash at every size
+        for (size_t size : { 1u, 3u, 8u, 16u, 17u, 128u, 129u, 240u, 241u, 256u, 257u, 1024u, 1025u, 2048u, 4396u }) {
+            uint64_t expected = Xxh3::Hash64(data.data(), size);
+            for (size_t piece : { 1u, 7u, 64u, 255u, 256u, 1000u }) {
+                Xxh3 running;
+                for (size_t at = 0; at < size; at += piece) {
+                    running.Update(data.data() + at, std::min(piece, size - at));
+                }
+                ok = ok && running.Finish() == expected;
+            }
+        }
+        return ok;
+    });
+}
+
+inline void Checksum::RegisterBenchmarks(size_t bytes) {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    static std::vector<uint8_t> data;
+    data.assign(bytes, 0);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7 + (i >> 9));
+    }
+
+    std::string size = std::to_string(bytes >> 20) + " MiB";
+    tests.AddBenchmark("Checksum", "CRC32C " + size + (Crc32c::IsHardwareAccelerated() ? " (hardware)" : " (software)"), []() {
+        TestManagerNew::DoNotOptimize(Crc32c::Compute(data.data(), data.size()));
+    });
+    tests.AddBenchmark("Checksum", "CRC32C " + size + " (slice-by-8)", []() {
+        TestManagerNew::DoNotOptimize(Crc32c::ExtendSoftware(0xFFFFFFFFu, data.data(), data.size()));
+    });
+    tests.AddBenchmark("Checksum", "XXH3 " + size, []() {
+        TestManagerNew::DoNotOptimize(Xxh3::Hash64(data.data(), data.size()));
+    });
+}
+
+// Note on usage:
+// PakArchive stores a CRC32C per block and an XXH3 per entry; FileService's
+// verify-on-load hashes while it reads. Use Crc32c for "are these bytes intact" and
+// Xxh3 for "is this the same content" (dedup, cache keys).
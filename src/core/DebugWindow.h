@@ -9,8 +9,11 @@
 #include <vector>
 #include <unordered_map>
 #include <mutex>
+#include <functional>
+#include <ostream>
 #include <iostream>
 #include <filesystem>
+#include <ctime>
 
 class DebugWindow {
 public:
@@ -135,6 +138,35 @@ public:
         std::cout << "======================================\n\n";
     }
 
+    // Register a named dashboard page; `render` writes the page body when printed
+    void RegisterPage(const std::string& pageName, std::function<void(std::ostream&)> render) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPages[pageName] = std::move(render);
+    }
+
+    // Print a dashboard page registered by a subsystem (e.g. "Memory")
+    void PrintPage(const std::string& pageName) {
+        std::function<void(std::ostream&)> render;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            // Guard: page doesn't exist
+            auto it = mPages.find(pageName);
+            if (it == mPages.end()) {
+                std::cerr << "[WARN] Page '" << pageName << "' not registered.\n";
+                return;
+            }
+            render = it->second;
+        }
+
+        // Rendered outside the lock so pages may Post() while printing
+        std::cout << "\n======================================\n";
+        std::cout << "        " << pageName << " Dashboard\n";
+        std::cout << "======================================\n";
+        render(std::cout);
+        std::cout << "======================================\n\n";
+    }
+
     // Enable or disable a specific channel
     void ToggleChannel(const std::string& channel, bool enabled) {
         std::lock_guard<std::mutex> lock(mMutex);
@@ -235,14 +267,22 @@ private:
         }
     }
 
+    // localtime_r/_s: Post() is called from several JobSystem workers at once
     std::string GetTimestamp() {
         std::time_t now = std::time(nullptr);
+        std::tm local{};
+#if defined(_WIN32)
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
         char buffer[20];
-        std::strftime(buffer, sizeof(buffer), "%H:%M:%S", std::localtime(&now));
+        std::strftime(buffer, sizeof(buffer), "%H:%M:%S", &local);
         return std::string(buffer);
     }
 
     // Member variables
     std::mutex mMutex;
     std::unordered_map<std::string, ChannelStats> mChannels;
+    std::unordered_map<std::string, std::function<void(std::ostream&)>> mPages;
 };
@@ -12,6 +12,7 @@
 #include <mutex>
 #include <variant>
 #include <iostream>
+#include "MemoryTracker.h"
 
 class EventBus {
 public:
@@ -147,12 +148,16 @@ private:
         // Config events
         mEventCatalog.push_back("config.changed");
 
+        // Memory budget events
+        mEventCatalog.push_back("memory.budget_warning");
+        mEventCatalog.push_back("memory.budget_exceeded");
+
         std::cout << "[EVENT-BUS] Initialized with " << mEventCatalog.size() << " documented events\n";
     }
 
     // Member variables
     std::mutex mMutex;
-    std::unordered_map<std::string, std::vector<Subscription>> mSubscriptions;
+    std::unordered_map<std::string, TrackedVector<Subscription, MemoryTag::EVENT_BUS>> mSubscriptions;
     std::vector<std::string> mEventCatalog;
     size_t mNextSubscriptionId;
 };
@@ -167,4 +172,6 @@ private:
 // camera.updated    - Payload: void* (camera object pointer)
 // render.frame_start - Payload: int (frame number)
 // render.frame_end   - Payload: int (frame number)
-// config.changed    - Payload: std::string (config key)
+// config.changed    - Payload: std::string (config file path; sent from HotReloadService::ConsumePending)
+// memory.budget_warning  - Payload: std::string (subsystem over its soft budget)
+// memory.budget_exceeded - Payload: std::string (subsystem over its hard budget)
@@ -0,0 +1,125 @@
+// Float8.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Eight-lane float vector for SoA shading and pixel kernels
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// One register on AVX, two SSE2 halves otherwise, plain arrays as the last resort.
+// Comparisons return all-ones lane masks for Select(), like the intrinsics do.
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define BF_FLOAT8_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define BF_FLOAT8_SSE2 1
+#endif
+
+struct Float8 {
+    static constexpr int LANES = 8;
+
+#if defined(BF_FLOAT8_AVX)
+    __m256 v;
+
+    static Float8 Broadcast(float value) { return Make(_mm256_set1_ps(value)); }
+    static Float8 Load(const float* source) { return Make(_mm256_loadu_ps(source)); }
+    void Store(float* destination) const { _mm256_storeu_ps(destination, v); }
+
+    friend Float8 operator+(Float8 a, Float8 b) { return Make(_mm256_add_ps(a.v, b.v)); }
+    friend Float8 operator-(Float8 a, Float8 b) { return Make(_mm256_sub_ps(a.v, b.v)); }
+    friend Float8 operator*(Float8 a, Float8 b) { return Make(_mm256_mul_ps(a.v, b.v)); }
+    friend Float8 operator/(Float8 a, Float8 b) { return Make(_mm256_div_ps(a.v, b.v)); }
+
+    static Float8 Min(Float8 a, Float8 b) { return Make(_mm256_min_ps(a.v, b.v)); }
+    static Float8 Max(Float8 a, Float8 b) { return Make(_mm256_max_ps(a.v, b.v)); }
+    static Float8 Sqrt(Float8 a) { return Make(_mm256_sqrt_ps(a.v)); }
+    static Float8 Greater(Float8 a, Float8 b) { return Make(_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)); }
+    static Float8 Select(Float8 mask, Float8 a, Float8 b) { return Make(_mm256_blendv_ps(b.v, a.v, mask.v)); }
+    static bool Any(Float8 mask) { return _mm256_movemask_ps(mask.v) != 0; }
+
+private:
+    static Float8 Make(__m256 value) { Float8 r; r.v = value; return r; }
+
+#elif defined(BF_FLOAT8_SSE2)
+    __m128 lo;
+    __m128 hi;
+
+    static Float8 Broadcast(float value) { __m128 x = _mm_set1_ps(value); return Make(x, x); }
+    static Float8 Load(const float* source) { return Make(_mm_loadu_ps(source), _mm_loadu_ps(source + 4)); }
+    void Store(float* destination) const { _mm_storeu_ps(destination, lo); _mm_storeu_ps(destination + 4, hi); }
+
+    friend Float8 operator+(Float8 a, Float8 b) { return Make(_mm_add_ps(a.lo, b.lo), _mm_add_ps(a.hi, b.hi)); }
+    friend Float8 operator-(Float8 a, Float8 b) { return Make(_mm_sub_ps(a.lo, b.lo), _mm_sub_ps(a.hi, b.hi)); }
+    friend Float8 operator*(Float8 a, Float8 b) { return Make(_mm_mul_ps(a.lo, b.lo), _mm_mul_ps(a.hi, b.hi)); }
+    friend Float8 operator/(Float8 a, Float8 b) { return Make(_mm_div_ps(a.lo, b.lo), _mm_div_ps(a.hi, b.hi)); }
+
+    static Float8 Min(Float8 a, Float8 b) { return Make(_mm_min_ps(a.lo, b.lo), _mm_min_ps(a.hi, b.hi)); }
+    static Float8 Max(Float8 a, Float8 b) { return Make(_mm_max_ps(a.lo, b.lo), _mm_max_ps(a.hi, b.hi)); }
+    static Float8 Sqrt(Float8 a) { return Make(_mm_sqrt_ps(a.lo), _mm_sqrt_ps(a.hi)); }
+    static Float8 Greater(Float8 a, Float8 b) { return Make(_mm_cmpgt_ps(a.lo, b.lo), _mm_cmpgt_ps(a.hi, b.hi)); }
+
+    // SSE2 has no blendv; (mask & a) | (~mask & b)
+    static Float8 Select(Float8 mask, Float8 a, Float8 b) {
+        return Make(_mm_or_ps(_mm_and_ps(mask.lo, a.lo), _mm_andnot_ps(mask.lo, b.lo)),
+                    _mm_or_ps(_mm_and_ps(mask.hi, a.hi), _mm_andnot_ps(mask.hi, b.hi)));
+    }
+
+    static bool Any(Float8 mask) { return (_mm_movemask_ps(mask.lo) | _mm_movemask_ps(mask.hi)) != 0; }
+
+private:
+    static Float8 Make(__m128 low, __m128 high) { Float8 r; r.lo = low; r.hi = high; return r; }
+
+#else
+    float v[LANES];
+
+    static Float8 Broadcast(float value) { Float8 r; for (float& x : r.v) { x = value; } return r; }
+    static Float8 Load(const float* source) { Float8 r; std::memcpy(r.v, source, sizeof(r.v)); return r; }
+    void Store(float* destination) const { std::memcpy(destination, v, sizeof(v)); }
+
+    friend Float8 operator+(Float8 a, Float8 b) { for (int i = 0; i < LANES; ++i) { a.v[i] += b.v[i]; } return a; }
+    friend Float8 operator-(Float8 a, Float8 b) { for (int i = 0; i < LANES; ++i) { a.v[i] -= b.v[i]; } return a; }
+    friend Float8 operator*(Float8 a, Float8 b) { for (int i = 0; i < LANES; ++i) { a.v[i] *= b.v[i]; } return a; }
+    friend Float8 operator/(Float8 a, Float8 b) { for (int i = 0; i < LANES; ++i) { a.v[i] /= b.v[i]; } return a; }
+
+    static Float8 Min(Float8 a, Float8 b) { for (int i = 0; i < LANES; ++i) { a.v[i] = b.v[i] < a.v[i] ? b.v[i] : a.v[i]; } return a; }
+    static Float8 Max(Float8 a, Float8 b) { for (int i = 0; i < LANES; ++i) { a.v[i] = a.v[i] < b.v[i] ? b.v[i] : a.v[i]; } return a; }
+    static Float8 Sqrt(Float8 a) { for (float& x : a.v) { x = std::sqrt(x); } return a; }
+
+    static Float8 Greater(Float8 a, Float8 b) {
+        Float8 r;
+        for (int i = 0; i < LANES; ++i) {
+            uint32_t bits = a.v[i] > b.v[i] ? 0xFFFFFFFFu : 0u;
+            std::memcpy(&r.v[i], &bits, sizeof(bits));
+        }
+        return r;
+    }
+
+    static Float8 Select(Float8 mask, Float8 a, Float8 b) {
+        for (int i = 0; i < LANES; ++i) {
+            uint32_t bits;
+            std::memcpy(&bits, &mask.v[i], sizeof(bits));
+            a.v[i] = bits != 0 ? a.v[i] : b.v[i];
+        }
+        return a;
+    }
+
+    static bool Any(Float8 mask) {
+        for (float lane : mask.v) {
+            uint32_t bits;
+            std::memcpy(&bits, &lane, sizeof(bits));
+            if (bits != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+#endif
+
+public:
+    static Float8 Saturate(Float8 a) { return Min(Max(a, Broadcast(0.0f)), Broadcast(1.0f)); }
+    static Float8 Lerp(Float8 a, Float8 b, Float8 t) { return a + (b - a) * t; }
+};
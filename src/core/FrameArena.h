@@ -0,0 +1,367 @@
+// FrameArena.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Double-buffered per-frame bump allocator with STL allocator adapters
+
+#pragma once
+
+#include "QuoteSystem.h"
+#include "TestManagerNew.h"
+#include "JobSystem.h"
+#include "MemoryTracker.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <new>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// Bytes requested from the heap per chunk (larger requests get a chunk of their own size)
+constexpr size_t FRAME_ARENA_CHUNK_SIZE = 256 * 1024;
+// Frames whose allocations are live at once: the current one and the one before it
+constexpr size_t FRAME_ARENA_BUFFERS = 2;
+
+// FrameArena hands out memory that lives until the frame after next:
+// - Each thread bumps through its own chunk, so Allocate() takes no lock until a
+//   chunk runs out
+// - Chunks are grouped by the frame that used them; BeginFrame() recycles the
+//   group from two frames ago, so last frame's data (draw lists being consumed,
+//   event payloads still in flight) stays valid for one more frame
+// - Recycled chunks are reused, never freed, so a steady-state frame makes no heap
+//   allocations once the arena has grown to its working set
+// Nothing is destroyed: only trivially destructible objects go through New().
+// BeginFrame() must not race with Allocate() (call it at the top of the frame,
+// before any job that allocates is submitted).
+class FrameArena {
+public:
+    explicit FrameArena(size_t chunkSize = FRAME_ARENA_CHUNK_SIZE)
+        : mChunkSize(chunkSize)
+        , mCurrent(0)
+        , mEpoch(NextEpoch())
+        , mFrameNumber(0)
+        , mUpstreamAllocations(0)
+        , mReservedBytes(0)
+    {}
+
+    ~FrameArena() {
+        MemoryTracker::Instance().Release(MemoryTag::FRAME_ARENA, mReservedBytes);
+    }
+
+    // Engine-wide arena, advanced by the active render service's BeginFrame()
+    static FrameArena& Instance() {
+        static FrameArena instance;
+        return instance;
+    }
+
+    // Start a new frame and recycle the memory of the frame before the last one
+    void BeginFrame() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCurrent = (mCurrent + 1) % FRAME_ARENA_BUFFERS;
+        for (Chunk* chunk : mInUse[mCurrent]) {
+            mFree.push_back(chunk);
+        }
+        mInUse[mCurrent].clear();
+
+        // Invalidates every thread's cached chunk
+        mEpoch.store(NextEpoch(), std::memory_order_release);
+        mFrameNumber++;
+    }
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        Cursor& cursor = ThreadCursor();
+        uint64_t epoch = mEpoch.load(std::memory_order_acquire);
+        if (cursor.owner != this || cursor.epoch != epoch) {
+            cursor.owner = this;
+            cursor.epoch = epoch;
+            cursor.chunk = nullptr;
+        }
+
+        if (cursor.chunk != nullptr) {
+            if (void* p = Bump(*cursor.chunk, size, alignment)) {
+                return p;
+            }
+        }
+
+        // Chunk exhausted (or first allocation this frame on this thread)
+        cursor.chunk = AcquireChunk(size + alignment);
+        return Bump(*cursor.chunk, size, alignment);
+    }
+
+    // Construct a transient object (e.g. a snapshot published as a void* event payload)
+    template <typename T, typename... Args>
+    T* New(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Grow the free pool to at least `bytes` up front so early frames do not hit the heap
+    void Reserve(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        size_t pooled = 0;
+        for (const Chunk* chunk : mFree) {
+            pooled += chunk->capacity;
+        }
+        while (pooled < bytes) {
+            mFree.push_back(NewChunk(mChunkSize));
+            pooled += mChunkSize;
+        }
+    }
+
+    uint64_t FrameNumber() const { return mFrameNumber; }
+
+    // Chunks ever requested from the heap; flat across steady-state frames
+    size_t UpstreamAllocationCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mUpstreamAllocations;
+    }
+
+    // Heap bytes held by the arena (in use plus pooled)
+    size_t ReservedBytes() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mReservedBytes;
+    }
+
+    // Steady-state heap use, double buffering and STL adapters
+    static void RegisterTests();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+private:
+    struct Chunk {
+        std::unique_ptr<uint8_t[]> data;
+        size_t capacity = 0;
+        size_t used = 0;
+    };
+
+    // One cached chunk per thread; switching arenas on a thread abandons the
+    // rest of the old chunk for this frame (correct, just wasteful)
+    struct Cursor {
+        const FrameArena* owner = nullptr;
+        uint64_t epoch = 0;
+        Chunk* chunk = nullptr;
+    };
+
+    static Cursor& ThreadCursor() {
+        thread_local Cursor cursor;
+        return cursor;
+    }
+
+    // Epochs are unique across arenas, so a new arena at a recycled address never
+    // matches a stale cursor
+    static uint64_t NextEpoch() {
+        static std::atomic<uint64_t> next(1);
+        return next.fetch_add(1);
+    }
+
+    static void* Bump(Chunk& chunk, size_t size, size_t alignment) {
+        uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data.get());
+        uintptr_t top = base + chunk.used;
+        uintptr_t aligned = (top + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        if (aligned + size > base + chunk.capacity) {
+            return nullptr;
+        }
+        chunk.used = aligned + size - base;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    Chunk* AcquireChunk(size_t minCapacity) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Chunk* chunk = nullptr;
+        for (size_t i = 0; i < mFree.size(); ++i) {
+            if (mFree[i]->capacity >= minCapacity) {
+                chunk = mFree[i];
+                mFree[i] = mFree.back();
+                mFree.pop_back();
+                break;
+            }
+        }
+        if (chunk == nullptr) {
+            chunk = NewChunk(std::max(mChunkSize, minCapacity));
+        }
+        chunk->used = 0;
+        mInUse[mCurrent].push_back(chunk);
+        return chunk;
+    }
+
+    // Caller holds mMutex
+    Chunk* NewChunk(size_t capacity) {
+        auto chunk = std::make_unique<Chunk>();
+        chunk->data.reset(new uint8_t[capacity]);
+        chunk->capacity = capacity;
+        mUpstreamAllocations++;
+        mReservedBytes += capacity;
+        MemoryTracker::Instance().Add(MemoryTag::FRAME_ARENA, capacity);
+        mChunks.push_back(std::move(chunk));
+
+        // The bookkeeping lists always have room for every chunk, so only new chunks
+        // touch the heap (however many threads take part in a frame)
+        mFree.reserve(mChunks.size());
+        for (std::vector<Chunk*>& inUse : mInUse) {
+            inUse.reserve(mChunks.size());
+        }
+        return mChunks.back().get();
+    }
+
+    const size_t mChunkSize;
+    mutable std::mutex mMutex;
+    std::vector<std::unique_ptr<Chunk>> mChunks;      // Owns every chunk
+    std::vector<Chunk*> mInUse[FRAME_ARENA_BUFFERS];  // Chunks handed out, per frame buffer
+    std::vector<Chunk*> mFree;
+    size_t mCurrent;
+    std::atomic<uint64_t> mEpoch;
+    uint64_t mFrameNumber;
+    size_t mUpstreamAllocations;
+    size_t mReservedBytes;
+};
+
+// Standard allocator over a FrameArena; deallocate() is a no-op because the whole
+// frame is recycled at once. Containers using it must not outlive the next frame.
+template <typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    FrameAllocator() noexcept : mArena(&FrameArena::Instance()) {}
+    explicit FrameAllocator(FrameArena& arena) noexcept : mArena(&arena) {}
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : mArena(other.Arena()) {}
+
+    T* allocate(size_t count) {
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(mArena->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept {}
+
+    FrameArena* Arena() const noexcept { return mArena; }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept { return mArena == other.Arena(); }
+    template <typename U>
+    bool operator!=(const FrameAllocator<U>& other) const noexcept { return mArena != other.Arena(); }
+
+private:
+    FrameArena* mArena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+
+inline void FrameArena::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("FrameArena");
+
+    tests.AddTest("FrameArena", "Steady-state frames make no heap allocations", []() {
+        // Guard: the runner must count real allocations (engine_tests.cpp replaces operator new)
+        if (!TestManagerNew::HeapCountingActive()) {
+            QuoteSystem::Instance().Log("FrameArena: heap allocation counting is not installed in this runner",
+                                        QuoteSystem::MessageType::ERROR_MSG);
+            return false;
+        }
+
+        struct Command {
+            uint32_t mesh;
+            float transform[16];
+        };
+
+        FrameArena arena(64 * 1024);
+        JobSystem jobs(3);
+        // Worst case per frame: the serial lists plus one chunk per participating thread
+        arena.Reserve(2 * (8 + jobs.Concurrency()) * 64 * 1024);
+        size_t lastCount = 0;
+
+        // Count on every pool thread: one job per thread, each spinning until all have
+        // started, so no thread can take two
+        std::atomic<size_t> counting(0);
+        jobs.ParallelFor(jobs.Concurrency(), 1, [&](size_t, size_t) {
+            TestManagerNew::CountHeapAllocations(true);
+            counting.fetch_add(1);
+            while (counting.load() < jobs.Concurrency()) {
+                std::this_thread::yield();
+            }
+        });
+
+        auto frame = [&](size_t drawCount) {
+            arena.BeginFrame();
+            FrameVector<Command> drawList{FrameAllocator<Command>(arena)};
+            drawList.reserve(lastCount);
+            for (size_t i = 0; i < drawCount; ++i) {
+                drawList.push_back(Command{static_cast<uint32_t>(i), {}});
+            }
+            FrameString label("frame payload long enough to skip the small-string buffer",
+                              FrameAllocator<char>(arena));
+            Command* snapshot = arena.New<Command>(drawList.back());
+
+            // Worker threads allocate from their own chunks
+            std::atomic<size_t> sum(0);
+            jobs.ParallelFor(64, 1, [&](size_t begin, size_t) {
+                FrameVector<float> scratch(256, 1.0f, FrameAllocator<float>(arena));
+                sum.fetch_add(scratch.size() + begin * 0);
+            });
+
+            lastCount = drawList.size();
+            return sum.load() == 64 * 256 && snapshot->mesh == drawCount - 1 && label.size() > 40;
+        };
+
+        bool ok = true;
+        for (int warmup = 0; warmup < 3; ++warmup) {
+            ok = frame(600) && ok;
+        }
+        uint64_t heapBefore = TestManagerNew::HeapAllocations();
+        size_t upstreamBefore = arena.UpstreamAllocationCount();
+        for (int steady = 0; steady < 20; ++steady) {
+            ok = frame(600) && ok;
+        }
+        uint64_t heapAllocations = TestManagerNew::HeapAllocations() - heapBefore;
+        TestManagerNew::CountHeapAllocations(false);
+
+        if (heapAllocations != 0) {
+            QuoteSystem::Instance().Log("FrameArena: " + std::to_string(heapAllocations) +
+                                        " heap allocations in 20 steady-state frames",
+                                        QuoteSystem::MessageType::ERROR_MSG);
+        }
+        return ok && heapAllocations == 0 && arena.UpstreamAllocationCount() == upstreamBefore;
+    });
+
+    tests.AddTest("FrameArena", "Last frame's data survives one BeginFrame", []() {
+        FrameArena arena(4096);
+        arena.BeginFrame();
+        FrameVector<uint32_t> previous(512, 0u, FrameAllocator<uint32_t>(arena));
+        for (uint32_t i = 0; i < previous.size(); ++i) {
+            previous[i] = i * 2654435761u;
+        }
+
+        // A full frame of other allocations must not land on `previous`
+        arena.BeginFrame();
+        FrameVector<uint32_t> current(2048, 0xFFFFFFFFu, FrameAllocator<uint32_t>(arena));
+        for (uint32_t i = 0; i < previous.size(); ++i) {
+            if (previous[i] != i * 2654435761u) {
+                return false;
+            }
+        }
+
+        // Two frames later the same memory is handed out again instead of new heap
+        size_t heapBefore = arena.UpstreamAllocationCount();
+        arena.BeginFrame();
+        FrameVector<uint32_t> recycled(512, 7u, FrameAllocator<uint32_t>(arena));
+        bool aligned = reinterpret_cast<uintptr_t>(arena.New<double>(1.0)) % alignof(double) == 0;
+        return aligned && arena.UpstreamAllocationCount() == heapBefore && current.back() == 0xFFFFFFFFu;
+    });
+}
+
+// Note on usage:
+// Render services hold their draw lists as FrameVector and rebuild them after
+// FrameArena::Instance().BeginFrame(), reserving last frame's count so they never
+// regrow in steady state. Transient event payloads published as void* (camera.updated)
+// can be copied with FrameArena::Instance().New<T>() and are valid through the next frame.
@@ -0,0 +1,279 @@
+// HandlePool.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Generational handle table with dense storage for engine resources
+
+#pragma once
+
+#include "QuoteSystem.h"
+#include "TestManagerNew.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+// Handles pack a slot index (low bits) and that slot's generation (high bits).
+// Generations start at 1, so a live handle is never 0 and 0 stays the invalid
+// handle every subsystem already uses.
+constexpr uint32_t HANDLE_INDEX_BITS = 20;
+constexpr uint32_t HANDLE_INDEX_MASK = (1u << HANDLE_INDEX_BITS) - 1;
+constexpr uint32_t HANDLE_GENERATION_MASK = (1u << (32 - HANDLE_INDEX_BITS)) - 1;
+constexpr uint32_t HANDLE_MAX_SLOTS = HANDLE_INDEX_MASK + 1;
+
+// HandlePool keeps values packed in one dense array (iteration touches only live
+// items) and a sparse slot array mapping handle index -> dense position.
+// - Lookup: one indexed load plus a generation compare, no hashing
+// - Removal: swap-and-pop in the dense array; the slot's generation is bumped so
+//   every outstanding copy of the handle goes stale
+// - Debug builds log each stale lookup (use-after-free) and count it
+// A pool either issues handles (Insert) or mirrors handles issued by another pool
+// (InsertAt); mixing both on one pool is not supported.
+// Not thread-safe; owners lock around it as they did around their maps.
+template <typename T>
+class HandlePool {
+public:
+    using Handle = uint32_t;
+
+    HandlePool() = default;
+
+    // Store a value and return its new handle (0 if the pool is full)
+    Handle Insert(T value) {
+        uint32_t index;
+        if (!mFreeSlots.empty()) {
+            index = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        } else {
+            // Guard: index space exhausted
+            if (mSlots.size() >= HANDLE_MAX_SLOTS) {
+                QuoteSystem::Instance().Log("HandlePool full (" + std::to_string(HANDLE_MAX_SLOTS) + " slots)",
+                    QuoteSystem::MessageType::ERROR_MSG);
+                return 0;
+            }
+            index = static_cast<uint32_t>(mSlots.size());
+            mSlots.push_back(Slot());
+        }
+
+        Slot& slot = mSlots[index];
+        slot.dense = static_cast<uint32_t>(mValues.size());
+        mValues.push_back(std::move(value));
+        mDenseSlots.push_back(index);
+        return MakeHandle(index, slot.generation);
+    }
+
+    // Store a value under a handle issued elsewhere (e.g. an index keyed by another
+    // service's handles). Fails if the handle is 0 or its slot is already live.
+    bool InsertAt(Handle handle, T value) {
+        // Guard: invalid handle
+        if (handle == 0) {
+            return false;
+        }
+        uint32_t index = handle & HANDLE_INDEX_MASK;
+        if (index >= mSlots.size()) {
+            mSlots.resize(index + 1);
+        }
+        Slot& slot = mSlots[index];
+        if (slot.dense != FREE) {
+            return false;
+        }
+        slot.generation = handle >> HANDLE_INDEX_BITS;
+        slot.dense = static_cast<uint32_t>(mValues.size());
+        mValues.push_back(std::move(value));
+        mDenseSlots.push_back(index);
+        return true;
+    }
+
+    bool Remove(Handle handle) {
+        uint32_t index = 0;
+        if (!Resolve(handle, index)) {
+            return false;
+        }
+
+        Slot& slot = mSlots[index];
+        uint32_t dense = slot.dense;
+        uint32_t last = static_cast<uint32_t>(mValues.size() - 1);
+        if (dense != last) {
+            mValues[dense] = std::move(mValues[last]);
+            mDenseSlots[dense] = mDenseSlots[last];
+            mSlots[mDenseSlots[dense]].dense = dense;
+        }
+        mValues.pop_back();
+        mDenseSlots.pop_back();
+
+        Retire(slot);
+        mFreeSlots.push_back(index);
+        return true;
+    }
+
+    // nullptr for 0, never-issued and stale handles
+    T* Get(Handle handle) {
+        uint32_t index = 0;
+        return Resolve(handle, index) ? &mValues[mSlots[index].dense] : nullptr;
+    }
+
+    const T* Get(Handle handle) const {
+        uint32_t index = 0;
+        return Resolve(handle, index) ? &mValues[mSlots[index].dense] : nullptr;
+    }
+
+    bool Contains(Handle handle) const {
+        uint32_t index = 0;
+        return Resolve(handle, index);
+    }
+
+    // Remove everything; outstanding handles all go stale
+    void Clear() {
+        for (uint32_t index : mDenseSlots) {
+            Retire(mSlots[index]);
+            mFreeSlots.push_back(index);
+        }
+        mValues.clear();
+        mDenseSlots.clear();
+    }
+
+    void Reserve(size_t count) {
+        mValues.reserve(count);
+        mDenseSlots.reserve(count);
+    }
+
+    size_t Size() const { return mValues.size(); }
+    bool Empty() const { return mValues.empty(); }
+
+    // Dense iteration; order changes when items are removed
+    T* begin() { return mValues.data(); }
+    T* end() { return mValues.data() + mValues.size(); }
+    const T* begin() const { return mValues.data(); }
+    const T* end() const { return mValues.data() + mValues.size(); }
+
+    // Handle of the value at a dense position (pairs with begin()/end())
+    Handle HandleAt(size_t dense) const {
+        uint32_t index = mDenseSlots[dense];
+        return MakeHandle(index, mSlots[index].generation);
+    }
+
+    // Stale lookups seen so far (debug builds only; always 0 with NDEBUG)
+    size_t StaleAccessCount() const { return mStaleAccesses; }
+
+    // Lifecycle, stale detection and dense iteration
+    static void RegisterTests();
+
+private:
+    static constexpr uint32_t FREE = 0xFFFFFFFFu;
+
+    struct Slot {
+        uint32_t dense = FREE;
+        uint32_t generation = 1;
+    };
+
+    static Handle MakeHandle(uint32_t index, uint32_t generation) {
+        return (generation << HANDLE_INDEX_BITS) | index;
+    }
+
+    // Bump the generation, skipping 0 on wrap so handles stay non-zero
+    static void Retire(Slot& slot) {
+        slot.dense = FREE;
+        slot.generation = (slot.generation + 1) & HANDLE_GENERATION_MASK;
+        if (slot.generation == 0) {
+            slot.generation = 1;
+        }
+    }
+
+    bool Resolve(Handle handle, uint32_t& index) const {
+        // Guard: the shared invalid handle
+        if (handle == 0) {
+            return false;
+        }
+        index = handle & HANDLE_INDEX_MASK;
+        if (index >= mSlots.size()) {
+            return false;
+        }
+        const Slot& slot = mSlots[index];
+        if (slot.dense != FREE && slot.generation == (handle >> HANDLE_INDEX_BITS)) {
+            return true;
+        }
+#ifndef NDEBUG
+        // Slot was live under an older generation or has since been freed
+        ++mStaleAccesses;
+        QuoteSystem::Instance().Log("Stale handle " + std::to_string(handle) + " (slot " + std::to_string(index) +
+            " is at generation " + std::to_string(slot.generation) + ")",
+            QuoteSystem::MessageType::ERROR_MSG);
+#endif
+        return false;
+    }
+
+    std::vector<T> mValues;
+    std::vector<uint32_t> mDenseSlots; // Dense position -> slot index
+    std::vector<Slot> mSlots;
+    std::vector<uint32_t> mFreeSlots;
+    mutable size_t mStaleAccesses = 0;
+};
+
+template <typename T>
+inline void HandlePool<T>::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("HandlePool");
+
+    tests.AddTest("HandlePool", "Stale handles miss after reuse", []() {
+        HandlePool<std::string> pool;
+        Handle first = pool.Insert("first");
+        Handle second = pool.Insert("second");
+        if (first == 0 || second == 0 || first == second || *pool.Get(first) != "first") {
+            return false;
+        }
+
+        pool.Remove(first);
+        Handle reused = pool.Insert("third");
+        bool sameSlot = (reused & HANDLE_INDEX_MASK) == (first & HANDLE_INDEX_MASK);
+        bool ok = sameSlot && reused != first && pool.Get(first) == nullptr &&
+                  *pool.Get(reused) == "third" && *pool.Get(second) == "second" && !pool.Remove(first);
+#ifndef NDEBUG
+        ok = ok && pool.StaleAccessCount() == 2;
+#endif
+        return ok && pool.Get(0) == nullptr;
+    });
+
+    tests.AddTest("HandlePool", "Dense iteration tracks removals", []() {
+        HandlePool<int> pool;
+        std::vector<Handle> handles;
+        for (int i = 0; i < 1000; ++i) {
+            handles.push_back(pool.Insert(i));
+        }
+        for (int i = 0; i < 1000; i += 3) {
+            pool.Remove(handles[i]);
+        }
+
+        // Every dense entry maps back to the handle that stores it
+        long long sum = 0;
+        for (size_t dense = 0; dense < pool.Size(); ++dense) {
+            const int* value = pool.Get(pool.HandleAt(dense));
+            if (value != pool.begin() + dense) {
+                return false;
+            }
+            sum += *value;
+        }
+        long long expected = 0;
+        for (int i = 0; i < 1000; ++i) {
+            expected += (i % 3 == 0) ? 0 : i;
+        }
+
+        size_t live = pool.Size();
+        pool.Clear();
+        return sum == expected && live == 666 && pool.Empty() && pool.Get(handles[1]) == nullptr;
+    });
+
+    tests.AddTest("HandlePool", "Mirrors another pool's handles", []() {
+        HandlePool<int> issuer;
+        HandlePool<std::string> mirror;
+        Handle a = issuer.Insert(1);
+        Handle b = issuer.Insert(2);
+        issuer.Remove(a);
+        Handle c = issuer.Insert(3); // Reuses a's slot with a new generation
+
+        bool ok = mirror.InsertAt(b, "b") && mirror.InsertAt(c, "c") && !mirror.InsertAt(c, "again");
+        return ok && mirror.Get(a) == nullptr && *mirror.Get(c) == "c" && mirror.Remove(b) && mirror.Size() == 1;
+    });
+}
+
+// Note on usage:
+// Owners that used std::unordered_map<Handle, T> with a counter call Insert() to mint
+// handles and Get() for lookups.
@@ -0,0 +1,640 @@
+// JobSystem.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Work-stealing job pool and dependency-aware task graphs for frame work
+
+#pragma once
+
+#include "QuoteSystem.h"
+#include "TestManagerNew.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Outstanding job count for a batch; JobSystem::Wait() returns once it reaches zero
+struct JobCounter {
+    std::atomic<size_t> pending{0};
+
+    bool Done() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+// Captures up to this size live inside a pooled job node; larger ones are copied to the heap
+constexpr size_t JOB_INLINE_BYTES = 64;
+// Job nodes added to the pool at once when it runs dry
+constexpr size_t JOB_NODE_BLOCK = 64;
+
+// JobSystem owns a fixed set of worker threads, each with its own deque:
+// - Jobs submitted from a worker go to the back of that worker's deque and are
+//   popped from the back again (LIFO keeps continuations cache-warm)
+// - Idle workers steal from the front of other deques (oldest, usually largest work)
+// - Threads outside the pool push to a shared injection deque
+// - Wait() runs jobs on the calling thread until its counter drains, so nested
+//   waits (a job that waits on a parallel-for) never block a worker
+// Workers sleep on a condition variable once every deque is empty. Jobs are stored
+// in pooled nodes linked into the deques, so once the pool has grown to the peak
+// number of queued jobs, Submit() and the queues make no heap allocations.
+class JobSystem {
+public:
+    // threadCount background workers; the waiting thread always helps, so 0 is valid
+    explicit JobSystem(size_t threadCount)
+        : mQueued(0)
+        , mSleepers(0)
+        , mStopping(false)
+    {
+        // Deque 0 is the injection deque, 1..threadCount belong to the workers
+        mQueues.reserve(threadCount + 1);
+        for (size_t i = 0; i <= threadCount; ++i) {
+            mQueues.push_back(std::make_unique<WorkQueue>());
+        }
+        mThreads.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            mThreads.emplace_back([this, i]() { WorkerLoop(i + 1); });
+        }
+    }
+
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+            mStopping = true;
+        }
+        mWake.notify_all();
+        for (std::thread& thread : mThreads) {
+            thread.join();
+        }
+
+        // Jobs nobody waited for (possible with no workers) are destroyed unrun
+        for (const std::unique_ptr<WorkQueue>& queue : mQueues) {
+            while (JobNode* node = PopFront(*queue)) {
+                node->destroy(node->storage);
+            }
+        }
+    }
+
+    // Engine-wide pool: one worker per hardware thread beyond the caller's
+    static JobSystem& Instance() {
+        static JobSystem instance(DefaultThreadCount() - 1);
+        return instance;
+    }
+
+    // Hardware threads, at least 1
+    static size_t DefaultThreadCount() {
+        return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    // Threads that can run jobs at once: the workers plus the thread in Wait()
+    size_t Concurrency() const { return mThreads.size() + 1; }
+
+    // Queue any void() callable to run once on the pool
+    template <typename Fn>
+    void Submit(Fn&& job, JobCounter& counter) {
+        using Callable = std::decay_t<Fn>;
+        JobNode* node = AcquireNode();
+        if constexpr (sizeof(Callable) <= JOB_INLINE_BYTES && alignof(Callable) <= alignof(std::max_align_t)) {
+            new (node->storage) Callable(std::forward<Fn>(job));
+            node->invoke = [](void* storage) { (*static_cast<Callable*>(storage))(); };
+            node->destroy = [](void* storage) { static_cast<Callable*>(storage)->~Callable(); };
+        } else {
+            new (node->storage) Callable*(new Callable(std::forward<Fn>(job)));
+            node->invoke = [](void* storage) { (**static_cast<Callable**>(storage))(); };
+            node->destroy = [](void* storage) { delete *static_cast<Callable**>(storage); };
+        }
+        node->counter = &counter;
+        counter.pending.fetch_add(1, std::memory_order_relaxed);
+        Push(node);
+    }
+
+    // Run queued jobs on this thread until every job counted by `counter` finished
+    void Wait(JobCounter& counter) {
+        size_t idle = 0;
+        while (!counter.Done()) {
+            if (RunOne()) {
+                idle = 0;
+            } else if (++idle > SPIN_LIMIT) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // fn(begin, end) over [0, count) in chunks of `grain`. Chunks come from a shared
+    // atomic counter so uneven work balances itself; maxConcurrency caps how many
+    // threads take part (0 = all of them, 1 = inline on the caller).
+    template <typename Fn>
+    void ParallelFor(size_t count, size_t grain, Fn&& fn, size_t maxConcurrency = 0) {
+        grain = std::max<size_t>(1, grain);
+        size_t chunks = (count + grain - 1) / grain;
+        size_t participants = std::min(chunks, maxConcurrency != 0 ? maxConcurrency : Concurrency());
+
+        std::atomic<size_t> next(0);
+        auto claim = [&]() {
+            for (size_t chunk = next.fetch_add(1); chunk < chunks; chunk = next.fetch_add(1)) {
+                size_t begin = chunk * grain;
+                fn(begin, std::min(count, begin + grain));
+            }
+        };
+
+        // Guard: nothing to split
+        if (participants <= 1) {
+            claim();
+            return;
+        }
+
+        JobCounter counter;
+        for (size_t p = 1; p < participants; ++p) {
+            Submit(claim, counter);
+        }
+        claim();
+        Wait(counter);
+    }
+
+    // Scheduling, parallel-for coverage and task graph ordering
+    static void RegisterTests();
+    // Task graph throughput at 1, 2, 4 and all hardware threads
+    static void RegisterBenchmarks();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+private:
+    // Failed steal rounds before a waiting thread starts yielding
+    static constexpr size_t SPIN_LIMIT = 64;
+
+    // A queued job: the callable is constructed in place in `storage`
+    struct JobNode {
+        alignas(std::max_align_t) unsigned char storage[JOB_INLINE_BYTES];
+        void (*invoke)(void*) = nullptr;
+        void (*destroy)(void*) = nullptr;
+        JobCounter* counter = nullptr;
+        JobNode* prev = nullptr;
+        JobNode* next = nullptr; // Also links the free list
+    };
+
+    // Intrusive deque: the owner pushes and pops at the tail, thieves take the head
+    struct WorkQueue {
+        std::mutex mutex;
+        JobNode* head = nullptr;
+        JobNode* tail = nullptr;
+    };
+
+    // Which pool (if any) the current thread works for, and its deque
+    struct WorkerContext {
+        const JobSystem* owner = nullptr;
+        size_t queue = 0;
+        uint32_t stealSeed = 0;
+    };
+
+    static WorkerContext& Context() {
+        thread_local WorkerContext context;
+        return context;
+    }
+
+    size_t LocalQueue() const {
+        const WorkerContext& context = Context();
+        return context.owner == this ? context.queue : 0;
+    }
+
+    JobNode* AcquireNode() {
+        std::lock_guard<std::mutex> lock(mPoolMutex);
+        if (mFreeNodes == nullptr) {
+            std::unique_ptr<JobNode[]> block(new JobNode[JOB_NODE_BLOCK]);
+            for (size_t i = 0; i < JOB_NODE_BLOCK; ++i) {
+                block[i].next = mFreeNodes;
+                mFreeNodes = &block[i];
+            }
+            mNodeBlocks.push_back(std::move(block));
+        }
+        JobNode* node = mFreeNodes;
+        mFreeNodes = node->next;
+        node->next = nullptr;
+        return node;
+    }
+
+    void ReleaseNode(JobNode* node) {
+        std::lock_guard<std::mutex> lock(mPoolMutex);
+        node->prev = nullptr;
+        node->next = mFreeNodes;
+        mFreeNodes = node;
+    }
+
+    // Queue operations; the caller holds queue.mutex (or owns the queue exclusively)
+    static void PushBack(WorkQueue& queue, JobNode* node) {
+        node->prev = queue.tail;
+        node->next = nullptr;
+        if (queue.tail != nullptr) {
+            queue.tail->next = node;
+        } else {
+            queue.head = node;
+        }
+        queue.tail = node;
+    }
+
+    static JobNode* PopBack(WorkQueue& queue) {
+        JobNode* node = queue.tail;
+        if (node != nullptr) {
+            queue.tail = node->prev;
+            if (queue.tail != nullptr) {
+                queue.tail->next = nullptr;
+            } else {
+                queue.head = nullptr;
+            }
+        }
+        return node;
+    }
+
+    static JobNode* PopFront(WorkQueue& queue) {
+        JobNode* node = queue.head;
+        if (node != nullptr) {
+            queue.head = node->next;
+            if (queue.head != nullptr) {
+                queue.head->prev = nullptr;
+            } else {
+                queue.tail = nullptr;
+            }
+        }
+        return node;
+    }
+
+    void Push(JobNode* node) {
+        WorkQueue& queue = *mQueues[LocalQueue()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            PushBack(queue, node);
+        }
+        mQueued.fetch_add(1);
+
+        // Taking the sleep mutex orders this push against a worker that is between
+        // its empty check and its wait, so the notify cannot be lost
+        if (mSleepers.load() > 0) {
+            { std::lock_guard<std::mutex> lock(mSleepMutex); }
+            mWake.notify_one();
+        }
+    }
+
+    // Pop from the local deque, else steal; runs one job if found
+    bool RunOne() {
+        size_t local = LocalQueue();
+        JobNode* node = nullptr;
+
+        {
+            WorkQueue& queue = *mQueues[local];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            node = PopBack(queue);
+        }
+
+        // Start at a rotating victim so thieves do not all hammer deque 0
+        size_t queueCount = mQueues.size();
+        size_t start = Context().stealSeed++;
+        for (size_t i = 0; i < queueCount && node == nullptr; ++i) {
+            size_t victim = (start + i) % queueCount;
+            if (victim == local) {
+                continue;
+            }
+            WorkQueue& queue = *mQueues[victim];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            node = PopFront(queue);
+        }
+
+        if (node == nullptr) {
+            return false;
+        }
+
+        mQueued.fetch_sub(1);
+        node->invoke(node->storage);
+        node->destroy(node->storage);
+        JobCounter* counter = node->counter;
+        ReleaseNode(node);
+        // Last touch of the counter: the waiter may destroy it right after
+        counter->pending.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void WorkerLoop(size_t queue) {
+        WorkerContext& context = Context();
+        context.owner = this;
+        context.queue = queue;
+        context.stealSeed = static_cast<uint32_t>(queue);
+
+        for (;;) {
+            if (RunOne()) {
+                continue;
+            }
+
+            bool ran = false;
+            for (size_t spin = 0; spin < SPIN_LIMIT && !ran; ++spin) {
+                std::this_thread::yield();
+                ran = RunOne();
+            }
+            if (ran) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            mSleepers.fetch_add(1);
+            mWake.wait(lock, [this]() { return mStopping || mQueued.load() > 0; });
+            mSleepers.fetch_sub(1);
+            // Drain whatever is still queued before exiting
+            if (mStopping && mQueued.load() <= 0) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> mQueues;
+    std::vector<std::thread> mThreads;
+
+    // Node pool: the blocks own every node, free ones are linked through `next`
+    std::mutex mPoolMutex;
+    std::vector<std::unique_ptr<JobNode[]>> mNodeBlocks;
+    JobNode* mFreeNodes = nullptr; // Guarded by mPoolMutex
+
+    // Jobs sitting in deques (may dip below 0 briefly between pop and push bookkeeping)
+    std::atomic<int64_t> mQueued;
+    std::atomic<size_t> mSleepers;
+    std::mutex mSleepMutex;
+    std::condition_variable mWake;
+    bool mStopping; // Guarded by mSleepMutex
+};
+
+// TaskGraph: named tasks plus "runs before" edges, executed on a JobSystem.
+// Each task counts its unfinished predecessors; the task that finishes last submits
+// the successor as a continuation from its own worker, so independent branches
+// (UI update next to culling, say) overlap without a central scheduler thread.
+// A graph can be cleared and rebuilt every frame; Run() blocks until all tasks ran.
+class TaskGraph {
+public:
+    using TaskId = uint32_t;
+
+    TaskId Add(const std::string& name, std::function<void()> work) {
+        Node node;
+        node.name = name;
+        node.work = std::move(work);
+        mNodes.push_back(std::move(node));
+        return static_cast<TaskId>(mNodes.size() - 1);
+    }
+
+    // fn(begin, end) over [0, count) spread across the pool when the task runs
+    template <typename Fn>
+    TaskId AddParallelFor(const std::string& name, size_t count, size_t grain, Fn fn) {
+        return Add(name, [this, count, grain, fn]() {
+            mJobs->ParallelFor(count, grain, fn);
+        });
+    }
+
+    // `after` starts only once `before` has finished
+    void Precede(TaskId before, TaskId after) {
+        mNodes[before].successors.push_back(after);
+        mNodes[after].predecessors++;
+    }
+
+    // Add a task that continues `before`
+    TaskId Then(TaskId before, const std::string& name, std::function<void()> work) {
+        TaskId task = Add(name, std::move(work));
+        Precede(before, task);
+        return task;
+    }
+
+    // Execute every task once, respecting edges. Returns false (running nothing)
+    // if the edges form a cycle.
+    bool Run(JobSystem& jobs = JobSystem::Instance()) {
+        // Guard: empty graph
+        if (mNodes.empty()) {
+            return true;
+        }
+
+        // Guard: cycle (Kahn's algorithm must reach every node)
+        if (!IsAcyclic()) {
+            QuoteSystem::Instance().Log("TaskGraph: dependency cycle among " +
+                std::to_string(mNodes.size()) + " tasks, nothing was run",
+                QuoteSystem::MessageType::ERROR_MSG);
+            return false;
+        }
+
+        mJobs = &jobs;
+        mRemaining.reset(new std::atomic<uint32_t>[mNodes.size()]);
+        for (size_t i = 0; i < mNodes.size(); ++i) {
+            mRemaining[i].store(mNodes[i].predecessors, std::memory_order_relaxed);
+        }
+
+        JobCounter counter;
+        for (size_t i = 0; i < mNodes.size(); ++i) {
+            if (mNodes[i].predecessors == 0) {
+                Launch(static_cast<TaskId>(i), counter);
+            }
+        }
+        jobs.Wait(counter);
+        mJobs = nullptr;
+        return true;
+    }
+
+    void Clear() {
+        mNodes.clear();
+        mRemaining.reset();
+    }
+
+    size_t Size() const { return mNodes.size(); }
+    const std::string& Name(TaskId task) const { return mNodes[task].name; }
+
+    // Wall time the task body took during the last Run()
+    double LastDurationMs(TaskId task) const { return mNodes[task].durationMs; }
+
+private:
+    struct Node {
+        std::string name;
+        std::function<void()> work;
+        std::vector<TaskId> successors;
+        uint32_t predecessors = 0;
+        double durationMs = 0.0;
+    };
+
+    void Launch(TaskId task, JobCounter& counter) {
+        mJobs->Submit([this, task, &counter]() {
+            Node& node = mNodes[task];
+            auto start = std::chrono::steady_clock::now();
+            if (node.work) {
+                node.work();
+            }
+            node.durationMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+
+            // Submitted before this job's own count drops, so Run() cannot return early
+            for (TaskId successor : node.successors) {
+                if (mRemaining[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    Launch(successor, counter);
+                }
+            }
+        }, counter);
+    }
+
+    bool IsAcyclic() const {
+        std::vector<uint32_t> remaining(mNodes.size());
+        std::vector<TaskId> ready;
+        for (size_t i = 0; i < mNodes.size(); ++i) {
+            remaining[i] = mNodes[i].predecessors;
+            if (remaining[i] == 0) {
+                ready.push_back(static_cast<TaskId>(i));
+            }
+        }
+        size_t visited = 0;
+        while (!ready.empty()) {
+            TaskId task = ready.back();
+            ready.pop_back();
+            ++visited;
+            for (TaskId successor : mNodes[task].successors) {
+                if (--remaining[successor] == 0) {
+                    ready.push_back(successor);
+                }
+            }
+        }
+        return visited == mNodes.size();
+    }
+
+    std::vector<Node> mNodes;
+    std::unique_ptr<std::atomic<uint32_t>[]> mRemaining;
+    JobSystem* mJobs = nullptr; // Set for the duration of Run()
+};
+
+inline void JobSystem::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("JobSystem");
+
+    tests.AddTest("JobSystem", "Parallel-for covers every index once", []() {
+        JobSystem jobs(3);
+        std::vector<uint32_t> hits(100003, 0);
+        jobs.ParallelFor(hits.size(), 61, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                hits[i]++;
+            }
+        });
+
+        // Nested loops wait by helping, so they must not deadlock a small pool
+        std::atomic<size_t> nested(0);
+        jobs.ParallelFor(16, 1, [&](size_t, size_t) {
+            jobs.ParallelFor(100, 7, [&](size_t begin, size_t end) {
+                nested.fetch_add(end - begin);
+            });
+        });
+
+        bool once = std::all_of(hits.begin(), hits.end(), [](uint32_t h) { return h == 1; });
+        return once && nested.load() == 1600;
+    });
+
+    tests.AddTest("JobSystem", "Task graph runs tasks after their predecessors", []() {
+        JobSystem jobs(3);
+        std::mt19937 rng(61);
+        const uint32_t taskCount = 300;
+
+        TaskGraph graph;
+        std::vector<std::atomic<bool>> finished(taskCount);
+        std::vector<std::vector<uint32_t>> before(taskCount);
+        std::atomic<uint32_t> violations(0);
+        std::atomic<uint32_t> runs(0);
+        for (uint32_t i = 0; i < taskCount; ++i) {
+            finished[i].store(false);
+            graph.Add("task" + std::to_string(i), [&, i]() {
+                for (uint32_t p : before[i]) {
+                    if (!finished[p].load()) {
+                        violations.fetch_add(1);
+                    }
+                }
+                runs.fetch_add(1);
+                finished[i].store(true);
+            });
+        }
+        // Random DAG: edges only go from lower to higher ids
+        for (uint32_t i = 1; i < taskCount; ++i) {
+            uint32_t edges = rng() % 4;
+            for (uint32_t e = 0; e < edges; ++e) {
+                uint32_t p = rng() % i;
+                graph.Precede(p, i);
+                before[i].push_back(p);
+            }
+        }
+
+        bool ok = graph.Run(jobs) && runs.load() == taskCount && violations.load() == 0;
+
+        // Reuse: a second Run() sees fresh predecessor counts
+        for (std::atomic<bool>& flag : finished) {
+            flag.store(false);
+        }
+        runs.store(0);
+        return ok && graph.Run(jobs) && runs.load() == taskCount && violations.load() == 0;
+    });
+
+    tests.AddTest("JobSystem", "Cyclic graph is rejected", []() {
+        JobSystem jobs(1);
+        TaskGraph graph;
+        std::atomic<int> runs(0);
+        TaskGraph::TaskId a = graph.Add("a", [&]() { runs++; });
+        TaskGraph::TaskId b = graph.Then(a, "b", [&]() { runs++; });
+        TaskGraph::TaskId c = graph.Then(b, "c", [&]() { runs++; });
+        graph.Precede(c, a);
+        return !graph.Run(jobs) && runs.load() == 0;
+    });
+}
+
+inline void JobSystem::RegisterBenchmarks() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    TestManagerNew::BenchmarkOptions options;
+    options.warmupIterations = 1;
+    options.sampleCount = 7;
+
+    // Frame-shaped graph: 8 independent pipelines of 4 stages, each stage a parallel-for
+    // over 32k elements, joined by one final task. Ideal scaling is linear until the
+    // machine runs out of cores.
+    auto runFrame = [](JobSystem& jobs, std::vector<float>& data) {
+        const size_t pipelines = 8;
+        const size_t stages = 4;
+        const size_t span = data.size() / pipelines;
+        TaskGraph graph;
+        TaskGraph::TaskId join = graph.Add("join", []() {});
+        for (size_t p = 0; p < pipelines; ++p) {
+            float* base = data.data() + p * span;
+            TaskGraph::TaskId previous = 0;
+            for (size_t s = 0; s < stages; ++s) {
+                TaskGraph::TaskId stage = graph.AddParallelFor("stage", span, 1024, [base](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        base[i] = std::sqrt(base[i] * base[i] + 1.0f) * 0.5f;
+                    }
+                });
+                if (s > 0) {
+                    graph.Precede(previous, stage);
+                }
+                previous = stage;
+            }
+            graph.Precede(previous, join);
+        }
+        graph.Run(jobs);
+    };
+
+    std::vector<size_t> threadCounts = {1, 2, 4};
+    if (DefaultThreadCount() > 4) {
+        threadCounts.push_back(DefaultThreadCount());
+    }
+    for (size_t threads : threadCounts) {
+        auto jobs = std::make_shared<JobSystem>(threads - 1);
+        auto data = std::make_shared<std::vector<float>>(8 * 32768, 1.0f);
+        tests.AddBenchmark("JobSystem", "Frame graph " + std::to_string(threads) + " threads", [=]() {
+            runFrame(*jobs, *data);
+            TestManagerNew::DoNotOptimize(data->data());
+        }, options);
+    }
+}
+
+// Note on usage:
+// Parallel::For/ForRange run on JobSystem::Instance(), so asset decoding, bakes and
+// deferred shading share one pool instead of spawning threads per call.
+// SoftwareRenderService::EndFrame builds a TaskGraph per frame (camera -> cull -> bin ->
+// raster -> stats, with host tasks such as UI updates beside them).
@@ -0,0 +1,709 @@
+// JsonBinding.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Single-pass JSON tokenizer and constexpr field tables that bind JSON keys to struct members
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <array>
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Member types a field table can bind
+enum class JsonFieldType {
+    INT,
+    FLOAT,
+    BOOL,
+    STRING
+};
+
+// One row of a schema: a JSON key (dotted for nested objects, e.g. "sun.intensity")
+// bound to a member of T. Tables are constexpr arrays so lookup data lives in .rodata.
+template <typename T>
+struct JsonField {
+    std::string_view key;
+    JsonFieldType type;
+    int T::* intMember;
+    float T::* floatMember;
+    bool T::* boolMember;
+    std::string T::* stringMember;
+
+    constexpr JsonField(std::string_view k, int T::* m)
+        : key(k), type(JsonFieldType::INT), intMember(m), floatMember(nullptr), boolMember(nullptr), stringMember(nullptr) {}
+    constexpr JsonField(std::string_view k, float T::* m)
+        : key(k), type(JsonFieldType::FLOAT), intMember(nullptr), floatMember(m), boolMember(nullptr), stringMember(nullptr) {}
+    constexpr JsonField(std::string_view k, bool T::* m)
+        : key(k), type(JsonFieldType::BOOL), intMember(nullptr), floatMember(nullptr), boolMember(m), stringMember(nullptr) {}
+    constexpr JsonField(std::string_view k, std::string T::* m)
+        : key(k), type(JsonFieldType::STRING), intMember(nullptr), floatMember(nullptr), boolMember(nullptr), stringMember(m) {}
+};
+
+// Pull tokenizer over a JSON document
+// Tokens are views into the source text; nothing is copied unless a string holds escapes
+class JsonReader {
+public:
+    enum class TokenType {
+        OBJECT_BEGIN,
+        OBJECT_END,
+        ARRAY_BEGIN,
+        ARRAY_END,
+        COLON,
+        COMMA,
+        STRING,
+        NUMBER,
+        TRUE_VALUE,
+        FALSE_VALUE,
+        NULL_VALUE,
+        END,
+        ERROR
+    };
+
+    struct Token {
+        TokenType type = TokenType::END;
+        std::string_view text;
+        bool hasEscapes = false;
+    };
+
+    explicit JsonReader(std::string_view json)
+        : mJson(json), mPos(0) {}
+
+    // Advance to the next token
+    Token Next() {
+        SkipWhitespace();
+
+        Token token;
+        if (mPos >= mJson.size()) {
+            token.type = TokenType::END;
+            return token;
+        }
+
+        char c = mJson[mPos];
+        switch (c) {
+            case '{': ++mPos; token.type = TokenType::OBJECT_BEGIN; return token;
+            case '}': ++mPos; token.type = TokenType::OBJECT_END; return token;
+            case '[': ++mPos; token.type = TokenType::ARRAY_BEGIN; return token;
+            case ']': ++mPos; token.type = TokenType::ARRAY_END; return token;
+            case ':': ++mPos; token.type = TokenType::COLON; return token;
+            case ',': ++mPos; token.type = TokenType::COMMA; return token;
+            case '"': return ReadString();
+            case 't': return ReadLiteral("true", TokenType::TRUE_VALUE);
+            case 'f': return ReadLiteral("false", TokenType::FALSE_VALUE);
+            case 'n': return ReadLiteral("null", TokenType::NULL_VALUE);
+            default: break;
+        }
+
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            return ReadNumber();
+        }
+
+        return Fail("unexpected character '" + std::string(1, c) + "'");
+    }
+
+    // Skip the remainder of a value whose first token has already been read
+    bool SkipValue(const Token& first) {
+        if (first.type != TokenType::OBJECT_BEGIN && first.type != TokenType::ARRAY_BEGIN) {
+            return IsScalar(first.type);
+        }
+
+        size_t depth = 1;
+        while (depth > 0) {
+            Token token = Next();
+            switch (token.type) {
+                case TokenType::OBJECT_BEGIN:
+                case TokenType::ARRAY_BEGIN:
+                    ++depth;
+                    break;
+                case TokenType::OBJECT_END:
+                case TokenType::ARRAY_END:
+                    --depth;
+                    break;
+                case TokenType::END:
+                    Fail("unterminated object or array");
+                    return false;
+                case TokenType::ERROR:
+                    return false;
+                default:
+                    break;
+            }
+        }
+        return true;
+    }
+
+    static bool IsScalar(TokenType type) {
+        return type == TokenType::STRING || type == TokenType::NUMBER ||
+               type == TokenType::TRUE_VALUE || type == TokenType::FALSE_VALUE ||
+               type == TokenType::NULL_VALUE;
+    }
+
+    // Decode escape sequences of a string token (only needed when hasEscapes is set)
+    static std::string Unescape(std::string_view raw) {
+        std::string out;
+        out.reserve(raw.size());
+        for (size_t i = 0; i < raw.size(); ++i) {
+            char c = raw[i];
+            if (c != '\\' || i + 1 >= raw.size()) {
+                out.push_back(c);
+                continue;
+            }
+
+            char e = raw[++i];
+            switch (e) {
+                case 'n': out.push_back('\n'); break;
+                case 't': out.push_back('\t'); break;
+                case 'r': out.push_back('\r'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'u': {
+                    // Basic Multilingual Plane only, encoded as UTF-8
+                    uint32_t code = 0;
+                    if (i + 4 < raw.size()) {
+                        std::from_chars(raw.data() + i + 1, raw.data() + i + 5, code, 16);
+                        i += 4;
+                    }
+                    AppendUtf8(out, code);
+                    break;
+                }
+                default: out.push_back(e); break;
+            }
+        }
+        return out;
+    }
+
+    size_t GetOffset() const { return mPos; }
+    const std::string& GetError() const { return mError; }
+
+private:
+    void SkipWhitespace() {
+        while (mPos < mJson.size()) {
+            char c = mJson[mPos];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                return;
+            }
+            ++mPos;
+        }
+    }
+
+    Token ReadString() {
+        Token token;
+        token.type = TokenType::STRING;
+
+        size_t start = ++mPos;
+        while (mPos < mJson.size()) {
+            char c = mJson[mPos];
+            if (c == '"') {
+                token.text = mJson.substr(start, mPos - start);
+                ++mPos;
+                return token;
+            }
+            if (c == '\\') {
+                token.hasEscapes = true;
+                ++mPos;
+            }
+            ++mPos;
+        }
+
+        return Fail("unterminated string");
+    }
+
+    Token ReadNumber() {
+        size_t start = mPos;
+        while (mPos < mJson.size()) {
+            char c = mJson[mPos];
+            bool numeric = (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+            if (!numeric) {
+                break;
+            }
+            ++mPos;
+        }
+
+        Token token;
+        token.type = TokenType::NUMBER;
+        token.text = mJson.substr(start, mPos - start);
+        return token;
+    }
+
+    Token ReadLiteral(std::string_view literal, TokenType type) {
+        if (mJson.compare(mPos, literal.size(), literal) != 0) {
+            return Fail("invalid literal");
+        }
+
+        Token token;
+        token.type = type;
+        token.text = mJson.substr(mPos, literal.size());
+        mPos += literal.size();
+        return token;
+    }
+
+    Token Fail(const std::string& message) {
+        if (mError.empty()) {
+            mError = message + " at offset " + std::to_string(mPos);
+        }
+        Token token;
+        token.type = TokenType::ERROR;
+        return token;
+    }
+
+    static void AppendUtf8(std::string& out, uint32_t code) {
+        if (code < 0x80) {
+            out.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+
+    std::string_view mJson;
+    size_t mPos;
+    std::string mError;
+};
+
+// Reads and writes structs through a JsonField table in one pass over the text
+// Keys missing from the document keep their current value, so defaults act as fallback.
+// Unknown keys and nested objects without bound fields are skipped.
+class JsonBinding {
+public:
+    template <typename T, size_t N>
+    static bool Read(std::string_view json, const std::array<JsonField<T>, N>& fields, T& out,
+                     std::string* outError = nullptr) {
+        JsonReader reader(json);
+        std::string path;
+        std::string error;
+
+        JsonReader::Token first = reader.Next();
+        bool ok = (first.type == JsonReader::TokenType::OBJECT_BEGIN);
+        if (!ok) {
+            error = reader.GetError().empty() ? "document is not a JSON object" : reader.GetError();
+        } else {
+            ok = ReadObject(reader, fields, out, path, 0, error);
+        }
+
+        if (!ok && outError != nullptr) {
+            *outError = error;
+        }
+        return ok;
+    }
+
+    // Append `text` as a JSON string literal. Quotes, backslashes and every control
+    // character below 0x20 are escaped (\n \t \r short, the rest as \u00XX).
+    // The one escaper for JSON the engine and its tools write.
+    static void AppendEscaped(std::string& out, std::string_view text) {
+        static constexpr char HEX[] = "0123456789abcdef";
+        out.push_back('"');
+        for (char c : text) {
+            unsigned char byte = static_cast<unsigned char>(c);
+            switch (c) {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                case '\r': out += "\\r"; break;
+                default:
+                    if (byte < 0x20) {
+                        const char escaped[] = { '\\', 'u', '0', '0', HEX[byte >> 4], HEX[byte & 0xF] };
+                        out.append(escaped, sizeof(escaped));
+                    } else {
+                        out.push_back(c);
+                    }
+                    break;
+            }
+        }
+        out.push_back('"');
+    }
+
+    // `text` as a JSON string literal (see AppendEscaped)
+    static std::string StringLiteral(std::string_view text) {
+        std::string out;
+        out.reserve(text.size() + 2);
+        AppendEscaped(out, text);
+        return out;
+    }
+
+    // Tokenizer, escaping and number binding. Templated on the runner because
+    // TestManagerNew.h includes this header for its baseline escaper.
+    template <typename Tests>
+    static void RegisterTests(Tests& tests);
+
+    // Serialize in table order; consecutive dotted keys with a shared prefix become nested objects
+    template <typename T, size_t N>
+    static std::string Write(const T& value, const std::array<JsonField<T>, N>& fields) {
+        std::string out = "{\n";
+        std::string_view openPrefix;
+        size_t openDepth = 0;
+        bool first = true;
+
+        for (const JsonField<T>& field : fields) {
+            // Close or open nested objects to match this field's prefix
+            size_t dot = field.key.rfind('.');
+            std::string_view prefix = (dot == std::string_view::npos) ? std::string_view() : field.key.substr(0, dot);
+            std::string_view leaf = (dot == std::string_view::npos) ? field.key : field.key.substr(dot + 1);
+
+            size_t common = CommonPrefixDepth(openPrefix, prefix);
+            while (openDepth > common) {
+                out += "\n" + Indent(openDepth) + "}";
+                --openDepth;
+                first = false;
+            }
+            size_t targetDepth = SegmentCount(prefix);
+            while (openDepth < targetDepth) {
+                out += first ? "" : ",\n";
+                out += Indent(openDepth + 1);
+                AppendEscaped(out, Segment(prefix, openDepth));
+                out += ": {\n";
+                ++openDepth;
+                first = true;
+            }
+            openPrefix = prefix;
+
+            out += first ? "" : ",\n";
+            out += Indent(openDepth + 1);
+            AppendEscaped(out, leaf);
+            out += ": ";
+            AppendValue(out, value, field);
+            first = false;
+        }
+
+        while (openDepth > 0) {
+            out += "\n" + Indent(openDepth) + "}";
+            --openDepth;
+        }
+        out += "\n}\n";
+        return out;
+    }
+
+private:
+    static constexpr size_t MAX_NESTING_DEPTH = 64;
+
+    template <typename T, size_t N>
+    static bool ReadObject(JsonReader& reader, const std::array<JsonField<T>, N>& fields, T& out,
+                           std::string& path, size_t depth, std::string& error) {
+        using TokenType = JsonReader::TokenType;
+
+        // Guard: runaway nesting
+        if (depth >= MAX_NESTING_DEPTH) {
+            error = "nesting too deep at offset " + std::to_string(reader.GetOffset());
+            return false;
+        }
+
+        JsonReader::Token token = reader.Next();
+        if (token.type == TokenType::OBJECT_END) {
+            return true;
+        }
+
+        while (true) {
+            if (token.type != TokenType::STRING) {
+                return Fail(reader, "expected key", error);
+            }
+            if (reader.Next().type != TokenType::COLON) {
+                return Fail(reader, "expected ':'", error);
+            }
+
+            size_t pathLength = path.size();
+            if (!path.empty()) {
+                path.push_back('.');
+            }
+            if (token.hasEscapes) {
+                path += JsonReader::Unescape(token.text);
+            } else {
+                path.append(token.text.data(), token.text.size());
+            }
+
+            JsonReader::Token value = reader.Next();
+            bool ok = true;
+            if (value.type == TokenType::OBJECT_BEGIN) {
+                ok = ReadObject(reader, fields, out, path, depth + 1, error);
+            } else if (value.type == TokenType::ARRAY_BEGIN) {
+                ok = reader.SkipValue(value);
+            } else if (JsonReader::IsScalar(value.type)) {
+                const JsonField<T>* field = FindField(fields, path);
+                if (field != nullptr && !Assign(*field, value, out)) {
+                    error = "type mismatch for '" + path + "' at offset " + std::to_string(reader.GetOffset());
+                    return false;
+                }
+            } else {
+                ok = false;
+            }
+
+            if (!ok) {
+                return error.empty() ? Fail(reader, "invalid value", error) : false;
+            }
+            path.resize(pathLength);
+
+            token = reader.Next();
+            if (token.type == TokenType::OBJECT_END) {
+                return true;
+            }
+            if (token.type != TokenType::COMMA) {
+                return Fail(reader, "expected ',' or '}'", error);
+            }
+            token = reader.Next();
+        }
+    }
+
+    static bool Fail(const JsonReader& reader, const std::string& message, std::string& error) {
+        error = reader.GetError().empty()
+            ? message + " at offset " + std::to_string(reader.GetOffset())
+            : reader.GetError();
+        return false;
+    }
+
+    template <typename T, size_t N>
+    static const JsonField<T>* FindField(const std::array<JsonField<T>, N>& fields, std::string_view key) {
+        for (const JsonField<T>& field : fields) {
+            if (field.key.size() == key.size() && field.key == key) {
+                return &field;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    static bool Assign(const JsonField<T>& field, const JsonReader::Token& token, T& out) {
+        using TokenType = JsonReader::TokenType;
+        const char* begin = token.text.data();
+        const char* end = begin + token.text.size();
+
+        switch (field.type) {
+            case JsonFieldType::INT: {
+                if (token.type != TokenType::NUMBER) {
+                    return false;
+                }
+                int value = 0;
+                auto result = std::from_chars(begin, end, value);
+                if (result.ec != std::errc() || result.ptr != end) {
+                    // Accept "800.0" style integers written by other tools, if they fit
+                    double real = 0.0;
+                    if (!ParseWhole(begin, end, real) || !(real >= std::numeric_limits<int>::min()) ||
+                        !(real <= std::numeric_limits<int>::max())) {
+                        return false;
+                    }
+                    value = static_cast<int>(real);
+                }
+                out.*(field.intMember) = value;
+                return true;
+            }
+            case JsonFieldType::FLOAT: {
+                if (token.type != TokenType::NUMBER) {
+                    return false;
+                }
+                float value = 0.0f;
+                auto result = std::from_chars(begin, end, value);
+                if (result.ec != std::errc() || result.ptr != end) {
+                    return false;
+                }
+                out.*(field.floatMember) = value;
+                return true;
+            }
+            case JsonFieldType::BOOL: {
+                if (token.type == TokenType::TRUE_VALUE || token.type == TokenType::FALSE_VALUE) {
+                    out.*(field.boolMember) = (token.type == TokenType::TRUE_VALUE);
+                    return true;
+                }
+                // Legacy files store flags as 0/1
+                double number = 0.0;
+                if (token.type == TokenType::NUMBER && ParseWhole(begin, end, number)) {
+                    out.*(field.boolMember) = (number != 0.0);
+                    return true;
+                }
+                return false;
+            }
+            case JsonFieldType::STRING: {
+                if (token.type != TokenType::STRING) {
+                    return false;
+                }
+                if (token.hasEscapes) {
+                    out.*(field.stringMember) = JsonReader::Unescape(token.text);
+                } else {
+                    (out.*(field.stringMember)).assign(token.text.data(), token.text.size());
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // A number token that parses completely ("1-2" and "1e999" do not)
+    static bool ParseWhole(const char* begin, const char* end, double& out) {
+        auto result = std::from_chars(begin, end, out);
+        return result.ec == std::errc() && result.ptr == end && std::isfinite(out);
+    }
+
+    template <typename T>
+    static void AppendValue(std::string& out, const T& value, const JsonField<T>& field) {
+        char buffer[64];
+        switch (field.type) {
+            case JsonFieldType::INT: {
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), value.*(field.intMember));
+                out.append(buffer, result.ptr);
+                break;
+            }
+            case JsonFieldType::FLOAT: {
+                // Shortest representation that round-trips
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), value.*(field.floatMember));
+                out.append(buffer, result.ptr);
+                break;
+            }
+            case JsonFieldType::BOOL:
+                out += (value.*(field.boolMember)) ? "true" : "false";
+                break;
+            case JsonFieldType::STRING:
+                AppendEscaped(out, value.*(field.stringMember));
+                break;
+        }
+    }
+
+    static std::string Indent(size_t depth) {
+        return std::string(depth * 2, ' ');
+    }
+
+    static size_t SegmentCount(std::string_view prefix) {
+        if (prefix.empty()) {
+            return 0;
+        }
+        size_t count = 1;
+        for (char c : prefix) {
+            count += (c == '.') ? 1 : 0;
+        }
+        return count;
+    }
+
+    static std::string_view Segment(std::string_view prefix, size_t index) {
+        size_t start = 0;
+        for (size_t i = 0; i < index; ++i) {
+            start = prefix.find('.', start) + 1;
+        }
+        size_t end = prefix.find('.', start);
+        return prefix.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+    }
+
+    static size_t CommonPrefixDepth(std::string_view a, std::string_view b) {
+        size_t depth = 0;
+        size_t count = std::min(SegmentCount(a), SegmentCount(b));
+        while (depth < count && Segment(a, depth) == Segment(b, depth)) {
+            ++depth;
+        }
+        return depth;
+    }
+};
+
+namespace JsonBindingTesting {
+
+struct Sample {
+    int count = 7;
+    float scale = 1.0f;
+    bool enabled = false;
+    std::string name = "default";
+};
+
+inline constexpr std::array<JsonField<Sample>, 4> FIELDS = {{
+    { "count",         &Sample::count },
+    { "scale",         &Sample::scale },
+    { "flags.enabled", &Sample::enabled },
+    { "flags.name",    &Sample::name }
+}};
+
+// Read `json` into a default Sample; false when the binding rejects it
+inline bool ReadSample(std::string_view json, Sample& out) {
+    out = Sample();
+    return JsonBinding::Read(json, FIELDS, out);
+}
+
+} // namespace JsonBindingTesting
+
+template <typename Tests>
+void JsonBinding::RegisterTests(Tests& tests) {
+    using JsonBindingTesting::Sample;
+    using JsonBindingTesting::ReadSample;
+    tests.RegisterSuite("JsonBinding");
+
+    tests.AddTest("JsonBinding", "Tokenizer yields every token type and stops at errors", []() {
+        using TokenType = JsonReader::TokenType;
+        JsonReader reader(" {\"a\\\"b\": [1, -2.5e3, true, false, null], \"c\": {}} ");
+        const TokenType expected[] = {
+            TokenType::OBJECT_BEGIN, TokenType::STRING, TokenType::COLON, TokenType::ARRAY_BEGIN,
+            TokenType::NUMBER, TokenType::COMMA, TokenType::NUMBER, TokenType::COMMA, TokenType::TRUE_VALUE,
+            TokenType::COMMA, TokenType::FALSE_VALUE, TokenType::COMMA, TokenType::NULL_VALUE, TokenType::ARRAY_END,
+            TokenType::COMMA, TokenType::STRING, TokenType::COLON, TokenType::OBJECT_BEGIN, TokenType::OBJECT_END,
+            TokenType::OBJECT_END, TokenType::END
+        };
+        bool ok = true;
+        for (TokenType type : expected) {
+            JsonReader::Token token = reader.Next();
+            ok = ok && token.type == type;
+            if (token.type == TokenType::STRING && token.hasEscapes) {
+                ok = ok && JsonReader::Unescape(token.text) == "a\"b";
+            }
+        }
+
+        JsonReader bad("{\"a\": @}");
+        bad.Next(); bad.Next(); bad.Next();
+        JsonReader open("\"never closed");
+        return ok && bad.Next().type == TokenType::ERROR && bad.GetError().find("offset 6") != std::string::npos &&
+               open.Next().type == TokenType::ERROR && !open.GetError().empty();
+    });
+
+    // Every byte below 0x20 must come out escaped, or the document is not JSON
+    tests.AddTest("JsonBinding", "Control characters are escaped and read back", []() {
+        bool ok = JsonBinding::StringLiteral("a\"b\\c\n\t\r") == "\"a\\\"b\\\\c\\n\\t\\r\"" &&
+                  JsonBinding::StringLiteral(std::string("\x01\x1f", 2)) == "\"\\u0001\\u001f\"";
+        for (int c = 0; c < 0x20; ++c) {
+            std::string literal = JsonBinding::StringLiteral(std::string(1, static_cast<char>(c)));
+            ok = ok && std::none_of(literal.begin(), literal.end(),
+                                    [](char ch) { return static_cast<unsigned char>(ch) < 0x20; });
+            JsonReader reader(literal);
+            JsonReader::Token token = reader.Next();
+            ok = ok && token.type == JsonReader::TokenType::STRING &&
+                 JsonReader::Unescape(token.text) == std::string(1, static_cast<char>(c));
+        }
+        return ok;
+    });
+
+    tests.AddTest("JsonBinding", "Field tables round-trip nested keys and escaped strings", []() {
+        Sample written;
+        written.count = -42;
+        written.scale = 0.1f;
+        written.enabled = true;
+        written.name = std::string("tab\tquote\"slash\\bell\x07nul", 24) + std::string(1, '\0');
+        std::string json = JsonBinding::Write(written, JsonBindingTesting::FIELDS);
+
+        Sample read;
+        bool ok = ReadSample(json, read) && read.count == written.count && read.scale == written.scale &&
+                  read.enabled && read.name == written.name && json.find("\"flags\": {") != std::string::npos;
+        for (char c : json) {
+            ok = ok && (static_cast<unsigned char>(c) >= 0x20 || c == '\n');
+        }
+
+        // Missing keys keep their defaults; unknown keys, arrays and objects are skipped
+        return ok && ReadSample("{\"scale\": 2, \"extra\": [1, {\"x\": 2}], \"flags\": {\"other\": {}}}", read) &&
+               read.count == 7 && read.scale == 2.0f && !read.enabled && read.name == "default";
+    });
+
+    tests.AddTest("JsonBinding", "Numbers must parse completely and fit their field", []() {
+        Sample read;
+        bool ok = ReadSample("{\"count\": 800.0, \"flags\": {\"enabled\": 1}}", read) && read.count == 800 &&
+                  read.enabled &&
+                  ReadSample("{\"count\": -2147483648.0}", read) && read.count == std::numeric_limits<int>::min() &&
+                  ReadSample("{\"count\": 2147483647, \"flags\": {\"enabled\": 0}}", read) &&
+                  read.count == std::numeric_limits<int>::max() && !read.enabled;
+
+        // Partially consumed tokens, out-of-range values and overflow to infinity
+        const char* rejected[] = {
+            "{\"count\": 1-2}", "{\"count\": 1.5.5}", "{\"count\": 2147483648.0}", "{\"count\": -3e9}",
+            "{\"count\": 1e999}", "{\"scale\": 1-2}", "{\"scale\": 1e999}", "{\"scale\": 0.5e}",
+            "{\"flags\": {\"enabled\": 1-2}}", "{\"count\": \"12\"}"
+        };
+        for (const char* json : rejected) {
+            ok = ok && !ReadSample(json, read);
+        }
+        return ok;
+    });
+}
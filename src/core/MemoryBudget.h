@@ -0,0 +1,239 @@
+// MemoryBudget.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Soft/hard memory budgets per subsystem with EventBus warnings and a dashboard
+
+#pragma once
+
+#include "MemoryTracker.h"
+#include "EventBus.h"
+#include "DebugWindow.h"
+#include "QuoteSystem.h"
+#include "TestManagerNew.h"
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <mutex>
+#include <ostream>
+#include <iomanip>
+#include <cstdio>
+
+// Where a subsystem stands against its budget
+enum class BudgetState {
+    OK,
+    SOFT,   // Over the soft budget: warn, keep going
+    HARD    // Over the hard budget: caches should evict now
+};
+
+// MemoryBudget samples MemoryTracker once per frame (Poll):
+// - Tracks per-tag high-water marks at frame granularity
+// - Publishes "memory.budget_warning" (soft) and "memory.budget_exceeded" (hard)
+//   with a human-readable string payload, once per transition rather than per frame
+// - Serves the DebugWindow "Memory" page
+class MemoryBudget {
+public:
+    explicit MemoryBudget(MemoryTracker& tracker)
+        : mTracker(tracker)
+    {
+        mStates.fill(BudgetState::OK);
+        mHighWater.fill(0);
+        mCurrent.fill(0);
+    }
+
+    // Engine-wide budgets over MemoryTracker::Instance(); registers the dashboard page
+    static MemoryBudget& Instance() {
+        static MemoryBudget* instance = []() {
+            static MemoryBudget budget(MemoryTracker::Instance());
+            DebugWindow::Instance().RegisterPage("Memory", [](std::ostream& out) {
+                MemoryBudget::Instance().PrintDashboard(out);
+            });
+            return &budget;
+        }();
+        return *instance;
+    }
+
+    // 0 disables a limit. A hard budget below the soft one is raised to match it.
+    void SetBudget(MemoryTag tag, size_t softBytes, size_t hardBytes) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Limits& limits = mLimits[static_cast<size_t>(tag)];
+        limits.softBytes = softBytes;
+        limits.hardBytes = (hardBytes != 0 && hardBytes < softBytes) ? softBytes : hardBytes;
+    }
+
+    // Sample counters, update high-water marks and publish budget transitions
+    void Poll() {
+        struct Transition {
+            MemoryTag tag;
+            BudgetState state;
+            size_t bytes;
+            size_t limit;
+        };
+        std::vector<Transition> transitions;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (size_t t = 0; t < MEMORY_TAG_COUNT; ++t) {
+                MemoryTag tag = static_cast<MemoryTag>(t);
+                size_t bytes = mTracker.CurrentBytes(tag);
+                mCurrent[t] = bytes;
+                mHighWater[t] = std::max(mHighWater[t], bytes);
+
+                const Limits& limits = mLimits[t];
+                BudgetState state = BudgetState::OK;
+                if (limits.hardBytes != 0 && bytes > limits.hardBytes) {
+                    state = BudgetState::HARD;
+                } else if (limits.softBytes != 0 && bytes > limits.softBytes) {
+                    state = BudgetState::SOFT;
+                }
+
+                // Only escalations are announced; dropping back is logged quietly below
+                if (state != mStates[t]) {
+                    size_t limit = state == BudgetState::HARD ? limits.hardBytes : limits.softBytes;
+                    transitions.push_back(Transition{tag, state, bytes, limit});
+                    mStates[t] = state;
+                }
+            }
+        }
+
+        // Published outside the lock: subscribers may query this object
+        for (const Transition& change : transitions) {
+            std::string name = MemoryTracker::TagName(change.tag);
+            if (change.state == BudgetState::OK) {
+                DebugWindow::Instance().Post("Engine", name + " back under budget (" +
+                    FormatBytes(change.bytes) + ")", DebugWindow::DebugLevel::INFO);
+                continue;
+            }
+
+            bool hard = change.state == BudgetState::HARD;
+            std::string message = name + " at " + FormatBytes(change.bytes) + ", over its " +
+                (hard ? "hard" : "soft") + " budget of " + FormatBytes(change.limit);
+            QuoteSystem::Instance().Log(message,
+                hard ? QuoteSystem::MessageType::ERROR_MSG : QuoteSystem::MessageType::WARNING);
+            EventBus::Instance().PublishString(hard ? "memory.budget_exceeded" : "memory.budget_warning", message);
+        }
+    }
+
+    // State as of the last Poll()
+    BudgetState GetState(MemoryTag tag) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStates[static_cast<size_t>(tag)];
+    }
+
+    // Worst state across all tags as of the last Poll()
+    BudgetState WorstState() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        BudgetState worst = BudgetState::OK;
+        for (BudgetState state : mStates) {
+            worst = std::max(worst, state);
+        }
+        return worst;
+    }
+
+    size_t HighWaterBytes(MemoryTag tag) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mHighWater[static_cast<size_t>(tag)];
+    }
+
+    // Table of current / high-water / budgets per tag, as of the last Poll()
+    void PrintDashboard(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        out << std::left << std::setw(16) << "Subsystem" << std::right
+            << std::setw(12) << "Current" << std::setw(12) << "Peak"
+            << std::setw(12) << "Soft" << std::setw(12) << "Hard" << "  State\n";
+        size_t total = 0;
+        for (size_t t = 0; t < MEMORY_TAG_COUNT; ++t) {
+            const Limits& limits = mLimits[t];
+            total += mCurrent[t];
+            out << std::left << std::setw(16) << MemoryTracker::TagName(static_cast<MemoryTag>(t)) << std::right
+                << std::setw(12) << FormatBytes(mCurrent[t])
+                << std::setw(12) << FormatBytes(mHighWater[t])
+                << std::setw(12) << (limits.softBytes != 0 ? FormatBytes(limits.softBytes) : "-")
+                << std::setw(12) << (limits.hardBytes != 0 ? FormatBytes(limits.hardBytes) : "-")
+                << "  " << StateName(mStates[t]) << "\n";
+        }
+        out << std::left << std::setw(16) << "Total" << std::right << std::setw(12) << FormatBytes(total) << "\n";
+    }
+
+    static const char* StateName(BudgetState state) {
+        switch (state) {
+            case BudgetState::SOFT: return "OVER SOFT";
+            case BudgetState::HARD: return "OVER HARD";
+            default:                return "ok";
+        }
+    }
+
+    static std::string FormatBytes(size_t bytes) {
+        const char* units[] = {"B", "KB", "MB", "GB"};
+        double size = static_cast<double>(bytes);
+        int unit = 0;
+        while (size >= 1024.0 && unit < 3) {
+            size /= 1024.0;
+            unit++;
+        }
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.1f %s", size, units[unit]);
+        return buffer;
+    }
+
+    // Transition publishing and high-water tracking
+    static void RegisterTests();
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+private:
+    struct Limits {
+        size_t softBytes = 0;
+        size_t hardBytes = 0;
+    };
+
+    MemoryTracker& mTracker;
+    mutable std::mutex mMutex;
+    std::array<Limits, MEMORY_TAG_COUNT> mLimits;
+    std::array<BudgetState, MEMORY_TAG_COUNT> mStates;
+    std::array<size_t, MEMORY_TAG_COUNT> mHighWater;
+    std::array<size_t, MEMORY_TAG_COUNT> mCurrent;
+};
+
+inline void MemoryBudget::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("MemoryBudget", TestManagerNew::SuiteMode::SERIAL);
+
+    tests.AddTest("MemoryBudget", "Budget transitions publish once", []() {
+        MemoryTracker tracker;
+        MemoryBudget budget(tracker);
+        budget.SetBudget(MemoryTag::TEXTURE_CACHE, 1000, 2000);
+
+        int warnings = 0;
+        int exceeded = 0;
+        size_t warningId = EventBus::Instance().Subscribe("memory.budget_warning",
+            [&](const EventBus::EventPayload&) { warnings++; });
+        size_t exceededId = EventBus::Instance().Subscribe("memory.budget_exceeded",
+            [&](const EventBus::EventPayload&) { exceeded++; });
+
+        tracker.Add(MemoryTag::TEXTURE_CACHE, 1500);
+        budget.Poll();
+        budget.Poll(); // Still soft: no second warning
+        bool soft = budget.GetState(MemoryTag::TEXTURE_CACHE) == BudgetState::SOFT;
+
+        tracker.Add(MemoryTag::TEXTURE_CACHE, 1000);
+        budget.Poll();
+        bool hard = budget.WorstState() == BudgetState::HARD;
+
+        tracker.Release(MemoryTag::TEXTURE_CACHE, 2500);
+        budget.Poll();
+
+        EventBus::Instance().Unsubscribe(warningId);
+        EventBus::Instance().Unsubscribe(exceededId);
+        return soft && hard && warnings == 1 && exceeded == 1 &&
+               budget.GetState(MemoryTag::TEXTURE_CACHE) == BudgetState::OK &&
+               budget.HighWaterBytes(MemoryTag::TEXTURE_CACHE) == 2500;
+    });
+}
+
+// Note on usage:
+// Render services call MemoryBudget::Instance().Poll() at the end of each frame;
+// StatusBar reads MemoryTracker totals and WorstState() every Update. Budgets come from
+// the host (config or tests) via SetBudget(); without one a tag is tracked but never warns.
+// DebugWindow::Instance().PrintPage("Memory") prints the dashboard.
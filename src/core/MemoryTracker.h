@@ -0,0 +1,248 @@
+// MemoryTracker.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Lock-free per-subsystem byte counters and tagged STL allocators
+
+#pragma once
+
+#include "TestManagerNew.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+
+// Subsystems that own long-lived heap memory. Budgets (MemoryBudget.h) and the
+// DebugWindow "Memory" page are keyed by these.
+enum class MemoryTag : uint8_t {
+    FILE_SERVICE,
+    ASSET_INDEX,
+    MESH_CACHE,
+    TEXTURE_CACHE,
+    EVENT_BUS,
+    UI,
+    GPU_BUFFERS,
+    FRAME_ARENA,
+    STRINGS,
+    COUNT
+};
+
+constexpr size_t MEMORY_TAG_COUNT = static_cast<size_t>(MemoryTag::COUNT);
+
+// MemoryTracker counts bytes per tag without locks on the hot path:
+// - Every thread gets its own cache-line-aligned block of counters the first time
+//   it reports; only that thread writes it
+// - Readers sum the blocks, so totals are exact once writers are quiescent and a
+//   close approximation while they run
+// - Bytes released on a different thread than they were added simply make one
+//   block go negative; the sum is still right
+// Blocks outlive their threads (a pool thread's history still counts); a thread id
+// reused by the OS adopts the old block, which only ever adds to the same sum.
+class MemoryTracker {
+public:
+    MemoryTracker() : mId(NextId()) {}
+
+    // Never destroyed: statics torn down at exit (EventBus, caches) still release into it
+    static MemoryTracker& Instance() {
+        static MemoryTracker* instance = new MemoryTracker();
+        return *instance;
+    }
+
+    static const char* TagName(MemoryTag tag) {
+        switch (tag) {
+            case MemoryTag::FILE_SERVICE:  return "FileService";
+            case MemoryTag::ASSET_INDEX:   return "AssetIndex";
+            case MemoryTag::MESH_CACHE:    return "Mesh cache";
+            case MemoryTag::TEXTURE_CACHE: return "Texture cache";
+            case MemoryTag::EVENT_BUS:     return "EventBus";
+            case MemoryTag::UI:            return "UI";
+            case MemoryTag::GPU_BUFFERS:   return "GPU buffers";
+            case MemoryTag::FRAME_ARENA:   return "Frame arena";
+            case MemoryTag::STRINGS:       return "String table";
+            default:                       return "Unknown";
+        }
+    }
+
+    void Add(MemoryTag tag, size_t bytes) {
+        LocalBlock().bytes[static_cast<size_t>(tag)].fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    void Release(MemoryTag tag, size_t bytes) {
+        LocalBlock().bytes[static_cast<size_t>(tag)].fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    // Bytes currently held by one subsystem
+    size_t CurrentBytes(MemoryTag tag) const {
+        int64_t sum = 0;
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (const std::unique_ptr<Block>& block : mBlocks) {
+            sum += block->bytes[static_cast<size_t>(tag)].load(std::memory_order_relaxed);
+        }
+        return sum > 0 ? static_cast<size_t>(sum) : 0;
+    }
+
+    size_t TotalBytes() const {
+        size_t total = 0;
+        for (size_t t = 0; t < MEMORY_TAG_COUNT; ++t) {
+            total += CurrentBytes(static_cast<MemoryTag>(t));
+        }
+        return total;
+    }
+
+    // Heap bytes owned by a string (0 while it fits the small-string buffer)
+    static size_t StringBytes(const std::string& value) {
+        return value.capacity() > std::string().capacity() ? value.capacity() + 1 : 0;
+    }
+
+    // Counter accuracy across threads and the tagged allocator
+    static void RegisterTests();
+
+    MemoryTracker(const MemoryTracker&) = delete;
+    MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+private:
+    struct alignas(64) Block {
+        std::atomic<int64_t> bytes[MEMORY_TAG_COUNT];
+        std::thread::id owner;
+
+        explicit Block(std::thread::id ownerThread) : owner(ownerThread) {
+            for (std::atomic<int64_t>& counter : bytes) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    static constexpr size_t THREAD_CACHE_SIZE = 4;
+
+    // Ids (not addresses) key the thread cache, so a tracker created where an old
+    // one was destroyed never inherits its blocks
+    static uint64_t NextId() {
+        static std::atomic<uint64_t> next(1);
+        return next.fetch_add(1);
+    }
+
+    Block& LocalBlock() {
+        // Plain arrays (no destructor) so releases from static destructors at exit stay valid
+        struct CacheEntry {
+            uint64_t trackerId;
+            Block* block;
+        };
+        thread_local CacheEntry cache[THREAD_CACHE_SIZE] = {};
+        thread_local size_t nextSlot = 0;
+        for (const CacheEntry& entry : cache) {
+            if (entry.trackerId == mId) {
+                return *entry.block;
+            }
+        }
+
+        // Cache miss: find this thread's block (evicted earlier) or register a new one
+        std::thread::id self = std::this_thread::get_id();
+        Block* block = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (const std::unique_ptr<Block>& candidate : mBlocks) {
+                if (candidate->owner == self) {
+                    block = candidate.get();
+                    break;
+                }
+            }
+            if (block == nullptr) {
+                mBlocks.push_back(std::make_unique<Block>(self));
+                block = mBlocks.back().get();
+            }
+        }
+        cache[nextSlot] = CacheEntry{mId, block};
+        nextSlot = (nextSlot + 1) % THREAD_CACHE_SIZE;
+        return *block;
+    }
+
+    const uint64_t mId;
+    mutable std::mutex mMutex; // Guards mBlocks (registration and summing only)
+    std::vector<std::unique_ptr<Block>> mBlocks;
+};
+
+// Standard allocator that reports its bytes to MemoryTracker::Instance() under Tag
+template <typename T, MemoryTag Tag>
+class TrackedAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = TrackedAllocator<U, Tag>;
+    };
+
+    TrackedAllocator() noexcept = default;
+    template <typename U>
+    TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(size_t count) {
+        T* p = std::allocator<T>().allocate(count);
+        MemoryTracker::Instance().Add(Tag, count * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, size_t count) noexcept {
+        MemoryTracker::Instance().Release(Tag, count * sizeof(T));
+        std::allocator<T>().deallocate(p, count);
+    }
+
+    template <typename U>
+    bool operator==(const TrackedAllocator<U, Tag>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const TrackedAllocator<U, Tag>&) const noexcept { return false; }
+};
+
+template <typename T, MemoryTag Tag>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+
+inline void MemoryTracker::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("MemoryTracker", TestManagerNew::SuiteMode::SERIAL);
+
+    tests.AddTest("MemoryTracker", "Per-thread counters sum exactly", []() {
+        MemoryTracker tracker;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&tracker, t]() {
+                for (int i = 0; i < 10000; ++i) {
+                    tracker.Add(MemoryTag::MESH_CACHE, 64);
+                    if (i % 2 == 0) {
+                        tracker.Release(MemoryTag::MESH_CACHE, 64);
+                    }
+                }
+                tracker.Add(MemoryTag::UI, static_cast<size_t>(t) + 1);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        // Release on a thread that never added: that block goes negative, the sum holds
+        tracker.Release(MemoryTag::MESH_CACHE, 64 * 1000);
+        return tracker.CurrentBytes(MemoryTag::MESH_CACHE) == 64 * (4 * 5000 - 1000) &&
+               tracker.CurrentBytes(MemoryTag::UI) == 10 &&
+               tracker.TotalBytes() == 64 * 19000 + 10;
+    });
+
+    tests.AddTest("MemoryTracker", "Tagged allocator reports container bytes", []() {
+        MemoryTracker& tracker = MemoryTracker::Instance();
+        size_t before = tracker.CurrentBytes(MemoryTag::EVENT_BUS);
+        size_t during = 0;
+        {
+            TrackedVector<uint64_t, MemoryTag::EVENT_BUS> values;
+            values.reserve(1000);
+            during = tracker.CurrentBytes(MemoryTag::EVENT_BUS);
+        }
+        return during == before + 1000 * sizeof(uint64_t) && tracker.CurrentBytes(MemoryTag::EVENT_BUS) == before;
+    });
+}
+
+// Note on usage:
+// Containers a subsystem owns outright use TrackedVector / TrackedAllocator. Records
+// whose bytes live in nested containers (AssetInfo, SoftwareMesh, IblData) are reported
+// with Add/Release at the point they enter and leave their owner. MemoryBudget.h turns
+// these counters into budgets, EventBus warnings and the DebugWindow "Memory" page.
@@ -0,0 +1,39 @@
+// Parallel.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Minimal data-parallel loops for CPU-heavy asset and bake work
+
+#pragma once
+
+#include "JobSystem.h"
+#include <cstddef>
+
+// Parallel::For hands out indices from a shared atomic counter, so uneven work
+// balances itself. Loops run on the shared JobSystem pool and the calling thread
+// participates; nested calls help drain the pool while they wait.
+class Parallel {
+public:
+    // Thread count used when callers pass 0
+    static size_t DefaultWorkerCount() {
+        return JobSystem::DefaultThreadCount();
+    }
+
+    // fn(index) for every index in [0, count); workerCount caps the threads taking part
+    template <typename Fn>
+    static void For(size_t count, Fn&& fn, size_t workerCount = 0) {
+        JobSystem::Instance().ParallelFor(count, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                fn(i);
+            }
+        }, workerCount);
+    }
+
+    // fn(begin, end) over [0, count) in chunks of `grain`; use for cheap per-item work
+    template <typename Fn>
+    static void ForRange(size_t count, size_t grain, Fn&& fn, size_t workerCount = 0) {
+        JobSystem::Instance().ParallelFor(count, grain, fn, workerCount);
+    }
+
+    // Prevent instantiation (static API)
+    Parallel() = delete;
+};
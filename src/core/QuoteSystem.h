@@ -246,10 +246,17 @@ private:
         }
     }
 
+    // Reentrant localtime: Log() runs on JobSystem workers and test-runner threads at once
     std::string GetTimestamp() {
         std::time_t now = std::time(nullptr);
+        std::tm local{};
+#if defined(_WIN32)
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
         char buffer[20];
-        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
         return std::string(buffer);
     }
 
@@ -0,0 +1,550 @@
+// ResidencyManager.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Per-class byte budgets with LRU demotion/eviction and coarse-first re-streaming
+
+#pragma once
+
+#include "HandlePool.h"
+#include "QuoteSystem.h"
+#include "DebugWindow.h"
+#include "TestManagerNew.h"
+#include <array>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <functional>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+// Asset classes with independent budgets
+enum class ResidencyClass : uint8_t {
+    MESH,
+    TEXTURE,
+    COUNT
+};
+
+constexpr size_t RESIDENCY_CLASS_COUNT = static_cast<size_t>(ResidencyClass::COUNT);
+
+using ResidencyId = uint32_t;
+constexpr ResidencyId INVALID_RESIDENCY_ID = 0;
+
+// Returned by a level callback that could not reach the requested level
+constexpr size_t RESIDENCY_LOAD_FAILED = std::numeric_limits<size_t>::max();
+
+// Default cap on level changes toward finer detail per Update()
+constexpr size_t RESIDENCY_STREAMS_PER_FRAME = 4;
+
+// ResidencyManager decides what stays in memory; owners do the actual loading:
+// - Each asset has a ladder of levels: 0 is full detail, lodCount - 1 the coarsest,
+//   lodCount means evicted. The owner's callback moves the asset to a level and
+//   returns the bytes now resident.
+// - Touch() marks an asset used this frame (SubmitMesh, texture binds). Resident
+//   assets sit in a per-class LRU list, so victims come from its stale end
+//   without scanning every asset.
+// - Update() (once per frame) first refines wanted assets one level per frame,
+//   coarsest first, making room by demoting stale assets; then, while a class is
+//   over budget, demotes stale assets in LRU order: every stale asset drops toward
+//   its coarsest level before any is evicted outright. Assets touched in the
+//   current frame are never demoted.
+// - Refinement that cannot fit even after demoting everything stale waits, so a
+//   returning asset stays at a coarse level instead of blowing the budget.
+// Callbacks run without the manager's lock held and may call back into it.
+class ResidencyManager {
+public:
+    // Move the asset to `level` (lodCount = evict); return resident bytes or RESIDENCY_LOAD_FAILED
+    using LevelFunction = std::function<size_t(uint32_t level)>;
+
+    struct ClassStats {
+        size_t budgetBytes = 0;   // 0 = unlimited
+        size_t residentBytes = 0;
+        size_t residentCount = 0;
+        uint64_t demotions = 0;   // Steps toward coarser (including evictions)
+        uint64_t evictions = 0;
+        uint64_t streams = 0;     // Steps toward finer
+    };
+
+    ResidencyManager() {
+        DebugWindow::Instance().RegisterChannel("Residency");
+    }
+
+    static const char* ClassName(ResidencyClass residencyClass) {
+        switch (residencyClass) {
+            case ResidencyClass::MESH:    return "Mesh";
+            case ResidencyClass::TEXTURE: return "Texture";
+            default:                      return "Unknown";
+        }
+    }
+
+    // 0 disables the budget for that class
+    void SetBudget(ResidencyClass residencyClass, size_t bytes) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClasses[static_cast<size_t>(residencyClass)].stats.budgetBytes = bytes;
+    }
+
+    // Track an asset currently resident at `level` with `bytes`, as most recently used
+    ResidencyId Register(ResidencyClass residencyClass, uint32_t lodCount, uint32_t level, size_t bytes,
+                         LevelFunction setLevel) {
+        // Guard: malformed registration
+        if (lodCount == 0 || level > lodCount || !setLevel) {
+            QuoteSystem::Instance().Log("ResidencyManager: invalid registration", QuoteSystem::MessageType::WARNING);
+            return INVALID_RESIDENCY_ID;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        Entry entry;
+        entry.residencyClass = residencyClass;
+        entry.lodCount = lodCount;
+        entry.level = level;
+        entry.bytes = level < lodCount ? bytes : 0;
+        entry.levelBytes.assign(lodCount, 0);
+        if (level < lodCount) {
+            entry.levelBytes[level] = bytes;
+        }
+        entry.lastUsedFrame = mFrame;
+        entry.setLevel = std::move(setLevel);
+
+        ResidencyId id = mEntries.Insert(std::move(entry));
+        if (id == INVALID_RESIDENCY_ID) {
+            return INVALID_RESIDENCY_ID;
+        }
+        Entry& stored = *mEntries.Get(id);
+        if (stored.level < stored.lodCount) {
+            ClassState& state = mClasses[static_cast<size_t>(residencyClass)];
+            state.stats.residentBytes += stored.bytes;
+            state.stats.residentCount++;
+            LinkFront(state, id, stored);
+        }
+        return id;
+    }
+
+    // Stop tracking (the owner has released the asset itself)
+    void Unregister(ResidencyId id) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Entry* entry = mEntries.Get(id);
+        if (entry == nullptr) {
+            return;
+        }
+        if (entry->level < entry->lodCount) {
+            ClassState& state = mClasses[static_cast<size_t>(entry->residencyClass)];
+            state.stats.residentBytes -= entry->bytes;
+            state.stats.residentCount--;
+            Unlink(state, *entry);
+        }
+        mEntries.Remove(id);
+    }
+
+    // Mark used this frame; non-full-detail assets are queued to refine in Update()
+    void Touch(ResidencyId id) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Entry* entry = mEntries.Get(id);
+        if (entry == nullptr || entry->lastUsedFrame == mFrame) {
+            return;
+        }
+        entry->lastUsedFrame = mFrame;
+        if (entry->level < entry->lodCount) {
+            ClassState& state = mClasses[static_cast<size_t>(entry->residencyClass)];
+            Unlink(state, *entry);
+            LinkFront(state, id, *entry);
+        }
+        if (entry->level > 0 && !entry->wanted) {
+            entry->wanted = true;
+            mWanted.push_back(id);
+        }
+    }
+
+    bool IsResident(ResidencyId id) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const Entry* entry = mEntries.Get(id);
+        return entry != nullptr && entry->level < entry->lodCount;
+    }
+
+    // Current level (lodCount when evicted, UINT32_MAX for unknown ids)
+    uint32_t Level(ResidencyId id) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const Entry* entry = mEntries.Get(id);
+        return entry != nullptr ? entry->level : UINT32_MAX;
+    }
+
+    ClassStats GetStats(ResidencyClass residencyClass) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mClasses[static_cast<size_t>(residencyClass)].stats;
+    }
+
+    void SetStreamsPerFrame(size_t count) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStreamsPerFrame = std::max<size_t>(count, 1);
+    }
+
+    // Refine wanted assets, then enforce budgets; call once per frame after draws are submitted
+    void Update() {
+        RefineWanted();
+        for (size_t c = 0; c < RESIDENCY_CLASS_COUNT; ++c) {
+            ResidencyClass residencyClass = static_cast<ResidencyClass>(c);
+            size_t budget = GetStats(residencyClass).budgetBytes;
+            if (budget != 0 && !DemoteUntil(residencyClass, budget)) {
+                ReportOverBudget(residencyClass);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFrame++;
+    }
+
+    // LRU order, demotion/eviction, coarse-first refinement
+    static void RegisterTests();
+
+    ResidencyManager(const ResidencyManager&) = delete;
+    ResidencyManager& operator=(const ResidencyManager&) = delete;
+
+private:
+    struct Entry {
+        ResidencyClass residencyClass = ResidencyClass::MESH;
+        uint32_t lodCount = 1;
+        uint32_t level = 0;
+        size_t bytes = 0;
+        std::vector<size_t> levelBytes; // Last observed bytes per level (0 = unknown)
+        uint64_t lastUsedFrame = 0;
+        ResidencyId prev = INVALID_RESIDENCY_ID; // Toward most recently used
+        ResidencyId next = INVALID_RESIDENCY_ID; // Toward least recently used
+        bool wanted = false;
+        LevelFunction setLevel;
+    };
+
+    struct ClassState {
+        ClassStats stats;
+        ResidencyId head = INVALID_RESIDENCY_ID; // Most recently used resident asset
+        ResidencyId tail = INVALID_RESIDENCY_ID; // Least recently used resident asset
+        bool overBudgetReported = false;
+    };
+
+    void LinkFront(ClassState& state, ResidencyId id, Entry& entry) {
+        entry.prev = INVALID_RESIDENCY_ID;
+        entry.next = state.head;
+        if (state.head != INVALID_RESIDENCY_ID) {
+            mEntries.Get(state.head)->prev = id;
+        } else {
+            state.tail = id;
+        }
+        state.head = id;
+    }
+
+    void Unlink(ClassState& state, Entry& entry) {
+        if (entry.prev != INVALID_RESIDENCY_ID) {
+            mEntries.Get(entry.prev)->next = entry.next;
+        } else {
+            state.head = entry.next;
+        }
+        if (entry.next != INVALID_RESIDENCY_ID) {
+            mEntries.Get(entry.next)->prev = entry.prev;
+        } else {
+            state.tail = entry.prev;
+        }
+        entry.prev = INVALID_RESIDENCY_ID;
+        entry.next = INVALID_RESIDENCY_ID;
+    }
+
+    // Run the owner's callback outside the lock and book the result
+    bool ApplyLevel(ResidencyId id, uint32_t level) {
+        LevelFunction setLevel;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            Entry* entry = mEntries.Get(id);
+            if (entry == nullptr || entry->level == level) {
+                return false;
+            }
+            setLevel = entry->setLevel;
+        }
+
+        size_t bytes = setLevel(level);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        Entry* entry = mEntries.Get(id);
+        if (entry == nullptr) {
+            return false;
+        }
+        if (bytes == RESIDENCY_LOAD_FAILED) {
+            DebugWindow::Instance().Post("Residency", std::string(ClassName(entry->residencyClass)) +
+                " asset " + std::to_string(id) + " failed to reach level " + std::to_string(level),
+                DebugWindow::DebugLevel::WARN);
+            return false;
+        }
+
+        ClassState& state = mClasses[static_cast<size_t>(entry->residencyClass)];
+        bool wasResident = entry->level < entry->lodCount;
+        bool isResident = level < entry->lodCount;
+        if (level < entry->level) {
+            state.stats.streams++;
+        } else {
+            state.stats.demotions++;
+            state.stats.evictions += isResident ? 0 : 1;
+        }
+
+        state.stats.residentBytes = state.stats.residentBytes - entry->bytes + (isResident ? bytes : 0);
+        entry->bytes = isResident ? bytes : 0;
+        entry->level = level;
+        if (isResident) {
+            entry->levelBytes[level] = bytes;
+        }
+
+        if (wasResident && !isResident) {
+            Unlink(state, *entry);
+            state.stats.residentCount--;
+        } else if (!wasResident && isResident) {
+            // Only wanted (recently touched) assets come back, so they start as most recent
+            LinkFront(state, id, *entry);
+            state.stats.residentCount++;
+        }
+        return true;
+    }
+
+    // Least recently used asset not used this frame that can still drop a level short of
+    // eviction; failing that, the least recently used stale asset (to evict). Walks only
+    // the stale end of the list.
+    ResidencyId FindVictim(const ClassState& state, ResidencyId exclude) const {
+        ResidencyId evictCandidate = INVALID_RESIDENCY_ID;
+        for (ResidencyId id = state.tail; id != INVALID_RESIDENCY_ID; ) {
+            const Entry* entry = mEntries.Get(id);
+            if (entry->lastUsedFrame == mFrame) {
+                break; // Everything nearer the head is newer still
+            }
+            if (id != exclude) {
+                if (entry->level + 1 < entry->lodCount) {
+                    return id;
+                }
+                if (evictCandidate == INVALID_RESIDENCY_ID) {
+                    evictCandidate = id;
+                }
+            }
+            id = entry->prev;
+        }
+        return evictCandidate;
+    }
+
+    // Demote stale assets one level at a time until the class fits `targetBytes`
+    bool DemoteUntil(ResidencyClass residencyClass, size_t targetBytes, ResidencyId exclude = INVALID_RESIDENCY_ID) {
+        ClassState& state = mClasses[static_cast<size_t>(residencyClass)];
+        while (true) {
+            ResidencyId victim = INVALID_RESIDENCY_ID;
+            uint32_t nextLevel = 0;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (state.stats.residentBytes <= targetBytes) {
+                    state.overBudgetReported = false;
+                    return true;
+                }
+                victim = FindVictim(state, exclude);
+                if (victim == INVALID_RESIDENCY_ID) {
+                    return false;
+                }
+                nextLevel = mEntries.Get(victim)->level + 1;
+            }
+            if (!ApplyLevel(victim, nextLevel)) {
+                // A failing owner must not stall eviction: drop it from consideration
+                std::lock_guard<std::mutex> lock(mMutex);
+                Entry* entry = mEntries.Get(victim);
+                if (entry != nullptr && entry->level < entry->lodCount) {
+                    Unlink(state, *entry);
+                    LinkFront(state, victim, *entry);
+                    entry->lastUsedFrame = mFrame;
+                }
+            }
+        }
+    }
+
+    void RefineWanted() {
+        std::vector<ResidencyId> wanted;
+        size_t streamsPerFrame = 0;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            wanted.swap(mWanted);
+            streamsPerFrame = mStreamsPerFrame;
+
+            // Most recently touched first; stale requests are dropped
+            wanted.erase(std::remove_if(wanted.begin(), wanted.end(), [this](ResidencyId id) {
+                Entry* entry = mEntries.Get(id);
+                if (entry == nullptr) {
+                    return true;
+                }
+                entry->wanted = false;
+                return entry->level == 0 || entry->lastUsedFrame + 1 < mFrame;
+            }), wanted.end());
+            std::stable_sort(wanted.begin(), wanted.end(), [this](ResidencyId a, ResidencyId b) {
+                return mEntries.Get(a)->lastUsedFrame > mEntries.Get(b)->lastUsedFrame;
+            });
+        }
+
+        size_t streamed = 0;
+        std::vector<ResidencyId> deferred;
+        for (ResidencyId id : wanted) {
+            if (streamed >= streamsPerFrame) {
+                deferred.push_back(id);
+                continue;
+            }
+
+            ResidencyClass residencyClass = ResidencyClass::MESH;
+            uint32_t target = 0;
+            size_t growth = 0;
+            size_t resident = 0;
+            size_t budget = 0;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                Entry* entry = mEntries.Get(id);
+                if (entry == nullptr) {
+                    continue;
+                }
+                // Evicted assets come back at their coarsest level, then refine one step per frame
+                target = entry->level >= entry->lodCount ? entry->lodCount - 1 : entry->level - 1;
+                residencyClass = entry->residencyClass;
+                const ClassState& state = mClasses[static_cast<size_t>(residencyClass)];
+                budget = state.stats.budgetBytes;
+                resident = state.stats.residentBytes;
+                // Unknown sizes (never resident at that level) are assumed to fit; the
+                // budget pass below corrects any overshoot
+                size_t targetBytes = entry->levelBytes[target];
+                growth = targetBytes > entry->bytes ? targetBytes - entry->bytes : 0;
+            }
+
+            bool fits = budget == 0 || resident + growth <= budget ||
+                        (growth <= budget && DemoteUntil(residencyClass, budget - growth, id));
+            if (!fits) {
+                deferred.push_back(id);
+                continue;
+            }
+            if (ApplyLevel(id, target)) {
+                streamed++;
+            }
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            Entry* entry = mEntries.Get(id);
+            if (entry != nullptr && entry->level > 0) {
+                deferred.push_back(id); // Keep refining next frame while it stays in use
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (ResidencyId id : deferred) {
+            Entry* entry = mEntries.Get(id);
+            if (entry != nullptr && !entry->wanted) {
+                entry->wanted = true;
+                mWanted.push_back(id);
+            }
+        }
+    }
+
+    void ReportOverBudget(ResidencyClass residencyClass) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ClassState& state = mClasses[static_cast<size_t>(residencyClass)];
+        if (state.overBudgetReported) {
+            return;
+        }
+        state.overBudgetReported = true;
+        DebugWindow::Instance().Post("Residency", std::string(ClassName(residencyClass)) +
+            " assets in use this frame exceed the budget (" + std::to_string(state.stats.residentBytes) +
+            " of " + std::to_string(state.stats.budgetBytes) + " bytes)", DebugWindow::DebugLevel::WARN);
+    }
+
+    mutable std::mutex mMutex;
+    HandlePool<Entry> mEntries;
+    std::array<ClassState, RESIDENCY_CLASS_COUNT> mClasses;
+    std::vector<ResidencyId> mWanted;
+    size_t mStreamsPerFrame = RESIDENCY_STREAMS_PER_FRAME;
+    uint64_t mFrame = 1; // Starts past 0 so "never used" differs from "used in frame 0"
+};
+
+inline void ResidencyManager::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("ResidencyManager");
+
+    // Fake assets: level 0 = 100 bytes, level 1 = 10 bytes, level 2 = evicted
+    struct FakeAssets {
+        std::vector<uint32_t> levels;
+        std::vector<uint32_t> history;
+
+        ResidencyManager::LevelFunction For(uint32_t index) {
+            return [this, index](uint32_t level) -> size_t {
+                levels[index] = level;
+                history.push_back(index * 10 + level);
+                return level == 0 ? 100 : (level == 1 ? 10 : 0);
+            };
+        }
+    };
+
+    tests.AddTest("ResidencyManager", "Least recently used assets are demoted first", []() {
+        ResidencyManager residency;
+        FakeAssets assets;
+        assets.levels.assign(4, 0);
+        std::vector<ResidencyId> ids;
+        for (uint32_t i = 0; i < 4; ++i) {
+            ids.push_back(residency.Register(ResidencyClass::MESH, 2, 0, 100, assets.For(i)));
+        }
+        residency.Update();
+
+        // Asset 0 used most recently, then 2; 1 and 3 are stale. 400 -> budget 250.
+        residency.Touch(ids[2]);
+        residency.Touch(ids[0]);
+        residency.SetBudget(ResidencyClass::MESH, 250);
+        residency.Update();
+
+        ClassStats stats = residency.GetStats(ResidencyClass::MESH);
+        return assets.levels[0] == 0 && assets.levels[2] == 0 && assets.levels[1] == 1 && assets.levels[3] == 1 &&
+               stats.residentBytes == 220 && stats.demotions == 2 && stats.evictions == 0;
+    });
+
+    tests.AddTest("ResidencyManager", "Eviction and coarse-first re-streaming", []() {
+        ResidencyManager residency;
+        FakeAssets assets;
+        assets.levels.assign(3, 0);
+        std::vector<ResidencyId> ids;
+        for (uint32_t i = 0; i < 3; ++i) {
+            ids.push_back(residency.Register(ResidencyClass::MESH, 2, 0, 100, assets.For(i)));
+        }
+        residency.Update();
+
+        // Only asset 0 in use with room for 100 bytes: both others are demoted, then evicted
+        residency.SetBudget(ResidencyClass::MESH, 100);
+        residency.Touch(ids[0]);
+        residency.Update();
+        bool evicted = !residency.IsResident(ids[1]) && !residency.IsResident(ids[2]) &&
+                       residency.GetStats(ResidencyClass::MESH).evictions == 2;
+
+        // Asset 1 comes back: proxy first while 0 is still in use, full once 0 goes stale
+        residency.SetBudget(ResidencyClass::MESH, 110);
+        residency.Touch(ids[0]);
+        residency.Touch(ids[1]);
+        residency.Update();
+        bool proxyFirst = residency.Level(ids[1]) == 1 && residency.Level(ids[0]) == 0;
+
+        residency.Touch(ids[1]);
+        residency.Update();
+        ClassStats stats = residency.GetStats(ResidencyClass::MESH);
+        return evicted && proxyFirst && residency.Level(ids[1]) == 0 && residency.Level(ids[0]) == 1 &&
+               stats.residentBytes == 110 && stats.streams == 2;
+    });
+
+    tests.AddTest("ResidencyManager", "In-use assets are never evicted", []() {
+        ResidencyManager residency;
+        FakeAssets assets;
+        assets.levels.assign(2, 0);
+        ResidencyId a = residency.Register(ResidencyClass::TEXTURE, 1, 0, 100, assets.For(0));
+        ResidencyId b = residency.Register(ResidencyClass::TEXTURE, 1, 0, 100, assets.For(1));
+        residency.SetBudget(ResidencyClass::TEXTURE, 50);
+        residency.Touch(a);
+        residency.Touch(b);
+        residency.Update();
+        bool kept = residency.IsResident(a) && residency.IsResident(b);
+
+        residency.Unregister(a);
+        residency.Touch(b);
+        residency.Update();
+        return kept && residency.IsResident(b) && residency.GetStats(ResidencyClass::TEXTURE).residentBytes == 100 &&
+               residency.GetStats(ResidencyClass::MESH).residentBytes == 0;
+    });
+}
+
+// Note on usage:
+// SoftwareRenderService registers each mesh with three levels (full, MeshLod proxy,
+// evicted), touches it from SubmitMesh and calls Update() in EndFrame. Budgets come from
+// RenderConfig::meshBudgetMB / textureBudgetMB.
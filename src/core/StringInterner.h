@@ -0,0 +1,537 @@
+// StringInterner.h
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Sharded, thread-safe string and path interning with stable 32-bit ids
+
+#pragma once
+
+#include "MemoryTracker.h"
+#include "QuoteSystem.h"
+#include "TestManagerNew.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// Interned string id; 0 is the empty/invalid id and View(0) is ""
+using StringId = uint32_t;
+constexpr StringId INVALID_STRING_ID = 0;
+
+// Interned path id (a node in the path tree); 0 is the empty path
+using PathId = uint32_t;
+constexpr PathId INVALID_PATH_ID = 0;
+
+// Ids pack a shard (high bits) and a 1-based index within that shard (low bits)
+constexpr uint32_t INTERN_SHARD_BITS = 4;
+constexpr uint32_t INTERN_SHARD_COUNT = 1u << INTERN_SHARD_BITS;
+constexpr uint32_t INTERN_INDEX_BITS = 32 - INTERN_SHARD_BITS;
+constexpr uint32_t INTERN_INDEX_MASK = (1u << INTERN_INDEX_BITS) - 1;
+constexpr uint32_t INTERN_PAGE_BITS = 10;
+constexpr uint32_t INTERN_PAGE_SIZE = 1u << INTERN_PAGE_BITS;
+constexpr uint32_t INTERN_MAX_PAGES = 2048; // 2M entries per shard, 32M in total
+constexpr size_t INTERN_ARENA_CHUNK_SIZE = 16 * 1024;
+
+// Append-only table of entries in fixed pages. Entries never move, so readers index
+// it without the shard lock: an id is only handed out after its entry is written,
+// and the page pointer is published with release/acquire.
+template <typename Entry>
+class InternPages {
+public:
+    InternPages() {
+        for (std::atomic<Entry*>& page : mPages) {
+            page.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~InternPages() {
+        for (std::atomic<Entry*>& page : mPages) {
+            Entry* entries = page.load(std::memory_order_relaxed);
+            if (entries != nullptr) {
+                MemoryTracker::Instance().Release(MemoryTag::STRINGS, sizeof(Entry) * INTERN_PAGE_SIZE);
+                delete[] entries;
+            }
+        }
+    }
+
+    // Append under the owner's lock; returns the 0-based index, or UINT32_MAX when full
+    uint32_t Push(const Entry& entry) {
+        uint32_t index = mCount;
+        uint32_t pageIndex = index >> INTERN_PAGE_BITS;
+        if (pageIndex >= INTERN_MAX_PAGES) {
+            return UINT32_MAX;
+        }
+        Entry* page = mPages[pageIndex].load(std::memory_order_relaxed);
+        if (page == nullptr) {
+            page = new Entry[INTERN_PAGE_SIZE];
+            MemoryTracker::Instance().Add(MemoryTag::STRINGS, sizeof(Entry) * INTERN_PAGE_SIZE);
+            mPages[pageIndex].store(page, std::memory_order_release);
+        }
+        page[index & (INTERN_PAGE_SIZE - 1)] = entry;
+        mCount++;
+        return index;
+    }
+
+    // Lock-free read of an entry whose index was obtained from Push()
+    const Entry* At(uint32_t index) const {
+        uint32_t pageIndex = index >> INTERN_PAGE_BITS;
+        if (pageIndex >= INTERN_MAX_PAGES) {
+            return nullptr;
+        }
+        const Entry* page = mPages[pageIndex].load(std::memory_order_acquire);
+        return page != nullptr ? &page[index & (INTERN_PAGE_SIZE - 1)] : nullptr;
+    }
+
+    uint32_t Count() const { return mCount; }
+
+    InternPages(const InternPages&) = delete;
+    InternPages& operator=(const InternPages&) = delete;
+
+private:
+    std::atomic<Entry*> mPages[INTERN_MAX_PAGES];
+    uint32_t mCount = 0; // Guarded by the owner's lock
+};
+
+// StringInterner stores each distinct string once:
+// - 16 shards picked by hash, each with its own mutex, map and character arena,
+//   so loader threads interning different strings rarely contend
+// - Characters live in 16 KB arena chunks (NUL-terminated), never moved or freed,
+//   so View() stays valid for the process lifetime
+// - Ids are stable and small; equal strings have equal ids, so comparisons and
+//   hash keys become integer operations
+// Instance() is never destroyed, so ids held by statics stay resolvable at exit.
+class StringInterner {
+public:
+    StringInterner() = default;
+
+    static StringInterner& Instance() {
+        static StringInterner* instance = new StringInterner();
+        return *instance;
+    }
+
+    // Id for `value`, inserting it on first sight ("" is always INVALID_STRING_ID)
+    StringId Intern(std::string_view value) {
+        if (value.empty()) {
+            return INVALID_STRING_ID;
+        }
+
+        size_t hash = std::hash<std::string_view>()(value);
+        uint32_t shardIndex = ShardOf(hash);
+        Shard& shard = mShards[shardIndex];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.lookup.find(value);
+        if (it != shard.lookup.end()) {
+            return it->second;
+        }
+
+        std::string_view stored = shard.Store(value);
+        uint32_t index = shard.entries.Push(stored);
+        if (index == UINT32_MAX) {
+            QuoteSystem::Instance().Log("StringInterner shard full", QuoteSystem::MessageType::ERROR_MSG);
+            return INVALID_STRING_ID;
+        }
+
+        StringId id = MakeId(shardIndex, index);
+        shard.lookup.emplace(stored, id);
+        MemoryTracker::Instance().Add(MemoryTag::STRINGS, LOOKUP_NODE_BYTES);
+        return id;
+    }
+
+    // Id for `value` if it was interned before, INVALID_STRING_ID otherwise (never inserts)
+    StringId Find(std::string_view value) const {
+        if (value.empty()) {
+            return INVALID_STRING_ID;
+        }
+
+        size_t hash = std::hash<std::string_view>()(value);
+        const Shard& shard = mShards[ShardOf(hash)];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.lookup.find(value);
+        return it != shard.lookup.end() ? it->second : INVALID_STRING_ID;
+    }
+
+    // Lock-free; the view is NUL-terminated and valid for the interner's lifetime
+    std::string_view View(StringId id) const {
+        if (id == INVALID_STRING_ID) {
+            return std::string_view();
+        }
+        const std::string_view* entry = mShards[id >> INTERN_INDEX_BITS].entries.At((id & INTERN_INDEX_MASK) - 1);
+        return entry != nullptr ? *entry : std::string_view();
+    }
+
+    std::string Str(StringId id) const {
+        return std::string(View(id));
+    }
+
+    size_t Count() const {
+        size_t count = 0;
+        for (const Shard& shard : mShards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            count += shard.entries.Count();
+        }
+        return count;
+    }
+
+    // Characters stored across all arenas (excluding chunk slack)
+    size_t StoredBytes() const {
+        size_t bytes = 0;
+        for (const Shard& shard : mShards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            bytes += shard.storedBytes;
+        }
+        return bytes;
+    }
+
+    // Dedup, concurrency and path-tree tests
+    static void RegisterTests();
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+private:
+    // Approximate hash node cost reported per distinct string
+    static constexpr size_t LOOKUP_NODE_BYTES = sizeof(std::string_view) + sizeof(StringId) + 2 * sizeof(void*);
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string_view, StringId> lookup;
+        InternPages<std::string_view> entries;
+        std::vector<std::unique_ptr<char[]>> chunks;
+        char* cursor = nullptr;
+        size_t remaining = 0;
+        size_t storedBytes = 0;
+        size_t chunkBytes = 0;
+
+        ~Shard() {
+            MemoryTracker::Instance().Release(MemoryTag::STRINGS, chunkBytes + lookup.size() * LOOKUP_NODE_BYTES);
+        }
+
+        // Copy into the arena (caller holds the lock); long strings get a chunk of their own
+        std::string_view Store(std::string_view value) {
+            size_t needed = value.size() + 1;
+            char* dest = nullptr;
+            if (needed > INTERN_ARENA_CHUNK_SIZE / 4) {
+                chunks.push_back(std::make_unique<char[]>(needed));
+                dest = chunks.back().get();
+                chunkBytes += needed;
+                MemoryTracker::Instance().Add(MemoryTag::STRINGS, needed);
+            } else {
+                if (needed > remaining) {
+                    chunks.push_back(std::make_unique<char[]>(INTERN_ARENA_CHUNK_SIZE));
+                    cursor = chunks.back().get();
+                    remaining = INTERN_ARENA_CHUNK_SIZE;
+                    chunkBytes += INTERN_ARENA_CHUNK_SIZE;
+                    MemoryTracker::Instance().Add(MemoryTag::STRINGS, INTERN_ARENA_CHUNK_SIZE);
+                }
+                dest = cursor;
+                cursor += needed;
+                remaining -= needed;
+            }
+            std::memcpy(dest, value.data(), value.size());
+            dest[value.size()] = '\0';
+            storedBytes += value.size();
+            return std::string_view(dest, value.size());
+        }
+    };
+
+    static uint32_t ShardOf(size_t hash) {
+        // High bits: std::hash low bits also pick the map bucket inside the shard
+        return static_cast<uint32_t>(hash >> (sizeof(size_t) * 8 - INTERN_SHARD_BITS));
+    }
+
+    static StringId MakeId(uint32_t shard, uint32_t index) {
+        return (shard << INTERN_INDEX_BITS) | (index + 1);
+    }
+
+    Shard mShards[INTERN_SHARD_COUNT];
+};
+
+// PathInterner stores paths as a tree of (parent, segment) nodes, segments being
+// StringIds. "textures/env/sky.hdr" and "textures/env/ground.hdr" share the
+// "textures" and "textures/env" nodes, so a 500k-file project pays one node plus
+// one filename per file instead of a full path string each.
+// - Separators are normalized to '/', empty and "." segments are dropped; a leading
+//   '/' becomes a root segment so absolute and relative paths stay distinct
+// - Equal normalized paths get equal ids; Resolve() rebuilds the string on demand
+class PathInterner {
+public:
+    explicit PathInterner(StringInterner& strings)
+        : mStrings(strings)
+    {}
+
+    static PathInterner& Instance() {
+        static PathInterner* instance = new PathInterner(StringInterner::Instance());
+        return *instance;
+    }
+
+    // Id for `path`, inserting missing nodes; "" yields INVALID_PATH_ID
+    PathId Intern(std::string_view path) {
+        PathId node = INVALID_PATH_ID;
+        bool complete = true;
+        ForEachSegment(path, [&](std::string_view segment) {
+            node = AddChild(node, mStrings.Intern(segment));
+            complete = node != INVALID_PATH_ID;
+            return complete;
+        });
+        return complete ? node : INVALID_PATH_ID;
+    }
+
+    // Id for `path` if every node exists already, INVALID_PATH_ID otherwise (never inserts)
+    PathId Find(std::string_view path) const {
+        PathId node = INVALID_PATH_ID;
+        bool found = true;
+        ForEachSegment(path, [&](std::string_view segment) {
+            StringId segmentId = mStrings.Find(segment);
+            node = segmentId != INVALID_STRING_ID ? FindChild(node, segmentId) : INVALID_PATH_ID;
+            found = node != INVALID_PATH_ID;
+            return found;
+        });
+        return found ? node : INVALID_PATH_ID;
+    }
+
+    // Normalized path string ("" for INVALID_PATH_ID)
+    std::string Resolve(PathId id) const {
+        // Collect segments leaf-to-root, then join root-first
+        StringId segments[MAX_DEPTH];
+        size_t depth = 0;
+        size_t length = 0;
+        for (PathId node = id; node != INVALID_PATH_ID && depth < MAX_DEPTH; ) {
+            const Node* entry = NodeAt(node);
+            if (entry == nullptr) {
+                break;
+            }
+            segments[depth++] = entry->segment;
+            length += mStrings.View(entry->segment).size() + 1;
+            node = entry->parent;
+        }
+
+        std::string result;
+        result.reserve(length);
+        for (size_t i = depth; i > 0; --i) {
+            std::string_view segment = mStrings.View(segments[i - 1]);
+            if (!result.empty() && result.back() != '/') {
+                result += '/';
+            }
+            result += segment;
+        }
+        return result;
+    }
+
+    // Last segment (file or directory name)
+    StringId FileName(PathId id) const {
+        const Node* entry = NodeAt(id);
+        return entry != nullptr ? entry->segment : INVALID_STRING_ID;
+    }
+
+    PathId Parent(PathId id) const {
+        const Node* entry = NodeAt(id);
+        return entry != nullptr ? entry->parent : INVALID_PATH_ID;
+    }
+
+    // True if `ancestor` is `id` or one of its parent directories
+    bool IsWithin(PathId id, PathId ancestor) const {
+        for (PathId node = id; node != INVALID_PATH_ID; node = Parent(node)) {
+            if (node == ancestor) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t NodeCount() const {
+        size_t count = 0;
+        for (const Shard& shard : mShards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            count += shard.nodes.Count();
+        }
+        return count;
+    }
+
+    PathInterner(const PathInterner&) = delete;
+    PathInterner& operator=(const PathInterner&) = delete;
+
+private:
+    static constexpr size_t MAX_DEPTH = 256;
+    static constexpr size_t LOOKUP_NODE_BYTES = sizeof(uint64_t) + sizeof(PathId) + 2 * sizeof(void*);
+
+    struct Node {
+        PathId parent = INVALID_PATH_ID;
+        StringId segment = INVALID_STRING_ID;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<uint64_t, PathId> lookup; // (parent << 32 | segment) -> node
+        InternPages<Node> nodes;
+
+        ~Shard() {
+            MemoryTracker::Instance().Release(MemoryTag::STRINGS, lookup.size() * LOOKUP_NODE_BYTES);
+        }
+    };
+
+    // Calls visit(segment) per normalized segment until it returns false
+    template <typename Visit>
+    static void ForEachSegment(std::string_view path, Visit&& visit) {
+        size_t start = 0;
+        if (!path.empty() && (path[0] == '/' || path[0] == '\\')) {
+            if (!visit(std::string_view("/"))) {
+                return;
+            }
+            start = 1;
+        }
+        while (start < path.size()) {
+            size_t end = start;
+            while (end < path.size() && path[end] != '/' && path[end] != '\\') {
+                end++;
+            }
+            std::string_view segment = path.substr(start, end - start);
+            if (!segment.empty() && segment != ".") {
+                if (!visit(segment)) {
+                    return;
+                }
+            }
+            start = end + 1;
+        }
+    }
+
+    static uint64_t ChildKey(PathId parent, StringId segment) {
+        return (static_cast<uint64_t>(parent) << 32) | segment;
+    }
+
+    static uint32_t ShardOf(uint64_t key) {
+        return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - INTERN_SHARD_BITS));
+    }
+
+    PathId FindChild(PathId parent, StringId segment) const {
+        uint64_t key = ChildKey(parent, segment);
+        const Shard& shard = mShards[ShardOf(key)];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.lookup.find(key);
+        return it != shard.lookup.end() ? it->second : INVALID_PATH_ID;
+    }
+
+    PathId AddChild(PathId parent, StringId segment) {
+        uint64_t key = ChildKey(parent, segment);
+        uint32_t shardIndex = ShardOf(key);
+        Shard& shard = mShards[shardIndex];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.lookup.find(key);
+        if (it != shard.lookup.end()) {
+            return it->second;
+        }
+
+        uint32_t index = shard.nodes.Push(Node{parent, segment});
+        if (index == UINT32_MAX) {
+            QuoteSystem::Instance().Log("PathInterner shard full", QuoteSystem::MessageType::ERROR_MSG);
+            return INVALID_PATH_ID;
+        }
+        PathId id = (shardIndex << INTERN_INDEX_BITS) | (index + 1);
+        shard.lookup.emplace(key, id);
+        MemoryTracker::Instance().Add(MemoryTag::STRINGS, LOOKUP_NODE_BYTES);
+        return id;
+    }
+
+    const Node* NodeAt(PathId id) const {
+        if (id == INVALID_PATH_ID) {
+            return nullptr;
+        }
+        return mShards[id >> INTERN_INDEX_BITS].nodes.At((id & INTERN_INDEX_MASK) - 1);
+    }
+
+    StringInterner& mStrings;
+    Shard mShards[INTERN_SHARD_COUNT];
+};
+
+inline void StringInterner::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("StringInterner");
+
+    tests.AddTest("StringInterner", "Equal strings share one id and view", []() {
+        std::unique_ptr<StringInterner> interner = std::make_unique<StringInterner>();
+        StringInterner& strings = *interner;
+        StringId a = strings.Intern("sky.hdr");
+        StringId b = strings.Intern(std::string("sky") + ".hdr");
+        StringId c = strings.Intern("ground.hdr");
+        std::string longValue(INTERN_ARENA_CHUNK_SIZE, 'x');
+        StringId d = strings.Intern(longValue);
+        return a == b && a != c && a != INVALID_STRING_ID && strings.View(a) == "sky.hdr" &&
+               strings.View(a).data() == strings.View(b).data() && strings.View(a).data()[7] == '\0' &&
+               strings.View(d) == longValue && strings.Find("missing") == INVALID_STRING_ID &&
+               strings.Intern("") == INVALID_STRING_ID && strings.View(INVALID_STRING_ID).empty() &&
+               strings.Count() == 3;
+    });
+
+    tests.AddTest("StringInterner", "Concurrent interning agrees on ids", []() {
+        std::unique_ptr<StringInterner> interner = std::make_unique<StringInterner>();
+        StringInterner& strings = *interner;
+        constexpr int THREADS = 4;
+        constexpr int NAMES = 5000;
+        std::vector<std::vector<StringId>> ids(THREADS, std::vector<StringId>(NAMES));
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&strings, &ids, t]() {
+                // Each thread walks the names in a different order
+                for (int i = 0; i < NAMES; ++i) {
+                    int name = (i + t * 1237) % NAMES;
+                    ids[t][name] = strings.Intern("asset_" + std::to_string(name));
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (int i = 0; i < NAMES; ++i) {
+            for (int t = 1; t < THREADS; ++t) {
+                if (ids[t][i] != ids[0][i]) {
+                    return false;
+                }
+            }
+            if (strings.View(ids[0][i]) != "asset_" + std::to_string(i)) {
+                return false;
+            }
+        }
+        return strings.Count() == NAMES;
+    });
+
+    tests.AddTest("StringInterner", "Paths share directory nodes", []() {
+        std::unique_ptr<StringInterner> interner = std::make_unique<StringInterner>();
+        std::unique_ptr<PathInterner> pathInterner = std::make_unique<PathInterner>(*interner);
+        StringInterner& strings = *interner;
+        PathInterner& paths = *pathInterner;
+        PathId sky = paths.Intern("assets/textures/env/sky.hdr");
+        PathId ground = paths.Intern("assets\\textures\\env\\ground.hdr");
+        PathId same = paths.Intern("assets//textures/./env/sky.hdr");
+        PathId absolute = paths.Intern("/assets/textures/env/sky.hdr");
+        size_t nodes = paths.NodeCount(); // assets, textures, env, sky, ground + "/" and 4 under it
+
+        return sky == same && sky != ground && sky != absolute && nodes == 10 &&
+               paths.Parent(sky) == paths.Parent(ground) &&
+               paths.Resolve(sky) == "assets/textures/env/sky.hdr" &&
+               paths.Resolve(ground) == "assets/textures/env/ground.hdr" &&
+               paths.Resolve(absolute) == "/assets/textures/env/sky.hdr" &&
+               strings.View(paths.FileName(ground)) == "ground.hdr" &&
+               paths.IsWithin(ground, paths.Find("assets/textures")) &&
+               paths.Find("assets/textures/env/sky.hdr") == sky &&
+               paths.Find("assets/meshes/env/sky.hdr") == INVALID_PATH_ID &&
+               paths.Intern("") == INVALID_PATH_ID;
+    });
+}
+
+// Note on usage:
+// FileService, AssetIndex, the UI FileList and SoftwareRenderService's texture table
+// hold PathId / StringId instead of strings. Resolve to text only at boundaries
+// (logging, events, file I/O): PathInterner::Instance().Resolve(id) or
+// StringInterner::Instance().View(id). Interned storage is never freed, which suits
+// asset paths and names; do not intern per-frame or unbounded user text.
@@ -1,7 +1,8 @@
 // TestManagerNew.h
 // Developer: Marcus Daley
 // Date: April 2026
-// Purpose: Enhanced test suite system with QuoteSystem integration and default engine tests
+// Purpose: Enhanced test suite system with QuoteSystem integration, parallel execution,
+//          microbenchmarks with baseline regression checks, and default engine tests
 
 #pragma once
 
@@ -11,33 +12,95 @@
 #include <functional>
 #include <mutex>
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <chrono>
 #include <filesystem>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
 #include "QuoteSystem.h"
+#include "JsonBinding.h"
 
 class TestManagerNew {
 public:
     using TestFunction = std::function<bool()>;
+    using BenchmarkFunction = std::function<void()>;
+
+    // How RunAll schedules a suite. SERIAL suites run one at a time after the parallel
+    // batch, with nothing else running: use it for any suite that asserts on process-wide
+    // state (EventBus subscriptions, MemoryTracker totals, mounts on the global VFS)
+    enum class SuiteMode {
+        PARALLEL,
+        SERIAL
+    };
 
     struct TestCase {
         std::string name;
         TestFunction testFunc;
         bool enabled;
+        bool timedOut;
         std::chrono::milliseconds executionTime;
 
         TestCase(const std::string& n, TestFunction fn)
-            : name(n), testFunc(fn), enabled(true), executionTime(0) {}
+            : name(n), testFunc(fn), enabled(true), timedOut(false), executionTime(0) {}
     };
 
     struct TestSuite {
         std::string name;
         std::vector<TestCase> tests;
         bool enabled;
+        SuiteMode mode;
         size_t passedCount;
         size_t failedCount;
 
-        TestSuite(const std::string& n)
-            : name(n), enabled(true), passedCount(0), failedCount(0) {}
+        TestSuite(const std::string& n, SuiteMode m = SuiteMode::PARALLEL)
+            : name(n), enabled(true), mode(m), passedCount(0), failedCount(0) {}
+    };
+
+    // Benchmark tuning knobs
+    // Iteration count is calibrated so each sample runs for at least minSampleTimeMs
+    struct BenchmarkOptions {
+        size_t warmupIterations;
+        size_t sampleCount;
+        double minSampleTimeMs;
+        size_t maxIterationsPerSample;
+        double maxRegressionPercent;
+
+        BenchmarkOptions()
+            : warmupIterations(3), sampleCount(15), minSampleTimeMs(10.0),
+              maxIterationsPerSample(1u << 24), maxRegressionPercent(10.0) {}
+    };
+
+    // Statistical summary of one benchmark run (all times are per iteration)
+    struct BenchmarkStats {
+        std::string name;
+        size_t iterationsPerSample = 0;
+        size_t samples = 0;
+        double medianNs = 0.0;
+        double madNs = 0.0;
+        double meanNs = 0.0;
+        double minNs = 0.0;
+        double ciLowNs = 0.0;
+        double ciHighNs = 0.0;
+    };
+
+    struct BenchmarkCase {
+        std::string suite;
+        std::string name;
+        BenchmarkFunction body;
+        BenchmarkOptions options;
+        BenchmarkStats lastStats;
+
+        BenchmarkCase(const std::string& s, const std::string& n, BenchmarkFunction fn, const BenchmarkOptions& opts)
+            : suite(s), name(n), body(fn), options(opts) {}
+
+        std::string Key() const { return suite + "/" + name; }
     };
 
     // Singleton accessor
@@ -47,19 +110,9 @@ public:
     }
 
     // Register a new test suite
-    void RegisterSuite(const std::string& suiteName) {
+    void RegisterSuite(const std::string& suiteName, SuiteMode mode = SuiteMode::PARALLEL) {
         std::lock_guard<std::mutex> lock(mMutex);
-
-        // Guard: suite already exists
-        if (mSuites.find(suiteName) != mSuites.end()) {
-            QuoteSystem::Instance().Log("Suite '" + suiteName + "' already registered",
-                                        QuoteSystem::MessageType::WARNING);
-            return;
-        }
-
-        mSuites[suiteName] = TestSuite(suiteName);
-        QuoteSystem::Instance().Log("Registered test suite: " + suiteName,
-                                    QuoteSystem::MessageType::INFO);
+        RegisterSuiteInternal(suiteName, mode);
     }
 
     // Add a test to a suite
@@ -71,8 +124,7 @@ public:
         if (it == mSuites.end()) {
             QuoteSystem::Instance().Log("Suite '" + suiteName + "' not found. Auto-registering.",
                                         QuoteSystem::MessageType::WARNING);
-            mSuites[suiteName] = TestSuite(suiteName);
-            it = mSuites.find(suiteName);
+            it = mSuites.emplace(suiteName, TestSuite(suiteName)).first;
         }
 
         it->second.tests.emplace_back(testName, testFunc);
@@ -80,48 +132,192 @@ public:
                                     QuoteSystem::MessageType::DEBUG);
     }
 
-    // Run all enabled test suites
-    void RunAll() {
+    // Add a microbenchmark to a suite
+    // The body is one iteration; the runner decides how many iterations make a sample
+    void AddBenchmark(const std::string& suiteName, const std::string& benchName, BenchmarkFunction body,
+                      const BenchmarkOptions& options = BenchmarkOptions()) {
         std::lock_guard<std::mutex> lock(mMutex);
 
-        // Guard: no suites registered
-        if (mSuites.empty()) {
-            QuoteSystem::Instance().Log("No test suites registered", QuoteSystem::MessageType::WARNING);
+        // Guard: empty body
+        if (!body) {
+            QuoteSystem::Instance().Log("Benchmark '" + benchName + "' has no body",
+                                        QuoteSystem::MessageType::WARNING);
             return;
         }
 
-        QuoteSystem::Instance().Log("Running all test suites...", QuoteSystem::MessageType::INFO);
+        mBenchmarks.emplace_back(suiteName, benchName, body, options);
+        QuoteSystem::Instance().Log("Added benchmark '" + benchName + "' to suite '" + suiteName + "'",
+                                    QuoteSystem::MessageType::DEBUG);
+    }
 
-        for (auto& [name, suite] : mSuites) {
-            if (suite.enabled) {
-                RunSuiteInternal(suite);
+    // Run all enabled test suites, sharded across the worker pool
+    // Returns true when every test passed
+    bool RunAll() {
+        std::lock_guard<std::mutex> runLock(mRunMutex);
+
+        std::vector<TestSuite> work;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            // Guard: no suites registered
+            if (mSuites.empty()) {
+                QuoteSystem::Instance().Log("No test suites registered", QuoteSystem::MessageType::WARNING);
+                return true;
+            }
+
+            // Snapshot so tests may register new tests without invalidating the run
+            for (const auto& [name, suite] : mSuites) {
+                if (suite.enabled) {
+                    work.push_back(suite);
+                }
             }
         }
 
-        PrintSummary();
+        std::vector<size_t> parallel;
+        std::vector<size_t> serial;
+        for (size_t i = 0; i < work.size(); ++i) {
+            (work[i].mode == SuiteMode::SERIAL ? serial : parallel).push_back(i);
+        }
+
+        size_t workerCount = std::max<size_t>(1, std::min(GetWorkerCount(), parallel.size()));
+        QuoteSystem::Instance().Log("Running all test suites on " + std::to_string(workerCount) + " worker(s), " +
+                                    std::to_string(serial.size()) + " serially...",
+                                    QuoteSystem::MessageType::INFO);
+
+        // Each worker claims whole suites so suite-local fixtures never run concurrently
+        TestWatchdog watchdog(workerCount, GetTestTimeout());
+        std::atomic<size_t> nextSuite{0};
+        auto worker = [this, &work, &parallel, &nextSuite, &watchdog](size_t slot) {
+            for (size_t i = nextSuite.fetch_add(1); i < parallel.size(); i = nextSuite.fetch_add(1)) {
+                RunSuiteInternal(work[parallel[i]], watchdog, slot);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (size_t i = 1; i < workerCount; ++i) {
+            pool.emplace_back(worker, i);
+        }
+        worker(0);
+        for (auto& thread : pool) {
+            thread.join();
+        }
+
+        // Pool joined: singleton-bound suites see no other test running
+        for (size_t index : serial) {
+            RunSuiteInternal(work[index], watchdog, 0);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& suite : work) {
+            StoreResults(suite);
+        }
+
+        return PrintSummary();
     }
 
     // Run a specific test suite
-    void RunSuite(const std::string& suiteName) {
+    bool RunSuite(const std::string& suiteName) {
+        std::lock_guard<std::mutex> runLock(mRunMutex);
+
+        std::vector<TestSuite> work;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            // Guard: suite doesn't exist
+            auto it = mSuites.find(suiteName);
+            if (it == mSuites.end()) {
+                QuoteSystem::Instance().Log("Suite '" + suiteName + "' not found",
+                                            QuoteSystem::MessageType::ERROR_MSG);
+                return false;
+            }
+
+            // Guard: suite disabled
+            if (!it->second.enabled) {
+                QuoteSystem::Instance().Log("Suite '" + suiteName + "' is disabled",
+                                            QuoteSystem::MessageType::WARNING);
+                return false;
+            }
+
+            work.push_back(it->second);
+        }
+
+        {
+            TestWatchdog watchdog(1, GetTestTimeout());
+            RunSuiteInternal(work[0], watchdog, 0);
+        }
+
         std::lock_guard<std::mutex> lock(mMutex);
+        StoreResults(work[0]);
+        PrintSuiteSummary(work[0]);
+        return work[0].failedCount == 0;
+    }
 
-        // Guard: suite doesn't exist
-        auto it = mSuites.find(suiteName);
-        if (it == mSuites.end()) {
-            QuoteSystem::Instance().Log("Suite '" + suiteName + "' not found",
+    // Run every registered benchmark serially (parallel runs would perturb timings)
+    // When baselinePath names an existing file, any benchmark whose median regressed
+    // beyond its threshold fails the run. Returns true when no regression was found.
+    bool RunBenchmarks(const std::string& baselinePath = "") {
+        std::lock_guard<std::mutex> runLock(mRunMutex);
+
+        std::vector<BenchmarkCase> work;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            work = mBenchmarks;
+        }
+
+        // Guard: nothing to run
+        if (work.empty()) {
+            QuoteSystem::Instance().Log("No benchmarks registered", QuoteSystem::MessageType::WARNING);
+            return true;
+        }
+
+        std::unordered_map<std::string, BenchmarkStats> baseline;
+        if (!baselinePath.empty() && std::filesystem::exists(baselinePath)) {
+            baseline = LoadBaseline(baselinePath);
+        }
+
+        size_t regressions = 0;
+        for (auto& bench : work) {
+            bench.lastStats = MeasureBenchmark(bench);
+            PrintBenchmarkStats(bench.lastStats);
+
+            auto it = baseline.find(bench.Key());
+            if (it != baseline.end() && IsRegression(bench.lastStats, it->second, bench.options)) {
+                ++regressions;
+                QuoteSystem::Instance().Log("REGRESSION: " + bench.Key() + " median " +
+                                            FormatNs(bench.lastStats.medianNs) + " vs baseline " +
+                                            FormatNs(it->second.medianNs),
+                                            QuoteSystem::MessageType::ERROR_MSG);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mLastBenchmarkResults = work;
+        }
+
+        if (regressions > 0) {
+            QuoteSystem::Instance().Log(std::to_string(regressions) + " benchmark(s) regressed",
                                         QuoteSystem::MessageType::ERROR_MSG);
-            return;
+            return false;
         }
 
-        // Guard: suite disabled
-        if (!it->second.enabled) {
-            QuoteSystem::Instance().Log("Suite '" + suiteName + "' is disabled",
+        QuoteSystem::Instance().Log("Benchmarks complete (" + std::to_string(work.size()) + " run)",
+                                    QuoteSystem::MessageType::SUCCESS);
+        return true;
+    }
+
+    // Write the results of the last RunBenchmarks() call as the new baseline
+    bool SaveBenchmarkBaseline(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // Guard: nothing measured yet
+        if (mLastBenchmarkResults.empty()) {
+            QuoteSystem::Instance().Log("SaveBenchmarkBaseline: no benchmark results to save",
                                         QuoteSystem::MessageType::WARNING);
-            return;
+            return false;
         }
 
-        RunSuiteInternal(it->second);
-        PrintSuiteSummary(it->second);
+        return WriteBaseline(path, mLastBenchmarkResults);
     }
 
     // Enable or disable a test suite
@@ -142,6 +338,19 @@ public:
                                     QuoteSystem::MessageType::INFO);
     }
 
+    // Number of worker threads used by RunAll (0 = hardware concurrency)
+    void SetWorkerCount(size_t count) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mWorkerCount = count;
+    }
+
+    // Per-test timeout; a test still running after this is reported as timed out and counted
+    // as failed once it returns (0 = no timeout)
+    void SetTestTimeout(std::chrono::milliseconds timeout) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTestTimeout = timeout;
+    }
+
     // Get test results
     void GetResults(size_t& total, size_t& passed, size_t& failed) {
         std::lock_guard<std::mutex> lock(mMutex);
@@ -157,13 +366,67 @@ public:
         }
     }
 
+    // Get statistics from the last RunBenchmarks() call
+    std::vector<BenchmarkStats> GetBenchmarkResults() {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        std::vector<BenchmarkStats> results;
+        results.reserve(mLastBenchmarkResults.size());
+        for (const auto& bench : mLastBenchmarkResults) {
+            results.push_back(bench.lastStats);
+        }
+        return results;
+    }
+
+    // Keep the optimizer from discarding a benchmark's result
+    template <typename T>
+    static void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile char sink;
+        sink = *reinterpret_cast<const volatile char*>(&value);
+#endif
+    }
+
+    // Heap allocation counting for tests that assert a path never allocates. Only
+    // threads that opted in with CountHeapAllocations(true) are counted, and only in
+    // a runner whose replacement operator new calls NoteHeapAllocation()
+    // (src/tests/engine_tests.cpp); HeapCountingActive() reports whether that is so.
+    static void CountHeapAllocations(bool enabled) {
+        CountingThisThread() = enabled;
+    }
+
+    static void NoteHeapAllocation() {
+        std::atomic<bool>& hooked = HeapCountingHooked();
+        if (!hooked.load(std::memory_order_relaxed)) {
+            hooked.store(true, std::memory_order_relaxed);
+        }
+        if (CountingThisThread()) {
+            HeapAllocationCounter().fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    static uint64_t HeapAllocations() {
+        return HeapAllocationCounter().load(std::memory_order_relaxed);
+    }
+
+    // True once the runner's operator new has reported any allocation (registering
+    // the tests allocates, so this is settled before the first test runs)
+    static bool HeapCountingActive() {
+        return HeapCountingHooked().load(std::memory_order_relaxed);
+    }
+
+    // Statistics, baseline files and the watchdog of the runner itself
+    static void RegisterTests();
+
     // Register default engine file existence tests
     void RegisterDefaultEngineTests(const std::vector<std::string>& shaderPaths,
                                      const std::vector<std::string>& assetPaths) {
         std::lock_guard<std::mutex> lock(mMutex);
 
         // Create shader existence tests
-        RegisterSuite("ShaderFiles");
+        RegisterSuiteInternal("ShaderFiles");
         for (const auto& path : shaderPaths) {
             std::string testName = "Check shader: " + path;
             AddTestInternal("ShaderFiles", testName, [path]() {
@@ -172,7 +435,7 @@ public:
         }
 
         // Create asset existence tests
-        RegisterSuite("AssetFiles");
+        RegisterSuiteInternal("AssetFiles");
         for (const auto& path : assetPaths) {
             std::string testName = "Check asset: " + path;
             AddTestInternal("AssetFiles", testName, [path]() {
@@ -192,10 +455,49 @@ public:
 
 private:
     static constexpr int64_t MAX_TEST_DURATION_MS = 100;
+    static constexpr int64_t DEFAULT_TEST_TIMEOUT_MS = 5000;
+
+    // z-score for the 95% confidence interval of the median
+    static constexpr double CI_Z_SCORE = 1.96;
+
+    // Scales MAD to a standard deviation estimate for normally distributed noise
+    static constexpr double MAD_TO_SIGMA = 1.4826;
 
     TestManagerNew() = default;
 
-    // Internal test execution (assumes lock already held)
+    static std::atomic<uint64_t>& HeapAllocationCounter() {
+        static std::atomic<uint64_t> count{0};
+        return count;
+    }
+
+    static std::atomic<bool>& HeapCountingHooked() {
+        static std::atomic<bool> hooked{false};
+        return hooked;
+    }
+
+    static bool& CountingThisThread() {
+        thread_local bool counting = false;
+        return counting;
+    }
+
+    // Internal registration (assumes lock already held)
+    void RegisterSuiteInternal(const std::string& suiteName, SuiteMode mode = SuiteMode::PARALLEL) {
+        // Guard: suite already exists (a SERIAL registration still sticks)
+        auto it = mSuites.find(suiteName);
+        if (it != mSuites.end()) {
+            if (mode == SuiteMode::SERIAL) {
+                it->second.mode = mode;
+            }
+            QuoteSystem::Instance().Log("Suite '" + suiteName + "' already registered",
+                                        QuoteSystem::MessageType::WARNING);
+            return;
+        }
+
+        mSuites.emplace(suiteName, TestSuite(suiteName, mode));
+        QuoteSystem::Instance().Log("Registered test suite: " + suiteName,
+                                    QuoteSystem::MessageType::INFO);
+    }
+
     void AddTestInternal(const std::string& suiteName, const std::string& testName, TestFunction testFunc) {
         auto it = mSuites.find(suiteName);
         if (it != mSuites.end()) {
@@ -203,7 +505,132 @@ private:
         }
     }
 
-    void RunSuiteInternal(TestSuite& suite) {
+    size_t GetWorkerCount() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mWorkerCount > 0) {
+            return mWorkerCount;
+        }
+        return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    std::chrono::milliseconds GetTestTimeout() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mTestTimeout;
+    }
+
+    // Copy results from a finished snapshot back into the registry (assumes lock held)
+    void StoreResults(const TestSuite& finished) {
+        auto it = mSuites.find(finished.name);
+        if (it == mSuites.end()) {
+            return;
+        }
+
+        TestSuite& suite = it->second;
+        suite.passedCount = finished.passedCount;
+        suite.failedCount = finished.failedCount;
+
+        // Tests added during the run keep their default state
+        for (size_t i = 0; i < finished.tests.size() && i < suite.tests.size(); ++i) {
+            suite.tests[i].executionTime = finished.tests[i].executionTime;
+            suite.tests[i].timedOut = finished.tests[i].timedOut;
+        }
+    }
+
+    // Reports tests that overrun the timeout while a batch of workers runs them. An
+    // overrunning test cannot be killed, so it is not abandoned either: it keeps its
+    // worker until it returns and is then counted as failed, so nothing it references
+    // is torn down underneath it. One thread per run, however many tests time out.
+    class TestWatchdog {
+    public:
+        TestWatchdog(size_t workerCount, std::chrono::milliseconds timeout)
+            : mSlots(workerCount), mTimeout(timeout), mStopping(false) {
+            // Guard: no timeout, nothing to watch
+            if (mTimeout.count() > 0) {
+                mThread = std::thread([this]() { Watch(); });
+            }
+        }
+
+        ~TestWatchdog() {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStopping = true;
+            }
+            mWake.notify_all();
+            if (mThread.joinable()) {
+                mThread.join();
+            }
+        }
+
+        void Begin(size_t slot, const std::string& testName) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSlots[slot].name = &testName;
+            mSlots[slot].deadline = std::chrono::steady_clock::now() + mTimeout;
+            mSlots[slot].timedOut = false;
+        }
+
+        // Returns true when the test overran its timeout
+        bool End(size_t slot) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSlots[slot].name = nullptr;
+            return mSlots[slot].timedOut;
+        }
+
+        TestWatchdog(const TestWatchdog&) = delete;
+        TestWatchdog& operator=(const TestWatchdog&) = delete;
+
+    private:
+        struct Slot {
+            const std::string* name = nullptr; // Test running on this worker, if any
+            std::chrono::steady_clock::time_point deadline;
+            bool timedOut = false;
+        };
+
+        void Watch() {
+            std::unique_lock<std::mutex> lock(mMutex);
+            while (!mStopping) {
+                auto now = std::chrono::steady_clock::now();
+                auto wakeAt = now + mTimeout;
+                for (Slot& slot : mSlots) {
+                    if (slot.name == nullptr || slot.timedOut) {
+                        continue;
+                    }
+                    if (now >= slot.deadline) {
+                        slot.timedOut = true;
+                        QuoteSystem::Instance().Log("Test '" + *slot.name + "' timed out after " +
+                                                    std::to_string(mTimeout.count()) +
+                                                    "ms; waiting for it to return",
+                                                    QuoteSystem::MessageType::ERROR_MSG);
+                    } else {
+                        wakeAt = std::min(wakeAt, slot.deadline);
+                    }
+                }
+                mWake.wait_until(lock, wakeAt);
+            }
+        }
+
+        std::vector<Slot> mSlots;
+        const std::chrono::milliseconds mTimeout;
+        std::mutex mMutex;
+        std::condition_variable mWake;
+        bool mStopping; // Guarded by mMutex
+        std::thread mThread;
+    };
+
+    // Run one test on the calling worker with exceptions contained
+    static bool RunTestGuarded(const TestCase& test) {
+        try {
+            return test.testFunc();
+        } catch (const std::exception& e) {
+            QuoteSystem::Instance().Log("Test '" + test.name + "' threw exception: " + e.what(),
+                                        QuoteSystem::MessageType::ERROR_MSG);
+        } catch (...) {
+            QuoteSystem::Instance().Log("Test '" + test.name + "' threw unknown exception",
+                                        QuoteSystem::MessageType::ERROR_MSG);
+        }
+        return false;
+    }
+
+    void RunSuiteInternal(TestSuite& suite, TestWatchdog& watchdog, size_t slot) {
         suite.passedCount = 0;
         suite.failedCount = 0;
 
@@ -215,26 +642,16 @@ private:
                 continue;
             }
 
+            watchdog.Begin(slot, test.name);
             auto startTime = std::chrono::high_resolution_clock::now();
-            bool passed = false;
-
-            try {
-                passed = test.testFunc();
-            } catch (const std::exception& e) {
-                QuoteSystem::Instance().Log("Test '" + test.name + "' threw exception: " + e.what(),
-                                            QuoteSystem::MessageType::ERROR_MSG);
-                passed = false;
-            } catch (...) {
-                QuoteSystem::Instance().Log("Test '" + test.name + "' threw unknown exception",
-                                            QuoteSystem::MessageType::ERROR_MSG);
-                passed = false;
-            }
-
+            bool passed = RunTestGuarded(test);
             auto endTime = std::chrono::high_resolution_clock::now();
             test.executionTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+            test.timedOut = watchdog.End(slot);
+            passed = passed && !test.timedOut;
 
             // Guard: test took too long
-            if (test.executionTime.count() > MAX_TEST_DURATION_MS) {
+            if (!test.timedOut && test.executionTime.count() > MAX_TEST_DURATION_MS) {
                 QuoteSystem::Instance().Log("Test '" + test.name + "' exceeded time limit (" +
                                             std::to_string(test.executionTime.count()) + "ms)",
                                             QuoteSystem::MessageType::WARNING);
@@ -253,6 +670,226 @@ private:
         }
     }
 
+    // Time `iterations` calls of the body in nanoseconds
+    static double TimeBatch(const BenchmarkFunction& body, size_t iterations) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            body();
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::nano>(endTime - startTime).count();
+    }
+
+    static double Median(std::vector<double> values) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        size_t mid = values.size() / 2;
+        std::nth_element(values.begin(), values.begin() + mid, values.end());
+        double upper = values[mid];
+        if (values.size() % 2 == 1) {
+            return upper;
+        }
+        double lower = *std::max_element(values.begin(), values.begin() + mid);
+        return 0.5 * (lower + upper);
+    }
+
+    BenchmarkStats MeasureBenchmark(const BenchmarkCase& bench) {
+        const BenchmarkOptions& opts = bench.options;
+        BenchmarkStats stats;
+        stats.name = bench.Key();
+
+        // Warmup: populate caches, fault in pages, settle the branch predictor
+        TimeBatch(bench.body, opts.warmupIterations);
+
+        // Calibrate: double the batch size until a sample is long enough to time reliably
+        const double minSampleNs = opts.minSampleTimeMs * 1.0e6;
+        size_t iterations = 1;
+        while (iterations < opts.maxIterationsPerSample) {
+            double elapsed = TimeBatch(bench.body, iterations);
+            if (elapsed >= minSampleNs) {
+                break;
+            }
+            // Jump close to the target when the estimate is meaningful
+            if (elapsed > minSampleNs * 0.01) {
+                size_t estimate = static_cast<size_t>(std::ceil(iterations * minSampleNs / elapsed));
+                iterations = std::min(opts.maxIterationsPerSample, std::max(iterations * 2, estimate));
+                break;
+            }
+            iterations *= 2;
+        }
+        stats.iterationsPerSample = iterations;
+
+        // Sample
+        size_t sampleCount = std::max<size_t>(1, opts.sampleCount);
+        std::vector<double> perIteration;
+        perIteration.reserve(sampleCount);
+        for (size_t i = 0; i < sampleCount; ++i) {
+            perIteration.push_back(TimeBatch(bench.body, iterations) / static_cast<double>(iterations));
+        }
+        SummarizeSamples(std::move(perIteration), stats);
+        return stats;
+    }
+
+    // Median, MAD, mean, minimum and the 95% CI of the median over per-iteration times
+    static void SummarizeSamples(std::vector<double> perIteration, BenchmarkStats& stats) {
+        stats.samples = perIteration.size();
+
+        // Guard: no samples
+        if (perIteration.empty()) {
+            return;
+        }
+
+        stats.medianNs = Median(perIteration);
+        std::vector<double> deviations;
+        deviations.reserve(perIteration.size());
+        for (double v : perIteration) {
+            deviations.push_back(std::fabs(v - stats.medianNs));
+        }
+        stats.madNs = Median(deviations);
+
+        double sum = 0.0;
+        for (double v : perIteration) {
+            sum += v;
+        }
+        stats.meanNs = sum / static_cast<double>(perIteration.size());
+
+        // Distribution-free confidence interval for the median from order statistics
+        std::sort(perIteration.begin(), perIteration.end());
+        stats.minNs = perIteration.front();
+        double n = static_cast<double>(perIteration.size());
+        double halfWidth = CI_Z_SCORE * std::sqrt(n) / 2.0;
+        long lowRank = static_cast<long>(std::floor(n / 2.0 - halfWidth));
+        long highRank = static_cast<long>(std::ceil(n / 2.0 + halfWidth));
+        lowRank = std::max(0L, std::min(lowRank, static_cast<long>(n) - 1));
+        highRank = std::max(0L, std::min(highRank, static_cast<long>(n) - 1));
+        stats.ciLowNs = perIteration[static_cast<size_t>(lowRank)];
+        stats.ciHighNs = perIteration[static_cast<size_t>(highRank)];
+    }
+
+    // A regression needs both a median beyond the threshold and a CI that clears the noise floor,
+    // so a single noisy run on a busy machine does not fail the build
+    static bool IsRegression(const BenchmarkStats& current, const BenchmarkStats& base,
+                             const BenchmarkOptions& options) {
+        if (base.medianNs <= 0.0) {
+            return false;
+        }
+        double limit = base.medianNs * (1.0 + options.maxRegressionPercent / 100.0);
+        double noiseFloor = base.medianNs + MAD_TO_SIGMA * base.madNs;
+        return current.medianNs > limit && current.ciLowNs > noiseFloor;
+    }
+
+    // One line per benchmark so LoadBaseline can read it without a full JSON parser
+    static bool WriteBaseline(const std::string& path, const std::vector<BenchmarkCase>& results) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            QuoteSystem::Instance().Log("SaveBenchmarkBaseline: cannot open " + path,
+                                        QuoteSystem::MessageType::ERROR_MSG);
+            return false;
+        }
+
+        file << "{\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkStats& s = results[i].lastStats;
+            file << "  " << JsonBinding::StringLiteral(results[i].Key()) << ": { "
+                 << "\"medianNs\": " << s.medianNs << ", "
+                 << "\"madNs\": " << s.madNs << ", "
+                 << "\"ciLowNs\": " << s.ciLowNs << ", "
+                 << "\"ciHighNs\": " << s.ciHighNs << " }"
+                 << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        file << "}\n";
+
+        QuoteSystem::Instance().Log("Benchmark baseline saved to " + path, QuoteSystem::MessageType::SUCCESS);
+        return true;
+    }
+
+    // Parse the flat baseline written by SaveBenchmarkBaseline
+    static std::unordered_map<std::string, BenchmarkStats> LoadBaseline(const std::string& path) {
+        std::unordered_map<std::string, BenchmarkStats> baseline;
+
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            QuoteSystem::Instance().Log("LoadBaseline: cannot open " + path, QuoteSystem::MessageType::WARNING);
+            return baseline;
+        }
+
+        std::string line;
+        while (std::getline(file, line)) {
+            BenchmarkStats stats;
+            size_t keyEnd = ReadEscapedKey(line, stats.name);
+            if (keyEnd == std::string::npos || line.find('{', keyEnd) == std::string::npos) {
+                continue;
+            }
+
+            std::string fields = line.substr(keyEnd);
+            stats.medianNs = ReadNumberField(fields, "medianNs");
+            stats.madNs = ReadNumberField(fields, "madNs");
+            stats.ciLowNs = ReadNumberField(fields, "ciLowNs");
+            stats.ciHighNs = ReadNumberField(fields, "ciHighNs");
+            baseline[stats.name] = stats;
+        }
+
+        QuoteSystem::Instance().Log("Loaded benchmark baseline (" + std::to_string(baseline.size()) +
+                                    " entries) from " + path, QuoteSystem::MessageType::INFO);
+        return baseline;
+    }
+
+    // Read the first quoted string on the line into `key`; returns the index just past
+    // its closing quote, or npos when the line has none
+    static size_t ReadEscapedKey(const std::string& line, std::string& key) {
+        size_t i = line.find('"');
+        if (i == std::string::npos) {
+            return i;
+        }
+        size_t start = i + 1;
+        for (++i; i < line.size(); ++i) {
+            if (line[i] == '"') {
+                key = JsonReader::Unescape(std::string_view(line).substr(start, i - start));
+                return i + 1;
+            }
+            if (line[i] == '\\') {
+                ++i;
+            }
+        }
+        return std::string::npos;
+    }
+
+    static double ReadNumberField(const std::string& line, const std::string& field) {
+        size_t pos = line.find("\"" + field + "\":");
+        if (pos == std::string::npos) {
+            return 0.0;
+        }
+        pos += field.size() + 3;
+        try {
+            return std::stod(line.substr(pos));
+        } catch (...) {
+            return 0.0;
+        }
+    }
+
+    static std::string FormatNs(double ns) {
+        std::ostringstream ss;
+        ss.setf(std::ios::fixed);
+        ss.precision(2);
+        if (ns >= 1.0e6) {
+            ss << ns / 1.0e6 << "ms";
+        } else if (ns >= 1.0e3) {
+            ss << ns / 1.0e3 << "us";
+        } else {
+            ss << ns << "ns";
+        }
+        return ss.str();
+    }
+
+    void PrintBenchmarkStats(const BenchmarkStats& stats) {
+        std::cout << "[BENCH] " << stats.name
+                  << "  median " << FormatNs(stats.medianNs)
+                  << "  MAD " << FormatNs(stats.madNs)
+                  << "  95% CI [" << FormatNs(stats.ciLowNs) << ", " << FormatNs(stats.ciHighNs) << "]"
+                  << "  (" << stats.samples << " x " << stats.iterationsPerSample << " iters)\n";
+    }
+
     void PrintSuiteSummary(const TestSuite& suite) {
         size_t total = suite.passedCount + suite.failedCount;
         std::cout << "\n=== Suite Summary: " << suite.name << " ===\n";
@@ -262,7 +899,7 @@ private:
         std::cout << "==============================\n\n";
     }
 
-    void PrintSummary() {
+    bool PrintSummary() {
         size_t totalTests = 0;
         size_t totalPassed = 0;
         size_t totalFailed = 0;
@@ -287,9 +924,101 @@ private:
             QuoteSystem::Instance().Log(std::to_string(totalFailed) + " test(s) failed",
                                         QuoteSystem::MessageType::ERROR_MSG);
         }
+
+        return totalFailed == 0;
     }
 
     // Member variables
     std::mutex mMutex;
+    std::mutex mRunMutex;
     std::unordered_map<std::string, TestSuite> mSuites;
+    std::vector<BenchmarkCase> mBenchmarks;
+    std::vector<BenchmarkCase> mLastBenchmarkResults;
+    size_t mWorkerCount = 0;
+    std::chrono::milliseconds mTestTimeout{DEFAULT_TEST_TIMEOUT_MS};
 };
+
+inline void TestManagerNew::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("TestManagerNew");
+
+    tests.AddTest("TestManagerNew", "Median, MAD and CI of known samples", []() {
+        // 1..15 shuffled: median 8, deviations 0,1,1,...,7,7 give MAD 4, order statistics 4 and 13
+        BenchmarkStats odd;
+        SummarizeSamples({ 9, 2, 15, 4, 11, 1, 8, 13, 6, 3, 14, 7, 10, 5, 12 }, odd);
+        bool ok = odd.samples == 15 && odd.medianNs == 8.0 && odd.madNs == 4.0 && odd.meanNs == 8.0 &&
+                  odd.minNs == 1.0 && odd.ciLowNs == 4.0 && odd.ciHighNs == 13.0;
+
+        BenchmarkStats even;
+        SummarizeSamples({ 4, 1, 3, 2 }, even);
+        ok = ok && even.medianNs == 2.5 && even.madNs == 1.0 && even.ciLowNs == 1.0 && even.ciHighNs == 4.0;
+
+        // One outlier moves the mean but not the median or MAD
+        BenchmarkStats outlier;
+        SummarizeSamples({ 10, 10, 11, 9, 10, 1000 }, outlier);
+        ok = ok && outlier.medianNs == 10.0 && outlier.madNs == 0.5 && outlier.meanNs > 100.0;
+
+        BenchmarkStats empty;
+        SummarizeSamples({}, empty);
+        return ok && empty.samples == 0 && empty.medianNs == 0.0;
+    });
+
+    tests.AddTest("TestManagerNew", "Baselines round-trip and flag only clear regressions", []() {
+        std::error_code ec;
+        std::string path = (std::filesystem::temp_directory_path(ec) / "brightforge_bench_baseline.json").string();
+
+        std::vector<BenchmarkCase> results;
+        results.emplace_back("Suite", "plain", []() {}, BenchmarkOptions());
+        results.emplace_back("Suite", "\"quoted\"\ttab\x01", []() {}, BenchmarkOptions());
+        results[0].lastStats = { "", 0, 0, 1250.5, 40.25, 0.0, 0.0, 1200.0, 1300.0 };
+        results[1].lastStats = { "", 0, 0, 80.0, 2.5, 0.0, 0.0, 78.0, 83.0 };
+        bool ok = WriteBaseline(path, results);
+        std::ofstream(path, std::ios::app) << "not a baseline line\n";
+
+        std::unordered_map<std::string, BenchmarkStats> baseline = LoadBaseline(path);
+        std::filesystem::remove(path, ec);
+        ok = ok && baseline.size() == 2;
+        for (const BenchmarkCase& bench : results) {
+            auto it = baseline.find(bench.Key());
+            ok = ok && it != baseline.end() && it->second.medianNs == bench.lastStats.medianNs &&
+                 it->second.madNs == bench.lastStats.madNs && it->second.ciLowNs == bench.lastStats.ciLowNs &&
+                 it->second.ciHighNs == bench.lastStats.ciHighNs;
+        }
+
+        // Base 1000 +/- 20: the limit is 1100 and the noise floor 1000 + 1.4826 * 20
+        BenchmarkStats base;
+        base.medianNs = 1000.0;
+        base.madNs = 20.0;
+        BenchmarkOptions options;
+        options.maxRegressionPercent = 10.0;
+        auto current = [](double median, double ciLow) {
+            BenchmarkStats stats;
+            stats.medianNs = median;
+            stats.ciLowNs = ciLow;
+            return stats;
+        };
+        BenchmarkStats unmeasured;
+        return ok && IsRegression(current(1200.0, 1150.0), base, options) &&
+               !IsRegression(current(1200.0, 1010.0), base, options) &&   // Slower median, CI inside the noise
+               !IsRegression(current(1050.0, 1040.0), base, options) &&   // Within the threshold
+               !IsRegression(current(1200.0, 1150.0), unmeasured, options);
+    });
+
+    tests.AddTest("TestManagerNew", "Watchdog fails tests that overrun their timeout", []() {
+        // Runs a private suite on its own watchdog; its FAILED lines are expected
+        TestSuite suite("WatchdogFixture");
+        suite.tests.emplace_back("returns at once", []() { return true; });
+        suite.tests.emplace_back("overruns the timeout (expected failure)", []() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            return true;
+        });
+        suite.tests.emplace_back("throws (expected failure)", []() -> bool { throw std::runtime_error("fixture"); });
+
+        {
+            TestWatchdog watchdog(1, std::chrono::milliseconds(50));
+            TestManagerNew::Instance().RunSuiteInternal(suite, watchdog, 0);
+        }
+        return suite.passedCount == 1 && suite.failedCount == 2 && !suite.tests[0].timedOut &&
+               suite.tests[1].timedOut && suite.tests[1].executionTime.count() >= 300 && !suite.tests[2].timedOut;
+    });
+}
@@ -21,6 +21,11 @@ int main() {
     TestManagerNew::Instance().AddTest("BasicTests", "Always Pass", []() { return true; });
     TestManagerNew::Instance().AddTest("BasicTests", "Always Fail", []() { return false; });
     TestManagerNew::Instance().RunSuite("BasicTests");
+    TestManagerNew::Instance().AddBenchmark("BasicTests", "String Concat", []() {
+        std::string s = std::string("bright") + "forge";
+        TestManagerNew::DoNotOptimize(s);
+    });
+    TestManagerNew::Instance().RunBenchmarks();
 
     // Test EventBus
     EventBus::Instance().Subscribe("test.event", [](const EventBus::EventPayload& payload) {
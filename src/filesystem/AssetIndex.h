@@ -13,6 +13,8 @@
 #include <mutex>
 #include <algorithm>
 #include "FileService.h"
+#include "../core/MemoryTracker.h"
+#include "../core/StringInterner.h"
 #include "../core/QuoteSystem.h"
 #include "../core/EventBus.h"
 
@@ -31,52 +33,64 @@ namespace BrightForge {
 // );
 // CREATE INDEX idx_type ON assets(type);
 
+// Name, path and tags are interned ids; resolve them only for display
 struct IndexedAsset {
     AssetHandle handle;
-    std::string name;
-    std::string path;
+    StringId name;
+    PathId path;
     AssetFormat format;
     size_t sizeBytes;
     std::string lastModified;
-    std::unordered_set<std::string> tags;
+    std::unordered_set<StringId> tags;
 
     IndexedAsset()
         : handle(INVALID_HANDLE)
-        , name("")
-        , path("")
+        , name(INVALID_STRING_ID)
+        , path(INVALID_PATH_ID)
         , format(AssetFormat::UNKNOWN)
         , sizeBytes(0)
         , lastModified("")
     {}
+
+    std::string_view NameView() const {
+        return StringInterner::Instance().View(name);
+    }
+
+    std::string PathString() const {
+        return PathInterner::Instance().Resolve(path);
+    }
 };
 
 class AssetIndex {
 public:
     AssetIndex() {
-        QuoteSystem::Get().Log("SUCCESS", "AssetIndex", "Initialized in-memory catalog");
+        QuoteSystem::Instance().Log("AssetIndex: Initialized in-memory catalog",
+            QuoteSystem::MessageType::SUCCESS);
 
         // Subscribe to file.loaded events to auto-index
-        EventBus::Get().Subscribe("file.loaded", [this](const EventData& data) {
-            OnFileLoaded(data);
-        });
+        m_loadedSubscription = EventBus::Instance().Subscribe("file.loaded",
+            [this](const EventBus::EventPayload& payload) { OnFileLoaded(payload); });
     }
 
     ~AssetIndex() {
+        EventBus::Instance().Unsubscribe(m_loadedSubscription);
         Clear();
     }
 
     // Add asset to index
     bool AddAsset(const AssetInfo& info) {
         if (info.handle == INVALID_HANDLE) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Cannot index invalid handle");
+            QuoteSystem::Instance().Log("AssetIndex: Cannot index invalid handle",
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
         std::lock_guard<std::mutex> lock(m_mutex);
 
         // Check if already indexed
-        if (m_assets.find(info.handle) != m_assets.end()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Handle already indexed: " + std::to_string(info.handle));
+        if (m_assets.Contains(info.handle)) {
+            QuoteSystem::Instance().Log("AssetIndex: Handle already indexed: " + std::to_string(info.handle),
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
@@ -87,9 +101,8 @@ public:
         indexed.format = info.format;
         indexed.sizeBytes = info.sizeBytes;
 
-        // Extract filename from path
-        std::filesystem::path filePath(info.path);
-        indexed.name = filePath.filename().string();
+        // The filename is the path's last segment, already interned
+        indexed.name = PathInterner::Instance().FileName(info.path);
 
         // Format timestamp
         auto timeT = std::chrono::system_clock::to_time_t(info.loadedAt);
@@ -97,13 +110,22 @@ public:
         std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::localtime(&timeT));
         indexed.lastModified = buffer;
 
-        m_assets[info.handle] = indexed;
+        // Keyed by FileService's handle, so stale handles miss here too
+        if (!m_assets.InsertAt(info.handle, indexed)) {
+            QuoteSystem::Instance().Log("AssetIndex: Handle slot in use: " + std::to_string(info.handle),
+                QuoteSystem::MessageType::ERROR_MSG);
+            return false;
+        }
+
+        // Measured on the stored copy: its strings' capacities are what Release sees later
+        MemoryTracker::Instance().Add(MemoryTag::ASSET_INDEX, Footprint(*m_assets.Get(info.handle)));
 
-        // Add to type index for fast format-based searches
+        // Add to type and path indexes for fast lookups
         m_typeIndex[info.format].insert(info.handle);
+        m_pathIndex[info.path] = info.handle;
 
-        QuoteSystem::Get().Log("SUCCESS", "AssetIndex",
-            "Indexed " + indexed.name + " (handle " + std::to_string(info.handle) + ")");
+        QuoteSystem::Instance().Log("AssetIndex: Indexed " + std::string(indexed.NameView()) +
+            " (handle " + std::to_string(info.handle) + ")", QuoteSystem::MessageType::SUCCESS);
 
         return true;
     }
@@ -111,38 +133,43 @@ public:
     // Remove asset from index
     bool RemoveAsset(AssetHandle handle) {
         if (handle == INVALID_HANDLE) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Cannot remove invalid handle");
+            QuoteSystem::Instance().Log("AssetIndex: Cannot remove invalid handle",
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        auto it = m_assets.find(handle);
-        if (it == m_assets.end()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Handle not found: " + std::to_string(handle));
+        const IndexedAsset* asset = m_assets.Get(handle);
+        if (asset == nullptr) {
+            QuoteSystem::Instance().Log("AssetIndex: Handle not found: " + std::to_string(handle),
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
-        // Remove from type index
-        AssetFormat format = it->second.format;
-        m_typeIndex[format].erase(handle);
+        // Remove from type and path indexes
+        m_typeIndex[asset->format].erase(handle);
+        m_pathIndex.erase(asset->path);
 
         // Remove from tag index
-        for (const auto& tag : it->second.tags) {
+        for (StringId tag : asset->tags) {
             m_tagIndex[tag].erase(handle);
         }
 
-        std::string name = it->second.name;
-        m_assets.erase(it);
+        std::string name(asset->NameView());
+        MemoryTracker::Instance().Release(MemoryTag::ASSET_INDEX, Footprint(*asset));
+        m_assets.Remove(handle);
 
-        QuoteSystem::Get().Log("SUCCESS", "AssetIndex", "Removed " + name + " from index");
+        QuoteSystem::Instance().Log("AssetIndex: Removed " + name + " from index",
+            QuoteSystem::MessageType::SUCCESS);
         return true;
     }
 
     // Search by name substring
     std::vector<IndexedAsset> Search(const std::string& query) const {
         if (query.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Cannot search with empty query");
+            QuoteSystem::Instance().Log("AssetIndex: Cannot search with empty query",
+                QuoteSystem::MessageType::ERROR_MSG);
             return {};
         }
 
@@ -151,15 +178,15 @@ public:
         std::vector<IndexedAsset> results;
         std::string lowerQuery = ToLower(query);
 
-        for (const auto& [handle, asset] : m_assets) {
-            std::string lowerName = ToLower(asset.name);
+        for (const IndexedAsset& asset : m_assets) {
+            std::string lowerName = ToLower(asset.NameView());
             if (lowerName.find(lowerQuery) != std::string::npos) {
                 results.push_back(asset);
             }
         }
 
-        QuoteSystem::Get().Log("SUCCESS", "AssetIndex",
-            "Search '" + query + "' returned " + std::to_string(results.size()) + " results");
+        QuoteSystem::Instance().Log("AssetIndex: Search '" + query + "' returned " +
+            std::to_string(results.size()) + " results", QuoteSystem::MessageType::SUCCESS);
 
         return results;
     }
@@ -176,15 +203,13 @@ public:
         }
 
         for (AssetHandle handle : it->second) {
-            auto assetIt = m_assets.find(handle);
-            if (assetIt != m_assets.end()) {
-                results.push_back(assetIt->second);
+            if (const IndexedAsset* asset = m_assets.Get(handle)) {
+                results.push_back(*asset);
             }
         }
 
-        QuoteSystem::Get().Log("SUCCESS", "AssetIndex",
-            "Type search '" + FormatValidator::GetFormatName(format) +
-            "' returned " + std::to_string(results.size()) + " results");
+        QuoteSystem::Instance().Log("AssetIndex: Type search '" + FormatValidator::GetFormatName(format) +
+            "' returned " + std::to_string(results.size()) + " results", QuoteSystem::MessageType::SUCCESS);
 
         return results;
     }
@@ -192,28 +217,31 @@ public:
     // Search by tag
     std::vector<IndexedAsset> SearchByTag(const std::string& tag) const {
         if (tag.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Cannot search with empty tag");
+            QuoteSystem::Instance().Log("AssetIndex: Cannot search with empty tag",
+                QuoteSystem::MessageType::ERROR_MSG);
             return {};
         }
 
+        // Never-interned tags cannot be on any asset
+        StringId tagId = StringInterner::Instance().Find(tag);
+
         std::lock_guard<std::mutex> lock(m_mutex);
 
         std::vector<IndexedAsset> results;
 
-        auto it = m_tagIndex.find(tag);
+        auto it = m_tagIndex.find(tagId);
         if (it == m_tagIndex.end()) {
             return results;
         }
 
         for (AssetHandle handle : it->second) {
-            auto assetIt = m_assets.find(handle);
-            if (assetIt != m_assets.end()) {
-                results.push_back(assetIt->second);
+            if (const IndexedAsset* asset = m_assets.Get(handle)) {
+                results.push_back(*asset);
             }
         }
 
-        QuoteSystem::Get().Log("SUCCESS", "AssetIndex",
-            "Tag search '" + tag + "' returned " + std::to_string(results.size()) + " results");
+        QuoteSystem::Instance().Log("AssetIndex: Tag search '" + tag + "' returned " +
+            std::to_string(results.size()) + " results", QuoteSystem::MessageType::SUCCESS);
 
         return results;
     }
@@ -221,28 +249,35 @@ public:
     // Add tag to asset
     bool AddTag(AssetHandle handle, const std::string& tag) {
         if (handle == INVALID_HANDLE) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Cannot tag invalid handle");
+            QuoteSystem::Instance().Log("AssetIndex: Cannot tag invalid handle",
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
         if (tag.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Cannot add empty tag");
+            QuoteSystem::Instance().Log("AssetIndex: Cannot add empty tag",
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
+        StringId tagId = StringInterner::Instance().Intern(tag);
+
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        auto it = m_assets.find(handle);
-        if (it == m_assets.end()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Handle not found: " + std::to_string(handle));
+        IndexedAsset* asset = m_assets.Get(handle);
+        if (asset == nullptr) {
+            QuoteSystem::Instance().Log("AssetIndex: Handle not found: " + std::to_string(handle),
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
-        it->second.tags.insert(tag);
-        m_tagIndex[tag].insert(handle);
+        if (asset->tags.insert(tagId).second) {
+            MemoryTracker::Instance().Add(MemoryTag::ASSET_INDEX, TAG_FOOTPRINT);
+        }
+        m_tagIndex[tagId].insert(handle);
 
-        QuoteSystem::Get().Log("SUCCESS", "AssetIndex",
-            "Added tag '" + tag + "' to " + it->second.name);
+        QuoteSystem::Instance().Log("AssetIndex: Added tag '" + tag + "' to " + std::string(asset->NameView()),
+            QuoteSystem::MessageType::SUCCESS);
 
         return true;
     }
@@ -250,93 +285,121 @@ public:
     // Remove tag from asset
     bool RemoveTag(AssetHandle handle, const std::string& tag) {
         if (handle == INVALID_HANDLE) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Cannot untag invalid handle");
+            QuoteSystem::Instance().Log("AssetIndex: Cannot untag invalid handle",
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
         if (tag.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Cannot remove empty tag");
+            QuoteSystem::Instance().Log("AssetIndex: Cannot remove empty tag",
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
+        StringId tagId = StringInterner::Instance().Find(tag);
+
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        auto it = m_assets.find(handle);
-        if (it == m_assets.end()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "Handle not found: " + std::to_string(handle));
+        IndexedAsset* asset = m_assets.Get(handle);
+        if (asset == nullptr) {
+            QuoteSystem::Instance().Log("AssetIndex: Handle not found: " + std::to_string(handle),
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
-        it->second.tags.erase(tag);
-        m_tagIndex[tag].erase(handle);
+        if (asset->tags.erase(tagId) > 0) {
+            MemoryTracker::Instance().Release(MemoryTag::ASSET_INDEX, TAG_FOOTPRINT);
+            m_tagIndex[tagId].erase(handle);
+        }
 
-        QuoteSystem::Get().Log("SUCCESS", "AssetIndex",
-            "Removed tag '" + tag + "' from " + it->second.name);
+        QuoteSystem::Instance().Log("AssetIndex: Removed tag '" + tag + "' from " +
+            std::string(asset->NameView()), QuoteSystem::MessageType::SUCCESS);
 
         return true;
     }
 
+    // Handle indexed under `path`, INVALID_HANDLE if none (nothing is interned)
+    AssetHandle FindByPath(const std::string& path) const {
+        PathId pathId = PathInterner::Instance().Find(path);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pathIndex.find(pathId);
+        return it != m_pathIndex.end() ? it->second : INVALID_HANDLE;
+    }
+
     // Get all indexed assets
     std::vector<IndexedAsset> GetAll() const {
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        std::vector<IndexedAsset> all;
-        all.reserve(m_assets.size());
-
-        for (const auto& [handle, asset] : m_assets) {
-            all.push_back(asset);
-        }
-
-        return all;
+        return std::vector<IndexedAsset>(m_assets.begin(), m_assets.end());
     }
 
     // Get total indexed asset count
     size_t GetCount() const {
         std::lock_guard<std::mutex> lock(m_mutex);
-        return m_assets.size();
+        return m_assets.Size();
     }
 
     // Clear entire index
     void Clear() {
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        size_t count = m_assets.size();
-        m_assets.clear();
+        size_t count = m_assets.Size();
+        for (const IndexedAsset& asset : m_assets) {
+            MemoryTracker::Instance().Release(MemoryTag::ASSET_INDEX, Footprint(asset));
+        }
+        m_assets.Clear();
         m_typeIndex.clear();
+        m_pathIndex.clear();
         m_tagIndex.clear();
 
         if (count > 0) {
-            QuoteSystem::Get().Log("SUCCESS", "AssetIndex", "Cleared " + std::to_string(count) + " indexed assets");
+            QuoteSystem::Instance().Log("AssetIndex: Cleared " + std::to_string(count) + " indexed assets",
+                QuoteSystem::MessageType::SUCCESS);
         }
     }
 
     // Future: Save index to SQLite database
     bool SaveToSQLite(const std::string& path) const {
         // TODO: Implement SQLite persistence
-        QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "SQLite persistence not yet implemented");
+        QuoteSystem::Instance().Log("AssetIndex: SQLite persistence not yet implemented",
+            QuoteSystem::MessageType::ERROR_MSG);
         return false;
     }
 
     // Future: Load index from SQLite database
     bool LoadFromSQLite(const std::string& path) {
         // TODO: Implement SQLite persistence
-        QuoteSystem::Get().Log("ERROR_MSG", "AssetIndex", "SQLite persistence not yet implemented");
+        QuoteSystem::Instance().Log("AssetIndex: SQLite persistence not yet implemented",
+            QuoteSystem::MessageType::ERROR_MSG);
         return false;
     }
 
 private:
-    std::unordered_map<AssetHandle, IndexedAsset> m_assets;
+    // Bytes reported to MemoryTracker: the entry, its timestamp and one hash node per
+    // tag (interned text is counted once, under STRINGS)
+    static constexpr size_t TAG_FOOTPRINT = sizeof(StringId) + 2 * sizeof(void*);
+
+    static size_t Footprint(const IndexedAsset& asset) {
+        return sizeof(IndexedAsset) + MemoryTracker::StringBytes(asset.lastModified) +
+               asset.tags.size() * TAG_FOOTPRINT;
+    }
+
+    HandlePool<IndexedAsset> m_assets;
     std::unordered_map<AssetFormat, std::unordered_set<AssetHandle>> m_typeIndex;
-    std::unordered_map<std::string, std::unordered_set<AssetHandle>> m_tagIndex;
+    std::unordered_map<PathId, AssetHandle> m_pathIndex;
+    std::unordered_map<StringId, std::unordered_set<AssetHandle>> m_tagIndex;
+    size_t m_loadedSubscription = 0;
     mutable std::mutex m_mutex;
 
-    void OnFileLoaded(const EventData& data) {
-        // Future: extract AssetInfo from EventData and auto-index
-        QuoteSystem::Get().Log("SUCCESS", "AssetIndex", "Received file.loaded event");
+    // The payload is the loaded path; indexing needs the AssetInfo, so owners call AddAsset
+    void OnFileLoaded(const EventBus::EventPayload&) {
+        QuoteSystem::Instance().Log("AssetIndex: Received file.loaded event",
+            QuoteSystem::MessageType::SUCCESS);
     }
 
-    static std::string ToLower(const std::string& str) {
-        std::string lower = str;
+    static std::string ToLower(std::string_view str) {
+        std::string lower(str);
         std::transform(lower.begin(), lower.end(), lower.begin(),
             [](unsigned char c) { return std::tolower(c); });
         return lower;
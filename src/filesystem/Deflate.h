@@ -0,0 +1,661 @@
+/**
+ * Deflate - DEFLATE / zlib compression into growable buffers
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include "Inflate.h"
+#include "../core/JobSystem.h"
+
+namespace BrightForge {
+
+// Compression levels: FAST is greedy matching over short hash chains (export-time
+// friendly); HIGH walks longer chains with lazy matching for a smaller stream; STORE
+// skips matching and only frames the bytes (for data that is about to be re-packed).
+// All emit standard RFC 1951 data that Inflate (or any zlib) decodes.
+enum class DeflateLevel : uint8_t {
+    FAST = 0,
+    HIGH = 1,
+    STORE = 2
+};
+
+// Self-contained RFC 1950/1951 encoder, the counterpart to Inflate
+// Each block is emitted as whichever of dynamic Huffman, fixed Huffman or stored is
+// smallest, so incompressible data costs only a few bytes per 64 KiB.
+// Stateless and re-entrant: safe to run many compressions in parallel.
+class Deflate {
+public:
+    // Append a zlib stream (2-byte header, deflate data, Adler-32 trailer) to `out`
+    static bool CompressZlib(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& out,
+                             DeflateLevel level = DeflateLevel::FAST) {
+        if (src == nullptr && srcSize > 0) {
+            return false;
+        }
+
+        out.reserve(out.size() + srcSize / 2 + 64);
+        out.push_back(0x78);
+        out.push_back(level == DeflateLevel::HIGH ? 0xDA : 0x01);
+        CompressRaw(src, srcSize, out, level);
+
+        uint32_t adler = Inflate::Adler32(src, srcSize);
+        out.push_back(static_cast<uint8_t>(adler >> 24));
+        out.push_back(static_cast<uint8_t>(adler >> 16));
+        out.push_back(static_cast<uint8_t>(adler >> 8));
+        out.push_back(static_cast<uint8_t>(adler));
+        return true;
+    }
+
+    // Same stream as CompressZlib(), with slices of PARALLEL_SLICE bytes compressed
+    // concurrently (the pigz layout): every slice but the last ends in a sync flush, so
+    // the pieces join on byte boundaries. Matches cannot reach back across a slice,
+    // which costs well under 1% at this slice size.
+    static bool CompressZlibParallel(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& out,
+                                     DeflateLevel level = DeflateLevel::FAST, size_t workerCount = 0) {
+        size_t slices = (srcSize + PARALLEL_SLICE - 1) / PARALLEL_SLICE;
+        if (slices <= 1 || src == nullptr) {
+            return CompressZlib(src, srcSize, out, level);
+        }
+
+        std::vector<std::vector<uint8_t>> packed(slices);
+        std::vector<uint32_t> adler(slices);
+        JobSystem::Instance().ParallelFor(slices, 1, [&](size_t begin, size_t end) {
+            for (size_t s = begin; s < end; ++s) {
+                size_t offset = s * PARALLEL_SLICE;
+                size_t size = std::min(PARALLEL_SLICE, srcSize - offset);
+                packed[s].reserve(size / 2 + 64);
+                CompressRaw(src + offset, size, packed[s], level, s + 1 == slices);
+                adler[s] = Inflate::Adler32(src + offset, size);
+            }
+        }, workerCount);
+
+        size_t total = 6;
+        for (const std::vector<uint8_t>& piece : packed) {
+            total += piece.size();
+        }
+        out.reserve(out.size() + total);
+        out.push_back(0x78);
+        out.push_back(level == DeflateLevel::HIGH ? 0xDA : 0x01);
+        uint32_t checksum = adler[0];
+        for (size_t s = 0; s < slices; ++s) {
+            out.insert(out.end(), packed[s].begin(), packed[s].end());
+            if (s > 0) {
+                checksum = Adler32Combine(checksum, adler[s], std::min(PARALLEL_SLICE, srcSize - s * PARALLEL_SLICE));
+            }
+        }
+        out.push_back(static_cast<uint8_t>(checksum >> 24));
+        out.push_back(static_cast<uint8_t>(checksum >> 16));
+        out.push_back(static_cast<uint8_t>(checksum >> 8));
+        out.push_back(static_cast<uint8_t>(checksum));
+        return true;
+    }
+
+    // Append raw deflate data (no zlib wrapper) to `out`. With final = false the data
+    // ends in a sync flush instead of a final block, so more deflate data can follow.
+    static void CompressRaw(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& out,
+                            DeflateLevel level = DeflateLevel::FAST, bool final = true) {
+        BitWriter bits{ out };
+
+        // Guard: an empty stream is one final fixed block holding only end-of-block
+        if (srcSize == 0) {
+            if (!final) {
+                WriteStored(bits, src, 0, false);
+                return;
+            }
+            bits.Put(1, 1);
+            bits.Put(1, 2);
+            bits.Put(0, 7);
+            bits.AlignToByte();
+            return;
+        }
+
+        if (level == DeflateLevel::STORE) {
+            WriteStored(bits, src, srcSize, final);
+            if (!final) {
+                WriteStored(bits, src, 0, false);
+            }
+            return;
+        }
+
+        Chains chains(src, srcSize, level);
+        std::vector<Token> tokens;
+        tokens.reserve(BLOCK_TOKENS);
+
+        size_t position = 0;
+        size_t blockStart = 0;
+        while (position < srcSize) {
+            position = Tokenize(chains, position, tokens, level);
+            WriteBlock(bits, tokens, src + blockStart, position - blockStart, final && position == srcSize);
+            tokens.clear();
+            blockStart = position;
+        }
+        if (!final) {
+            // Empty stored block: byte-aligns and marks the flush point (00 00 FF FF)
+            WriteStored(bits, src, 0, false);
+            return;
+        }
+        bits.AlignToByte();
+    }
+
+    // Adler-32 of A + B from adler(A), adler(B) and |B| (zlib's adler32_combine)
+    static uint32_t Adler32Combine(uint32_t first, uint32_t second, size_t secondSize) {
+        constexpr uint32_t MOD = 65521;
+        uint32_t remainder = static_cast<uint32_t>(secondSize % MOD);
+        uint32_t sum1 = first & 0xFFFF;
+        uint32_t sum2 = static_cast<uint32_t>((static_cast<uint64_t>(remainder) * sum1) % MOD);
+        sum1 += (second & 0xFFFF) + MOD - 1;
+        sum2 += (first >> 16) + (second >> 16) + MOD - remainder;
+        if (sum1 >= MOD) sum1 -= MOD;
+        if (sum1 >= MOD) sum1 -= MOD;
+        if (sum2 >= (MOD << 1)) sum2 -= (MOD << 1);
+        if (sum2 >= MOD) sum2 -= MOD;
+        return (sum2 << 16) | sum1;
+    }
+
+    // Prevent instantiation (static API)
+    Deflate() = delete;
+
+private:
+    static constexpr size_t PARALLEL_SLICE = 256 * 1024;
+    static constexpr size_t WINDOW_SIZE = 32768;
+    static constexpr size_t MIN_MATCH = 3;
+    static constexpr size_t MAX_MATCH = 258;
+    static constexpr size_t BLOCK_TOKENS = 1u << 16;     // Symbols per block before the tables are refit
+    static constexpr uint32_t HASH_LOG = 15;
+    static constexpr uint32_t FAST_ATTEMPTS = 8;
+    static constexpr uint32_t HIGH_ATTEMPTS = 128;
+    static constexpr size_t FAST_NICE_LENGTH = 32;        // Stop searching once a match is this long
+    static constexpr size_t HIGH_NICE_LENGTH = MAX_MATCH;
+
+    static constexpr int LITERAL_CODES = 288;      // Includes the two reserved codes the fixed table assigns
+    static constexpr int DISTANCE_CODES = 30;
+    static constexpr int CODE_LENGTH_CODES = 19;
+    static constexpr int END_OF_BLOCK = 256;
+    static constexpr int MAX_BITS = 15;
+    static constexpr int MAX_CODE_LENGTH_BITS = 7;
+
+    static constexpr uint16_t LENGTH_BASE[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+    };
+    static constexpr uint8_t LENGTH_EXTRA[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+    };
+    static constexpr uint16_t DISTANCE_BASE[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537,
+        2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+    };
+    static constexpr uint8_t DISTANCE_EXTRA[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+    };
+    static constexpr uint8_t CODE_LENGTH_ORDER[CODE_LENGTH_CODES] = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+    };
+
+    // A literal (distance 0, byte in `length`) or a back-reference
+    struct Token {
+        uint16_t length;
+        uint16_t distance;
+    };
+
+    // LSB-first bit packer; flushes whole 32-bit words
+    struct BitWriter {
+        std::vector<uint8_t>& out;
+        uint64_t bits = 0;
+        uint32_t count = 0;
+
+        void Put(uint32_t value, uint32_t n) {
+            bits |= static_cast<uint64_t>(value) << count;
+            count += n;
+            if (count >= 32) {
+                uint8_t word[4] = { static_cast<uint8_t>(bits), static_cast<uint8_t>(bits >> 8),
+                                    static_cast<uint8_t>(bits >> 16), static_cast<uint8_t>(bits >> 24) };
+                out.insert(out.end(), word, word + 4);
+                bits >>= 32;
+                count -= 32;
+            }
+        }
+
+        void AlignToByte() {
+            while (count > 0) {
+                out.push_back(static_cast<uint8_t>(bits));
+                bits >>= 8;
+                count = count > 8 ? count - 8 : 0;
+            }
+            bits = 0;
+        }
+    };
+
+    // Hash chains over the 32 KiB window; positions are inserted lazily up to each search
+    struct Chains {
+        const uint8_t* src;
+        size_t size;
+        std::vector<int32_t> head;
+        std::vector<int32_t> previous;
+        size_t next = 0;
+        uint32_t attempts;
+        size_t niceLength;
+
+        Chains(const uint8_t* data, size_t dataSize, DeflateLevel level)
+            : src(data), size(dataSize), head(1u << HASH_LOG, -1), previous(WINDOW_SIZE, -1),
+              attempts(level == DeflateLevel::HIGH ? HIGH_ATTEMPTS : FAST_ATTEMPTS),
+              niceLength(level == DeflateLevel::HIGH ? HIGH_NICE_LENGTH : FAST_NICE_LENGTH) {}
+
+        uint32_t Hash(size_t position) const {
+            const uint8_t* p = src + position;
+            uint32_t sequence = (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) | p[2];
+            return (sequence * 2654435761u) >> (32 - HASH_LOG);
+        }
+
+        void InsertUpTo(size_t position) {
+            size_t limit = std::min(position, size - std::min(size, MIN_MATCH - 1));
+            for (; next < limit; ++next) {
+                int32_t& first = head[Hash(next)];
+                previous[next & (WINDOW_SIZE - 1)] = first;
+                first = static_cast<int32_t>(next);
+            }
+            next = std::max(next, position);
+        }
+
+        // Longest match at `position`; returns its length (0 if none) and sets `distance`
+        size_t Find(size_t position, size_t& distance) {
+            InsertUpTo(position);
+            if (size - position < MIN_MATCH) {
+                return 0;
+            }
+
+            size_t limit = std::min(MAX_MATCH, size - position);
+            const uint8_t* current = src + position;
+            size_t best = MIN_MATCH - 1;
+            int32_t candidate = head[Hash(position)];
+            for (uint32_t attempt = 0; attempt < attempts && candidate >= 0; ++attempt) {
+                size_t from = static_cast<size_t>(candidate);
+                if (position - from > WINDOW_SIZE) {
+                    break;
+                }
+                const uint8_t* ref = src + from;
+                if (ref[best] == current[best] && ref[0] == current[0] && ref[1] == current[1]) {
+                    size_t length = 2;
+                    while (length < limit && ref[length] == current[length]) {
+                        ++length;
+                    }
+                    if (length > best) {
+                        best = length;
+                        distance = position - from;
+                        if (length >= niceLength || length == limit) {
+                            break;
+                        }
+                    }
+                }
+                int32_t older = previous[from & (WINDOW_SIZE - 1)];
+                if (older >= candidate) {
+                    break;
+                }
+                candidate = older;
+            }
+            return best >= MIN_MATCH ? best : 0;
+        }
+    };
+
+    // Fill `tokens` with up to one block of symbols starting at `position`; returns the end
+    static size_t Tokenize(Chains& chains, size_t position, std::vector<Token>& tokens, DeflateLevel level) {
+        const uint8_t* src = chains.src;
+        size_t size = chains.size;
+
+        while (position < size && tokens.size() + 2 <= BLOCK_TOKENS) {
+            size_t distance = 0;
+            size_t length = chains.Find(position, distance);
+
+            // Lazy: emit a literal when the next position matches further
+            if (level == DeflateLevel::HIGH && length > 0 && length < chains.niceLength && position + 1 < size) {
+                size_t nextDistance = 0;
+                size_t nextLength = chains.Find(position + 1, nextDistance);
+                if (nextLength > length) {
+                    tokens.push_back({ src[position], 0 });
+                    ++position;
+                    continue;
+                }
+            }
+
+            if (length == 0) {
+                tokens.push_back({ src[position], 0 });
+                ++position;
+                continue;
+            }
+            tokens.push_back({ static_cast<uint16_t>(length), static_cast<uint16_t>(distance) });
+            position += length;
+        }
+        return position;
+    }
+
+    static int LengthCode(size_t length) {
+        int code = 28;
+        while (LENGTH_BASE[code] > length) {
+            --code;
+        }
+        return code;
+    }
+
+    static int DistanceCode(size_t distance) {
+        // Codes 2k and 2k+1 share a power-of-two range, so start from the bit width
+        if (distance <= 4) {
+            return static_cast<int>(distance) - 1;
+        }
+        int width = 0;
+        for (size_t d = distance - 1; d > 1; d >>= 1) {
+            ++width;
+        }
+        int code = width * 2;
+        return distance - 1 >= (static_cast<size_t>(3) << (width - 1)) ? code + 1 : code;
+    }
+
+    // Huffman code lengths no longer than `limit`; rebuilds with flattened counts until they fit
+    static void BuildLengths(const uint32_t* counts, int symbolCount, int limit, uint8_t* lengths) {
+        std::vector<uint32_t> weights(counts, counts + symbolCount);
+        std::memset(lengths, 0, static_cast<size_t>(symbolCount));
+
+        struct Leaf {
+            uint32_t weight;
+            int symbol;
+        };
+
+        for (;;) {
+            std::vector<Leaf> leaves;
+            for (int s = 0; s < symbolCount; ++s) {
+                if (weights[s] > 0) {
+                    leaves.push_back({ weights[s], s });
+                }
+            }
+            if (leaves.empty()) {
+                return;
+            }
+            if (leaves.size() == 1) {
+                lengths[leaves[0].symbol] = 1;
+                return;
+            }
+            std::sort(leaves.begin(), leaves.end(), [](const Leaf& a, const Leaf& b) {
+                return a.weight != b.weight ? a.weight < b.weight : a.symbol < b.symbol;
+            });
+
+            // Two-queue merge: internal nodes are created in non-decreasing weight order
+            size_t n = leaves.size();
+            std::vector<uint64_t> weight(2 * n - 1);
+            std::vector<uint32_t> parent(2 * n - 1, 0);
+            for (size_t i = 0; i < n; ++i) {
+                weight[i] = leaves[i].weight;
+            }
+            size_t leaf = 0;
+            size_t internal = n;
+            for (size_t node = n; node < 2 * n - 1; ++node) {
+                size_t pick[2];
+                for (size_t& p : pick) {
+                    if (leaf < n && (internal >= node || weight[leaf] <= weight[internal])) {
+                        p = leaf++;
+                    } else {
+                        p = internal++;
+                    }
+                }
+                weight[node] = weight[pick[0]] + weight[pick[1]];
+                parent[pick[0]] = static_cast<uint32_t>(node);
+                parent[pick[1]] = static_cast<uint32_t>(node);
+            }
+
+            std::vector<uint8_t> depth(2 * n - 1, 0);
+            int deepest = 0;
+            for (size_t node = 2 * n - 1; node-- > 0;) {
+                if (node != 2 * n - 2) {
+                    depth[node] = static_cast<uint8_t>(std::min(255, depth[parent[node]] + 1));
+                }
+                if (node < n) {
+                    deepest = std::max<int>(deepest, depth[node]);
+                }
+            }
+
+            if (deepest <= limit) {
+                for (size_t i = 0; i < n; ++i) {
+                    lengths[leaves[i].symbol] = depth[i];
+                }
+                return;
+            }
+            for (uint32_t& w : weights) {
+                if (w > 0) {
+                    w = (w >> 1) | 1;
+                }
+            }
+        }
+    }
+
+    // A tree with fewer than two codes is incomplete, which strict decoders (zlib)
+    // reject; pad it with unused one-bit codes
+    static void CompleteTree(uint8_t* lengths, int symbolCount) {
+        int used = 0;
+        for (int s = 0; s < symbolCount; ++s) {
+            used += lengths[s] > 0 ? 1 : 0;
+        }
+        for (int s = 0; s < symbolCount && used < 2; ++s) {
+            if (lengths[s] == 0) {
+                lengths[s] = 1;
+                ++used;
+            }
+        }
+    }
+
+    // Canonical codes, bit-reversed for LSB-first output
+    static void BuildCodes(const uint8_t* lengths, int symbolCount, uint16_t* codes) {
+        uint16_t counts[MAX_BITS + 1] = {};
+        for (int s = 0; s < symbolCount; ++s) {
+            ++counts[lengths[s]];
+        }
+        counts[0] = 0;
+
+        uint16_t nextCode[MAX_BITS + 2] = {};
+        for (int len = 1; len <= MAX_BITS; ++len) {
+            nextCode[len + 1] = static_cast<uint16_t>((nextCode[len] + counts[len]) << 1);
+        }
+
+        for (int s = 0; s < symbolCount; ++s) {
+            int len = lengths[s];
+            if (len == 0) {
+                codes[s] = 0;
+                continue;
+            }
+            uint32_t code = nextCode[len]++;
+            uint32_t reversed = 0;
+            for (int i = 0; i < len; ++i) {
+                reversed = (reversed << 1) | ((code >> i) & 1u);
+            }
+            codes[s] = static_cast<uint16_t>(reversed);
+        }
+    }
+
+    // Run-length encode the concatenated code lengths with symbols 16/17/18
+    struct LengthRun {
+        uint8_t symbol;
+        uint8_t extra;
+    };
+
+    static void EncodeLengthRuns(const uint8_t* lengths, int count, std::vector<LengthRun>& runs) {
+        for (int i = 0; i < count;) {
+            uint8_t value = lengths[i];
+            int run = 1;
+            while (i + run < count && lengths[i + run] == value) {
+                ++run;
+            }
+            i += run;
+
+            if (value == 0) {
+                while (run >= 11) {
+                    int take = std::min(run, 138);
+                    runs.push_back({ 18, static_cast<uint8_t>(take - 11) });
+                    run -= take;
+                }
+                if (run >= 3) {
+                    runs.push_back({ 17, static_cast<uint8_t>(run - 3) });
+                    run = 0;
+                }
+            } else {
+                runs.push_back({ value, 0 });
+                --run;
+                while (run >= 3) {
+                    int take = std::min(run, 6);
+                    runs.push_back({ 16, static_cast<uint8_t>(take - 3) });
+                    run -= take;
+                }
+            }
+            for (; run > 0; --run) {
+                runs.push_back({ value, 0 });
+            }
+        }
+    }
+
+    static uint64_t SymbolBits(const uint32_t* literalCounts, const uint32_t* distanceCounts,
+                               const uint8_t* literalLengths, const uint8_t* distanceLengths) {
+        uint64_t bits = 0;
+        for (int s = 0; s < LITERAL_CODES; ++s) {
+            uint32_t extra = s > END_OF_BLOCK && s < 286 ? LENGTH_EXTRA[s - 257] : 0;
+            bits += static_cast<uint64_t>(literalCounts[s]) * (literalLengths[s] + extra);
+        }
+        for (int s = 0; s < DISTANCE_CODES; ++s) {
+            bits += static_cast<uint64_t>(distanceCounts[s]) * (distanceLengths[s] + DISTANCE_EXTRA[s]);
+        }
+        return bits;
+    }
+
+    static void FixedLengths(uint8_t* literalLengths, uint8_t* distanceLengths) {
+        for (int s = 0; s < LITERAL_CODES; ++s) {
+            literalLengths[s] = s < 144 ? 8 : s < 256 ? 9 : s < 280 ? 7 : 8;
+        }
+        std::memset(distanceLengths, 5, DISTANCE_CODES);
+    }
+
+    static void WriteBlock(BitWriter& bits, const std::vector<Token>& tokens, const uint8_t* raw, size_t rawSize,
+                           bool last) {
+        uint32_t literalCounts[LITERAL_CODES] = {};
+        uint32_t distanceCounts[DISTANCE_CODES] = {};
+        for (const Token& token : tokens) {
+            if (token.distance == 0) {
+                ++literalCounts[token.length];
+            } else {
+                ++literalCounts[257 + LengthCode(token.length)];
+                ++distanceCounts[DistanceCode(token.distance)];
+            }
+        }
+        literalCounts[END_OF_BLOCK] = 1;
+
+        uint8_t literalLengths[LITERAL_CODES];
+        uint8_t distanceLengths[DISTANCE_CODES];
+        BuildLengths(literalCounts, LITERAL_CODES, MAX_BITS, literalLengths);
+        BuildLengths(distanceCounts, DISTANCE_CODES, MAX_BITS, distanceLengths);
+
+        CompleteTree(distanceLengths, DISTANCE_CODES);
+
+        int literalCount = LITERAL_CODES;
+        while (literalCount > 257 && literalLengths[literalCount - 1] == 0) {
+            --literalCount;
+        }
+        int distanceCount = DISTANCE_CODES;
+        while (distanceCount > 1 && distanceLengths[distanceCount - 1] == 0) {
+            --distanceCount;
+        }
+
+        uint8_t combined[LITERAL_CODES + DISTANCE_CODES];
+        std::memcpy(combined, literalLengths, static_cast<size_t>(literalCount));
+        std::memcpy(combined + literalCount, distanceLengths, static_cast<size_t>(distanceCount));
+        std::vector<LengthRun> runs;
+        EncodeLengthRuns(combined, literalCount + distanceCount, runs);
+
+        uint32_t runCounts[CODE_LENGTH_CODES] = {};
+        for (const LengthRun& run : runs) {
+            ++runCounts[run.symbol];
+        }
+        uint8_t runLengths[CODE_LENGTH_CODES];
+        BuildLengths(runCounts, CODE_LENGTH_CODES, MAX_CODE_LENGTH_BITS, runLengths);
+        CompleteTree(runLengths, CODE_LENGTH_CODES);
+        int runLengthCount = CODE_LENGTH_CODES;
+        while (runLengthCount > 4 && runLengths[CODE_LENGTH_ORDER[runLengthCount - 1]] == 0) {
+            --runLengthCount;
+        }
+
+        // Pick the cheapest encoding for this block
+        uint64_t dynamicBits = 3 + 14 + 3ull * runLengthCount +
+                               SymbolBits(literalCounts, distanceCounts, literalLengths, distanceLengths);
+        for (const LengthRun& run : runs) {
+            dynamicBits += runLengths[run.symbol] + (run.symbol == 16 ? 2 : run.symbol == 17 ? 3 : run.symbol == 18 ? 7 : 0);
+        }
+        uint8_t fixedLiteralLengths[LITERAL_CODES];
+        uint8_t fixedDistanceLengths[DISTANCE_CODES];
+        FixedLengths(fixedLiteralLengths, fixedDistanceLengths);
+        uint64_t fixedBits = 3 + SymbolBits(literalCounts, distanceCounts, fixedLiteralLengths, fixedDistanceLengths);
+        uint64_t storedBits = (static_cast<uint64_t>(rawSize) + 5 * ((rawSize + 65534) / 65535)) * 8 + 7;
+
+        if (storedBits <= dynamicBits && storedBits <= fixedBits) {
+            WriteStored(bits, raw, rawSize, last);
+            return;
+        }
+
+        bool dynamic = dynamicBits < fixedBits;
+        bits.Put(last ? 1 : 0, 1);
+        bits.Put(dynamic ? 2 : 1, 2);
+        if (dynamic) {
+            uint16_t runCodes[CODE_LENGTH_CODES];
+            BuildCodes(runLengths, CODE_LENGTH_CODES, runCodes);
+            bits.Put(static_cast<uint32_t>(literalCount - 257), 5);
+            bits.Put(static_cast<uint32_t>(distanceCount - 1), 5);
+            bits.Put(static_cast<uint32_t>(runLengthCount - 4), 4);
+            for (int i = 0; i < runLengthCount; ++i) {
+                bits.Put(runLengths[CODE_LENGTH_ORDER[i]], 3);
+            }
+            for (const LengthRun& run : runs) {
+                bits.Put(runCodes[run.symbol], runLengths[run.symbol]);
+                if (run.symbol == 16) bits.Put(run.extra, 2);
+                else if (run.symbol == 17) bits.Put(run.extra, 3);
+                else if (run.symbol == 18) bits.Put(run.extra, 7);
+            }
+        } else {
+            std::memcpy(literalLengths, fixedLiteralLengths, sizeof(literalLengths));
+            std::memcpy(distanceLengths, fixedDistanceLengths, sizeof(distanceLengths));
+        }
+
+        uint16_t literalCodes[LITERAL_CODES];
+        uint16_t distanceCodes[DISTANCE_CODES];
+        BuildCodes(literalLengths, LITERAL_CODES, literalCodes);
+        BuildCodes(distanceLengths, DISTANCE_CODES, distanceCodes);
+
+        for (const Token& token : tokens) {
+            if (token.distance == 0) {
+                bits.Put(literalCodes[token.length], literalLengths[token.length]);
+                continue;
+            }
+            int lengthCode = LengthCode(token.length);
+            bits.Put(literalCodes[257 + lengthCode], literalLengths[257 + lengthCode]);
+            bits.Put(static_cast<uint32_t>(token.length - LENGTH_BASE[lengthCode]), LENGTH_EXTRA[lengthCode]);
+            int distanceCode = DistanceCode(token.distance);
+            bits.Put(distanceCodes[distanceCode], distanceLengths[distanceCode]);
+            bits.Put(static_cast<uint32_t>(token.distance - DISTANCE_BASE[distanceCode]), DISTANCE_EXTRA[distanceCode]);
+        }
+        bits.Put(literalCodes[END_OF_BLOCK], literalLengths[END_OF_BLOCK]);
+    }
+
+    static void WriteStored(BitWriter& bits, const uint8_t* raw, size_t rawSize, bool last) {
+        size_t offset = 0;
+        do {
+            size_t chunk = std::min<size_t>(rawSize - offset, 65535);
+            bool final = last && offset + chunk == rawSize;
+            bits.Put(final ? 1 : 0, 1);
+            bits.Put(0, 2);
+            bits.AlignToByte();
+            uint8_t header[4] = { static_cast<uint8_t>(chunk), static_cast<uint8_t>(chunk >> 8),
+                                  static_cast<uint8_t>(~chunk), static_cast<uint8_t>(~chunk >> 8) };
+            bits.out.insert(bits.out.end(), header, header + 4);
+            bits.out.insert(bits.out.end(), raw + offset, raw + offset + chunk);
+            offset += chunk;
+        } while (offset < rawSize);
+    }
+};
+
+} // namespace BrightForge
@@ -12,6 +12,7 @@
 #include <atomic>
 #include "FormatValidator.h"
 #include "FileService.h"
+#include "BatchIO.h"
 #include "../core/QuoteSystem.h"
 #include "../core/EventBus.h"
 
@@ -40,7 +41,8 @@ public:
         , m_isProcessing(false)
         , m_stats()
     {
-        QuoteSystem::Get().Log("SUCCESS", "DropHandler", "Initialized with batch support and rate limiting");
+        QuoteSystem::Instance().Log("DropHandler: Initialized with batch support and rate limiting",
+            QuoteSystem::MessageType::SUCCESS);
     }
 
     ~DropHandler() = default;
@@ -48,34 +50,64 @@ public:
     // Handle file drop from OS (supports batch drops)
     void HandleDrop(const std::vector<std::string>& paths) {
         if (paths.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "DropHandler", "Cannot handle empty drop");
+            QuoteSystem::Instance().Log("DropHandler: Cannot handle empty drop",
+                QuoteSystem::MessageType::ERROR_MSG);
             return;
         }
 
         // Rate limiting: don't accept new drops while processing
         if (m_isProcessing.load()) {
-            QuoteSystem::Get().Log("WARNING", "DropHandler",
-                "Drop in progress, queuing " + std::to_string(paths.size()) + " files");
+            QuoteSystem::Instance().Log("DropHandler: Drop in progress, queuing " +
+                std::to_string(paths.size()) + " files", QuoteSystem::MessageType::WARNING);
             QueueDrop(paths);
             return;
         }
 
         m_isProcessing.store(true);
 
-        QuoteSystem::Get().Log("SUCCESS", "DropHandler",
-            "Processing batch drop: " + std::to_string(paths.size()) + " files");
-
-        size_t batchAccepted = 0;
-        size_t batchRejected = 0;
+        QuoteSystem::Instance().Log("DropHandler: Processing batch drop: " +
+            std::to_string(paths.size()) + " files", QuoteSystem::MessageType::SUCCESS);
 
+        // One batched probe covers existence, size and magic bytes for the whole drop
+        std::vector<std::string> named;
+        named.reserve(paths.size());
         for (const std::string& path : paths) {
-            if (ProcessSingleDrop(path)) {
-                batchAccepted++;
+            if (path.empty()) {
+                QuoteSystem::Instance().Log("DropHandler: Skipping empty path",
+                    QuoteSystem::MessageType::ERROR_MSG);
             } else {
-                batchRejected++;
+                named.push_back(path);
+            }
+        }
+        std::vector<FileProbe> probes = IoBackend::Default().ProbePaths(named);
+
+        // Validate format at system boundary
+        std::vector<AssetFormat> formats = m_validator.ValidateFormats(probes);
+        std::vector<FileProbe> accepted;
+        accepted.reserve(probes.size());
+        for (size_t i = 0; i < probes.size(); ++i) {
+            if (!FormatValidator::IsSupported(formats[i])) {
+                QuoteSystem::Instance().Log("DropHandler: Rejected unsupported format: " + probes[i].path,
+                    QuoteSystem::MessageType::WARNING);
+                continue;
             }
+            // Publish drop event before queuing for load
+            PublishDropEvent(probes[i].path, formats[i]);
+            accepted.push_back(std::move(probes[i]));
         }
 
+        // Register with the file service straight from the probes (no second file access)
+        std::vector<AssetHandle> handles = m_fileService.LoadProbed(accepted);
+        // Successes are summarized by LoadProbed; only failures are reported per file
+        for (size_t i = 0; i < accepted.size(); ++i) {
+            if (handles[i] == INVALID_HANDLE) {
+                OnLoadComplete(accepted[i].path, handles[i], false, "Load failed");
+            }
+        }
+
+        size_t batchAccepted = accepted.size();
+        size_t batchRejected = paths.size() - accepted.size();
+
         // Update statistics
         {
             std::lock_guard<std::mutex> lock(m_statsMutex);
@@ -84,9 +116,9 @@ public:
             m_stats.rejected += batchRejected;
         }
 
-        QuoteSystem::Get().Log("SUCCESS", "DropHandler",
-            "Batch complete: " + std::to_string(batchAccepted) + " accepted, " +
-            std::to_string(batchRejected) + " rejected");
+        QuoteSystem::Instance().Log("DropHandler: Batch complete: " + std::to_string(batchAccepted) +
+            " accepted, " +
+            std::to_string(batchRejected) + " rejected", QuoteSystem::MessageType::SUCCESS);
 
         m_isProcessing.store(false);
 
@@ -104,7 +136,7 @@ public:
     void ResetStats() {
         std::lock_guard<std::mutex> lock(m_statsMutex);
         m_stats = DropStats();
-        QuoteSystem::Get().Log("SUCCESS", "DropHandler", "Reset drop statistics");
+        QuoteSystem::Instance().Log("DropHandler: Reset drop statistics", QuoteSystem::MessageType::SUCCESS);
     }
 
     // Check if currently processing a drop
@@ -129,36 +161,6 @@ private:
     std::vector<std::vector<std::string>> m_dropQueue;
     mutable std::mutex m_queueMutex;
 
-    // Process a single file drop
-    bool ProcessSingleDrop(const std::string& path) {
-        if (path.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "DropHandler", "Skipping empty path");
-            return false;
-        }
-
-        // Validate format at system boundary
-        AssetFormat format = m_validator.ValidateFormat(path);
-
-        if (!FormatValidator::IsSupported(format)) {
-            QuoteSystem::Get().Log("WARNING", "DropHandler",
-                "Rejected unsupported format: " + path);
-            return false;
-        }
-
-        // Publish drop event before queuing for load
-        PublishDropEvent(path, format);
-
-        // Queue for async loading (doesn't block render loop)
-        m_fileService.LoadAsync(path, [this, path](AssetHandle handle, bool success, const std::string& error) {
-            OnLoadComplete(path, handle, success, error);
-        });
-
-        QuoteSystem::Get().Log("SUCCESS", "DropHandler",
-            "Accepted " + FormatValidator::GetFormatName(format) + ": " + path);
-
-        return true;
-    }
-
     // Queue drops received while processing
     void QueueDrop(const std::vector<std::string>& paths) {
         std::lock_guard<std::mutex> lock(m_queueMutex);
@@ -169,9 +171,8 @@ private:
             m_stats.pending += paths.size();
         }
 
-        QuoteSystem::Get().Log("SUCCESS", "DropHandler",
-            "Queued " + std::to_string(paths.size()) + " files (" +
-            std::to_string(m_dropQueue.size()) + " batches pending)");
+        QuoteSystem::Instance().Log("DropHandler: Queued " + std::to_string(paths.size()) + " files (" +
+            std::to_string(m_dropQueue.size()) + " batches pending)", QuoteSystem::MessageType::SUCCESS);
     }
 
     // Process queued drops after current batch completes
@@ -188,8 +189,8 @@ private:
             m_dropQueue.clear();
         }
 
-        QuoteSystem::Get().Log("SUCCESS", "DropHandler",
-            "Processing " + std::to_string(queue.size()) + " queued batches");
+        QuoteSystem::Instance().Log("DropHandler: Processing " + std::to_string(queue.size()) +
+            " queued batches", QuoteSystem::MessageType::SUCCESS);
 
         for (const auto& batch : queue) {
             {
@@ -201,20 +202,18 @@ private:
     }
 
     // Publish file.dropped event
-    void PublishDropEvent(const std::string& path, AssetFormat format) {
-        EventData data;
-        // Future: populate EventData with path and format
-        EventBus::Get().Publish("file.dropped", data);
+    void PublishDropEvent(const std::string& path, AssetFormat) {
+        EventBus::Instance().PublishString("file.dropped", path);
     }
 
     // Callback when async load completes
     void OnLoadComplete(const std::string& path, AssetHandle handle, bool success, const std::string& error) {
         if (success) {
-            QuoteSystem::Get().Log("SUCCESS", "DropHandler",
-                "Async load complete (handle " + std::to_string(handle) + "): " + path);
+            QuoteSystem::Instance().Log("DropHandler: Async load complete (handle " +
+                std::to_string(handle) + "): " + path, QuoteSystem::MessageType::SUCCESS);
         } else {
-            QuoteSystem::Get().Log("ERROR_MSG", "DropHandler",
-                "Async load failed: " + path + " - " + error);
+            QuoteSystem::Instance().Log("DropHandler: Async load failed: " + path + " - " + error,
+                QuoteSystem::MessageType::ERROR_MSG);
         }
     }
 };
@@ -11,10 +11,12 @@
 #include <sstream>
 #include <filesystem>
 #include <chrono>
+#include "VirtualFileSystem.h"
 #include "../core/QuoteSystem.h"
 
 namespace BrightForge {
 
+// Paths resolve through VirtualFileSystem: mounted archive entries first, then loose files
 class FileIntoString {
 public:
     FileIntoString() = default;
@@ -23,29 +25,26 @@ public:
     // Read entire file into string
     static std::string ReadFile(const std::string& path) {
         if (path.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "Cannot read empty path");
+            QuoteSystem::Instance().Log("FileIntoString: Cannot read empty path",
+                QuoteSystem::MessageType::ERROR_MSG);
             return "";
         }
 
         if (!FileExists(path)) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "File not found: " + path);
+            QuoteSystem::Instance().Log("FileIntoString: File not found: " + path,
+                QuoteSystem::MessageType::ERROR_MSG);
             return "";
         }
 
-        std::ifstream file(path, std::ios::in | std::ios::binary);
-        if (!file.is_open()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "Failed to open file: " + path);
+        std::string contents;
+        if (!VirtualFileSystem::Instance().ReadFile(path, contents)) {
+            QuoteSystem::Instance().Log("FileIntoString: Failed to read file: " + path,
+                QuoteSystem::MessageType::ERROR_MSG);
             return "";
         }
 
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string contents = buffer.str();
-
-        file.close();
-
-        QuoteSystem::Get().Log("SUCCESS", "FileIntoString",
-            "Read " + std::to_string(contents.size()) + " bytes: " + path);
+        QuoteSystem::Instance().Log("FileIntoString: Read " + std::to_string(contents.size()) +
+            " bytes: " + path, QuoteSystem::MessageType::SUCCESS);
 
         return contents;
     }
@@ -56,10 +55,11 @@ public:
             return false;
         }
 
-        bool exists = std::filesystem::exists(path);
+        bool exists = VirtualFileSystem::Instance().Exists(path);
 
         if (!exists) {
-            QuoteSystem::Get().Log("WARNING", "FileIntoString", "File not found: " + path);
+            QuoteSystem::Instance().Log("FileIntoString: File not found: " + path,
+                QuoteSystem::MessageType::WARNING);
         }
 
         return exists;
@@ -68,48 +68,52 @@ public:
     // Get file size in bytes
     static size_t GetFileSize(const std::string& path) {
         if (path.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "Cannot get size of empty path");
+            QuoteSystem::Instance().Log("FileIntoString: Cannot get size of empty path",
+                QuoteSystem::MessageType::ERROR_MSG);
             return 0;
         }
 
         if (!FileExists(path)) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "File not found: " + path);
+            QuoteSystem::Instance().Log("FileIntoString: File not found: " + path,
+                QuoteSystem::MessageType::ERROR_MSG);
             return 0;
         }
 
-        std::error_code ec;
-        size_t size = std::filesystem::file_size(path, ec);
-
-        if (ec) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString",
-                "Failed to get file size: " + path + " - " + ec.message());
+        uint64_t size = 0;
+        if (!VirtualFileSystem::Instance().Size(path, size)) {
+            QuoteSystem::Instance().Log("FileIntoString: Failed to get file size: " + path,
+                QuoteSystem::MessageType::ERROR_MSG);
             return 0;
         }
 
-        QuoteSystem::Get().Log("SUCCESS", "FileIntoString",
-            "File size: " + std::to_string(size) + " bytes - " + path);
+        QuoteSystem::Instance().Log("FileIntoString: File size: " + std::to_string(size) + " bytes - " + path,
+            QuoteSystem::MessageType::SUCCESS);
 
-        return size;
+        return static_cast<size_t>(size);
     }
 
     // Get last modification time as formatted string
     static std::string GetLastModified(const std::string& path) {
         if (path.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "Cannot get modification time of empty path");
+            QuoteSystem::Instance().Log("FileIntoString: Cannot get modification time of empty path",
+                QuoteSystem::MessageType::ERROR_MSG);
             return "";
         }
 
         if (!FileExists(path)) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "File not found: " + path);
+            QuoteSystem::Instance().Log("FileIntoString: File not found: " + path,
+                QuoteSystem::MessageType::ERROR_MSG);
             return "";
         }
 
+        // Archived entries report the archive's timestamp
+        std::string archive = VirtualFileSystem::Instance().ArchiveFor(path);
         std::error_code ec;
-        auto ftime = std::filesystem::last_write_time(path, ec);
+        auto ftime = std::filesystem::last_write_time(archive.empty() ? path : archive, ec);
 
         if (ec) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString",
-                "Failed to get modification time: " + path + " - " + ec.message());
+            QuoteSystem::Instance().Log("FileIntoString: Failed to get modification time: " + path +
+                " - " + ec.message(), QuoteSystem::MessageType::ERROR_MSG);
             return "";
         }
 
@@ -122,14 +126,15 @@ public:
 
         char buffer[64];
         if (std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::localtime(&timeT)) == 0) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "Failed to format timestamp");
+            QuoteSystem::Instance().Log("FileIntoString: Failed to format timestamp",
+                QuoteSystem::MessageType::ERROR_MSG);
             return "";
         }
 
         std::string timestamp(buffer);
 
-        QuoteSystem::Get().Log("SUCCESS", "FileIntoString",
-            "Last modified: " + timestamp + " - " + path);
+        QuoteSystem::Instance().Log("FileIntoString: Last modified: " + timestamp + " - " + path,
+            QuoteSystem::MessageType::SUCCESS);
 
         return timestamp;
     }
@@ -137,20 +142,22 @@ public:
     // Read file with size limit (prevents loading huge files into memory)
     static std::string ReadFileWithLimit(const std::string& path, size_t maxBytes) {
         if (path.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "Cannot read empty path");
+            QuoteSystem::Instance().Log("FileIntoString: Cannot read empty path",
+                QuoteSystem::MessageType::ERROR_MSG);
             return "";
         }
 
         if (!FileExists(path)) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "File not found: " + path);
+            QuoteSystem::Instance().Log("FileIntoString: File not found: " + path,
+                QuoteSystem::MessageType::ERROR_MSG);
             return "";
         }
 
         size_t fileSize = GetFileSize(path);
         if (fileSize > maxBytes) {
-            QuoteSystem::Get().Log("WARNING", "FileIntoString",
-                "File exceeds limit (" + std::to_string(fileSize) + " > " +
-                std::to_string(maxBytes) + " bytes): " + path);
+            QuoteSystem::Instance().Log("FileIntoString: File exceeds limit (" +
+                std::to_string(fileSize) + " > " +
+                std::to_string(maxBytes) + " bytes): " + path, QuoteSystem::MessageType::WARNING);
             return "";
         }
 
@@ -160,37 +167,52 @@ public:
     // Read first N lines from file
     static std::string ReadLines(const std::string& path, size_t maxLines) {
         if (path.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "Cannot read empty path");
+            QuoteSystem::Instance().Log("FileIntoString: Cannot read empty path",
+                QuoteSystem::MessageType::ERROR_MSG);
             return "";
         }
 
         if (!FileExists(path)) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "File not found: " + path);
+            QuoteSystem::Instance().Log("FileIntoString: File not found: " + path,
+                QuoteSystem::MessageType::ERROR_MSG);
             return "";
         }
 
-        std::ifstream file(path);
-        if (!file.is_open()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileIntoString", "Failed to open file: " + path);
-            return "";
+        // Archived entries decode whole; loose files stop reading at the last line needed
+        std::ifstream file;
+        std::istringstream archived;
+        std::istream* input = &file;
+        if (!VirtualFileSystem::Instance().ArchiveFor(path).empty()) {
+            std::string contents;
+            if (!VirtualFileSystem::Instance().ReadFile(path, contents)) {
+                QuoteSystem::Instance().Log("FileIntoString: Failed to read file: " + path,
+                    QuoteSystem::MessageType::ERROR_MSG);
+                return "";
+            }
+            archived.str(std::move(contents));
+            input = &archived;
+        } else {
+            file.open(path);
+            if (!file.is_open()) {
+                QuoteSystem::Instance().Log("FileIntoString: Failed to open file: " + path,
+                    QuoteSystem::MessageType::ERROR_MSG);
+                return "";
+            }
         }
 
         std::stringstream buffer;
         std::string line;
         size_t lineCount = 0;
 
-        while (lineCount < maxLines && std::getline(file, line)) {
+        while (lineCount < maxLines && std::getline(*input, line)) {
             buffer << line << '\n';
             lineCount++;
         }
 
-        file.close();
-
         std::string contents = buffer.str();
 
-        QuoteSystem::Get().Log("SUCCESS", "FileIntoString",
-            "Read " + std::to_string(lineCount) + " lines (" +
-            std::to_string(contents.size()) + " bytes): " + path);
+        QuoteSystem::Instance().Log("FileIntoString: Read " + std::to_string(lineCount) + " lines (" +
+            std::to_string(contents.size()) + " bytes): " + path, QuoteSystem::MessageType::SUCCESS);
 
         return contents;
     }
@@ -8,40 +8,58 @@
 
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <functional>
 #include <mutex>
+#include <atomic>
+#include <unordered_map>
 #include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
 #include "FormatValidator.h"
+#include "BatchIO.h"
+#include "VirtualFileSystem.h"
+#include "../core/HandlePool.h"
+#include "../core/Checksum.h"
+#include "../core/MemoryTracker.h"
+#include "../core/StringInterner.h"
 #include "../core/QuoteSystem.h"
 #include "../core/EventBus.h"
+#include "../core/JobSystem.h"
+#include "../core/TestManagerNew.h"
 
 namespace BrightForge {
 
-// Asset handle type
+// Asset handle type (generational, see HandlePool)
 using AssetHandle = uint32_t;
 
 // Invalid handle constant
 static constexpr AssetHandle INVALID_HANDLE = 0;
 
-// Asset information structure
+// Asset information structure (path is interned, see PathInterner)
 struct AssetInfo {
     AssetHandle handle;
-    std::string path;
+    PathId path;
     AssetFormat format;
     size_t sizeBytes;
     double loadTimeMs;
+    uint64_t contentHash;   // Xxh3 of the file bytes; 0 unless loaded with verify-on-load
     std::chrono::system_clock::time_point loadedAt;
 
     AssetInfo()
         : handle(INVALID_HANDLE)
-        , path("")
+        , path(INVALID_PATH_ID)
         , format(AssetFormat::UNKNOWN)
         , sizeBytes(0)
         , loadTimeMs(0.0)
+        , contentHash(0)
         , loadedAt(std::chrono::system_clock::now())
     {}
+
+    std::string PathString() const {
+        return PathInterner::Instance().Resolve(path);
+    }
 };
 
 // Async load callback signature
@@ -50,96 +68,136 @@ using LoadCallback = std::function<void(AssetHandle, bool success, const std::st
 class FileService {
 public:
     FileService()
-        : m_nextHandle(1)
-        , m_validator()
+        : m_validator()
+        , m_dropSubscription(0)
     {
         // Register debug channel
-        QuoteSystem::Get().Log("SUCCESS", "FileService", "Initialized with DebugWindow channel 'FileSystem'");
+        QuoteSystem::Instance().Log("FileService: Initialized with DebugWindow channel 'FileSystem'",
+            QuoteSystem::MessageType::SUCCESS);
 
         // Subscribe to file.dropped events
-        EventBus::Get().Subscribe("file.dropped", [this](const EventData& data) {
-            OnFileDropped(data);
-        });
+        m_dropSubscription = EventBus::Instance().Subscribe("file.dropped",
+            [this](const EventBus::EventPayload& payload) { OnFileDropped(payload); });
     }
 
     ~FileService() {
+        EventBus::Instance().Unsubscribe(m_dropSubscription);
+        WaitForAsyncLoads();
         Clear();
     }
 
     // Synchronous load - validates format and loads file immediately
     AssetHandle Load(const std::string& path) {
         if (path.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileService", "Cannot load empty path");
+            QuoteSystem::Instance().Log("FileService: Cannot load empty path",
+                QuoteSystem::MessageType::ERROR_MSG);
             PublishError(path, "Empty path provided");
             return INVALID_HANDLE;
         }
 
-        if (!std::filesystem::exists(path)) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileService", "File not found: " + path);
-            PublishError(path, "File not found");
-            return INVALID_HANDLE;
-        }
+        // One probe answers existence, size and format magic (archive entry or loose file)
+        std::vector<FileProbe> probes = VirtualFileSystem::Instance().ProbePaths({ path });
+        return LoadOne(probes[0], true);
+    }
 
-        // Validate format at system boundary
-        AssetFormat format = m_validator.ValidateFormat(path);
-        if (!FormatValidator::IsSupported(format)) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileService", "Unsupported format: " + path);
-            PublishError(path, "Unsupported format");
-            return INVALID_HANDLE;
+    // Load many files with one batched probe; handles line up with `paths`
+    // (INVALID_HANDLE for files that are missing or unsupported)
+    std::vector<AssetHandle> LoadBatch(const std::vector<std::string>& paths) {
+        return LoadProbed(VirtualFileSystem::Instance().ProbePaths(paths));
+    }
+
+    // Register already-probed files (see DropHandler); successes are summarized in one line
+    std::vector<AssetHandle> LoadProbed(const std::vector<FileProbe>& probes) {
+        std::vector<AssetHandle> handles(probes.size(), INVALID_HANDLE);
+        size_t loaded = 0;
+        uint64_t bytes = 0;
+        for (size_t i = 0; i < probes.size(); ++i) {
+            handles[i] = LoadOne(probes[i], false);
+            if (handles[i] != INVALID_HANDLE) {
+                ++loaded;
+                bytes += probes[i].size;
+            }
         }
 
-        auto startTime = std::chrono::high_resolution_clock::now();
+        QuoteSystem::Instance().Log("FileService: Loaded " + std::to_string(loaded) + " of " +
+            std::to_string(probes.size()) + " files (" +
+            std::to_string(bytes) + " bytes)", QuoteSystem::MessageType::SUCCESS);
+        return handles;
+    }
 
-        // Load file data (placeholder - actual loading depends on format)
-        size_t fileSize = std::filesystem::file_size(path);
+    // Verify-on-load: each load reads its file once and hashes it on the way through,
+    // filling AssetInfo::contentHash. Archived entries are checked against their block
+    // CRC32Cs and take the hash from the archive TOC; loose files stream through Xxh3.
+    void SetVerifyOnLoad(bool enabled) {
+        m_verifyOnLoad.store(enabled, std::memory_order_relaxed);
+    }
 
-        auto endTime = std::chrono::high_resolution_clock::now();
-        double loadTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    bool GetVerifyOnLoad() const {
+        return m_verifyOnLoad.load(std::memory_order_relaxed);
+    }
 
-        // Create asset info
-        AssetInfo info;
-        info.handle = GenerateHandle();
-        info.path = path;
-        info.format = format;
-        info.sizeBytes = fileSize;
-        info.loadTimeMs = loadTimeMs;
-        info.loadedAt = std::chrono::system_clock::now();
+    // Expected content hash (Xxh3) for a path, e.g. from a build manifest. Verified
+    // loads of that path fail when the content hashes differently.
+    void SetExpectedHash(const std::string& path, uint64_t contentHash) {
+        PathId pathId = PathInterner::Instance().Intern(path);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_expectedHashes[pathId] = contentHash;
+    }
 
-        // Store in registry
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_loadedAssets[info.handle] = info;
+    // A loaded asset with identical content (verified loads only), for dedup
+    AssetHandle FindByContentHash(uint64_t contentHash) const {
+        if (contentHash == 0) {
+            return INVALID_HANDLE;
         }
-
-        QuoteSystem::Get().Log("SUCCESS", "FileService",
-            "Loaded " + FormatValidator::GetFormatName(format) +
-            " (" + std::to_string(fileSize) + " bytes) in " +
-            std::to_string(loadTimeMs) + "ms: " + path);
-
-        PublishLoaded(info);
-        return info.handle;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const AssetInfo& info : m_loadedAssets) {
+            if (info.contentHash == contentHash) {
+                return info.handle;
+            }
+        }
+        return INVALID_HANDLE;
     }
 
-    // Asynchronous load - queues for background loading
+    // Asynchronous load - runs Load() as a JobSystem job. The callback runs on the
+    // thread that ran the job (a worker, or whoever waits); without workers the load
+    // runs inline. The service must outlive its pending loads (the destructor waits).
     void LoadAsync(const std::string& path, LoadCallback callback) {
         if (path.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileService", "Cannot queue empty path");
+            QuoteSystem::Instance().Log("FileService: Cannot queue empty path",
+                QuoteSystem::MessageType::ERROR_MSG);
             if (callback) {
                 callback(INVALID_HANDLE, false, "Empty path provided");
             }
             return;
         }
 
-        // Queue for async processing (simple immediate execution for now)
-        // Future: add thread pool or job queue
-        QuoteSystem::Get().Log("SUCCESS", "FileService", "Queuing async load: " + path);
+        QuoteSystem::Instance().Log("FileService: Queuing async load: " + path,
+            QuoteSystem::MessageType::SUCCESS);
 
-        AssetHandle handle = Load(path);
-        bool success = (handle != INVALID_HANDLE);
+        auto job = [this, path, callback]() {
+            AssetHandle handle = Load(path);
+            bool success = (handle != INVALID_HANDLE);
+            if (callback) {
+                callback(handle, success, success ? "" : "Load failed");
+            }
+        };
 
-        if (callback) {
-            callback(handle, success, success ? "" : "Load failed");
+        JobSystem& jobs = JobSystem::Instance();
+        if (jobs.Concurrency() <= 1) {
+            job();
+            return;
         }
+        jobs.Submit(std::move(job), m_asyncLoads);
+    }
+
+    // Block until every LoadAsync() issued so far has run its callback; the caller
+    // helps run queued jobs meanwhile
+    void WaitForAsyncLoads() {
+        JobSystem::Instance().Wait(m_asyncLoads);
+    }
+
+    size_t PendingAsyncLoads() const {
+        return m_asyncLoads.pending.load(std::memory_order_acquire);
     }
 
     // Get all loaded assets
@@ -147,11 +205,7 @@ public:
         std::lock_guard<std::mutex> lock(m_mutex);
 
         std::vector<AssetInfo> assets;
-        assets.reserve(m_loadedAssets.size());
-
-        for (const auto& [handle, info] : m_loadedAssets) {
-            assets.push_back(info);
-        }
+        assets.assign(m_loadedAssets.begin(), m_loadedAssets.end());
 
         return assets;
     }
@@ -159,22 +213,26 @@ public:
     // Unload asset and free resources
     bool Unload(AssetHandle handle) {
         if (handle == INVALID_HANDLE) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileService", "Cannot unload invalid handle");
+            QuoteSystem::Instance().Log("FileService: Cannot unload invalid handle",
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        auto it = m_loadedAssets.find(handle);
-        if (it == m_loadedAssets.end()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FileService", "Handle not found: " + std::to_string(handle));
+        const AssetInfo* info = m_loadedAssets.Get(handle);
+        if (info == nullptr) {
+            QuoteSystem::Instance().Log("FileService: Handle not found: " + std::to_string(handle),
+                QuoteSystem::MessageType::ERROR_MSG);
             return false;
         }
 
-        std::string path = it->second.path;
-        m_loadedAssets.erase(it);
+        std::string path = info->PathString();
+        MemoryTracker::Instance().Release(MemoryTag::FILE_SERVICE, sizeof(AssetInfo));
+        m_loadedAssets.Remove(handle);
 
-        QuoteSystem::Get().Log("SUCCESS", "FileService", "Unloaded handle " + std::to_string(handle) + ": " + path);
+        QuoteSystem::Instance().Log("FileService: Unloaded handle " + std::to_string(handle) + ": " + path,
+            QuoteSystem::MessageType::SUCCESS);
         return true;
     }
 
@@ -186,60 +244,357 @@ public:
 
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        auto it = m_loadedAssets.find(handle);
-        if (it == m_loadedAssets.end()) {
+        const AssetInfo* info = m_loadedAssets.Get(handle);
+        if (info == nullptr) {
             return false;
         }
 
-        outInfo = it->second;
+        outInfo = *info;
         return true;
     }
 
+    // Handle of a loaded asset by path; an integer compare per asset, nothing is interned
+    AssetHandle FindByPath(const std::string& path) const {
+        PathId pathId = PathInterner::Instance().Find(path);
+        if (pathId == INVALID_PATH_ID) {
+            return INVALID_HANDLE;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const AssetInfo& info : m_loadedAssets) {
+            if (info.path == pathId) {
+                return info.handle;
+            }
+        }
+        return INVALID_HANDLE;
+    }
+
     // Clear all loaded assets
     void Clear() {
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        size_t count = m_loadedAssets.size();
-        m_loadedAssets.clear();
+        size_t count = m_loadedAssets.Size();
+        MemoryTracker::Instance().Release(MemoryTag::FILE_SERVICE, count * sizeof(AssetInfo));
+        m_loadedAssets.Clear();
 
         if (count > 0) {
-            QuoteSystem::Get().Log("SUCCESS", "FileService", "Cleared " + std::to_string(count) + " assets");
+            QuoteSystem::Instance().Log("FileService: Cleared " + std::to_string(count) + " assets",
+                QuoteSystem::MessageType::SUCCESS);
         }
     }
 
     // Get total loaded asset count
     size_t GetLoadedCount() const {
         std::lock_guard<std::mutex> lock(m_mutex);
-        return m_loadedAssets.size();
+        return m_loadedAssets.Size();
     }
 
+    // Verified, batched and archive-backed loads against real files (scratch directories)
+    static void RegisterTests();
+
 private:
-    AssetHandle m_nextHandle;
     FormatValidator m_validator;
-    std::unordered_map<AssetHandle, AssetInfo> m_loadedAssets;
+    HandlePool<AssetInfo> m_loadedAssets;
+    std::unordered_map<PathId, uint64_t> m_expectedHashes;
+    std::atomic<bool> m_verifyOnLoad{ false };
+    JobCounter m_asyncLoads;
+    size_t m_dropSubscription;
     mutable std::mutex m_mutex;
 
-    AssetHandle GenerateHandle() {
-        return m_nextHandle++;
+    // verbose: per-file validation and success logs (single loads); batches log a summary
+    AssetHandle LoadOne(const FileProbe& probe, bool verbose) {
+        if (probe.path.empty()) {
+            QuoteSystem::Instance().Log("FileService: Cannot load empty path",
+                QuoteSystem::MessageType::ERROR_MSG);
+            PublishError(probe.path, "Empty path provided");
+            return INVALID_HANDLE;
+        }
+
+        if (!probe.exists) {
+            QuoteSystem::Instance().Log("FileService: File not found: " + probe.path,
+                QuoteSystem::MessageType::ERROR_MSG);
+            PublishError(probe.path, "File not found");
+            return INVALID_HANDLE;
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        // Validate format at system boundary
+        AssetFormat format = verbose ? m_validator.ValidateProbe(probe) : FormatValidator::Classify(probe);
+        if (!FormatValidator::IsSupported(format)) {
+            QuoteSystem::Instance().Log("FileService: Unsupported format: " + probe.path,
+                QuoteSystem::MessageType::ERROR_MSG);
+            PublishError(probe.path, "Unsupported format");
+            return INVALID_HANDLE;
+        }
+
+        uint64_t contentHash = 0;
+        if (m_verifyOnLoad.load(std::memory_order_relaxed)) {
+            std::string error;
+            if (!VerifyContent(probe, contentHash, error)) {
+                QuoteSystem::Instance().Log("FileService: " + error + ": " + probe.path,
+                    QuoteSystem::MessageType::ERROR_MSG);
+                PublishError(probe.path, error);
+                return INVALID_HANDLE;
+            }
+        }
+
+        // Load file data (placeholder - actual loading depends on format)
+        size_t fileSize = static_cast<size_t>(probe.size);
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        double loadTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        // Create asset info
+        AssetInfo info;
+        info.path = PathInterner::Instance().Intern(probe.path);
+        info.format = format;
+        info.sizeBytes = fileSize;
+        info.loadTimeMs = loadTimeMs;
+        info.contentHash = contentHash;
+        info.loadedAt = std::chrono::system_clock::now();
+
+        // Store in registry; the pool mints the handle
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            info.handle = m_loadedAssets.Insert(info);
+            if (info.handle == INVALID_HANDLE) {
+                PublishError(probe.path, "Asset registry full");
+                return INVALID_HANDLE;
+            }
+            m_loadedAssets.Get(info.handle)->handle = info.handle;
+            MemoryTracker::Instance().Add(MemoryTag::FILE_SERVICE, sizeof(AssetInfo));
+        }
+
+        if (verbose) {
+            QuoteSystem::Instance().Log("FileService: Loaded " + FormatValidator::GetFormatName(format) +
+                " (" + std::to_string(fileSize) + " bytes) in " +
+                std::to_string(loadTimeMs) + "ms: " + probe.path, QuoteSystem::MessageType::SUCCESS);
+        }
+
+        PublishLoaded(info);
+        return info.handle;
     }
 
-    void OnFileDropped(const EventData& data) {
-        // Handle file.dropped event (path should be in data)
-        // Future: extract path from EventData and queue for loading
-        QuoteSystem::Get().Log("SUCCESS", "FileService", "Received file.dropped event");
+    // One pass over the file: archived entries decode and check each block's CRC32C,
+    // loose files stream through Xxh3. Then compare against any expected hash.
+    bool VerifyContent(const FileProbe& probe, uint64_t& outHash, std::string& error) const {
+        VirtualFileSystem& vfs = VirtualFileSystem::Instance();
+        if (vfs.ArchivedContentHash(probe.path, outHash)) {
+            if (!vfs.VerifyArchived(probe.path)) {
+                error = "Checksum mismatch";
+                return false;
+            }
+        } else {
+            Xxh3 running;
+            uint64_t streamed = 0;
+            bool read = IoBackend::Default().Stream(probe.path, [&](const uint8_t* data, size_t size) {
+                running.Update(data, size);
+                streamed += size;
+                return true;
+            });
+            if (!read || streamed != probe.size) {
+                error = "Read failed";
+                return false;
+            }
+            outHash = running.Finish();
+        }
+
+        PathId pathId = PathInterner::Instance().Find(probe.path);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto expected = m_expectedHashes.find(pathId);
+        if (pathId != INVALID_PATH_ID && expected != m_expectedHashes.end() && expected->second != outHash) {
+            error = "Checksum mismatch";
+            return false;
+        }
+        return true;
+    }
+
+    // DropHandler registers dropped files itself; this only records the drop
+    void OnFileDropped(const EventBus::EventPayload& payload) {
+        const std::string* path = std::get_if<std::string>(&payload);
+        QuoteSystem::Instance().Log("FileService: Received file.dropped event" +
+            (path != nullptr ? ": " + *path : std::string()), QuoteSystem::MessageType::SUCCESS);
     }
 
     void PublishLoaded(const AssetInfo& info) {
-        EventData data;
-        // Future: populate EventData with asset info
-        EventBus::Get().Publish("file.loaded", data);
+        EventBus::Instance().PublishString("file.loaded", info.PathString());
     }
 
     void PublishError(const std::string& path, const std::string& error) {
-        EventData data;
-        // Future: populate EventData with error details
-        EventBus::Get().Publish("file.error", data);
+        EventBus::Instance().PublishString("file.error", error + ": " + path);
     }
 };
 
+inline void FileService::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("FileService", TestManagerNew::SuiteMode::SERIAL);
+
+    // Loose files stream through Xxh3 while they are read; a manifest hash that
+    // disagrees fails the load and registers nothing
+    tests.AddTest("FileService", "Verified loads accept matching content and reject mismatches", []() {
+        BatchIOTesting::ScratchFiles files("brightforge_fileservice_verify", 2);
+        const std::string& good = files.paths[0];
+        const std::string& bad = files.paths[1];
+        uint64_t goodHash = Xxh3::Hash64(files.contents[0].data(), files.contents[0].size());
+        uint64_t badHash = Xxh3::Hash64(files.contents[1].data(), files.contents[1].size());
+
+        FileService service;
+        service.SetVerifyOnLoad(true);
+        service.SetExpectedHash(good, goodHash);
+        service.SetExpectedHash(bad, badHash ^ 1);
+
+        AssetInfo info;
+        AssetHandle accepted = service.Load(good);
+        bool ok = accepted != INVALID_HANDLE && service.GetAssetInfo(accepted, info) && info.contentHash == goodHash &&
+                  service.FindByContentHash(goodHash) == accepted;
+        ok = ok && service.Load(bad) == INVALID_HANDLE && service.GetLoadedCount() == 1 &&
+             service.FindByContentHash(badHash) == INVALID_HANDLE;
+
+        // Correcting the manifest lets the same bytes through
+        service.SetExpectedHash(bad, badHash);
+        AssetHandle corrected = service.Load(bad);
+        ok = ok && corrected != INVALID_HANDLE && service.FindByContentHash(badHash) == corrected;
+
+        // Unverified loads hash nothing
+        service.SetVerifyOnLoad(false);
+        AssetHandle unverified = service.Load(good);
+        return ok && unverified != INVALID_HANDLE && service.GetAssetInfo(unverified, info) && info.contentHash == 0;
+    });
+
+    // More files than one io_uring round; misses and unsupported files keep their slot
+    tests.AddTest("FileService", "Batch loads line up with their probes and contents", []() {
+        BatchIOTesting::ScratchFiles files("brightforge_fileservice_batch", BATCH_IO_QUEUE_DEPTH + 21);
+        std::string unsupported = (files.dir / "notes.txt").string();
+        std::ofstream(unsupported, std::ios::binary) << "plain text";
+        std::vector<std::string> paths = files.paths;
+        paths.push_back((files.dir / "missing.bin").string());
+        paths.push_back(unsupported);
+
+        std::vector<FileProbe> probes = VirtualFileSystem::Instance().ProbePaths(paths);
+        FileService service;
+        service.SetVerifyOnLoad(true);
+        std::vector<AssetHandle> handles = service.LoadBatch(paths);
+
+        bool ok = handles.size() == paths.size() && service.GetLoadedCount() == files.paths.size();
+        for (size_t i = 0; ok && i < files.paths.size(); ++i) {
+            const std::string& body = files.contents[i];
+            size_t headerBytes = std::min(body.size(), BATCH_IO_HEADER_BYTES);
+            AssetInfo info;
+            ok = probes[i].exists && probes[i].size == body.size() && probes[i].headerBytes == headerBytes &&
+                 std::memcmp(probes[i].header, body.data(), headerBytes) == 0 &&
+                 service.GetAssetInfo(handles[i], info) && info.sizeBytes == body.size() &&
+                 info.format == (i % 2 == 0 ? AssetFormat::GLB : AssetFormat::HDR) &&
+                 info.contentHash == Xxh3::Hash64(body.data(), body.size()) &&
+                 info.path == PathInterner::Instance().Find(paths[i]);
+        }
+        return ok && !probes[files.paths.size()].exists && handles[files.paths.size()] == INVALID_HANDLE &&
+               probes.back().exists && handles.back() == INVALID_HANDLE;
+    });
+
+    // Mounted archives answer first under their mount point; everything else (and the
+    // same paths once unmounted) falls through to loose files on disk
+    tests.AddTest("FileService", "Archived entries shadow loose files and misses fall through", []() {
+        BatchIOTesting::ScratchFiles files("brightforge_fileservice_vfs", 0);
+        std::error_code ec;
+        std::filesystem::create_directories(files.dir / "assets", ec);
+        std::ofstream((files.dir / "assets" / "shared.gltf").string(), std::ios::binary) << "loose";
+        std::ofstream((files.dir / "assets" / "only_loose.gltf").string(), std::ios::binary) << "disk";
+
+        std::string shared = "glTF" + std::string(70000, 's');
+        std::string packedOnly = "glTF" + std::string(300, 'q');
+        std::string pakPath = (files.dir / "assets.bfpak").string();
+        PakWriter writer;
+        writer.AddData("shared.gltf", std::vector<uint8_t>(shared.begin(), shared.end()));
+        writer.AddData("only_packed.gltf", std::vector<uint8_t>(packedOnly.begin(), packedOnly.end()));
+        std::string mountPoint = (files.dir / "assets").generic_string();
+        VirtualFileSystem& vfs = VirtualFileSystem::Instance();
+        if (!writer.Write(pakPath) || !vfs.Mount(pakPath, mountPoint)) {
+            return false;
+        }
+
+        FileService service;
+        service.SetVerifyOnLoad(true);
+        std::vector<AssetHandle> handles = service.LoadBatch({ mountPoint + "/shared.gltf",
+            mountPoint + "/only_packed.gltf", mountPoint + "/only_loose.gltf", mountPoint + "/missing.gltf" });
+        auto loaded = [&](AssetHandle handle, const std::string& body) {
+            AssetInfo info;
+            return service.GetAssetInfo(handle, info) && info.sizeBytes == body.size() &&
+                   info.contentHash == Xxh3::Hash64(body.data(), body.size());
+        };
+        bool ok = loaded(handles[0], shared) && loaded(handles[1], packedOnly) && loaded(handles[2], "disk") &&
+                  handles[3] == INVALID_HANDLE;
+
+        vfs.Unmount(pakPath);
+        ok = ok && loaded(service.Load(mountPoint + "/shared.gltf"), "loose") &&
+             service.Load(mountPoint + "/only_packed.gltf") == INVALID_HANDLE;
+        return ok;
+    });
+
+    // Assets hold interned PathIds: lookups compare ids, accept any spelling that
+    // normalizes to the same path and never intern the query
+    tests.AddTest("FileService", "FindByPath matches interned ids without interning", []() {
+        BatchIOTesting::ScratchFiles files("brightforge_fileservice_paths", 2);
+        std::string ghost = (files.dir / "never_loaded" / "ghost.glb").string();
+        FileService service;
+        FileService other;
+        bool ok = service.FindByPath(ghost) == INVALID_HANDLE && PathInterner::Instance().Find(ghost) == INVALID_PATH_ID;
+
+        AssetHandle first = service.Load(files.paths[0]);
+        AssetHandle second = service.Load(files.paths[1]);
+        std::string respelled = files.dir.generic_string() + "//./file1.bin";
+        AssetInfo info;
+        ok = ok && first != INVALID_HANDLE && second != INVALID_HANDLE && service.FindByPath(files.paths[0]) == first &&
+             service.FindByPath(respelled) == second && service.GetAssetInfo(second, info) &&
+             info.path == PathInterner::Instance().Find(files.paths[1]) && other.FindByPath(files.paths[0]) == INVALID_HANDLE;
+
+        // Unloading forgets the asset; the path stays interned for the next load
+        ok = ok && service.Unload(first) && service.FindByPath(files.paths[0]) == INVALID_HANDLE &&
+             PathInterner::Instance().Find(files.paths[0]) != INVALID_PATH_ID;
+        return ok && PathInterner::Instance().Find(ghost) == INVALID_PATH_ID;
+    });
+
+    // Handles are generational: a reused slot never answers to the handle it had before
+    tests.AddTest("FileService", "Unloaded handles go stale even after their slot is reused", []() {
+        BatchIOTesting::ScratchFiles files("brightforge_fileservice_handles", 1);
+        FileService service;
+        AssetInfo info;
+        AssetHandle first = service.Load(files.paths[0]);
+        bool ok = first != INVALID_HANDLE && service.GetAssetInfo(first, info) && info.handle == first &&
+                  service.Unload(first) && !service.GetAssetInfo(first, info) && !service.Unload(first) &&
+                  !service.Unload(INVALID_HANDLE);
+
+        AssetHandle second = service.Load(files.paths[0]);
+        ok = ok && second != INVALID_HANDLE && second != first && !service.GetAssetInfo(first, info) &&
+             !service.Unload(first) && service.GetAssetInfo(second, info) && info.handle == second &&
+             service.GetLoadedCount() == 1;
+
+        service.Clear();
+        return ok && !service.GetAssetInfo(second, info) && !service.Unload(second) && service.GetLoadedCount() == 0;
+    });
+
+    // Each registered asset is reported under FILE_SERVICE until it is unloaded, cleared
+    // or its service is destroyed
+    tests.AddTest("FileService", "Memory tracker follows loads, unloads and teardown", []() {
+        BatchIOTesting::ScratchFiles files("brightforge_fileservice_memory", 3);
+        MemoryTracker& tracker = MemoryTracker::Instance();
+        const size_t before = tracker.CurrentBytes(MemoryTag::FILE_SERVICE);
+        bool ok = true;
+        {
+            FileService service;
+            std::vector<AssetHandle> handles = service.LoadBatch(files.paths);
+            auto held = [&](size_t assets) {
+                return tracker.CurrentBytes(MemoryTag::FILE_SERVICE) == before + assets * sizeof(AssetInfo);
+            };
+            ok = held(3) && service.Unload(handles[1]) && held(2) && !service.Unload(handles[1]) && held(2);
+            service.Clear();
+            ok = ok && held(0);
+
+            service.Load(files.paths[0]);
+            ok = ok && held(1);
+        }
+        return ok && tracker.CurrentBytes(MemoryTag::FILE_SERVICE) == before;
+    });
+}
+
 } // namespace BrightForge
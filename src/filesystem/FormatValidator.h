@@ -7,8 +7,11 @@
 #pragma once
 
 #include <string>
-#include <fstream>
+#include <vector>
+#include <cstring>
 #include <filesystem>
+#include "BatchIO.h"
+#include "VirtualFileSystem.h"
 #include "../core/QuoteSystem.h"
 
 namespace BrightForge {
@@ -34,32 +37,74 @@ public:
     // Validate file format by magic bytes (primary) and extension (fallback)
     AssetFormat ValidateFormat(const std::string& path) {
         if (path.empty()) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FormatValidator", "Cannot validate empty path");
+            QuoteSystem::Instance().Log("FormatValidator: Cannot validate empty path",
+                QuoteSystem::MessageType::ERROR_MSG);
             return AssetFormat::UNKNOWN;
         }
 
-        if (!std::filesystem::exists(path)) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FormatValidator", "File does not exist: " + path);
-            return AssetFormat::UNKNOWN;
-        }
-
-        AssetFormat format = CheckMagicBytes(path);
+        std::vector<FileProbe> probes = VirtualFileSystem::Instance().ProbePaths({ path });
+        return ValidateProbe(probes[0]);
+    }
 
-        // Fallback to extension if magic bytes didn't match
-        if (format == AssetFormat::UNKNOWN) {
-            format = CheckExtension(path);
+    // Validate from an existing probe (no file access); logs like ValidateFormat
+    AssetFormat ValidateProbe(const FileProbe& probe) {
+        if (!probe.exists) {
+            QuoteSystem::Instance().Log("FormatValidator: File does not exist: " + probe.path,
+                QuoteSystem::MessageType::ERROR_MSG);
+            return AssetFormat::UNKNOWN;
         }
 
+        AssetFormat format = Classify(probe);
         std::string formatName = GetFormatName(format);
         if (format == AssetFormat::UNKNOWN) {
-            QuoteSystem::Get().Log("ERROR_MSG", "FormatValidator", "Unsupported format: " + path);
+            QuoteSystem::Instance().Log("FormatValidator: Unsupported format: " + probe.path,
+                QuoteSystem::MessageType::ERROR_MSG);
         } else {
-            QuoteSystem::Get().Log("SUCCESS", "FormatValidator", "Validated as " + formatName + ": " + path);
+            QuoteSystem::Instance().Log("FormatValidator: Validated as " + formatName + ": " + probe.path,
+                QuoteSystem::MessageType::SUCCESS);
         }
 
         return format;
     }
 
+    // Validate a whole drop with one batched probe. Only rejects are logged per file;
+    // accepted files are summarized, so large drops stay I/O-bound.
+    std::vector<AssetFormat> ValidateFormats(const std::vector<FileProbe>& probes) {
+        std::vector<AssetFormat> formats(probes.size(), AssetFormat::UNKNOWN);
+        size_t accepted = 0;
+        for (size_t i = 0; i < probes.size(); ++i) {
+            if (!probes[i].exists) {
+                QuoteSystem::Instance().Log("FormatValidator: File does not exist: " + probes[i].path,
+                    QuoteSystem::MessageType::ERROR_MSG);
+                continue;
+            }
+            formats[i] = Classify(probes[i]);
+            if (formats[i] == AssetFormat::UNKNOWN) {
+                QuoteSystem::Instance().Log("FormatValidator: Unsupported format: " + probes[i].path,
+                    QuoteSystem::MessageType::ERROR_MSG);
+            } else {
+                ++accepted;
+            }
+        }
+
+        QuoteSystem::Instance().Log("FormatValidator: Validated " + std::to_string(accepted) + " of " +
+            std::to_string(probes.size()) + " files", QuoteSystem::MessageType::SUCCESS);
+        return formats;
+    }
+
+    std::vector<AssetFormat> ValidateFormats(const std::vector<std::string>& paths) {
+        return ValidateFormats(VirtualFileSystem::Instance().ProbePaths(paths));
+    }
+
+    // Magic bytes first, extension as the fallback
+    static AssetFormat Classify(const FileProbe& probe) {
+        AssetFormat format = CheckMagicBytes(probe.header, probe.headerBytes);
+        if (format == AssetFormat::UNKNOWN) {
+            format = CheckExtension(probe.path);
+        }
+        return format;
+    }
+
     // Get human-readable format name
     static std::string GetFormatName(AssetFormat format) {
         switch (format) {
@@ -88,23 +133,15 @@ private:
     static constexpr const char* MAGIC_HDR = "#?RADIANCE";
     static constexpr const char* MAGIC_FBX = "Kaydara FBX Binary";
 
-    AssetFormat CheckMagicBytes(const std::string& path) {
-        std::ifstream file(path, std::ios::binary);
-        if (!file.is_open()) {
-            return AssetFormat::UNKNOWN;
-        }
-
-        // Read first 32 bytes for magic byte checks
-        unsigned char buffer[32] = {0};
-        file.read(reinterpret_cast<char*>(buffer), sizeof(buffer));
-        size_t bytesRead = file.gcount();
-
+    // `buffer` holds the first `bytesRead` bytes of the file (see FileProbe::header)
+    static AssetFormat CheckMagicBytes(const uint8_t* buffer, size_t bytesRead) {
         if (bytesRead < 4) {
             return AssetFormat::UNKNOWN;
         }
 
         // Check GLB (4-byte signature)
-        uint32_t signature32 = *reinterpret_cast<const uint32_t*>(buffer);
+        uint32_t signature32 = 0;
+        std::memcpy(&signature32, buffer, sizeof(signature32));
         if (signature32 == MAGIC_GLB) {
             return AssetFormat::GLB;
         }
@@ -115,14 +152,15 @@ private:
         }
 
         // Check JPEG (2-byte signature)
-        uint16_t signature16 = *reinterpret_cast<const uint16_t*>(buffer);
+        uint16_t signature16 = 0;
+        std::memcpy(&signature16, buffer, sizeof(signature16));
         if (signature16 == MAGIC_JPG) {
             return AssetFormat::JPG;
         }
 
-        // Check HDR (text signature)
-        if (bytesRead >= 11) {
-            std::string headerStr(reinterpret_cast<const char*>(buffer), 11);
+        // Check HDR (text signature, 10 characters)
+        if (bytesRead >= 10) {
+            std::string headerStr(reinterpret_cast<const char*>(buffer), 10);
             if (headerStr == MAGIC_HDR) {
                 return AssetFormat::HDR;
             }
@@ -139,7 +177,7 @@ private:
         return AssetFormat::UNKNOWN;
     }
 
-    AssetFormat CheckExtension(const std::string& path) {
+    static AssetFormat CheckExtension(const std::string& path) {
         std::filesystem::path filePath(path);
         std::string ext = filePath.extension().string();
 
@@ -0,0 +1,420 @@
+/**
+ * Inflate - DEFLATE / zlib decompression into caller-owned buffers
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace BrightForge {
+
+// Self-contained RFC 1950/1951 decoder
+// Output goes into a fixed destination whose size the caller already knows (FBX arrays,
+// PNG rows, pak entries), so there is no growth path and no allocation at all.
+// Stateless and re-entrant: safe to run many decompressions in parallel.
+class Inflate {
+public:
+    // Decompress a zlib stream (2-byte header, deflate data, Adler-32 trailer)
+    static bool DecompressZlib(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize,
+                               size_t* written = nullptr) {
+        // Guard: header + trailer
+        if (src == nullptr || srcSize < 6) {
+            return false;
+        }
+
+        uint8_t cmf = src[0];
+        uint8_t flg = src[1];
+        if ((cmf & 0x0F) != 8 || (cmf >> 4) > 7 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20) != 0) {
+            return false;    // Not deflate, bad check bits, or preset dictionary
+        }
+
+        size_t produced = 0;
+        if (!DecompressRaw(src + 2, srcSize - 6, dst, dstSize, &produced)) {
+            return false;
+        }
+
+        const uint8_t* trailer = src + srcSize - 4;
+        uint32_t expected = (static_cast<uint32_t>(trailer[0]) << 24) | (static_cast<uint32_t>(trailer[1]) << 16) |
+                            (static_cast<uint32_t>(trailer[2]) << 8) | trailer[3];
+        if (Adler32(dst, produced) != expected) {
+            return false;
+        }
+
+        if (written != nullptr) {
+            *written = produced;
+        }
+        return true;
+    }
+
+    // Decompress raw deflate data (no zlib wrapper)
+    static bool DecompressRaw(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize,
+                              size_t* written = nullptr) {
+        BitReader in(src, srcSize);
+        size_t out = 0;
+
+        bool last = false;
+        while (!last) {
+            last = in.Read(1) != 0;
+            uint32_t type = in.Read(2);
+
+            bool ok = false;
+            if (type == 0) {
+                ok = StoredBlock(in, dst, dstSize, out);
+            } else if (type == 1) {
+                Huffman lengths;
+                Huffman distances;
+                BuildFixed(lengths, distances);
+                ok = CompressedBlock(in, lengths, distances, dst, dstSize, out);
+            } else if (type == 2) {
+                Huffman lengths;
+                Huffman distances;
+                ok = ReadDynamicTables(in, lengths, distances) &&
+                     CompressedBlock(in, lengths, distances, dst, dstSize, out);
+            }
+
+            if (!ok || in.failed) {
+                return false;
+            }
+        }
+
+        if (written != nullptr) {
+            *written = out;
+        }
+        return true;
+    }
+
+    static uint32_t Adler32(const uint8_t* data, size_t size) {
+        // 5552 is the largest block for which the sums cannot overflow 32 bits
+        constexpr uint32_t MOD = 65521;
+        constexpr size_t BLOCK = 5552;
+        uint32_t a = 1;
+        uint32_t b = 0;
+        while (size > 0) {
+            size_t n = size < BLOCK ? size : BLOCK;
+            size -= n;
+            while (n-- > 0) {
+                a += *data++;
+                b += a;
+            }
+            a %= MOD;
+            b %= MOD;
+        }
+        return (b << 16) | a;
+    }
+
+    // Prevent instantiation (static API)
+    Inflate() = delete;
+
+private:
+    static constexpr int MAX_BITS = 15;
+    static constexpr int FAST_BITS = 10;
+    static constexpr int MAX_LENGTH_CODES = 288;
+    static constexpr int MAX_DISTANCE_CODES = 30;
+
+    // LSB-first bit reader. Refills only with real input bytes so stored blocks can
+    // rewind to an exact byte position; reading past the end sets `failed`.
+    struct BitReader {
+        const uint8_t* pos;
+        const uint8_t* end;
+        uint64_t bits = 0;
+        uint32_t count = 0;
+        bool failed = false;
+
+        BitReader(const uint8_t* src, size_t size) : pos(src), end(src + size) {}
+
+        void Refill() {
+            while (count <= 56 && pos < end) {
+                bits |= static_cast<uint64_t>(*pos++) << count;
+                count += 8;
+            }
+        }
+
+        uint32_t Peek(uint32_t n) {
+            if (count < n) {
+                Refill();
+            }
+            return static_cast<uint32_t>(bits & ((1ull << n) - 1));
+        }
+
+        void Consume(uint32_t n) {
+            if (count < n) {
+                failed = true;
+                count = 0;
+                bits = 0;
+                return;
+            }
+            bits >>= n;
+            count -= n;
+        }
+
+        uint32_t Read(uint32_t n) {
+            if (n == 0) {
+                return 0;
+            }
+            uint32_t value = Peek(n);
+            Consume(n);
+            return value;
+        }
+
+        // Drop partial-byte bits and hand back whole buffered bytes
+        void AlignToByte() {
+            uint32_t drop = count & 7;
+            bits >>= drop;
+            count -= drop;
+            pos -= count / 8;
+            bits = 0;
+            count = 0;
+        }
+    };
+
+    // Canonical Huffman decoder: a FAST_BITS lookup table resolves most symbols in one
+    // probe; longer codes fall back to walking the per-length counts.
+    struct Huffman {
+        uint16_t fast[1 << FAST_BITS];    // (length << 9) | symbol, 0 = not in table
+        uint16_t counts[MAX_BITS + 1];
+        uint16_t symbols[MAX_LENGTH_CODES];
+
+        bool Build(const uint8_t* lengths, int n) {
+            std::memset(counts, 0, sizeof(counts));
+            std::memset(fast, 0, sizeof(fast));
+            for (int s = 0; s < n; ++s) {
+                ++counts[lengths[s]];
+            }
+            counts[0] = 0;
+
+            // Reject over-subscribed sets; incomplete sets are legal (e.g. one distance code)
+            int left = 1;
+            for (int len = 1; len <= MAX_BITS; ++len) {
+                left = (left << 1) - counts[len];
+                if (left < 0) {
+                    return false;
+                }
+            }
+
+            uint16_t offsets[MAX_BITS + 2];
+            uint16_t nextCode[MAX_BITS + 2];
+            offsets[1] = 0;
+            nextCode[1] = 0;
+            for (int len = 1; len <= MAX_BITS; ++len) {
+                offsets[len + 1] = offsets[len] + counts[len];
+                nextCode[len + 1] = static_cast<uint16_t>((nextCode[len] + counts[len]) << 1);
+            }
+
+            for (int s = 0; s < n; ++s) {
+                int len = lengths[s];
+                if (len == 0) {
+                    continue;
+                }
+
+                symbols[offsets[len]++] = static_cast<uint16_t>(s);
+                uint32_t code = nextCode[len]++;
+                if (len > FAST_BITS) {
+                    continue;
+                }
+
+                // Deflate stores codes MSB-first inside an LSB-first stream
+                uint32_t reversed = 0;
+                for (int b = 0; b < len; ++b) {
+                    reversed |= ((code >> b) & 1u) << (len - 1 - b);
+                }
+                uint16_t entry = static_cast<uint16_t>((len << 9) | s);
+                for (uint32_t fill = reversed; fill < (1u << FAST_BITS); fill += (1u << len)) {
+                    fast[fill] = entry;
+                }
+            }
+            return true;
+        }
+
+        int Decode(BitReader& in) const {
+            uint32_t window = in.Peek(MAX_BITS);
+            uint16_t entry = fast[window & ((1u << FAST_BITS) - 1)];
+            if (entry != 0) {
+                in.Consume(entry >> 9);
+                return entry & 0x1FF;
+            }
+
+            int code = 0;
+            int first = 0;
+            int index = 0;
+            for (int len = 1; len <= MAX_BITS; ++len) {
+                code |= static_cast<int>((window >> (len - 1)) & 1u);
+                int count = counts[len];
+                if (code - count < first) {
+                    in.Consume(static_cast<uint32_t>(len));
+                    return symbols[index + (code - first)];
+                }
+                index += count;
+                first += count;
+                first <<= 1;
+                code <<= 1;
+            }
+            in.failed = true;
+            return -1;
+        }
+    };
+
+    static bool StoredBlock(BitReader& in, uint8_t* dst, size_t dstSize, size_t& out) {
+        in.AlignToByte();
+        if (in.end - in.pos < 4) {
+            return false;
+        }
+
+        uint32_t length = in.pos[0] | (in.pos[1] << 8);
+        uint32_t complement = in.pos[2] | (in.pos[3] << 8);
+        in.pos += 4;
+        if ((length ^ 0xFFFFu) != complement ||
+            static_cast<size_t>(in.end - in.pos) < length || dstSize - out < length) {
+            return false;
+        }
+
+        std::memcpy(dst + out, in.pos, length);
+        in.pos += length;
+        out += length;
+        return true;
+    }
+
+    static void BuildFixed(Huffman& lengths, Huffman& distances) {
+        uint8_t table[MAX_LENGTH_CODES];
+        int s = 0;
+        for (; s < 144; ++s) table[s] = 8;
+        for (; s < 256; ++s) table[s] = 9;
+        for (; s < 280; ++s) table[s] = 7;
+        for (; s < MAX_LENGTH_CODES; ++s) table[s] = 8;
+        lengths.Build(table, MAX_LENGTH_CODES);
+
+        for (s = 0; s < MAX_DISTANCE_CODES; ++s) table[s] = 5;
+        distances.Build(table, MAX_DISTANCE_CODES);
+    }
+
+    static bool ReadDynamicTables(BitReader& in, Huffman& lengths, Huffman& distances) {
+        static constexpr uint8_t ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+        int literalCount = static_cast<int>(in.Read(5)) + 257;
+        int distanceCount = static_cast<int>(in.Read(5)) + 1;
+        int codeLengthCount = static_cast<int>(in.Read(4)) + 4;
+        if (literalCount > 286 || distanceCount > MAX_DISTANCE_CODES) {
+            return false;
+        }
+
+        uint8_t codeLengths[19] = {};
+        for (int i = 0; i < codeLengthCount; ++i) {
+            codeLengths[ORDER[i]] = static_cast<uint8_t>(in.Read(3));
+        }
+
+        Huffman codeLengthCode;
+        if (!codeLengthCode.Build(codeLengths, 19)) {
+            return false;
+        }
+
+        // Literal/length and distance lengths form one run-length coded sequence
+        uint8_t all[286 + MAX_DISTANCE_CODES] = {};
+        int total = literalCount + distanceCount;
+        int index = 0;
+        while (index < total) {
+            int symbol = codeLengthCode.Decode(in);
+            if (symbol < 0) {
+                return false;
+            }
+            if (symbol < 16) {
+                all[index++] = static_cast<uint8_t>(symbol);
+                continue;
+            }
+
+            uint8_t value = 0;
+            int repeat = 0;
+            if (symbol == 16) {
+                if (index == 0) {
+                    return false;
+                }
+                value = all[index - 1];
+                repeat = 3 + static_cast<int>(in.Read(2));
+            } else if (symbol == 17) {
+                repeat = 3 + static_cast<int>(in.Read(3));
+            } else {
+                repeat = 11 + static_cast<int>(in.Read(7));
+            }
+
+            if (index + repeat > total) {
+                return false;
+            }
+            while (repeat-- > 0) {
+                all[index++] = value;
+            }
+        }
+
+        // A block without an end-of-block code can never terminate
+        if (all[256] == 0) {
+            return false;
+        }
+
+        return lengths.Build(all, literalCount) && distances.Build(all + literalCount, distanceCount);
+    }
+
+    static bool CompressedBlock(BitReader& in, const Huffman& lengths, const Huffman& distances,
+                                uint8_t* dst, size_t dstSize, size_t& out) {
+        static constexpr uint16_t LENGTH_BASE[29] = {
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static constexpr uint8_t LENGTH_EXTRA[29] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static constexpr uint16_t DISTANCE_BASE[30] = {
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+            257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        static constexpr uint8_t DISTANCE_EXTRA[30] = {
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+            7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+        while (true) {
+            int symbol = lengths.Decode(in);
+            if (symbol < 0 || in.failed) {
+                return false;
+            }
+
+            if (symbol < 256) {
+                if (out >= dstSize) {
+                    return false;
+                }
+                dst[out++] = static_cast<uint8_t>(symbol);
+                continue;
+            }
+            if (symbol == 256) {
+                return true;
+            }
+
+            symbol -= 257;
+            if (symbol >= 29) {
+                return false;
+            }
+            size_t length = LENGTH_BASE[symbol] + in.Read(LENGTH_EXTRA[symbol]);
+
+            int distanceSymbol = distances.Decode(in);
+            if (distanceSymbol < 0 || distanceSymbol >= 30) {
+                return false;
+            }
+            size_t distance = DISTANCE_BASE[distanceSymbol] + in.Read(DISTANCE_EXTRA[distanceSymbol]);
+
+            if (distance > out || length > dstSize - out) {
+                return false;
+            }
+
+            uint8_t* target = dst + out;
+            const uint8_t* source = target - distance;
+            if (distance >= length) {
+                std::memcpy(target, source, length);
+            } else {
+                // Overlapping copy repeats the last `distance` bytes
+                for (size_t i = 0; i < length; ++i) {
+                    target[i] = source[i];
+                }
+            }
+            out += length;
+        }
+    }
+};
+
+} // namespace BrightForge
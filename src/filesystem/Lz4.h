@@ -0,0 +1,330 @@
+/**
+ * Lz4 - LZ4 block compression and safe decompression into caller-owned buffers
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace BrightForge {
+
+// Compression levels: FAST is a single-probe hash (load-time friendly, ~memcpy-class
+// decode either way); HIGH walks hash chains with lazy matching for a smaller output
+// at a much higher build-time cost. Both emit the same block format.
+enum class Lz4Level : uint8_t {
+    FAST = 0,
+    HIGH = 1
+};
+
+// Self-contained encoder/decoder for the LZ4 *block* format (no frame header, no
+// checksums): pak blocks carry their own sizes, so the frame layer would be dead weight.
+// Stateless and re-entrant like Inflate: safe to run many (de)compressions in parallel.
+class Lz4 {
+public:
+    // Worst-case compressed size for `size` input bytes (incompressible data grows
+    // by one length byte per 255 literals plus the token)
+    static constexpr size_t CompressBound(size_t size) {
+        return size + size / 255 + 16;
+    }
+
+    // Compress into `dst`, which must hold CompressBound(srcSize) bytes.
+    // Returns the compressed size, or 0 if `dst` is too small.
+    static size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity,
+                           Lz4Level level = Lz4Level::FAST) {
+        if (dst == nullptr || dstCapacity < CompressBound(srcSize) || (src == nullptr && srcSize > 0)) {
+            return 0;
+        }
+
+        Writer out{ dst, src };
+        if (srcSize >= MIN_INPUT) {
+            if (level == Lz4Level::HIGH) {
+                CompressHigh(src, srcSize, out);
+            } else {
+                CompressFast(src, srcSize, out);
+            }
+        }
+        out.Literals(src + srcSize);
+        return static_cast<size_t>(out.op - dst);
+    }
+
+    // Decompress a block whose decoded size the caller knows exactly. Rejects
+    // truncated input, out-of-range offsets and output that would over- or under-fill `dst`.
+    static bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+        if ((src == nullptr && srcSize > 0) || (dst == nullptr && dstSize > 0)) {
+            return false;
+        }
+
+        const uint8_t* ip = src;
+        const uint8_t* const ipEnd = src + srcSize;
+        size_t out = 0;
+
+        while (ip < ipEnd) {
+            uint8_t token = *ip++;
+
+            size_t literals = token >> 4;
+            if (literals == 15 && !ReadLength(ip, ipEnd, literals)) {
+                return false;
+            }
+            if (literals > static_cast<size_t>(ipEnd - ip) || literals > dstSize - out) {
+                return false;
+            }
+            if (literals > 0) {
+                std::memcpy(dst + out, ip, literals);
+            }
+            ip += literals;
+            out += literals;
+
+            // The last sequence is literals only
+            if (ip == ipEnd) {
+                break;
+            }
+
+            if (ipEnd - ip < 2) {
+                return false;
+            }
+            size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > out) {
+                return false;
+            }
+
+            size_t length = token & 15;
+            if (length == 15 && !ReadLength(ip, ipEnd, length)) {
+                return false;
+            }
+            length += MIN_MATCH;
+            if (length > dstSize - out) {
+                return false;
+            }
+
+            uint8_t* target = dst + out;
+            const uint8_t* source = target - offset;
+            if (offset >= length) {
+                std::memcpy(target, source, length);
+            } else {
+                // Overlapping copy repeats the last `offset` bytes
+                for (size_t i = 0; i < length; ++i) {
+                    target[i] = source[i];
+                }
+            }
+            out += length;
+        }
+
+        return out == dstSize;
+    }
+
+    // Prevent instantiation (static API)
+    Lz4() = delete;
+
+private:
+    static constexpr size_t MIN_MATCH = 4;
+    static constexpr size_t LAST_LITERALS = 5;   // A block always ends with >= 5 literals
+    static constexpr size_t MATCH_FIND_LIMIT = 12; // No match may start in the last 12 bytes
+    static constexpr size_t MIN_INPUT = MATCH_FIND_LIMIT + 1;
+    static constexpr size_t MAX_DISTANCE = 65535;
+
+    static constexpr uint32_t FAST_HASH_LOG = 12;
+    static constexpr uint32_t HIGH_HASH_LOG = 15;
+    static constexpr uint32_t HIGH_MAX_ATTEMPTS = 64;
+    static constexpr int SKIP_TRIGGER = 6;       // Fast mode strides further through incompressible runs
+
+    // Sequence emitter; `anchor` is the first literal not yet written
+    struct Writer {
+        uint8_t* op;
+        const uint8_t* anchor;
+
+        void Length(size_t length) {
+            while (length >= 255) {
+                *op++ = 255;
+                length -= 255;
+            }
+            *op++ = static_cast<uint8_t>(length);
+        }
+
+        void Sequence(const uint8_t* matchStart, size_t offset, size_t matchLength) {
+            size_t literals = static_cast<size_t>(matchStart - anchor);
+            size_t extra = matchLength - MIN_MATCH;
+            uint8_t* token = op++;
+            *token = static_cast<uint8_t>((literals < 15 ? literals : 15) << 4 | (extra < 15 ? extra : 15));
+            if (literals >= 15) {
+                Length(literals - 15);
+            }
+            if (literals > 0) {
+                std::memcpy(op, anchor, literals);
+            }
+            op += literals;
+            *op++ = static_cast<uint8_t>(offset & 0xFF);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+            if (extra >= 15) {
+                Length(extra - 15);
+            }
+            anchor = matchStart + matchLength;
+        }
+
+        void Literals(const uint8_t* end) {
+            size_t literals = static_cast<size_t>(end - anchor);
+            *op++ = static_cast<uint8_t>((literals < 15 ? literals : 15) << 4);
+            if (literals >= 15) {
+                Length(literals - 15);
+            }
+            if (literals > 0) {
+                std::memcpy(op, anchor, literals);
+            }
+            op += literals;
+            anchor = end;
+        }
+    };
+
+    static uint32_t Read32(const uint8_t* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static uint32_t Hash(uint32_t sequence, uint32_t log) {
+        return (sequence * 2654435761u) >> (32 - log);
+    }
+
+    static size_t MatchLength(const uint8_t* a, const uint8_t* b, const uint8_t* limit) {
+        const uint8_t* start = a;
+        while (a < limit && *a == *b) {
+            ++a;
+            ++b;
+        }
+        return static_cast<size_t>(a - start);
+    }
+
+    static bool ReadLength(const uint8_t*& ip, const uint8_t* ipEnd, size_t& length) {
+        uint8_t byte;
+        do {
+            if (ip >= ipEnd) {
+                return false;
+            }
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    static void CompressFast(const uint8_t* src, size_t srcSize, Writer& out) {
+        uint32_t table[1u << FAST_HASH_LOG] = {};
+        const uint8_t* const matchLimit = src + srcSize - LAST_LITERALS;
+        const uint8_t* const findLimit = src + srcSize - MATCH_FIND_LIMIT;
+        const uint8_t* ip = src + 1;
+        uint32_t misses = 1u << SKIP_TRIGGER;
+
+        while (ip < findLimit) {
+            uint32_t sequence = Read32(ip);
+            uint32_t& slot = table[Hash(sequence, FAST_HASH_LOG)];
+            const uint8_t* candidate = src + slot;
+            slot = static_cast<uint32_t>(ip - src);
+
+            if (candidate >= ip || static_cast<size_t>(ip - candidate) > MAX_DISTANCE || Read32(candidate) != sequence) {
+                ip += misses++ >> SKIP_TRIGGER;
+                continue;
+            }
+            misses = 1u << SKIP_TRIGGER;
+
+            // Grow the match backwards over literals that also match
+            while (ip > out.anchor && candidate > src && ip[-1] == candidate[-1]) {
+                --ip;
+                --candidate;
+            }
+            size_t length = MIN_MATCH + MatchLength(ip + MIN_MATCH, candidate + MIN_MATCH, matchLimit);
+            out.Sequence(ip, static_cast<size_t>(ip - candidate), length);
+            ip += length;
+
+            // Seed the position just before the next search so runs chain
+            if (ip < findLimit) {
+                table[Hash(Read32(ip - 2), FAST_HASH_LOG)] = static_cast<uint32_t>(ip - 2 - src);
+            }
+        }
+    }
+
+    // Hash chains over a 64 KiB window, plus a one-step lazy check
+    struct Chains {
+        std::vector<int32_t> head;
+        std::vector<uint16_t> delta;
+        const uint8_t* src;
+        size_t next = 0;    // First position not yet inserted
+
+        explicit Chains(const uint8_t* base)
+            : head(1u << HIGH_HASH_LOG, -1), delta(MAX_DISTANCE + 1, 0), src(base) {}
+
+        void InsertUpTo(const uint8_t* ip) {
+            size_t target = static_cast<size_t>(ip - src);
+            for (; next < target; ++next) {
+                int32_t& first = head[Hash(Read32(src + next), HIGH_HASH_LOG)];
+                size_t distance = first < 0 ? 0 : next - static_cast<size_t>(first);
+                delta[next & MAX_DISTANCE] = static_cast<uint16_t>(distance > MAX_DISTANCE ? 0 : distance);
+                first = static_cast<int32_t>(next);
+            }
+        }
+
+        // Longest match for `ip`; returns its length (0 if none) and sets `match`
+        size_t Find(const uint8_t* ip, const uint8_t* matchLimit, const uint8_t*& match) {
+            InsertUpTo(ip);
+            size_t best = 0;
+            int32_t position = head[Hash(Read32(ip), HIGH_HASH_LOG)];
+            size_t current = static_cast<size_t>(ip - src);
+            for (uint32_t attempt = 0; attempt < HIGH_MAX_ATTEMPTS && position >= 0; ++attempt) {
+                size_t candidate = static_cast<size_t>(position);
+                if (candidate >= current || current - candidate > MAX_DISTANCE) {
+                    break;
+                }
+                const uint8_t* ref = src + candidate;
+                if (ref[best] == ip[best] && Read32(ref) == Read32(ip)) {
+                    size_t length = MIN_MATCH + MatchLength(ip + MIN_MATCH, ref + MIN_MATCH, matchLimit);
+                    if (length > best) {
+                        best = length;
+                        match = ref;
+                    }
+                }
+                uint16_t step = delta[candidate & MAX_DISTANCE];
+                if (step == 0 || step > candidate) {
+                    break;
+                }
+                position = static_cast<int32_t>(candidate - step);
+            }
+            return best;
+        }
+    };
+
+    static void CompressHigh(const uint8_t* src, size_t srcSize, Writer& out) {
+        Chains chains(src);
+        const uint8_t* const matchLimit = src + srcSize - LAST_LITERALS;
+        const uint8_t* const findLimit = src + srcSize - MATCH_FIND_LIMIT;
+        const uint8_t* ip = src;
+
+        while (ip < findLimit) {
+            const uint8_t* match = nullptr;
+            size_t length = chains.Find(ip, matchLimit, match);
+            if (length < MIN_MATCH) {
+                ++ip;
+                continue;
+            }
+
+            // Lazy: defer by a byte when the next position matches further
+            while (ip + 1 < findLimit) {
+                const uint8_t* nextMatch = nullptr;
+                size_t nextLength = chains.Find(ip + 1, matchLimit, nextMatch);
+                if (nextLength <= length) {
+                    break;
+                }
+                ++ip;
+                length = nextLength;
+                match = nextMatch;
+            }
+
+            out.Sequence(ip, static_cast<size_t>(ip - match), length);
+            ip += length;
+        }
+    }
+};
+
+} // namespace BrightForge
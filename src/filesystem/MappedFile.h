@@ -0,0 +1,200 @@
+/**
+ * MappedFile - Read-only memory-mapped file view
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace BrightForge {
+
+// RAII wrapper around an OS file mapping
+// Loaders parse directly out of the mapping so file bytes are never copied into the heap.
+// Deliberately silent: callers decide how to log failures (see GetError()).
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    ~MappedFile() {
+        Close();
+    }
+
+    // Map the whole file read-only. Returns false and sets GetError() on failure.
+    bool Open(const std::string& path) {
+        Close();
+
+        if (path.empty()) {
+            m_error = "empty path";
+            return false;
+        }
+
+#if defined(_WIN32)
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            m_error = "cannot open " + path;
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size)) {
+            m_error = "cannot stat " + path;
+            Close();
+            return false;
+        }
+        m_size = static_cast<size_t>(size.QuadPart);
+
+        // Zero-length files cannot be mapped but are still valid
+        if (m_size == 0) {
+            m_path = path;
+            return true;
+        }
+
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping == nullptr) {
+            m_error = "cannot map " + path;
+            Close();
+            return false;
+        }
+
+        m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_data == nullptr) {
+            m_error = "cannot map view of " + path;
+            Close();
+            return false;
+        }
+#else
+        m_fd = ::open(path.c_str(), O_RDONLY);
+        if (m_fd < 0) {
+            m_error = "cannot open " + path;
+            return false;
+        }
+
+        struct stat info;
+        if (::fstat(m_fd, &info) != 0) {
+            m_error = "cannot stat " + path;
+            Close();
+            return false;
+        }
+        m_size = static_cast<size_t>(info.st_size);
+
+        // Zero-length files cannot be mapped but are still valid
+        if (m_size == 0) {
+            m_path = path;
+            return true;
+        }
+
+        void* address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (address == MAP_FAILED) {
+            m_error = "cannot map " + path;
+            Close();
+            return false;
+        }
+        m_data = static_cast<const uint8_t*>(address);
+
+        // Loaders mostly stream front to back
+        ::madvise(address, m_size, MADV_SEQUENTIAL);
+#endif
+
+        m_path = path;
+        return true;
+    }
+
+    void Close() {
+#if defined(_WIN32)
+        if (m_data != nullptr) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping != nullptr) {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+        }
+        m_mapping = nullptr;
+        m_file = INVALID_HANDLE_VALUE;
+#else
+        if (m_data != nullptr) {
+            ::munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+        m_fd = -1;
+#endif
+        m_data = nullptr;
+        m_size = 0;
+        m_path.clear();
+    }
+
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+    bool IsOpen() const { return m_data != nullptr || !m_path.empty(); }
+    const std::string& GetPath() const { return m_path; }
+    const std::string& GetError() const { return m_error; }
+
+    // Prevent copy (the mapping is uniquely owned)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_path = std::move(other.m_path);
+            m_error = std::move(other.m_error);
+#if defined(_WIN32)
+            m_file = other.m_file;
+            m_mapping = other.m_mapping;
+            other.m_file = INVALID_HANDLE_VALUE;
+            other.m_mapping = nullptr;
+#else
+            m_fd = other.m_fd;
+            other.m_fd = -1;
+#endif
+            other.m_data = nullptr;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    std::string m_path;
+    std::string m_error;
+
+#if defined(_WIN32)
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
+
+} // namespace BrightForge
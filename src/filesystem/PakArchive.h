@@ -0,0 +1,871 @@
+/**
+ * PakArchive - .bfpak packed asset archives: writer and memory-mapped reader
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include "MappedFile.h"
+#include "Lz4.h"
+#include "../core/JobSystem.h"
+#include "../core/Checksum.h"
+#include "../core/TestManagerNew.h"
+
+namespace BrightForge {
+
+constexpr uint32_t PAK_FORMAT_VERSION = 2;
+constexpr const char* PAK_EXTENSION = ".bfpak";
+
+// Entries are cut into blocks of this size, each compressed on its own so a reader
+// can decode them in parallel (and a prefix read touches one block only)
+constexpr uint32_t PAK_DEFAULT_BLOCK_SIZE = 64u * 1024u;
+
+// Entry data starts on this boundary inside the file. Mappings are page-aligned, so a
+// stored entry viewed in place is aligned for any vertex/index type; use 4096 to
+// make stored entries page-aligned as well.
+constexpr uint32_t PAK_DEFAULT_ALIGNMENT = 64;
+
+// Source bytes the writer holds in memory at once while compressing
+constexpr uint64_t PAK_WRITE_BATCH_BYTES = 64ull * 1024ull * 1024ull;
+
+// Per-block codec. Readers reject ids they do not know.
+enum class PakCodec : uint16_t {
+    NONE = 0,   // Stored: the block is the raw bytes
+    LZ4 = 1     // LZ4 block (either Lz4Level; the decoder is the same)
+};
+
+// On-disk layout (little-endian, all offsets absolute):
+//   PakHeader | entry data (aligned) | PakBlock[blockCount] | PakEntry[entryCount] | path strings
+// The TOC is sorted by pathHash, then path, so lookups are a binary search. Entries with
+// identical content share one run of blocks.
+struct PakHeader {
+    char magic[8];              // "BFPAK\0\0\0"
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t blockSize;
+    uint32_t alignment;
+    uint32_t blockCount;
+    uint32_t reserved;
+    uint64_t tocOffset;
+    uint64_t blockTableOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+};
+
+struct PakEntry {
+    uint64_t pathHash;          // PakArchive::HashPath of the normalized path
+    uint64_t size;              // Uncompressed bytes
+    uint64_t contentHash;       // Xxh3 of the uncompressed bytes (dedup and identity)
+    uint32_t pathOffset;        // Into the strings region (not NUL-terminated)
+    uint32_t pathLength;
+    uint32_t firstBlock;        // Blocks of one entry are consecutive in the table and the file
+    uint32_t blockCount;        // ceil(size / blockSize)
+};
+
+struct PakBlock {
+    uint64_t offset;
+    uint32_t storedSize;
+    uint32_t checksum;          // Crc32c of the uncompressed bytes, checked by verified reads
+    uint16_t codec;             // PakCodec
+    uint16_t reserved[3];
+};
+
+static_assert(sizeof(PakHeader) == 64, "PakHeader layout is part of the file format");
+static_assert(sizeof(PakEntry) == 40, "PakEntry layout is part of the file format");
+static_assert(sizeof(PakBlock) == 24, "PakBlock layout is part of the file format");
+
+struct PakWriteOptions {
+    bool compress = true;               // false stores every block (zero-copy views for all entries)
+    Lz4Level level = Lz4Level::FAST;    // HIGH trades build time for size
+    uint32_t blockSize = PAK_DEFAULT_BLOCK_SIZE;
+    uint32_t alignment = PAK_DEFAULT_ALIGNMENT;
+};
+
+struct PakWriteStats {
+    size_t entries = 0;
+    size_t blocks = 0;
+    size_t compressedBlocks = 0;        // Blocks that came out smaller than their raw bytes
+    size_t dedupedEntries = 0;          // Entries stored once and shared with an earlier path
+    uint64_t rawBytes = 0;
+    uint64_t archiveBytes = 0;
+};
+
+// Read side of a .bfpak: maps the archive once, validates every table at Open(), then
+// answers lookups and reads without locks. Deliberately silent like MappedFile.
+class PakArchive {
+public:
+    PakArchive() = default;
+
+    bool Open(const std::string& path) {
+        Close();
+        if (!m_file.Open(path)) {
+            m_error = m_file.GetError();
+            return false;
+        }
+        if (!Validate()) {
+            m_file.Close();
+            m_entries = nullptr;
+            m_blocks = nullptr;
+            m_strings = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    void Close() {
+        m_file.Close();
+        std::memset(&m_header, 0, sizeof(m_header));
+        m_entries = nullptr;
+        m_blocks = nullptr;
+        m_strings = nullptr;
+        m_error.clear();
+    }
+
+    bool IsOpen() const { return m_file.IsOpen(); }
+    const std::string& GetPath() const { return m_file.GetPath(); }
+    const std::string& GetError() const { return m_error; }
+    size_t EntryCount() const { return m_header.entryCount; }
+    uint32_t GetBlockSize() const { return m_header.blockSize; }
+    const PakEntry& EntryAt(size_t index) const { return m_entries[index]; }
+
+    std::string_view EntryPath(const PakEntry& entry) const {
+        return std::string_view(m_strings + entry.pathOffset, entry.pathLength);
+    }
+
+    // Entry for `path` (normalized first), or nullptr
+    const PakEntry* Find(std::string_view path) const {
+        if (m_header.entryCount == 0) {
+            return nullptr;
+        }
+        std::string normalized = NormalizePath(path);
+        uint64_t hash = HashPath(normalized);
+        const PakEntry* end = m_entries + m_header.entryCount;
+        const PakEntry* it = std::lower_bound(m_entries, end, hash,
+            [](const PakEntry& entry, uint64_t value) { return entry.pathHash < value; });
+        for (; it != end && it->pathHash == hash; ++it) {
+            if (EntryPath(*it) == normalized) {
+                return it;
+            }
+        }
+        return nullptr;
+    }
+
+    // Decode `entry` into `dst`, which must be exactly entry.size bytes. Multi-block
+    // entries decode their blocks in parallel on `jobs`. With `verify`, each block's
+    // CRC32C is checked right after it is decoded, while it is still in cache.
+    bool Read(const PakEntry& entry, uint8_t* dst, size_t dstSize, bool verify = false,
+              JobSystem& jobs = JobSystem::Instance()) const {
+        if (dstSize != entry.size || (dst == nullptr && dstSize > 0)) {
+            return false;
+        }
+        if (entry.blockCount <= 1) {
+            return entry.blockCount == 0 || DecodeBlock(entry, 0, dst, verify);
+        }
+
+        std::atomic<bool> ok{ true };
+        jobs.ParallelFor(entry.blockCount, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end && ok.load(std::memory_order_relaxed); ++i) {
+                if (!DecodeBlock(entry, static_cast<uint32_t>(i), dst + i * m_header.blockSize, verify)) {
+                    ok.store(false, std::memory_order_relaxed);
+                }
+            }
+        });
+        return ok.load();
+    }
+
+    bool Read(const PakEntry& entry, std::vector<uint8_t>& out, bool verify = false,
+              JobSystem& jobs = JobSystem::Instance()) const {
+        out.resize(static_cast<size_t>(entry.size));
+        return Read(entry, out.data(), out.size(), verify, jobs);
+    }
+
+    // First min(maxBytes, entry.size) bytes; decodes the first block only.
+    // Returns the number of bytes written, or 0 on a decode failure.
+    size_t ReadPrefix(const PakEntry& entry, uint8_t* dst, size_t maxBytes) const {
+        size_t count = static_cast<size_t>(std::min<uint64_t>(maxBytes, entry.size));
+        if (count == 0) {
+            return 0;
+        }
+        const PakBlock& block = m_blocks[entry.firstBlock];
+        if (block.codec == static_cast<uint16_t>(PakCodec::NONE)) {
+            std::memcpy(dst, m_file.Data() + block.offset, count);
+            return count;
+        }
+        std::vector<uint8_t> scratch(RawBlockSize(entry, 0));
+        if (!DecodeBlock(entry, 0, scratch.data(), false)) {
+            return 0;
+        }
+        std::memcpy(dst, scratch.data(), count);
+        return count;
+    }
+
+    // Check every block's CRC32C without an output buffer: stored blocks are hashed in
+    // place, compressed ones through a block-sized scratch per worker
+    bool Verify(const PakEntry& entry, JobSystem& jobs = JobSystem::Instance()) const {
+        std::atomic<bool> ok{ true };
+        jobs.ParallelFor(entry.blockCount, 4, [&](size_t begin, size_t end) {
+            std::vector<uint8_t> scratch;
+            for (size_t i = begin; i < end && ok.load(std::memory_order_relaxed); ++i) {
+                const PakBlock& block = m_blocks[entry.firstBlock + i];
+                size_t rawSize = RawBlockSize(entry, static_cast<uint32_t>(i));
+                bool intact;
+                if (block.codec == static_cast<uint16_t>(PakCodec::NONE)) {
+                    intact = Crc32c::Compute(m_file.Data() + block.offset, rawSize) == block.checksum;
+                } else {
+                    scratch.resize(rawSize);
+                    intact = DecodeBlock(entry, static_cast<uint32_t>(i), scratch.data(), true);
+                }
+                if (!intact) {
+                    ok.store(false, std::memory_order_relaxed);
+                }
+            }
+        });
+        return ok.load();
+    }
+
+    // In-place bytes of an entry whose blocks are all stored; nullptr otherwise
+    // (and for empty entries). Valid until Close().
+    const uint8_t* View(const PakEntry& entry) const {
+        if (entry.blockCount == 0) {
+            return nullptr;
+        }
+        for (uint32_t i = 0; i < entry.blockCount; ++i) {
+            if (m_blocks[entry.firstBlock + i].codec != static_cast<uint16_t>(PakCodec::NONE)) {
+                return nullptr;
+            }
+        }
+        return m_file.Data() + m_blocks[entry.firstBlock].offset;
+    }
+
+    // Archive paths use '/' separators with no leading "./" or '/'
+    static std::string NormalizePath(std::string_view path) {
+        std::string normalized(path);
+        std::replace(normalized.begin(), normalized.end(), '\\', '/');
+        size_t start = 0;
+        while (start < normalized.size()) {
+            if (normalized[start] == '/') {
+                ++start;
+            } else if (normalized.compare(start, 2, "./") == 0) {
+                start += 2;
+            } else {
+                break;
+            }
+        }
+        return normalized.substr(start);
+    }
+
+    // Xxh3 of a normalized path
+    static uint64_t HashPath(std::string_view normalized) {
+        return Xxh3::Hash64(normalized.data(), normalized.size());
+    }
+
+    // Writer/reader round trips and corruption handling
+    static void RegisterTests();
+
+    // Prevent copy (owns the mapping that the table pointers point into)
+    PakArchive(const PakArchive&) = delete;
+    PakArchive& operator=(const PakArchive&) = delete;
+
+private:
+    MappedFile m_file;
+    PakHeader m_header = {};
+    const PakEntry* m_entries = nullptr;
+    const PakBlock* m_blocks = nullptr;
+    const char* m_strings = nullptr;
+    std::string m_error;
+
+    size_t RawBlockSize(const PakEntry& entry, uint32_t index) const {
+        uint64_t start = static_cast<uint64_t>(index) * m_header.blockSize;
+        return static_cast<size_t>(std::min<uint64_t>(m_header.blockSize, entry.size - start));
+    }
+
+    bool DecodeBlock(const PakEntry& entry, uint32_t index, uint8_t* dst, bool verify) const {
+        const PakBlock& block = m_blocks[entry.firstBlock + index];
+        const uint8_t* src = m_file.Data() + block.offset;
+        size_t rawSize = RawBlockSize(entry, index);
+        if (block.codec == static_cast<uint16_t>(PakCodec::NONE)) {
+            std::memcpy(dst, src, rawSize);
+        } else if (!Lz4::Decompress(src, block.storedSize, dst, rawSize)) {
+            return false;
+        }
+        return !verify || Crc32c::Compute(dst, rawSize) == block.checksum;
+    }
+
+    // Table span [offset, offset + count * stride) lies inside the file and is 8-byte aligned
+    bool SpanInFile(uint64_t offset, uint64_t count, uint64_t stride) const {
+        uint64_t fileSize = m_file.Size();
+        return offset % 8 == 0 && offset <= fileSize && count <= (fileSize - offset) / stride;
+    }
+
+    // Every bound a reader relies on is checked once here, so lookups and reads
+    // never touch memory outside the mapping even for a corrupt archive
+    bool Validate() {
+        const uint8_t* data = m_file.Data();
+        if (data == nullptr || m_file.Size() < sizeof(PakHeader)) {
+            m_error = "Not a pak archive (too small)";
+            return false;
+        }
+        std::memcpy(&m_header, data, sizeof(PakHeader));
+        if (std::memcmp(m_header.magic, "BFPAK\0\0\0", 8) != 0) {
+            m_error = "Not a pak archive (bad magic)";
+            return false;
+        }
+        if (m_header.version != PAK_FORMAT_VERSION) {
+            m_error = "Unsupported pak version " + std::to_string(m_header.version);
+            return false;
+        }
+        if (m_header.blockSize == 0 ||
+            !SpanInFile(m_header.tocOffset, m_header.entryCount, sizeof(PakEntry)) ||
+            !SpanInFile(m_header.blockTableOffset, m_header.blockCount, sizeof(PakBlock)) ||
+            m_header.stringsOffset > m_file.Size() || m_header.stringsSize > m_file.Size() - m_header.stringsOffset) {
+            m_error = "Corrupt pak header";
+            return false;
+        }
+
+        m_entries = reinterpret_cast<const PakEntry*>(data + m_header.tocOffset);
+        m_blocks = reinterpret_cast<const PakBlock*>(data + m_header.blockTableOffset);
+        m_strings = reinterpret_cast<const char*>(data + m_header.stringsOffset);
+
+        for (uint32_t e = 0; e < m_header.entryCount; ++e) {
+            const PakEntry& entry = m_entries[e];
+            uint64_t expectedBlocks = (entry.size + m_header.blockSize - 1) / m_header.blockSize;
+            bool ok = static_cast<uint64_t>(entry.pathOffset) + entry.pathLength <= m_header.stringsSize &&
+                      entry.blockCount == expectedBlocks &&
+                      static_cast<uint64_t>(entry.firstBlock) + entry.blockCount <= m_header.blockCount &&
+                      (e == 0 || m_entries[e - 1].pathHash <= entry.pathHash) &&
+                      HashPath(EntryPath(entry)) == entry.pathHash;
+            for (uint32_t b = 0; ok && b < entry.blockCount; ++b) {
+                const PakBlock& block = m_blocks[entry.firstBlock + b];
+                size_t rawSize = RawBlockSize(entry, b);
+                ok = block.offset <= m_file.Size() && block.storedSize <= m_file.Size() - block.offset &&
+                     ((block.codec == static_cast<uint16_t>(PakCodec::NONE) && block.storedSize == rawSize) ||
+                      block.codec == static_cast<uint16_t>(PakCodec::LZ4));
+            }
+            if (!ok) {
+                m_error = "Corrupt pak entry " + std::to_string(e);
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Builds a .bfpak from loose files and in-memory data. Sources are read in bounded
+// batches (PAK_WRITE_BATCH_BYTES), hashed block by block as they are read, deduplicated
+// against everything written so far, and the remaining blocks of a batch are compressed
+// in parallel; the archive is written to a temp file and renamed into place.
+class PakWriter {
+public:
+    explicit PakWriter(PakWriteOptions options = {}) : m_options(options) {}
+
+    // Queue a file on disk under `archivePath`; read at Write() time
+    void AddFile(const std::string& diskPath, const std::string& archivePath) {
+        Source source;
+        source.archivePath = PakArchive::NormalizePath(archivePath);
+        source.diskPath = diskPath;
+        m_sources.push_back(std::move(source));
+    }
+
+    void AddData(const std::string& archivePath, std::vector<uint8_t> data) {
+        Source source;
+        source.archivePath = PakArchive::NormalizePath(archivePath);
+        source.data = std::move(data);
+        source.inMemory = true;
+        m_sources.push_back(std::move(source));
+    }
+
+    // Queue every regular file under `root`, stored as prefix + its path relative to root.
+    // Returns the number of files queued.
+    size_t AddDirectory(const std::string& root, const std::string& prefix = "") {
+        std::error_code ec;
+        size_t added = 0;
+        std::filesystem::recursive_directory_iterator it(root, ec);
+        for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            if (!it->is_regular_file(ec)) {
+                continue;
+            }
+            std::string relative = std::filesystem::relative(it->path(), root, ec).generic_string();
+            if (ec) {
+                continue;
+            }
+            AddFile(it->path().string(), prefix.empty() ? relative : prefix + "/" + relative);
+            ++added;
+        }
+        return added;
+    }
+
+    size_t GetSourceCount() const { return m_sources.size(); }
+    const PakWriteStats& GetStats() const { return m_stats; }
+
+    bool Write(const std::string& outPath, std::string* error = nullptr, JobSystem& jobs = JobSystem::Instance()) {
+        m_stats = PakWriteStats();
+        std::string failure;
+        if (!WriteArchive(outPath, failure, jobs)) {
+            if (error != nullptr) {
+                *error = failure;
+            }
+            return false;
+        }
+        return true;
+    }
+
+private:
+    struct Source {
+        std::string archivePath;
+        std::string diskPath;
+        std::vector<uint8_t> data;
+        bool inMemory = false;
+        uint64_t hash = 0;
+        uint64_t size = 0;
+        uint64_t contentHash = 0;
+        std::vector<uint32_t> blockChecksums;
+    };
+
+    // One block of a batch: which source, which slice, and its encoded bytes
+    struct PendingBlock {
+        size_t source;
+        uint32_t index;
+        std::vector<uint8_t> stored;
+        PakCodec codec = PakCodec::NONE;
+    };
+
+    PakWriteOptions m_options;
+    std::vector<Source> m_sources;
+    PakWriteStats m_stats;
+
+    // Load (disk sources) and hash one block-sized slice at a time, so each slice is
+    // hashed while it is still in cache
+    bool ReadSource(Source& source) const {
+        std::ifstream file;
+        if (!source.inMemory) {
+            file.open(source.diskPath, std::ios::binary);
+            if (!file.is_open()) {
+                return false;
+            }
+            source.data.resize(static_cast<size_t>(source.size));
+        }
+
+        Xxh3 content;
+        source.blockChecksums.clear();
+        for (uint64_t start = 0; start < source.size; start += m_options.blockSize) {
+            size_t length = static_cast<size_t>(std::min<uint64_t>(m_options.blockSize, source.size - start));
+            uint8_t* slice = source.data.data() + start;
+            if (!source.inMemory) {
+                file.read(reinterpret_cast<char*>(slice), static_cast<std::streamsize>(length));
+                if (file.gcount() != static_cast<std::streamsize>(length)) {
+                    return false;
+                }
+            }
+            content.Update(slice, length);
+            source.blockChecksums.push_back(Crc32c::Compute(slice, length));
+        }
+        source.contentHash = content.Finish();
+        return true;
+    }
+
+    static void Pad(std::ofstream& out, uint64_t& offset, uint64_t alignment) {
+        static const char zeros[4096] = {};
+        uint64_t padding = (alignment - offset % alignment) % alignment;
+        while (padding > 0) {
+            uint64_t n = std::min<uint64_t>(padding, sizeof(zeros));
+            out.write(zeros, static_cast<std::streamsize>(n));
+            padding -= n;
+            offset += n;
+        }
+    }
+
+    void EncodeBlock(const Source& source, PendingBlock& block) const {
+        uint64_t start = static_cast<uint64_t>(block.index) * m_options.blockSize;
+        size_t rawSize = static_cast<size_t>(std::min<uint64_t>(m_options.blockSize, source.size - start));
+        const uint8_t* raw = source.data.data() + start;
+        if (m_options.compress) {
+            block.stored.resize(Lz4::CompressBound(rawSize));
+            size_t size = Lz4::Compress(raw, rawSize, block.stored.data(), block.stored.size(), m_options.level);
+            if (size > 0 && size < rawSize) {
+                block.stored.resize(size);
+                block.codec = PakCodec::LZ4;
+                return;
+            }
+        }
+        block.stored.assign(raw, raw + rawSize);
+        block.codec = PakCodec::NONE;
+    }
+
+    bool Fail(std::ofstream& out, const std::string& tempPath, const std::string& message, std::string& failure) {
+        failure = message;
+        out.close();
+        std::error_code ec;
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    bool WriteArchive(const std::string& outPath, std::string& failure, JobSystem& jobs) {
+        const uint64_t blockSize = m_options.blockSize;
+        const uint64_t alignment = m_options.alignment;
+        if (blockSize == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0) {
+            failure = "Block size must be non-zero and alignment a power of two";
+            return false;
+        }
+
+        // Sizes up front: the TOC layout is fixed before any data is read
+        for (Source& source : m_sources) {
+            if (source.archivePath.empty()) {
+                failure = "Empty archive path" + (source.diskPath.empty() ? "" : " for " + source.diskPath);
+                return false;
+            }
+            source.hash = PakArchive::HashPath(source.archivePath);
+            if (source.inMemory) {
+                source.size = source.data.size();
+            } else {
+                std::error_code ec;
+                source.size = std::filesystem::file_size(source.diskPath, ec);
+                if (ec) {
+                    failure = "Cannot read " + source.diskPath + ": " + ec.message();
+                    return false;
+                }
+            }
+        }
+
+        std::sort(m_sources.begin(), m_sources.end(), [](const Source& a, const Source& b) {
+            return a.hash != b.hash ? a.hash < b.hash : a.archivePath < b.archivePath;
+        });
+        for (size_t i = 1; i < m_sources.size(); ++i) {
+            if (m_sources[i].archivePath == m_sources[i - 1].archivePath) {
+                failure = "Duplicate archive path " + m_sources[i].archivePath;
+                return false;
+            }
+        }
+
+        std::vector<PakEntry> entries(m_sources.size());
+        std::string strings;
+        for (size_t i = 0; i < m_sources.size(); ++i) {
+            PakEntry& entry = entries[i];
+            entry.pathHash = m_sources[i].hash;
+            entry.size = m_sources[i].size;
+            entry.contentHash = 0;
+            entry.pathOffset = static_cast<uint32_t>(strings.size());
+            entry.pathLength = static_cast<uint32_t>(m_sources[i].archivePath.size());
+            entry.firstBlock = 0;
+            entry.blockCount = static_cast<uint32_t>((entry.size + blockSize - 1) / blockSize);
+            strings += m_sources[i].archivePath;
+        }
+        if (m_sources.size() > UINT32_MAX || strings.size() > UINT32_MAX) {
+            failure = "Too many entries for one archive";
+            return false;
+        }
+
+        std::string tempPath = outPath + ".tmp";
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            failure = "Cannot create " + tempPath;
+            return false;
+        }
+
+        PakHeader header;
+        std::memset(&header, 0, sizeof(header));
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        uint64_t offset = sizeof(header);
+
+        // Content already written: (size, xxh3) -> entry. A match must also agree on every
+        // block CRC32C before the entry is shared.
+        std::unordered_map<uint64_t, std::vector<size_t>> written;
+        std::vector<PakBlock> blocks;
+        for (size_t batchStart = 0; batchStart < m_sources.size();) {
+            // Gather sources up to the batch budget (always at least one)
+            size_t batchEnd = batchStart;
+            uint64_t batchBytes = 0;
+            while (batchEnd < m_sources.size() &&
+                   (batchEnd == batchStart || batchBytes + m_sources[batchEnd].size <= PAK_WRITE_BATCH_BYTES)) {
+                batchBytes += m_sources[batchEnd].size;
+                ++batchEnd;
+            }
+
+            std::atomic<bool> readOk{ true };
+            jobs.ParallelFor(batchEnd - batchStart, 1, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (!ReadSource(m_sources[batchStart + i])) {
+                        readOk.store(false);
+                    }
+                }
+            });
+            if (!readOk.load()) {
+                return Fail(out, tempPath, "Failed to read a source file", failure);
+            }
+
+            // Serial, in TOC order, so the first path with some content owns its blocks
+            std::vector<size_t> owner(batchEnd - batchStart, SIZE_MAX);
+            std::vector<PendingBlock> pending;
+            for (size_t s = batchStart; s < batchEnd; ++s) {
+                const Source& source = m_sources[s];
+                entries[s].contentHash = source.contentHash;
+                if (source.size > 0) {
+                    std::vector<size_t>& candidates = written[source.contentHash ^ (source.size * 0x9E3779B97F4A7C15ull)];
+                    for (size_t candidate : candidates) {
+                        if (entries[candidate].size == source.size &&
+                            m_sources[candidate].blockChecksums == source.blockChecksums) {
+                            owner[s - batchStart] = candidate;
+                            break;
+                        }
+                    }
+                    if (owner[s - batchStart] == SIZE_MAX) {
+                        candidates.push_back(s);
+                    }
+                }
+                if (owner[s - batchStart] == SIZE_MAX) {
+                    for (uint32_t b = 0; b < entries[s].blockCount; ++b) {
+                        pending.push_back({ s, b, {} });
+                    }
+                }
+            }
+            jobs.ParallelFor(pending.size(), 1, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    EncodeBlock(m_sources[pending[i].source], pending[i]);
+                }
+            });
+
+            // Serial write keeps the file order equal to TOC order
+            size_t cursor = 0;
+            for (size_t s = batchStart; s < batchEnd; ++s) {
+                PakEntry& entry = entries[s];
+                m_stats.rawBytes += entry.size;
+                if (owner[s - batchStart] != SIZE_MAX) {
+                    entry.firstBlock = entries[owner[s - batchStart]].firstBlock;
+                    ++m_stats.dedupedEntries;
+                } else {
+                    entry.firstBlock = static_cast<uint32_t>(std::min<size_t>(blocks.size(), UINT32_MAX));
+                    if (entry.blockCount > 0) {
+                        Pad(out, offset, alignment);
+                    }
+                    for (uint32_t b = 0; b < entry.blockCount; ++b, ++cursor) {
+                        PendingBlock& block = pending[cursor];
+                        PakBlock record;
+                        std::memset(&record, 0, sizeof(record));
+                        record.offset = offset;
+                        record.storedSize = static_cast<uint32_t>(block.stored.size());
+                        record.checksum = m_sources[s].blockChecksums[b];
+                        record.codec = static_cast<uint16_t>(block.codec);
+                        blocks.push_back(record);
+                        out.write(reinterpret_cast<const char*>(block.stored.data()),
+                                  static_cast<std::streamsize>(block.stored.size()));
+                        offset += block.stored.size();
+
+                        m_stats.compressedBlocks += block.codec == PakCodec::LZ4 ? 1 : 0;
+                        std::vector<uint8_t>().swap(block.stored);
+                    }
+                }
+                // Checksums stay for later dedup matches; the bytes are on disk now
+                std::vector<uint8_t>().swap(m_sources[s].data);
+            }
+            batchStart = batchEnd;
+        }
+        if (blocks.size() > UINT32_MAX) {
+            return Fail(out, tempPath, "Too many blocks for one archive", failure);
+        }
+
+        Pad(out, offset, 8);
+        header.blockTableOffset = offset;
+        out.write(reinterpret_cast<const char*>(blocks.data()), static_cast<std::streamsize>(blocks.size() * sizeof(PakBlock)));
+        offset += blocks.size() * sizeof(PakBlock);
+
+        header.tocOffset = offset;
+        out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(PakEntry)));
+        offset += entries.size() * sizeof(PakEntry);
+
+        header.stringsOffset = offset;
+        header.stringsSize = strings.size();
+        out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        offset += strings.size();
+
+        std::memcpy(header.magic, "BFPAK\0\0\0", 8);
+        header.version = PAK_FORMAT_VERSION;
+        header.entryCount = static_cast<uint32_t>(entries.size());
+        header.blockSize = m_options.blockSize;
+        header.alignment = m_options.alignment;
+        header.blockCount = static_cast<uint32_t>(blocks.size());
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+
+        std::error_code ec;
+        if (out.fail()) {
+            failure = "Failed writing " + tempPath;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        std::filesystem::rename(tempPath, outPath, ec);
+        if (ec) {
+            failure = "Cannot replace " + outPath + ": " + ec.message();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        m_stats.entries = entries.size();
+        m_stats.blocks = blocks.size();
+        m_stats.archiveBytes = offset;
+        return true;
+    }
+};
+
+namespace PakTesting {
+
+// Deterministic mix of compressible text, repeated runs and noise
+inline std::vector<uint8_t> MakeContent(size_t size, uint32_t seed) {
+    std::vector<uint8_t> data(size);
+    uint32_t state = seed * 2654435761u + 1;
+    for (size_t i = 0; i < size; ++i) {
+        state = state * 1664525u + 1013904223u;
+        size_t region = (i / 4096) % 3;
+        data[i] = region == 0 ? static_cast<uint8_t>("vertex normal uv "[i % 17])
+                : region == 1 ? static_cast<uint8_t>(i / 512)
+                              : static_cast<uint8_t>(state >> 24);
+    }
+    return data;
+}
+
+inline std::string ScratchPath(const char* name) {
+    std::error_code ec;
+    return (std::filesystem::temp_directory_path(ec) / name).string();
+}
+
+} // namespace PakTesting
+
+inline void PakArchive::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("PakArchive");
+
+    // Every codec setting must read back byte-exact, including empty, tiny and
+    // multi-block entries; lookups must survive path spelling differences and
+    // identical content must be stored once
+    tests.AddTest("PakArchive", "Round trip across codecs and block boundaries", []() {
+        const size_t sizes[] = { 0, 1, 13, 4096, PAK_DEFAULT_BLOCK_SIZE, PAK_DEFAULT_BLOCK_SIZE * 3 + 777 };
+        const PakWriteOptions settings[] = {
+            { false, Lz4Level::FAST, PAK_DEFAULT_BLOCK_SIZE, 4096 },
+            { true, Lz4Level::FAST, PAK_DEFAULT_BLOCK_SIZE, PAK_DEFAULT_ALIGNMENT },
+            { true, Lz4Level::HIGH, 16 * 1024, PAK_DEFAULT_ALIGNMENT },
+        };
+        std::string path = PakTesting::ScratchPath("brightforge_pak_roundtrip.bfpak");
+
+        bool ok = true;
+        for (const PakWriteOptions& options : settings) {
+            PakWriter writer(options);
+            std::vector<std::vector<uint8_t>> contents;
+            for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+                contents.push_back(PakTesting::MakeContent(sizes[i], static_cast<uint32_t>(i)));
+                writer.AddData("meshes/asset" + std::to_string(i) + ".bin", contents.back());
+            }
+            writer.AddData("copies/last.bin", contents.back());
+
+            PakArchive archive;
+            ok = ok && writer.Write(path) && archive.Open(path) && archive.EntryCount() == contents.size() + 1 &&
+                 writer.GetStats().dedupedEntries == 1;
+            for (size_t i = 0; ok && i < contents.size(); ++i) {
+                const PakEntry* entry = archive.Find(".\\meshes\\asset" + std::to_string(i) + ".bin");
+                std::vector<uint8_t> read;
+                uint8_t prefix[8] = {};
+                ok = entry != nullptr && archive.Read(*entry, read, true) && read == contents[i] &&
+                     archive.Verify(*entry) && entry->contentHash == Xxh3::Hash64(read.data(), read.size()) &&
+                     archive.ReadPrefix(*entry, prefix, sizeof(prefix)) == std::min<size_t>(8, sizes[i]) &&
+                     (sizes[i] == 0 || std::memcmp(prefix, contents[i].data(), std::min<size_t>(8, sizes[i])) == 0);
+
+                // Stored entries are viewable in place at the requested alignment
+                if (ok && !options.compress && sizes[i] > 0) {
+                    const uint8_t* view = archive.View(*entry);
+                    ok = view != nullptr && std::memcmp(view, contents[i].data(), sizes[i]) == 0 &&
+                         (view - archive.m_file.Data()) % options.alignment == 0;
+                }
+            }
+            const PakEntry* copy = archive.Find("copies/last.bin");
+            const PakEntry* original = archive.Find("meshes/asset" + std::to_string(contents.size() - 1) + ".bin");
+            std::vector<uint8_t> copied;
+            ok = ok && copy != nullptr && original != nullptr && copy->firstBlock == original->firstBlock &&
+                 archive.Read(*copy, copied, true) && copied == contents.back();
+            ok = ok && archive.Find("meshes/missing.bin") == nullptr;
+            if (options.compress) {
+                ok = ok && writer.GetStats().compressedBlocks > 0 && writer.GetStats().archiveBytes < writer.GetStats().rawBytes;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return ok;
+    });
+
+    // Truncation must fail at open; a flipped byte in compressed or stored data must
+    // fail a verified read, never crash
+    tests.AddTest("PakArchive", "Corrupt archives are rejected", []() {
+        std::string path = PakTesting::ScratchPath("brightforge_pak_corrupt.bfpak");
+        PakWriter writer;
+        writer.AddData("a.bin", PakTesting::MakeContent(PAK_DEFAULT_BLOCK_SIZE * 2, 7));
+        writer.AddData("b.bin", { 'x' });
+        bool ok = writer.Write(path) && !writer.Write(path + "/nested/impossible.bfpak");
+
+        PakWriter duplicate;
+        duplicate.AddData("same.bin", { 1 });
+        duplicate.AddData("./same.bin", { 2 });
+        ok = ok && !duplicate.Write(path + ".dup");
+
+        std::vector<uint8_t> bytes;
+        {
+            std::ifstream file(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        auto reopen = [&path](const std::vector<uint8_t>& content, PakArchive& archive) {
+            archive.Close();
+            std::ofstream(path, std::ios::binary | std::ios::trunc)
+                .write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+            return archive.Open(path);
+        };
+
+        PakArchive archive;
+        std::vector<uint8_t> truncated(bytes.begin(), bytes.end() - 9);
+        ok = ok && !reopen(truncated, archive) && !archive.GetError().empty();
+
+        // One flipped byte per entry: in the middle of a compressed block and in a stored one
+        ok = ok && reopen(bytes, archive);
+        const PakEntry* compressed = ok ? archive.Find("a.bin") : nullptr;
+        const PakEntry* stored = ok ? archive.Find("b.bin") : nullptr;
+        ok = ok && compressed != nullptr && stored != nullptr;
+        if (ok) {
+            PakBlock compressedBlock = archive.m_blocks[compressed->firstBlock];
+            PakBlock storedBlock = archive.m_blocks[stored->firstBlock];
+            ok = compressedBlock.codec == static_cast<uint16_t>(PakCodec::LZ4) &&
+                 storedBlock.codec == static_cast<uint16_t>(PakCodec::NONE);
+
+            std::vector<uint8_t> damaged = bytes;
+            damaged[compressedBlock.offset + compressedBlock.storedSize / 2] ^= 0x01;
+            damaged[storedBlock.offset] ^= 0x01;
+            ok = ok && reopen(damaged, archive);
+            compressed = ok ? archive.Find("a.bin") : nullptr;
+            stored = ok ? archive.Find("b.bin") : nullptr;
+
+            std::vector<uint8_t> read;
+            ok = ok && compressed != nullptr && stored != nullptr &&
+                 !archive.Read(*compressed, read, true) && !archive.Verify(*compressed) &&
+                 archive.Read(*stored, read) && !archive.Read(*stored, read, true) && !archive.Verify(*stored);
+        }
+
+        archive.Close();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return ok;
+    });
+}
+
+} // namespace BrightForge
+
+// Note on usage:
+// Build archives with tools/bf-pak (or PakWriter directly) and mount them through
+// VirtualFileSystem so FileService and FileIntoString see packed and loose files
+// alike.
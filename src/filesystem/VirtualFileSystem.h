@@ -0,0 +1,289 @@
+/**
+ * VirtualFileSystem - Mounted .bfpak archives layered over loose files
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include "PakArchive.h"
+#include "BatchIO.h"
+#include "../core/TestManagerNew.h"
+
+namespace BrightForge {
+
+// One lookup order for every engine read: mounted archives, most recent mount first,
+// then the loose file on disk. An archive mounted at "assets" answers "assets/x.glb"
+// from its entry "x.glb"; with no mount point it answers archive paths directly.
+// Lookups take a shared lock only long enough to pin the mount, so reads from many
+// threads never serialize. Deliberately silent like PakArchive; callers log.
+class VirtualFileSystem {
+public:
+    static VirtualFileSystem& Instance() {
+        static VirtualFileSystem instance;
+        return instance;
+    }
+
+    bool Mount(const std::string& archivePath, const std::string& mountPoint = "", std::string* error = nullptr) {
+        auto mount = std::make_shared<MountedArchive>();
+        if (!mount->archive.Open(archivePath)) {
+            if (error != nullptr) {
+                *error = mount->archive.GetError();
+            }
+            return false;
+        }
+        mount->archivePath = archivePath;
+        mount->mountPoint = PakArchive::NormalizePath(mountPoint);
+        while (!mount->mountPoint.empty() && mount->mountPoint.back() == '/') {
+            mount->mountPoint.pop_back();
+        }
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_mounts.insert(m_mounts.begin(), std::move(mount));
+        return true;
+    }
+
+    // Readers that already pinned the archive finish against it; new lookups miss it
+    bool Unmount(const std::string& archivePath) {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        for (auto it = m_mounts.begin(); it != m_mounts.end(); ++it) {
+            if ((*it)->archivePath == archivePath) {
+                m_mounts.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void UnmountAll() {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_mounts.clear();
+    }
+
+    size_t GetMountCount() const {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return m_mounts.size();
+    }
+
+    // Archive that serves `path`, or empty when it resolves to a loose file (or nothing)
+    std::string ArchiveFor(const std::string& path) const {
+        Resolved resolved = Resolve(path);
+        return resolved.entry != nullptr ? resolved.mount->archivePath : std::string();
+    }
+
+    bool Exists(const std::string& path) const {
+        if (Resolve(path).entry != nullptr) {
+            return true;
+        }
+        std::error_code ec;
+        return !path.empty() && std::filesystem::is_regular_file(path, ec);
+    }
+
+    bool Size(const std::string& path, uint64_t& outSize) const {
+        Resolved resolved = Resolve(path);
+        if (resolved.entry != nullptr) {
+            outSize = resolved.entry->size;
+            return true;
+        }
+        std::error_code ec;
+        uint64_t size = path.empty() ? 0 : std::filesystem::file_size(path, ec);
+        if (path.empty() || ec) {
+            return false;
+        }
+        outSize = size;
+        return true;
+    }
+
+    // `verify` checks archived blocks against their CRC32C as they decode (loose files
+    // carry no checksum)
+    bool ReadFile(const std::string& path, std::vector<uint8_t>& out, bool verify = false) const {
+        return ReadInto(path, out, verify);
+    }
+
+    bool ReadFile(const std::string& path, std::string& out, bool verify = false) const {
+        return ReadInto(path, out, verify);
+    }
+
+    // Content hash (Xxh3) of an archived entry straight from the TOC; false for loose files
+    bool ArchivedContentHash(const std::string& path, uint64_t& outHash) const {
+        Resolved resolved = Resolve(path);
+        if (resolved.entry == nullptr) {
+            return false;
+        }
+        outHash = resolved.entry->contentHash;
+        return true;
+    }
+
+    // Check an archived entry's block CRC32Cs without materializing it
+    bool VerifyArchived(const std::string& path) const {
+        Resolved resolved = Resolve(path);
+        return resolved.entry != nullptr && resolved.mount->archive.Verify(*resolved.entry);
+    }
+
+    // Probes for `paths` in the same order. Archived entries are answered from the
+    // TOC and their first block; the rest go to IoBackend::Default() as one batch.
+    std::vector<FileProbe> ProbePaths(const std::vector<std::string>& paths) const {
+        std::vector<FileProbe> probes(paths.size());
+        std::vector<FileProbe> loose;
+        std::vector<size_t> looseIndex;
+
+        for (size_t i = 0; i < paths.size(); ++i) {
+            probes[i].path = paths[i];
+            Resolved resolved = Resolve(paths[i]);
+            if (resolved.entry == nullptr) {
+                loose.push_back(probes[i]);
+                looseIndex.push_back(i);
+                continue;
+            }
+            probes[i].exists = true;
+            probes[i].size = resolved.entry->size;
+            probes[i].headerBytes = static_cast<uint32_t>(
+                resolved.mount->archive.ReadPrefix(*resolved.entry, probes[i].header, BATCH_IO_HEADER_BYTES));
+        }
+
+        if (!loose.empty()) {
+            IoBackend::Default().Probe(loose);
+            for (size_t i = 0; i < loose.size(); ++i) {
+                probes[looseIndex[i]] = std::move(loose[i]);
+            }
+        }
+        return probes;
+    }
+
+    // Archive-over-loose precedence and mount points
+    static void RegisterTests();
+
+private:
+    struct MountedArchive {
+        std::string archivePath;
+        std::string mountPoint;
+        PakArchive archive;
+    };
+
+    // Holding `mount` keeps the archive mapped while `entry` is in use
+    struct Resolved {
+        std::shared_ptr<const MountedArchive> mount;
+        const PakEntry* entry = nullptr;
+    };
+
+    mutable std::shared_mutex m_mutex;
+    std::vector<std::shared_ptr<const MountedArchive>> m_mounts;   // Newest first
+
+    VirtualFileSystem() = default;
+
+    Resolved Resolve(const std::string& path) const {
+        Resolved resolved;
+        if (path.empty()) {
+            return resolved;
+        }
+
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        if (m_mounts.empty()) {
+            return resolved;
+        }
+        std::string normalized = PakArchive::NormalizePath(path);
+        for (const auto& mount : m_mounts) {
+            std::string_view inner = normalized;
+            if (!mount->mountPoint.empty()) {
+                if (inner.size() <= mount->mountPoint.size() || inner.compare(0, mount->mountPoint.size(), mount->mountPoint) != 0 ||
+                    inner[mount->mountPoint.size()] != '/') {
+                    continue;
+                }
+                inner.remove_prefix(mount->mountPoint.size() + 1);
+            }
+            if (const PakEntry* entry = mount->archive.Find(inner)) {
+                resolved.mount = mount;
+                resolved.entry = entry;
+                return resolved;
+            }
+        }
+        return resolved;
+    }
+
+    template <typename Buffer>
+    bool ReadInto(const std::string& path, Buffer& out, bool verify) const {
+        Resolved resolved = Resolve(path);
+        if (resolved.entry != nullptr) {
+            out.resize(static_cast<size_t>(resolved.entry->size));
+            bool ok = resolved.mount->archive.Read(*resolved.entry, reinterpret_cast<uint8_t*>(out.data()), out.size(), verify);
+            if (!ok) {
+                out.clear();
+            }
+            return ok;
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        if (path.empty() || !file.is_open()) {
+            return false;
+        }
+        std::error_code ec;
+        uint64_t size = std::filesystem::file_size(path, ec);
+        if (ec) {
+            return false;
+        }
+        out.resize(static_cast<size_t>(size));
+        file.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+        return file.gcount() == static_cast<std::streamsize>(out.size());
+    }
+};
+
+inline void VirtualFileSystem::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("VirtualFileSystem");
+
+    // A private instance keeps the test away from whatever the engine has mounted
+    tests.AddTest("VirtualFileSystem", "Archives shadow loose files under their mount point", []() {
+        std::error_code ec;
+        std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / "brightforge_vfs";
+        std::filesystem::remove_all(dir, ec);
+        std::filesystem::create_directories(dir / "assets", ec);
+        std::ofstream((dir / "assets" / "shared.txt").string(), std::ios::binary) << "loose";
+        std::ofstream((dir / "assets" / "only_loose.txt").string(), std::ios::binary) << "disk";
+
+        std::string pakPath = (dir / "assets.bfpak").string();
+        PakWriter writer;
+        std::string packed = "glTF" + std::string(70000, 'p');
+        writer.AddData("shared.txt", std::vector<uint8_t>(packed.begin(), packed.end()));
+        bool ok = writer.Write(pakPath);
+
+        VirtualFileSystem vfs;
+        std::string mountPoint = (dir / "assets").generic_string();
+        std::string shared = mountPoint + "/shared.txt";
+        std::string looseOnly = (dir / "assets" / "only_loose.txt").string();
+
+        std::string text;
+        ok = ok && vfs.ReadFile(shared, text) && text == "loose" && vfs.ArchiveFor(shared).empty();
+        ok = ok && vfs.Mount(pakPath, mountPoint) && vfs.GetMountCount() == 1 && !vfs.Mount(looseOnly);
+
+        uint64_t size = 0;
+        std::vector<uint8_t> bytes;
+        ok = ok && vfs.ArchiveFor(shared) == pakPath && vfs.Size(shared, size) && size == packed.size() &&
+             vfs.ReadFile(shared, text) && text == packed && vfs.ReadFile(looseOnly, bytes) &&
+             std::string(bytes.begin(), bytes.end()) == "disk" && !vfs.Exists(mountPoint + "/missing.txt");
+
+        std::vector<FileProbe> probes = vfs.ProbePaths({ shared, looseOnly, mountPoint + "/missing.txt" });
+        ok = ok && probes[0].exists && probes[0].size == packed.size() && probes[0].headerBytes == BATCH_IO_HEADER_BYTES &&
+             std::memcmp(probes[0].header, "glTF", 4) == 0 && probes[1].exists && probes[1].size == 4 && !probes[2].exists;
+
+        ok = ok && vfs.Unmount(pakPath) && vfs.ReadFile(shared, text) && text == "loose";
+        std::filesystem::remove_all(dir, ec);
+        return ok;
+    });
+}
+
+} // namespace BrightForge
+
+// Note on usage:
+// Mount shipping archives at startup (VirtualFileSystem::Instance().Mount(...)) before
+// FileService or FileIntoString touch assets; loose files keep working underneath for
+// development.
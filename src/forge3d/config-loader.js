@@ -120,6 +120,19 @@ class Forge3DConfig {
       coordinate_system: 'unreal'
     });
 
+    this.meshOptimize = this._section('mesh_optimize', {
+      native: true,
+      native_path: 'bf-decimate',
+      timeout_ms: 120000
+    });
+
+    this.meshValidate = this._section('mesh_validate', {
+      native: true,
+      native_path: 'bf-validate',
+      timeout_ms: 30000,
+      overlap_threshold: 0.05
+    });
+
     this.materials = this._section('materials', {
       extract_on_convert: true,
       default_preset: 'ue5-standard',
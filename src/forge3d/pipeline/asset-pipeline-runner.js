@@ -587,6 +587,7 @@ class AssetPipelineRunner extends EventEmitter {
     delete safe.imageBuffer;
     delete safe.meshBuffer;
     delete safe.optimizedBuffer;
+    delete safe.presetBuffers;
     delete safe.fbxBuffer;
     return safe;
   }
@@ -3,7 +3,12 @@
 // Date: March 6, 2026
 // Purpose: Pipeline stage handler — optimizes mesh by reducing polygon count
 
+import { execFile } from 'child_process';
+import { mkdtemp, writeFile, readFile, rm } from 'fs/promises';
+import { tmpdir } from 'os';
+import { join } from 'path';
 import modelBridge from '../../model-bridge.js';
+import forge3dConfig from '../../config-loader.js';
 import errorHandler from '../../../core/error-handler.js';
 
 // Preset face counts matching forge3d routes /presets endpoint
@@ -14,9 +19,76 @@ const PRESETS = {
   unreal: 50000
 };
 
+/**
+ * Run bf-decimate on the buffer. One call decimates to the requested budget and every
+ * preset in a single collapse pass, so the whole ladder comes back together.
+ *
+ * @param {Buffer} meshBuffer - GLB buffer
+ * @param {number} targetFaces - Face budget for the optimized mesh
+ * @returns {Promise<Object|null>} Stage result, or null when the binary is not installed
+ */
+async function optimizeNative(meshBuffer, targetFaces) {
+  const { native_path: nativePath, timeout_ms: timeoutMs } = forge3dConfig.meshOptimize;
+  const dir = await mkdtemp(join(tmpdir(), 'bf-decimate-'));
+
+  try {
+    const inputPath = join(dir, 'mesh.glb');
+    await writeFile(inputPath, meshBuffer);
+
+    const targets = [...new Set([targetFaces, ...Object.values(PRESETS)])];
+    let stdout;
+    try {
+      stdout = await new Promise((resolve, reject) => {
+        execFile(nativePath, [inputPath, dir, '--targets', targets.join(',')],
+          { timeout: timeoutMs, windowsHide: true },
+          (err, out, stderr) => {
+            if (err) {
+              err.stderr = stderr;
+              reject(err);
+            } else {
+              resolve(out);
+            }
+          });
+      });
+    } catch (err) {
+      if (err.code === 'ENOENT') {
+        return null;
+      }
+      throw new Error(`bf-decimate failed: ${(err.stderr || err.message).trim()}`);
+    }
+
+    const report = JSON.parse(stdout);
+    const presetBuffers = {};
+    let optimized = null;
+    for (const level of report.levels) {
+      const buffer = await readFile(level.path);
+      if (level.target === targetFaces) {
+        optimized = { level, buffer };
+      }
+      if (PRESETS[level.name] === level.target) {
+        presetBuffers[level.name] = buffer;
+      }
+    }
+    if (!optimized) {
+      throw new Error(`bf-decimate produced no mesh for ${targetFaces} faces`);
+    }
+
+    return {
+      optimizedBuffer: optimized.buffer,
+      presetBuffers,
+      originalFaces: report.originalFaces,
+      optimizedFaces: optimized.level.faces,
+      reductionRatio: report.originalFaces > 0 ? optimized.level.faces / report.originalFaces : 1,
+      backend: 'native'
+    };
+  } finally {
+    await rm(dir, { recursive: true, force: true });
+  }
+}
+
 /**
  * Optimize mesh stage handler.
- * Runs quadric decimation on the mesh via Python bridge.
+ * Runs quadric decimation natively (bf-decimate) when available, otherwise via the Python bridge.
  *
  * @param {Object} context - Pipeline execution context
  * @param {Buffer} context.meshBuffer - GLB buffer from previous stage
@@ -33,19 +105,27 @@ export async function execute(context, stageConfig) {
     };
   }
 
-  if (modelBridge.state !== 'running') {
-    return {
-      success: false,
-      result: null,
-      error: `Python bridge not running (state: ${modelBridge.state})`
-    };
-  }
-
   // Resolve target face count from preset or explicit value
   const preset = stageConfig.preset;
   const targetFaces = stageConfig.target_faces || PRESETS[preset] || PRESETS.desktop;
 
   try {
+    if (forge3dConfig.meshOptimize.native) {
+      const result = await optimizeNative(context.meshBuffer, targetFaces);
+      if (result) {
+        return { success: true, result: { ...result, preset } };
+      }
+      console.warn('[OPTIMIZE] bf-decimate not found, falling back to the Python bridge');
+    }
+
+    if (modelBridge.state !== 'running') {
+      return {
+        success: false,
+        result: null,
+        error: `Python bridge not running (state: ${modelBridge.state})`
+      };
+    }
+
     const result = await modelBridge.optimizeMesh(
       context.meshBuffer,
       targetFaces,
@@ -60,6 +140,7 @@ export async function execute(context, stageConfig) {
         originalFaces: result.original_faces || result.originalFaces,
         optimizedFaces: result.optimized_faces || result.optimizedFaces,
         reductionRatio: result.reduction_ratio || result.reductionRatio,
+        backend: 'python',
         preset
       }
     };
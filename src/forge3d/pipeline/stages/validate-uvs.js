@@ -6,13 +6,71 @@
  * @date 2026-03-07
  */
 
+import { execFile } from 'child_process';
+import { mkdtemp, writeFile, rm } from 'fs/promises';
+import { tmpdir } from 'os';
+import { join } from 'path';
 import modelBridge from '../../model-bridge.js';
+import forge3dConfig from '../../config-loader.js';
 import errorHandler from '../../../core/error-handler.js';
 import telemetryBus from '../../../core/telemetry-bus.js';
 
+/**
+ * Run bf-validate on the buffer and map its report onto the bridge's UV result shape.
+ *
+ * @param {Buffer} meshBuffer - GLB buffer
+ * @returns {Promise<Object|null>} UV validation, or null when the binary is not installed
+ */
+async function validateNative(meshBuffer) {
+  const { native_path: nativePath, timeout_ms: timeoutMs, overlap_threshold: overlapThreshold } =
+    forge3dConfig.meshValidate;
+  const dir = await mkdtemp(join(tmpdir(), 'bf-validate-'));
+
+  try {
+    const inputPath = join(dir, 'mesh.glb');
+    await writeFile(inputPath, meshBuffer);
+
+    let stdout;
+    try {
+      stdout = await new Promise((resolve, reject) => {
+        execFile(nativePath, [inputPath], { timeout: timeoutMs, windowsHide: true }, (err, out, stderr) => {
+          // Exit code 1 means "mesh is invalid" and still comes with a report
+          if (err && !(err.code === 1 && out)) {
+            err.stderr = stderr;
+            reject(err);
+          } else {
+            resolve(out);
+          }
+        });
+      });
+    } catch (err) {
+      if (err.code === 'ENOENT') {
+        return null;
+      }
+      throw new Error(`bf-validate failed: ${(err.stderr || err.message).trim()}`);
+    }
+
+    const report = JSON.parse(stdout.split('\n')[0]);
+    return {
+      has_uvs: report.uv.has_uvs,
+      uv_count: report.uv.uv_count,
+      uv_min: report.uv.min,
+      uv_max: report.uv.max,
+      out_of_range: report.uv.out_of_range,
+      overlap_ratio: report.uv.overlap_ratio,
+      overlapping_islands: report.uv.overlap_ratio > overlapThreshold,
+      texel_density: report.uv.texel_density.mean,
+      backend: 'native'
+    };
+  } finally {
+    await rm(dir, { recursive: true, force: true });
+  }
+}
+
 /**
  * Validate UV coordinates stage handler.
- * Checks if mesh has valid UVs for texturing.
+ * Checks if mesh has valid UVs for texturing, natively (bf-validate) when available,
+ * otherwise via the Python bridge.
  * Optionally auto-unwraps if UVs are missing and auto_unwrap is enabled.
  *
  * @param {Object} context - Pipeline execution context
@@ -23,15 +81,6 @@ import telemetryBus from '../../../core/telemetry-bus.js';
  * @returns {Promise<Object>} { success, result, error }
  */
 export async function execute(context, stageConfig) {
-  // Verify bridge is running
-  if (modelBridge.state !== 'running') {
-    return {
-      success: false,
-      result: null,
-      error: `Python bridge not running (state: ${modelBridge.state})`
-    };
-  }
-
   if (!context.meshBuffer) {
     return {
       success: false,
@@ -46,7 +95,26 @@ export async function execute(context, stageConfig) {
     console.log('[UV] Validating UV coordinates...');
 
     // Check UV coordinates
-    const validation = await modelBridge.validateUVs(context.meshBuffer);
+    let validation = null;
+    if (forge3dConfig.meshValidate.native) {
+      validation = await validateNative(context.meshBuffer);
+      if (!validation) {
+        console.warn('[UV] bf-validate not found, falling back to the Python bridge');
+      }
+    }
+
+    if (!validation) {
+      // Verify bridge is running
+      if (modelBridge.state !== 'running') {
+        endTimer({ success: false, error: 'bridge_not_running' });
+        return {
+          success: false,
+          result: null,
+          error: `Python bridge not running (state: ${modelBridge.state})`
+        };
+      }
+      validation = await modelBridge.validateUVs(context.meshBuffer);
+    }
 
     if (validation.has_uvs) {
       console.log(`[UV] Valid UVs found (${validation.uv_count} coordinates)`);
@@ -59,7 +127,9 @@ export async function execute(context, stageConfig) {
           has_uvs: true,
           uv_count: validation.uv_count,
           overlapping_islands: validation.overlapping_islands,
-          texel_density: validation.texel_density
+          overlap_ratio: validation.overlap_ratio,
+          texel_density: validation.texel_density,
+          backend: validation.backend || 'python'
         }
       };
     }
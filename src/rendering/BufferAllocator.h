@@ -6,9 +6,11 @@
 #pragma once
 
 #include <vector>
-#include <unordered_map>
+#include <algorithm>
 #include <mutex>
 #include <cstdint>
+#include "../core/HandlePool.h"
+#include "../core/MemoryTracker.h"
 #include "../core/QuoteSystem.h"
 #include "../core/DebugWindow.h"
 
@@ -23,7 +25,7 @@ using VkDeviceMemory = VkDeviceMemory_T*;
 using VkDevice = VkDevice_T*;
 using VkPhysicalDevice = VkPhysicalDevice_T*;
 
-// Buffer handle type
+// Buffer handle type (generational, see HandlePool)
 using BufferHandle = uint32_t;
 constexpr BufferHandle INVALID_BUFFER_HANDLE = 0;
 
@@ -37,6 +39,7 @@ struct BufferInfo {
     uint64_t size;
     bool isMapped;
     void* mappedPointer;
+    uint64_t creationIndex; // Orders DestroyAll() independently of pool layout
 
     BufferInfo()
         : buffer(nullptr)
@@ -44,6 +47,7 @@ struct BufferInfo {
         , size(0)
         , isMapped(false)
         , mappedPointer(nullptr)
+        , creationIndex(0)
     {}
 };
 
@@ -57,7 +61,7 @@ public:
     BufferAllocator(VkDevice device, VkPhysicalDevice physicalDevice)
         : mDevice(device)
         , mPhysicalDevice(physicalDevice)
-        , mNextHandle(1)
+        , mNextCreationIndex(0)
         , mTotalAllocatedBytes(0)
         , mDeviceMemoryLimit(0)
     {
@@ -149,13 +153,13 @@ public:
         std::lock_guard<std::mutex> lock(mMutex);
 
         // Guard: handle not found
-        auto it = mBuffers.find(handle);
-        if (it == mBuffers.end()) {
+        BufferInfo* found = mBuffers.Get(handle);
+        if (found == nullptr) {
             QuoteSystem::Instance().Log("WriteBuffer: handle not found", QuoteSystem::MessageType::WARNING);
             return false;
         }
 
-        BufferInfo& info = it->second;
+        BufferInfo& info = *found;
 
         // Guard: write exceeds buffer size
         if (offset + size > info.size) {
@@ -184,16 +188,16 @@ public:
 
         std::lock_guard<std::mutex> lock(mMutex);
 
-        auto it = mBuffers.find(handle);
-        if (it == mBuffers.end()) {
+        BufferInfo* info = mBuffers.Get(handle);
+        if (info == nullptr) {
             return;
         }
 
-        BufferInfo& info = it->second;
-        DestroyBufferInternal(info);
+        DestroyBufferInternal(*info);
 
-        mTotalAllocatedBytes -= info.size;
-        mBuffers.erase(it);
+        mTotalAllocatedBytes -= info->size;
+        MemoryTracker::Instance().Release(MemoryTag::GPU_BUFFERS, static_cast<size_t>(info->size));
+        mBuffers.Remove(handle);
 
         DebugWindow::Instance().Post("Renderer", "Buffer destroyed (handle " +
             std::to_string(handle) + ")",
@@ -204,21 +208,30 @@ public:
     void DestroyAll() {
         std::lock_guard<std::mutex> lock(mMutex);
 
-        // Destroy in reverse order to handle dependencies
-        for (auto it = mBuffers.rbegin(); it != mBuffers.rend(); ++it) {
-            DestroyBufferInternal(it->second);
+        // Destroy in reverse creation order to handle dependencies; the pool's
+        // dense order is reshuffled by removals, so sort by creationIndex
+        std::vector<BufferInfo*> ordered;
+        ordered.reserve(mBuffers.Size());
+        for (BufferInfo& info : mBuffers) {
+            ordered.push_back(&info);
+        }
+        std::sort(ordered.begin(), ordered.end(), [](const BufferInfo* a, const BufferInfo* b) {
+            return a->creationIndex > b->creationIndex;
+        });
+        for (BufferInfo* info : ordered) {
+            DestroyBufferInternal(*info);
         }
 
-        if (!mBuffers.empty()) {
+        if (!mBuffers.Empty()) {
             QuoteSystem::Instance().Log("BufferAllocator destroyed " +
-                std::to_string(mBuffers.size()) + " buffers (total: " +
+                std::to_string(mBuffers.Size()) + " buffers (total: " +
                 std::to_string(mTotalAllocatedBytes / (1024 * 1024)) + " MB)",
                 QuoteSystem::MessageType::INFO);
         }
 
-        mBuffers.clear();
+        MemoryTracker::Instance().Release(MemoryTag::GPU_BUFFERS, static_cast<size_t>(mTotalAllocatedBytes));
+        mBuffers.Clear();
         mTotalAllocatedBytes = 0;
-        mNextHandle = 1;
     }
 
     // Get total allocated memory in bytes
@@ -230,7 +243,7 @@ public:
     // Get number of allocated buffers
     uint32_t GetBufferCount() const {
         std::lock_guard<std::mutex> lock(mMutex);
-        return static_cast<uint32_t>(mBuffers.size());
+        return static_cast<uint32_t>(mBuffers.Size());
     }
 
     // Prevent copy/move
@@ -280,9 +293,14 @@ private:
         }
 
         // Assign handle and track
-        BufferHandle handle = mNextHandle++;
-        mBuffers[handle] = info;
+        info.creationIndex = mNextCreationIndex++;
+        BufferHandle handle = mBuffers.Insert(info);
+        if (handle == INVALID_BUFFER_HANDLE) {
+            DestroyBufferInternal(info);
+            return INVALID_BUFFER_HANDLE;
+        }
         mTotalAllocatedBytes += size;
+        MemoryTracker::Instance().Add(MemoryTag::GPU_BUFFERS, static_cast<size_t>(size));
 
         return handle;
     }
@@ -303,8 +321,8 @@ private:
     VkDevice mDevice;
     VkPhysicalDevice mPhysicalDevice;
     mutable std::mutex mMutex;
-    std::unordered_map<BufferHandle, BufferInfo> mBuffers;
-    BufferHandle mNextHandle;
+    HandlePool<BufferInfo> mBuffers;
+    uint64_t mNextCreationIndex;
     uint64_t mTotalAllocatedBytes;
     uint64_t mDeviceMemoryLimit;
 };
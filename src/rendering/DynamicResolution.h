@@ -0,0 +1,400 @@
+/** DynamicResolution - Frame-time driven render scale and bilinear upscale
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "RenderConfig.h"
+#include "../core/Parallel.h"
+#include "../core/TestManagerNew.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define BF_UPSCALE_SSE2 1
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define BF_UPSCALE_NEON 1
+#endif
+
+// Controller tuning. Render cost is taken to scale with pixel count (scale squared).
+constexpr float DYNAMIC_RES_COST_SMOOTHING = 0.2f;  // Weight of the newest frame in the cost average
+constexpr float DYNAMIC_RES_HEADROOM = 0.9f;        // Aim this far below the target so spikes still fit
+constexpr float DYNAMIC_RES_DEADBAND = 0.05f;       // Relative scale error that is left alone
+constexpr float DYNAMIC_RES_DROP_GAIN = 0.5f;       // Share of the correction applied per frame when over budget
+constexpr float DYNAMIC_RES_RAISE_GAIN = 0.1f;      // ... and when under budget (raise slowly, drop fast)
+constexpr float DYNAMIC_RES_STEP = 1.0f / 64.0f;    // Scales snap to this grid so noise does not resize targets
+
+// DynamicResolution picks the internal render scale each frame:
+// - Update() takes the measured render time (not vsync waits) and keeps a smoothed
+//   cost. The scale that would bring that cost to headroom x target is
+//   scale * sqrt(goal / cost); each frame moves part of the way there, faster down
+//   than up, inside [minRenderScale, maxRenderScale]
+// - After a change the smoothed cost is rescaled to the new pixel count, so the next
+//   frames do not correct the same error twice (no overshoot or oscillation)
+// - Upscale() resamples the scaled frame into the output framebuffer: separable
+//   bilinear on packed 8-bit x4 pixels, SSE2 / NEON with a matching scalar path,
+//   rows spread over the JobSystem
+// With RenderConfig::dynamicResolution off the scale stays at RenderConfig::renderScale.
+class DynamicResolution {
+public:
+    DynamicResolution() = default;
+
+    explicit DynamicResolution(const RenderConfig& config) {
+        Configure(config);
+    }
+
+    // Bounds and target from the config; the scale restarts at renderScale (clamped)
+    void Configure(const RenderConfig& config) {
+        mEnabled = config.dynamicResolution;
+        mTargetMs = config.targetFrameTimeMs;
+        mMinScale = config.minRenderScale;
+        mMaxScale = std::max(config.minRenderScale, config.maxRenderScale);
+        mScale = mEnabled ? std::clamp(config.renderScale, mMinScale, mMaxScale) : config.renderScale;
+        mSmoothedMs = 0.0f;
+    }
+
+    // Feed one frame's render time; returns the scale for the next frame
+    float Update(float renderMs) {
+        if (!mEnabled || renderMs <= 0.0f || mTargetMs <= 0.0f) {
+            return mScale;
+        }
+        mSmoothedMs = mSmoothedMs > 0.0f ? mSmoothedMs + (renderMs - mSmoothedMs) * DYNAMIC_RES_COST_SMOOTHING
+                                         : renderMs;
+
+        float ideal = std::clamp(mScale * std::sqrt(mTargetMs * DYNAMIC_RES_HEADROOM / mSmoothedMs), mMinScale, mMaxScale);
+        bool atBound = ideal == mMinScale || ideal == mMaxScale;
+        if (ideal == mScale || (!atBound && std::fabs(ideal - mScale) <= mScale * DYNAMIC_RES_DEADBAND)) {
+            return mScale;
+        }
+
+        float gain = ideal < mScale ? DYNAMIC_RES_DROP_GAIN : DYNAMIC_RES_RAISE_GAIN;
+        float next = std::round((mScale + (ideal - mScale) * gain) / DYNAMIC_RES_STEP) * DYNAMIC_RES_STEP;
+        if (next == mScale) {
+            // Corrections smaller than half a step still move one step (never past the ideal)
+            next = ideal < mScale ? std::max(mScale - DYNAMIC_RES_STEP, ideal) : std::min(mScale + DYNAMIC_RES_STEP, ideal);
+        }
+        next = std::clamp(next, mMinScale, mMaxScale);
+
+        float ratio = next / mScale;
+        mSmoothedMs *= ratio * ratio;
+        mScale = next;
+        return mScale;
+    }
+
+    float GetScale() const { return mScale; }
+    float GetSmoothedMs() const { return mSmoothedMs; }
+    bool IsEnabled() const { return mEnabled; }
+
+    // Render target size for an output size at `scale` (at least 1x1)
+    static void RenderExtent(uint32_t width, uint32_t height, float scale, uint32_t& outWidth, uint32_t& outHeight) {
+        outWidth = std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(width * scale)));
+        outHeight = std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(height * scale)));
+    }
+
+    // Bilinear resample of packed 8-bit x4 pixels (channel order does not matter) with
+    // pixel centers aligned. Meant for enlarging; shrinking works but does not filter
+    // the skipped texels. allowSimd = false forces the scalar path (tests compare the two).
+    static void Upscale(const uint32_t* src, uint32_t srcWidth, uint32_t srcHeight, uint32_t* dst, uint32_t dstWidth,
+                        uint32_t dstHeight, bool allowSimd = true, size_t workerCount = 0) {
+        // Guard: nothing to do
+        if (srcWidth == 0 || srcHeight == 0 || dstWidth == 0 || dstHeight == 0) {
+            return;
+        }
+        if (srcWidth == dstWidth && srcHeight == dstHeight) {
+            std::memcpy(dst, src, static_cast<size_t>(srcWidth) * srcHeight * sizeof(uint32_t));
+            return;
+        }
+
+        const std::vector<Tap> columns = BuildTaps(srcWidth, dstWidth);
+        const std::vector<Tap> rows = BuildTaps(srcHeight, dstHeight);
+        const bool simd = allowSimd && HasSimd();
+
+        Parallel::ForRange(dstHeight, ROWS_PER_TASK, [&](size_t begin, size_t end) {
+            // One vertically blended source row, 16 bits per channel, plus a copy of its
+            // last pixel so the right edge needs no special case
+            std::vector<int16_t> blended((static_cast<size_t>(srcWidth) + 1) * 4);
+            const size_t channels = static_cast<size_t>(srcWidth) * 4;
+            for (size_t y = begin; y < end; ++y) {
+                const Tap& tap = rows[y];
+                const uint8_t* top = reinterpret_cast<const uint8_t*>(src + static_cast<size_t>(tap.index) * srcWidth);
+                const uint8_t* bottom = tap.index + 1 < srcHeight ? top + channels : top;
+                size_t done = simd ? BlendRowsSimd(top, bottom, tap.weight, blended.data(), channels) : 0;
+                for (size_t k = done; k < channels; ++k) {
+                    blended[k] = Lerp(top[k], bottom[k], tap.weight);
+                }
+                std::memcpy(&blended[channels], &blended[channels - 4], 4 * sizeof(int16_t));
+
+                uint8_t* out = reinterpret_cast<uint8_t*>(dst + y * dstWidth);
+                done = simd ? BlendColumnsSimd(blended.data(), columns.data(), out, dstWidth) : 0;
+                for (size_t x = done; x < dstWidth; ++x) {
+                    const int16_t* left = &blended[static_cast<size_t>(columns[x].index) * 4];
+                    for (size_t c = 0; c < 4; ++c) {
+                        out[x * 4 + c] = static_cast<uint8_t>(Lerp(left[c], left[c + 4], columns[x].weight));
+                    }
+                }
+            }
+        }, workerCount);
+    }
+
+    static bool HasSimd() {
+#if defined(BF_UPSCALE_SSE2) || defined(BF_UPSCALE_NEON)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static void RegisterTests();
+
+    static void RegisterBenchmarks(uint32_t width = 1920, uint32_t height = 1080);
+
+private:
+    static constexpr size_t ROWS_PER_TASK = 16;
+
+    // Source index and the weight of its right/lower neighbour, in 1/128ths. Seven bits
+    // keep (b - a) * weight inside int16, so SIMD lanes and scalar code agree exactly.
+    struct Tap {
+        uint32_t index;
+        int16_t weight;
+    };
+
+    bool mEnabled = false;
+    float mTargetMs = 16.6f;
+    float mMinScale = 0.5f;
+    float mMaxScale = 1.0f;
+    float mScale = 1.0f;
+    float mSmoothedMs = 0.0f;
+
+    static std::vector<Tap> BuildTaps(uint32_t srcSize, uint32_t dstSize) {
+        std::vector<Tap> taps(dstSize);
+        const float step = static_cast<float>(srcSize) / static_cast<float>(dstSize);
+        for (uint32_t d = 0; d < dstSize; ++d) {
+            float position = std::max((static_cast<float>(d) + 0.5f) * step - 0.5f, 0.0f);
+            uint32_t index = static_cast<uint32_t>(position);
+            if (index + 1 >= srcSize) {
+                taps[d] = { srcSize - 1, 0 };
+            } else {
+                taps[d] = { index, static_cast<int16_t>(std::lround((position - static_cast<float>(index)) * 128.0f)) };
+            }
+        }
+        return taps;
+    }
+
+    static int16_t Lerp(int a, int b, int16_t weight) {
+        return static_cast<int16_t>(a + (((b - a) * weight) >> 7));
+    }
+
+    // Both return how many elements they handled; the scalar loops finish the rest
+#if defined(BF_UPSCALE_SSE2)
+    static size_t BlendRowsSimd(const uint8_t* top, const uint8_t* bottom, int16_t weight, int16_t* out, size_t count) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i w = _mm_set1_epi16(weight);
+        size_t k = 0;
+        for (; k + 16 <= count; k += 16) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + k));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + k));
+            __m128i aLow = _mm_unpacklo_epi8(a, zero);
+            __m128i aHigh = _mm_unpackhi_epi8(a, zero);
+            __m128i low = _mm_add_epi16(aLow, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(b, zero), aLow), w), 7));
+            __m128i high = _mm_add_epi16(aHigh, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(b, zero), aHigh), w), 7));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), low);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k + 8), high);
+        }
+        return k;
+    }
+
+    // Two output pixels per step: one unaligned load brings each pixel's left and right taps
+    static size_t BlendColumnsSimd(const int16_t* row, const Tap* columns, uint8_t* out, size_t count) {
+        size_t x = 0;
+        for (; x + 2 <= count; x += 2) {
+            __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + static_cast<size_t>(columns[x].index) * 4));
+            __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + static_cast<size_t>(columns[x + 1].index) * 4));
+            __m128i left = _mm_unpacklo_epi64(first, second);
+            __m128i right = _mm_unpackhi_epi64(first, second);
+            __m128i w = _mm_set_epi16(columns[x + 1].weight, columns[x + 1].weight, columns[x + 1].weight, columns[x + 1].weight,
+                                      columns[x].weight, columns[x].weight, columns[x].weight, columns[x].weight);
+            __m128i value = _mm_add_epi16(left, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(right, left), w), 7));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + x * 4), _mm_packus_epi16(value, value));
+        }
+        return x;
+    }
+#elif defined(BF_UPSCALE_NEON)
+    static size_t BlendRowsSimd(const uint8_t* top, const uint8_t* bottom, int16_t weight, int16_t* out, size_t count) {
+        const int16x8_t w = vdupq_n_s16(weight);
+        size_t k = 0;
+        for (; k + 8 <= count; k += 8) {
+            int16x8_t a = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(top + k)));
+            int16x8_t b = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(bottom + k)));
+            vst1q_s16(out + k, vaddq_s16(a, vshrq_n_s16(vmulq_s16(vsubq_s16(b, a), w), 7)));
+        }
+        return k;
+    }
+
+    static size_t BlendColumnsSimd(const int16_t* row, const Tap* columns, uint8_t* out, size_t count) {
+        size_t x = 0;
+        for (; x + 2 <= count; x += 2) {
+            int16x8_t first = vld1q_s16(row + static_cast<size_t>(columns[x].index) * 4);
+            int16x8_t second = vld1q_s16(row + static_cast<size_t>(columns[x + 1].index) * 4);
+            int16x8_t left = vcombine_s16(vget_low_s16(first), vget_low_s16(second));
+            int16x8_t right = vcombine_s16(vget_high_s16(first), vget_high_s16(second));
+            int16x8_t w = vcombine_s16(vdup_n_s16(columns[x].weight), vdup_n_s16(columns[x + 1].weight));
+            int16x8_t value = vaddq_s16(left, vshrq_n_s16(vmulq_s16(vsubq_s16(right, left), w), 7));
+            vst1_u8(out + x * 4, vqmovun_s16(value));
+        }
+        return x;
+    }
+#else
+    static size_t BlendRowsSimd(const uint8_t*, const uint8_t*, int16_t, int16_t*, size_t) { return 0; }
+    static size_t BlendColumnsSimd(const int16_t*, const Tap*, uint8_t*, size_t) { return 0; }
+#endif
+};
+
+inline void DynamicResolution::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("DynamicResolution");
+
+    // Synthetic scene: fixed cost plus a cost per output pixel at full scale
+    auto simulate = [](DynamicResolution& controller, float fixedMs, float pixelMs, int frames, float noise,
+                       std::vector<float>& scales) {
+        uint32_t seed = 777;
+        for (int frame = 0; frame < frames; ++frame) {
+            seed = seed * 1664525u + 1013904223u;
+            float jitter = 1.0f + noise * ((seed >> 8) / 8388608.0f - 1.0f);
+            float scale = controller.GetScale();
+            scales.push_back(controller.Update((fixedMs + pixelMs * scale * scale) * jitter));
+        }
+    };
+
+    auto dynamicConfig = []() {
+        RenderConfig config;
+        config.dynamicResolution = true;
+        config.targetFrameTimeMs = 16.0f;
+        config.minRenderScale = 0.25f;
+        config.maxRenderScale = 1.0f;
+        return config;
+    };
+
+    tests.AddTest("DynamicResolution", "Settles on the frame-time target without oscillating", [=]() {
+        // 40 ms at full scale: 16 * 0.9 = 14.4 ms needs a scale near sqrt(12.4 / 38) = 0.57
+        DynamicResolution controller(dynamicConfig());
+        std::vector<float> scales;
+        simulate(controller, 2.0f, 38.0f, 300, 0.0f, scales);
+
+        float settled = scales.back();
+        bool ok = std::fabs(settled - 0.57f) < 0.05f && scales.front() < 1.0f;
+        size_t changes = 0;
+        for (size_t i = 200; i < scales.size(); ++i) {
+            changes += scales[i] != scales[i - 1] ? 1 : 0;
+        }
+        // Never undershoots far below the settled scale on the way down
+        float lowest = *std::min_element(scales.begin(), scales.end());
+        return ok && changes == 0 && lowest > settled - 0.1f;
+    });
+
+    tests.AddTest("DynamicResolution", "Holds its bounds and recovers when the scene gets lighter", [=]() {
+        DynamicResolution controller(dynamicConfig());
+        std::vector<float> scales;
+        simulate(controller, 1.0f, 400.0f, 200, 0.0f, scales);
+        bool ok = controller.GetScale() == 0.25f;
+
+        simulate(controller, 1.0f, 4.0f, 400, 0.0f, scales);
+        ok = ok && controller.GetScale() == 1.0f;
+
+        // Frame-time noise of +-10% moves the scale rarely
+        DynamicResolution noisy(dynamicConfig());
+        std::vector<float> noisyScales;
+        simulate(noisy, 2.0f, 38.0f, 600, 0.1f, noisyScales);
+        size_t changes = 0;
+        for (size_t i = 300; i < noisyScales.size(); ++i) {
+            changes += noisyScales[i] != noisyScales[i - 1] ? 1 : 0;
+        }
+
+        // Disabled: the configured scale, whatever the frame time
+        RenderConfig fixed;
+        fixed.renderScale = 0.75f;
+        DynamicResolution off(fixed);
+        return ok && changes < 15 && std::fabs(noisy.GetScale() - 0.57f) < 0.08f && off.Update(100.0f) == 0.75f;
+    });
+
+    tests.AddTest("DynamicResolution", "SIMD upscale matches scalar and interpolates", []() {
+        uint32_t seed = 4242;
+        auto next = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return seed;
+        };
+
+        bool ok = true;
+        const uint32_t sizes[][4] = { { 13, 7, 29, 17 }, { 640, 360, 1280, 720 }, { 1, 1, 5, 3 }, { 64, 64, 37, 91 },
+                                      { 3, 9, 3, 9 } };
+        for (const auto& size : sizes) {
+            std::vector<uint32_t> src(static_cast<size_t>(size[0]) * size[1]);
+            for (uint32_t& pixel : src) {
+                pixel = next();
+            }
+            std::vector<uint32_t> simd(static_cast<size_t>(size[2]) * size[3], 0);
+            std::vector<uint32_t> scalar(simd.size(), 1);
+            Upscale(src.data(), size[0], size[1], simd.data(), size[2], size[3], true);
+            Upscale(src.data(), size[0], size[1], scalar.data(), size[2], size[3], false);
+            ok = ok && simd == scalar;
+        }
+
+        // A horizontal ramp doubled in width stays a ramp: monotonic and within the ends
+        const uint32_t width = 32;
+        std::vector<uint32_t> ramp(width * 2);
+        for (uint32_t x = 0; x < width; ++x) {
+            uint32_t value = x * 8;
+            ramp[x] = ramp[width + x] = 0xFF000000u | value << 16 | value << 8 | value;
+        }
+        std::vector<uint32_t> wide(width * 2 * 4);
+        Upscale(ramp.data(), width, 2, wide.data(), width * 2, 4);
+        for (uint32_t y = 0; y < 4; ++y) {
+            for (uint32_t x = 1; x < width * 2; ++x) {
+                uint32_t left = wide[y * width * 2 + x - 1];
+                uint32_t right = wide[y * width * 2 + x];
+                ok = ok && (right & 0xFF) >= (left & 0xFF) && (right >> 24) == 0xFF &&
+                     ((right >> 8) & 0xFF) == (right & 0xFF);
+            }
+        }
+        ok = ok && (wide[0] & 0xFF) == 0 && (wide[width * 2 - 1] & 0xFF) == (width - 1) * 8;
+
+        uint32_t renderWidth = 0;
+        uint32_t renderHeight = 0;
+        RenderExtent(1920, 1080, 0.5f, renderWidth, renderHeight);
+        ok = ok && renderWidth == 960 && renderHeight == 540;
+        RenderExtent(3, 3, 0.01f, renderWidth, renderHeight);
+        return ok && renderWidth == 1 && renderHeight == 1;
+    });
+}
+
+inline void DynamicResolution::RegisterBenchmarks(uint32_t width, uint32_t height) {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    static std::vector<uint32_t> source;
+    static std::vector<uint32_t> output;
+    source.assign(static_cast<size_t>(width / 2) * (height / 2), 0);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+    output.assign(static_cast<size_t>(width) * height, 0);
+
+    std::string size = std::to_string(width / 2) + "x" + std::to_string(height / 2) + " -> " +
+                       std::to_string(width) + "x" + std::to_string(height);
+    tests.AddBenchmark("DynamicResolution", "Upscale " + size, [width, height]() {
+        Upscale(source.data(), width / 2, height / 2, output.data(), width, height);
+        TestManagerNew::DoNotOptimize(output.data());
+    });
+    tests.AddBenchmark("DynamicResolution", "Upscale " + size + " (scalar)", [width, height]() {
+        Upscale(source.data(), width / 2, height / 2, output.data(), width, height, false);
+        TestManagerNew::DoNotOptimize(output.data());
+    });
+}
+
+// Note on usage:
+// SoftwareRenderService renders at RenderExtent(window, GetScale()) and upscales into
+// the window's pixel buffer; EndFrame() feeds the frame graph's time to Update().
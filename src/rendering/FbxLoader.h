@@ -0,0 +1,1286 @@
+/** FbxLoader - Binary FBX reader producing SoftwareMesh data
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "SoftwareMesh.h"
+#include "../core/QuoteSystem.h"
+#include "../core/DebugWindow.h"
+#include "../core/Parallel.h"
+#include "../core/TestManagerNew.h"
+#include "../filesystem/MappedFile.h"
+#include "../filesystem/Inflate.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <memory>
+#include <new>
+#include <atomic>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <cmath>
+
+// Binary FBX header: "Kaydara FBX Binary  \0\x1A\0" followed by a uint32 version
+constexpr size_t FBX_MAGIC_SIZE = 23;
+constexpr size_t FBX_HEADER_SIZE = 27;
+constexpr uint32_t FBX_VERSION_64BIT_OFFSETS = 7500;
+
+// Parse-time allocations (node records, property tables, inflated arrays) come from
+// here. The cap bounds memory use even for hostile array lengths.
+class FbxArena {
+public:
+    explicit FbxArena(size_t capacityBytes)
+        : mCapacity(capacityBytes), mUsed(0), mBlockUsed(0), mBlockSize(0) {}
+
+    // Alignment must be a power of two no larger than alignof(std::max_align_t)
+    void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        // Guard: budget exhausted
+        if (bytes > mCapacity - mUsed) {
+            return nullptr;
+        }
+
+        size_t aligned = (mBlockUsed + alignment - 1) & ~(alignment - 1);
+        if (mBlocks.empty() || aligned + bytes > mBlockSize) {
+            // Large requests get a dedicated block; small ones share 1 MB blocks
+            size_t blockSize = std::max(bytes, DEFAULT_BLOCK_SIZE);
+            mBlocks.emplace_back(new uint8_t[blockSize]);
+            mBlockSize = blockSize;
+            aligned = 0;
+        }
+
+        uint8_t* result = mBlocks.back().get() + aligned;
+        mBlockUsed = aligned + bytes;
+        mUsed += bytes;
+        return result;
+    }
+
+    template <typename T>
+    T* AllocateArray(size_t count) {
+        if (count > (mCapacity - mUsed) / sizeof(T)) {
+            return nullptr;
+        }
+        T* items = static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+        if (items != nullptr) {
+            for (size_t i = 0; i < count; ++i) {
+                new (items + i) T();
+            }
+        }
+        return items;
+    }
+
+    size_t GetUsed() const { return mUsed; }
+    size_t GetCapacity() const { return mCapacity; }
+
+    // Prevent copy/move
+    FbxArena(const FbxArena&) = delete;
+    FbxArena& operator=(const FbxArena&) = delete;
+    FbxArena(FbxArena&&) = delete;
+    FbxArena& operator=(FbxArena&&) = delete;
+
+private:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1u << 20;
+
+    std::vector<std::unique_ptr<uint8_t[]>> mBlocks;
+    size_t mCapacity;
+    size_t mUsed;
+    size_t mBlockUsed;
+    size_t mBlockSize;
+};
+
+// One property of a node record. Arrays point at their inflated elements once
+// decoding has run; uncompressed arrays point straight into the mapping.
+struct FbxProperty {
+    char type = 0;
+    const uint8_t* data = nullptr;
+    uint32_t size = 0;                // Bytes for S/R, element count for arrays
+    const uint8_t* packed = nullptr;  // zlib source for compressed arrays
+    uint32_t packedSize = 0;
+
+    bool IsArray() const { return type == 'f' || type == 'd' || type == 'l' || type == 'i' || type == 'b'; }
+
+    int64_t AsInt() const {
+        switch (type) {
+            case 'C': return data[0];
+            case 'Y': { int16_t v; std::memcpy(&v, data, 2); return v; }
+            case 'I': { int32_t v; std::memcpy(&v, data, 4); return v; }
+            case 'L': { int64_t v; std::memcpy(&v, data, 8); return v; }
+            case 'F': { float v; std::memcpy(&v, data, 4); return static_cast<int64_t>(v); }
+            case 'D': { double v; std::memcpy(&v, data, 8); return static_cast<int64_t>(v); }
+            default:  return 0;
+        }
+    }
+
+    double AsDouble() const {
+        switch (type) {
+            case 'F': { float v; std::memcpy(&v, data, 4); return v; }
+            case 'D': { double v; std::memcpy(&v, data, 8); return v; }
+            default:  return static_cast<double>(AsInt());
+        }
+    }
+
+    std::string_view AsString() const {
+        if (type != 'S' && type != 'R') {
+            return std::string_view();
+        }
+        return std::string_view(reinterpret_cast<const char*>(data), size);
+    }
+
+    // Element i of an array property, converted to double
+    double ArrayDouble(size_t i) const {
+        switch (type) {
+            case 'd': { double v; std::memcpy(&v, data + i * 8, 8); return v; }
+            case 'f': { float v; std::memcpy(&v, data + i * 4, 4); return v; }
+            case 'l': { int64_t v; std::memcpy(&v, data + i * 8, 8); return static_cast<double>(v); }
+            case 'i': { int32_t v; std::memcpy(&v, data + i * 4, 4); return v; }
+            case 'b': return data[i];
+            default:  return 0.0;
+        }
+    }
+
+    int64_t ArrayInt(size_t i) const {
+        switch (type) {
+            case 'i': { int32_t v; std::memcpy(&v, data + i * 4, 4); return v; }
+            case 'l': { int64_t v; std::memcpy(&v, data + i * 8, 8); return v; }
+            case 'b': return data[i];
+            default:  return static_cast<int64_t>(ArrayDouble(i));
+        }
+    }
+
+    static size_t ElementSize(char arrayType) {
+        switch (arrayType) {
+            case 'd': case 'l': return 8;
+            case 'f': case 'i': return 4;
+            case 'b':           return 1;
+            default:            return 0;
+        }
+    }
+};
+
+struct FbxNode {
+    std::string_view name;
+    FbxProperty* properties = nullptr;
+    uint32_t propertyCount = 0;
+    FbxNode* firstChild = nullptr;
+    FbxNode* nextSibling = nullptr;
+
+    const FbxNode* FindChild(std::string_view childName) const {
+        for (const FbxNode* child = firstChild; child != nullptr; child = child->nextSibling) {
+            if (child->name == childName) {
+                return child;
+            }
+        }
+        return nullptr;
+    }
+
+    const FbxProperty* Property(uint32_t index) const {
+        return index < propertyCount ? &properties[index] : nullptr;
+    }
+};
+
+struct FbxMaterial {
+    int64_t id = 0;
+    std::string name;
+    std::array<float, 3> diffuse = { 0.8f, 0.8f, 0.8f };
+};
+
+struct FbxModel {
+    int64_t id = 0;
+    std::string name;
+    int32_t parent = -1;
+    int32_t geometry = -1;              // Index into the parse-time geometry list, -1 for empty nodes
+    std::vector<uint32_t> materials;    // Material slots, in connection order
+    std::array<double, 16> local = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };     // Column-major
+    std::array<double, 16> world = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+    std::array<double, 16> geometric = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 }; // Not inherited by children
+};
+
+// Geometry of one model, triangulated and baked into world space
+struct FbxMeshInstance {
+    uint32_t model = 0;
+    SoftwareMesh mesh;
+    std::vector<uint32_t> triangleMaterials;    // Index into FbxScene::materials, UINT32_MAX if unbound
+};
+
+struct FbxScene {
+    uint32_t version = 0;
+    double unitScaleFactor = 1.0;   // Centimetres per file unit, as authored
+    int32_t upAxis = 1;
+    std::vector<FbxModel> models;
+    std::vector<FbxMaterial> materials;
+    std::vector<FbxMeshInstance> meshes;
+};
+
+struct FbxLoadOptions {
+    size_t arenaBytes;      // 0 = derive from file size
+    uint32_t workerCount;   // 0 = hardware concurrency
+
+    FbxLoadOptions() : arenaBytes(0), workerCount(0) {}
+};
+
+// FbxLoader - stateless entry points
+// Walks the node tree through a MappedFile and only materializes the records the
+// renderer needs (Objects/Geometry|Model|Material, Connections, GlobalSettings).
+// Everything else, including embedded textures and animation, is skipped by offset.
+// Compressed arrays inside kept records are inflated on worker threads straight into
+// arena buffers sized from the array header.
+class FbxLoader {
+public:
+    static bool IsFbxPath(const std::string& path) {
+        std::string ext = std::filesystem::path(path).extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return ext == ".fbx";
+    }
+
+    static bool Parse(const std::string& path, FbxScene& scene, std::string* error = nullptr,
+                      const FbxLoadOptions& options = FbxLoadOptions()) {
+        scene = FbxScene();
+
+        BrightForge::MappedFile file;
+        if (!file.Open(path)) {
+            return Fail(error, file.GetError());
+        }
+        return ParseMemory(file.Data(), file.Size(), scene, error, options);
+    }
+
+    static bool ParseMemory(const uint8_t* data, size_t size, FbxScene& scene, std::string* error = nullptr,
+                            const FbxLoadOptions& options = FbxLoadOptions()) {
+        scene = FbxScene();
+
+        if (size < FBX_HEADER_SIZE || std::memcmp(data, "Kaydara FBX Binary  \0", 21) != 0) {
+            return Fail(error, "not a binary FBX file (ASCII FBX is not supported)");
+        }
+        std::memcpy(&scene.version, data + FBX_MAGIC_SIZE, 4);
+
+        // Inflated arrays dominate; real files rarely exceed ~6x compression
+        size_t capacity = options.arenaBytes != 0 ? options.arenaBytes : size * 8 + ARENA_MIN_BYTES;
+        FbxArena arena(capacity);
+
+        Reader reader;
+        reader.data = data;
+        reader.size = size;
+        reader.wide = scene.version >= FBX_VERSION_64BIT_OFFSETS;
+        reader.arena = &arena;
+
+        FbxNode* root = nullptr;
+        if (!ReadNodeList(reader, FBX_HEADER_SIZE, size, nullptr, 0, root)) {
+            return Fail(error, reader.error.empty() ? "malformed FBX node tree" : reader.error);
+        }
+
+        if (!InflateArrays(reader.pendingArrays, options.workerCount, error)) {
+            return false;
+        }
+
+        return BuildScene(root, scene, options.workerCount, error);
+    }
+
+    // Parse + merge every mesh instance; used by SoftwareRenderService::LoadMesh
+    static bool Load(const std::string& path, SoftwareMesh& outMesh) {
+        FbxScene scene;
+        std::string error;
+        if (!Parse(path, scene, &error)) {
+            QuoteSystem::Instance().Log("FbxLoader: " + path + " - " + error,
+                QuoteSystem::MessageType::ERROR_MSG);
+            DebugWindow::Instance().Post("Renderer", "FBX parse failed: " + error, DebugWindow::DebugLevel::ERR);
+            return false;
+        }
+
+        size_t vertexTotal = 0;
+        size_t indexTotal = 0;
+        for (const FbxMeshInstance& instance : scene.meshes) {
+            vertexTotal += instance.mesh.vertices.size();
+            indexTotal += instance.mesh.indices.size();
+        }
+
+        outMesh.vertexStride = SOFTWARE_MESH_STRIDE;
+        outMesh.vertices.clear();
+        outMesh.indices.clear();
+        outMesh.vertices.reserve(vertexTotal);
+        outMesh.indices.reserve(indexTotal);
+        for (const FbxMeshInstance& instance : scene.meshes) {
+            uint32_t base = static_cast<uint32_t>(outMesh.vertices.size() / SOFTWARE_MESH_STRIDE);
+            outMesh.vertices.insert(outMesh.vertices.end(), instance.mesh.vertices.begin(), instance.mesh.vertices.end());
+            for (uint32_t index : instance.mesh.indices) {
+                outMesh.indices.push_back(base + index);
+            }
+        }
+
+        DebugWindow::Instance().Post("Renderer", "FBX loaded: " + path + " (" +
+            std::to_string(scene.meshes.size()) + " meshes, " +
+            std::to_string(outMesh.indices.size() / 3) + " tris)", DebugWindow::DebugLevel::INFO);
+        return true;
+    }
+
+    // Correctness checks against small generated files
+    static void RegisterTests() {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        tests.RegisterSuite("FbxLoader");
+
+        for (uint32_t version : { 7400u, 7500u }) {
+            tests.AddTest("FbxLoader", "Quad + triangle (v" + std::to_string(version) + ")", [version]() {
+                std::vector<uint8_t> file = BuildTestFile(version);
+                FbxScene scene;
+                std::string error;
+                if (!ParseMemory(file.data(), file.size(), scene, &error) || scene.meshes.size() != 1) {
+                    return false;
+                }
+
+                const FbxMeshInstance& instance = scene.meshes[0];
+                bool ok = instance.mesh.vertices.size() == 7 * SOFTWARE_MESH_STRIDE &&
+                          instance.mesh.indices.size() == 9 &&
+                          instance.triangleMaterials.size() == 3 &&
+                          instance.triangleMaterials[0] == 0 &&
+                          scene.materials.size() == 1 && scene.materials[0].name == "Red";
+
+                // Model translation (10, 0, 0) is baked into positions; normals stay +Z
+                ok = ok && std::fabs(instance.mesh.vertices[0] - 10.0f) < 1e-5f &&
+                     std::fabs(instance.mesh.vertices[5] - 1.0f) < 1e-5f;
+                return ok;
+            });
+        }
+
+        tests.AddTest("FbxLoader", "Arena budget is enforced", []() {
+            std::vector<uint8_t> file = BuildTestFile(7400);
+            FbxScene scene;
+            FbxLoadOptions options;
+            options.arenaBytes = 256;
+            return !ParseMemory(file.data(), file.size(), scene, nullptr, options);
+        });
+
+        tests.AddTest("FbxLoader", "Rejects truncated file", []() {
+            std::vector<uint8_t> file = BuildTestFile(7400);
+            file.resize(file.size() / 2);
+            FbxScene scene;
+            return !ParseMemory(file.data(), file.size(), scene);
+        });
+    }
+
+    // Prevent instantiation (static API)
+    FbxLoader() = delete;
+
+private:
+    static constexpr size_t ARENA_MIN_BYTES = 16u << 20;
+    static constexpr size_t MAX_NODE_DEPTH = 64;
+    static constexpr uint32_t NO_MATERIAL = UINT32_MAX;
+
+    using Matrix4 = std::array<double, 16>;
+
+    struct Reader {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        bool wide = false;
+        FbxArena* arena = nullptr;
+        std::vector<FbxProperty*> pendingArrays;
+        std::string error;
+    };
+
+    static bool Fail(std::string* error, const std::string& message) {
+        if (error != nullptr) {
+            *error = message;
+        }
+        return false;
+    }
+
+    template <typename T>
+    static T ReadScalar(const uint8_t* p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        return value;
+    }
+
+    // ---- Node tree ---------------------------------------------------------
+
+    // Which records to materialize, keyed on the parent record's name
+    static bool IsWanted(const FbxNode* parent, std::string_view name) {
+        if (parent == nullptr) {
+            return name == "Objects" || name == "Connections" || name == "GlobalSettings";
+        }
+
+        std::string_view p = parent->name;
+        if (p == "Objects") {
+            return name == "Geometry" || name == "Model" || name == "Material";
+        }
+        if (p == "Geometry") {
+            return name == "Vertices" || name == "PolygonVertexIndex" || name == "LayerElementNormal" ||
+                   name == "LayerElementUV" || name == "LayerElementMaterial";
+        }
+        if (p == "Model" || p == "Material" || p == "GlobalSettings") {
+            return name == "Properties70";
+        }
+        if (p == "Properties70") {
+            return name == "P";
+        }
+        if (p == "Connections") {
+            return name == "C";
+        }
+        return p.compare(0, 12, "LayerElement") == 0;
+    }
+
+    static bool ReadNodeList(Reader& reader, size_t offset, size_t end, FbxNode* parent,
+                             size_t depth, FbxNode*& outFirst) {
+        // Guard: runaway nesting
+        if (depth > MAX_NODE_DEPTH) {
+            reader.error = "FBX node nesting too deep";
+            return false;
+        }
+
+        size_t headerSize = reader.wide ? 25 : 13;
+        FbxNode* last = nullptr;
+        outFirst = nullptr;
+
+        while (offset + headerSize <= end) {
+            const uint8_t* p = reader.data + offset;
+            uint64_t endOffset = reader.wide ? ReadScalar<uint64_t>(p) : ReadScalar<uint32_t>(p);
+            uint64_t propertyCount = reader.wide ? ReadScalar<uint64_t>(p + 8) : ReadScalar<uint32_t>(p + 4);
+            uint64_t propertyBytes = reader.wide ? ReadScalar<uint64_t>(p + 16) : ReadScalar<uint32_t>(p + 8);
+            uint8_t nameLength = p[headerSize - 1];
+
+            // Null record terminates the list
+            if (endOffset == 0) {
+                return true;
+            }
+
+            size_t nameStart = offset + headerSize;
+            size_t propertyStart = nameStart + nameLength;
+            if (endOffset > end || endOffset <= offset || propertyStart + propertyBytes > endOffset) {
+                reader.error = "FBX record at offset " + std::to_string(offset) + " overruns its parent";
+                return false;
+            }
+
+            std::string_view name(reinterpret_cast<const char*>(reader.data + nameStart), nameLength);
+            if (IsWanted(parent, name)) {
+                FbxNode* node = reader.arena->AllocateArray<FbxNode>(1);
+                FbxProperty* properties = reader.arena->AllocateArray<FbxProperty>(static_cast<size_t>(propertyCount));
+                if (node == nullptr || (propertyCount > 0 && properties == nullptr)) {
+                    reader.error = "FBX arena budget exceeded";
+                    return false;
+                }
+
+                node->name = name;
+                node->properties = properties;
+                node->propertyCount = static_cast<uint32_t>(propertyCount);
+                if (!ReadProperties(reader, propertyStart, propertyStart + propertyBytes, *node)) {
+                    return false;
+                }
+
+                size_t childStart = propertyStart + propertyBytes;
+                if (childStart < endOffset &&
+                    !ReadNodeList(reader, childStart, endOffset, node, depth + 1, node->firstChild)) {
+                    return false;
+                }
+
+                if (last == nullptr) {
+                    outFirst = node;
+                } else {
+                    last->nextSibling = node;
+                }
+                last = node;
+            }
+
+            offset = static_cast<size_t>(endOffset);
+        }
+
+        // Top level may end at EOF (the footer follows the last null record)
+        return parent == nullptr || offset == end;
+    }
+
+    static bool ReadProperties(Reader& reader, size_t offset, size_t end, FbxNode& node) {
+        for (uint32_t i = 0; i < node.propertyCount; ++i) {
+            if (offset >= end) {
+                reader.error = "FBX property list truncated";
+                return false;
+            }
+
+            FbxProperty& property = node.properties[i];
+            property.type = static_cast<char>(reader.data[offset++]);
+            size_t remaining = end - offset;
+            const uint8_t* p = reader.data + offset;
+
+            size_t scalarSize = 0;
+            switch (property.type) {
+                case 'C':           scalarSize = 1; break;
+                case 'Y':           scalarSize = 2; break;
+                case 'I': case 'F': scalarSize = 4; break;
+                case 'L': case 'D': scalarSize = 8; break;
+                default:            break;
+            }
+
+            if (scalarSize > 0) {
+                if (remaining < scalarSize) {
+                    reader.error = "FBX scalar property truncated";
+                    return false;
+                }
+                property.data = p;
+                offset += scalarSize;
+                continue;
+            }
+
+            if (property.type == 'S' || property.type == 'R') {
+                if (remaining < 4 || remaining - 4 < ReadScalar<uint32_t>(p)) {
+                    reader.error = "FBX string property truncated";
+                    return false;
+                }
+                property.size = ReadScalar<uint32_t>(p);
+                property.data = p + 4;
+                offset += 4 + property.size;
+                continue;
+            }
+
+            size_t elementSize = FbxProperty::ElementSize(property.type);
+            if (elementSize == 0 || remaining < 12) {
+                reader.error = "FBX property has unknown type '" + std::string(1, property.type) + "'";
+                return false;
+            }
+
+            uint32_t count = ReadScalar<uint32_t>(p);
+            uint32_t encoding = ReadScalar<uint32_t>(p + 4);
+            uint32_t stored = ReadScalar<uint32_t>(p + 8);
+            if (remaining - 12 < stored) {
+                reader.error = "FBX array property truncated";
+                return false;
+            }
+
+            property.size = count;
+            if (encoding == 0) {
+                if (stored != static_cast<uint64_t>(count) * elementSize) {
+                    reader.error = "FBX array length mismatch";
+                    return false;
+                }
+                property.data = p + 12;
+            } else if (encoding == 1) {
+                // Destination is reserved now so inflation can run in parallel later
+                uint8_t* destination = static_cast<uint8_t*>(reader.arena->Allocate(count * elementSize, 8));
+                if (destination == nullptr && count > 0) {
+                    reader.error = "FBX arena budget exceeded";
+                    return false;
+                }
+                property.data = destination;
+                property.packed = p + 12;
+                property.packedSize = stored;
+                reader.pendingArrays.push_back(&property);
+            } else {
+                reader.error = "FBX array uses unknown encoding " + std::to_string(encoding);
+                return false;
+            }
+            offset += 12 + stored;
+        }
+        return true;
+    }
+
+    // ---- Parallel work -----------------------------------------------------
+
+    static bool InflateArrays(std::vector<FbxProperty*>& arrays, uint32_t workerCount, std::string* error) {
+        // Largest first keeps one big vertex array from serializing the tail
+        std::sort(arrays.begin(), arrays.end(), [](const FbxProperty* a, const FbxProperty* b) {
+            return a->packedSize > b->packedSize;
+        });
+
+        std::atomic<bool> failed(false);
+        Parallel::For(arrays.size(), [&](size_t i) {
+            FbxProperty& property = *arrays[i];
+            size_t expected = static_cast<size_t>(property.size) * FbxProperty::ElementSize(property.type);
+            size_t written = 0;
+            uint8_t* destination = const_cast<uint8_t*>(property.data);
+            if (!BrightForge::Inflate::DecompressZlib(property.packed, property.packedSize,
+                                                      destination, expected, &written) ||
+                written != expected) {
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }, workerCount);
+
+        if (failed.load()) {
+            return Fail(error, "FBX compressed array failed to inflate");
+        }
+        return true;
+    }
+
+    // ---- Scene -------------------------------------------------------------
+
+    // "Name\0\1Class" -> "Name"
+    static std::string ObjectName(const FbxNode& node) {
+        const FbxProperty* property = node.Property(1);
+        std::string_view name = property != nullptr ? property->AsString() : std::string_view();
+        size_t separator = name.find(std::string_view("\0\1", 2));
+        return std::string(separator == std::string_view::npos ? name : name.substr(0, separator));
+    }
+
+    static int64_t ObjectId(const FbxNode& node) {
+        const FbxProperty* property = node.Property(0);
+        return property != nullptr ? property->AsInt() : 0;
+    }
+
+    // Find a Properties70 entry; values start at property index 4
+    static const FbxNode* FindP(const FbxNode& object, std::string_view name) {
+        const FbxNode* properties = object.FindChild("Properties70");
+        if (properties == nullptr) {
+            return nullptr;
+        }
+        for (const FbxNode* p = properties->firstChild; p != nullptr; p = p->nextSibling) {
+            const FbxProperty* key = p->Property(0);
+            if (key != nullptr && key->AsString() == name) {
+                return p;
+            }
+        }
+        return nullptr;
+    }
+
+    static std::array<double, 3> ReadVector(const FbxNode& object, std::string_view name, double fallback) {
+        std::array<double, 3> value = { fallback, fallback, fallback };
+        const FbxNode* p = FindP(object, name);
+        if (p != nullptr && p->propertyCount >= 7) {
+            for (uint32_t i = 0; i < 3; ++i) {
+                value[i] = p->properties[4 + i].AsDouble();
+            }
+        }
+        return value;
+    }
+
+    static bool BuildScene(const FbxNode* root, FbxScene& scene, uint32_t workerCount, std::string* error) {
+        const FbxNode* objects = nullptr;
+        const FbxNode* connections = nullptr;
+        for (const FbxNode* node = root; node != nullptr; node = node->nextSibling) {
+            if (node->name == "Objects") objects = node;
+            else if (node->name == "Connections") connections = node;
+            else if (node->name == "GlobalSettings") {
+                const FbxNode* unit = FindP(*node, "UnitScaleFactor");
+                if (unit != nullptr && unit->propertyCount >= 5) {
+                    scene.unitScaleFactor = unit->properties[4].AsDouble();
+                }
+                const FbxNode* up = FindP(*node, "UpAxis");
+                if (up != nullptr && up->propertyCount >= 5) {
+                    scene.upAxis = static_cast<int32_t>(up->properties[4].AsInt());
+                }
+            }
+        }
+
+        // Guard: files without objects are valid but empty
+        if (objects == nullptr) {
+            return true;
+        }
+
+        std::vector<const FbxNode*> geometries;
+        std::unordered_map<int64_t, uint32_t> geometryById;
+        std::unordered_map<int64_t, uint32_t> modelById;
+        std::unordered_map<int64_t, uint32_t> materialById;
+
+        for (const FbxNode* object = objects->firstChild; object != nullptr; object = object->nextSibling) {
+            int64_t id = ObjectId(*object);
+            if (object->name == "Geometry") {
+                const FbxProperty* type = object->Property(2);
+                if (type != nullptr && type->AsString() == "Mesh") {
+                    geometryById[id] = static_cast<uint32_t>(geometries.size());
+                    geometries.push_back(object);
+                }
+            } else if (object->name == "Model") {
+                FbxModel model;
+                model.id = id;
+                model.name = ObjectName(*object);
+                model.local = LocalTransform(*object);
+                model.geometric = ComposeTrs(ReadVector(*object, "GeometricTranslation", 0.0),
+                                             ReadVector(*object, "GeometricRotation", 0.0), 0,
+                                             ReadVector(*object, "GeometricScaling", 1.0));
+                modelById[id] = static_cast<uint32_t>(scene.models.size());
+                scene.models.push_back(std::move(model));
+            } else if (object->name == "Material") {
+                FbxMaterial material;
+                material.id = id;
+                material.name = ObjectName(*object);
+                std::array<double, 3> diffuse = ReadVector(*object, "DiffuseColor", 0.8);
+                material.diffuse = { static_cast<float>(diffuse[0]), static_cast<float>(diffuse[1]),
+                                     static_cast<float>(diffuse[2]) };
+                materialById[id] = static_cast<uint32_t>(scene.materials.size());
+                scene.materials.push_back(std::move(material));
+            }
+        }
+
+        // Object-object connections: geometry->model, material->model, model->parent model
+        if (connections != nullptr) {
+            for (const FbxNode* c = connections->firstChild; c != nullptr; c = c->nextSibling) {
+                if (c->propertyCount < 3 || c->properties[0].AsString() != "OO") {
+                    continue;
+                }
+                int64_t child = c->properties[1].AsInt();
+                int64_t parent = c->properties[2].AsInt();
+
+                auto model = modelById.find(parent);
+                if (model == modelById.end()) {
+                    continue;
+                }
+                FbxModel& target = scene.models[model->second];
+
+                if (auto geometry = geometryById.find(child); geometry != geometryById.end()) {
+                    target.geometry = static_cast<int32_t>(geometry->second);
+                } else if (auto material = materialById.find(child); material != materialById.end()) {
+                    target.materials.push_back(material->second);
+                } else if (auto childModel = modelById.find(child); childModel != modelById.end()) {
+                    scene.models[childModel->second].parent = static_cast<int32_t>(model->second);
+                }
+            }
+        }
+
+        for (size_t m = 0; m < scene.models.size(); ++m) {
+            scene.models[m].world = WorldTransform(scene.models, m);
+        }
+
+        // Triangulate every model that owns geometry, one task per model
+        std::vector<uint32_t> meshModels;
+        for (uint32_t m = 0; m < scene.models.size(); ++m) {
+            if (scene.models[m].geometry >= 0) {
+                meshModels.push_back(m);
+            }
+        }
+
+        scene.meshes.resize(meshModels.size());
+        std::atomic<bool> failed(false);
+        Parallel::For(meshModels.size(), [&](size_t i) {
+            const FbxModel& model = scene.models[meshModels[i]];
+            scene.meshes[i].model = meshModels[i];
+            if (!BuildMesh(*geometries[model.geometry], model, scene.meshes[i])) {
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }, workerCount);
+
+        if (failed.load()) {
+            return Fail(error, "FBX geometry references out-of-range vertices or layer elements");
+        }
+        return true;
+    }
+
+    // Index of the layer element for one polygon corner, or -1. `mappingOnly` skips the
+    // reference step, for material layers whose Materials array is itself the index array.
+    static int64_t LayerIndex(const FbxNode& layer, const FbxProperty* indexArray, size_t corner,
+                              int64_t controlPoint, size_t polygon, bool mappingOnly = false) {
+        const FbxNode* mappingNode = layer.FindChild("MappingInformationType");
+        const FbxNode* referenceNode = layer.FindChild("ReferenceInformationType");
+        std::string_view mapping = mappingNode != nullptr && mappingNode->propertyCount > 0
+            ? mappingNode->properties[0].AsString() : std::string_view("ByPolygonVertex");
+        std::string_view reference = referenceNode != nullptr && referenceNode->propertyCount > 0
+            ? referenceNode->properties[0].AsString() : std::string_view("Direct");
+
+        int64_t index = 0;
+        if (mapping == "ByPolygonVertex") index = static_cast<int64_t>(corner);
+        else if (mapping == "ByVertex" || mapping == "ByVertice" || mapping == "ByControlPoint") index = controlPoint;
+        else if (mapping == "ByPolygon") index = static_cast<int64_t>(polygon);
+        else if (mapping == "AllSame") index = 0;
+        else return -1;
+
+        if (!mappingOnly && (reference == "IndexToDirect" || reference == "Index")) {
+            if (indexArray == nullptr || index < 0 || static_cast<size_t>(index) >= indexArray->size) {
+                return -1;
+            }
+            index = indexArray->ArrayInt(static_cast<size_t>(index));
+        }
+        return index;
+    }
+
+    static const FbxProperty* ArrayOf(const FbxNode* node, std::string_view childName) {
+        const FbxNode* child = node != nullptr ? node->FindChild(childName) : nullptr;
+        const FbxProperty* property = child != nullptr ? child->Property(0) : nullptr;
+        return property != nullptr && property->IsArray() ? property : nullptr;
+    }
+
+    static bool BuildMesh(const FbxNode& geometry, const FbxModel& model, FbxMeshInstance& out) {
+        const FbxProperty* positions = ArrayOf(&geometry, "Vertices");
+        const FbxProperty* polygons = ArrayOf(&geometry, "PolygonVertexIndex");
+        if (positions == nullptr || polygons == nullptr) {
+            return true;    // Empty geometry
+        }
+
+        // Only the first layer of each kind is used
+        const FbxNode* normalLayer = geometry.FindChild("LayerElementNormal");
+        const FbxNode* uvLayer = geometry.FindChild("LayerElementUV");
+        const FbxNode* materialLayer = geometry.FindChild("LayerElementMaterial");
+        const FbxProperty* normals = ArrayOf(normalLayer, "Normals");
+        const FbxProperty* normalIndices = ArrayOf(normalLayer, "NormalsIndex");
+        const FbxProperty* uvs = ArrayOf(uvLayer, "UV");
+        const FbxProperty* uvIndices = ArrayOf(uvLayer, "UVIndex");
+        const FbxProperty* materials = ArrayOf(materialLayer, "Materials");
+
+        size_t controlPoints = positions->size / 3;
+        size_t corners = polygons->size;
+
+        // Count triangles up front so output is sized once
+        size_t triangles = 0;
+        size_t polygonSize = 0;
+        for (size_t c = 0; c < corners; ++c) {
+            ++polygonSize;
+            if (polygons->ArrayInt(c) < 0) {
+                triangles += polygonSize >= 3 ? polygonSize - 2 : 0;
+                polygonSize = 0;
+            }
+        }
+
+        SoftwareMesh& mesh = out.mesh;
+        mesh.vertexStride = SOFTWARE_MESH_STRIDE;
+        mesh.vertices.assign(corners * SOFTWARE_MESH_STRIDE, 0.0f);
+        mesh.indices.clear();
+        mesh.indices.reserve(triangles * 3);
+        out.triangleMaterials.clear();
+        out.triangleMaterials.reserve(triangles);
+
+        Matrix4 transform = Multiply(model.world, model.geometric);
+        Matrix4 normalMatrix = NormalMatrix(transform);
+
+        size_t polygon = 0;
+        size_t polygonStart = 0;
+        for (size_t c = 0; c < corners; ++c) {
+            int64_t raw = polygons->ArrayInt(c);
+            bool lastCorner = raw < 0;
+            int64_t controlPoint = lastCorner ? ~raw : raw;
+            if (controlPoint < 0 || static_cast<size_t>(controlPoint) >= controlPoints) {
+                return false;
+            }
+
+            // One output vertex per polygon corner; FBX normals/UVs are usually per corner
+            float* v = mesh.vertices.data() + c * SOFTWARE_MESH_STRIDE;
+            double p[3] = { positions->ArrayDouble(controlPoint * 3), positions->ArrayDouble(controlPoint * 3 + 1),
+                            positions->ArrayDouble(controlPoint * 3 + 2) };
+            for (int r = 0; r < 3; ++r) {
+                v[r] = static_cast<float>(transform[r] * p[0] + transform[4 + r] * p[1] + transform[8 + r] * p[2] + transform[12 + r]);
+            }
+
+            if (normals != nullptr) {
+                int64_t n = LayerIndex(*normalLayer, normalIndices, c, controlPoint, polygon);
+                if (n < 0 || static_cast<size_t>(n) * 3 + 2 >= normals->size) {
+                    return false;
+                }
+                double nx = normals->ArrayDouble(n * 3), ny = normals->ArrayDouble(n * 3 + 1), nz = normals->ArrayDouble(n * 3 + 2);
+                double t[3];
+                for (int r = 0; r < 3; ++r) {
+                    t[r] = normalMatrix[r] * nx + normalMatrix[4 + r] * ny + normalMatrix[8 + r] * nz;
+                }
+                double length = std::sqrt(t[0] * t[0] + t[1] * t[1] + t[2] * t[2]);
+                if (length > 0.0) {
+                    v[3] = static_cast<float>(t[0] / length);
+                    v[4] = static_cast<float>(t[1] / length);
+                    v[5] = static_cast<float>(t[2] / length);
+                }
+            }
+
+            if (uvs != nullptr) {
+                int64_t u = LayerIndex(*uvLayer, uvIndices, c, controlPoint, polygon);
+                if (u < 0 || static_cast<size_t>(u) * 2 + 1 >= uvs->size) {
+                    return false;
+                }
+                // FBX UV origin is bottom-left; flip to match the glTF path
+                v[6] = static_cast<float>(uvs->ArrayDouble(u * 2));
+                v[7] = static_cast<float>(1.0 - uvs->ArrayDouble(u * 2 + 1));
+            }
+
+            if (!lastCorner) {
+                continue;
+            }
+
+            // Fan-triangulate the finished polygon
+            uint32_t material = NO_MATERIAL;
+            if (materials != nullptr) {
+                int64_t slot = LayerIndex(*materialLayer, nullptr, c, controlPoint, polygon, true);
+                if (slot >= 0 && static_cast<size_t>(slot) < materials->size) {
+                    int64_t bound = materials->ArrayInt(static_cast<size_t>(slot));
+                    if (bound >= 0 && static_cast<size_t>(bound) < model.materials.size()) {
+                        material = model.materials[static_cast<size_t>(bound)];
+                    }
+                }
+            } else if (!model.materials.empty()) {
+                material = model.materials[0];
+            }
+
+            for (size_t k = polygonStart + 1; k + 1 <= c; ++k) {
+                mesh.indices.push_back(static_cast<uint32_t>(polygonStart));
+                mesh.indices.push_back(static_cast<uint32_t>(k));
+                mesh.indices.push_back(static_cast<uint32_t>(k + 1));
+                out.triangleMaterials.push_back(material);
+            }
+
+            polygonStart = c + 1;
+            ++polygon;
+        }
+
+        // Faceted normals for files exported without a normal layer
+        if (normals == nullptr) {
+            for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+                float* a = mesh.vertices.data() + mesh.indices[i] * SOFTWARE_MESH_STRIDE;
+                float* b = mesh.vertices.data() + mesh.indices[i + 1] * SOFTWARE_MESH_STRIDE;
+                float* c = mesh.vertices.data() + mesh.indices[i + 2] * SOFTWARE_MESH_STRIDE;
+                float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+                float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+                float face[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+                for (float* v : { a, b, c }) {
+                    v[3] += face[0];
+                    v[4] += face[1];
+                    v[5] += face[2];
+                }
+            }
+            for (size_t i = 0; i < corners; ++i) {
+                float* v = mesh.vertices.data() + i * SOFTWARE_MESH_STRIDE;
+                float length = std::sqrt(v[3] * v[3] + v[4] * v[4] + v[5] * v[5]);
+                if (length > 0.0f) {
+                    v[3] /= length;
+                    v[4] /= length;
+                    v[5] /= length;
+                }
+            }
+        }
+        return true;
+    }
+
+    // ---- Transforms --------------------------------------------------------
+
+    // Simplified FBX transform chain: T * Rpre * R * Rpost^-1 * S
+    // (pivots and offsets are ignored; exporters bake them for static meshes)
+    static Matrix4 LocalTransform(const FbxNode& model) {
+        int order = 0;
+        const FbxNode* rotationOrder = FindP(model, "RotationOrder");
+        if (rotationOrder != nullptr && rotationOrder->propertyCount >= 5) {
+            order = static_cast<int>(rotationOrder->properties[4].AsInt());
+        }
+
+        std::array<double, 3> translation = ReadVector(model, "Lcl Translation", 0.0);
+        std::array<double, 3> rotation = ReadVector(model, "Lcl Rotation", 0.0);
+        std::array<double, 3> scale = ReadVector(model, "Lcl Scaling", 1.0);
+
+        std::array<double, 3> zero = { 0.0, 0.0, 0.0 };
+        std::array<double, 3> one = { 1.0, 1.0, 1.0 };
+        Matrix4 pre = ComposeTrs(zero, ReadVector(model, "PreRotation", 0.0), 0, one);
+        Matrix4 post = ComposeTrs(zero, ReadVector(model, "PostRotation", 0.0), 0, one);
+
+        // Common case: no pre/post rotation, so the plain TRS composition is exact
+        if (IsIdentity(pre) && IsIdentity(post)) {
+            return ComposeTrs(translation, rotation, order, scale);
+        }
+
+        // Rotation matrices are orthonormal, so Rpost^-1 is its transpose
+        Matrix4 t = ComposeTrs(translation, zero, 0, one);
+        Matrix4 r = ComposeTrs(zero, rotation, order, one);
+        Matrix4 s = ComposeTrs(zero, zero, 0, scale);
+        return Multiply(Multiply(Multiply(t, pre), Multiply(r, Transpose(post))), s);
+    }
+
+    static Matrix4 WorldTransform(const std::vector<FbxModel>& models, size_t index) {
+        Matrix4 world = models[index].local;
+        int32_t parent = models[index].parent;
+        for (size_t depth = 0; parent >= 0 && depth < models.size(); ++depth) {
+            world = Multiply(models[parent].local, world);
+            parent = models[parent].parent;
+        }
+        return world;
+    }
+
+    // Euler angles in degrees; order follows FbxEuler::EOrder (0 = XYZ: X applied first)
+    static Matrix4 ComposeTrs(const std::array<double, 3>& t, const std::array<double, 3>& r, int order,
+                              const std::array<double, 3>& s) {
+        static constexpr int ORDERS[6][3] = { {0,1,2}, {0,2,1}, {1,2,0}, {1,0,2}, {2,0,1}, {2,1,0} };
+        const int* axes = ORDERS[(order >= 0 && order < 6) ? order : 0];
+
+        Matrix4 rotation = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+        for (int i = 0; i < 3; ++i) {
+            int axis = axes[i];
+            double radians = r[axis] * 3.14159265358979323846 / 180.0;
+            double c = std::cos(radians);
+            double sn = std::sin(radians);
+            Matrix4 step = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+            int a = (axis + 1) % 3;
+            int b = (axis + 2) % 3;
+            step[a * 4 + a] = c;
+            step[a * 4 + b] = sn;
+            step[b * 4 + a] = -sn;
+            step[b * 4 + b] = c;
+            rotation = Multiply(step, rotation);
+        }
+
+        Matrix4 m = rotation;
+        for (int col = 0; col < 3; ++col) {
+            for (int row = 0; row < 3; ++row) {
+                m[col * 4 + row] *= s[col];
+            }
+        }
+        m[12] = t[0];
+        m[13] = t[1];
+        m[14] = t[2];
+        return m;
+    }
+
+    static Matrix4 Multiply(const Matrix4& a, const Matrix4& b) {
+        Matrix4 out{};
+        for (int col = 0; col < 4; ++col) {
+            for (int row = 0; row < 4; ++row) {
+                double sum = 0.0;
+                for (int k = 0; k < 4; ++k) {
+                    sum += a[k * 4 + row] * b[col * 4 + k];
+                }
+                out[col * 4 + row] = sum;
+            }
+        }
+        return out;
+    }
+
+    static Matrix4 Transpose(const Matrix4& m) {
+        Matrix4 out{};
+        for (int col = 0; col < 4; ++col) {
+            for (int row = 0; row < 4; ++row) {
+                out[col * 4 + row] = m[row * 4 + col];
+            }
+        }
+        return out;
+    }
+
+    // Cofactor of the upper 3x3: the inverse-transpose up to scale, so normals survive non-uniform scale
+    static Matrix4 NormalMatrix(const Matrix4& m) {
+        Matrix4 n = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+        n[0] = m[5] * m[10] - m[6] * m[9];
+        n[1] = m[6] * m[8] - m[4] * m[10];
+        n[2] = m[4] * m[9] - m[5] * m[8];
+        n[4] = m[9] * m[2] - m[10] * m[1];
+        n[5] = m[10] * m[0] - m[8] * m[2];
+        n[6] = m[8] * m[1] - m[9] * m[0];
+        n[8] = m[1] * m[6] - m[2] * m[5];
+        n[9] = m[2] * m[4] - m[0] * m[6];
+        n[10] = m[0] * m[5] - m[1] * m[4];
+        return n;
+    }
+
+    static bool IsIdentity(const Matrix4& m) {
+        for (int i = 0; i < 16; ++i) {
+            if (std::fabs(m[i] - ((i % 5 == 0) ? 1.0 : 0.0)) > 1e-12) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // ---- Test fixture ------------------------------------------------------
+
+    // Minimal writer for the built-in tests: one quad + one triangle under a translated
+    // model, per-corner normals, one material. Arrays are stored as zlib streams made of
+    // stored deflate blocks so the inflate path runs without needing a compressor.
+    class TestWriter {
+    public:
+        explicit TestWriter(uint32_t version) : mWide(version >= FBX_VERSION_64BIT_OFFSETS) {
+            const char magic[FBX_MAGIC_SIZE] = "Kaydara FBX Binary  \0\x1A";
+            mBytes.assign(magic, magic + FBX_MAGIC_SIZE);
+            Put(version);
+        }
+
+        void Begin(const std::string& name) {
+            mOpen.push_back({ mBytes.size(), 0, 0, false, 0 });
+            size_t header = mWide ? 24 : 12;
+            mBytes.resize(mBytes.size() + header, 0);
+            mBytes.push_back(static_cast<uint8_t>(name.size()));
+            mBytes.insert(mBytes.end(), name.begin(), name.end());
+            mOpen.back().propertyStart = mBytes.size();
+        }
+
+        void Int64(int64_t v) { Property('L'); Put(v); }
+        void Int32(int32_t v) { Property('I'); Put(v); }
+        void Double(double v) { Property('D'); Put(v); }
+        void String(const std::string& s) {
+            Property('S');
+            Put(static_cast<uint32_t>(s.size()));
+            mBytes.insert(mBytes.end(), s.begin(), s.end());
+        }
+
+        template <typename T>
+        void Array(char type, const std::vector<T>& values) {
+            Property(type);
+            std::vector<uint8_t> raw(values.size() * sizeof(T));
+            std::memcpy(raw.data(), values.data(), raw.size());
+            std::vector<uint8_t> packed = StoredZlib(raw);
+            Put(static_cast<uint32_t>(values.size()));
+            Put(static_cast<uint32_t>(1));
+            Put(static_cast<uint32_t>(packed.size()));
+            mBytes.insert(mBytes.end(), packed.begin(), packed.end());
+        }
+
+        void End() {
+            Open node = mOpen.back();
+            mOpen.pop_back();
+            if (node.hasChildren) {
+                mBytes.resize(mBytes.size() + (mWide ? 25 : 13), 0);
+            }
+            Patch(node.start, mBytes.size(), node.propertyCount,
+                  (node.hasChildren ? node.childStart : mBytes.size()) - node.propertyStart);
+        }
+
+        // Call before writing the first child of the innermost open node
+        void Children() {
+            mOpen.back().hasChildren = true;
+            mOpen.back().childStart = mBytes.size();
+        }
+
+        std::vector<uint8_t> Finish() {
+            mBytes.resize(mBytes.size() + (mWide ? 25 : 13), 0);
+            return mBytes;
+        }
+
+    private:
+        struct Open {
+            size_t start;
+            size_t propertyStart;
+            uint64_t propertyCount;
+            bool hasChildren;
+            size_t childStart;
+        };
+
+        template <typename T>
+        void Put(T value) {
+            uint8_t bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            mBytes.insert(mBytes.end(), bytes, bytes + sizeof(T));
+        }
+
+        void Property(char type) {
+            ++mOpen.back().propertyCount;
+            mBytes.push_back(static_cast<uint8_t>(type));
+        }
+
+        void Patch(size_t at, uint64_t end, uint64_t count, uint64_t propertyBytes) {
+            if (mWide) {
+                std::memcpy(&mBytes[at], &end, 8);
+                std::memcpy(&mBytes[at + 8], &count, 8);
+                std::memcpy(&mBytes[at + 16], &propertyBytes, 8);
+            } else {
+                uint32_t narrow[3] = { static_cast<uint32_t>(end), static_cast<uint32_t>(count),
+                                       static_cast<uint32_t>(propertyBytes) };
+                std::memcpy(&mBytes[at], narrow, 12);
+            }
+        }
+
+        static std::vector<uint8_t> StoredZlib(const std::vector<uint8_t>& raw) {
+            std::vector<uint8_t> out = { 0x78, 0x01 };
+            size_t offset = 0;
+            do {
+                size_t chunk = std::min<size_t>(raw.size() - offset, 65535);
+                bool last = offset + chunk == raw.size();
+                out.push_back(last ? 1 : 0);
+                out.push_back(static_cast<uint8_t>(chunk & 0xFF));
+                out.push_back(static_cast<uint8_t>(chunk >> 8));
+                out.push_back(static_cast<uint8_t>(~chunk & 0xFF));
+                out.push_back(static_cast<uint8_t>((~chunk >> 8) & 0xFF));
+                out.insert(out.end(), raw.begin() + offset, raw.begin() + offset + chunk);
+                offset += chunk;
+            } while (offset < raw.size());
+
+            uint32_t adler = BrightForge::Inflate::Adler32(raw.data(), raw.size());
+            out.push_back(static_cast<uint8_t>(adler >> 24));
+            out.push_back(static_cast<uint8_t>(adler >> 16));
+            out.push_back(static_cast<uint8_t>(adler >> 8));
+            out.push_back(static_cast<uint8_t>(adler));
+            return out;
+        }
+
+        std::vector<uint8_t> mBytes;
+        std::vector<Open> mOpen;
+        bool mWide;
+    };
+
+    static void WriteP(TestWriter& w, const std::string& name, double x, double y, double z) {
+        w.Begin("P");
+        w.String(name);
+        w.String("Lcl Translation");
+        w.String("");
+        w.String("A");
+        w.Double(x);
+        w.Double(y);
+        w.Double(z);
+        w.End();
+    }
+
+    static std::vector<uint8_t> BuildTestFile(uint32_t version) {
+        TestWriter w(version);
+
+        w.Begin("Objects");
+        w.Children();
+
+        w.Begin("Geometry");
+        w.Int64(100);
+        w.String(std::string("Shape\0\1Geometry", 16));
+        w.String("Mesh");
+        w.Children();
+        w.Begin("Vertices");
+        w.Array<double>('d', { 0,0,0, 1,0,0, 1,1,0, 0,1,0, 2,0,0 });
+        w.End();
+        w.Begin("PolygonVertexIndex");
+        w.Array<int32_t>('i', { 0, 1, 2, ~3, 1, 4, ~2 });
+        w.End();
+        w.Begin("LayerElementNormal");
+        w.Int32(0);
+        w.Children();
+        w.Begin("MappingInformationType");
+        w.String("ByPolygonVertex");
+        w.End();
+        w.Begin("ReferenceInformationType");
+        w.String("Direct");
+        w.End();
+        w.Begin("Normals");
+        w.Array<double>('d', std::vector<double>{ 0,0,1, 0,0,1, 0,0,1, 0,0,1, 0,0,1, 0,0,1, 0,0,1 });
+        w.End();
+        w.End();
+        w.Begin("LayerElementMaterial");
+        w.Int32(0);
+        w.Children();
+        w.Begin("MappingInformationType");
+        w.String("AllSame");
+        w.End();
+        w.Begin("Materials");
+        w.Array<int32_t>('i', { 0 });
+        w.End();
+        w.End();
+        w.End();
+
+        w.Begin("Model");
+        w.Int64(200);
+        w.String(std::string("Quad\0\1Model", 11));
+        w.String("Mesh");
+        w.Children();
+        w.Begin("Properties70");
+        w.Children();
+        WriteP(w, "Lcl Translation", 10, 0, 0);
+        w.End();
+        w.End();
+
+        w.Begin("Material");
+        w.Int64(300);
+        w.String(std::string("Red\0\1Material", 13));
+        w.String("");
+        w.End();
+
+        // Skipped record: proves unwanted subtrees are jumped over
+        w.Begin("AnimationCurve");
+        w.Int64(400);
+        w.Children();
+        w.Begin("KeyValueFloat");
+        w.Array<float>('f', { 1.0f, 2.0f, 3.0f });
+        w.End();
+        w.End();
+
+        w.End();
+
+        w.Begin("Connections");
+        w.Children();
+        for (auto link : { std::array<int64_t, 2>{ 100, 200 }, std::array<int64_t, 2>{ 300, 200 },
+                           std::array<int64_t, 2>{ 200, 0 } }) {
+            w.Begin("C");
+            w.String("OO");
+            w.Int64(link[0]);
+            w.Int64(link[1]);
+            w.End();
+        }
+        w.End();
+
+        return w.Finish();
+    }
+};
+
+// Note on usage:
+// SoftwareRenderService::LoadMesh routes .fbx paths through FbxLoader::Load.
+// Tools that need per-model meshes or material bindings call Parse() and read
+// FbxScene::meshes / triangleMaterials directly.
+//
+// Transforms use the simplified T * Rpre * R * Rpost^-1 * S chain (no pivots or
+// offsets); unitScaleFactor and upAxis are reported but not applied.
@@ -0,0 +1,785 @@
+/** FbxWriter - Binary FBX 7.4 writer and native glTF/GLB-to-FBX conversion
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "SoftwareMesh.h"
+#include "GltfLoader.h"
+#include "FbxLoader.h"
+#include "../core/QuoteSystem.h"
+#include "../core/Parallel.h"
+#include "../core/TestManagerNew.h"
+#include "../filesystem/Deflate.h"
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <cmath>
+
+constexpr uint32_t FBX_WRITE_VERSION = 7400;     // 32-bit record offsets; what Unreal's importer expects
+
+struct FbxExportMaterial {
+    std::string name;
+    std::array<float, 3> diffuse = { 0.8f, 0.8f, 0.8f };
+    float opacity = 1.0f;
+};
+
+// One model in the exported scene. Transforms are already baked into the vertices.
+struct FbxExportMesh {
+    std::string name;
+    const SoftwareMesh* mesh = nullptr;
+    int32_t material = -1;      // Index into the material list, -1 for none
+};
+
+struct FbxWriteOptions {
+    double scaleFactor;                 // Applied to positions; 100 turns glTF metres into Unreal centimetres
+    uint32_t compressMinBytes;          // Smaller arrays are stored raw, as the FBX SDK does
+    BrightForge::DeflateLevel level;
+    uint32_t workerCount;               // 0 = hardware concurrency
+
+    FbxWriteOptions()
+        : scaleFactor(100.0), compressMinBytes(128), level(BrightForge::DeflateLevel::FAST), workerCount(0) {}
+};
+
+struct FbxWriteStats {
+    size_t models = 0;
+    size_t triangles = 0;
+    size_t arrays = 0;
+    size_t compressedArrays = 0;
+    uint64_t arrayBytes = 0;            // Array payload before compression
+    uint64_t packedArrayBytes = 0;      // ... and as written
+    uint64_t fileBytes = 0;
+};
+
+// FbxWriter - stateless entry points
+// Builds the record tree in memory, converts each mesh into FBX arrays on worker threads,
+// deflates every array on worker threads (largest first), then serializes once.
+// ConvertGltf() reads the source through GltfLoader's mapping, so the GLB is never copied
+// whole; Y-up is kept and declared in GlobalSettings for the importer to convert.
+class FbxWriter {
+public:
+    static bool WriteMemory(const std::vector<FbxExportMesh>& meshes, const std::vector<FbxExportMaterial>& materials,
+                            std::vector<uint8_t>& out, const FbxWriteOptions& options = FbxWriteOptions(),
+                            FbxWriteStats* stats = nullptr, std::string* error = nullptr) {
+        out.clear();
+        FbxWriteStats local;
+        FbxWriteStats& counters = stats != nullptr ? *stats : local;
+        counters = FbxWriteStats();
+
+        for (const FbxExportMesh& mesh : meshes) {
+            if (mesh.mesh == nullptr || mesh.mesh->vertexStride < 3 ||
+                (mesh.material >= 0 && static_cast<size_t>(mesh.material) >= materials.size())) {
+                return Fail(error, "mesh '" + mesh.name + "' has no data or an out-of-range material");
+            }
+        }
+
+        // Geometry arrays are independent per mesh, so convert them in parallel
+        std::vector<Node> geometries(meshes.size());
+        std::atomic<bool> failed(false);
+        Parallel::For(meshes.size(), [&](size_t i) {
+            if (!BuildGeometry(meshes[i], GeometryId(i), options, geometries[i])) {
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }, options.workerCount);
+        if (failed.load()) {
+            return Fail(error, "mesh has out-of-range indices or more than 2^31 vertices");
+        }
+
+        std::vector<Node> document;
+        BuildDocument(meshes, materials, options, std::move(geometries), document);
+
+        std::vector<Property*> arrays;
+        for (Node& node : document) {
+            CollectArrays(node, arrays);
+        }
+        CompressArrays(arrays, options);
+
+        for (const Property* array : arrays) {
+            ++counters.arrays;
+            counters.compressedArrays += array->compressed ? 1 : 0;
+            counters.arrayBytes += array->raw.size();
+            counters.packedArrayBytes += array->compressed ? array->packed.size() : array->raw.size();
+        }
+        counters.models = meshes.size();
+        for (const FbxExportMesh& mesh : meshes) {
+            counters.triangles += mesh.mesh->indices.size() / 3;
+        }
+
+        out.reserve(static_cast<size_t>(counters.packedArrayBytes) + (64u << 10));
+        const char magic[FBX_MAGIC_SIZE] = "Kaydara FBX Binary  \0\x1A";
+        out.assign(magic, magic + FBX_MAGIC_SIZE);
+        PutScalar(out, FBX_WRITE_VERSION);
+
+        bool overflow = false;
+        for (const Node& node : document) {
+            Serialize(node, out, overflow);
+        }
+        out.resize(out.size() + NULL_RECORD_SIZE, 0);
+        WriteFooter(out);
+
+        if (overflow) {
+            out.clear();
+            return Fail(error, "scene exceeds the 4 GB limit of FBX 7.4");
+        }
+        counters.fileBytes = out.size();
+        return true;
+    }
+
+    static bool Write(const std::string& path, const std::vector<FbxExportMesh>& meshes,
+                      const std::vector<FbxExportMaterial>& materials, const FbxWriteOptions& options = FbxWriteOptions(),
+                      FbxWriteStats* stats = nullptr, std::string* error = nullptr) {
+        std::vector<uint8_t> bytes;
+        if (!WriteMemory(meshes, materials, bytes, options, stats, error)) {
+            return false;
+        }
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!out) {
+            return Fail(error, "cannot write " + path);
+        }
+        return true;
+    }
+
+    // One FBX model per primitive instance of the default scene, node transforms baked in
+    static bool ConvertGltf(const std::string& inputPath, const std::string& outputPath,
+                            const FbxWriteOptions& options = FbxWriteOptions(), FbxWriteStats* stats = nullptr,
+                            std::string* error = nullptr) {
+        GltfDocument doc;
+        if (!GltfLoader::Parse(inputPath, doc, error)) {
+            return false;
+        }
+
+        std::vector<SoftwareMesh> decoded;
+        std::vector<GltfPrimitiveRef> sources;
+        if (!GltfLoader::DecodePrimitives(doc, decoded, &sources)) {
+            return Fail(error, "glTF primitives failed to decode");
+        }
+
+        std::vector<FbxExportMaterial> materials;
+        materials.reserve(doc.materials.size());
+        for (size_t m = 0; m < doc.materials.size(); ++m) {
+            const GltfMaterial& source = doc.materials[m];
+            FbxExportMaterial material;
+            material.name = source.name.empty() ? "Material_" + std::to_string(m) : source.name;
+            material.diffuse = { source.baseColor[0], source.baseColor[1], source.baseColor[2] };
+            material.opacity = source.baseColor[3];
+            materials.push_back(std::move(material));
+        }
+
+        std::vector<FbxExportMesh> meshes(decoded.size());
+        for (size_t i = 0; i < decoded.size(); ++i) {
+            const GltfMesh& source = doc.meshes[sources[i].mesh];
+            int32_t material = source.primitives[sources[i].primitive].material;
+            meshes[i].name = source.name.empty() ? "Mesh_" + std::to_string(sources[i].mesh) : source.name;
+            if (source.primitives.size() > 1) {
+                meshes[i].name += "_" + std::to_string(sources[i].primitive);
+            }
+            meshes[i].mesh = &decoded[i];
+            meshes[i].material = material >= 0 && static_cast<size_t>(material) < materials.size() ? material : -1;
+        }
+
+        return Write(outputPath, meshes, materials, options, stats, error);
+    }
+
+    // Converts every .glb/.gltf under sampleDir (e.g. a batch of generated assets) plus
+    // a synthetic scene of syntheticBytes; pass syntheticBytes = 0 to skip it.
+    // bf-convert --compare-python runs the same inputs through python/fbx_converter.py.
+    static void RegisterBenchmarks(const std::string& sampleDir, uint64_t syntheticBytes = 64ull << 20) {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        std::error_code ec;
+        std::filesystem::path scratch = std::filesystem::temp_directory_path(ec) / "brightforge_fbx_bench.fbx";
+
+        if (!sampleDir.empty() && std::filesystem::is_directory(sampleDir, ec)) {
+            for (auto it = std::filesystem::recursive_directory_iterator(sampleDir, ec);
+                 !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+                if (!it->is_regular_file(ec) || !GltfLoader::IsGltfPath(it->path().string())) {
+                    continue;
+                }
+
+                std::string path = it->path().string();
+                std::string name = std::filesystem::relative(it->path(), sampleDir, ec).generic_string();
+                tests.AddBenchmark("FbxWriter", "Convert " + name, [path, scratch]() {
+                    FbxWriteStats stats;
+                    ConvertGltf(path, scratch.string(), FbxWriteOptions(), &stats);
+                    TestManagerNew::DoNotOptimize(stats.fileBytes);
+                });
+            }
+        } else if (!sampleDir.empty()) {
+            QuoteSystem::Instance().Log("FbxWriter: sample model directory not found - " + sampleDir,
+                QuoteSystem::MessageType::WARNING);
+        }
+
+        if (syntheticBytes == 0) {
+            return;
+        }
+
+        std::string path = (std::filesystem::temp_directory_path(ec) /
+            ("brightforge_fbx_synthetic_" + std::to_string(syntheticBytes >> 20) + "MB.glb")).string();
+        if (!std::filesystem::exists(path, ec) || std::filesystem::file_size(path, ec) < syntheticBytes / 2) {
+            if (!GltfLoader::WriteSyntheticGlb(path, syntheticBytes, 64)) {
+                return;
+            }
+        }
+
+        TestManagerNew::BenchmarkOptions options;
+        options.warmupIterations = 1;
+        options.sampleCount = 5;
+        options.minSampleTimeMs = 0.0;
+        tests.AddBenchmark("FbxWriter", "Convert synthetic scene", [path, scratch]() {
+            FbxWriteStats stats;
+            ConvertGltf(path, scratch.string(), FbxWriteOptions(), &stats);
+            TestManagerNew::DoNotOptimize(stats.fileBytes);
+        }, options);
+    }
+
+    // Round trips through FbxLoader
+    static void RegisterTests() {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        tests.RegisterSuite("FbxWriter");
+
+        tests.AddTest("FbxWriter", "Meshes and materials survive FbxLoader", []() {
+            SoftwareMesh grid = TestGrid(24);
+            SoftwareMesh triangle;
+            triangle.vertices = { 0,0,0, 0,0,1, 0,0,  1,0,0, 0,0,1, 1,0,  0,1,0, 0,0,1, 0,1 };
+            triangle.indices = { 0, 1, 2 };
+
+            std::vector<FbxExportMaterial> materials(1);
+            materials[0].name = "Red";
+            materials[0].diffuse = { 1.0f, 0.0f, 0.0f };
+            std::vector<FbxExportMesh> meshes = { { "Grid", &grid, -1 }, { "Tri", &triangle, 0 } };
+
+            std::vector<uint8_t> file;
+            FbxWriteStats stats;
+            FbxScene scene;
+            bool ok = WriteMemory(meshes, materials, file, FbxWriteOptions(), &stats) &&
+                      FbxLoader::ParseMemory(file.data(), file.size(), scene) &&
+                      scene.version == FBX_WRITE_VERSION && scene.meshes.size() == 2 &&
+                      scene.materials.size() == 1 && scene.materials[0].name == "Red" &&
+                      scene.materials[0].diffuse[0] == 1.0f && stats.compressedArrays > 0 &&
+                      stats.packedArrayBytes < stats.arrayBytes && stats.fileBytes == file.size();
+            if (!ok) {
+                return false;
+            }
+
+            // FbxLoader expands to one vertex per corner; positions come back scaled by 100
+            for (const FbxMeshInstance& instance : scene.meshes) {
+                const SoftwareMesh& source = scene.models[instance.model].name == "Grid" ? grid : triangle;
+                if (instance.mesh.indices.size() != source.indices.size()) {
+                    return false;
+                }
+                for (size_t c = 0; c < source.indices.size(); ++c) {
+                    const float* expected = source.vertices.data() + source.indices[c] * SOFTWARE_MESH_STRIDE;
+                    const float* actual = instance.mesh.vertices.data() + instance.mesh.indices[c] * SOFTWARE_MESH_STRIDE;
+                    for (uint32_t k = 0; k < SOFTWARE_MESH_STRIDE; ++k) {
+                        float scale = k < 3 ? 100.0f : 1.0f;
+                        if (std::fabs(actual[k] - expected[k] * scale) > 1e-3f) {
+                            return false;
+                        }
+                    }
+                }
+                bool bound = &source == &triangle;
+                if (instance.triangleMaterials.empty() ||
+                    instance.triangleMaterials[0] != (bound ? 0u : UINT32_MAX)) {
+                    return false;
+                }
+            }
+            return true;
+        });
+
+        tests.AddTest("FbxWriter", "Synthetic GLB converts with matching geometry", []() {
+            std::error_code ec;
+            std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+            std::string glb = (dir / "brightforge_fbx_convert.glb").string();
+            std::string fbx = (dir / "brightforge_fbx_convert.fbx").string();
+            if (!GltfLoader::WriteSyntheticGlb(glb, 256 * 1024, 4)) {
+                return false;
+            }
+
+            FbxWriteOptions options;
+            options.scaleFactor = 1.0;
+            options.level = BrightForge::DeflateLevel::HIGH;
+            FbxWriteStats stats;
+            GltfDocument doc;
+            SoftwareMesh merged;
+            FbxScene scene;
+            bool ok = ConvertGltf(glb, fbx, options, &stats) && GltfLoader::Parse(glb, doc) &&
+                      GltfLoader::DecodeMerged(doc, merged) && FbxLoader::Parse(fbx, scene) &&
+                      stats.models == 4 && scene.meshes.size() == 4 && std::fabs(scene.unitScaleFactor - 100.0) < 1e-9;
+
+            size_t triangles = 0;
+            float maxX = 0.0f;
+            for (const FbxMeshInstance& instance : scene.meshes) {
+                triangles += instance.mesh.indices.size() / 3;
+                for (size_t v = 0; v < instance.mesh.vertices.size(); v += SOFTWARE_MESH_STRIDE) {
+                    maxX = std::max(maxX, instance.mesh.vertices[v]);
+                }
+            }
+            float expectedX = 0.0f;
+            for (size_t v = 0; v < merged.vertices.size(); v += SOFTWARE_MESH_STRIDE) {
+                expectedX = std::max(expectedX, merged.vertices[v]);
+            }
+            ok = ok && triangles == merged.indices.size() / 3 && std::fabs(maxX - expectedX) < 1e-5f;
+
+            std::filesystem::remove(glb, ec);
+            std::filesystem::remove(fbx, ec);
+            return ok;
+        });
+
+        tests.AddTest("FbxWriter", "Deflate output inflates for every block type", []() {
+            std::vector<uint8_t> runs(200000, 7);
+            std::vector<uint8_t> noise(70000);
+            uint32_t state = 1;
+            for (uint8_t& b : noise) {
+                state = state * 1664525u + 1013904223u;
+                b = static_cast<uint8_t>(state >> 24);
+            }
+            std::vector<uint8_t> mixed = TestGridBytes();
+
+            for (const std::vector<uint8_t>* input : { &runs, &noise, &mixed }) {
+                for (BrightForge::DeflateLevel level : { BrightForge::DeflateLevel::FAST, BrightForge::DeflateLevel::HIGH }) {
+                    std::vector<uint8_t> packed;
+                    std::vector<uint8_t> unpacked(input->size());
+                    size_t written = 0;
+                    if (!BrightForge::Deflate::CompressZlib(input->data(), input->size(), packed, level) ||
+                        !BrightForge::Inflate::DecompressZlib(packed.data(), packed.size(), unpacked.data(),
+                                                              unpacked.size(), &written) ||
+                        written != input->size() || unpacked != *input) {
+                        return false;
+                    }
+                }
+            }
+
+            std::vector<uint8_t> empty;
+            uint8_t sink = 0;
+            size_t written = 1;
+            return BrightForge::Deflate::CompressZlib(nullptr, 0, empty) &&
+                   BrightForge::Inflate::DecompressZlib(empty.data(), empty.size(), &sink, 0, &written) && written == 0;
+        });
+    }
+
+    // Prevent instantiation (static API)
+    FbxWriter() = delete;
+
+private:
+    static constexpr size_t NULL_RECORD_SIZE = 13;
+    static constexpr int64_t OBJECT_ID_BASE = 1000000;
+
+    // Fixed FileId/CreationTime pair (the values Blender writes) keep output byte-identical
+    // across runs; importers check only that the two agree with the footer.
+    static constexpr uint8_t FILE_ID[16] = { 0x28, 0xb3, 0x2a, 0xeb, 0xb6, 0x24, 0xcc, 0xc2,
+                                             0xbf, 0xc8, 0xb0, 0x2a, 0xa9, 0x2b, 0xfc, 0xf1 };
+    static constexpr uint8_t FOOTER_ID[16] = { 0xfa, 0xbc, 0xab, 0x09, 0xd0, 0xc8, 0xd4, 0x66,
+                                               0xb1, 0x76, 0xfb, 0x83, 0x1c, 0xf7, 0x26, 0x7e };
+    static constexpr uint8_t FOOTER_MAGIC[16] = { 0xf8, 0x5a, 0x8c, 0x6a, 0xde, 0xf5, 0xd9, 0x7e,
+                                                  0xec, 0xe9, 0x0c, 0xe3, 0x75, 0x8f, 0x29, 0x0b };
+
+    struct Property {
+        char type = 0;
+        uint8_t scalar[8] = {};
+        std::string text;               // S and R payloads
+        std::vector<uint8_t> raw;       // Array elements
+        uint32_t count = 0;
+        std::vector<uint8_t> packed;    // zlib stream, when it beat the raw bytes
+        bool compressed = false;
+    };
+
+    struct Node {
+        std::string name;
+        std::vector<Property> properties;
+        std::vector<Node> children;
+    };
+
+    static bool Fail(std::string* error, const std::string& message) {
+        if (error != nullptr) {
+            *error = message;
+        }
+        return false;
+    }
+
+    template <typename T>
+    static void PutScalar(std::vector<uint8_t>& out, T value) {
+        uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    // ---- Records -----------------------------------------------------------
+
+    template <typename T>
+    static Property Scalar(char type, T value) {
+        static_assert(sizeof(T) <= 8, "FBX scalars are at most 8 bytes");
+        Property property;
+        property.type = type;
+        std::memcpy(property.scalar, &value, sizeof(T));
+        return property;
+    }
+
+    static Property Int32(int32_t value) { return Scalar('I', value); }
+    static Property Int64(int64_t value) { return Scalar('L', value); }
+    static Property Double(double value) { return Scalar('D', value); }
+    static Property Bool(bool value) { return Scalar('C', static_cast<uint8_t>(value ? 1 : 0)); }
+
+    static Property String(const std::string& text, char type = 'S') {
+        Property property;
+        property.type = type;
+        property.text = text;
+        return property;
+    }
+
+    template <typename T>
+    static Property Array(char type, const std::vector<T>& values) {
+        Property property;
+        property.type = type;
+        property.count = static_cast<uint32_t>(values.size());
+        property.raw.resize(values.size() * sizeof(T));
+        if (!values.empty()) {
+            std::memcpy(property.raw.data(), values.data(), property.raw.size());
+        }
+        return property;
+    }
+
+    static Node Make(const std::string& name, std::vector<Property> properties = {}) {
+        Node node;
+        node.name = name;
+        node.properties = std::move(properties);
+        return node;
+    }
+
+    // "Name\0\1Class", the binary form of "Class::Name"
+    static Property ObjectName(const std::string& name, const char* objectClass) {
+        return String(name + std::string("\0\1", 2) + objectClass);
+    }
+
+    // Properties70 entry: P "name", "type", "label", "flags", values...
+    static Node P(const char* name, const char* type, const char* label, const char* flags,
+                  std::vector<Property> values) {
+        std::vector<Property> properties = { String(name), String(type), String(label), String(flags) };
+        for (Property& value : values) {
+            properties.push_back(std::move(value));
+        }
+        return Make("P", std::move(properties));
+    }
+
+    static Node Properties70(std::vector<Node> entries) {
+        Node node = Make("Properties70");
+        node.children = std::move(entries);
+        return node;
+    }
+
+    static Node WithChildren(Node node, std::vector<Node> children) {
+        node.children = std::move(children);
+        return node;
+    }
+
+    static int64_t GeometryId(size_t mesh) { return OBJECT_ID_BASE + static_cast<int64_t>(mesh) * 2; }
+    static int64_t ModelId(size_t mesh) { return OBJECT_ID_BASE + static_cast<int64_t>(mesh) * 2 + 1; }
+    static int64_t MaterialId(size_t meshCount, size_t material) {
+        return OBJECT_ID_BASE + static_cast<int64_t>(meshCount) * 2 + static_cast<int64_t>(material);
+    }
+
+    // ---- Scene -------------------------------------------------------------
+
+    // Control points are the indexed vertices; normals and UVs map by control point
+    static bool BuildGeometry(const FbxExportMesh& source, int64_t id, const FbxWriteOptions& options, Node& out) {
+        const SoftwareMesh& mesh = *source.mesh;
+        size_t stride = mesh.vertexStride;
+        size_t vertexCount = mesh.vertices.size() / stride;
+        if (vertexCount > static_cast<size_t>(INT32_MAX) || mesh.indices.size() > static_cast<size_t>(UINT32_MAX)) {
+            return false;
+        }
+
+        bool hasNormals = stride >= 6;
+        bool hasUvs = stride >= 8;
+        std::vector<double> positions(vertexCount * 3);
+        std::vector<double> normals(hasNormals ? vertexCount * 3 : 0);
+        std::vector<double> uvs(hasUvs ? vertexCount * 2 : 0);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            const float* vertex = mesh.vertices.data() + v * stride;
+            for (int k = 0; k < 3; ++k) {
+                positions[v * 3 + k] = vertex[k] * options.scaleFactor;
+                if (hasNormals) {
+                    normals[v * 3 + k] = vertex[3 + k];
+                }
+            }
+            if (hasUvs) {
+                // FBX UV origin is bottom-left
+                uvs[v * 2] = vertex[6];
+                uvs[v * 2 + 1] = 1.0 - vertex[7];
+            }
+        }
+
+        // Triangles only: the last corner of each polygon is stored as ~index
+        size_t cornerCount = mesh.indices.size() - mesh.indices.size() % 3;
+        std::vector<int32_t> polygons(cornerCount);
+        for (size_t c = 0; c < cornerCount; ++c) {
+            uint32_t index = mesh.indices[c];
+            if (index >= vertexCount) {
+                return false;
+            }
+            polygons[c] = c % 3 == 2 ? ~static_cast<int32_t>(index) : static_cast<int32_t>(index);
+        }
+
+        out = Make("Geometry", { Int64(id), ObjectName(source.name, "Geometry"), String("Mesh") });
+        out.children.push_back(Properties70({}));
+        out.children.push_back(Make("GeometryVersion", { Int32(124) }));
+        out.children.push_back(Make("Vertices", { Array('d', positions) }));
+        out.children.push_back(Make("PolygonVertexIndex", { Array('i', polygons) }));
+
+        std::vector<Node> layer = { Make("Version", { Int32(100) }) };
+        auto addLayerElement = [&](const char* type, const char* name, const char* mapping, const char* reference,
+                                   const char* arrayName, Property values) {
+            out.children.push_back(WithChildren(Make(type, { Int32(0) }), {
+                Make("Version", { Int32(101) }),
+                Make("Name", { String(name) }),
+                Make("MappingInformationType", { String(mapping) }),
+                Make("ReferenceInformationType", { String(reference) }),
+                Make(arrayName, { std::move(values) }) }));
+            layer.push_back(WithChildren(Make("LayerElement"), {
+                Make("Type", { String(type) }),
+                Make("TypedIndex", { Int32(0) }) }));
+        };
+
+        if (hasNormals) {
+            addLayerElement("LayerElementNormal", "", "ByVertice", "Direct", "Normals", Array('d', normals));
+        }
+        if (hasUvs) {
+            addLayerElement("LayerElementUV", "UVMap", "ByVertice", "Direct", "UV", Array('d', uvs));
+        }
+        if (source.material >= 0) {
+            addLayerElement("LayerElementMaterial", "", "AllSame", "IndexToDirect", "Materials",
+                            Array('i', std::vector<int32_t>{ 0 }));
+        }
+        out.children.push_back(WithChildren(Make("Layer", { Int32(0) }), std::move(layer)));
+        return true;
+    }
+
+    static void BuildDocument(const std::vector<FbxExportMesh>& meshes, const std::vector<FbxExportMaterial>& materials,
+                              const FbxWriteOptions& options, std::vector<Node> geometries, std::vector<Node>& document) {
+        const std::string creator = "BrightForge FbxWriter";
+        const std::string creationTime = "1970-01-01 10:00:00:000";
+
+        document.push_back(WithChildren(Make("FBXHeaderExtension"), {
+            Make("FBXHeaderVersion", { Int32(1003) }),
+            Make("FBXVersion", { Int32(static_cast<int32_t>(FBX_WRITE_VERSION)) }),
+            Make("EncryptionType", { Int32(0) }),
+            WithChildren(Make("CreationTimeStamp"), {
+                Make("Version", { Int32(1000) }), Make("Year", { Int32(1970) }), Make("Month", { Int32(1) }),
+                Make("Day", { Int32(1) }), Make("Hour", { Int32(10) }), Make("Minute", { Int32(0) }),
+                Make("Second", { Int32(0) }), Make("Millisecond", { Int32(0) }) }),
+            Make("Creator", { String(creator) }) }));
+        document.push_back(Make("FileId", { String(std::string(reinterpret_cast<const char*>(FILE_ID), 16), 'R') }));
+        document.push_back(Make("CreationTime", { String(creationTime) }));
+        document.push_back(Make("Creator", { String(creator) }));
+
+        // glTF is Y-up, +Z front, right-handed; UnitScaleFactor is centimetres per file unit
+        document.push_back(WithChildren(Make("GlobalSettings"), {
+            Make("Version", { Int32(1000) }),
+            Properties70({
+                P("UpAxis", "int", "Integer", "", { Int32(1) }),
+                P("UpAxisSign", "int", "Integer", "", { Int32(1) }),
+                P("FrontAxis", "int", "Integer", "", { Int32(2) }),
+                P("FrontAxisSign", "int", "Integer", "", { Int32(1) }),
+                P("CoordAxis", "int", "Integer", "", { Int32(0) }),
+                P("CoordAxisSign", "int", "Integer", "", { Int32(1) }),
+                P("OriginalUpAxis", "int", "Integer", "", { Int32(1) }),
+                P("OriginalUpAxisSign", "int", "Integer", "", { Int32(1) }),
+                P("UnitScaleFactor", "double", "Number", "", { Double(100.0 / options.scaleFactor) }),
+                P("OriginalUnitScaleFactor", "double", "Number", "", { Double(100.0 / options.scaleFactor) }) }) }));
+
+        document.push_back(WithChildren(Make("Documents"), {
+            Make("Count", { Int32(1) }),
+            WithChildren(Make("Document", { Int64(OBJECT_ID_BASE - 1), String("Scene"), String("Scene") }), {
+                Properties70({
+                    P("SourceObject", "object", "", "", {}),
+                    P("ActiveAnimStackName", "KString", "", "", { String("") }) }),
+                Make("RootNode", { Int64(0) }) }) }));
+        document.push_back(Make("References"));
+
+        std::vector<Node> definitions = {
+            Make("Version", { Int32(100) }),
+            Make("Count", { Int32(static_cast<int32_t>(1 + meshes.size() * 2 + materials.size())) }),
+            WithChildren(Make("ObjectType", { String("GlobalSettings") }), { Make("Count", { Int32(1) }) }) };
+        if (!meshes.empty()) {
+            for (const char* type : { "Geometry", "Model" }) {
+                definitions.push_back(WithChildren(Make("ObjectType", { String(type) }), {
+                    Make("Count", { Int32(static_cast<int32_t>(meshes.size())) }) }));
+            }
+        }
+        if (!materials.empty()) {
+            definitions.push_back(WithChildren(Make("ObjectType", { String("Material") }), {
+                Make("Count", { Int32(static_cast<int32_t>(materials.size())) }) }));
+        }
+        document.push_back(WithChildren(Make("Definitions"), std::move(definitions)));
+
+        Node objects = Make("Objects");
+        Node connections = Make("Connections");
+        objects.children.reserve(meshes.size() * 2 + materials.size());
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            objects.children.push_back(std::move(geometries[i]));
+            objects.children.push_back(WithChildren(
+                Make("Model", { Int64(ModelId(i)), ObjectName(meshes[i].name, "Model"), String("Mesh") }), {
+                    Make("Version", { Int32(232) }),
+                    Properties70({
+                        P("DefaultAttributeIndex", "int", "Integer", "", { Int32(0) }),
+                        P("InheritType", "enum", "", "", { Int32(1) }) }),
+                    Make("MultiLayer", { Int32(0) }),
+                    Make("MultiTake", { Int32(0) }),
+                    Make("Shading", { Bool(true) }),
+                    Make("Culling", { String("CullingOff") }) }));
+
+            connections.children.push_back(Make("C", { String("OO"), Int64(ModelId(i)), Int64(0) }));
+            connections.children.push_back(Make("C", { String("OO"), Int64(GeometryId(i)), Int64(ModelId(i)) }));
+            if (meshes[i].material >= 0) {
+                connections.children.push_back(Make("C", { String("OO"),
+                    Int64(MaterialId(meshes.size(), static_cast<size_t>(meshes[i].material))), Int64(ModelId(i)) }));
+            }
+        }
+        for (size_t m = 0; m < materials.size(); ++m) {
+            const FbxExportMaterial& material = materials[m];
+            objects.children.push_back(WithChildren(
+                Make("Material", { Int64(MaterialId(meshes.size(), m)), ObjectName(material.name, "Material"), String("") }), {
+                    Make("Version", { Int32(102) }),
+                    Make("ShadingModel", { String("lambert") }),
+                    Make("MultiLayer", { Int32(0) }),
+                    Properties70({
+                        P("DiffuseColor", "Color", "", "A",
+                          { Double(material.diffuse[0]), Double(material.diffuse[1]), Double(material.diffuse[2]) }),
+                        P("Opacity", "double", "Number", "", { Double(material.opacity) }) }) }));
+        }
+        document.push_back(std::move(objects));
+        document.push_back(std::move(connections));
+        document.push_back(WithChildren(Make("Takes"), { Make("Current", { String("") }) }));
+    }
+
+    // ---- Parallel work -----------------------------------------------------
+
+    static void CollectArrays(Node& node, std::vector<Property*>& arrays) {
+        for (Property& property : node.properties) {
+            if (FbxProperty::ElementSize(property.type) != 0) {
+                arrays.push_back(&property);
+            }
+        }
+        for (Node& child : node.children) {
+            CollectArrays(child, arrays);
+        }
+    }
+
+    static void CompressArrays(std::vector<Property*>& arrays, const FbxWriteOptions& options) {
+        // Largest first keeps one big vertex array from serializing the tail
+        std::sort(arrays.begin(), arrays.end(), [](const Property* a, const Property* b) {
+            return a->raw.size() > b->raw.size();
+        });
+
+        Parallel::For(arrays.size(), [&](size_t i) {
+            Property& property = *arrays[i];
+            if (property.raw.size() < options.compressMinBytes) {
+                return;
+            }
+            BrightForge::Deflate::CompressZlib(property.raw.data(), property.raw.size(), property.packed, options.level);
+            property.compressed = property.packed.size() < property.raw.size();
+            if (!property.compressed) {
+                property.packed = std::vector<uint8_t>();
+            }
+        }, options.workerCount);
+    }
+
+    // ---- Serialization -----------------------------------------------------
+
+    static void Serialize(const Node& node, std::vector<uint8_t>& out, bool& overflow) {
+        size_t start = out.size();
+        out.resize(start + NULL_RECORD_SIZE - 1, 0);
+        out.push_back(static_cast<uint8_t>(std::min<size_t>(node.name.size(), 255)));
+        out.insert(out.end(), node.name.begin(), node.name.begin() + std::min<size_t>(node.name.size(), 255));
+
+        size_t propertyStart = out.size();
+        for (const Property& property : node.properties) {
+            out.push_back(static_cast<uint8_t>(property.type));
+            switch (property.type) {
+                case 'C': out.push_back(property.scalar[0]); break;
+                case 'Y': out.insert(out.end(), property.scalar, property.scalar + 2); break;
+                case 'I': case 'F': out.insert(out.end(), property.scalar, property.scalar + 4); break;
+                case 'L': case 'D': out.insert(out.end(), property.scalar, property.scalar + 8); break;
+                case 'S': case 'R':
+                    PutScalar(out, static_cast<uint32_t>(property.text.size()));
+                    out.insert(out.end(), property.text.begin(), property.text.end());
+                    break;
+                default: {
+                    const std::vector<uint8_t>& payload = property.compressed ? property.packed : property.raw;
+                    PutScalar(out, property.count);
+                    PutScalar(out, static_cast<uint32_t>(property.compressed ? 1 : 0));
+                    PutScalar(out, static_cast<uint32_t>(payload.size()));
+                    out.insert(out.end(), payload.begin(), payload.end());
+                    break;
+                }
+            }
+        }
+        size_t propertyBytes = out.size() - propertyStart;
+
+        // Nested lists end in a null record; so do records with nothing in them at all
+        for (const Node& child : node.children) {
+            Serialize(child, out, overflow);
+        }
+        if (!node.children.empty() || node.properties.empty()) {
+            out.resize(out.size() + NULL_RECORD_SIZE, 0);
+        }
+
+        if (out.size() > UINT32_MAX || propertyBytes > UINT32_MAX) {
+            overflow = true;
+            return;
+        }
+        uint32_t header[3] = { static_cast<uint32_t>(out.size()), static_cast<uint32_t>(node.properties.size()),
+                               static_cast<uint32_t>(propertyBytes) };
+        std::memcpy(out.data() + start, header, sizeof(header));
+    }
+
+    static void WriteFooter(std::vector<uint8_t>& out) {
+        out.insert(out.end(), FOOTER_ID, FOOTER_ID + 16);
+        out.resize(out.size() + 4, 0);
+        size_t padding = ((out.size() + 15) & ~static_cast<size_t>(15)) - out.size();
+        out.resize(out.size() + (padding == 0 ? 16 : padding), 0);
+        PutScalar(out, FBX_WRITE_VERSION);
+        out.resize(out.size() + 120, 0);
+        out.insert(out.end(), FOOTER_MAGIC, FOOTER_MAGIC + 16);
+    }
+
+    // ---- Test fixture ------------------------------------------------------
+
+    // n x n grid with a wavy height, large enough that its arrays get compressed
+    static SoftwareMesh TestGrid(uint32_t n) {
+        SoftwareMesh mesh;
+        for (uint32_t y = 0; y < n; ++y) {
+            for (uint32_t x = 0; x < n; ++x) {
+                float u = static_cast<float>(x) / (n - 1);
+                float v = static_cast<float>(y) / (n - 1);
+                mesh.vertices.insert(mesh.vertices.end(), { u, 0.1f * std::sin(u * 6.0f), v, 0.0f, 1.0f, 0.0f, u, v });
+            }
+        }
+        for (uint32_t y = 0; y + 1 < n; ++y) {
+            for (uint32_t x = 0; x + 1 < n; ++x) {
+                uint32_t i = y * n + x;
+                mesh.indices.insert(mesh.indices.end(), { i, i + n, i + 1, i + 1, i + n, i + n + 1 });
+            }
+        }
+        return mesh;
+    }
+
+    static std::vector<uint8_t> TestGridBytes() {
+        SoftwareMesh grid = TestGrid(96);
+        std::vector<uint8_t> bytes(grid.vertices.size() * sizeof(float));
+        std::memcpy(bytes.data(), grid.vertices.data(), bytes.size());
+        return bytes;
+    }
+};
+
+// Note on usage:
+// src/tools/bf-convert.cpp wraps ConvertGltf for single files and whole directories;
+// python/fbx_converter.py uses it as its "native" backend when the binary is found.
+// Only static geometry and base colours are exported: textures, skins and animation
+// stay with the Blender backend.
@@ -0,0 +1,1863 @@
+/** GltfLoader - Zero-copy glTF 2.0 / GLB loader producing SoftwareMesh data
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "SoftwareMesh.h"
+#include "../core/QuoteSystem.h"
+#include "../core/DebugWindow.h"
+#include "../core/JsonBinding.h"
+#include "../core/Parallel.h"
+#include "../core/TestManagerNew.h"
+#include "../filesystem/MappedFile.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <numeric>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+
+// GLB container constants (little-endian)
+constexpr uint32_t GLB_MAGIC = 0x46546C67;        // "glTF"
+constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;   // "JSON"
+constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;    // "BIN\0"
+constexpr size_t GLB_HEADER_SIZE = 12;
+constexpr size_t GLB_CHUNK_HEADER_SIZE = 8;
+
+// Accessor component types as numbered by the glTF spec
+enum class GltfComponentType : uint32_t {
+    BYTE = 5120,
+    UNSIGNED_BYTE = 5121,
+    SHORT = 5122,
+    UNSIGNED_SHORT = 5123,
+    UNSIGNED_INT = 5125,
+    FLOAT = 5126
+};
+
+// Primitive topologies the loader can triangulate
+enum class GltfPrimitiveMode : uint32_t {
+    POINTS = 0,
+    LINES = 1,
+    LINE_LOOP = 2,
+    LINE_STRIP = 3,
+    TRIANGLES = 4,
+    TRIANGLE_STRIP = 5,
+    TRIANGLE_FAN = 6
+};
+
+struct GltfBufferView {
+    uint32_t buffer = 0;
+    size_t byteOffset = 0;
+    size_t byteLength = 0;
+    uint32_t byteStride = 0;
+};
+
+struct GltfSparse {
+    uint32_t count = 0;
+    int32_t indicesView = -1;
+    size_t indicesOffset = 0;
+    uint32_t indicesComponentType = 0;
+    int32_t valuesView = -1;
+    size_t valuesOffset = 0;
+};
+
+struct GltfAccessor {
+    int32_t bufferView = -1;    // -1 means all zeros (sparse-only accessors)
+    size_t byteOffset = 0;
+    uint32_t componentType = 0;
+    uint32_t components = 0;
+    uint32_t count = 0;
+    bool normalized = false;
+    bool hasSparse = false;
+    GltfSparse sparse;
+};
+
+struct GltfPrimitive {
+    int32_t position = -1;
+    int32_t normal = -1;
+    int32_t texcoord0 = -1;
+    int32_t indices = -1;
+    int32_t material = -1;
+    uint32_t mode = static_cast<uint32_t>(GltfPrimitiveMode::TRIANGLES);
+};
+
+struct GltfMesh {
+    std::string name;
+    std::vector<GltfPrimitive> primitives;
+};
+
+struct GltfMaterial {
+    std::string name;
+    std::array<float, 4> baseColor = { 1, 1, 1, 1 };   // pbrMetallicRoughness.baseColorFactor
+};
+
+// Which mesh primitive a decoded SoftwareMesh came from
+struct GltfPrimitiveRef {
+    uint32_t mesh = 0;
+    uint32_t primitive = 0;
+};
+
+// One mesh of a written scene; vertex layout follows mesh->vertexStride
+// (3 = position, 6 = + normal, 8+ = + uv; extra floats are dropped)
+struct GltfExportMesh {
+    std::string name;
+    const SoftwareMesh* mesh = nullptr;
+    int32_t material = -1;      // Index into the material list, -1 for none
+};
+
+// A mesh primitive placed in the scene by a node, with the node's world transform
+struct GltfPrimitiveInstance {
+    uint32_t mesh = 0;
+    uint32_t primitive = 0;
+    std::array<float, 16> world = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };   // Column-major
+    bool identity = true;
+};
+
+struct GltfNode {
+    int32_t mesh = -1;
+    std::vector<uint32_t> children;
+    std::array<float, 16> matrix = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };  // Column-major local transform
+};
+
+// Strided, typed window onto accessor data that still lives in the mapping
+// Reads go through memcpy because glTF only guarantees component alignment
+template <typename T>
+class GltfAccessorView {
+public:
+    GltfAccessorView() : mData(nullptr), mCount(0), mStride(sizeof(T)) {}
+    GltfAccessorView(const uint8_t* data, size_t count, size_t stride)
+        : mData(data), mCount(count), mStride(stride) {}
+
+    T operator[](size_t index) const {
+        T value;
+        std::memcpy(&value, mData + index * mStride, sizeof(T));
+        return value;
+    }
+
+    const uint8_t* data() const { return mData; }
+    size_t size() const { return mCount; }
+    size_t stride() const { return mStride; }
+    bool empty() const { return mCount == 0; }
+
+    // True when elements are tightly packed and can be handed to memcpy/GPU upload directly
+    bool IsContiguous() const { return mStride == sizeof(T); }
+
+private:
+    const uint8_t* mData;
+    size_t mCount;
+    size_t mStride;
+};
+
+// Parsed glTF document; owns the mappings its accessors point into
+struct GltfDocument {
+    std::string path;
+    BrightForge::MappedFile file;
+    std::vector<BrightForge::MappedFile> externalFiles;
+    std::vector<std::vector<uint8_t>> embeddedData;    // Decoded data: URIs (the only copy we make)
+
+    struct BufferRange {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    std::vector<BufferRange> buffers;
+    std::vector<GltfBufferView> bufferViews;
+    std::vector<GltfAccessor> accessors;
+    std::vector<GltfMesh> meshes;
+    std::vector<GltfMaterial> materials;
+    std::vector<GltfNode> nodes;
+    std::vector<std::vector<uint32_t>> scenes;
+    int32_t scene = -1;
+
+    // Typed view over a dense accessor. Returns an empty view when T does not match
+    // the element size or the accessor needs sparse substitution.
+    template <typename T>
+    GltfAccessorView<T> GetView(uint32_t accessorIndex) const {
+        if (accessorIndex >= accessors.size()) {
+            return GltfAccessorView<T>();
+        }
+
+        const GltfAccessor& accessor = accessors[accessorIndex];
+        if (accessor.hasSparse || accessor.bufferView < 0 ||
+            sizeof(T) != ElementSize(accessor)) {
+            return GltfAccessorView<T>();
+        }
+
+        const GltfBufferView& view = bufferViews[accessor.bufferView];
+        size_t stride = view.byteStride != 0 ? view.byteStride : sizeof(T);
+        const uint8_t* base = buffers[view.buffer].data + view.byteOffset + accessor.byteOffset;
+        return GltfAccessorView<T>(base, accessor.count, stride);
+    }
+
+    static size_t ComponentSize(uint32_t componentType) {
+        switch (static_cast<GltfComponentType>(componentType)) {
+            case GltfComponentType::BYTE:
+            case GltfComponentType::UNSIGNED_BYTE:  return 1;
+            case GltfComponentType::SHORT:
+            case GltfComponentType::UNSIGNED_SHORT: return 2;
+            case GltfComponentType::UNSIGNED_INT:
+            case GltfComponentType::FLOAT:          return 4;
+            default:                                return 0;
+        }
+    }
+
+    static size_t ElementSize(const GltfAccessor& accessor) {
+        return ComponentSize(accessor.componentType) * accessor.components;
+    }
+};
+
+// Counts used to size merged output before decoding
+struct GltfLoadStats {
+    size_t primitiveCount = 0;
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    size_t skippedPrimitives = 0;
+};
+
+// GltfLoader - stateless entry points
+// Parse() maps the file and reads the JSON with the pull tokenizer from JsonBinding.h
+// (no DOM is built). Decode*() converts primitives into the SoftwareMesh layout on
+// worker threads, one primitive per task, writing straight into preallocated output.
+class GltfLoader {
+public:
+    static bool IsGltfPath(const std::string& path) {
+        std::string ext = std::filesystem::path(path).extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return ext == ".glb" || ext == ".gltf";
+    }
+
+    // Map and parse a .glb or .gltf file. Buffer data is validated but not touched.
+    static bool Parse(const std::string& path, GltfDocument& doc, std::string* error = nullptr) {
+        doc = GltfDocument();
+        doc.path = path;
+
+        if (!doc.file.Open(path)) {
+            return Fail(error, doc.file.GetError());
+        }
+
+        const uint8_t* data = doc.file.Data();
+        size_t size = doc.file.Size();
+
+        std::string_view json;
+        GltfDocument::BufferRange binChunk;
+
+        if (size >= GLB_HEADER_SIZE && ReadU32(data) == GLB_MAGIC) {
+            if (!SplitGlb(data, size, json, binChunk, error)) {
+                return false;
+            }
+        } else {
+            json = std::string_view(reinterpret_cast<const char*>(data), size);
+        }
+
+        std::vector<std::string> bufferUris;
+        if (!ParseJson(json, doc, bufferUris, error)) {
+            return false;
+        }
+
+        if (!ResolveBuffers(doc, bufferUris, binChunk, error)) {
+            return false;
+        }
+
+        return Validate(doc, error);
+    }
+
+    // Count what DecodeMerged() will produce so callers can size buffers up front
+    static GltfLoadStats Measure(const GltfDocument& doc) {
+        GltfLoadStats stats;
+        for (const PrimitiveInstance& instance : CollectInstances(doc)) {
+            const GltfPrimitive& primitive = doc.meshes[instance.mesh].primitives[instance.primitive];
+            size_t vertices = 0;
+            size_t indices = 0;
+            if (!CountPrimitive(doc, primitive, vertices, indices)) {
+                ++stats.skippedPrimitives;
+                continue;
+            }
+            ++stats.primitiveCount;
+            stats.vertexCount += vertices;
+            stats.indexCount += indices;
+        }
+        return stats;
+    }
+
+    // Every primitive the default scene places, in traversal order (what the decoders walk)
+    static std::vector<GltfPrimitiveInstance> Instances(const GltfDocument& doc) {
+        return CollectInstances(doc);
+    }
+
+    // Any accessor (quantized, normalized or sparse) decoded to `components` packed floats
+    // per element. Dense float data is better read in place through GltfDocument::GetView.
+    static std::vector<float> ReadAccessor(const GltfDocument& doc, uint32_t accessorIndex, uint32_t components) {
+        if (accessorIndex >= doc.accessors.size()) {
+            return {};
+        }
+        const GltfAccessor& accessor = doc.accessors[accessorIndex];
+        std::vector<float> out(accessor.count * components, 0.0f);
+        ReadFloats(doc, accessor, components, out.data(), components);
+        return out;
+    }
+
+    // Index accessor flattened to uint32 (sparse substitution applied)
+    static std::vector<uint32_t> ReadIndices(const GltfDocument& doc, uint32_t accessorIndex) {
+        if (accessorIndex >= doc.accessors.size()) {
+            return {};
+        }
+        return ResolveIndices(doc, doc.accessors[accessorIndex]);
+    }
+
+    // Flatten the default scene into one mesh with node transforms baked in
+    static bool DecodeMerged(const GltfDocument& doc, SoftwareMesh& outMesh) {
+        std::vector<PrimitiveInstance> instances = CollectInstances(doc);
+
+        // Prefix sums give every primitive its own disjoint output range
+        std::vector<Job> jobs;
+        jobs.reserve(instances.size());
+        size_t vertexTotal = 0;
+        size_t indexTotal = 0;
+        size_t skipped = 0;
+        for (const PrimitiveInstance& instance : instances) {
+            Job job;
+            job.instance = instance;
+            if (!CountPrimitive(doc, doc.meshes[instance.mesh].primitives[instance.primitive],
+                                job.vertexCount, job.indexCount)) {
+                ++skipped;
+                continue;
+            }
+            job.vertexOffset = vertexTotal;
+            job.indexOffset = indexTotal;
+            vertexTotal += job.vertexCount;
+            indexTotal += job.indexCount;
+            jobs.push_back(job);
+        }
+
+        if (skipped > 0) {
+            QuoteSystem::Instance().Log("GltfLoader: skipped " + std::to_string(skipped) +
+                " non-triangle or attribute-less primitive(s) in " + doc.path,
+                QuoteSystem::MessageType::WARNING);
+        }
+
+        // Guard: SoftwareMesh indices are 32-bit
+        if (vertexTotal > UINT32_MAX) {
+            QuoteSystem::Instance().Log("GltfLoader: " + doc.path + " exceeds 2^32 vertices",
+                QuoteSystem::MessageType::ERROR_MSG);
+            return false;
+        }
+
+        outMesh.vertexStride = SOFTWARE_MESH_STRIDE;
+        outMesh.vertices.assign(vertexTotal * SOFTWARE_MESH_STRIDE, 0.0f);
+        outMesh.indices.assign(indexTotal, 0);
+
+        float* vertexBase = outMesh.vertices.data();
+        uint32_t* indexBase = outMesh.indices.data();
+        RunJobs(jobs, [&](const Job& job) {
+            DecodePrimitive(doc, job, vertexBase + job.vertexOffset * SOFTWARE_MESH_STRIDE,
+                            indexBase + job.indexOffset, static_cast<uint32_t>(job.vertexOffset));
+        });
+
+        return true;
+    }
+
+    // One SoftwareMesh per primitive instance, for callers that keep draw calls separate.
+    // outSources (optional) receives the mesh/primitive each output came from.
+    static bool DecodePrimitives(const GltfDocument& doc, std::vector<SoftwareMesh>& outMeshes,
+                                 std::vector<GltfPrimitiveRef>* outSources = nullptr) {
+        std::vector<Job> jobs;
+        for (const PrimitiveInstance& instance : CollectInstances(doc)) {
+            Job job;
+            job.instance = instance;
+            if (CountPrimitive(doc, doc.meshes[instance.mesh].primitives[instance.primitive],
+                               job.vertexCount, job.indexCount)) {
+                job.vertexOffset = jobs.size();    // Reused as the output slot
+                jobs.push_back(job);
+            }
+        }
+
+        outMeshes.assign(jobs.size(), SoftwareMesh());
+        if (outSources != nullptr) {
+            outSources->resize(jobs.size());
+        }
+        for (const Job& job : jobs) {
+            if (outSources != nullptr) {
+                (*outSources)[job.vertexOffset] = { job.instance.mesh, job.instance.primitive };
+            }
+            SoftwareMesh& mesh = outMeshes[job.vertexOffset];
+            mesh.vertexStride = SOFTWARE_MESH_STRIDE;
+            mesh.vertices.assign(job.vertexCount * SOFTWARE_MESH_STRIDE, 0.0f);
+            mesh.indices.assign(job.indexCount, 0);
+        }
+
+        RunJobs(jobs, [&](const Job& job) {
+            SoftwareMesh& mesh = outMeshes[job.vertexOffset];
+            DecodePrimitive(doc, job, mesh.vertices.data(), mesh.indices.data(), 0);
+        });
+
+        return true;
+    }
+
+    // Parse + DecodeMerged with renderer logging; used by SoftwareRenderService::LoadMesh
+    static bool Load(const std::string& path, SoftwareMesh& outMesh) {
+        GltfDocument doc;
+        std::string error;
+        if (!Parse(path, doc, &error)) {
+            QuoteSystem::Instance().Log("GltfLoader: " + path + " - " + error,
+                QuoteSystem::MessageType::ERROR_MSG);
+            DebugWindow::Instance().Post("Renderer", "glTF parse failed: " + error, DebugWindow::DebugLevel::ERR);
+            return false;
+        }
+
+        if (!DecodeMerged(doc, outMesh)) {
+            return false;
+        }
+
+        DebugWindow::Instance().Post("Renderer", "glTF loaded: " + path + " (" +
+            std::to_string(outMesh.vertices.size() / SOFTWARE_MESH_STRIDE) + " verts, " +
+            std::to_string(outMesh.indices.size() / 3) + " tris)", DebugWindow::DebugLevel::INFO);
+        return true;
+    }
+
+    // Write a GLB of roughly targetBytes made of grid patches. Attributes use a mix of
+    // float, normalized byte and normalized ushort so every conversion path is exercised.
+    static bool WriteSyntheticGlb(const std::string& path, uint64_t targetBytes, uint32_t primitiveCount) {
+        // Guard: nothing to write
+        if (primitiveCount == 0 || targetBytes == 0) {
+            return false;
+        }
+
+        // Per grid vertex: 12 position + 4 normal + 4 uv + ~24 bytes of indices
+        constexpr uint64_t BYTES_PER_VERTEX = 44;
+        uint64_t verticesPerPrimitive = std::max<uint64_t>(4, targetBytes / BYTES_PER_VERTEX / primitiveCount);
+        uint32_t side = static_cast<uint32_t>(std::max<double>(2.0, std::floor(std::sqrt(static_cast<double>(verticesPerPrimitive)))));
+        uint64_t vertexCount = static_cast<uint64_t>(side) * side;
+        uint64_t indexCount = static_cast<uint64_t>(side - 1) * (side - 1) * 6;
+
+        uint64_t positionBytes = vertexCount * 12;
+        uint64_t normalBytes = vertexCount * 4;
+        uint64_t uvBytes = vertexCount * 4;
+        uint64_t indexBytes = indexCount * 4;
+        uint64_t primitiveBytes = positionBytes + normalBytes + uvBytes + indexBytes;
+        uint64_t binBytes = primitiveBytes * primitiveCount;
+
+        // One mesh per primitive, one node per mesh, laid out on a grid so bounds differ
+        std::string json;
+        json.reserve(512 + primitiveCount * 600);
+        json += "{\"asset\":{\"version\":\"2.0\",\"generator\":\"BrightForge synthetic\"},";
+        json += "\"buffers\":[{\"byteLength\":" + std::to_string(binBytes) + "}],";
+
+        std::string views = "\"bufferViews\":[";
+        std::string accessors = "\"accessors\":[";
+        std::string meshes = "\"meshes\":[";
+        std::string nodes = "\"nodes\":[";
+        std::string rootList = "\"scenes\":[{\"nodes\":[";
+        uint32_t columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(primitiveCount))));
+
+        for (uint32_t p = 0; p < primitiveCount; ++p) {
+            uint64_t base = static_cast<uint64_t>(p) * primitiveBytes;
+            uint32_t v = p * 4;
+            std::string sep = p == 0 ? "" : ",";
+
+            views += sep + "{\"buffer\":0,\"byteOffset\":" + std::to_string(base) +
+                ",\"byteLength\":" + std::to_string(positionBytes) + "}";
+            views += ",{\"buffer\":0,\"byteOffset\":" + std::to_string(base + positionBytes) +
+                ",\"byteLength\":" + std::to_string(normalBytes) + ",\"byteStride\":4}";
+            views += ",{\"buffer\":0,\"byteOffset\":" + std::to_string(base + positionBytes + normalBytes) +
+                ",\"byteLength\":" + std::to_string(uvBytes) + "}";
+            views += ",{\"buffer\":0,\"byteOffset\":" + std::to_string(base + positionBytes + normalBytes + uvBytes) +
+                ",\"byteLength\":" + std::to_string(indexBytes) + "}";
+
+            std::string count = std::to_string(vertexCount);
+            accessors += sep + "{\"bufferView\":" + std::to_string(v) +
+                ",\"componentType\":5126,\"type\":\"VEC3\",\"count\":" + count + "}";
+            accessors += ",{\"bufferView\":" + std::to_string(v + 1) +
+                ",\"componentType\":5120,\"normalized\":true,\"type\":\"VEC3\",\"count\":" + count + "}";
+            accessors += ",{\"bufferView\":" + std::to_string(v + 2) +
+                ",\"componentType\":5123,\"normalized\":true,\"type\":\"VEC2\",\"count\":" + count + "}";
+            accessors += ",{\"bufferView\":" + std::to_string(v + 3) +
+                ",\"componentType\":5125,\"type\":\"SCALAR\",\"count\":" + std::to_string(indexCount) + "}";
+
+            meshes += sep + "{\"primitives\":[{\"attributes\":{\"POSITION\":" + std::to_string(v) +
+                ",\"NORMAL\":" + std::to_string(v + 1) + ",\"TEXCOORD_0\":" + std::to_string(v + 2) +
+                "},\"indices\":" + std::to_string(v + 3) + "}]}";
+
+            float x = static_cast<float>(p % columns) * 1.1f;
+            float z = static_cast<float>(p / columns) * 1.1f;
+            nodes += sep + "{\"mesh\":" + std::to_string(p) + ",\"translation\":[" +
+                std::to_string(x) + ",0," + std::to_string(z) + "]}";
+            rootList += sep + std::to_string(p);
+        }
+
+        json += views + "]," + accessors + "]," + meshes + "]," + nodes + "]," + rootList + "]}],\"scene\":0}";
+        while (json.size() % 4 != 0) {
+            json += ' ';
+        }
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            QuoteSystem::Instance().Log("GltfLoader: cannot write " + path, QuoteSystem::MessageType::ERROR_MSG);
+            return false;
+        }
+
+        uint64_t totalBytes = GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE * 2 + json.size() + binBytes;
+        if (totalBytes > UINT32_MAX) {
+            QuoteSystem::Instance().Log("GltfLoader: synthetic scene exceeds the 4 GB GLB limit",
+                QuoteSystem::MessageType::ERROR_MSG);
+            return false;
+        }
+
+        WriteU32(out, GLB_MAGIC);
+        WriteU32(out, 2);
+        WriteU32(out, static_cast<uint32_t>(totalBytes));
+        WriteU32(out, static_cast<uint32_t>(json.size()));
+        WriteU32(out, GLB_CHUNK_JSON);
+        out.write(json.data(), static_cast<std::streamsize>(json.size()));
+        WriteU32(out, static_cast<uint32_t>(binBytes));
+        WriteU32(out, GLB_CHUNK_BIN);
+
+        // Every primitive shares the same grid, so build it once and write it N times
+        std::vector<uint8_t> block(static_cast<size_t>(primitiveBytes));
+        uint8_t* cursor = block.data();
+        float inv = 1.0f / static_cast<float>(side - 1);
+        for (uint32_t y = 0; y < side; ++y) {
+            for (uint32_t x = 0; x < side; ++x) {
+                float position[3] = { x * inv, 0.05f * std::sin(x * inv * 6.2831853f), y * inv };
+                std::memcpy(cursor, position, 12);
+                cursor += 12;
+            }
+        }
+        for (uint64_t i = 0; i < vertexCount; ++i) {
+            int8_t normal[4] = { 0, 127, 0, 0 };
+            std::memcpy(cursor, normal, 4);
+            cursor += 4;
+        }
+        for (uint32_t y = 0; y < side; ++y) {
+            for (uint32_t x = 0; x < side; ++x) {
+                uint16_t uv[2] = { static_cast<uint16_t>(x * inv * 65535.0f), static_cast<uint16_t>(y * inv * 65535.0f) };
+                std::memcpy(cursor, uv, 4);
+                cursor += 4;
+            }
+        }
+        for (uint32_t y = 0; y + 1 < side; ++y) {
+            for (uint32_t x = 0; x + 1 < side; ++x) {
+                uint32_t i0 = y * side + x;
+                uint32_t quad[6] = { i0, i0 + side, i0 + 1, i0 + 1, i0 + side, i0 + side + 1 };
+                std::memcpy(cursor, quad, 24);
+                cursor += 24;
+            }
+        }
+
+        for (uint32_t p = 0; p < primitiveCount; ++p) {
+            out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+        }
+
+        return static_cast<bool>(out);
+    }
+
+    // Write a GLB with one node per mesh. Positions carry the min/max bounds the spec
+    // requires; indices are always 32-bit. Materials keep their name and base colour.
+    static bool WriteGlb(const std::string& path, const std::vector<GltfExportMesh>& meshes,
+                         const std::vector<GltfMaterial>& materials, std::string* error = nullptr) {
+        std::string views, accessors, meshList, nodes, roots;
+        std::vector<const SoftwareMesh*> sources;
+        uint64_t binBytes = 0;
+        uint32_t viewCount = 0;
+        uint32_t accessorCount = 0;
+
+        // Every view is a multiple of 4 bytes, so offsets stay aligned without padding
+        auto addView = [&](uint64_t byteLength, uint32_t target) {
+            views += std::string(viewCount == 0 ? "" : ",") + "{\"buffer\":0,\"byteOffset\":" + std::to_string(binBytes) +
+                ",\"byteLength\":" + std::to_string(byteLength) + ",\"target\":" + std::to_string(target) + "}";
+            binBytes += byteLength;
+            return viewCount++;
+        };
+        auto addAccessor = [&](uint32_t view, const char* type, const std::string& count, uint32_t componentType,
+                               const std::string& extra) {
+            accessors += std::string(accessorCount == 0 ? "" : ",") + "{\"bufferView\":" + std::to_string(view) +
+                ",\"componentType\":" + std::to_string(componentType) + ",\"type\":\"" + type + "\",\"count\":" +
+                count + extra + "}";
+            ++accessorCount;
+        };
+
+        for (size_t m = 0; m < meshes.size(); ++m) {
+            const GltfExportMesh& entry = meshes[m];
+            const SoftwareMesh* mesh = entry.mesh;
+            if (mesh == nullptr || mesh->vertexStride < 3 ||
+                (entry.material >= 0 && static_cast<size_t>(entry.material) >= materials.size())) {
+                return Fail(error, "mesh '" + entry.name + "' has no data or an out-of-range material");
+            }
+            // glTF has no empty accessors, so callers drop meshes that decimated away
+            const size_t vertexCount = mesh->vertices.size() / mesh->vertexStride;
+            if (vertexCount == 0 || mesh->indices.empty()) {
+                return Fail(error, "mesh '" + entry.name + "' is empty");
+            }
+            for (uint32_t index : mesh->indices) {
+                if (index >= vertexCount) {
+                    return Fail(error, "mesh '" + entry.name + "' has out-of-range indices");
+                }
+            }
+
+            float boundsMin[3] = { 0.0f, 0.0f, 0.0f };
+            float boundsMax[3] = { 0.0f, 0.0f, 0.0f };
+            for (size_t v = 0; v < vertexCount; ++v) {
+                const float* p = &mesh->vertices[v * mesh->vertexStride];
+                for (int axis = 0; axis < 3; ++axis) {
+                    boundsMin[axis] = v == 0 ? p[axis] : std::min(boundsMin[axis], p[axis]);
+                    boundsMax[axis] = v == 0 ? p[axis] : std::max(boundsMax[axis], p[axis]);
+                }
+            }
+
+            // One tightly packed view and accessor per attribute present in the layout
+            std::string count = std::to_string(vertexCount);
+            std::string attributes = "\"POSITION\":" + std::to_string(accessorCount);
+            addAccessor(addView(vertexCount * 12, 34962), "VEC3", count, 5126, ",\"min\":[" +
+                FormatFloat(boundsMin[0]) + "," + FormatFloat(boundsMin[1]) + "," + FormatFloat(boundsMin[2]) + "],\"max\":[" +
+                FormatFloat(boundsMax[0]) + "," + FormatFloat(boundsMax[1]) + "," + FormatFloat(boundsMax[2]) + "]");
+            if (mesh->vertexStride >= 6) {
+                attributes += ",\"NORMAL\":" + std::to_string(accessorCount);
+                addAccessor(addView(vertexCount * 12, 34962), "VEC3", count, 5126, "");
+            }
+            if (mesh->vertexStride >= 8) {
+                attributes += ",\"TEXCOORD_0\":" + std::to_string(accessorCount);
+                addAccessor(addView(vertexCount * 8, 34962), "VEC2", count, 5126, "");
+            }
+            uint32_t indexAccessor = accessorCount;
+            addAccessor(addView(mesh->indices.size() * 4, 34963), "SCALAR", std::to_string(mesh->indices.size()), 5125, "");
+
+            std::string sep = m == 0 ? "" : ",";
+            meshList += sep + "{\"name\":" + JsonBinding::StringLiteral(entry.name) +
+                ",\"primitives\":[{\"attributes\":{" + attributes + "},\"indices\":" + std::to_string(indexAccessor) +
+                (entry.material >= 0 ? ",\"material\":" + std::to_string(entry.material) : std::string()) + "}]}";
+            nodes += sep + "{\"name\":" + JsonBinding::StringLiteral(entry.name) + ",\"mesh\":" +
+                std::to_string(m) + "}";
+            roots += sep + std::to_string(m);
+            sources.push_back(mesh);
+        }
+
+        std::string materialList;
+        for (size_t m = 0; m < materials.size(); ++m) {
+            const GltfMaterial& material = materials[m];
+            materialList += std::string(m == 0 ? "" : ",") + "{\"name\":" +
+                JsonBinding::StringLiteral(material.name) + ",\"pbrMetallicRoughness\":{\"baseColorFactor\":[" +
+                FormatFloat(material.baseColor[0]) + "," +
+                FormatFloat(material.baseColor[1]) + "," + FormatFloat(material.baseColor[2]) + "," +
+                FormatFloat(material.baseColor[3]) + "]}}";
+        }
+
+        std::string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"BrightForge\"},\"scene\":0,"
+            "\"scenes\":[{\"nodes\":[" + roots + "]}],\"nodes\":[" + nodes + "],\"meshes\":[" + meshList + "]," +
+            (materials.empty() ? std::string() : "\"materials\":[" + materialList + "],") +
+            "\"accessors\":[" + accessors + "],\"bufferViews\":[" + views + "],"
+            "\"buffers\":[{\"byteLength\":" + std::to_string(binBytes) + "}]}";
+        while (json.size() % 4 != 0) {
+            json += ' ';
+        }
+
+        uint64_t totalBytes = GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE * 2 + json.size() + binBytes;
+        if (totalBytes > UINT32_MAX) {
+            return Fail(error, "scene exceeds the 4 GB GLB limit");
+        }
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return Fail(error, "cannot write " + path);
+        }
+        WriteU32(out, GLB_MAGIC);
+        WriteU32(out, 2);
+        WriteU32(out, static_cast<uint32_t>(totalBytes));
+        WriteU32(out, static_cast<uint32_t>(json.size()));
+        WriteU32(out, GLB_CHUNK_JSON);
+        out.write(json.data(), static_cast<std::streamsize>(json.size()));
+        WriteU32(out, static_cast<uint32_t>(binBytes));
+        WriteU32(out, GLB_CHUNK_BIN);
+
+        // Same order as the views: positions, normals, uvs, indices per mesh
+        std::vector<float> column;
+        for (const SoftwareMesh* mesh : sources) {
+            const size_t vertexCount = mesh->vertices.size() / mesh->vertexStride;
+            for (uint32_t first : { 0u, 3u, 6u }) {
+                uint32_t width = first == 6 ? 2 : 3;
+                if (first + width > mesh->vertexStride) {
+                    break;
+                }
+                column.resize(vertexCount * width);
+                for (size_t v = 0; v < vertexCount; ++v) {
+                    std::memcpy(&column[v * width], &mesh->vertices[v * mesh->vertexStride + first], width * sizeof(float));
+                }
+                out.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(column.size() * sizeof(float)));
+            }
+            out.write(reinterpret_cast<const char*>(mesh->indices.data()),
+                      static_cast<std::streamsize>(mesh->indices.size() * sizeof(uint32_t)));
+        }
+
+        if (!out) {
+            return Fail(error, "cannot write " + path);
+        }
+        return true;
+    }
+
+    // Benchmarks every .glb/.gltf under sampleDir (e.g. a checkout of the Khronos
+    // glTF-Sample-Models repo) plus a synthetic scene of syntheticBytes.
+    // Pass syntheticBytes = 0 to skip the synthetic scene.
+    static void RegisterBenchmarks(const std::string& sampleDir, uint64_t syntheticBytes = GLTF_SYNTHETIC_SCENE_BYTES) {
+        TestManagerNew& tests = TestManagerNew::Instance();
+
+        std::error_code ec;
+        if (!sampleDir.empty() && std::filesystem::is_directory(sampleDir, ec)) {
+            for (auto it = std::filesystem::recursive_directory_iterator(sampleDir, ec);
+                 !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+                if (!it->is_regular_file(ec) || !IsGltfPath(it->path().string())) {
+                    continue;
+                }
+
+                std::string path = it->path().string();
+                std::string name = std::filesystem::relative(it->path(), sampleDir, ec).generic_string();
+                tests.AddBenchmark("GltfLoader", "Load " + name, [path]() {
+                    GltfDocument doc;
+                    SoftwareMesh mesh;
+                    if (Parse(path, doc) && DecodeMerged(doc, mesh)) {
+                        TestManagerNew::DoNotOptimize(mesh.vertices.data());
+                    }
+                });
+            }
+        } else if (!sampleDir.empty()) {
+            QuoteSystem::Instance().Log("GltfLoader: sample model directory not found - " + sampleDir,
+                QuoteSystem::MessageType::WARNING);
+        }
+
+        if (syntheticBytes == 0) {
+            return;
+        }
+
+        // Cached in the temp directory; regenerated only when the size changes
+        std::string path = (std::filesystem::temp_directory_path(ec) /
+            ("brightforge_synthetic_" + std::to_string(syntheticBytes >> 20) + "MB.glb")).string();
+        if (!std::filesystem::exists(path, ec) || std::filesystem::file_size(path, ec) < syntheticBytes / 2) {
+            if (!WriteSyntheticGlb(path, syntheticBytes, GLTF_SYNTHETIC_PRIMITIVES)) {
+                return;
+            }
+        }
+
+        // Each sample decodes ~1 GB, so keep the sample count low
+        TestManagerNew::BenchmarkOptions options;
+        options.warmupIterations = 1;
+        options.sampleCount = 5;
+        options.minSampleTimeMs = 0.0;
+
+        tests.AddBenchmark("GltfLoader", "Parse synthetic scene", [path]() {
+            GltfDocument doc;
+            Parse(path, doc);
+            TestManagerNew::DoNotOptimize(doc.accessors.size());
+        });
+        tests.AddBenchmark("GltfLoader", "Decode synthetic scene", [path]() {
+            GltfDocument doc;
+            SoftwareMesh mesh;
+            if (Parse(path, doc) && DecodeMerged(doc, mesh)) {
+                TestManagerNew::DoNotOptimize(mesh.vertices.data());
+            }
+        }, options);
+    }
+
+    // Correctness checks against a small generated file
+    static void RegisterTests() {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        tests.RegisterSuite("GltfLoader");
+
+        tests.AddTest("GltfLoader", "Synthetic GLB round trip", []() {
+            std::error_code ec;
+            std::string path = (std::filesystem::temp_directory_path(ec) / "brightforge_gltf_test.glb").string();
+            if (!WriteSyntheticGlb(path, 64 * 1024, 3)) {
+                return false;
+            }
+
+            GltfDocument doc;
+            SoftwareMesh mesh;
+            bool ok = Parse(path, doc) && DecodeMerged(doc, mesh);
+            GltfLoadStats stats = Measure(doc);
+            ok = ok && stats.primitiveCount == 3 &&
+                 mesh.vertices.size() == stats.vertexCount * SOFTWARE_MESH_STRIDE &&
+                 mesh.indices.size() == stats.indexCount;
+
+            // Normals decode from normalized bytes to +Y; indices of the last patch are rebased
+            ok = ok && std::fabs(mesh.vertices[4] - 1.0f) < 1e-6f;
+            ok = ok && *std::max_element(mesh.indices.begin(), mesh.indices.end()) == stats.vertexCount - 1;
+
+            std::filesystem::remove(path, ec);
+            return ok;
+        });
+
+        tests.AddTest("GltfLoader", "Rejects truncated GLB", []() {
+            std::error_code ec;
+            std::string path = (std::filesystem::temp_directory_path(ec) / "brightforge_gltf_truncated.glb").string();
+            {
+                std::ofstream out(path, std::ios::binary | std::ios::trunc);
+                WriteU32(out, GLB_MAGIC);
+                WriteU32(out, 2);
+                WriteU32(out, 4096);
+            }
+
+            GltfDocument doc;
+            bool rejected = !Parse(path, doc);
+            std::filesystem::remove(path, ec);
+            return rejected;
+        });
+
+        tests.AddTest("GltfLoader", "WriteGlb round trip", []() {
+            std::error_code ec;
+            std::string path = (std::filesystem::temp_directory_path(ec) / "brightforge_gltf_write.glb").string();
+            SoftwareMesh full;
+            full.vertices = { 0,0,0, 0,0,1, 0,0,  1,0,0, 0,0,1, 1,0,  0,1,0, 0,0,1, 0,1,  1,1,0, 0,0,1, 1,1 };
+            full.indices = { 0, 1, 2, 1, 3, 2 };
+            SoftwareMesh positionsOnly;
+            positionsOnly.vertexStride = 3;
+            positionsOnly.vertices = { 0,0,2, 1,0,2, 0,1,2 };
+            positionsOnly.indices = { 0, 1, 2 };
+
+            std::vector<GltfMaterial> materials(1);
+            materials[0].name = "Quote\"d";
+            materials[0].baseColor = { 0.25f, 0.5f, 1.0f, 1.0f };
+            GltfDocument doc;
+            std::vector<SoftwareMesh> decoded;
+            std::vector<GltfPrimitiveRef> sources;
+            bool ok = WriteGlb(path, { { "Quad", &full, 0 }, { "Tri", &positionsOnly, -1 } }, materials) &&
+                      Parse(path, doc) && DecodePrimitives(doc, decoded, &sources) && decoded.size() == 2 &&
+                      doc.materials.size() == 1 && doc.materials[0].name == "Quote\"d" &&
+                      doc.materials[0].baseColor[1] == 0.5f && doc.meshes[sources[0].mesh].name == "Quad" &&
+                      doc.meshes[sources[0].mesh].primitives[0].material == 0 &&
+                      decoded[0].vertices == full.vertices && decoded[0].indices == full.indices &&
+                      decoded[1].indices == positionsOnly.indices && decoded[1].vertices[2] == 2.0f &&
+                      !WriteGlb(path, { { "Empty", &decoded[1], 3 } }, materials);
+            std::filesystem::remove(path, ec);
+            return ok;
+        });
+    }
+
+    // Prevent instantiation (static API)
+    GltfLoader() = delete;
+
+private:
+    static constexpr uint64_t GLTF_SYNTHETIC_SCENE_BYTES = 1ull << 30;
+    static constexpr uint32_t GLTF_SYNTHETIC_PRIMITIVES = 256;
+    static constexpr size_t MAX_NODE_DEPTH = 256;
+
+    using Token = JsonReader::Token;
+    using TokenType = JsonReader::TokenType;
+    using Matrix4 = std::array<float, 16>;
+
+    using PrimitiveInstance = GltfPrimitiveInstance;
+
+    struct Job {
+        PrimitiveInstance instance;
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        size_t vertexOffset = 0;
+        size_t indexOffset = 0;
+    };
+
+    static bool Fail(std::string* error, const std::string& message) {
+        if (error != nullptr) {
+            *error = message;
+        }
+        return false;
+    }
+
+    static uint32_t ReadU32(const uint8_t* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static void WriteU32(std::ofstream& out, uint32_t value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    // Shortest text that reads back to the same float
+    static std::string FormatFloat(float value) {
+        char text[32];
+        auto result = std::to_chars(text, text + sizeof(text), std::isfinite(value) ? value : 0.0f);
+        return std::string(text, result.ptr);
+    }
+
+
+    // ---- Container ---------------------------------------------------------
+
+    static bool SplitGlb(const uint8_t* data, size_t size, std::string_view& json,
+                         GltfDocument::BufferRange& bin, std::string* error) {
+        uint32_t version = ReadU32(data + 4);
+        uint32_t length = ReadU32(data + 8);
+        if (version != 2) {
+            return Fail(error, "unsupported GLB version " + std::to_string(version));
+        }
+        if (length > size) {
+            return Fail(error, "GLB header length exceeds file size (truncated file?)");
+        }
+
+        size_t offset = GLB_HEADER_SIZE;
+        while (offset + GLB_CHUNK_HEADER_SIZE <= length) {
+            uint32_t chunkLength = ReadU32(data + offset);
+            uint32_t chunkType = ReadU32(data + offset + 4);
+            offset += GLB_CHUNK_HEADER_SIZE;
+            if (chunkLength > length - offset) {
+                return Fail(error, "GLB chunk overruns file");
+            }
+
+            if (chunkType == GLB_CHUNK_JSON && json.empty()) {
+                json = std::string_view(reinterpret_cast<const char*>(data + offset), chunkLength);
+            } else if (chunkType == GLB_CHUNK_BIN && bin.data == nullptr) {
+                bin.data = data + offset;
+                bin.size = chunkLength;
+            }
+
+            // Chunks are 4-byte aligned
+            offset += (static_cast<size_t>(chunkLength) + 3) & ~static_cast<size_t>(3);
+        }
+
+        if (json.empty()) {
+            return Fail(error, "GLB has no JSON chunk");
+        }
+        return true;
+    }
+
+    // ---- JSON --------------------------------------------------------------
+    // Small combinators over JsonReader. Each callback receives the first token of a
+    // value and must consume the whole value (SkipValue for anything it ignores).
+
+    template <typename Fn>
+    static bool ForEachMember(JsonReader& reader, const Token& open, Fn&& fn) {
+        if (open.type != TokenType::OBJECT_BEGIN) {
+            return false;
+        }
+
+        Token token = reader.Next();
+        if (token.type == TokenType::OBJECT_END) {
+            return true;
+        }
+
+        while (true) {
+            if (token.type != TokenType::STRING || reader.Next().type != TokenType::COLON) {
+                return false;
+            }
+
+            Token value = reader.Next();
+            if (!fn(token.text, value)) {
+                return false;
+            }
+
+            token = reader.Next();
+            if (token.type == TokenType::OBJECT_END) {
+                return true;
+            }
+            if (token.type != TokenType::COMMA) {
+                return false;
+            }
+            token = reader.Next();
+        }
+    }
+
+    template <typename Fn>
+    static bool ForEachElement(JsonReader& reader, const Token& open, Fn&& fn) {
+        if (open.type != TokenType::ARRAY_BEGIN) {
+            return false;
+        }
+
+        Token token = reader.Next();
+        if (token.type == TokenType::ARRAY_END) {
+            return true;
+        }
+
+        while (true) {
+            if (!fn(token)) {
+                return false;
+            }
+
+            token = reader.Next();
+            if (token.type == TokenType::ARRAY_END) {
+                return true;
+            }
+            if (token.type != TokenType::COMMA) {
+                return false;
+            }
+            token = reader.Next();
+        }
+    }
+
+    template <typename T>
+    static bool ToNumber(const Token& token, T& out) {
+        if (token.type != TokenType::NUMBER) {
+            return false;
+        }
+        const char* first = token.text.data();
+        const char* last = first + token.text.size();
+        if constexpr (std::is_floating_point_v<T>) {
+            return std::from_chars(first, last, out).ec == std::errc();
+        } else {
+            // Integers may be written as 12.0 by some exporters
+            double value = 0.0;
+            if (std::from_chars(first, last, value).ec != std::errc() || value < 0.0) {
+                return false;
+            }
+            out = static_cast<T>(value);
+            return true;
+        }
+    }
+
+    static bool ToIndex(const Token& token, int32_t& out) {
+        uint32_t value = 0;
+        if (!ToNumber(token, value)) {
+            return false;
+        }
+        out = static_cast<int32_t>(value);
+        return true;
+    }
+
+    template <size_t N>
+    static bool ToFloats(JsonReader& reader, const Token& open, std::array<float, N>& out) {
+        size_t i = 0;
+        return ForEachElement(reader, open, [&](const Token& t) {
+            return i < N && ToNumber(t, out[i++]);
+        }) && i == N;
+    }
+
+    static uint32_t ComponentsForType(std::string_view type) {
+        if (type == "SCALAR") return 1;
+        if (type == "VEC2") return 2;
+        if (type == "VEC3") return 3;
+        if (type == "VEC4") return 4;
+        if (type == "MAT2") return 4;
+        if (type == "MAT3") return 9;
+        if (type == "MAT4") return 16;
+        return 0;
+    }
+
+    static bool ParseJson(std::string_view json, GltfDocument& doc, std::vector<std::string>& bufferUris,
+                          std::string* error) {
+        JsonReader reader(json);
+        std::vector<size_t> bufferLengths;
+        std::string unsupported;
+
+        bool ok = ForEachMember(reader, reader.Next(), [&](std::string_view key, const Token& value) {
+            if (key == "buffers") {
+                return ForEachElement(reader, value, [&](const Token& item) {
+                    std::string uri;
+                    size_t length = 0;
+                    bool parsed = ForEachMember(reader, item, [&](std::string_view k, const Token& v) {
+                        if (k == "uri" && v.type == TokenType::STRING) {
+                            uri = v.hasEscapes ? JsonReader::Unescape(v.text) : std::string(v.text);
+                            return true;
+                        }
+                        if (k == "byteLength") return ToNumber(v, length);
+                        return reader.SkipValue(v);
+                    });
+                    bufferUris.push_back(std::move(uri));
+                    bufferLengths.push_back(length);
+                    return parsed;
+                });
+            }
+            if (key == "bufferViews") {
+                return ForEachElement(reader, value, [&](const Token& item) {
+                    GltfBufferView view;
+                    bool parsed = ForEachMember(reader, item, [&](std::string_view k, const Token& v) {
+                        if (k == "buffer") return ToNumber(v, view.buffer);
+                        if (k == "byteOffset") return ToNumber(v, view.byteOffset);
+                        if (k == "byteLength") return ToNumber(v, view.byteLength);
+                        if (k == "byteStride") return ToNumber(v, view.byteStride);
+                        return reader.SkipValue(v);
+                    });
+                    doc.bufferViews.push_back(view);
+                    return parsed;
+                });
+            }
+            if (key == "accessors") {
+                return ForEachElement(reader, value, [&](const Token& item) {
+                    GltfAccessor accessor;
+                    bool parsed = ForEachMember(reader, item, [&](std::string_view k, const Token& v) {
+                        if (k == "bufferView") return ToIndex(v, accessor.bufferView);
+                        if (k == "byteOffset") return ToNumber(v, accessor.byteOffset);
+                        if (k == "componentType") return ToNumber(v, accessor.componentType);
+                        if (k == "count") return ToNumber(v, accessor.count);
+                        if (k == "normalized") {
+                            accessor.normalized = v.type == TokenType::TRUE_VALUE;
+                            return true;
+                        }
+                        if (k == "type" && v.type == TokenType::STRING) {
+                            accessor.components = ComponentsForType(v.text);
+                            return true;
+                        }
+                        if (k == "sparse") {
+                            accessor.hasSparse = true;
+                            return ParseSparse(reader, v, accessor.sparse);
+                        }
+                        return reader.SkipValue(v);
+                    });
+                    doc.accessors.push_back(accessor);
+                    return parsed;
+                });
+            }
+            if (key == "meshes") {
+                return ForEachElement(reader, value, [&](const Token& item) {
+                    GltfMesh mesh;
+                    bool parsed = ForEachMember(reader, item, [&](std::string_view k, const Token& v) {
+                        if (k == "name" && v.type == TokenType::STRING) {
+                            mesh.name = v.hasEscapes ? JsonReader::Unescape(v.text) : std::string(v.text);
+                            return true;
+                        }
+                        if (k == "primitives") {
+                            return ForEachElement(reader, v, [&](const Token& p) {
+                                GltfPrimitive primitive;
+                                bool parsedPrimitive = ParsePrimitive(reader, p, primitive);
+                                mesh.primitives.push_back(primitive);
+                                return parsedPrimitive;
+                            });
+                        }
+                        return reader.SkipValue(v);
+                    });
+                    doc.meshes.push_back(std::move(mesh));
+                    return parsed;
+                });
+            }
+            if (key == "materials") {
+                return ForEachElement(reader, value, [&](const Token& item) {
+                    GltfMaterial material;
+                    bool parsed = ForEachMember(reader, item, [&](std::string_view k, const Token& v) {
+                        if (k == "name" && v.type == TokenType::STRING) {
+                            material.name = v.hasEscapes ? JsonReader::Unescape(v.text) : std::string(v.text);
+                            return true;
+                        }
+                        if (k == "pbrMetallicRoughness") {
+                            return ForEachMember(reader, v, [&](std::string_view pk, const Token& pv) {
+                                if (pk == "baseColorFactor") return ToFloats(reader, pv, material.baseColor);
+                                return reader.SkipValue(pv);
+                            });
+                        }
+                        return reader.SkipValue(v);
+                    });
+                    doc.materials.push_back(std::move(material));
+                    return parsed;
+                });
+            }
+            if (key == "nodes") {
+                return ForEachElement(reader, value, [&](const Token& item) {
+                    GltfNode node;
+                    bool parsed = ParseNode(reader, item, node);
+                    doc.nodes.push_back(std::move(node));
+                    return parsed;
+                });
+            }
+            if (key == "scenes") {
+                return ForEachElement(reader, value, [&](const Token& item) {
+                    std::vector<uint32_t> roots;
+                    bool parsed = ForEachMember(reader, item, [&](std::string_view k, const Token& v) {
+                        if (k == "nodes") {
+                            return ForEachElement(reader, v, [&](const Token& n) {
+                                uint32_t index = 0;
+                                roots.push_back(index);
+                                return ToNumber(n, roots.back());
+                            });
+                        }
+                        return reader.SkipValue(v);
+                    });
+                    doc.scenes.push_back(std::move(roots));
+                    return parsed;
+                });
+            }
+            if (key == "scene") {
+                return ToIndex(value, doc.scene);
+            }
+            if (key == "extensionsRequired") {
+                // Compressed geometry needs a decoder we do not ship
+                return ForEachElement(reader, value, [&](const Token& ext) {
+                    if (ext.type == TokenType::STRING &&
+                        (ext.text == "KHR_draco_mesh_compression" || ext.text == "EXT_meshopt_compression")) {
+                        unsupported = std::string(ext.text);
+                    }
+                    return JsonReader::IsScalar(ext.type);
+                });
+            }
+            return reader.SkipValue(value);
+        });
+
+        if (!ok) {
+            std::string detail = reader.GetError().empty() ? "malformed glTF JSON" : reader.GetError();
+            return Fail(error, detail + " at offset " + std::to_string(reader.GetOffset()));
+        }
+        if (!unsupported.empty()) {
+            return Fail(error, "required extension not supported: " + unsupported);
+        }
+
+        // Sizes only; ResolveBuffers() fills in the data pointers
+        doc.buffers.resize(bufferLengths.size());
+        for (size_t i = 0; i < bufferLengths.size(); ++i) {
+            doc.buffers[i].size = bufferLengths[i];
+        }
+        return true;
+    }
+
+    static bool ParseSparse(JsonReader& reader, const Token& open, GltfSparse& sparse) {
+        return ForEachMember(reader, open, [&](std::string_view k, const Token& v) {
+            if (k == "count") return ToNumber(v, sparse.count);
+            if (k == "indices") {
+                return ForEachMember(reader, v, [&](std::string_view ik, const Token& iv) {
+                    if (ik == "bufferView") return ToIndex(iv, sparse.indicesView);
+                    if (ik == "byteOffset") return ToNumber(iv, sparse.indicesOffset);
+                    if (ik == "componentType") return ToNumber(iv, sparse.indicesComponentType);
+                    return reader.SkipValue(iv);
+                });
+            }
+            if (k == "values") {
+                return ForEachMember(reader, v, [&](std::string_view vk, const Token& vv) {
+                    if (vk == "bufferView") return ToIndex(vv, sparse.valuesView);
+                    if (vk == "byteOffset") return ToNumber(vv, sparse.valuesOffset);
+                    return reader.SkipValue(vv);
+                });
+            }
+            return reader.SkipValue(v);
+        });
+    }
+
+    static bool ParsePrimitive(JsonReader& reader, const Token& open, GltfPrimitive& primitive) {
+        return ForEachMember(reader, open, [&](std::string_view k, const Token& v) {
+            if (k == "attributes") {
+                return ForEachMember(reader, v, [&](std::string_view name, const Token& a) {
+                    if (name == "POSITION") return ToIndex(a, primitive.position);
+                    if (name == "NORMAL") return ToIndex(a, primitive.normal);
+                    if (name == "TEXCOORD_0") return ToIndex(a, primitive.texcoord0);
+                    return reader.SkipValue(a);
+                });
+            }
+            if (k == "indices") return ToIndex(v, primitive.indices);
+            if (k == "material") return ToIndex(v, primitive.material);
+            if (k == "mode") return ToNumber(v, primitive.mode);
+            return reader.SkipValue(v);
+        });
+    }
+
+    static bool ParseNode(JsonReader& reader, const Token& open, GltfNode& node) {
+        std::array<float, 3> translation = { 0, 0, 0 };
+        std::array<float, 4> rotation = { 0, 0, 0, 1 };
+        std::array<float, 3> scale = { 1, 1, 1 };
+        bool hasTrs = false;
+
+        bool parsed = ForEachMember(reader, open, [&](std::string_view k, const Token& v) {
+            if (k == "mesh") return ToIndex(v, node.mesh);
+            if (k == "matrix") return ToFloats(reader, v, node.matrix);
+            if (k == "translation") { hasTrs = true; return ToFloats(reader, v, translation); }
+            if (k == "rotation") { hasTrs = true; return ToFloats(reader, v, rotation); }
+            if (k == "scale") { hasTrs = true; return ToFloats(reader, v, scale); }
+            if (k == "children") {
+                return ForEachElement(reader, v, [&](const Token& c) {
+                    node.children.push_back(0);
+                    return ToNumber(c, node.children.back());
+                });
+            }
+            return reader.SkipValue(v);
+        });
+
+        if (hasTrs) {
+            node.matrix = ComposeTrs(translation, rotation, scale);
+        }
+        return parsed;
+    }
+
+    // ---- Buffers -----------------------------------------------------------
+
+    static bool ResolveBuffers(GltfDocument& doc, const std::vector<std::string>& uris,
+                               const GltfDocument::BufferRange& binChunk, std::string* error) {
+        std::filesystem::path baseDir = std::filesystem::path(doc.path).parent_path();
+        doc.externalFiles.reserve(uris.size());
+
+        for (size_t i = 0; i < doc.buffers.size(); ++i) {
+            GltfDocument::BufferRange& buffer = doc.buffers[i];
+            std::string uri = i < uris.size() ? uris[i] : std::string();
+
+            if (uri.empty()) {
+                // GLB-stored buffer (only buffer 0 may reference the BIN chunk)
+                if (i != 0 || binChunk.data == nullptr) {
+                    return Fail(error, "buffer " + std::to_string(i) + " has no uri and no BIN chunk");
+                }
+                if (binChunk.size < buffer.size) {
+                    return Fail(error, "BIN chunk shorter than buffer byteLength");
+                }
+                buffer.data = binChunk.data;
+            } else if (uri.compare(0, 5, "data:") == 0) {
+                size_t comma = uri.find(',');
+                if (comma == std::string::npos || uri.rfind(";base64", comma) == std::string::npos) {
+                    return Fail(error, "buffer " + std::to_string(i) + " has a non-base64 data URI");
+                }
+                doc.embeddedData.push_back(DecodeBase64(std::string_view(uri).substr(comma + 1)));
+                buffer.data = doc.embeddedData.back().data();
+                if (doc.embeddedData.back().size() < buffer.size) {
+                    return Fail(error, "buffer " + std::to_string(i) + " data URI shorter than byteLength");
+                }
+            } else {
+                BrightForge::MappedFile external;
+                std::string externalPath = (baseDir / DecodeUriPath(uri)).string();
+                if (!external.Open(externalPath)) {
+                    return Fail(error, external.GetError());
+                }
+                if (external.Size() < buffer.size) {
+                    return Fail(error, externalPath + " is shorter than byteLength");
+                }
+                buffer.data = external.Data();
+                doc.externalFiles.push_back(std::move(external));
+            }
+        }
+        return true;
+    }
+
+    static std::string DecodeUriPath(const std::string& uri) {
+        std::string out;
+        out.reserve(uri.size());
+        for (size_t i = 0; i < uri.size(); ++i) {
+            unsigned int code = 0;
+            if (uri[i] == '%' && i + 2 < uri.size() &&
+                std::from_chars(uri.data() + i + 1, uri.data() + i + 3, code, 16).ec == std::errc()) {
+                out.push_back(static_cast<char>(code));
+                i += 2;
+            } else {
+                out.push_back(uri[i]);
+            }
+        }
+        return out;
+    }
+
+    static std::vector<uint8_t> DecodeBase64(std::string_view text) {
+        std::vector<uint8_t> out;
+        out.reserve(text.size() * 3 / 4);
+        uint32_t accumulator = 0;
+        int bits = 0;
+        for (char c : text) {
+            int value;
+            if (c >= 'A' && c <= 'Z') value = c - 'A';
+            else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+            else if (c >= '0' && c <= '9') value = c - '0' + 52;
+            else if (c == '+' || c == '-') value = 62;
+            else if (c == '/' || c == '_') value = 63;
+            else continue;    // Padding and whitespace
+
+            accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                out.push_back(static_cast<uint8_t>((accumulator >> bits) & 0xFF));
+            }
+        }
+        return out;
+    }
+
+    // Bounds-check every view and accessor once so decoding can run unchecked
+    static bool Validate(const GltfDocument& doc, std::string* error) {
+        for (size_t i = 0; i < doc.bufferViews.size(); ++i) {
+            const GltfBufferView& view = doc.bufferViews[i];
+            if (view.buffer >= doc.buffers.size() ||
+                view.byteOffset + view.byteLength > doc.buffers[view.buffer].size) {
+                return Fail(error, "bufferView " + std::to_string(i) + " is out of range");
+            }
+        }
+
+        for (size_t i = 0; i < doc.accessors.size(); ++i) {
+            const GltfAccessor& accessor = doc.accessors[i];
+            size_t elementSize = GltfDocument::ElementSize(accessor);
+            if (elementSize == 0) {
+                return Fail(error, "accessor " + std::to_string(i) + " has an unknown type or componentType");
+            }
+
+            if (accessor.bufferView >= 0 && static_cast<size_t>(accessor.bufferView) >= doc.bufferViews.size()) {
+                return Fail(error, "accessor " + std::to_string(i) + " references a missing bufferView");
+            }
+
+            if (accessor.bufferView >= 0 && accessor.count > 0) {
+                const GltfBufferView& view = doc.bufferViews[accessor.bufferView];
+                size_t stride = view.byteStride != 0 ? view.byteStride : elementSize;
+                size_t end = accessor.byteOffset + stride * (accessor.count - 1) + elementSize;
+                if (end > view.byteLength) {
+                    return Fail(error, "accessor " + std::to_string(i) + " overruns its bufferView");
+                }
+            }
+
+            if (accessor.hasSparse) {
+                const GltfSparse& sparse = accessor.sparse;
+                size_t indexSize = GltfDocument::ComponentSize(sparse.indicesComponentType);
+                if (!IsIndexType(sparse.indicesComponentType) ||
+                    !SparseViewFits(doc, sparse.indicesView, sparse.indicesOffset, indexSize * sparse.count) ||
+                    !SparseViewFits(doc, sparse.valuesView, sparse.valuesOffset, elementSize * sparse.count)) {
+                    return Fail(error, "accessor " + std::to_string(i) + " has an invalid sparse block");
+                }
+            }
+        }
+
+        for (size_t m = 0; m < doc.meshes.size(); ++m) {
+            for (const GltfPrimitive& primitive : doc.meshes[m].primitives) {
+                for (int32_t index : { primitive.position, primitive.normal, primitive.texcoord0, primitive.indices }) {
+                    if (index >= 0 && static_cast<size_t>(index) >= doc.accessors.size()) {
+                        return Fail(error, "mesh " + std::to_string(m) + " references a missing accessor");
+                    }
+                }
+                if (primitive.indices >= 0 && !IsIndexType(doc.accessors[primitive.indices].componentType)) {
+                    return Fail(error, "mesh " + std::to_string(m) + " has a non-integer index accessor");
+                }
+            }
+        }
+
+        for (size_t n = 0; n < doc.nodes.size(); ++n) {
+            const GltfNode& node = doc.nodes[n];
+            if (node.mesh >= 0 && static_cast<size_t>(node.mesh) >= doc.meshes.size()) {
+                return Fail(error, "node " + std::to_string(n) + " references a missing mesh");
+            }
+            for (uint32_t child : node.children) {
+                if (child >= doc.nodes.size()) {
+                    return Fail(error, "node " + std::to_string(n) + " references a missing child");
+                }
+            }
+        }
+        return true;
+    }
+
+    static bool IsIndexType(uint32_t componentType) {
+        return componentType == static_cast<uint32_t>(GltfComponentType::UNSIGNED_BYTE) ||
+               componentType == static_cast<uint32_t>(GltfComponentType::UNSIGNED_SHORT) ||
+               componentType == static_cast<uint32_t>(GltfComponentType::UNSIGNED_INT);
+    }
+
+    static bool SparseViewFits(const GltfDocument& doc, int32_t viewIndex, size_t offset, size_t bytes) {
+        if (viewIndex < 0 || static_cast<size_t>(viewIndex) >= doc.bufferViews.size()) {
+            return false;
+        }
+        return offset + bytes <= doc.bufferViews[viewIndex].byteLength;
+    }
+
+    // ---- Scene -------------------------------------------------------------
+
+    static std::vector<PrimitiveInstance> CollectInstances(const GltfDocument& doc) {
+        std::vector<PrimitiveInstance> instances;
+
+        // No node hierarchy: every mesh at the origin
+        if (doc.nodes.empty()) {
+            for (uint32_t m = 0; m < doc.meshes.size(); ++m) {
+                for (uint32_t p = 0; p < doc.meshes[m].primitives.size(); ++p) {
+                    PrimitiveInstance instance;
+                    instance.mesh = m;
+                    instance.primitive = p;
+                    instances.push_back(instance);
+                }
+            }
+            return instances;
+        }
+
+        std::vector<uint32_t> roots;
+        if (!doc.scenes.empty()) {
+            size_t sceneIndex = doc.scene >= 0 && static_cast<size_t>(doc.scene) < doc.scenes.size()
+                ? static_cast<size_t>(doc.scene) : 0;
+            roots = doc.scenes[sceneIndex];
+        } else {
+            // No scenes: treat every node that is nobody's child as a root
+            std::vector<bool> isChild(doc.nodes.size(), false);
+            for (const GltfNode& node : doc.nodes) {
+                for (uint32_t child : node.children) {
+                    isChild[child] = true;
+                }
+            }
+            for (uint32_t n = 0; n < doc.nodes.size(); ++n) {
+                if (!isChild[n]) {
+                    roots.push_back(n);
+                }
+            }
+        }
+
+        Matrix4 identity = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+        for (uint32_t root : roots) {
+            if (root < doc.nodes.size()) {
+                VisitNode(doc, root, identity, 0, instances);
+            }
+        }
+        return instances;
+    }
+
+    static void VisitNode(const GltfDocument& doc, uint32_t nodeIndex, const Matrix4& parent,
+                          size_t depth, std::vector<PrimitiveInstance>& instances) {
+        // Guard: cyclic or absurdly deep hierarchy
+        if (depth > MAX_NODE_DEPTH) {
+            return;
+        }
+
+        const GltfNode& node = doc.nodes[nodeIndex];
+        Matrix4 world = Multiply(parent, node.matrix);
+
+        if (node.mesh >= 0) {
+            const GltfMesh& mesh = doc.meshes[node.mesh];
+            bool identity = IsIdentity(world);
+            for (uint32_t p = 0; p < mesh.primitives.size(); ++p) {
+                PrimitiveInstance instance;
+                instance.mesh = static_cast<uint32_t>(node.mesh);
+                instance.primitive = p;
+                instance.world = world;
+                instance.identity = identity;
+                instances.push_back(instance);
+            }
+        }
+
+        for (uint32_t child : node.children) {
+            VisitNode(doc, child, world, depth + 1, instances);
+        }
+    }
+
+    static Matrix4 Multiply(const Matrix4& a, const Matrix4& b) {
+        Matrix4 out{};
+        for (int col = 0; col < 4; ++col) {
+            for (int row = 0; row < 4; ++row) {
+                float sum = 0.0f;
+                for (int k = 0; k < 4; ++k) {
+                    sum += a[k * 4 + row] * b[col * 4 + k];
+                }
+                out[col * 4 + row] = sum;
+            }
+        }
+        return out;
+    }
+
+    static Matrix4 ComposeTrs(const std::array<float, 3>& t, const std::array<float, 4>& q,
+                              const std::array<float, 3>& s) {
+        float x = q[0], y = q[1], z = q[2], w = q[3];
+        Matrix4 m = {
+            (1 - 2 * (y * y + z * z)) * s[0], (2 * (x * y + z * w)) * s[0],     (2 * (x * z - y * w)) * s[0],     0,
+            (2 * (x * y - z * w)) * s[1],     (1 - 2 * (x * x + z * z)) * s[1], (2 * (y * z + x * w)) * s[1],     0,
+            (2 * (x * z + y * w)) * s[2],     (2 * (y * z - x * w)) * s[2],     (1 - 2 * (x * x + y * y)) * s[2], 0,
+            t[0], t[1], t[2], 1
+        };
+        return m;
+    }
+
+    static bool IsIdentity(const Matrix4& m) {
+        for (int i = 0; i < 16; ++i) {
+            if (m[i] != ((i % 5 == 0) ? 1.0f : 0.0f)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // ---- Decoding ----------------------------------------------------------
+
+    static bool CountPrimitive(const GltfDocument& doc, const GltfPrimitive& primitive,
+                               size_t& vertexCount, size_t& indexCount) {
+        if (primitive.position < 0) {
+            return false;
+        }
+
+        vertexCount = doc.accessors[primitive.position].count;
+        size_t sourceCount = primitive.indices >= 0 ? doc.accessors[primitive.indices].count : vertexCount;
+
+        switch (static_cast<GltfPrimitiveMode>(primitive.mode)) {
+            case GltfPrimitiveMode::TRIANGLES:
+                indexCount = sourceCount - sourceCount % 3;
+                return true;
+            case GltfPrimitiveMode::TRIANGLE_STRIP:
+            case GltfPrimitiveMode::TRIANGLE_FAN:
+                indexCount = sourceCount >= 3 ? (sourceCount - 2) * 3 : 0;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Run jobs on the shared pool, largest first so one huge primitive does not end up last
+    template <typename Fn>
+    static void RunJobs(std::vector<Job>& jobs, Fn&& fn) {
+        std::sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) {
+            return a.vertexCount + a.indexCount > b.vertexCount + b.indexCount;
+        });
+
+        Parallel::For(jobs.size(), [&](size_t i) {
+            fn(jobs[i]);
+        });
+    }
+
+    static float ReadComponent(const uint8_t* p, uint32_t componentType, bool normalized) {
+        switch (static_cast<GltfComponentType>(componentType)) {
+            case GltfComponentType::FLOAT: {
+                float v;
+                std::memcpy(&v, p, 4);
+                return v;
+            }
+            case GltfComponentType::BYTE: {
+                int8_t v = static_cast<int8_t>(*p);
+                return normalized ? std::max(v / 127.0f, -1.0f) : static_cast<float>(v);
+            }
+            case GltfComponentType::UNSIGNED_BYTE:
+                return normalized ? *p / 255.0f : static_cast<float>(*p);
+            case GltfComponentType::SHORT: {
+                int16_t v;
+                std::memcpy(&v, p, 2);
+                return normalized ? std::max(v / 32767.0f, -1.0f) : static_cast<float>(v);
+            }
+            case GltfComponentType::UNSIGNED_SHORT: {
+                uint16_t v;
+                std::memcpy(&v, p, 2);
+                return normalized ? v / 65535.0f : static_cast<float>(v);
+            }
+            case GltfComponentType::UNSIGNED_INT: {
+                uint32_t v;
+                std::memcpy(&v, p, 4);
+                return static_cast<float>(v);
+            }
+            default:
+                return 0.0f;
+        }
+    }
+
+    static uint32_t ReadIndex(const uint8_t* p, uint32_t componentType) {
+        switch (static_cast<GltfComponentType>(componentType)) {
+            case GltfComponentType::UNSIGNED_BYTE:
+                return *p;
+            case GltfComponentType::UNSIGNED_SHORT: {
+                uint16_t v;
+                std::memcpy(&v, p, 2);
+                return v;
+            }
+            default: {
+                uint32_t v;
+                std::memcpy(&v, p, 4);
+                return v;
+            }
+        }
+    }
+
+    // Convert up to `components` floats per element into out[i * outStride + outOffset]
+    static void ReadFloats(const GltfDocument& doc, const GltfAccessor& accessor, uint32_t components,
+                           float* out, size_t outStride) {
+        uint32_t n = std::min(components, accessor.components);
+        size_t componentSize = GltfDocument::ComponentSize(accessor.componentType);
+        size_t elementSize = componentSize * accessor.components;
+
+        if (accessor.bufferView >= 0) {
+            const GltfBufferView& view = doc.bufferViews[accessor.bufferView];
+            size_t stride = view.byteStride != 0 ? view.byteStride : elementSize;
+            const uint8_t* src = doc.buffers[view.buffer].data + view.byteOffset + accessor.byteOffset;
+
+            if (accessor.componentType == static_cast<uint32_t>(GltfComponentType::FLOAT)) {
+                // Fast path: plain floats, one memcpy per element
+                for (size_t i = 0; i < accessor.count; ++i) {
+                    std::memcpy(out + i * outStride, src + i * stride, n * sizeof(float));
+                }
+            } else {
+                for (size_t i = 0; i < accessor.count; ++i) {
+                    const uint8_t* element = src + i * stride;
+                    float* dst = out + i * outStride;
+                    for (uint32_t c = 0; c < n; ++c) {
+                        dst[c] = ReadComponent(element + c * componentSize, accessor.componentType, accessor.normalized);
+                    }
+                }
+            }
+        } else {
+            for (size_t i = 0; i < accessor.count; ++i) {
+                std::fill_n(out + i * outStride, n, 0.0f);
+            }
+        }
+
+        if (!accessor.hasSparse) {
+            return;
+        }
+
+        // Sparse substitution: values are tightly packed in their own view
+        const GltfSparse& sparse = accessor.sparse;
+        const GltfBufferView& indexView = doc.bufferViews[sparse.indicesView];
+        const GltfBufferView& valueView = doc.bufferViews[sparse.valuesView];
+        const uint8_t* indexData = doc.buffers[indexView.buffer].data + indexView.byteOffset + sparse.indicesOffset;
+        const uint8_t* valueData = doc.buffers[valueView.buffer].data + valueView.byteOffset + sparse.valuesOffset;
+        size_t indexSize = GltfDocument::ComponentSize(sparse.indicesComponentType);
+
+        for (size_t s = 0; s < sparse.count; ++s) {
+            uint32_t target = ReadIndex(indexData + s * indexSize, sparse.indicesComponentType);
+            if (target >= accessor.count) {
+                continue;
+            }
+            const uint8_t* element = valueData + s * elementSize;
+            float* dst = out + static_cast<size_t>(target) * outStride;
+            for (uint32_t c = 0; c < n; ++c) {
+                dst[c] = ReadComponent(element + c * componentSize, accessor.componentType, accessor.normalized);
+            }
+        }
+    }
+
+    // Dense + sparse index accessor flattened to uint32 (rare; normal index buffers are read in place)
+    static std::vector<uint32_t> ResolveIndices(const GltfDocument& doc, const GltfAccessor& accessor) {
+        std::vector<uint32_t> out(accessor.count, 0);
+        size_t indexSize = GltfDocument::ComponentSize(accessor.componentType);
+
+        if (accessor.bufferView >= 0) {
+            const GltfBufferView& view = doc.bufferViews[accessor.bufferView];
+            size_t stride = view.byteStride != 0 ? view.byteStride : indexSize;
+            const uint8_t* src = doc.buffers[view.buffer].data + view.byteOffset + accessor.byteOffset;
+            for (size_t i = 0; i < accessor.count; ++i) {
+                out[i] = ReadIndex(src + i * stride, accessor.componentType);
+            }
+        }
+
+        if (accessor.hasSparse) {
+            const GltfSparse& sparse = accessor.sparse;
+            const GltfBufferView& indexView = doc.bufferViews[sparse.indicesView];
+            const GltfBufferView& valueView = doc.bufferViews[sparse.valuesView];
+            const uint8_t* targets = doc.buffers[indexView.buffer].data + indexView.byteOffset + sparse.indicesOffset;
+            const uint8_t* values = doc.buffers[valueView.buffer].data + valueView.byteOffset + sparse.valuesOffset;
+            size_t targetSize = GltfDocument::ComponentSize(sparse.indicesComponentType);
+            for (size_t s = 0; s < sparse.count; ++s) {
+                uint32_t target = ReadIndex(targets + s * targetSize, sparse.indicesComponentType);
+                if (target < out.size()) {
+                    out[target] = ReadIndex(values + s * indexSize, accessor.componentType);
+                }
+            }
+        }
+        return out;
+    }
+
+    static void DecodePrimitive(const GltfDocument& doc, const Job& job, float* vertices,
+                                uint32_t* indices, uint32_t baseVertex) {
+        const GltfPrimitive& primitive = doc.meshes[job.instance.mesh].primitives[job.instance.primitive];
+
+        // Interleave attributes straight into the output slice
+        ReadFloats(doc, doc.accessors[primitive.position], 3, vertices, SOFTWARE_MESH_STRIDE);
+        if (primitive.normal >= 0) {
+            ReadFloats(doc, doc.accessors[primitive.normal], 3, vertices + 3, SOFTWARE_MESH_STRIDE);
+        }
+        if (primitive.texcoord0 >= 0) {
+            ReadFloats(doc, doc.accessors[primitive.texcoord0], 2, vertices + 6, SOFTWARE_MESH_STRIDE);
+        }
+
+        // Indices are read in place; sparse index accessors are flattened first
+        const uint8_t* indexData = nullptr;
+        size_t indexStride = 0;
+        uint32_t indexType = static_cast<uint32_t>(GltfComponentType::UNSIGNED_INT);
+        std::vector<uint32_t> resolved;
+        if (primitive.indices >= 0) {
+            const GltfAccessor& accessor = doc.accessors[primitive.indices];
+            if (accessor.hasSparse || accessor.bufferView < 0) {
+                resolved = ResolveIndices(doc, accessor);
+                indexData = reinterpret_cast<const uint8_t*>(resolved.data());
+                indexStride = sizeof(uint32_t);
+            } else {
+                const GltfBufferView& view = doc.bufferViews[accessor.bufferView];
+                indexData = doc.buffers[view.buffer].data + view.byteOffset + accessor.byteOffset;
+                indexType = accessor.componentType;
+                indexStride = view.byteStride != 0 ? view.byteStride : GltfDocument::ComponentSize(indexType);
+            }
+        }
+
+        // Non-indexed primitives use the implicit 0..n-1 sequence
+        auto source = [&](size_t i) -> uint32_t {
+            return indexData != nullptr ? ReadIndex(indexData + i * indexStride, indexType) : static_cast<uint32_t>(i);
+        };
+
+        uint32_t vertexCount = static_cast<uint32_t>(job.vertexCount);
+        auto emit = [&](size_t slot, uint32_t index) {
+            // Out-of-range indices collapse to vertex 0 instead of reading past the slice
+            indices[slot] = baseVertex + (index < vertexCount ? index : 0);
+        };
+
+        switch (static_cast<GltfPrimitiveMode>(primitive.mode)) {
+            case GltfPrimitiveMode::TRIANGLE_STRIP:
+                for (size_t t = 0; t * 3 < job.indexCount; ++t) {
+                    // Alternate winding so every triangle keeps the strip's orientation
+                    uint32_t a = source(t);
+                    uint32_t b = source(t + 1);
+                    uint32_t c = source(t + 2);
+                    emit(t * 3, a);
+                    emit(t * 3 + 1, (t & 1) ? c : b);
+                    emit(t * 3 + 2, (t & 1) ? b : c);
+                }
+                break;
+            case GltfPrimitiveMode::TRIANGLE_FAN: {
+                uint32_t hub = job.indexCount > 0 ? source(0) : 0;
+                for (size_t t = 0; t * 3 < job.indexCount; ++t) {
+                    emit(t * 3, hub);
+                    emit(t * 3 + 1, source(t + 1));
+                    emit(t * 3 + 2, source(t + 2));
+                }
+                break;
+            }
+            default:
+                for (size_t i = 0; i < job.indexCount; ++i) {
+                    emit(i, source(i));
+                }
+                break;
+        }
+
+        if (!job.instance.identity) {
+            TransformVertices(job.instance.world, vertices, job.vertexCount);
+        }
+
+        if (primitive.normal < 0) {
+            GenerateNormals(vertices, job.vertexCount, indices, job.indexCount, baseVertex);
+        }
+    }
+
+    static void TransformVertices(const Matrix4& m, float* vertices, size_t count) {
+        // Normals use the inverse-transpose of the upper 3x3 (cofactor matrix; scale drops out on normalize)
+        float n[9] = {
+            m[5] * m[10] - m[6] * m[9], m[6] * m[8] - m[4] * m[10], m[4] * m[9] - m[5] * m[8],
+            m[9] * m[2] - m[10] * m[1], m[10] * m[0] - m[8] * m[2], m[8] * m[1] - m[9] * m[0],
+            m[1] * m[6] - m[2] * m[5], m[2] * m[4] - m[0] * m[6], m[0] * m[5] - m[1] * m[4]
+        };
+
+        for (size_t i = 0; i < count; ++i) {
+            float* v = vertices + i * SOFTWARE_MESH_STRIDE;
+            float x = v[0], y = v[1], z = v[2];
+            v[0] = m[0] * x + m[4] * y + m[8] * z + m[12];
+            v[1] = m[1] * x + m[5] * y + m[9] * z + m[13];
+            v[2] = m[2] * x + m[6] * y + m[10] * z + m[14];
+
+            float nx = v[3], ny = v[4], nz = v[5];
+            float tx = n[0] * nx + n[3] * ny + n[6] * nz;
+            float ty = n[1] * nx + n[4] * ny + n[7] * nz;
+            float tz = n[2] * nx + n[5] * ny + n[8] * nz;
+            float length = std::sqrt(tx * tx + ty * ty + tz * tz);
+            if (length > 0.0f) {
+                v[3] = tx / length;
+                v[4] = ty / length;
+                v[5] = tz / length;
+            }
+        }
+    }
+
+    // Area-weighted smooth normals for primitives exported without NORMAL
+    static void GenerateNormals(float* vertices, size_t vertexCount, const uint32_t* indices,
+                                size_t indexCount, uint32_t baseVertex) {
+        for (size_t i = 0; i + 2 < indexCount; i += 3) {
+            float* a = vertices + (indices[i] - baseVertex) * SOFTWARE_MESH_STRIDE;
+            float* b = vertices + (indices[i + 1] - baseVertex) * SOFTWARE_MESH_STRIDE;
+            float* c = vertices + (indices[i + 2] - baseVertex) * SOFTWARE_MESH_STRIDE;
+            float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+            float face[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+            for (float* v : { a, b, c }) {
+                v[3] += face[0];
+                v[4] += face[1];
+                v[5] += face[2];
+            }
+        }
+
+        for (size_t i = 0; i < vertexCount; ++i) {
+            float* v = vertices + i * SOFTWARE_MESH_STRIDE;
+            float length = std::sqrt(v[3] * v[3] + v[4] * v[4] + v[5] * v[5]);
+            if (length > 0.0f) {
+                v[3] /= length;
+                v[4] /= length;
+                v[5] /= length;
+            } else {
+                v[4] = 1.0f;
+            }
+        }
+    }
+};
+
+// Note on usage:
+// SoftwareRenderService::LoadMesh routes .glb/.gltf paths through GltfLoader::Load.
+// Tools that need per-primitive draw calls call Parse() + DecodePrimitives() instead.
+// GltfDocument::GetView<T>() hands out zero-copy views for uploads that can consume
+// the source layout directly (e.g. tightly packed float positions).
+//
+// Only POSITION, NORMAL and TEXCOORD_0 are decoded; materials are recorded per primitive
+// but not yet resolved. Draco/meshopt-compressed files are rejected with a clear error.
@@ -0,0 +1,398 @@
+/** HdrLoader - Radiance .hdr (RGBE) reader
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "../core/QuoteSystem.h"
+#include "../core/DebugWindow.h"
+#include "../core/Parallel.h"
+#include "../core/TestManagerNew.h"
+#include "../filesystem/MappedFile.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define BF_HDR_SSE2 1
+#endif
+
+// Linear RGBA32F image (alpha is always 1); rows top to bottom
+struct HdrImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<float> pixels;
+
+    const float* Pixel(uint32_t x, uint32_t y) const {
+        return pixels.data() + (static_cast<size_t>(y) * width + x) * 4;
+    }
+};
+
+// HdrLoader - stateless entry points
+// Scanlines are RLE-decoded sequentially into an RGBE buffer (run lengths make row
+// starts unknowable without decoding), then RGBE -> float runs in parallel row
+// blocks, four pixels per SSE2 instruction sequence.
+class HdrLoader {
+public:
+    static bool Load(const std::string& path, HdrImage& outImage, std::string* error = nullptr) {
+        BrightForge::MappedFile file;
+        if (!file.Open(path)) {
+            return Fail(error, file.GetError());
+        }
+
+        if (!LoadMemory(file.Data(), file.Size(), outImage, error)) {
+            return false;
+        }
+
+        DebugWindow::Instance().Post("Renderer", "HDR loaded: " + path + " (" + std::to_string(outImage.width) +
+            "x" + std::to_string(outImage.height) + ")", DebugWindow::DebugLevel::INFO);
+        return true;
+    }
+
+    static bool LoadMemory(const uint8_t* data, size_t size, HdrImage& outImage, std::string* error = nullptr) {
+        outImage = HdrImage();
+
+        size_t offset = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        bool bottomUp = false;
+        if (!ParseHeader(data, size, offset, width, height, bottomUp, error)) {
+            return false;
+        }
+
+        // RGBE staging buffer, one row per scanline in file order
+        std::vector<uint8_t> rgbe(static_cast<size_t>(width) * height * 4);
+        for (uint32_t row = 0; row < height; ++row) {
+            uint8_t* destination = rgbe.data() + static_cast<size_t>(row) * width * 4;
+            if (!DecodeScanline(data, size, offset, destination, width)) {
+                return Fail(error, "HDR scanline " + std::to_string(row) + " is corrupt or truncated");
+            }
+        }
+
+        outImage.width = width;
+        outImage.height = height;
+        outImage.pixels.resize(static_cast<size_t>(width) * height * 4);
+
+        Parallel::ForRange(height, ROWS_PER_TASK, [&](size_t begin, size_t end) {
+            for (size_t row = begin; row < end; ++row) {
+                size_t target = bottomUp ? height - 1 - row : row;
+                ConvertRgbe(rgbe.data() + row * width * 4, outImage.pixels.data() + target * width * 4, width);
+            }
+        });
+        return true;
+    }
+
+    // RGBE -> linear float for `count` pixels (RGBA out, alpha = 1)
+    static void ConvertRgbe(const uint8_t* rgbe, float* out, size_t count) {
+        size_t i = 0;
+
+#if defined(BF_HDR_SSE2)
+        // value = mantissa * 2^(e - 128) / 256; the 2^(e - 128) scale is built directly
+        // as float bits (biased exponent e - 1), so only e <= 1 (denormal results, or
+        // e == 0 meaning black) flush to zero
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi32(1);
+        const __m128 mantissaScale = _mm_set1_ps(1.0f / 256.0f);
+        const __m128 alphaMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        for (; i + 4 <= count; i += 4) {
+            __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgbe + i * 4));
+            __m128i low = _mm_unpacklo_epi8(packed, zero);
+            __m128i high = _mm_unpackhi_epi8(packed, zero);
+            __m128i pixels[4] = {
+                _mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero),
+                _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero)
+            };
+
+            for (int p = 0; p < 4; ++p) {
+                __m128i exponent = _mm_sub_epi32(_mm_shuffle_epi32(pixels[p], _MM_SHUFFLE(3, 3, 3, 3)), bias);
+                exponent = _mm_and_si128(exponent, _mm_cmpgt_epi32(exponent, zero));
+                __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(exponent, 23));
+                __m128 value = _mm_mul_ps(_mm_mul_ps(_mm_cvtepi32_ps(pixels[p]), mantissaScale), scale);
+                value = _mm_or_ps(_mm_andnot_ps(alphaMask, value), _mm_and_ps(alphaMask, one));
+                _mm_storeu_ps(out + (i + p) * 4, value);
+            }
+        }
+#endif
+
+        for (; i < count; ++i) {
+            const uint8_t* p = rgbe + i * 4;
+            float* o = out + i * 4;
+            if (p[3] == 0) {
+                o[0] = o[1] = o[2] = 0.0f;
+            } else {
+                float scale = std::ldexp(1.0f, static_cast<int>(p[3]) - 136);
+                o[0] = p[0] * scale;
+                o[1] = p[1] * scale;
+                o[2] = p[2] * scale;
+            }
+            o[3] = 1.0f;
+        }
+    }
+
+    // Correctness checks on generated images
+    static void RegisterTests() {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        tests.RegisterSuite("HdrLoader");
+
+        tests.AddTest("HdrLoader", "RLE and flat scanlines decode identically", []() {
+            const uint32_t width = 37;
+            const uint32_t height = 3;
+            std::vector<uint8_t> pixels(width * height * 4);
+            for (size_t i = 0; i < width * height; ++i) {
+                // Runs in the first half of each row, noise in the second
+                uint8_t v = static_cast<uint8_t>((i % width) < width / 2 ? 128 : (i * 37) & 0xFF);
+                pixels[i * 4 + 0] = v;
+                pixels[i * 4 + 1] = static_cast<uint8_t>(255 - v);
+                pixels[i * 4 + 2] = 64;
+                pixels[i * 4 + 3] = static_cast<uint8_t>(i % 7 == 0 ? 0 : 129);
+            }
+
+            HdrImage rle;
+            HdrImage flat;
+            std::vector<uint8_t> rleFile = EncodeTestFile(pixels, width, height, true);
+            std::vector<uint8_t> flatFile = EncodeTestFile(pixels, width, height, false);
+            if (!LoadMemory(rleFile.data(), rleFile.size(), rle) ||
+                !LoadMemory(flatFile.data(), flatFile.size(), flat)) {
+                return false;
+            }
+
+            // e = 129 -> scale 2^-7; 128 * 2^-7 = 1.0
+            return rle.pixels == flat.pixels && rle.width == width &&
+                   std::fabs(rle.Pixel(1, 0)[0] - 1.0f) < 1e-6f && rle.Pixel(0, 0)[0] == 0.0f;
+        });
+
+        tests.AddTest("HdrLoader", "SIMD matches scalar conversion", []() {
+            std::vector<uint8_t> rgbe(4 * 1031);
+            for (size_t i = 0; i < rgbe.size(); ++i) {
+                rgbe[i] = static_cast<uint8_t>((i * 2654435761u) >> 13);
+            }
+            std::vector<float> fast(1031 * 4);
+            ConvertRgbe(rgbe.data(), fast.data(), 1031);
+            for (size_t i = 0; i < 1031; ++i) {
+                float reference[4];
+                const uint8_t* p = rgbe.data() + i * 4;
+                float scale = p[3] == 0 ? 0.0f : std::ldexp(1.0f, static_cast<int>(p[3]) - 136);
+                reference[0] = p[0] * scale;
+                reference[1] = p[1] * scale;
+                reference[2] = p[2] * scale;
+                for (int c = 0; c < 3; ++c) {
+                    // SSE2 flushes denormal results to zero
+                    if (fast[i * 4 + c] != reference[c] && std::fabs(reference[c]) > 1e-37f) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        });
+
+        tests.AddTest("HdrLoader", "Rejects truncated file", []() {
+            std::vector<uint8_t> pixels(16 * 16 * 4, 100);
+            std::vector<uint8_t> file = EncodeTestFile(pixels, 16, 16, true);
+            file.resize(file.size() - 10);
+            HdrImage image;
+            return !LoadMemory(file.data(), file.size(), image);
+        });
+    }
+
+    // Prevent instantiation (static API)
+    HdrLoader() = delete;
+
+private:
+    static constexpr size_t ROWS_PER_TASK = 16;
+    static constexpr uint32_t MAX_DIMENSION = 1u << 16;
+    static constexpr uint32_t RLE_MIN_WIDTH = 8;
+    static constexpr uint32_t RLE_MAX_WIDTH = 0x7FFF;
+
+    static bool Fail(std::string* error, const std::string& message) {
+        if (error != nullptr) {
+            *error = message;
+        }
+        return false;
+    }
+
+    static bool ReadLine(const uint8_t* data, size_t size, size_t& offset, std::string_view& line) {
+        size_t start = offset;
+        while (offset < size && data[offset] != '\n') {
+            ++offset;
+        }
+        if (offset >= size) {
+            return false;
+        }
+        line = std::string_view(reinterpret_cast<const char*>(data + start), offset - start);
+        ++offset;
+        return true;
+    }
+
+    static bool ParseHeader(const uint8_t* data, size_t size, size_t& offset, uint32_t& width,
+                            uint32_t& height, bool& bottomUp, std::string* error) {
+        std::string_view line;
+        if (!ReadLine(data, size, offset, line) || (line.rfind("#?RADIANCE", 0) != 0 && line.rfind("#?RGBE", 0) != 0)) {
+            return Fail(error, "missing #?RADIANCE signature");
+        }
+
+        // Variables until the blank line; only FORMAT matters for decoding
+        while (true) {
+            if (!ReadLine(data, size, offset, line)) {
+                return Fail(error, "HDR header not terminated");
+            }
+            if (line.empty()) {
+                break;
+            }
+            if (line.rfind("FORMAT=", 0) == 0 && line != "FORMAT=32-bit_rle_rgbe") {
+                return Fail(error, "unsupported HDR pixel format " + std::string(line.substr(7)));
+            }
+        }
+
+        // Resolution string: "-Y <h> +X <w>" (top-down) or "+Y <h> +X <w>" (bottom-up)
+        if (!ReadLine(data, size, offset, line)) {
+            return Fail(error, "HDR resolution line missing");
+        }
+
+        char ySign = 0;
+        char xSign = 0;
+        unsigned long h = 0;
+        unsigned long w = 0;
+        std::string resolution(line);
+        if (std::sscanf(resolution.c_str(), "%cY %lu %cX %lu", &ySign, &h, &xSign, &w) != 4 || xSign != '+' ||
+            (ySign != '-' && ySign != '+')) {
+            return Fail(error, "unsupported HDR orientation '" + resolution + "'");
+        }
+        if (w == 0 || h == 0 || w > MAX_DIMENSION || h > MAX_DIMENSION) {
+            return Fail(error, "HDR dimensions out of range");
+        }
+
+        width = static_cast<uint32_t>(w);
+        height = static_cast<uint32_t>(h);
+        bottomUp = ySign == '+';
+        return true;
+    }
+
+    static bool DecodeScanline(const uint8_t* data, size_t size, size_t& offset, uint8_t* out, uint32_t width) {
+        if (size - offset < 4) {
+            return false;
+        }
+
+        const uint8_t* p = data + offset;
+        bool adaptiveRle = width >= RLE_MIN_WIDTH && width <= RLE_MAX_WIDTH &&
+                           p[0] == 2 && p[1] == 2 && (p[2] & 0x80) == 0;
+        if (!adaptiveRle) {
+            return DecodeFlatScanline(data, size, offset, out, width);
+        }
+
+        if ((static_cast<uint32_t>(p[2]) << 8 | p[3]) != width) {
+            return false;
+        }
+        offset += 4;
+
+        // Channels are stored as four separate run-length planes
+        for (int channel = 0; channel < 4; ++channel) {
+            uint32_t x = 0;
+            while (x < width) {
+                if (offset >= size) {
+                    return false;
+                }
+                uint32_t count = data[offset++];
+                if (count > 128) {
+                    count -= 128;
+                    if (count > width - x || offset >= size) {
+                        return false;
+                    }
+                    uint8_t value = data[offset++];
+                    for (uint32_t i = 0; i < count; ++i) {
+                        out[(x + i) * 4 + channel] = value;
+                    }
+                } else {
+                    if (count == 0 || count > width - x || count > size - offset) {
+                        return false;
+                    }
+                    for (uint32_t i = 0; i < count; ++i) {
+                        out[(x + i) * 4 + channel] = data[offset + i];
+                    }
+                    offset += count;
+                }
+                x += count;
+            }
+        }
+        return true;
+    }
+
+    // Uncompressed pixels, possibly with the original (1,1,1,n) repeat codes
+    static bool DecodeFlatScanline(const uint8_t* data, size_t size, size_t& offset, uint8_t* out, uint32_t width) {
+        uint32_t x = 0;
+        int shift = 0;
+        while (x < width) {
+            if (size - offset < 4) {
+                return false;
+            }
+            const uint8_t* p = data + offset;
+            offset += 4;
+
+            if (p[0] == 1 && p[1] == 1 && p[2] == 1) {
+                if (x == 0) {
+                    return false;
+                }
+                uint64_t repeat = static_cast<uint64_t>(p[3]) << shift;
+                if (repeat > width - x) {
+                    return false;
+                }
+                for (uint64_t i = 0; i < repeat; ++i, ++x) {
+                    std::memcpy(out + x * 4, out + (x - 1) * 4, 4);
+                }
+                shift += 8;
+                continue;
+            }
+
+            std::memcpy(out + x * 4, p, 4);
+            ++x;
+            shift = 0;
+        }
+        return true;
+    }
+
+    static std::vector<uint8_t> EncodeTestFile(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, bool rle) {
+        std::string header = "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y " + std::to_string(height) +
+                             " +X " + std::to_string(width) + "\n";
+        std::vector<uint8_t> file(header.begin(), header.end());
+
+        for (uint32_t y = 0; y < height; ++y) {
+            const uint8_t* row = pixels.data() + static_cast<size_t>(y) * width * 4;
+            if (!rle) {
+                file.insert(file.end(), row, row + width * 4);
+                continue;
+            }
+
+            file.insert(file.end(), { 2, 2, static_cast<uint8_t>(width >> 8), static_cast<uint8_t>(width & 0xFF) });
+            for (int channel = 0; channel < 4; ++channel) {
+                uint32_t x = 0;
+                while (x < width) {
+                    uint32_t run = 1;
+                    while (x + run < width && run < 127 && row[(x + run) * 4 + channel] == row[x * 4 + channel]) {
+                        ++run;
+                    }
+                    if (run >= 3) {
+                        file.push_back(static_cast<uint8_t>(128 + run));
+                        file.push_back(row[x * 4 + channel]);
+                        x += run;
+                        continue;
+                    }
+                    uint32_t literal = std::min<uint32_t>(width - x, 128);
+                    literal = std::min<uint32_t>(literal, run);
+                    file.push_back(static_cast<uint8_t>(literal));
+                    for (uint32_t i = 0; i < literal; ++i) {
+                        file.push_back(row[(x + i) * 4 + channel]);
+                    }
+                    x += literal;
+                }
+            }
+        }
+        return file;
+    }
+};
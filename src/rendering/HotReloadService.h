@@ -0,0 +1,643 @@
+/** HotReloadService - Watches RenderConfig and shader sources and recompiles in the background
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "RenderConfig.h"
+#include "ShaderCompiler.h"
+#include "../core/QuoteSystem.h"
+#include "../core/DebugWindow.h"
+#include "../core/EventBus.h"
+#include "../core/TestManagerNew.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <algorithm>
+
+// Default poll interval; keeps edit-to-screen latency well under a second
+constexpr uint32_t HOT_RELOAD_POLL_MS = 250;
+
+// Compiles one shader to SPIR-V; an empty result keeps the previous module
+using ShaderCompileFunction =
+    std::function<std::vector<uint32_t>(ShaderType type, const std::string& path, const ShaderOptions& options)>;
+
+// Shader recompiled by the watcher thread, ready to be swapped in
+struct ReloadedShader {
+    std::string path;
+    ShaderType type;
+    std::vector<uint32_t> spirv;
+};
+
+// Everything that changed since the last frame boundary
+struct ReloadBatch {
+    bool configChanged = false;
+    std::string configPath;
+    RenderConfig config;
+    uint32_t configChanges = CONFIG_CHANGE_NONE;
+    std::vector<ReloadedShader> shaders;
+
+    bool IsEmpty() const {
+        return !configChanged && shaders.empty();
+    }
+};
+
+// HotReloadService polls the config file and the shader tree from a background thread
+// Features:
+// - Config edits are parsed and diffed so only the affected subsystems are rebuilt
+// - Shader edits recompile every registered shader whose #include closure contains the file
+// - Results are queued and handed to the renderer at a frame boundary via ConsumePending(),
+//   which is also where "config.changed" is published (never from the watcher thread)
+class HotReloadService {
+public:
+    explicit HotReloadService(ShaderCompiler& compiler)
+        : HotReloadService([&compiler](ShaderType type, const std::string& path, const ShaderOptions& options) {
+              return compiler.Compile(type, path, options);
+          })
+    {
+    }
+
+    explicit HotReloadService(ShaderCompileFunction compile)
+        : mCompile(std::move(compile))
+        , mHasConfig(false)
+        , mRunning(false)
+        , mPollInterval(HOT_RELOAD_POLL_MS)
+    {
+        DebugWindow::Instance().RegisterChannel("Shaders");
+    }
+
+    ~HotReloadService() {
+        Stop();
+    }
+
+    // Watch a RenderConfig JSON file; `current` is the config the renderer is running with
+    void WatchConfig(const std::string& path, const RenderConfig& current) {
+        // Guard: empty path
+        if (path.empty()) {
+            QuoteSystem::Instance().Log("WatchConfig: empty path", QuoteSystem::MessageType::WARNING);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mStateMutex);
+        mConfigPath = path;
+        mAppliedConfig = current;
+        mHasConfig = true;
+        mConfigStamp = ReadStamp(path);
+    }
+
+    // Watch every .hlsl/.hlsli file under a shader root (e.g. "Shaders/")
+    void WatchShaderTree(const std::string& root) {
+        // Guard: missing directory
+        std::error_code ec;
+        if (root.empty() || !std::filesystem::is_directory(root, ec)) {
+            QuoteSystem::Instance().Log("WatchShaderTree: not a directory - " + root,
+                QuoteSystem::MessageType::WARNING);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mStateMutex);
+        mShaderRoot = root;
+        ScanShaderTree();
+    }
+
+    // Register a shader the renderer owns; it is recompiled when it or any include changes
+    void RegisterShader(const std::string& path, ShaderType type, const ShaderOptions& options = ShaderOptions()) {
+        std::lock_guard<std::mutex> lock(mStateMutex);
+        std::string key = Normalize(path);
+        mShaders[key] = WatchedShader{ path, type, options };
+
+        if (mFiles.find(key) == mFiles.end()) {
+            TrackFile(key);
+        }
+    }
+
+    // Include hash for a registered shader; pass through ShaderOptions::includeHash on first compile
+    uint64_t GetIncludeHash(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mStateMutex);
+        return ComputeIncludeHash(Normalize(path));
+    }
+
+    // Start the watcher thread
+    bool Start(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(HOT_RELOAD_POLL_MS)) {
+        // Guard: already running
+        if (mRunning.load()) {
+            return false;
+        }
+
+        mPollInterval = pollInterval;
+        mRunning.store(true);
+        mThread = std::thread([this]() { WatchLoop(); });
+
+        QuoteSystem::Instance().Log("HotReloadService watching (poll " +
+            std::to_string(pollInterval.count()) + "ms)", QuoteSystem::MessageType::INFO);
+        return true;
+    }
+
+    // Stop the watcher thread (safe to call repeatedly)
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mWakeMutex);
+            if (!mRunning.load()) {
+                return;
+            }
+            mRunning.store(false);
+        }
+        mWake.notify_all();
+
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+    }
+
+    // Run one poll synchronously (used by tools and when no thread is wanted)
+    void PollNow() {
+        PollOnce();
+    }
+
+    // Hand over everything that changed since the last call
+    // Call from the render thread between frames; returns false when there is nothing to apply
+    bool ConsumePending(ReloadBatch& outBatch) {
+        {
+            std::lock_guard<std::mutex> lock(mPendingMutex);
+
+            // Guard: nothing pending
+            if (mPending.IsEmpty()) {
+                return false;
+            }
+
+            outBatch = std::move(mPending);
+            mPending = ReloadBatch();
+        }
+
+        // Subscribers run on this thread, with the batch already drained
+        if (outBatch.configChanged) {
+            EventBus::Instance().PublishString("config.changed", outBatch.configPath);
+        }
+        return true;
+    }
+
+    // Config and shader edits in a scratch directory, polled and drained like a frame loop
+    static void RegisterTests();
+
+    // Prevent copy/move
+    HotReloadService(const HotReloadService&) = delete;
+    HotReloadService& operator=(const HotReloadService&) = delete;
+    HotReloadService(HotReloadService&&) = delete;
+    HotReloadService& operator=(HotReloadService&&) = delete;
+
+private:
+    struct FileStamp {
+        std::filesystem::file_time_type writeTime{};
+        uint64_t contentHash = 0;
+        bool exists = false;
+    };
+
+    struct TrackedFile {
+        FileStamp stamp;
+        std::vector<std::string> includes; // normalized paths
+    };
+
+    struct WatchedShader {
+        std::string path;
+        ShaderType type;
+        ShaderOptions options;
+    };
+
+    void WatchLoop() {
+        while (mRunning.load()) {
+            PollOnce();
+
+            std::unique_lock<std::mutex> lock(mWakeMutex);
+            mWake.wait_for(lock, mPollInterval, [this]() { return !mRunning.load(); });
+        }
+    }
+
+    void PollOnce() {
+        PollConfig();
+        PollShaders();
+    }
+
+    void PollConfig() {
+        std::string path;
+        RenderConfig applied;
+        {
+            std::lock_guard<std::mutex> lock(mStateMutex);
+            if (!mHasConfig) {
+                return;
+            }
+
+            // Cheap check first: only hash the file when its timestamp moved
+            std::error_code ec;
+            auto writeTime = std::filesystem::last_write_time(mConfigPath, ec);
+            if (ec || writeTime == mConfigStamp.writeTime) {
+                return;
+            }
+
+            FileStamp stamp = ReadStamp(mConfigPath);
+            bool contentChanged = (stamp.contentHash != mConfigStamp.contentHash);
+            mConfigStamp = stamp;
+            if (!contentChanged) {
+                return;
+            }
+
+            path = mConfigPath;
+            applied = mAppliedConfig;
+        }
+
+        // Parse on top of the running config so omitted keys keep their values
+        RenderConfig updated = applied;
+        if (!RenderConfig::LoadFromFile(path, updated)) {
+            DebugWindow::Instance().Post("Renderer", "Config reload rejected, keeping current settings",
+                DebugWindow::DebugLevel::WARN);
+            return;
+        }
+
+        uint32_t changes = RenderConfig::Diff(applied, updated);
+        if (changes == CONFIG_CHANGE_NONE) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mStateMutex);
+            mAppliedConfig = updated;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mPendingMutex);
+            mPending.configChanged = true;
+            mPending.configPath = path;
+            mPending.config = updated;
+            mPending.configChanges |= changes;
+        }
+
+        DebugWindow::Instance().Post("Renderer", "Config change queued (flags " +
+            std::to_string(changes) + ")", DebugWindow::DebugLevel::INFO);
+    }
+
+    void PollShaders() {
+        std::vector<WatchedShader> toCompile;
+        {
+            std::lock_guard<std::mutex> lock(mStateMutex);
+
+            // Pick up shaders added to the tree since the last scan
+            if (!mShaderRoot.empty()) {
+                ScanShaderTree();
+            }
+
+            std::unordered_set<std::string> changed;
+            for (auto& [path, file] : mFiles) {
+                if (RefreshFile(path, file)) {
+                    changed.insert(path);
+                }
+            }
+
+            // Guard: nothing changed
+            if (changed.empty()) {
+                return;
+            }
+
+            // An edit may have added an include we have not seen yet
+            std::vector<std::string> untracked;
+            for (const std::string& path : changed) {
+                for (const std::string& include : mFiles[path].includes) {
+                    if (mFiles.find(include) == mFiles.end()) {
+                        untracked.push_back(include);
+                    }
+                }
+            }
+            for (const std::string& include : untracked) {
+                TrackFile(include);
+            }
+
+            for (const auto& [path, shader] : mShaders) {
+                if (DependsOnAny(path, changed)) {
+                    WatchedShader job = shader;
+                    job.options.includeHash = ComputeIncludeHash(path);
+                    toCompile.push_back(job);
+                }
+            }
+        }
+
+        // Compile outside the state lock; ShaderCompiler has its own cache lock
+        std::vector<ReloadedShader> compiled;
+        for (const WatchedShader& job : toCompile) {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            std::vector<uint32_t> spirv = mCompile(job.type, job.path, job.options);
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            // Guard: failed compile keeps the previous module alive
+            if (spirv.empty()) {
+                DebugWindow::Instance().Post("Shaders", "Hot reload failed, keeping previous: " + job.path,
+                    DebugWindow::DebugLevel::ERR);
+                continue;
+            }
+
+            double ms = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+            DebugWindow::Instance().Post("Shaders", "Hot reloaded " + job.path + " (" +
+                std::to_string(static_cast<int>(ms)) + "ms)", DebugWindow::DebugLevel::INFO);
+            compiled.push_back(ReloadedShader{ job.path, job.type, std::move(spirv) });
+        }
+
+        if (compiled.empty()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mPendingMutex);
+        for (ReloadedShader& shader : compiled) {
+            // Latest compile of the same file wins
+            auto it = std::find_if(mPending.shaders.begin(), mPending.shaders.end(),
+                [&shader](const ReloadedShader& s) { return s.path == shader.path; });
+            if (it != mPending.shaders.end()) {
+                *it = std::move(shader);
+            } else {
+                mPending.shaders.push_back(std::move(shader));
+            }
+        }
+    }
+
+    // Track any shader source under the root that is not tracked yet (assumes state lock held)
+    void ScanShaderTree() {
+        std::error_code ec;
+        for (auto it = std::filesystem::recursive_directory_iterator(mShaderRoot, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            if (!it->is_regular_file(ec)) {
+                continue;
+            }
+            std::string ext = it->path().extension().string();
+            if (ext != ".hlsl" && ext != ".hlsli") {
+                continue;
+            }
+            std::string key = Normalize(it->path().string());
+            if (mFiles.find(key) == mFiles.end()) {
+                TrackFile(key);
+            }
+        }
+    }
+
+    void TrackFile(const std::string& path) {
+        TrackedFile file;
+        file.stamp = ReadStamp(path);
+        file.includes = ParseIncludes(path);
+        mFiles[path] = file;
+
+        // Includes outside the watched tree still need to be tracked
+        for (const std::string& include : file.includes) {
+            if (mFiles.find(include) == mFiles.end()) {
+                TrackFile(include);
+            }
+        }
+    }
+
+    // Returns true when the file content changed (assumes state lock held)
+    bool RefreshFile(const std::string& path, TrackedFile& file) {
+        std::error_code ec;
+        auto writeTime = std::filesystem::last_write_time(path, ec);
+        bool exists = !ec;
+
+        if (exists == file.stamp.exists && (!exists || writeTime == file.stamp.writeTime)) {
+            return false;
+        }
+
+        FileStamp stamp = ReadStamp(path);
+        bool changed = (stamp.exists != file.stamp.exists) || (stamp.contentHash != file.stamp.contentHash);
+        file.stamp = stamp;
+
+        // Include lists can change with the edit
+        if (changed) {
+            file.includes = ParseIncludes(path);
+        }
+        return changed;
+    }
+
+    // True when the shader or anything it transitively includes is in `changed`
+    bool DependsOnAny(const std::string& root, const std::unordered_set<std::string>& changed) const {
+        std::set<std::string> closure;
+        CollectIncludes(root, closure);
+        for (const std::string& path : closure) {
+            if (changed.count(path) > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void CollectIncludes(const std::string& path, std::set<std::string>& closure) const {
+        // Guard: already visited (also breaks include cycles)
+        if (!closure.insert(path).second) {
+            return;
+        }
+
+        auto it = mFiles.find(path);
+        if (it == mFiles.end()) {
+            return;
+        }
+        for (const std::string& include : it->second.includes) {
+            CollectIncludes(include, closure);
+        }
+    }
+
+    uint64_t ComputeIncludeHash(const std::string& path) const {
+        std::set<std::string> closure;
+        CollectIncludes(path, closure);
+        closure.erase(path);
+
+        // std::set keeps the combination order stable across runs
+        uint64_t hash = 14695981039346656037ull;
+        for (const std::string& include : closure) {
+            auto it = mFiles.find(include);
+            uint64_t contentHash = (it != mFiles.end()) ? it->second.stamp.contentHash : 0;
+            hash ^= contentHash + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+
+    static FileStamp ReadStamp(const std::string& path) {
+        FileStamp stamp;
+        std::error_code ec;
+        stamp.writeTime = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            return stamp;
+        }
+        stamp.exists = true;
+        stamp.contentHash = ShaderCompiler::HashSource(ReadText(path));
+        return stamp;
+    }
+
+    static std::string ReadText(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return "";
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+
+    // Extract #include "file" targets, resolved relative to the including file
+    static std::vector<std::string> ParseIncludes(const std::string& path) {
+        std::vector<std::string> includes;
+        std::istringstream source(ReadText(path));
+        std::filesystem::path directory = std::filesystem::path(path).parent_path();
+
+        std::string line;
+        while (std::getline(source, line)) {
+            size_t pos = line.find_first_not_of(" \t");
+            if (pos == std::string::npos || line.compare(pos, 8, "#include") != 0) {
+                continue;
+            }
+            size_t open = line.find('"', pos + 8);
+            size_t close = (open == std::string::npos) ? open : line.find('"', open + 1);
+            if (close == std::string::npos) {
+                continue;
+            }
+            includes.push_back(Normalize((directory / line.substr(open + 1, close - open - 1)).string()));
+        }
+        return includes;
+    }
+
+    static std::string Normalize(const std::string& path) {
+        return std::filesystem::path(path).lexically_normal().generic_string();
+    }
+
+    // Member variables
+    ShaderCompileFunction mCompile;
+
+    // Watch state (guarded by mStateMutex)
+    std::mutex mStateMutex;
+    std::string mConfigPath;
+    RenderConfig mAppliedConfig;
+    FileStamp mConfigStamp;
+    bool mHasConfig;
+    std::string mShaderRoot;
+    std::unordered_map<std::string, TrackedFile> mFiles;
+    std::map<std::string, WatchedShader> mShaders;
+
+    // Results waiting for the next frame boundary
+    std::mutex mPendingMutex;
+    ReloadBatch mPending;
+
+    // Watcher thread
+    std::thread mThread;
+    std::atomic<bool> mRunning;
+    std::mutex mWakeMutex;
+    std::condition_variable mWake;
+    std::chrono::milliseconds mPollInterval;
+};
+
+inline void HotReloadService::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("HotReloadService", TestManagerNew::SuiteMode::SERIAL);
+
+    // Write `text` and step the timestamp forward so the edit is seen even within one mtime tick
+    auto edit = [](const std::filesystem::path& path, const std::string& text, int step) {
+        std::ofstream(path.string(), std::ios::binary) << text;
+        std::error_code ec;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now() +
+            std::chrono::seconds(step), ec);
+    };
+
+    tests.AddTest("HotReloadService", "Edits between frames drain as one coalesced batch", [=]() {
+        std::error_code ec;
+        std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / "brightforge_hot_reload";
+        std::filesystem::remove_all(dir, ec);
+        std::filesystem::create_directories(dir, ec);
+
+        std::string common = (dir / "common.hlsli").string();
+        std::string lit = (dir / "lit.hlsl").string();
+        std::string flat = (dir / "flat.hlsl").string();
+        std::string config = (dir / "render_config.json").string();
+        edit(common, "float4 Tint;\n", 0);
+        edit(lit, "#include \"common.hlsli\"\nfloat4 main() : SV_Target { return Tint; }\n", 0);
+        edit(flat, "float4 main() : SV_Target { return 1; }\n", 0);
+        RenderConfig::SaveToFile(config, RenderConfig());
+
+        // Each compile returns a distinct module so the batch shows which one won
+        uint32_t compiles = 0;
+        HotReloadService service([&compiles](ShaderType, const std::string&, const ShaderOptions&) {
+            return std::vector<uint32_t>{ 0x07230203u, ++compiles };
+        });
+        service.WatchConfig(config, RenderConfig());
+        service.WatchShaderTree(dir.string());
+        service.RegisterShader(lit, ShaderType::FRAGMENT);
+        service.RegisterShader(flat, ShaderType::FRAGMENT);
+
+        std::vector<std::string> published;
+        size_t subscription = EventBus::Instance().Subscribe("config.changed",
+            [&published](const EventBus::EventPayload& payload) {
+                const std::string* path = std::get_if<std::string>(&payload);
+                published.push_back(path != nullptr ? *path : std::string());
+            });
+
+        ReloadBatch batch;
+        service.PollNow();
+        bool ok = !service.ConsumePending(batch);
+
+        // Three polls worth of edits before the next frame boundary
+        edit(common, "float4 Tint;\nfloat Gain;\n", 2);
+        service.PollNow();
+        RenderConfig edited;
+        edited.windowWidth = 1024;
+        edited.sunIntensity = 2.0f;
+        edit(config, RenderConfigIO::WriteJson(edited), 3);
+        service.PollNow();
+        edit(common, "float4 Tint;\nfloat Gain;\nfloat Bias;\n", 4);
+        service.PollNow();
+        ok = ok && published.empty();
+
+        ok = ok && service.ConsumePending(batch) && batch.configChanged && batch.configPath == config &&
+             batch.config.windowWidth == 1024 && batch.config.sunIntensity == 2.0f &&
+             batch.configChanges == (CONFIG_CHANGE_SWAPCHAIN | CONFIG_CHANGE_LIGHTING) &&
+             batch.shaders.size() == 1 && batch.shaders[0].path == lit &&
+             batch.shaders[0].type == ShaderType::FRAGMENT && batch.shaders[0].spirv.size() == 2 &&
+             batch.shaders[0].spirv[1] == compiles && compiles == 2;
+        ok = ok && published.size() == 1 && published[0] == config;
+
+        // Drained: the next frame gets nothing and nothing is published again
+        service.PollNow();
+        ok = ok && !service.ConsumePending(batch) && published.size() == 1;
+
+        EventBus::Instance().Unsubscribe(subscription);
+        std::filesystem::remove_all(dir, ec);
+        return ok;
+    });
+
+    tests.AddTest("HotReloadService", "Failed compiles and rejected configs queue nothing", [=]() {
+        std::error_code ec;
+        std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / "brightforge_hot_reload_reject";
+        std::filesystem::remove_all(dir, ec);
+        std::filesystem::create_directories(dir, ec);
+
+        std::string shader = (dir / "broken.hlsl").string();
+        std::string config = (dir / "render_config.json").string();
+        edit(shader, "float4 main() : SV_Target { return 0; }\n", 0);
+        RenderConfig::SaveToFile(config, RenderConfig());
+
+        HotReloadService service([](ShaderType, const std::string&, const ShaderOptions&) {
+            return std::vector<uint32_t>();
+        });
+        service.WatchConfig(config, RenderConfig());
+        service.RegisterShader(shader, ShaderType::VERTEX);
+
+        edit(shader, "float4 main() : SV_Target { return oops; }\n", 2);
+        edit(config, "{ \"windowWidth\": \"wide\" }\n", 2);
+        service.PollNow();
+
+        ReloadBatch batch;
+        bool ok = !service.ConsumePending(batch);
+        std::filesystem::remove_all(dir, ec);
+        return ok;
+    });
+}
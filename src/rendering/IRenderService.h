@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 #include "RenderConfig.h"
 
 // Handle types for resource management
@@ -79,6 +80,7 @@ struct FrameStats {
     uint64_t vramUsedBytes = 0;
     uint64_t vramTotalBytes = 0;
     bool vsyncActive = false;
+    float renderScale = 1.0f;       // Internal resolution scale of the frame (dynamic resolution)
 };
 
 // Abstract rendering service interface
@@ -115,6 +117,17 @@ public:
     // Returns INVALID_MESH_HANDLE on failure
     virtual MeshHandle LoadMesh(const std::string& path) = 0;
 
+    // LoadMeshes loads several meshes; handles line up with `paths`. Backends that can
+    // parse in parallel override it, the default loads one after another.
+    virtual std::vector<MeshHandle> LoadMeshes(const std::vector<std::string>& paths) {
+        std::vector<MeshHandle> handles;
+        handles.reserve(paths.size());
+        for (const std::string& path : paths) {
+            handles.push_back(LoadMesh(path));
+        }
+        return handles;
+    }
+
     // LoadTexture loads an image file (PNG, JPG, etc.) and returns a handle
     // Returns INVALID_TEXTURE_HANDLE on failure
     virtual TextureHandle LoadTexture(const std::string& path) = 0;
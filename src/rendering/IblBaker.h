@@ -0,0 +1,754 @@
+/** IblBaker - CPU image-based lighting precompute with a content-addressed disk cache
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "HdrLoader.h"
+#include "../core/QuoteSystem.h"
+#include "../core/DebugWindow.h"
+#include "../core/Parallel.h"
+#include "../core/MemoryTracker.h"
+#include "../core/TestManagerNew.h"
+#include "../core/Checksum.h"
+#include "../filesystem/MappedFile.h"
+#include <string>
+#include <vector>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+#include <unordered_map>
+#include <filesystem>
+#include <fstream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+// Bump when the bake math or file layout changes so stale caches are ignored
+constexpr uint32_t IBL_CACHE_VERSION = 1;
+constexpr const char* IBL_DEFAULT_CACHE_DIR = "Cache/IBL";
+
+// Bake quality knobs; part of the cache key
+struct IblSettings {
+    uint32_t cubeSize;          // Prefiltered cube face size at mip 0
+    uint32_t mipCount;          // pbr_ps.hlsl samples LOD roughness * 4, so 5 levels
+    uint32_t specularSamples;   // GGX importance samples per texel
+    uint32_t lutSize;
+    uint32_t lutSamples;
+
+    IblSettings()
+        : cubeSize(128), mipCount(5), specularSamples(128), lutSize(128), lutSamples(256) {}
+};
+
+// Baked environment, laid out for direct upload
+// - sh: irradiance / PI (pbr_ps multiplies the irradiance sample by albedo only)
+// - prefiltered[mip]: 6 faces (+X,-X,+Y,-Y,+Z,-Z) of size^2 RGBA32F, roughness = mip / (mipCount - 1)
+// - brdfLut: lutSize^2 RG32F (F0 scale, bias), x = NdotV, y = roughness
+struct IblData {
+    uint64_t sourceHash = 0;
+    IblSettings settings;
+    std::array<float, 27> sh = {};
+    std::vector<std::vector<float>> prefiltered;
+    std::vector<float> brdfLut;
+
+    // Evaluate the diffuse term for a unit normal
+    void EvaluateIrradiance(float x, float y, float z, float out[3]) const {
+        float basis[9];
+        ShBasis(x, y, z, basis);
+        for (int c = 0; c < 3; ++c) {
+            float sum = 0.0f;
+            for (int i = 0; i < 9; ++i) {
+                sum += sh[i * 3 + c] * basis[i];
+            }
+            out[c] = std::max(sum, 0.0f);
+        }
+    }
+
+    // Trilinear lookup into the prefiltered cube (inverse of IblBaker's face mapping)
+    // Bilinear filtering clamps at face edges; seams are below the mip 0 texel size
+    void SamplePrefiltered(float x, float y, float z, float lod, float out[3]) const {
+        if (prefiltered.empty()) {
+            out[0] = out[1] = out[2] = 0.0f;
+            return;
+        }
+
+        float ax = std::fabs(x);
+        float ay = std::fabs(y);
+        float az = std::fabs(z);
+        uint32_t face;
+        float u;
+        float v;
+        if (ax >= ay && ax >= az) {
+            face = x > 0.0f ? 0 : 1;
+            u = (x > 0.0f ? -z : z) / ax;
+            v = -y / ax;
+        } else if (ay >= az) {
+            face = y > 0.0f ? 2 : 3;
+            u = x / ay;
+            v = (y > 0.0f ? z : -z) / ay;
+        } else {
+            face = z > 0.0f ? 4 : 5;
+            u = (z > 0.0f ? x : -x) / az;
+            v = -y / az;
+        }
+
+        float maxLod = static_cast<float>(prefiltered.size() - 1);
+        lod = std::max(0.0f, std::min(lod, maxLod));
+        uint32_t level = static_cast<uint32_t>(lod);
+        float blend = lod - level;
+
+        SampleFace(level, face, u, v, out);
+        if (blend > 0.0f && level + 1 < prefiltered.size()) {
+            float next[3];
+            SampleFace(level + 1, face, u, v, next);
+            for (int c = 0; c < 3; ++c) {
+                out[c] += (next[c] - out[c]) * blend;
+            }
+        }
+    }
+
+    static void ShBasis(float x, float y, float z, float out[9]) {
+        out[0] = 0.282095f;
+        out[1] = 0.488603f * y;
+        out[2] = 0.488603f * z;
+        out[3] = 0.488603f * x;
+        out[4] = 1.092548f * x * y;
+        out[5] = 1.092548f * y * z;
+        out[6] = 0.315392f * (3.0f * z * z - 1.0f);
+        out[7] = 1.092548f * x * z;
+        out[8] = 0.546274f * (x * x - y * y);
+    }
+
+private:
+    void SampleFace(uint32_t level, uint32_t face, float u, float v, float out[3]) const {
+        uint32_t size = std::max(1u, settings.cubeSize >> level);
+        const float* texels = prefiltered[level].data() + static_cast<size_t>(face) * size * size * 4;
+
+        float maxCoord = static_cast<float>(size - 1);
+        float fx = std::max(0.0f, std::min((u + 1.0f) * 0.5f * size - 0.5f, maxCoord));
+        float fy = std::max(0.0f, std::min((v + 1.0f) * 0.5f * size - 0.5f, maxCoord));
+        uint32_t x0 = static_cast<uint32_t>(fx);
+        uint32_t y0 = static_cast<uint32_t>(fy);
+        uint32_t x1 = std::min(x0 + 1, size - 1);
+        uint32_t y1 = std::min(y0 + 1, size - 1);
+        float tx = fx - x0;
+        float ty = fy - y0;
+
+        const float* p00 = texels + (static_cast<size_t>(y0) * size + x0) * 4;
+        const float* p10 = texels + (static_cast<size_t>(y0) * size + x1) * 4;
+        const float* p01 = texels + (static_cast<size_t>(y1) * size + x0) * 4;
+        const float* p11 = texels + (static_cast<size_t>(y1) * size + x1) * 4;
+        for (int c = 0; c < 3; ++c) {
+            float top = p00[c] + (p10[c] - p00[c]) * tx;
+            float bottom = p01[c] + (p11[c] - p01[c]) * tx;
+            out[c] = top + (bottom - top) * ty;
+        }
+    }
+};
+
+// IblBaker - stateless bake stages, each parallel over rows or texels
+class IblBaker {
+public:
+    static void Bake(const HdrImage& environment, const IblSettings& settings, IblData& out) {
+        out.settings = settings;
+        out.sh = ProjectIrradiance(environment);
+        out.prefiltered = PrefilterSpecular(environment, settings);
+        out.brdfLut = IntegrateBrdf(settings.lutSize, settings.lutSamples);
+    }
+
+    // Project radiance onto SH9 and convolve with the clamped cosine lobe
+    static std::array<float, 27> ProjectIrradiance(const HdrImage& environment) {
+        const uint32_t width = environment.width;
+        const uint32_t height = environment.height;
+        std::vector<std::array<double, 27>> rows(height);
+
+        Parallel::For(height, [&](size_t y) {
+            std::array<double, 27>& sum = rows[y];
+            sum.fill(0.0);
+            double theta = (y + 0.5) * PI / height;
+            double solidAngle = (2.0 * PI / width) * (PI / height) * std::sin(theta);
+            for (uint32_t x = 0; x < width; ++x) {
+                float direction[3];
+                EquirectDirection(x, static_cast<uint32_t>(y), width, height, direction);
+                float basis[9];
+                IblData::ShBasis(direction[0], direction[1], direction[2], basis);
+                const float* texel = environment.Pixel(x, static_cast<uint32_t>(y));
+                for (int i = 0; i < 9; ++i) {
+                    double weight = basis[i] * solidAngle;
+                    sum[i * 3 + 0] += texel[0] * weight;
+                    sum[i * 3 + 1] += texel[1] * weight;
+                    sum[i * 3 + 2] += texel[2] * weight;
+                }
+            }
+        });
+
+        // Band factors of the cosine lobe (pi, 2pi/3, pi/4), pre-divided by pi
+        static constexpr double BAND[9] = { 1.0, 2.0 / 3.0, 2.0 / 3.0, 2.0 / 3.0, 0.25, 0.25, 0.25, 0.25, 0.25 };
+        std::array<float, 27> sh = {};
+        for (int i = 0; i < 27; ++i) {
+            double total = 0.0;
+            for (const auto& row : rows) {
+                total += row[i];
+            }
+            sh[i] = static_cast<float>(total * BAND[i / 3]);
+        }
+        return sh;
+    }
+
+    // GGX-prefiltered cube mips via filtered importance sampling of an equirect pyramid
+    static std::vector<std::vector<float>> PrefilterSpecular(const HdrImage& environment, const IblSettings& settings) {
+        std::vector<HdrImage> pyramid = BuildPyramid(environment);
+        double sourceTexelAngle = 4.0 * PI / (static_cast<double>(environment.width) * environment.height);
+
+        std::vector<std::vector<float>> mips(settings.mipCount);
+        for (uint32_t mip = 0; mip < settings.mipCount; ++mip) {
+            uint32_t size = std::max(1u, settings.cubeSize >> mip);
+            float roughness = settings.mipCount > 1 ? static_cast<float>(mip) / (settings.mipCount - 1) : 0.0f;
+            std::vector<float>& faces = mips[mip];
+            faces.resize(static_cast<size_t>(6) * size * size * 4);
+
+            // Mirror-like mip: one lookup at the LOD whose texels match the cube texel footprint
+            double cubeTexelAngle = 4.0 * PI / (6.0 * size * size);
+            float mirrorLod = static_cast<float>(std::max(0.0, 0.5 * std::log2(cubeTexelAngle / sourceTexelAngle)));
+
+            Parallel::For(static_cast<size_t>(6) * size, [&](size_t task) {
+                uint32_t face = static_cast<uint32_t>(task / size);
+                uint32_t y = static_cast<uint32_t>(task % size);
+                for (uint32_t x = 0; x < size; ++x) {
+                    float n[3];
+                    CubeDirection(face, x, y, size, n);
+                    float* texel = faces.data() + ((static_cast<size_t>(face) * size + y) * size + x) * 4;
+                    if (roughness <= 0.0f) {
+                        SamplePyramid(pyramid, n, mirrorLod, texel);
+                    } else {
+                        PrefilterTexel(pyramid, n, roughness, settings.specularSamples, sourceTexelAngle, texel);
+                    }
+                    texel[3] = 1.0f;
+                }
+            });
+        }
+        return mips;
+    }
+
+    // Split-sum BRDF integration (Karis 2013) with the IBL k = alpha / 2
+    static std::vector<float> IntegrateBrdf(uint32_t size, uint32_t samples) {
+        std::vector<float> lut(static_cast<size_t>(size) * size * 2);
+        Parallel::For(size, [&](size_t row) {
+            float roughness = (row + 0.5f) / size;
+            float alpha = roughness * roughness;
+            float k = alpha / 2.0f;
+            for (uint32_t column = 0; column < size; ++column) {
+                float nDotV = (column + 0.5f) / size;
+                float v[3] = { std::sqrt(1.0f - nDotV * nDotV), 0.0f, nDotV };
+                float n[3] = { 0.0f, 0.0f, 1.0f };
+                float a = 0.0f;
+                float b = 0.0f;
+                for (uint32_t i = 0; i < samples; ++i) {
+                    float h[3];
+                    ImportanceSampleGgx(Hammersley(i, samples), n, roughness, h);
+                    float vDotH = Dot(v, h);
+                    float l[3] = { 2.0f * vDotH * h[0] - v[0], 2.0f * vDotH * h[1] - v[1], 2.0f * vDotH * h[2] - v[2] };
+                    float nDotL = std::max(l[2], 0.0f);
+                    float nDotH = std::max(h[2], 0.0f);
+                    vDotH = std::max(vDotH, 0.0f);
+                    if (nDotL <= 0.0f) {
+                        continue;
+                    }
+                    float g = (nDotV / (nDotV * (1.0f - k) + k)) * (nDotL / (nDotL * (1.0f - k) + k));
+                    float visibility = g * vDotH / std::max(nDotH * nDotV, 1e-6f);
+                    float fresnel = std::pow(1.0f - vDotH, 5.0f);
+                    a += (1.0f - fresnel) * visibility;
+                    b += fresnel * visibility;
+                }
+                float* texel = lut.data() + (row * size + column) * 2;
+                texel[0] = a / samples;
+                texel[1] = b / samples;
+            }
+        });
+        return lut;
+    }
+
+    // Correctness checks on a uniform environment
+    static void RegisterTests() {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        tests.RegisterSuite("IblBaker");
+
+        tests.AddTest("IblBaker", "Uniform environment bakes to constants", []() {
+            HdrImage white;
+            white.width = 64;
+            white.height = 32;
+            white.pixels.assign(64 * 32 * 4, 1.0f);
+
+            IblSettings settings;
+            settings.cubeSize = 8;
+            settings.mipCount = 3;
+            settings.specularSamples = 32;
+            settings.lutSize = 16;
+            settings.lutSamples = 64;
+
+            IblData data;
+            Bake(white, settings, data);
+
+            // Uniform radiance 1 -> irradiance / pi == 1 in every direction
+            float irradiance[3];
+            data.EvaluateIrradiance(0.0f, 1.0f, 0.0f, irradiance);
+            bool ok = std::fabs(irradiance[0] - 1.0f) < 0.02f;
+            data.EvaluateIrradiance(0.6f, 0.0f, -0.8f, irradiance);
+            ok = ok && std::fabs(irradiance[2] - 1.0f) < 0.02f;
+
+            for (const auto& mip : data.prefiltered) {
+                for (float v : mip) {
+                    ok = ok && std::fabs(v - 1.0f) < 0.02f;
+                }
+            }
+
+            // Split-sum terms stay in [0, 1] and sum to at most 1 (energy conservation)
+            for (size_t i = 0; i < data.brdfLut.size(); i += 2) {
+                float sum = data.brdfLut[i] + data.brdfLut[i + 1];
+                ok = ok && data.brdfLut[i] >= 0.0f && data.brdfLut[i + 1] >= 0.0f && sum <= 1.01f;
+            }
+            return ok;
+        });
+    }
+
+    // Prevent instantiation (static API)
+    IblBaker() = delete;
+
+private:
+    static constexpr double PI = 3.14159265358979323846;
+    static constexpr float PI_F = 3.14159265f;
+
+    // Bias toward blurrier source mips to hide sample noise (GPU Gems 3, ch. 20)
+    static constexpr float LOD_BIAS = 1.0f;
+
+    static float Dot(const float a[3], const float b[3]) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    static void Normalize(float v[3]) {
+        float length = std::sqrt(Dot(v, v));
+        if (length > 0.0f) {
+            v[0] /= length;
+            v[1] /= length;
+            v[2] /= length;
+        }
+    }
+
+    // Equirect convention: u follows atan2(z, x), v = 0 is +Y
+    static void EquirectDirection(uint32_t x, uint32_t y, uint32_t width, uint32_t height, float out[3]) {
+        double phi = (x + 0.5) / width * 2.0 * PI - PI;
+        double theta = (y + 0.5) / height * PI;
+        out[0] = static_cast<float>(std::sin(theta) * std::cos(phi));
+        out[1] = static_cast<float>(std::cos(theta));
+        out[2] = static_cast<float>(std::sin(theta) * std::sin(phi));
+    }
+
+    // Cube face texel centre -> direction, D3D/Vulkan face orientation
+    static void CubeDirection(uint32_t face, uint32_t x, uint32_t y, uint32_t size, float out[3]) {
+        float u = 2.0f * (x + 0.5f) / size - 1.0f;
+        float v = 2.0f * (y + 0.5f) / size - 1.0f;
+        switch (face) {
+            case 0:  out[0] = 1.0f;  out[1] = -v;    out[2] = -u;    break;
+            case 1:  out[0] = -1.0f; out[1] = -v;    out[2] = u;     break;
+            case 2:  out[0] = u;     out[1] = 1.0f;  out[2] = v;     break;
+            case 3:  out[0] = u;     out[1] = -1.0f; out[2] = -v;    break;
+            case 4:  out[0] = u;     out[1] = -v;    out[2] = 1.0f;  break;
+            default: out[0] = -u;    out[1] = -v;    out[2] = -1.0f; break;
+        }
+        Normalize(out);
+    }
+
+    static std::vector<HdrImage> BuildPyramid(const HdrImage& base) {
+        std::vector<HdrImage> levels;
+        levels.push_back(base);
+        while (levels.back().width > 1 && levels.back().height > 1) {
+            const HdrImage& source = levels.back();
+            HdrImage next;
+            next.width = std::max(1u, source.width / 2);
+            next.height = std::max(1u, source.height / 2);
+            next.pixels.resize(static_cast<size_t>(next.width) * next.height * 4);
+            Parallel::For(next.height, [&](size_t y) {
+                for (uint32_t x = 0; x < next.width; ++x) {
+                    float* out = next.pixels.data() + (y * next.width + x) * 4;
+                    const float* a = source.Pixel(x * 2, static_cast<uint32_t>(y * 2));
+                    const float* b = source.Pixel(std::min(x * 2 + 1, source.width - 1), static_cast<uint32_t>(y * 2));
+                    const float* c = source.Pixel(x * 2, std::min(static_cast<uint32_t>(y * 2 + 1), source.height - 1));
+                    const float* d = source.Pixel(std::min(x * 2 + 1, source.width - 1),
+                                                  std::min(static_cast<uint32_t>(y * 2 + 1), source.height - 1));
+                    for (int channel = 0; channel < 4; ++channel) {
+                        out[channel] = 0.25f * (a[channel] + b[channel] + c[channel] + d[channel]);
+                    }
+                }
+            });
+            levels.push_back(std::move(next));
+        }
+        return levels;
+    }
+
+    static void SampleBilinear(const HdrImage& image, const float direction[3], float out[3]) {
+        float u = std::atan2(direction[2], direction[0]) / (2.0f * PI_F) + 0.5f;
+        float v = std::acos(std::max(-1.0f, std::min(1.0f, direction[1]))) / PI_F;
+        float fx = u * image.width - 0.5f;
+        float fy = std::max(0.0f, std::min(v * image.height - 0.5f, static_cast<float>(image.height - 1)));
+        int x0 = static_cast<int>(std::floor(fx));
+        int y0 = static_cast<int>(fy);
+        float tx = fx - x0;
+        float ty = fy - y0;
+        uint32_t xa = static_cast<uint32_t>((x0 % static_cast<int>(image.width) + image.width) % image.width);
+        uint32_t xb = (xa + 1) % image.width;
+        uint32_t ya = static_cast<uint32_t>(y0);
+        uint32_t yb = std::min(ya + 1, image.height - 1);
+
+        const float* p00 = image.Pixel(xa, ya);
+        const float* p10 = image.Pixel(xb, ya);
+        const float* p01 = image.Pixel(xa, yb);
+        const float* p11 = image.Pixel(xb, yb);
+        for (int c = 0; c < 3; ++c) {
+            float top = p00[c] + (p10[c] - p00[c]) * tx;
+            float bottom = p01[c] + (p11[c] - p01[c]) * tx;
+            out[c] = top + (bottom - top) * ty;
+        }
+    }
+
+    // Trilinear lookup across the equirect pyramid
+    static void SamplePyramid(const std::vector<HdrImage>& pyramid, const float direction[3], float lod, float out[3]) {
+        float maxLod = static_cast<float>(pyramid.size() - 1);
+        lod = std::max(0.0f, std::min(lod, maxLod));
+        uint32_t level = static_cast<uint32_t>(lod);
+        float blend = lod - level;
+
+        SampleBilinear(pyramid[level], direction, out);
+        if (blend > 0.0f && level + 1 < pyramid.size()) {
+            float next[3];
+            SampleBilinear(pyramid[level + 1], direction, next);
+            for (int c = 0; c < 3; ++c) {
+                out[c] += (next[c] - out[c]) * blend;
+            }
+        }
+    }
+
+    static void PrefilterTexel(const std::vector<HdrImage>& pyramid, const float n[3], float roughness,
+                               uint32_t samples, double sourceTexelAngle, float out[3]) {
+        float alpha = roughness * roughness;
+        float alpha2 = alpha * alpha;
+        float sum[3] = { 0.0f, 0.0f, 0.0f };
+        float weight = 0.0f;
+
+        // N = V = R approximation
+        for (uint32_t i = 0; i < samples; ++i) {
+            float h[3];
+            ImportanceSampleGgx(Hammersley(i, samples), n, roughness, h);
+            float nDotH = Dot(n, h);
+            float l[3] = { 2.0f * nDotH * h[0] - n[0], 2.0f * nDotH * h[1] - n[1], 2.0f * nDotH * h[2] - n[2] };
+            float nDotL = Dot(n, l);
+            if (nDotL <= 0.0f) {
+                continue;
+            }
+
+            // pdf = D * NdotH / (4 * VdotH) = D / 4 when V = N
+            float denominator = nDotH * nDotH * (alpha2 - 1.0f) + 1.0f;
+            float d = alpha2 / (PI_F * denominator * denominator);
+            double sampleAngle = 1.0 / (samples * std::max(d * 0.25, 1e-8));
+            float lod = static_cast<float>(0.5 * std::log2(sampleAngle / sourceTexelAngle)) + LOD_BIAS;
+
+            float radiance[3];
+            SamplePyramid(pyramid, l, lod, radiance);
+            for (int c = 0; c < 3; ++c) {
+                sum[c] += radiance[c] * nDotL;
+            }
+            weight += nDotL;
+        }
+
+        for (int c = 0; c < 3; ++c) {
+            out[c] = weight > 0.0f ? sum[c] / weight : 0.0f;
+        }
+    }
+
+    static std::array<float, 2> Hammersley(uint32_t i, uint32_t count) {
+        uint32_t bits = i;
+        bits = (bits << 16) | (bits >> 16);
+        bits = ((bits & 0x55555555u) << 1) | ((bits & 0xAAAAAAAAu) >> 1);
+        bits = ((bits & 0x33333333u) << 2) | ((bits & 0xCCCCCCCCu) >> 2);
+        bits = ((bits & 0x0F0F0F0Fu) << 4) | ((bits & 0xF0F0F0F0u) >> 4);
+        bits = ((bits & 0x00FF00FFu) << 8) | ((bits & 0xFF00FF00u) >> 8);
+        return { static_cast<float>(i) / count, bits * 2.3283064365386963e-10f };
+    }
+
+    // GGX half vector around n; alpha = roughness^2 to match DistributionGGX in lighting_common.hlsli
+    static void ImportanceSampleGgx(const std::array<float, 2>& xi, const float n[3], float roughness, float out[3]) {
+        float alpha = roughness * roughness;
+        float phi = 2.0f * PI_F * xi[0];
+        float cosTheta = std::sqrt((1.0f - xi[1]) / (1.0f + (alpha * alpha - 1.0f) * xi[1]));
+        float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+        float local[3] = { std::cos(phi) * sinTheta, std::sin(phi) * sinTheta, cosTheta };
+
+        float up[3] = { 0.0f, 0.0f, 1.0f };
+        if (std::fabs(n[2]) >= 0.999f) {
+            up[0] = 1.0f;
+            up[2] = 0.0f;
+        }
+        float tangent[3] = { up[1] * n[2] - up[2] * n[1], up[2] * n[0] - up[0] * n[2], up[0] * n[1] - up[1] * n[0] };
+        Normalize(tangent);
+        float bitangent[3] = { n[1] * tangent[2] - n[2] * tangent[1], n[2] * tangent[0] - n[0] * tangent[2],
+                               n[0] * tangent[1] - n[1] * tangent[0] };
+
+        for (int c = 0; c < 3; ++c) {
+            out[c] = tangent[c] * local[0] + bitangent[c] * local[1] + n[c] * local[2];
+        }
+        Normalize(out);
+    }
+
+};
+
+// IblCache - content-addressed bake cache
+// Keyed by a hash of the .hdr bytes plus the bake settings. Lookups go memory ->
+// disk -> bake, so switching back to a seen environment never re-bakes, and a new
+// session only pays for file reads.
+class IblCache {
+public:
+    explicit IblCache(const std::string& cacheDir = IBL_DEFAULT_CACHE_DIR)
+        : mCacheDir(cacheDir) {}
+
+    ~IblCache() {
+        ClearMemory();
+    }
+
+    std::shared_ptr<const IblData> Get(const std::string& hdrPath, const IblSettings& settings = IblSettings()) {
+        BrightForge::MappedFile file;
+        if (!file.Open(hdrPath)) {
+            QuoteSystem::Instance().Log("IblCache: " + file.GetError(), QuoteSystem::MessageType::ERROR_MSG);
+            return nullptr;
+        }
+
+        uint64_t hash = HashBytes(file.Data(), file.Size());
+        uint64_t key = hash ^ (HashSettings(settings) * 0x9E3779B97F4A7C15ull);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto cached = mMemory.find(key);
+            if (cached != mMemory.end()) {
+                return cached->second;
+            }
+        }
+
+        auto data = std::make_shared<IblData>();
+        std::string cachePath = CachePath(key);
+        if (ReadCacheFile(cachePath, hash, settings, *data)) {
+            DebugWindow::Instance().Post("Renderer", "IBL cache hit: " + hdrPath, DebugWindow::DebugLevel::INFO);
+        } else {
+            HdrImage environment;
+            std::string error;
+            if (!HdrLoader::LoadMemory(file.Data(), file.Size(), environment, &error)) {
+                QuoteSystem::Instance().Log("IblCache: " + hdrPath + " - " + error, QuoteSystem::MessageType::ERROR_MSG);
+                return nullptr;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            IblBaker::Bake(environment, settings, *data);
+            data->sourceHash = hash;
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+            QuoteSystem::Instance().Log("IBL baked: " + hdrPath + " in " + std::to_string(elapsed.count()) + "ms",
+                QuoteSystem::MessageType::SUCCESS);
+            if (!WriteCacheFile(cachePath, *data)) {
+                QuoteSystem::Instance().Log("IblCache: could not write " + cachePath, QuoteSystem::MessageType::WARNING);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::shared_ptr<const IblData>& slot = mMemory[key];
+        if (slot) {
+            // Another thread baked the same key meanwhile; this copy replaces it
+            MemoryTracker::Instance().Release(MemoryTag::TEXTURE_CACHE, MemoryBytes(*slot));
+        }
+        slot = data;
+        MemoryTracker::Instance().Add(MemoryTag::TEXTURE_CACHE, MemoryBytes(*data));
+        return data;
+    }
+
+    void ClearMemory() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (const auto& entry : mMemory) {
+            MemoryTracker::Instance().Release(MemoryTag::TEXTURE_CACHE, MemoryBytes(*entry.second));
+        }
+        mMemory.clear();
+    }
+
+    // Pixel bytes of one cached bake (prefiltered mips plus the BRDF LUT)
+    static size_t MemoryBytes(const IblData& data) {
+        size_t bytes = data.brdfLut.capacity() * sizeof(float);
+        for (const std::vector<float>& mip : data.prefiltered) {
+            bytes += mip.capacity() * sizeof(float);
+        }
+        return bytes;
+    }
+
+    // Binary layout: header, 27 SH floats, mip chain, LUT (all little-endian float32)
+    static bool WriteCacheFile(const std::string& path, const IblData& data) {
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+        // Write-then-rename so a crash never leaves a truncated cache entry
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                return false;
+            }
+
+            CacheHeader header = MakeHeader(data.sourceHash, data.settings);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(data.sh.data()), sizeof(float) * data.sh.size());
+            for (const auto& mip : data.prefiltered) {
+                out.write(reinterpret_cast<const char*>(mip.data()), static_cast<std::streamsize>(sizeof(float) * mip.size()));
+            }
+            out.write(reinterpret_cast<const char*>(data.brdfLut.data()),
+                      static_cast<std::streamsize>(sizeof(float) * data.brdfLut.size()));
+            if (!out) {
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary, path, ec);
+        return !ec;
+    }
+
+    static bool ReadCacheFile(const std::string& path, uint64_t sourceHash, const IblSettings& settings, IblData& out) {
+        BrightForge::MappedFile file;
+        if (!file.Open(path) || file.Size() < sizeof(CacheHeader)) {
+            return false;
+        }
+
+        CacheHeader expected = MakeHeader(sourceHash, settings);
+        if (std::memcmp(file.Data(), &expected, sizeof(CacheHeader)) != 0) {
+            return false;
+        }
+
+        size_t floats = 27 + static_cast<size_t>(settings.lutSize) * settings.lutSize * 2;
+        for (uint32_t mip = 0; mip < settings.mipCount; ++mip) {
+            size_t size = std::max(1u, settings.cubeSize >> mip);
+            floats += 6 * size * size * 4;
+        }
+        if (file.Size() != sizeof(CacheHeader) + floats * sizeof(float)) {
+            return false;
+        }
+
+        const uint8_t* cursor = file.Data() + sizeof(CacheHeader);
+        auto take = [&cursor](float* destination, size_t count) {
+            std::memcpy(destination, cursor, count * sizeof(float));
+            cursor += count * sizeof(float);
+        };
+
+        out.sourceHash = sourceHash;
+        out.settings = settings;
+        take(out.sh.data(), out.sh.size());
+        out.prefiltered.assign(settings.mipCount, std::vector<float>());
+        for (uint32_t mip = 0; mip < settings.mipCount; ++mip) {
+            size_t size = std::max(1u, settings.cubeSize >> mip);
+            out.prefiltered[mip].resize(6 * size * size * 4);
+            take(out.prefiltered[mip].data(), out.prefiltered[mip].size());
+        }
+        out.brdfLut.resize(static_cast<size_t>(settings.lutSize) * settings.lutSize * 2);
+        take(out.brdfLut.data(), out.brdfLut.size());
+        return true;
+    }
+
+    // Disk round trip and key mismatch
+    static void RegisterTests() {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        tests.RegisterSuite("IblCache");
+
+        tests.AddTest("IblCache", "Disk round trip", []() {
+            std::error_code ec;
+            std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / "brightforge_ibl_test";
+            std::filesystem::remove_all(dir, ec);
+
+            HdrImage gradient;
+            gradient.width = 32;
+            gradient.height = 16;
+            gradient.pixels.resize(32 * 16 * 4);
+            for (size_t i = 0; i < gradient.pixels.size(); ++i) {
+                gradient.pixels[i] = static_cast<float>(i % 97) / 97.0f;
+            }
+
+            IblSettings settings;
+            settings.cubeSize = 4;
+            settings.mipCount = 2;
+            settings.specularSamples = 8;
+            settings.lutSize = 8;
+            settings.lutSamples = 8;
+
+            IblData baked;
+            IblBaker::Bake(gradient, settings, baked);
+            baked.sourceHash = 0x1234;
+
+            std::string path = (dir / "test.bfibl").string();
+            IblData loaded;
+            bool ok = WriteCacheFile(path, baked) && ReadCacheFile(path, 0x1234, settings, loaded) &&
+                      loaded.sh == baked.sh && loaded.prefiltered == baked.prefiltered && loaded.brdfLut == baked.brdfLut;
+
+            // Different settings must miss
+            settings.cubeSize = 8;
+            ok = ok && !ReadCacheFile(path, 0x1234, settings, loaded);
+
+            std::filesystem::remove_all(dir, ec);
+            return ok;
+        });
+    }
+
+    // Prevent copy/move
+    IblCache(const IblCache&) = delete;
+    IblCache& operator=(const IblCache&) = delete;
+    IblCache(IblCache&&) = delete;
+    IblCache& operator=(IblCache&&) = delete;
+
+private:
+    struct CacheHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t cubeSize;
+        uint32_t mipCount;
+        uint32_t specularSamples;
+        uint32_t lutSize;
+        uint32_t lutSamples;
+        uint64_t sourceHash;
+    };
+
+    static CacheHeader MakeHeader(uint64_t sourceHash, const IblSettings& settings) {
+        CacheHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "BFIBL\0\0\0", 8);
+        header.version = IBL_CACHE_VERSION;
+        header.cubeSize = settings.cubeSize;
+        header.mipCount = settings.mipCount;
+        header.specularSamples = settings.specularSamples;
+        header.lutSize = settings.lutSize;
+        header.lutSamples = settings.lutSamples;
+        header.sourceHash = sourceHash;
+        return header;
+    }
+
+    // XXH3-64 over the file bytes (runs on every Get(), so it must stay near memory speed)
+    static uint64_t HashBytes(const uint8_t* data, size_t size) {
+        return Xxh3::Hash64(data, size);
+    }
+
+    static uint64_t HashSettings(const IblSettings& settings) {
+        uint32_t fields[6] = { settings.cubeSize, settings.mipCount, settings.specularSamples,
+                               settings.lutSize, settings.lutSamples, IBL_CACHE_VERSION };
+        return HashBytes(reinterpret_cast<const uint8_t*>(fields), sizeof(fields));
+    }
+
+    std::string CachePath(uint64_t key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bfibl", static_cast<unsigned long long>(key));
+        return (std::filesystem::path(mCacheDir) / name).string();
+    }
+
+    std::string mCacheDir;
+    std::mutex mMutex;
+    std::unordered_map<uint64_t, std::shared_ptr<const IblData>> mMemory;
+};
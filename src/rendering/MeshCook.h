@@ -0,0 +1,150 @@
+/** MeshCook - SoftwareMesh blob format and mesh steps for the AssetCooker
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "SoftwareMesh.h"
+#include "MeshLod.h"
+#include "../core/AssetCooker.h"
+#include "../core/TestManagerNew.h"
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+
+// Step versions: bump when the step's output changes for the same input
+constexpr uint32_t MESH_COOK_FORMAT_VERSION = 1;
+constexpr uint32_t MESH_COOK_CLUSTER_VERSION = 1;
+
+// Step names shared by every pipeline that produces SoftwareMesh blobs
+constexpr const char* MESH_COOK_IMPORT_STEP = "mesh.import";
+constexpr const char* MESH_COOK_CLUSTER_STEP = "mesh.cluster";
+
+// MeshCook turns SoftwareMesh data into cooker blobs and back:
+// - Blob layout: 32-byte header, vertex floats, uint32 indices (native endianness;
+//   the store is a local cache, not an interchange format)
+// - "mesh.cluster" runs MeshLod::Cluster on a mesh blob; params are the cell count
+// The import step depends on the owner's loaders, so it is registered by the owner
+// (see SoftwareRenderService) with a version that covers those loaders.
+class MeshCook {
+public:
+    static CookBlob Serialize(const SoftwareMesh& mesh) {
+        Header header = MakeHeader(mesh);
+        size_t vertexBytes = mesh.vertices.size() * sizeof(float);
+        size_t indexBytes = mesh.indices.size() * sizeof(uint32_t);
+
+        CookBlob blob(sizeof(Header) + vertexBytes + indexBytes);
+        std::memcpy(blob.data(), &header, sizeof(Header));
+        if (vertexBytes > 0) {
+            std::memcpy(blob.data() + sizeof(Header), mesh.vertices.data(), vertexBytes);
+        }
+        if (indexBytes > 0) {
+            std::memcpy(blob.data() + sizeof(Header) + vertexBytes, mesh.indices.data(), indexBytes);
+        }
+        return blob;
+    }
+
+    // Returns false for blobs that are not a well-formed mesh
+    static bool Deserialize(const CookBlob& blob, SoftwareMesh& outMesh) {
+        if (blob.size() < sizeof(Header)) {
+            return false;
+        }
+
+        Header header;
+        std::memcpy(&header, blob.data(), sizeof(Header));
+        if (std::memcmp(header.magic, "BFMESH\0\0", 8) != 0 || header.version != MESH_COOK_FORMAT_VERSION ||
+            header.vertexStride == 0 || header.vertexFloats % header.vertexStride != 0 ||
+            header.vertexFloats > blob.size() || header.indexCount > blob.size() ||
+            blob.size() != sizeof(Header) + header.vertexFloats * sizeof(float) + header.indexCount * sizeof(uint32_t)) {
+            return false;
+        }
+
+        const uint8_t* cursor = blob.data() + sizeof(Header);
+        outMesh.vertexStride = header.vertexStride;
+        outMesh.vertices.resize(static_cast<size_t>(header.vertexFloats));
+        outMesh.indices.resize(static_cast<size_t>(header.indexCount));
+        if (!outMesh.vertices.empty()) {
+            std::memcpy(outMesh.vertices.data(), cursor, outMesh.vertices.size() * sizeof(float));
+        }
+        cursor += outMesh.vertices.size() * sizeof(float);
+        if (!outMesh.indices.empty()) {
+            std::memcpy(outMesh.indices.data(), cursor, outMesh.indices.size() * sizeof(uint32_t));
+        }
+        return true;
+    }
+
+    // Version to register a mesh-producing step with: a blob format change must
+    // invalidate every cached mesh, whichever step produced it
+    static uint32_t StepVersion(uint32_t stepVersion) {
+        return (MESH_COOK_FORMAT_VERSION << 16) | stepVersion;
+    }
+
+    // Register the loader-independent mesh steps on `cooker`
+    static void RegisterSteps(AssetCooker& cooker) {
+        cooker.RegisterStep(MESH_COOK_CLUSTER_STEP, StepVersion(MESH_COOK_CLUSTER_VERSION),
+            [](const CookInput& input, CookBlob& output, std::string& error) {
+                SoftwareMesh mesh;
+                if (!Deserialize(input.data, mesh)) {
+                    error = "input is not a mesh blob";
+                    return false;
+                }
+                unsigned long cells = input.params.empty() ? MESH_LOD_PROXY_CELLS
+                                                           : std::strtoul(input.params.c_str(), nullptr, 10);
+                if (cells == 0 || cells > 65536) {
+                    error = "bad cell count '" + input.params + "'";
+                    return false;
+                }
+                output = Serialize(MeshLod::Cluster(mesh, static_cast<uint32_t>(cells)));
+                return true;
+            });
+    }
+
+    // Blob round trip
+    static void RegisterTests() {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        tests.RegisterSuite("MeshCook");
+
+        tests.AddTest("MeshCook", "Blob round trip rejects truncation", []() {
+            SoftwareMesh mesh;
+            for (uint32_t i = 0; i < 3 * SOFTWARE_MESH_STRIDE; ++i) {
+                mesh.vertices.push_back(static_cast<float>(i) * 0.5f);
+            }
+            mesh.indices = { 0, 1, 2 };
+
+            CookBlob blob = Serialize(mesh);
+            SoftwareMesh loaded;
+            bool ok = Deserialize(blob, loaded) && loaded.vertices == mesh.vertices &&
+                      loaded.indices == mesh.indices && loaded.vertexStride == mesh.vertexStride;
+
+            blob.pop_back();
+            return ok && !Deserialize(blob, loaded);
+        });
+    }
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t vertexStride;
+        uint64_t vertexFloats;
+        uint64_t indexCount;
+    };
+
+    static Header MakeHeader(const SoftwareMesh& mesh) {
+        Header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "BFMESH\0\0", 8);
+        header.version = MESH_COOK_FORMAT_VERSION;
+        header.vertexStride = mesh.vertexStride;
+        header.vertexFloats = mesh.vertices.size();
+        header.indexCount = mesh.indices.size();
+        return header;
+    }
+};
+
+// Note on usage:
+// SoftwareRenderService cooks "mesh.import" for full detail and "mesh.import" +
+// "mesh.cluster" for the residency proxy, so re-imports and re-streams of unchanged
+// files are store lookups.
@@ -0,0 +1,1037 @@
+/** MeshDecimator - Quadric-error edge-collapse simplification for SoftwareMesh
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "SoftwareMesh.h"
+#include "../core/Parallel.h"
+#include "../core/TestManagerNew.h"
+#include <string>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+// Face budgets of the forge3d optimize presets (src/forge3d/pipeline/stages/optimize-mesh.js)
+struct MeshDecimatePreset {
+    const char* name;
+    uint32_t triangles;
+};
+
+inline constexpr MeshDecimatePreset MESH_DECIMATE_PRESETS[] = {
+    { "mobile", 2000 }, { "web", 5000 }, { "desktop", 10000 }, { "unreal", 50000 }
+};
+
+struct MeshDecimateOptions {
+    bool lockBorders;           // Pin open-boundary vertices instead of sliding them along the border
+    float borderWeight;         // Strength of the planes that hold borders on their line
+    float maxError;             // Stop early past this error (fraction of the longest bounds axis)
+    uint32_t workerCount;       // 0 = hardware concurrency
+
+    MeshDecimateOptions()
+        : lockBorders(false), borderWeight(10.0f), maxError(std::numeric_limits<float>::infinity()), workerCount(0) {}
+};
+
+struct MeshDecimateLevel {
+    uint32_t targetTriangles = 0;
+    SoftwareMesh mesh;
+    float error = 0.0f;         // Largest collapse error spent reaching this level, as maxError measures it
+};
+
+// MeshDecimator - stateless entry points
+// Garland-Heckbert quadrics with half-edge collapses: a vertex always collapses onto a
+// neighbour that already exists, so every surviving vertex keeps its original attributes
+// and nothing is interpolated.
+// - Vertices are welded by position, within a small tolerance so split seams close; each
+//   original vertex is a "wedge" of its position.
+//   A collapse is taken only if every wedge of the moving position has a matching wedge
+//   across the collapsed edge, which keeps UV and normal seams intact (a seam vertex can
+//   slide along its seam, never across it)
+// - Open borders slide only along border edges (corners and non-manifold edges are
+//   locked), or stay put entirely with lockBorders
+// - Collapses that flip a triangle or break the link condition are rejected
+// - Best collapses are computed per vertex in parallel, then drained from an indexed
+//   min-heap; DecimateChain() snapshots each target on the way down, so a whole preset
+//   ladder costs one simplification
+class MeshDecimator {
+public:
+    // Simplified copy of `mesh` with at most targetTriangles triangles where the
+    // constraints allow it. Meshes without valid triangles are returned unchanged.
+    static SoftwareMesh Decimate(const SoftwareMesh& mesh, uint32_t targetTriangles,
+                                 const MeshDecimateOptions& options = MeshDecimateOptions(), float* outError = nullptr) {
+        std::vector<MeshDecimateLevel> levels = DecimateChain(mesh, { targetTriangles }, options);
+        if (outError != nullptr) {
+            *outError = levels[0].error;
+        }
+        return std::move(levels[0].mesh);
+    }
+
+    // One level per entry of `targets`, in the same order. Targets are reached largest
+    // first from a single collapse sequence, so each level matches Decimate() at its target.
+    static std::vector<MeshDecimateLevel> DecimateChain(const SoftwareMesh& mesh, const std::vector<uint32_t>& targets,
+                                                        const MeshDecimateOptions& options = MeshDecimateOptions()) {
+        std::vector<MeshDecimateLevel> levels(targets.size());
+        for (size_t i = 0; i < targets.size(); ++i) {
+            levels[i].targetTriangles = targets[i];
+        }
+
+        State state(mesh, options);
+        if (!state.Build()) {
+            for (MeshDecimateLevel& level : levels) {
+                level.mesh = mesh;
+            }
+            return levels;
+        }
+
+        std::vector<size_t> order(targets.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return targets[a] > targets[b]; });
+        for (size_t index : order) {
+            state.CollapseTo(targets[index]);
+            levels[index].mesh = state.Extract();
+            levels[index].error = state.MaxError();
+        }
+        return levels;
+    }
+
+    // Triangle budget of a named preset, 0 when the name is unknown
+    static uint32_t PresetTriangles(const std::string& name) {
+        for (const MeshDecimatePreset& preset : MESH_DECIMATE_PRESETS) {
+            if (name == preset.name) {
+                return preset.triangles;
+            }
+        }
+        return 0;
+    }
+
+    // Reduction, seams, manifoldness and chain consistency
+    static void RegisterTests();
+
+    // Prevent instantiation (static API)
+    MeshDecimator() = delete;
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr double INFINITE_COST = std::numeric_limits<double>::infinity();
+
+    // Symmetric 4x4 quadric (upper triangle) plus the area that went into it
+    struct Quadric {
+        double xx = 0, xy = 0, xz = 0, xw = 0, yy = 0, yz = 0, yw = 0, zz = 0, zw = 0, ww = 0;
+        double weight = 0;
+
+        // Plane n.p + d = 0 with unit n, scaled by weight
+        void AddPlane(double nx, double ny, double nz, double d, double w) {
+            xx += w * nx * nx; xy += w * nx * ny; xz += w * nx * nz; xw += w * nx * d;
+            yy += w * ny * ny; yz += w * ny * nz; yw += w * ny * d;
+            zz += w * nz * nz; zw += w * nz * d;
+            ww += w * d * d;
+            weight += w;
+        }
+
+        void Add(const Quadric& o) {
+            xx += o.xx; xy += o.xy; xz += o.xz; xw += o.xw; yy += o.yy; yz += o.yz; yw += o.yw;
+            zz += o.zz; zw += o.zw; ww += o.ww; weight += o.weight;
+        }
+
+        double Evaluate(const float* p) const {
+            double x = p[0], y = p[1], z = p[2];
+            double error = xx * x * x + 2.0 * (xy * x * y + xz * x * z + xw * x) + yy * y * y +
+                           2.0 * (yz * y * z + yw * y) + zz * z * z + 2.0 * zw * z + ww;
+            return std::max(error, 0.0);
+        }
+    };
+
+    // Min-heap over vertex ids with O(log n) key updates
+    class IndexedHeap {
+    public:
+        void Build(const std::vector<double>& keys, const std::vector<uint8_t>& include) {
+            mKeys = keys;
+            mSlots.assign(keys.size(), NONE);
+            mHeap.clear();
+            for (uint32_t i = 0; i < keys.size(); ++i) {
+                if (include[i]) {
+                    mSlots[i] = static_cast<uint32_t>(mHeap.size());
+                    mHeap.push_back(i);
+                }
+            }
+            for (size_t i = mHeap.size() / 2; i-- > 0;) {
+                SiftDown(i);
+            }
+        }
+
+        bool Empty() const { return mHeap.empty(); }
+        uint32_t Top() const { return mHeap[0]; }
+        double TopKey() const { return mKeys[mHeap[0]]; }
+
+        void Pop() {
+            Remove(mHeap[0]);
+        }
+
+        void Remove(uint32_t item) {
+            uint32_t slot = mSlots[item];
+            if (slot == NONE) {
+                return;
+            }
+            uint32_t last = mHeap.back();
+            mHeap.pop_back();
+            mSlots[item] = NONE;
+            if (last != item) {
+                mHeap[slot] = last;
+                mSlots[last] = slot;
+                SiftDown(slot);
+                SiftUp(mSlots[last]);
+            }
+        }
+
+        void Update(uint32_t item, double key) {
+            mKeys[item] = key;
+            if (mSlots[item] == NONE) {
+                mSlots[item] = static_cast<uint32_t>(mHeap.size());
+                mHeap.push_back(item);
+            }
+            SiftUp(mSlots[item]);
+            SiftDown(mSlots[item]);
+        }
+
+    private:
+        std::vector<double> mKeys;
+        std::vector<uint32_t> mHeap;
+        std::vector<uint32_t> mSlots;
+
+        void Place(size_t slot, uint32_t item) {
+            mHeap[slot] = item;
+            mSlots[item] = static_cast<uint32_t>(slot);
+        }
+
+        void SiftUp(size_t slot) {
+            uint32_t item = mHeap[slot];
+            while (slot > 0) {
+                size_t parent = (slot - 1) / 2;
+                if (mKeys[mHeap[parent]] <= mKeys[item]) {
+                    break;
+                }
+                Place(slot, mHeap[parent]);
+                slot = parent;
+            }
+            Place(slot, item);
+        }
+
+        void SiftDown(size_t slot) {
+            uint32_t item = mHeap[slot];
+            for (;;) {
+                size_t child = slot * 2 + 1;
+                if (child >= mHeap.size()) {
+                    break;
+                }
+                if (child + 1 < mHeap.size() && mKeys[mHeap[child + 1]] < mKeys[mHeap[child]]) {
+                    ++child;
+                }
+                if (mKeys[item] <= mKeys[mHeap[child]]) {
+                    break;
+                }
+                Place(slot, mHeap[child]);
+                slot = child;
+            }
+            Place(slot, item);
+        }
+    };
+
+    // Flat regions tie at zero cost; a faint edge-length term breaks the ties toward short
+    // edges, which keeps valence even instead of growing fans. Errors use `cost` alone.
+    static constexpr double EDGE_LENGTH_BIAS = 1e-4;
+    // Weld grid spacing relative to the longest bounds axis (MeshValidator uses the same)
+    static constexpr double WELD_TOLERANCE = 1e-6;
+
+    struct Candidate {
+        uint32_t target = NONE;
+        double cost = INFINITE_COST;    // Quadric error
+        double key = INFINITE_COST;     // Heap order
+    };
+
+    // Weld grid cell (see State::Build)
+    struct PositionKey {
+        uint32_t cell[3];
+        bool operator==(const PositionKey& o) const {
+            return cell[0] == o.cell[0] && cell[1] == o.cell[1] && cell[2] == o.cell[2];
+        }
+    };
+
+    struct PositionKeyHash {
+        size_t operator()(const PositionKey& key) const {
+            uint64_t h = key.cell[0] * 0x9E3779B97F4A7C15ull;
+            h ^= (h >> 29) ^ (key.cell[1] * 0xC2B2AE3D27D4EB4Full);
+            h ^= (h >> 31) ^ (key.cell[2] * 0x165667B19E3779F9ull);
+            return static_cast<size_t>(h ^ (h >> 32));
+        }
+    };
+
+    // Working set for one source mesh. Positions ("vertices" below) own quadrics and
+    // adjacency; triangles reference wedges (source vertices) so attributes stay exact.
+    class State {
+    public:
+        State(const SoftwareMesh& mesh, const MeshDecimateOptions& options) : mMesh(mesh), mOptions(options) {}
+
+        bool Build() {
+            const uint32_t stride = mMesh.vertexStride;
+            const size_t wedgeCount = stride >= 3 ? mMesh.vertices.size() / stride : 0;
+            if (wedgeCount == 0 || wedgeCount >= NONE || mMesh.indices.size() < 3) {
+                return false;
+            }
+
+            // Weld wedges within WELD_TOLERANCE x the longest axis, like MeshValidator, so
+            // seams whose two sides were computed separately (sin(2 pi) != 0) still close
+            float weldMin[3] = { 0.0f, 0.0f, 0.0f }, weldMax[3] = { 0.0f, 0.0f, 0.0f };
+            bool hasBounds = false;
+            for (size_t w = 0; w < wedgeCount; ++w) {
+                const float* p = &mMesh.vertices[w * stride];
+                if (!std::isfinite(p[0]) || !std::isfinite(p[1]) || !std::isfinite(p[2])) {
+                    continue;
+                }
+                for (int axis = 0; axis < 3; ++axis) {
+                    weldMin[axis] = hasBounds ? std::min(weldMin[axis], p[axis]) : p[axis];
+                    weldMax[axis] = hasBounds ? std::max(weldMax[axis], p[axis]) : p[axis];
+                }
+                hasBounds = true;
+            }
+            const double quantum = std::max({ weldMax[0] - weldMin[0], weldMax[1] - weldMin[1],
+                                              weldMax[2] - weldMin[2] }) * WELD_TOLERANCE;
+
+            // One welded position per cell (every point of a cell lies within one quantum of
+            // it); a wedge joins the first position within a quantum in its 3x3x3 block, so a
+            // seam straddling a cell boundary still closes
+            std::unordered_map<PositionKey, uint32_t, PositionKeyHash> cells;
+            cells.reserve(wedgeCount);
+            mWedgePosition.resize(wedgeCount);
+            for (size_t w = 0; w < wedgeCount; ++w) {
+                const float* p = &mMesh.vertices[w * stride];
+                const uint32_t next = static_cast<uint32_t>(mPositions.size() / 3);
+                if (!std::isfinite(p[0]) || !std::isfinite(p[1]) || !std::isfinite(p[2])) {
+                    // Never welded: a NaN corner must not stitch unrelated triangles together
+                    mPositions.insert(mPositions.end(), p, p + 3);
+                    mWedgePosition[w] = next;
+                    continue;
+                }
+                PositionKey key;
+                for (int axis = 0; axis < 3; ++axis) {
+                    key.cell[axis] = quantum > 0.0 ? static_cast<uint32_t>((p[axis] - weldMin[axis]) / quantum) : 0;
+                }
+                uint32_t match = NONE;
+                for (int dz = -1; dz <= 1 && match == NONE; ++dz) {
+                    for (int dy = -1; dy <= 1 && match == NONE; ++dy) {
+                        for (int dx = -1; dx <= 1 && match == NONE; ++dx) {
+                            PositionKey neighbour = { { key.cell[0] + dx, key.cell[1] + dy, key.cell[2] + dz } };
+                            auto found = cells.find(neighbour);
+                            if (found == cells.end()) {
+                                continue;
+                            }
+                            const float* q = &mPositions[static_cast<size_t>(found->second) * 3];
+                            if (std::fabs(q[0] - p[0]) <= quantum && std::fabs(q[1] - p[1]) <= quantum &&
+                                std::fabs(q[2] - p[2]) <= quantum) {
+                                match = found->second;
+                            }
+                        }
+                    }
+                }
+                if (match == NONE) {
+                    match = next;
+                    mPositions.insert(mPositions.end(), p, p + 3);
+                    cells.emplace(key, match);
+                }
+                mWedgePosition[w] = match;
+            }
+            const size_t positionCount = mPositions.size() / 3;
+
+            // Triangles that are degenerate after welding never contribute
+            for (size_t t = 0; t + 2 < mMesh.indices.size(); t += 3) {
+                std::array<uint32_t, 3> corners = { mMesh.indices[t], mMesh.indices[t + 1], mMesh.indices[t + 2] };
+                if (corners[0] >= wedgeCount || corners[1] >= wedgeCount || corners[2] >= wedgeCount) {
+                    return false;
+                }
+                uint32_t a = mWedgePosition[corners[0]], b = mWedgePosition[corners[1]], c = mWedgePosition[corners[2]];
+                if (a != b && b != c && a != c) {
+                    mTriangles.push_back({ { corners[0], corners[1], corners[2] }, { a, b, c } });
+                }
+            }
+            if (mTriangles.empty()) {
+                return false;
+            }
+            mAlive.assign(mTriangles.size(), 1);
+            mLiveTriangles = mTriangles.size();
+
+            mPositionTriangles.resize(positionCount);
+            for (uint32_t t = 0; t < mTriangles.size(); ++t) {
+                for (uint32_t position : mTriangles[t].positions) {
+                    mPositionTriangles[position].push_back(t);
+                }
+            }
+
+            ClassifyEdges(positionCount);
+            AccumulateQuadrics(positionCount);
+
+            float boundsMin[3] = { mPositions[0], mPositions[1], mPositions[2] };
+            float boundsMax[3] = { boundsMin[0], boundsMin[1], boundsMin[2] };
+            for (size_t v = 0; v < positionCount; ++v) {
+                for (int axis = 0; axis < 3; ++axis) {
+                    boundsMin[axis] = std::min(boundsMin[axis], mPositions[v * 3 + axis]);
+                    boundsMax[axis] = std::max(boundsMax[axis], mPositions[v * 3 + axis]);
+                }
+            }
+            mExtent = std::max({ boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2] });
+            mExtent = mExtent > 0.0f ? mExtent : 1.0f;
+
+            // Initial best collapse per vertex: read-only over the mesh, so in parallel
+            mBest.resize(positionCount);
+            mRemoved.assign(positionCount, 0);
+            Parallel::ForRange(positionCount, 256, [&](size_t begin, size_t end) {
+                Scratch scratch;
+                for (size_t v = begin; v < end; ++v) {
+                    mBest[v] = FindBest(static_cast<uint32_t>(v), scratch);
+                }
+            }, mOptions.workerCount);
+
+            std::vector<double> keys(positionCount);
+            std::vector<uint8_t> include(positionCount);
+            for (size_t v = 0; v < positionCount; ++v) {
+                keys[v] = mBest[v].key;
+                include[v] = mKind[v] != Kind::LOCKED;
+            }
+            mHeap.Build(keys, include);
+            return true;
+        }
+
+        void CollapseTo(uint32_t targetTriangles) {
+            Scratch scratch;
+            while (mLiveTriangles > targetTriangles && !mHeap.Empty()) {
+                uint32_t from = mHeap.Top();
+                if (mHeap.TopKey() == INFINITE_COST) {
+                    break;
+                }
+
+                // Neighbourhoods two rings out can change without a recompute; recheck
+                // the winner and start the vertex over if its collapse went stale
+                Candidate fresh = mBest[from];
+                GatherNeighbours(from, scratch.neighbours);
+                if (!std::binary_search(scratch.neighbours.begin(), scratch.neighbours.end(), fresh.target) ||
+                    Evaluate(from, fresh.target).key != fresh.key || !CanCollapse(from, fresh.target, scratch)) {
+                    Refresh(from, scratch);
+                    continue;
+                }
+                if (ErrorOf(from, fresh) > mOptions.maxError) {
+                    break;
+                }
+
+                mHeap.Pop();
+                mMaxError = std::max(mMaxError, ErrorOf(from, fresh));
+                Collapse(from, fresh.target, scratch);
+
+                // The survivor and neighbours that were headed for either end start over.
+                // Other neighbours only gain a (possibly cheaper) edge to the survivor;
+                // collapses invalidated further out are caught by the recheck above.
+                uint32_t to = fresh.target;
+                Refresh(to, scratch);
+                GatherNeighbours(to, scratch.dirty);
+                for (uint32_t v : scratch.dirty) {
+                    if (mKind[v] == Kind::LOCKED) {
+                        continue;
+                    }
+                    uint32_t previous = mBest[v].target;
+                    if (previous == NONE || previous == from || previous == to) {
+                        Refresh(v, scratch);
+                        continue;
+                    }
+                    Candidate edge = Evaluate(v, to);
+                    if (edge.key < mBest[v].key) {
+                        GatherNeighbours(v, scratch.neighbours);
+                        if (CanCollapse(v, to, scratch)) {
+                            mBest[v] = edge;
+                            mHeap.Update(v, edge.key);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Live triangles over the wedges they still use, in first-use order
+        SoftwareMesh Extract() const {
+            const uint32_t stride = mMesh.vertexStride;
+            SoftwareMesh result;
+            result.vertexStride = stride;
+            result.indices.reserve(mLiveTriangles * 3);
+
+            std::vector<uint32_t> remap(mWedgePosition.size(), NONE);
+            uint32_t next = 0;
+            for (size_t t = 0; t < mTriangles.size(); ++t) {
+                if (!mAlive[t]) {
+                    continue;
+                }
+                for (uint32_t wedge : mTriangles[t].wedges) {
+                    if (remap[wedge] == NONE) {
+                        remap[wedge] = next++;
+                    }
+                    result.indices.push_back(remap[wedge]);
+                }
+            }
+
+            result.vertices.resize(static_cast<size_t>(next) * stride);
+            for (size_t w = 0; w < remap.size(); ++w) {
+                if (remap[w] != NONE) {
+                    std::memcpy(&result.vertices[static_cast<size_t>(remap[w]) * stride], &mMesh.vertices[w * stride],
+                                stride * sizeof(float));
+                }
+            }
+            return result;
+        }
+
+        float MaxError() const { return mMaxError; }
+
+    private:
+        enum class Kind : uint8_t { INTERIOR, BORDER, LOCKED };
+
+        // Corners as wedges, with their welded positions cached alongside
+        struct Triangle {
+            uint32_t wedges[3];
+            uint32_t positions[3];
+        };
+
+        // Reused buffers for candidate evaluation
+        struct Scratch {
+            std::vector<uint32_t> neighbours;
+            std::vector<uint32_t> otherNeighbours;
+            std::vector<uint32_t> dirty;
+            std::vector<Candidate> candidates;
+            std::vector<std::pair<uint32_t, uint32_t>> wedgePairs;
+        };
+
+        const SoftwareMesh& mMesh;
+        MeshDecimateOptions mOptions;
+        std::vector<float> mPositions;                      // xyz per welded position
+        std::vector<uint32_t> mWedgePosition;               // Source vertex -> welded position
+        std::vector<Triangle> mTriangles;
+        std::vector<uint8_t> mAlive;
+        std::vector<std::vector<uint32_t>> mPositionTriangles;
+        std::vector<Kind> mKind;
+        std::vector<uint64_t> mBorderEdges;                 // Welded (low << 32 | high) pairs
+        std::vector<Quadric> mQuadrics;
+        std::vector<Candidate> mBest;
+        std::vector<uint8_t> mRemoved;
+        IndexedHeap mHeap;
+        size_t mLiveTriangles = 0;
+        float mExtent = 1.0f;
+        float mMaxError = 0.0f;
+
+        const float* PositionOf(uint32_t v) const { return &mPositions[static_cast<size_t>(v) * 3]; }
+
+        // Border edges have one triangle, manifold interior edges two, anything else pins both ends
+        void ClassifyEdges(size_t positionCount) {
+            std::vector<uint64_t> edges;
+            edges.reserve(mTriangles.size() * 3);
+            for (const auto& triangle : mTriangles) {
+                for (int e = 0; e < 3; ++e) {
+                    uint64_t a = triangle.positions[e];
+                    uint64_t b = triangle.positions[(e + 1) % 3];
+                    edges.push_back(a < b ? (a << 32) | b : (b << 32) | a);
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+
+            std::vector<uint32_t> borderEdges(positionCount, 0);
+            std::vector<uint8_t> nonManifold(positionCount, 0);
+            mBorderEdges.clear();
+            for (size_t i = 0; i < edges.size();) {
+                size_t run = i;
+                while (run < edges.size() && edges[run] == edges[i]) {
+                    ++run;
+                }
+                uint32_t a = static_cast<uint32_t>(edges[i] >> 32);
+                uint32_t b = static_cast<uint32_t>(edges[i] & 0xFFFFFFFFu);
+                if (run - i == 1) {
+                    ++borderEdges[a];
+                    ++borderEdges[b];
+                    mBorderEdges.push_back(edges[i]);
+                } else if (run - i > 2) {
+                    nonManifold[a] = nonManifold[b] = 1;
+                }
+                i = run;
+            }
+
+            mKind.assign(positionCount, Kind::INTERIOR);
+            for (size_t v = 0; v < positionCount; ++v) {
+                if (nonManifold[v] || (borderEdges[v] != 0 && (borderEdges[v] != 2 || mOptions.lockBorders))) {
+                    mKind[v] = Kind::LOCKED;
+                } else if (borderEdges[v] == 2) {
+                    mKind[v] = Kind::BORDER;
+                }
+            }
+        }
+
+        // Area-weighted face planes per vertex (gathered, so no write conflicts), then
+        // perpendicular planes along borders to keep their outline
+        void AccumulateQuadrics(size_t positionCount) {
+            mQuadrics.assign(positionCount, Quadric());
+            Parallel::ForRange(positionCount, 256, [&](size_t begin, size_t end) {
+                for (size_t v = begin; v < end; ++v) {
+                    for (uint32_t t : mPositionTriangles[v]) {
+                        double n[3], d, area;
+                        if (TrianglePlane(t, n, d, area)) {
+                            mQuadrics[v].AddPlane(n[0], n[1], n[2], d, area);
+                        }
+                    }
+                }
+            }, mOptions.workerCount);
+
+            for (uint64_t edge : mBorderEdges) {
+                uint32_t a = static_cast<uint32_t>(edge >> 32);
+                uint32_t b = static_cast<uint32_t>(edge & 0xFFFFFFFFu);
+                uint32_t triangle = NONE;
+                for (uint32_t t : mPositionTriangles[a]) {
+                    if (Contains(t, b)) {
+                        triangle = t;
+                        break;
+                    }
+                }
+                double n[3], d, area;
+                if (triangle == NONE || !TrianglePlane(triangle, n, d, area)) {
+                    continue;
+                }
+
+                // Plane through the edge, perpendicular to its face
+                const float* pa = PositionOf(a);
+                const float* pb = PositionOf(b);
+                double e[3] = { double(pb[0]) - pa[0], double(pb[1]) - pa[1], double(pb[2]) - pa[2] };
+                double p[3] = { e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0] };
+                double length = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+                if (length <= 0.0) {
+                    continue;
+                }
+                double edgeSquared = e[0] * e[0] + e[1] * e[1] + e[2] * e[2];
+                p[0] /= length;
+                p[1] /= length;
+                p[2] /= length;
+                double offset = -(p[0] * pa[0] + p[1] * pa[1] + p[2] * pa[2]);
+                double weight = edgeSquared * mOptions.borderWeight;
+                mQuadrics[a].AddPlane(p[0], p[1], p[2], offset, weight);
+                mQuadrics[b].AddPlane(p[0], p[1], p[2], offset, weight);
+            }
+        }
+
+        bool TrianglePlane(uint32_t t, double n[3], double& d, double& area) const {
+            const float* p0 = PositionOf(mTriangles[t].positions[0]);
+            const float* p1 = PositionOf(mTriangles[t].positions[1]);
+            const float* p2 = PositionOf(mTriangles[t].positions[2]);
+            double e1[3] = { double(p1[0]) - p0[0], double(p1[1]) - p0[1], double(p1[2]) - p0[2] };
+            double e2[3] = { double(p2[0]) - p0[0], double(p2[1]) - p0[1], double(p2[2]) - p0[2] };
+            n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+            n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+            n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+            double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length <= 0.0) {
+                return false;
+            }
+            n[0] /= length;
+            n[1] /= length;
+            n[2] /= length;
+            d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+            area = length * 0.5;
+            return true;
+        }
+
+        bool Contains(uint32_t t, uint32_t position) const {
+            const uint32_t* positions = mTriangles[t].positions;
+            return positions[0] == position || positions[1] == position || positions[2] == position;
+        }
+
+        // Sorted and unique, so link checks are a linear merge even around high-valence fans
+        void GatherNeighbours(uint32_t v, std::vector<uint32_t>& out) const {
+            out.clear();
+            for (uint32_t t : mPositionTriangles[v]) {
+                if (!mAlive[t]) {
+                    continue;
+                }
+                for (uint32_t position : mTriangles[t].positions) {
+                    if (position != v) {
+                        out.push_back(position);
+                    }
+                }
+            }
+            std::sort(out.begin(), out.end());
+            out.erase(std::unique(out.begin(), out.end()), out.end());
+        }
+
+        // RMS distance behind a collapse, relative to the mesh size
+        float ErrorOf(uint32_t from, const Candidate& candidate) const {
+            double weight = mQuadrics[from].weight + mQuadrics[candidate.target].weight;
+            double distance = weight > 0.0 ? std::sqrt(candidate.cost / weight) : 0.0;
+            return static_cast<float>(distance / mExtent);
+        }
+
+        void Refresh(uint32_t v, Scratch& scratch) {
+            mBest[v] = FindBest(v, scratch);
+            mHeap.Update(v, mBest[v].key);
+        }
+
+        Candidate Evaluate(uint32_t from, uint32_t to) const {
+            Quadric combined = mQuadrics[from];
+            combined.Add(mQuadrics[to]);
+            const float* a = PositionOf(from);
+            const float* b = PositionOf(to);
+            double dx = double(b[0]) - a[0], dy = double(b[1]) - a[1], dz = double(b[2]) - a[2];
+            Candidate candidate;
+            candidate.target = to;
+            candidate.cost = combined.Evaluate(b);
+            candidate.key = candidate.cost + EDGE_LENGTH_BIAS * combined.weight * (dx * dx + dy * dy + dz * dz);
+            return candidate;
+        }
+
+        Candidate FindBest(uint32_t from, Scratch& scratch) const {
+            Candidate best;
+            if (mKind[from] == Kind::LOCKED || mRemoved[from]) {
+                return best;
+            }
+
+            // An edge pairs at most two wedges, so a position with more can never move
+            uint32_t wedges[2] = { NONE, NONE };
+            for (uint32_t t : mPositionTriangles[from]) {
+                for (int c = 0; c < 3; ++c) {
+                    uint32_t wedge = mTriangles[t].wedges[c];
+                    if (!mAlive[t] || mTriangles[t].positions[c] != from || wedge == wedges[0] || wedge == wedges[1]) {
+                        continue;
+                    }
+                    if (wedges[1] != NONE) {
+                        return best;
+                    }
+                    wedges[wedges[0] == NONE ? 0 : 1] = wedge;
+                }
+            }
+
+            // Cheapest first; the topology checks only run until one collapse is legal
+            GatherNeighbours(from, scratch.neighbours);
+            scratch.candidates.clear();
+            for (uint32_t to : scratch.neighbours) {
+                scratch.candidates.push_back(Evaluate(from, to));
+            }
+            std::sort(scratch.candidates.begin(), scratch.candidates.end(), [](const Candidate& a, const Candidate& b) {
+                return a.key < b.key || (a.key == b.key && a.target < b.target);
+            });
+            for (const Candidate& candidate : scratch.candidates) {
+                if (CanCollapse(from, candidate.target, scratch)) {
+                    return candidate;
+                }
+            }
+            return best;
+        }
+
+        // Expects scratch.neighbours to hold the neighbours of `from`
+        bool CanCollapse(uint32_t from, uint32_t to, Scratch& scratch) const {
+            // Shared triangles; a border vertex may only travel along a border edge
+            uint32_t shared = 0;
+            scratch.wedgePairs.clear();
+            for (uint32_t t : mPositionTriangles[from]) {
+                if (!mAlive[t] || !Contains(t, to)) {
+                    continue;
+                }
+                ++shared;
+                uint32_t fromWedge = NONE, toWedge = NONE;
+                for (int c = 0; c < 3; ++c) {
+                    fromWedge = mTriangles[t].positions[c] == from ? mTriangles[t].wedges[c] : fromWedge;
+                    toWedge = mTriangles[t].positions[c] == to ? mTriangles[t].wedges[c] : toWedge;
+                }
+                scratch.wedgePairs.emplace_back(fromWedge, toWedge);
+            }
+            if (mKind[from] == Kind::BORDER && (shared != 1 || mKind[to] == Kind::INTERIOR)) {
+                return false;
+            }
+            if (shared == 0 || shared > 2) {
+                return false;
+            }
+
+            // Seams: each wedge of `from` needs a partner wedge of `to` across the edge
+            for (uint32_t t : mPositionTriangles[from]) {
+                if (!mAlive[t]) {
+                    continue;
+                }
+                for (int c = 0; c < 3; ++c) {
+                    uint32_t wedge = mTriangles[t].wedges[c];
+                    if (mTriangles[t].positions[c] != from) {
+                        continue;
+                    }
+                    bool paired = false;
+                    for (const auto& pair : scratch.wedgePairs) {
+                        paired = paired || pair.first == wedge;
+                    }
+                    if (!paired) {
+                        return false;
+                    }
+                }
+            }
+
+            // Link condition: the endpoints share exactly the apexes of their shared triangles
+            GatherNeighbours(to, scratch.otherNeighbours);
+            uint32_t common = 0;
+            for (size_t i = 0, j = 0; i < scratch.neighbours.size() && j < scratch.otherNeighbours.size();) {
+                if (scratch.neighbours[i] < scratch.otherNeighbours[j]) {
+                    ++i;
+                } else if (scratch.otherNeighbours[j] < scratch.neighbours[i]) {
+                    ++j;
+                } else {
+                    common += scratch.neighbours[i] != from && scratch.neighbours[i] != to ? 1 : 0;
+                    ++i;
+                    ++j;
+                }
+            }
+            if (common != shared) {
+                return false;
+            }
+
+            // No surviving triangle around `from` may flip or collapse to a sliver
+            const float* target = PositionOf(to);
+            for (uint32_t t : mPositionTriangles[from]) {
+                if (!mAlive[t] || Contains(t, to)) {
+                    continue;
+                }
+                const float* before[3];
+                const float* after[3];
+                for (int c = 0; c < 3; ++c) {
+                    uint32_t position = mTriangles[t].positions[c];
+                    before[c] = PositionOf(position);
+                    after[c] = position == from ? target : before[c];
+                }
+                double n0[3], n1[3];
+                Normal(before, n0);
+                Normal(after, n1);
+                double dot = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+                double lengths = std::sqrt((n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2]) *
+                                           (n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2]));
+                if (!(dot > 1e-3 * lengths) || lengths == 0.0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static void Normal(const float* const p[3], double n[3]) {
+            double e1[3] = { double(p[1][0]) - p[0][0], double(p[1][1]) - p[0][1], double(p[1][2]) - p[0][2] };
+            double e2[3] = { double(p[2][0]) - p[0][0], double(p[2][1]) - p[0][1], double(p[2][2]) - p[0][2] };
+            n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+            n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+            n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+        }
+
+        // Move `from` onto `to`: shared triangles die, the rest switch to partner wedges
+        void Collapse(uint32_t from, uint32_t to, Scratch& scratch) {
+            scratch.wedgePairs.clear();
+            for (uint32_t t : mPositionTriangles[from]) {
+                if (!mAlive[t] || !Contains(t, to)) {
+                    continue;
+                }
+                uint32_t fromWedge = NONE, toWedge = NONE;
+                for (int c = 0; c < 3; ++c) {
+                    fromWedge = mTriangles[t].positions[c] == from ? mTriangles[t].wedges[c] : fromWedge;
+                    toWedge = mTriangles[t].positions[c] == to ? mTriangles[t].wedges[c] : toWedge;
+                }
+                scratch.wedgePairs.emplace_back(fromWedge, toWedge);
+                mAlive[t] = 0;
+                --mLiveTriangles;
+            }
+
+            std::vector<uint32_t>& survivors = mPositionTriangles[to];
+            for (uint32_t t : mPositionTriangles[from]) {
+                if (!mAlive[t]) {
+                    continue;
+                }
+                for (int c = 0; c < 3; ++c) {
+                    if (mTriangles[t].positions[c] != from) {
+                        continue;
+                    }
+                    for (const auto& pair : scratch.wedgePairs) {
+                        if (pair.first == mTriangles[t].wedges[c]) {
+                            mTriangles[t].wedges[c] = pair.second;
+                            break;
+                        }
+                    }
+                    mTriangles[t].positions[c] = to;
+                }
+                survivors.push_back(t);
+            }
+            survivors.erase(std::remove_if(survivors.begin(), survivors.end(), [&](uint32_t t) { return !mAlive[t]; }),
+                            survivors.end());
+
+            mQuadrics[to].Add(mQuadrics[from]);
+            mRemoved[from] = 1;
+            std::vector<uint32_t>().swap(mPositionTriangles[from]);
+            mBest[from] = Candidate();
+        }
+    };
+};
+
+inline void MeshDecimator::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("MeshDecimator");
+
+    // n x n quads on the unit square; with seamAt > 0 the columns right of it get their
+    // own vertices and UVs shifted by 10, like a second UV chart
+    auto makeGrid = [](uint32_t n, uint32_t seamAt) {
+        SoftwareMesh grid;
+        auto add = [&](uint32_t x, uint32_t y, float uOffset) {
+            float vertex[SOFTWARE_MESH_STRIDE] = { x / float(n), y / float(n), 0.0f, 0.0f, 0.0f, 1.0f,
+                                                   x / float(n) + uOffset, y / float(n) };
+            grid.vertices.insert(grid.vertices.end(), vertex, vertex + SOFTWARE_MESH_STRIDE);
+        };
+        for (uint32_t y = 0; y <= n; ++y) {
+            for (uint32_t x = 0; x <= n; ++x) {
+                add(x, y, 0.0f);
+            }
+        }
+        std::vector<uint32_t> right((n + 1) * (n + 1), UINT32_MAX);
+        if (seamAt > 0) {
+            for (uint32_t y = 0; y <= n; ++y) {
+                for (uint32_t x = seamAt; x <= n; ++x) {
+                    right[y * (n + 1) + x] = static_cast<uint32_t>(grid.vertices.size() / SOFTWARE_MESH_STRIDE);
+                    add(x, y, 10.0f);
+                }
+            }
+        }
+        for (uint32_t y = 0; y < n; ++y) {
+            for (uint32_t x = 0; x < n; ++x) {
+                uint32_t i = y * (n + 1) + x;
+                uint32_t quad[6] = { i, i + 1, i + n + 1, i + 1, i + n + 2, i + n + 1 };
+                for (uint32_t& index : quad) {
+                    index = seamAt > 0 && x >= seamAt ? right[index] : index;
+                }
+                grid.indices.insert(grid.indices.end(), quad, quad + 6);
+            }
+        }
+        return grid;
+    };
+
+    tests.AddTest("MeshDecimator", "Flat grid reaches its target and keeps its outline", [makeGrid]() {
+        SoftwareMesh grid = makeGrid(48, 0);
+        float error = -1.0f;
+        SoftwareMesh result = Decimate(grid, 200, MeshDecimateOptions(), &error);
+
+        size_t vertexCount = result.vertices.size() / SOFTWARE_MESH_STRIDE;
+        float maxX = 0.0f, maxY = 0.0f;
+        bool ok = result.indices.size() / 3 <= 200 && !result.indices.empty() && error >= 0.0f && error < 1e-4f;
+        for (size_t v = 0; v < vertexCount; ++v) {
+            const float* p = &result.vertices[v * SOFTWARE_MESH_STRIDE];
+            ok = ok && p[2] == 0.0f && p[0] >= 0.0f && p[0] <= 1.0f && p[1] >= 0.0f && p[1] <= 1.0f;
+            maxX = std::max(maxX, p[0]);
+            maxY = std::max(maxY, p[1]);
+        }
+        // Corners are locked and the border stays on its line, so the area survives
+        double area = 0.0;
+        for (size_t t = 0; t + 2 < result.indices.size(); t += 3) {
+            const float* a = &result.vertices[result.indices[t] * SOFTWARE_MESH_STRIDE];
+            const float* b = &result.vertices[result.indices[t + 1] * SOFTWARE_MESH_STRIDE];
+            const float* c = &result.vertices[result.indices[t + 2] * SOFTWARE_MESH_STRIDE];
+            double cross = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+            ok = ok && cross > 0.0 && result.indices[t] < vertexCount && result.indices[t + 2] < vertexCount;
+            area += cross * 0.5;
+        }
+        return ok && maxX == 1.0f && maxY == 1.0f && std::fabs(area - 1.0) < 1e-4;
+    });
+
+    tests.AddTest("MeshDecimator", "UV seams are never crossed", [makeGrid]() {
+        SoftwareMesh grid = makeGrid(40, 17);
+        SoftwareMesh result = Decimate(grid, 150);
+        bool ok = result.indices.size() / 3 <= 150;
+
+        // No triangle may mix the two charts, and the seam column keeps both copies
+        size_t seamLeft = 0, seamRight = 0;
+        for (size_t t = 0; t + 2 < result.indices.size(); t += 3) {
+            float u0 = result.vertices[result.indices[t] * SOFTWARE_MESH_STRIDE + 6];
+            float u1 = result.vertices[result.indices[t + 1] * SOFTWARE_MESH_STRIDE + 6];
+            float u2 = result.vertices[result.indices[t + 2] * SOFTWARE_MESH_STRIDE + 6];
+            ok = ok && std::fabs(u0 - u1) < 5.0f && std::fabs(u1 - u2) < 5.0f;
+        }
+        for (size_t v = 0; v < result.vertices.size(); v += SOFTWARE_MESH_STRIDE) {
+            if (std::fabs(result.vertices[v] - 17.0f / 40.0f) < 1e-6f) {
+                (result.vertices[v + 6] > 5.0f ? seamRight : seamLeft)++;
+            }
+        }
+        return ok && seamLeft >= 2 && seamLeft == seamRight;
+    });
+
+    tests.AddTest("MeshDecimator", "Closed mesh stays manifold through a one-pass preset chain", []() {
+        // UV sphere with a longitude seam (duplicate column computed from phi = 2 pi, a few
+        // ulps off the first) and welded poles
+        const uint32_t rings = 48, segments = 96;
+        SoftwareMesh sphere;
+        for (uint32_t r = 0; r <= rings; ++r) {
+            for (uint32_t s = 0; s <= segments; ++s) {
+                float theta = 3.14159265f * r / rings;
+                float phi = 6.2831853f * s / segments;
+                float n[3] = { std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+                if (r == 0 || r == rings) {
+                    n[0] = n[2] = 0.0f;
+                }
+                float vertex[SOFTWARE_MESH_STRIDE] = { n[0], n[1], n[2], n[0], n[1], n[2],
+                                                       float(s) / segments, float(r) / rings };
+                sphere.vertices.insert(sphere.vertices.end(), vertex, vertex + SOFTWARE_MESH_STRIDE);
+            }
+        }
+        for (uint32_t r = 0; r < rings; ++r) {
+            for (uint32_t s = 0; s < segments; ++s) {
+                uint32_t i = r * (segments + 1) + s;
+                uint32_t j = i + segments + 1;
+                if (r != 0) {
+                    sphere.indices.insert(sphere.indices.end(), { i, i + 1, j });
+                }
+                if (r + 1 != rings) {
+                    sphere.indices.insert(sphere.indices.end(), { i + 1, j + 1, j });
+                }
+            }
+        }
+
+        std::vector<uint32_t> targets = { 500, 4000, 1500 };
+        std::vector<MeshDecimateLevel> chain = DecimateChain(sphere, targets);
+        bool ok = chain.size() == 3 && chain[0].error >= chain[2].error && chain[2].error >= chain[1].error;
+        for (size_t i = 0; ok && i < chain.size(); ++i) {
+            const SoftwareMesh& mesh = chain[i].mesh;
+            ok = mesh.indices.size() / 3 <= targets[i] && mesh.indices.size() / 3 + 8 > targets[i] &&
+                 Decimate(sphere, targets[i]).indices == mesh.indices;
+
+            // Every edge, welded within 1e-5, is shared by exactly two triangles
+            size_t vertexCount = mesh.vertices.size() / SOFTWARE_MESH_STRIDE;
+            std::vector<uint32_t> ids(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v) {
+                const float* p = &mesh.vertices[v * SOFTWARE_MESH_STRIDE];
+                ids[v] = static_cast<uint32_t>(v);
+                for (size_t u = 0; u < v; ++u) {
+                    const float* q = &mesh.vertices[u * SOFTWARE_MESH_STRIDE];
+                    if (std::fabs(p[0] - q[0]) <= 1e-5f && std::fabs(p[1] - q[1]) <= 1e-5f &&
+                        std::fabs(p[2] - q[2]) <= 1e-5f) {
+                        ids[v] = ids[u];
+                        break;
+                    }
+                }
+            }
+            std::unordered_map<uint64_t, uint32_t> edges;
+            for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+                uint32_t c[3];
+                for (int k = 0; k < 3; ++k) {
+                    c[k] = ids[mesh.indices[t + k]];
+                }
+                for (int k = 0; k < 3; ++k) {
+                    uint64_t a = std::min(c[k], c[(k + 1) % 3]), b = std::max(c[k], c[(k + 1) % 3]);
+                    edges[(a << 32) | b]++;
+                }
+            }
+            for (const auto& edge : edges) {
+                ok = ok && edge.second == 2;
+            }
+        }
+        return ok;
+    });
+}
+
+// Note on usage:
+// src/tools/bf-decimate.cpp runs DecimateChain over every primitive of a GLB and writes
+// one GLB per target; the forge3d optimize-mesh stage calls it instead of the Python
+// bridge when the binary is available.
@@ -0,0 +1,179 @@
+/** MeshLod - Coarse level-of-detail generation for SoftwareMesh
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "SoftwareMesh.h"
+#include "../core/TestManagerNew.h"
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Default grid for residency proxies: 16 cells on the longest axis keeps silhouettes
+// readable at distance while typically cutting dense meshes by well over 90%
+constexpr uint32_t MESH_LOD_PROXY_CELLS = 16;
+
+// MeshLod builds cheap stand-ins for meshes:
+// - Cluster(): vertex clustering on a uniform grid over the mesh bounds. Every vertex
+//   in a cell collapses to the cell's averaged position/normal (first UV), and
+//   triangles whose corners share a cell are dropped
+// - O(vertices + indices), no adjacency, so it can run on eviction without a stall
+// Topology is not preserved; use it for distant or placeholder detail, not editing.
+class MeshLod {
+public:
+    // Clustered copy of `mesh` with at most `cellsPerAxis` cells on its longest axis.
+    // Meshes that would not shrink (or have no triangles) are returned unchanged.
+    static SoftwareMesh Cluster(const SoftwareMesh& mesh, uint32_t cellsPerAxis = MESH_LOD_PROXY_CELLS) {
+        const uint32_t stride = mesh.vertexStride;
+        const size_t vertexCount = stride > 0 ? mesh.vertices.size() / stride : 0;
+
+        // Guard: nothing to cluster
+        if (vertexCount == 0 || mesh.indices.size() < 3 || stride < 3 || cellsPerAxis == 0) {
+            return mesh;
+        }
+
+        float boundsMin[3] = { mesh.vertices[0], mesh.vertices[1], mesh.vertices[2] };
+        float boundsMax[3] = { boundsMin[0], boundsMin[1], boundsMin[2] };
+        for (size_t v = 0; v < vertexCount; ++v) {
+            const float* p = &mesh.vertices[v * stride];
+            for (int axis = 0; axis < 3; ++axis) {
+                boundsMin[axis] = std::min(boundsMin[axis], p[axis]);
+                boundsMax[axis] = std::max(boundsMax[axis], p[axis]);
+            }
+        }
+
+        float extent = std::max({ boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1],
+                                  boundsMax[2] - boundsMin[2] });
+        float cellSize = extent > 0.0f ? extent / static_cast<float>(cellsPerAxis) : 1.0f;
+
+        // Vertex -> cluster, cluster -> accumulated vertex
+        std::unordered_map<uint64_t, uint32_t> cellToCluster;
+        cellToCluster.reserve(vertexCount / 4 + 1);
+        std::vector<uint32_t> remap(vertexCount);
+        std::vector<float> sums;
+        std::vector<uint32_t> counts;
+        for (size_t v = 0; v < vertexCount; ++v) {
+            const float* p = &mesh.vertices[v * stride];
+            uint64_t key = 0;
+            for (int axis = 0; axis < 3; ++axis) {
+                uint64_t cell = static_cast<uint64_t>(std::floor((p[axis] - boundsMin[axis]) / cellSize));
+                key = (key << 21) | std::min<uint64_t>(cell, (1u << 21) - 1);
+            }
+
+            auto inserted = cellToCluster.emplace(key, static_cast<uint32_t>(counts.size()));
+            uint32_t cluster = inserted.first->second;
+            if (inserted.second) {
+                sums.insert(sums.end(), p, p + stride); // UVs and extras keep the first vertex's
+                counts.push_back(1);
+            } else {
+                float* sum = &sums[static_cast<size_t>(cluster) * stride];
+                for (uint32_t c = 0; c < std::min<uint32_t>(stride, 6); ++c) {
+                    sum[c] += p[c];
+                }
+                counts[cluster]++;
+            }
+            remap[v] = cluster;
+        }
+
+        SoftwareMesh result;
+        result.vertexStride = stride;
+        for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+            uint32_t a = mesh.indices[t];
+            uint32_t b = mesh.indices[t + 1];
+            uint32_t c = mesh.indices[t + 2];
+            if (a >= vertexCount || b >= vertexCount || c >= vertexCount) {
+                continue;
+            }
+            a = remap[a];
+            b = remap[b];
+            c = remap[c];
+            if (a == b || b == c || a == c) {
+                continue;
+            }
+            result.indices.push_back(a);
+            result.indices.push_back(b);
+            result.indices.push_back(c);
+        }
+
+        // Guard: clustering removed nothing worth the swap
+        if (result.indices.size() >= mesh.indices.size() && counts.size() >= vertexCount) {
+            return mesh;
+        }
+
+        // Average positions; renormalize summed normals when the layout carries them
+        for (size_t cluster = 0; cluster < counts.size(); ++cluster) {
+            float* vertex = &sums[cluster * stride];
+            float inverse = 1.0f / static_cast<float>(counts[cluster]);
+            vertex[0] *= inverse;
+            vertex[1] *= inverse;
+            vertex[2] *= inverse;
+            if (stride >= 6) {
+                float length = std::sqrt(vertex[3] * vertex[3] + vertex[4] * vertex[4] + vertex[5] * vertex[5]);
+                if (length > 0.0f) {
+                    vertex[3] /= length;
+                    vertex[4] /= length;
+                    vertex[5] /= length;
+                }
+            }
+        }
+        result.vertices = std::move(sums);
+        result.vertices.shrink_to_fit();
+        result.indices.shrink_to_fit();
+        return result;
+    }
+
+    // Resident bytes of a mesh's buffers
+    static size_t MemoryBytes(const SoftwareMesh& mesh) {
+        return mesh.vertices.capacity() * sizeof(float) + mesh.indices.capacity() * sizeof(uint32_t);
+    }
+
+    // Clustering reduction and bounds
+    static void RegisterTests() {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        tests.RegisterSuite("MeshLod");
+
+        tests.AddTest("MeshLod", "Clustering shrinks a dense grid within its bounds", []() {
+            // 64x64 quad grid on the unit square
+            const uint32_t n = 64;
+            SoftwareMesh grid;
+            for (uint32_t y = 0; y <= n; ++y) {
+                for (uint32_t x = 0; x <= n; ++x) {
+                    float vertex[SOFTWARE_MESH_STRIDE] = { x / float(n), y / float(n), 0.0f, 0.0f, 0.0f, 1.0f,
+                                                           x / float(n), y / float(n) };
+                    grid.vertices.insert(grid.vertices.end(), vertex, vertex + SOFTWARE_MESH_STRIDE);
+                }
+            }
+            for (uint32_t y = 0; y < n; ++y) {
+                for (uint32_t x = 0; x < n; ++x) {
+                    uint32_t i = y * (n + 1) + x;
+                    uint32_t quad[6] = { i, i + 1, i + n + 1, i + 1, i + n + 2, i + n + 1 };
+                    grid.indices.insert(grid.indices.end(), quad, quad + 6);
+                }
+            }
+
+            SoftwareMesh proxy = Cluster(grid, 8);
+            size_t proxyVertices = proxy.vertices.size() / proxy.vertexStride;
+            bool inBounds = true;
+            for (size_t v = 0; v < proxyVertices; ++v) {
+                const float* p = &proxy.vertices[v * proxy.vertexStride];
+                inBounds = inBounds && p[0] >= 0.0f && p[0] <= 1.0f && p[1] >= 0.0f && p[1] <= 1.0f &&
+                           std::fabs(p[5] - 1.0f) < 1e-5f;
+            }
+            for (uint32_t index : proxy.indices) {
+                inBounds = inBounds && index < proxyVertices;
+            }
+            return inBounds && proxyVertices <= 9 * 9 && !proxy.indices.empty() &&
+                   proxy.indices.size() * 20 < grid.indices.size() &&
+                   MemoryBytes(proxy) * 20 < MemoryBytes(grid);
+        });
+    }
+};
+
+// Note on usage:
+// SoftwareRenderService demotes least-recently-used meshes to Cluster() proxies under
+// residency pressure (ResidencyManager.h) and refines them back from the source file
+// when they are drawn again.
@@ -0,0 +1,945 @@
+/** MeshValidator - Topology, attribute and UV checks on glTF meshes, read in place
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "GltfLoader.h"
+#include "../core/Parallel.h"
+#include "../core/TestManagerNew.h"
+#include <string>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+
+struct MeshValidationOptions {
+    uint32_t textureSize;       // Texture edge length that texel density is quoted for
+    uint32_t uvGridSize;        // Resolution of the UV overlap raster over [0, 1]^2
+    float maxOverlapRatio;      // Overlapping share of covered UV space before it is reported
+    uint64_t minFileBytes;      // Smaller files are rejected (python validation.min_mesh_file_size_bytes)
+    uint32_t workerCount;       // 0 = hardware concurrency
+
+    MeshValidationOptions()
+        : textureSize(1024), uvGridSize(256), maxOverlapRatio(0.01f), minFileBytes(100), workerCount(0) {}
+};
+
+struct MeshUvReport {
+    bool hasUvs = false;
+    size_t uvCount = 0;
+    std::array<float, 2> min = { 0.0f, 0.0f };
+    std::array<float, 2> max = { 0.0f, 0.0f };
+    size_t outOfRange = 0;          // Finite coordinates outside [0, 1]
+    size_t nonFinite = 0;
+    double overlapRatio = 0.0;      // Covered raster cells that more than one triangle lands on
+    double texelDensityMean = 0.0;  // Texels per world unit at textureSize, weighted by surface area
+    double texelDensityMin = 0.0;
+    double texelDensityMax = 0.0;
+};
+
+// Counts and bounds cover every placed instance, as the trimesh scene dump did; defect
+// counts cover each distinct primitive once, however often the scene places it.
+struct MeshValidationReport {
+    std::string filePath;
+    bool valid = false;
+    uint64_t fileSizeBytes = 0;
+    size_t primitiveCount = 0;
+    size_t vertexCount = 0;
+    size_t faceCount = 0;
+    bool hasBounds = false;
+    std::array<float, 3> boundsMin = { 0.0f, 0.0f, 0.0f };     // World space, non-finite positions ignored
+    std::array<float, 3> boundsMax = { 0.0f, 0.0f, 0.0f };
+    size_t degenerateTriangles = 0; // Repeated corners or (near) zero area
+    size_t nonFinitePositions = 0;
+    size_t invalidIndices = 0;      // Triangles that reference a vertex past the accessor
+    size_t boundaryEdges = 0;       // Welded edges with one triangle
+    size_t nonManifoldEdges = 0;    // Welded edges with three or more
+    size_t inconsistentEdges = 0;   // Two-triangle edges whose triangles disagree on winding
+    bool watertight = false;
+    MeshUvReport uv;
+    std::vector<std::string> errors;
+    std::vector<std::string> warnings;
+    double seconds = 0.0;
+};
+
+// MeshValidator - stateless entry points
+// Positions, UVs and indices are read straight from the mapped accessors through
+// GltfDocument::GetView (quantized or sparse accessors are decoded first). Per primitive:
+// - A vertex pass over parallel chunks gathers bounds, NaNs and the UV range
+// - Vertices are welded by (snapped) position so seams do not read as open borders
+// - A triangle pass over parallel chunks flags degenerate triangles, accumulates texel
+//   density, rasterizes UVs into a shared atomic grid and emits welded edges
+// - Welds and edges are grouped with a bucketed sort (scatter by hash per chunk, then
+//   every bucket sorts on its own), so no pass is serial in the triangle count
+class MeshValidator {
+public:
+    // Validate a .glb/.gltf on disk. Never throws; problems land in report.errors.
+    static MeshValidationReport ValidateFile(const std::string& path,
+                                             const MeshValidationOptions& options = MeshValidationOptions()) {
+        auto start = std::chrono::steady_clock::now();
+        MeshValidationReport report;
+        report.filePath = path;
+
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(path, ec)) {
+            report.errors.push_back("File not found: " + path);
+            return report;
+        }
+        report.fileSizeBytes = std::filesystem::file_size(path, ec);
+        if (report.fileSizeBytes < options.minFileBytes) {
+            report.errors.push_back("File too small (" + std::to_string(report.fileSizeBytes) + " bytes)");
+            return report;
+        }
+
+        GltfDocument doc;
+        std::string error;
+        if (!GltfLoader::Parse(path, doc, &error)) {
+            report.errors.push_back("Load error: " + error);
+            return report;
+        }
+
+        Validate(doc, options, report);
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
+
+    // Validate an already parsed document; fills everything but the file fields
+    static void Validate(const GltfDocument& doc, const MeshValidationOptions& options, MeshValidationReport& report) {
+        std::vector<GltfPrimitiveInstance> instances = GltfLoader::Instances(doc);
+
+        // Every distinct primitive the scene places is analyzed once
+        std::vector<size_t> firstPrimitive(doc.meshes.size() + 1, 0);
+        for (size_t m = 0; m < doc.meshes.size(); ++m) {
+            firstPrimitive[m + 1] = firstPrimitive[m] + doc.meshes[m].primitives.size();
+        }
+        std::vector<uint8_t> placed(firstPrimitive.back(), 0);
+        std::vector<GltfPrimitiveRef> unique;
+        for (const GltfPrimitiveInstance& instance : instances) {
+            uint8_t& seen = placed[firstPrimitive[instance.mesh] + instance.primitive];
+            if (!seen) {
+                seen = 1;
+                unique.push_back({ instance.mesh, instance.primitive });
+            }
+        }
+
+        std::vector<PrimitiveStats> stats(unique.size());
+        Parallel::For(unique.size(), [&](size_t i) {
+            Analyze(doc, doc.meshes[unique[i].mesh].primitives[unique[i].primitive], options, stats[i]);
+        }, options.workerCount);
+
+        std::vector<const PrimitiveStats*> byPrimitive(firstPrimitive.back(), nullptr);
+        size_t coveredCells = 0;
+        size_t overlapCells = 0;
+        double densitySum = 0.0;
+        double densityArea = 0.0;
+        MeshUvReport& uv = report.uv;
+        uv.texelDensityMin = std::numeric_limits<double>::infinity();
+        uv.texelDensityMax = 0.0;
+        for (size_t i = 0; i < unique.size(); ++i) {
+            const PrimitiveStats& s = stats[i];
+            byPrimitive[firstPrimitive[unique[i].mesh] + unique[i].primitive] = &s;
+            if (!s.supported) {
+                report.warnings.push_back("mesh " + std::to_string(unique[i].mesh) + " primitive " +
+                                          std::to_string(unique[i].primitive) + " is not a triangle list; skipped");
+                continue;
+            }
+            report.degenerateTriangles += s.degenerate;
+            report.nonFinitePositions += s.nonFinitePositions;
+            report.invalidIndices += s.invalidIndices;
+            report.boundaryEdges += s.boundary;
+            report.nonManifoldEdges += s.nonManifold;
+            report.inconsistentEdges += s.inconsistent;
+
+            if (s.uv.hasUvs) {
+                uv.min = uv.hasUvs ? std::array<float, 2>{ std::min(uv.min[0], s.uv.min[0]), std::min(uv.min[1], s.uv.min[1]) }
+                                   : s.uv.min;
+                uv.max = uv.hasUvs ? std::array<float, 2>{ std::max(uv.max[0], s.uv.max[0]), std::max(uv.max[1], s.uv.max[1]) }
+                                   : s.uv.max;
+                uv.hasUvs = true;
+                uv.uvCount += s.uv.uvCount;
+                uv.outOfRange += s.uv.outOfRange;
+                uv.nonFinite += s.uv.nonFinite;
+                coveredCells += s.coveredCells;
+                overlapCells += s.overlapCells;
+                densitySum += s.densitySum;
+                densityArea += s.densityArea;
+                uv.texelDensityMin = std::min(uv.texelDensityMin, s.densityMin);
+                uv.texelDensityMax = std::max(uv.texelDensityMax, s.densityMax);
+            }
+        }
+        uv.overlapRatio = coveredCells > 0 ? static_cast<double>(overlapCells) / static_cast<double>(coveredCells) : 0.0;
+        uv.texelDensityMean = densityArea > 0.0 ? densitySum / densityArea : 0.0;
+        if (densityArea <= 0.0) {
+            uv.texelDensityMin = 0.0;
+        }
+
+        // Totals and world bounds per placed instance
+        for (const GltfPrimitiveInstance& instance : instances) {
+            const PrimitiveStats* s = byPrimitive[firstPrimitive[instance.mesh] + instance.primitive];
+            if (!s->supported) {
+                continue;
+            }
+            ++report.primitiveCount;
+            report.vertexCount += s->vertices;
+            report.faceCount += s->triangles;
+            if (s->hasBounds) {
+                AddWorldBounds(*s, instance, report);
+            }
+        }
+
+        report.watertight = report.faceCount > 0 && report.boundaryEdges == 0 && report.nonManifoldEdges == 0;
+        if (report.vertexCount == 0) {
+            report.errors.push_back("Mesh has no vertices");
+        }
+        if (report.faceCount == 0) {
+            report.errors.push_back("Mesh has no faces");
+        }
+        if (report.nonFinitePositions > 0) {
+            report.errors.push_back(std::to_string(report.nonFinitePositions) + " vertex positions are NaN or infinite");
+        }
+        if (report.invalidIndices > 0) {
+            report.errors.push_back(std::to_string(report.invalidIndices) + " triangles reference missing vertices");
+        }
+
+        // Common in generated meshes and fixable downstream, so reported but not fatal
+        if (report.degenerateTriangles > 0) {
+            report.warnings.push_back(std::to_string(report.degenerateTriangles) + " degenerate triangles");
+        }
+        if (report.nonManifoldEdges > 0) {
+            report.warnings.push_back(std::to_string(report.nonManifoldEdges) + " non-manifold edges");
+        }
+        if (report.faceCount > 0 && !report.watertight) {
+            report.warnings.push_back("Mesh is not watertight (" + std::to_string(report.boundaryEdges) + " boundary edges)");
+        }
+        if (report.inconsistentEdges > 0) {
+            report.warnings.push_back(std::to_string(report.inconsistentEdges) + " edges with inconsistent winding");
+        }
+        if (!uv.hasUvs) {
+            report.warnings.push_back("Mesh has no UV coordinates");
+        } else {
+            if (uv.nonFinite > 0) {
+                report.warnings.push_back(std::to_string(uv.nonFinite) + " UV coordinates are NaN or infinite");
+            }
+            if (uv.outOfRange > 0) {
+                report.warnings.push_back(std::to_string(uv.outOfRange) + " UV coordinates outside [0, 1]");
+            }
+            if (uv.overlapRatio > options.maxOverlapRatio) {
+                report.warnings.push_back("UVs overlap on " + FormatNumber(uv.overlapRatio * 100.0) +
+                                          "% of the covered texture space");
+            }
+        }
+        report.valid = report.errors.empty();
+    }
+
+    // One JSON object, keys matching the dict python/mesh_utils.py validate_mesh() returns
+    static std::string ToJson(const MeshValidationReport& report) {
+        const MeshUvReport& uv = report.uv;
+        auto vec = [](const float* v, size_t n) {
+            std::string out = "[";
+            for (size_t i = 0; i < n; ++i) {
+                out += (i == 0 ? "" : ",") + FormatNumber(v[i]);
+            }
+            return out + "]";
+        };
+        auto list = [](const std::vector<std::string>& items) {
+            std::string out = "[";
+            for (size_t i = 0; i < items.size(); ++i) {
+                out += (i == 0 ? "" : ",") + JsonBinding::StringLiteral(items[i]);
+            }
+            return out + "]";
+        };
+        auto flag = [](bool value) { return std::string(value ? "true" : "false"); };
+
+        std::string json = "{\"file_path\":" + JsonBinding::StringLiteral(report.filePath) +
+            ",\"valid\":" + flag(report.valid) +
+            ",\"file_size_bytes\":" + std::to_string(report.fileSizeBytes) +
+            ",\"primitive_count\":" + std::to_string(report.primitiveCount) +
+            ",\"vertex_count\":" + std::to_string(report.vertexCount) +
+            ",\"face_count\":" + std::to_string(report.faceCount) +
+            ",\"bounds\":" + (report.hasBounds ? "{\"min\":" + vec(report.boundsMin.data(), 3) +
+                                                 ",\"max\":" + vec(report.boundsMax.data(), 3) + "}" : "null") +
+            ",\"degenerate_triangles\":" + std::to_string(report.degenerateTriangles) +
+            ",\"non_finite_positions\":" + std::to_string(report.nonFinitePositions) +
+            ",\"invalid_indices\":" + std::to_string(report.invalidIndices) +
+            ",\"boundary_edges\":" + std::to_string(report.boundaryEdges) +
+            ",\"non_manifold_edges\":" + std::to_string(report.nonManifoldEdges) +
+            ",\"inconsistent_winding_edges\":" + std::to_string(report.inconsistentEdges) +
+            ",\"watertight\":" + flag(report.watertight) +
+            ",\"uv\":{\"has_uvs\":" + flag(uv.hasUvs) +
+            ",\"uv_count\":" + std::to_string(uv.uvCount) +
+            ",\"min\":" + vec(uv.min.data(), 2) + ",\"max\":" + vec(uv.max.data(), 2) +
+            ",\"out_of_range\":" + std::to_string(uv.outOfRange) +
+            ",\"non_finite\":" + std::to_string(uv.nonFinite) +
+            ",\"overlap_ratio\":" + FormatNumber(uv.overlapRatio) +
+            ",\"texel_density\":{\"mean\":" + FormatNumber(uv.texelDensityMean) +
+            ",\"min\":" + FormatNumber(uv.texelDensityMin) + ",\"max\":" + FormatNumber(uv.texelDensityMax) + "}}" +
+            ",\"errors\":" + list(report.errors) +
+            ",\"warnings\":" + list(report.warnings) +
+            ",\"seconds\":" + FormatNumber(report.seconds) + "}";
+        return json;
+    }
+
+    // Defect detection on hand-built meshes and the JSON shape
+    static void RegisterTests();
+
+    // Prevent instantiation (static API)
+    MeshValidator() = delete;
+
+private:
+    static constexpr size_t VERTEX_GRAIN = 1 << 16;
+    static constexpr size_t TRIANGLE_GRAIN = 1 << 14;
+    static constexpr size_t SORT_GRAIN = 1 << 16;
+    static constexpr size_t SORT_BUCKETS = 256;
+    // Triangles below this area (relative to the squared longest bounds axis) count as degenerate
+    static constexpr double DEGENERATE_AREA = 1e-12;
+    // Weld grid spacing relative to the longest bounds axis (~8 float ulps at the far corner)
+    static constexpr double WELD_TOLERANCE = 1e-6;
+    static constexpr uint64_t NO_EDGE = ~0ull;
+
+    using Float3 = std::array<float, 3>;
+    using Float2 = std::array<float, 2>;
+
+    struct PrimitiveStats {
+        bool supported = false;
+        size_t vertices = 0;
+        size_t triangles = 0;
+        bool hasBounds = false;
+        Float3 min = { 0.0f, 0.0f, 0.0f };     // Local space
+        Float3 max = { 0.0f, 0.0f, 0.0f };
+        size_t nonFinitePositions = 0;
+        size_t invalidIndices = 0;
+        size_t degenerate = 0;
+        size_t boundary = 0;
+        size_t nonManifold = 0;
+        size_t inconsistent = 0;
+        MeshUvReport uv;
+        size_t coveredCells = 0;
+        size_t overlapCells = 0;
+        double densitySum = 0.0;                // Sum of density * world area
+        double densityArea = 0.0;
+        double densityMin = std::numeric_limits<double>::infinity();
+        double densityMax = 0.0;
+    };
+
+    struct VertexChunk {
+        bool hasBounds = false;
+        Float3 min = { 0.0f, 0.0f, 0.0f };
+        Float3 max = { 0.0f, 0.0f, 0.0f };
+        size_t nonFinite = 0;
+        bool hasUv = false;
+        Float2 uvMin = { 0.0f, 0.0f };
+        Float2 uvMax = { 0.0f, 0.0f };
+        size_t uvNonFinite = 0;
+        size_t uvOutOfRange = 0;
+    };
+
+    struct TriangleChunk {
+        size_t invalid = 0;
+        size_t degenerate = 0;
+        double densitySum = 0.0;
+        double densityArea = 0.0;
+        double densityMin = std::numeric_limits<double>::infinity();
+        double densityMax = 0.0;
+    };
+
+    struct EdgeChunk {
+        size_t boundary = 0;
+        size_t nonManifold = 0;
+        size_t inconsistent = 0;
+    };
+
+    // Snapped position plus the vertex it came from
+    struct WeldKey {
+        uint32_t x, y, z;
+        uint32_t vertex;
+    };
+
+    // Index accessor read in place (8/16/32-bit), or the implicit 0..n-1 of a non-indexed primitive
+    struct IndexStream {
+        const uint8_t* data = nullptr;
+        size_t stride = 0;
+        size_t width = 4;                   // Bytes per index
+        size_t size = 0;
+        std::vector<uint32_t> resolved;     // Only for sparse or view-less index accessors
+
+        uint32_t operator[](size_t i) const {
+            if (data == nullptr) {
+                return static_cast<uint32_t>(i);
+            }
+            const uint8_t* p = data + i * stride;
+            switch (width) {
+                case 1:
+                    return *p;
+                case 2: {
+                    uint16_t v;
+                    std::memcpy(&v, p, 2);
+                    return v;
+                }
+                default: {
+                    uint32_t v;
+                    std::memcpy(&v, p, 4);
+                    return v;
+                }
+            }
+        }
+    };
+
+    static void Analyze(const GltfDocument& doc, const GltfPrimitive& primitive, const MeshValidationOptions& options,
+                        PrimitiveStats& stats) {
+        if (primitive.position < 0 || primitive.mode != static_cast<uint32_t>(GltfPrimitiveMode::TRIANGLES)) {
+            return;
+        }
+        stats.supported = true;
+
+        std::vector<float> positionScratch;
+        std::vector<float> uvScratch;
+        GltfAccessorView<Float3> positions = FloatView<3>(doc, primitive.position, positionScratch);
+        GltfAccessorView<Float2> uvs;
+        if (primitive.texcoord0 >= 0) {
+            uvs = FloatView<2>(doc, primitive.texcoord0, uvScratch);
+        }
+        IndexStream indices = Indices(doc, primitive, positions.size());
+
+        const size_t vertexCount = positions.size();
+        const size_t triangleCount = indices.size / 3;
+        const uint32_t workers = options.workerCount;
+        stats.vertices = vertexCount;
+        stats.triangles = triangleCount;
+        // Welded ids share a 64-bit edge key with a winding bit
+        if (vertexCount >= (1ull << 31)) {
+            stats.invalidIndices = triangleCount;
+            return;
+        }
+
+        // ---- Vertex pass: bounds, NaNs, UV range --------------------------------
+        std::vector<VertexChunk> vertexChunks((vertexCount + VERTEX_GRAIN - 1) / VERTEX_GRAIN);
+        Parallel::ForRange(vertexCount, VERTEX_GRAIN, [&](size_t begin, size_t end) {
+            VertexChunk& chunk = vertexChunks[begin / VERTEX_GRAIN];
+            for (size_t v = begin; v < end; ++v) {
+                Float3 p = positions[v];
+                if (!std::isfinite(p[0]) || !std::isfinite(p[1]) || !std::isfinite(p[2])) {
+                    ++chunk.nonFinite;
+                    continue;
+                }
+                Grow(chunk.hasBounds, chunk.min, chunk.max, p);
+            }
+            for (size_t v = begin; v < std::min(end, uvs.size()); ++v) {
+                Float2 t = uvs[v];
+                if (!std::isfinite(t[0]) || !std::isfinite(t[1])) {
+                    ++chunk.uvNonFinite;
+                    continue;
+                }
+                if (t[0] < 0.0f || t[0] > 1.0f || t[1] < 0.0f || t[1] > 1.0f) {
+                    ++chunk.uvOutOfRange;
+                }
+                Grow(chunk.hasUv, chunk.uvMin, chunk.uvMax, t);
+            }
+        }, workers);
+
+        bool hasUvRange = false;
+        for (const VertexChunk& chunk : vertexChunks) {
+            stats.nonFinitePositions += chunk.nonFinite;
+            stats.uv.nonFinite += chunk.uvNonFinite;
+            stats.uv.outOfRange += chunk.uvOutOfRange;
+            if (chunk.hasBounds) {
+                Grow(stats.hasBounds, stats.min, stats.max, chunk.min);
+                Grow(stats.hasBounds, stats.min, stats.max, chunk.max);
+            }
+            if (chunk.hasUv) {
+                Grow(hasUvRange, stats.uv.min, stats.uv.max, chunk.uvMin);
+                Grow(hasUvRange, stats.uv.min, stats.uv.max, chunk.uvMax);
+            }
+        }
+        stats.uv.hasUvs = !uvs.empty();
+        stats.uv.uvCount = uvs.size();
+
+        // ---- Weld by position ---------------------------------------------------
+        // Positions snap to a grid of WELD_TOLERANCE x the longest axis, so seams whose two
+        // sides were computed separately (sin(2 pi) != 0) still close
+        float extent = stats.hasBounds ? std::max({ stats.max[0] - stats.min[0], stats.max[1] - stats.min[1],
+                                                    stats.max[2] - stats.min[2] }) : 0.0f;
+        const double quantum = extent * WELD_TOLERANCE;
+        std::vector<WeldKey> keys(vertexCount);
+        Parallel::ForRange(vertexCount, VERTEX_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) {
+                Float3 p = positions[v];
+                WeldKey& key = keys[v];
+                key.vertex = static_cast<uint32_t>(v);
+                if (!std::isfinite(p[0]) || !std::isfinite(p[1]) || !std::isfinite(p[2])) {
+                    // Never welded: a NaN corner must not stitch unrelated triangles together
+                    key.x = key.y = UINT32_MAX;
+                    key.z = key.vertex;
+                } else if (quantum > 0.0) {
+                    key.x = static_cast<uint32_t>(std::llround((p[0] - stats.min[0]) / quantum));
+                    key.y = static_cast<uint32_t>(std::llround((p[1] - stats.min[1]) / quantum));
+                    key.z = static_cast<uint32_t>(std::llround((p[2] - stats.min[2]) / quantum));
+                } else {
+                    key.x = key.y = key.z = 0;
+                }
+            }
+        }, workers);
+
+        std::vector<uint32_t> welded(vertexCount);
+        std::vector<size_t> weldBuckets = BucketSort(keys,
+            [](const WeldKey& k) { return Mix((static_cast<uint64_t>(k.x) << 32 | k.y) ^ Mix(k.z)); },
+            [](const WeldKey& a, const WeldKey& b) {
+                return std::tie(a.x, a.y, a.z, a.vertex) < std::tie(b.x, b.y, b.z, b.vertex);
+            }, workers);
+        Parallel::ForRange(SORT_BUCKETS, 1, [&](size_t begin, size_t end) {
+            for (size_t i = weldBuckets[begin]; i < weldBuckets[end]; ++i) {
+                const WeldKey& key = keys[i];
+                bool same = i > weldBuckets[begin] && keys[i - 1].x == key.x && keys[i - 1].y == key.y &&
+                            keys[i - 1].z == key.z;
+                // Runs are sorted by vertex, so the first (lowest) vertex names the weld
+                welded[key.vertex] = same ? welded[keys[i - 1].vertex] : key.vertex;
+            }
+        }, workers);
+        std::vector<WeldKey>().swap(keys);
+
+        // ---- Triangle pass: degeneracy, density, UV raster, edges ---------------
+        const double minArea = DEGENERATE_AREA * static_cast<double>(extent) * static_cast<double>(extent);
+        const uint32_t grid = std::max<uint32_t>(1, options.uvGridSize);
+        std::vector<std::atomic<uint32_t>> raster(uvs.empty() ? 0 : static_cast<size_t>(grid) * grid);
+        std::vector<uint64_t> edges(triangleCount * 3);
+        std::vector<TriangleChunk> triangleChunks((triangleCount + TRIANGLE_GRAIN - 1) / TRIANGLE_GRAIN);
+
+        Parallel::ForRange(triangleCount, TRIANGLE_GRAIN, [&](size_t begin, size_t end) {
+            TriangleChunk& chunk = triangleChunks[begin / TRIANGLE_GRAIN];
+            for (size_t t = begin; t < end; ++t) {
+                uint64_t* edge = &edges[t * 3];
+                uint32_t corner[3] = { indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2] };
+                if (corner[0] >= vertexCount || corner[1] >= vertexCount || corner[2] >= vertexCount) {
+                    ++chunk.invalid;
+                    edge[0] = edge[1] = edge[2] = NO_EDGE;
+                    continue;
+                }
+
+                uint32_t id[3] = { welded[corner[0]], welded[corner[1]], welded[corner[2]] };
+                bool distinct = id[0] != id[1] && id[1] != id[2] && id[0] != id[2];
+                for (int k = 0; k < 3; ++k) {
+                    uint64_t a = id[k];
+                    uint64_t b = id[(k + 1) % 3];
+                    edge[k] = distinct ? (std::min(a, b) << 33) | (std::max(a, b) << 1) | (a > b ? 1 : 0) : NO_EDGE;
+                }
+
+                Float3 p0 = positions[corner[0]];
+                Float3 p1 = positions[corner[1]];
+                Float3 p2 = positions[corner[2]];
+                double e1[3] = { double(p1[0]) - p0[0], double(p1[1]) - p0[1], double(p1[2]) - p0[2] };
+                double e2[3] = { double(p2[0]) - p0[0], double(p2[1]) - p0[1], double(p2[2]) - p0[2] };
+                double cx = e1[1] * e2[2] - e1[2] * e2[1];
+                double cy = e1[2] * e2[0] - e1[0] * e2[2];
+                double cz = e1[0] * e2[1] - e1[1] * e2[0];
+                double area = 0.5 * std::sqrt(cx * cx + cy * cy + cz * cz);
+                // NaN area lands here too
+                bool degenerate = !distinct || !(area > minArea) || !std::isfinite(area);
+                chunk.degenerate += degenerate ? 1 : 0;
+                if (uvs.empty() || std::max({ corner[0], corner[1], corner[2] }) >= uvs.size()) {
+                    continue;
+                }
+
+                Float2 t0 = uvs[corner[0]];
+                Float2 t1 = uvs[corner[1]];
+                Float2 t2 = uvs[corner[2]];
+                double uvArea = 0.5 * ((double(t1[0]) - t0[0]) * (double(t2[1]) - t0[1]) -
+                                       (double(t1[1]) - t0[1]) * (double(t2[0]) - t0[0]));
+                if (!std::isfinite(uvArea)) {
+                    continue;
+                }
+                if (!degenerate && uvArea != 0.0) {
+                    double density = options.textureSize * std::sqrt(std::abs(uvArea) / area);
+                    chunk.densitySum += density * area;
+                    chunk.densityArea += area;
+                    chunk.densityMin = std::min(chunk.densityMin, density);
+                    chunk.densityMax = std::max(chunk.densityMax, density);
+                }
+                if (uvArea != 0.0) {
+                    Rasterize(uvArea > 0.0 ? t0 : t1, uvArea > 0.0 ? t1 : t0, t2, grid, raster);
+                }
+            }
+        }, workers);
+
+        for (const TriangleChunk& chunk : triangleChunks) {
+            stats.invalidIndices += chunk.invalid;
+            stats.degenerate += chunk.degenerate;
+            stats.densitySum += chunk.densitySum;
+            stats.densityArea += chunk.densityArea;
+            stats.densityMin = std::min(stats.densityMin, chunk.densityMin);
+            stats.densityMax = std::max(stats.densityMax, chunk.densityMax);
+        }
+
+        // ---- UV overlap: covered cells that more than one triangle claimed -------
+        std::vector<std::array<size_t, 2>> rasterChunks((raster.size() + VERTEX_GRAIN - 1) / VERTEX_GRAIN);
+        Parallel::ForRange(raster.size(), VERTEX_GRAIN, [&](size_t begin, size_t end) {
+            std::array<size_t, 2>& chunk = rasterChunks[begin / VERTEX_GRAIN];
+            chunk = { 0, 0 };
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t hits = raster[i].load(std::memory_order_relaxed);
+                chunk[0] += hits > 0 ? 1 : 0;
+                chunk[1] += hits > 1 ? 1 : 0;
+            }
+        }, workers);
+        for (const std::array<size_t, 2>& chunk : rasterChunks) {
+            stats.coveredCells += chunk[0];
+            stats.overlapCells += chunk[1];
+        }
+
+        // ---- Edge census: runs of one welded edge in the sorted keys -------------
+        std::vector<size_t> edgeBuckets = BucketSort(edges,
+            [](uint64_t key) { return Mix(key >> 1); },
+            [](uint64_t a, uint64_t b) { return a < b; }, workers);
+        std::vector<EdgeChunk> edgeChunks(SORT_BUCKETS);
+        Parallel::ForRange(SORT_BUCKETS, 1, [&](size_t begin, size_t end) {
+            EdgeChunk& chunk = edgeChunks[begin];
+            size_t i = edgeBuckets[begin];
+            while (i < edgeBuckets[end]) {
+                uint64_t edge = edges[i] >> 1;
+                size_t run = i;
+                size_t forward = 0;
+                while (run < edgeBuckets[end] && (edges[run] >> 1) == edge) {
+                    forward += (edges[run] & 1) ? 0 : 1;
+                    ++run;
+                }
+                if (edges[i] != NO_EDGE) {
+                    size_t count = run - i;
+                    chunk.boundary += count == 1 ? 1 : 0;
+                    chunk.nonManifold += count > 2 ? 1 : 0;
+                    // A consistently wound pair walks the shared edge once in each direction
+                    chunk.inconsistent += count == 2 && forward != 1 ? 1 : 0;
+                }
+                i = run;
+            }
+        }, workers);
+        for (const EdgeChunk& chunk : edgeChunks) {
+            stats.boundary += chunk.boundary;
+            stats.nonManifold += chunk.nonManifold;
+            stats.inconsistent += chunk.inconsistent;
+        }
+    }
+
+    // Dense float accessors are viewed in place; anything else is decoded into `scratch`
+    template <size_t N>
+    static GltfAccessorView<std::array<float, N>> FloatView(const GltfDocument& doc, int32_t accessorIndex,
+                                                           std::vector<float>& scratch) {
+        const GltfAccessor& accessor = doc.accessors[accessorIndex];
+        if (accessor.componentType == static_cast<uint32_t>(GltfComponentType::FLOAT) && accessor.components == N) {
+            GltfAccessorView<std::array<float, N>> view = doc.GetView<std::array<float, N>>(accessorIndex);
+            if (!view.empty()) {
+                return view;
+            }
+        }
+        scratch = GltfLoader::ReadAccessor(doc, accessorIndex, N);
+        return GltfAccessorView<std::array<float, N>>(reinterpret_cast<const uint8_t*>(scratch.data()),
+                                                       accessor.count, sizeof(float) * N);
+    }
+
+    static IndexStream Indices(const GltfDocument& doc, const GltfPrimitive& primitive, size_t vertexCount) {
+        IndexStream stream;
+        if (primitive.indices < 0) {
+            stream.size = vertexCount - vertexCount % 3;
+            return stream;
+        }
+
+        const GltfAccessor& accessor = doc.accessors[primitive.indices];
+        stream.size = accessor.count - accessor.count % 3;
+        auto adopt = [&](const auto& view) {
+            stream.data = view.data();
+            stream.stride = view.stride();
+            stream.width = sizeof(typename std::decay_t<decltype(view[0])>);
+            return !view.empty();
+        };
+        bool inPlace = false;
+        switch (static_cast<GltfComponentType>(accessor.componentType)) {
+            case GltfComponentType::UNSIGNED_BYTE:  inPlace = adopt(doc.GetView<uint8_t>(primitive.indices)); break;
+            case GltfComponentType::UNSIGNED_SHORT: inPlace = adopt(doc.GetView<uint16_t>(primitive.indices)); break;
+            default:                                inPlace = adopt(doc.GetView<uint32_t>(primitive.indices)); break;
+        }
+        if (!inPlace) {
+            stream.resolved = GltfLoader::ReadIndices(doc, primitive.indices);
+            stream.data = reinterpret_cast<const uint8_t*>(stream.resolved.data());
+            stream.stride = sizeof(uint32_t);
+            stream.width = sizeof(uint32_t);
+        }
+        return stream;
+    }
+
+    // Scatter `items` into hash buckets chunk by chunk, then sort each bucket on its own.
+    // Equal items share a bucket, so runs can be scanned per bucket. Returns the
+    // SORT_BUCKETS + 1 bucket offsets.
+    template <typename T, typename Hash, typename Less>
+    static std::vector<size_t> BucketSort(std::vector<T>& items, Hash hash, Less less, uint32_t workers) {
+        const size_t count = items.size();
+        const size_t chunks = (count + SORT_GRAIN - 1) / SORT_GRAIN;
+        std::vector<uint8_t> bucketOf(count);
+        std::vector<size_t> offsets(chunks * SORT_BUCKETS, 0);
+        Parallel::ForRange(count, SORT_GRAIN, [&](size_t begin, size_t end) {
+            size_t* histogram = &offsets[(begin / SORT_GRAIN) * SORT_BUCKETS];
+            for (size_t i = begin; i < end; ++i) {
+                bucketOf[i] = static_cast<uint8_t>(hash(items[i]) >> 56);
+                ++histogram[bucketOf[i]];
+            }
+        }, workers);
+
+        // Bucket-major prefix sum: each chunk owns a disjoint slice of every bucket
+        std::vector<size_t> buckets(SORT_BUCKETS + 1, 0);
+        size_t running = 0;
+        for (size_t b = 0; b < SORT_BUCKETS; ++b) {
+            buckets[b] = running;
+            for (size_t c = 0; c < chunks; ++c) {
+                size_t n = offsets[c * SORT_BUCKETS + b];
+                offsets[c * SORT_BUCKETS + b] = running;
+                running += n;
+            }
+        }
+        buckets[SORT_BUCKETS] = running;
+
+        std::vector<T> sorted(count);
+        Parallel::ForRange(count, SORT_GRAIN, [&](size_t begin, size_t end) {
+            size_t* cursor = &offsets[(begin / SORT_GRAIN) * SORT_BUCKETS];
+            for (size_t i = begin; i < end; ++i) {
+                sorted[cursor[bucketOf[i]]++] = items[i];
+            }
+        }, workers);
+        Parallel::ForRange(SORT_BUCKETS, 1, [&](size_t begin, size_t end) {
+            std::sort(sorted.begin() + buckets[begin], sorted.begin() + buckets[end], less);
+        }, workers);
+        items.swap(sorted);
+        return buckets;
+    }
+
+    // Count the raster cells whose centres fall inside a counter-clockwise UV triangle.
+    // Edges follow a top-left rule, so two triangles sharing an edge never both claim a cell.
+    static void Rasterize(const Float2& a, const Float2& b, const Float2& c, uint32_t grid,
+                          std::vector<std::atomic<uint32_t>>& raster) {
+        double scale = grid;
+        double minU = std::min({ a[0], b[0], c[0] }) * scale - 0.5;
+        double maxU = std::max({ a[0], b[0], c[0] }) * scale - 0.5;
+        double minV = std::min({ a[1], b[1], c[1] }) * scale - 0.5;
+        double maxV = std::max({ a[1], b[1], c[1] }) * scale - 0.5;
+        if (maxU < 0.0 || maxV < 0.0 || minU > grid - 1.0 || minV > grid - 1.0) {
+            return;
+        }
+        uint32_t x0 = static_cast<uint32_t>(std::ceil(std::max(minU, 0.0)));
+        uint32_t x1 = static_cast<uint32_t>(std::floor(std::min(maxU, grid - 1.0)));
+        uint32_t y0 = static_cast<uint32_t>(std::ceil(std::max(minV, 0.0)));
+        uint32_t y1 = static_cast<uint32_t>(std::floor(std::min(maxV, grid - 1.0)));
+
+        const Float2* corners[3] = { &a, &b, &c };
+        double ex[3], ey[3], ox[3], oy[3];
+        bool topLeft[3];
+        for (int k = 0; k < 3; ++k) {
+            const Float2& from = *corners[k];
+            const Float2& to = *corners[(k + 1) % 3];
+            ox[k] = from[0];
+            oy[k] = from[1];
+            ex[k] = double(to[0]) - from[0];
+            ey[k] = double(to[1]) - from[1];
+            topLeft[k] = ey[k] > 0.0 || (ey[k] == 0.0 && ex[k] < 0.0);
+        }
+        for (uint32_t y = y0; y <= y1; ++y) {
+            double v = (y + 0.5) / scale;
+            for (uint32_t x = x0; x <= x1; ++x) {
+                double u = (x + 0.5) / scale;
+                bool inside = true;
+                for (int k = 0; k < 3 && inside; ++k) {
+                    double w = ex[k] * (v - oy[k]) - ey[k] * (u - ox[k]);
+                    inside = w > 0.0 || (w == 0.0 && topLeft[k]);
+                }
+                if (inside) {
+                    raster[static_cast<size_t>(y) * grid + x].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    static void AddWorldBounds(const PrimitiveStats& stats, const GltfPrimitiveInstance& instance,
+                               MeshValidationReport& report) {
+        const std::array<float, 16>& m = instance.world;
+        for (int corner = 0; corner < 8; ++corner) {
+            float x = (corner & 1) ? stats.max[0] : stats.min[0];
+            float y = (corner & 2) ? stats.max[1] : stats.min[1];
+            float z = (corner & 4) ? stats.max[2] : stats.min[2];
+            Float3 p = { m[0] * x + m[4] * y + m[8] * z + m[12],
+                         m[1] * x + m[5] * y + m[9] * z + m[13],
+                         m[2] * x + m[6] * y + m[10] * z + m[14] };
+            Grow(report.hasBounds, report.boundsMin, report.boundsMax, p);
+        }
+    }
+
+    template <size_t N>
+    static void Grow(bool& initialized, std::array<float, N>& min, std::array<float, N>& max,
+                     const std::array<float, N>& p) {
+        if (!initialized) {
+            min = max = p;
+            initialized = true;
+            return;
+        }
+        for (size_t i = 0; i < N; ++i) {
+            min[i] = std::min(min[i], p[i]);
+            max[i] = std::max(max[i], p[i]);
+        }
+    }
+
+    // splitmix64 finalizer; the top byte picks the sort bucket
+    static uint64_t Mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    static std::string FormatNumber(double value) {
+        if (!std::isfinite(value)) {
+            return "null";
+        }
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.9g", value);
+        return text;
+    }
+
+};
+
+inline void MeshValidator::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("MeshValidator");
+
+    // Write meshes to a scratch GLB and validate it from disk, the way bf-validate does
+    auto validate = [](const std::vector<SoftwareMesh>& meshes, const MeshValidationOptions& options) {
+        std::error_code ec;
+        std::string path = (std::filesystem::temp_directory_path(ec) / "brightforge_mesh_validate.glb").string();
+        std::vector<GltfExportMesh> entries;
+        for (const SoftwareMesh& mesh : meshes) {
+            entries.push_back({ "Mesh", &mesh, -1 });
+        }
+        MeshValidationReport report;
+        if (GltfLoader::WriteGlb(path, entries, {})) {
+            report = ValidateFile(path, options);
+        } else {
+            report.errors.push_back("write failed");
+        }
+        std::filesystem::remove(path, ec);
+        return report;
+    };
+    auto vertex = [](SoftwareMesh& mesh, float x, float y, float z, float u, float v) {
+        float data[SOFTWARE_MESH_STRIDE] = { x, y, z, 0.0f, 0.0f, 1.0f, u, v };
+        mesh.vertices.insert(mesh.vertices.end(), data, data + SOFTWARE_MESH_STRIDE);
+        return static_cast<uint32_t>(mesh.vertices.size() / SOFTWARE_MESH_STRIDE - 1);
+    };
+
+    // Unit cube with split vertices per face (as exporters write it) and each face in its own
+    // sixth of the atlas: closed, consistently wound, no overlap, one texel density everywhere
+    tests.AddTest("MeshValidator", "Closed cube is watertight", [=]() {
+        SoftwareMesh cube;
+        for (int axis = 0; axis < 3; ++axis) {
+            for (int side = 0; side < 2; ++side) {
+                int face = axis * 2 + side;
+                uint32_t base = static_cast<uint32_t>(cube.vertices.size() / SOFTWARE_MESH_STRIDE);
+                for (int corner = 0; corner < 4; ++corner) {
+                    float a = static_cast<float>(corner & 1);
+                    float b = static_cast<float>(corner >> 1);
+                    float p[3];
+                    p[axis] = static_cast<float>(side);
+                    p[(axis + 1) % 3] = a;
+                    p[(axis + 2) % 3] = b;
+                    vertex(cube, p[0], p[1], p[2], (face + a) / 6.0f, b);
+                }
+                // Outward winding: flip on the low side
+                uint32_t quad[6] = { 0, 1, 3, 0, 3, 2 };
+                for (int k = 0; k < 6; ++k) {
+                    uint32_t i = quad[side == 1 ? k : (k / 3) * 3 + 2 - k % 3];
+                    cube.indices.push_back(base + i);
+                }
+            }
+        }
+        MeshValidationReport report = validate({ cube }, MeshValidationOptions());
+        double expected = 1024.0 * std::sqrt(1.0 / 6.0);
+        return report.valid && report.watertight && report.vertexCount == 24 && report.faceCount == 12 &&
+               report.boundaryEdges == 0 && report.nonManifoldEdges == 0 && report.inconsistentEdges == 0 &&
+               report.degenerateTriangles == 0 && report.uv.hasUvs && report.uv.outOfRange == 0 &&
+               report.uv.overlapRatio == 0.0 && std::abs(report.uv.texelDensityMean - expected) < 1e-3 &&
+               std::abs(report.uv.texelDensityMax - report.uv.texelDensityMin) < 1e-3 &&
+               report.hasBounds && report.boundsMin == Float3{ 0, 0, 0 } && report.boundsMax == Float3{ 1, 1, 1 };
+    });
+
+    // Open n x n grid: 4n border edges; a zero-area sliver and a NaN corner are reported
+    tests.AddTest("MeshValidator", "Borders, degenerates and NaNs", [=]() {
+        const uint32_t n = 40;
+        SoftwareMesh grid;
+        for (uint32_t y = 0; y <= n; ++y) {
+            for (uint32_t x = 0; x <= n; ++x) {
+                vertex(grid, x / float(n), y / float(n), 0.0f, x / float(n), y / float(n));
+            }
+        }
+        for (uint32_t y = 0; y < n; ++y) {
+            for (uint32_t x = 0; x < n; ++x) {
+                uint32_t i = y * (n + 1) + x;
+                grid.indices.insert(grid.indices.end(), { i, i + 1, i + n + 2, i, i + n + 2, i + n + 1 });
+            }
+        }
+        MeshValidationReport clean = validate({ grid }, MeshValidationOptions());
+
+        SoftwareMesh broken = grid;
+        broken.indices.insert(broken.indices.end(), { 0, 1, 2 });   // Collinear along the bottom row
+        uint32_t nan = vertex(broken, std::nanf(""), 0.0f, 0.0f, 0.5f, 0.5f);
+        broken.indices.insert(broken.indices.end(), { nan, 0, n + 1 });
+        MeshValidationReport report = validate({ broken }, MeshValidationOptions());
+
+        return clean.valid && !clean.watertight && clean.boundaryEdges == 4 * n && clean.degenerateTriangles == 0 &&
+               clean.uv.overlapRatio == 0.0 && !report.valid && report.nonFinitePositions == 1 &&
+               report.degenerateTriangles == 2 && report.hasBounds && report.boundsMax[0] == 1.0f;
+    });
+
+    // A fin on one edge makes it non-manifold; a flipped triangle breaks winding; copying
+    // one quad's UVs onto another shows up as overlap
+    tests.AddTest("MeshValidator", "Non-manifold edges, winding and UV overlap", [=]() {
+        SoftwareMesh mesh;
+        uint32_t a = vertex(mesh, 0, 0, 0, 0.0f, 0.0f);
+        uint32_t b = vertex(mesh, 1, 0, 0, 0.5f, 0.0f);
+        uint32_t c = vertex(mesh, 0, 1, 0, 0.0f, 0.5f);
+        uint32_t d = vertex(mesh, 1, 1, 0, 0.5f, 0.5f);
+        uint32_t e = vertex(mesh, 0.5f, 0.5f, 1, 0.25f, 0.25f);
+        uint32_t f = vertex(mesh, 2, 0, 0, 0.0f, 0.0f);
+        uint32_t g = vertex(mesh, 2, 1, 0, 0.0f, 0.5f);
+        mesh.indices = { a, b, c, c, b, d,    // Quad
+                         b, c, e,             // Fin on the diagonal b-c: three triangles share it
+                         b, f, d, f, d, g };  // Second quad, its second triangle wound backwards
+        MeshValidationOptions options;
+        options.uvGridSize = 64;
+        MeshValidationReport report = validate({ mesh }, options);
+        std::string json = ToJson(report);
+        return report.valid && report.nonManifoldEdges == 1 && report.inconsistentEdges == 1 &&
+               !report.watertight && report.uv.overlapRatio > 0.1 &&
+               json.find("\"non_manifold_edges\":1,") != std::string::npos &&
+               json.find("\"watertight\":false") != std::string::npos &&
+               json.find("\"errors\":[]") != std::string::npos;
+    });
+
+    tests.AddTest("MeshValidator", "Missing and truncated files", []() {
+        std::error_code ec;
+        std::string path = (std::filesystem::temp_directory_path(ec) / "brightforge_mesh_validate_short.glb").string();
+        { std::ofstream(path) << "glTF"; }
+        MeshValidationReport tooSmall = ValidateFile(path);
+        std::filesystem::remove(path, ec);
+        MeshValidationReport missing = ValidateFile(path);
+        return !tooSmall.valid && tooSmall.errors.size() == 1 && tooSmall.errors[0].find("too small") != std::string::npos &&
+               !missing.valid && missing.errors[0].rfind("File not found", 0) == 0 &&
+               ToJson(missing).find("\"bounds\":null") != std::string::npos;
+    });
+}
+
+// Note on usage:
+// src/tools/bf-validate.cpp validates files or directory trees concurrently and prints one
+// ToJson() line per file; python/mesh_utils.py validate_mesh() and the forge3d validate-uvs
+// stage call it instead of trimesh / the Python bridge when the binary is available.
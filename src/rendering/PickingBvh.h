@@ -0,0 +1,1358 @@
+/** PickingBvh - Two-level BVH for CPU ray picking and marquee selection
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "IRenderService.h"
+#include "SoftwareMesh.h"
+#include "../core/Float8.h"
+#include "../core/TestManagerNew.h"
+#include <vector>
+#include <memory>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+// Children per node; one Float8 slab test covers all of them
+constexpr uint32_t BVH_WIDTH = 8;
+
+// Primitives per leaf; a BLAS leaf is exactly one 8-lane triangle block
+constexpr uint32_t BVH_LEAF_SIZE = 8;
+
+// Centroid bins per axis for the SAH sweep
+constexpr uint32_t BVH_SAH_BINS = 16;
+
+// Child slot encoding: inner node index, BVH_LEAF_BIT | leaf index, or empty
+constexpr uint32_t BVH_LEAF_BIT = 0x80000000u;
+constexpr uint32_t BVH_EMPTY_CHILD = 0xFFFFFFFFu;
+
+struct BvhBounds {
+    float min[3] = { INFINITY, INFINITY, INFINITY };
+    float max[3] = { -INFINITY, -INFINITY, -INFINITY };
+
+    void Grow(const float point[3]) {
+        for (int c = 0; c < 3; ++c) {
+            min[c] = std::min(min[c], point[c]);
+            max[c] = std::max(max[c], point[c]);
+        }
+    }
+
+    void Grow(const BvhBounds& other) {
+        for (int c = 0; c < 3; ++c) {
+            min[c] = std::min(min[c], other.min[c]);
+            max[c] = std::max(max[c], other.max[c]);
+        }
+    }
+
+    bool Empty() const {
+        return min[0] > max[0];
+    }
+
+    float SurfaceArea() const {
+        if (Empty()) {
+            return 0.0f;
+        }
+        float dx = max[0] - min[0];
+        float dy = max[1] - min[1];
+        float dz = max[2] - min[2];
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+    }
+
+    float Centroid(int axis) const {
+        return 0.5f * (min[axis] + max[axis]);
+    }
+};
+
+// Six inward planes (n.p + d >= 0 inside): left, right, bottom, top, near, far
+struct PickFrustum {
+    float planes[6][4] = {};
+};
+
+struct PickRay {
+    float origin[3] = { 0.0f, 0.0f, 0.0f };
+    float direction[3] = { 0.0f, 0.0f, -1.0f };
+};
+
+// Camera basis used to turn viewport pixels into rays and frustums (and back)
+struct PickCamera {
+    float position[3] = { 0.0f, 0.0f, 5.0f };
+    float right[3] = { 1.0f, 0.0f, 0.0f };
+    float up[3] = { 0.0f, 1.0f, 0.0f };
+    float forward[3] = { 0.0f, 0.0f, -1.0f };
+    float tanHalfFovY = 0.637f;
+    float aspect = 1.0f;
+    float width = 1.0f;
+    float height = 1.0f;
+    float nearPlane = 0.1f;
+    float farPlane = 1000.0f;
+
+    // width/height are the viewport size in the same units as the mouse coordinates
+    static PickCamera FromCamera(const CameraData& camera, float width, float height) {
+        PickCamera result;
+        result.position[0] = camera.positionX;
+        result.position[1] = camera.positionY;
+        result.position[2] = camera.positionZ;
+
+        float forward[3] = { camera.lookAtX - camera.positionX, camera.lookAtY - camera.positionY,
+                             camera.lookAtZ - camera.positionZ };
+        Normalize(forward);
+        float worldUp[3] = { camera.upX, camera.upY, camera.upZ };
+        float right[3];
+        Cross(forward, worldUp, right);
+        Normalize(right);
+        float up[3];
+        Cross(right, forward, up);
+
+        for (int c = 0; c < 3; ++c) {
+            result.forward[c] = forward[c];
+            result.right[c] = right[c];
+            result.up[c] = up[c];
+        }
+        result.tanHalfFovY = std::tan(camera.fovDegrees * 0.5f * 3.14159265359f / 180.0f);
+        result.width = std::max(width, 1.0f);
+        result.height = std::max(height, 1.0f);
+        result.aspect = result.width / result.height;
+        result.nearPlane = camera.nearPlane;
+        result.farPlane = camera.farPlane;
+        return result;
+    }
+
+    // Ray through viewport point (x, y), y down; direction has unit forward component
+    PickRay RayThrough(float x, float y) const {
+        PickRay ray;
+        float rx, ry;
+        ScreenToView(x, y, rx, ry);
+        for (int c = 0; c < 3; ++c) {
+            ray.origin[c] = position[c];
+            ray.direction[c] = right[c] * rx + up[c] * ry + forward[c];
+        }
+        return ray;
+    }
+
+    // World point -> viewport point; false when behind the camera
+    bool Project(const float world[3], float& x, float& y) const {
+        float d[3] = { world[0] - position[0], world[1] - position[1], world[2] - position[2] };
+        float depth = Dot(d, forward);
+        if (depth <= 1e-6f) {
+            return false;
+        }
+        float ndcX = Dot(d, right) / (depth * tanHalfFovY * aspect);
+        float ndcY = Dot(d, up) / (depth * tanHalfFovY);
+        x = (ndcX + 1.0f) * 0.5f * width;
+        y = (1.0f - ndcY) * 0.5f * height;
+        return true;
+    }
+
+    // Marquee rectangle (any two opposite corners) -> world-space frustum
+    PickFrustum FrustumFor(float x0, float y0, float x1, float y1) const {
+        float left, top, rightEdge, bottom;
+        ScreenToView(std::min(x0, x1), std::min(y0, y1), left, top);
+        ScreenToView(std::max(x0, x1), std::max(y0, y1), rightEdge, bottom);
+
+        // Side planes pass through the eye; inward normals in view space
+        float sides[4][3] = {
+            { 1.0f, 0.0f, -left },
+            { -1.0f, 0.0f, rightEdge },
+            { 0.0f, 1.0f, -bottom },
+            { 0.0f, -1.0f, top }
+        };
+
+        PickFrustum frustum;
+        for (int p = 0; p < 4; ++p) {
+            float n[3];
+            for (int c = 0; c < 3; ++c) {
+                n[c] = right[c] * sides[p][0] + up[c] * sides[p][1] + forward[c] * sides[p][2];
+            }
+            Normalize(n);
+            SetPlane(frustum.planes[p], n, -Dot(n, position));
+        }
+        float back[3] = { -forward[0], -forward[1], -forward[2] };
+        SetPlane(frustum.planes[4], forward, -Dot(forward, position) - nearPlane);
+        SetPlane(frustum.planes[5], back, Dot(forward, position) + farPlane);
+        return frustum;
+    }
+
+private:
+    void ScreenToView(float x, float y, float& rx, float& ry) const {
+        float ndcX = 2.0f * x / width - 1.0f;
+        float ndcY = 1.0f - 2.0f * y / height;
+        rx = ndcX * tanHalfFovY * aspect;
+        ry = ndcY * tanHalfFovY;
+    }
+
+    static void SetPlane(float plane[4], const float n[3], float d) {
+        plane[0] = n[0];
+        plane[1] = n[1];
+        plane[2] = n[2];
+        plane[3] = d;
+    }
+
+    static float Dot(const float a[3], const float b[3]) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    static void Normalize(float v[3]) {
+        float length = std::sqrt(Dot(v, v));
+        if (length > 0.0f) {
+            v[0] /= length;
+            v[1] /= length;
+            v[2] /= length;
+        }
+    }
+
+    static void Cross(const float a[3], const float b[3], float out[3]) {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+};
+
+// Eight children per node, bounds stored SoA for the SIMD slab and plane tests.
+// Unused slots hold inverted (empty) bounds, which every test rejects.
+struct BvhNode {
+    alignas(32) float bounds[6][8]; // minX, minY, minZ, maxX, maxY, maxZ
+    uint32_t child[8];
+};
+
+struct BvhLeaf {
+    uint32_t first = 0; // Into WideBvh::order
+    uint32_t count = 0;
+};
+
+// Ray prepared once per traversal (per instance, after the object-space transform)
+struct BvhRay {
+    float origin[3];
+    float direction[3];
+    float inverse[3];
+    int nearPlane[3]; // Bounds row hit first per axis (min or max)
+
+    static BvhRay Make(const float origin[3], const float direction[3]) {
+        BvhRay ray;
+        for (int c = 0; c < 3; ++c) {
+            ray.origin[c] = origin[c];
+            ray.direction[c] = direction[c];
+            // Zero components get a huge finite inverse so slabs never produce 0 * inf
+            float d = std::fabs(direction[c]) > 1e-20f ? direction[c] : (direction[c] < 0.0f ? -1e-20f : 1e-20f);
+            ray.inverse[c] = 1.0f / d;
+            ray.nearPlane[c] = ray.inverse[c] >= 0.0f ? c : c + 3;
+        }
+        return ray;
+    }
+};
+
+// Binned-SAH binary build collapsed into an 8-wide tree over arbitrary primitive bounds.
+// Nodes are stored parent-before-child, so Refit() can walk them backwards.
+struct WideBvh {
+    std::vector<BvhNode> nodes;
+    std::vector<BvhLeaf> leaves;
+    std::vector<uint32_t> order; // Primitive indices grouped by leaf
+    BvhBounds bounds;
+
+    void Build(const std::vector<BvhBounds>& primitives) {
+        nodes.clear();
+        leaves.clear();
+        order.resize(primitives.size());
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        bounds = BvhBounds();
+        // Guard: nothing to index
+        if (primitives.empty()) {
+            return;
+        }
+
+        std::vector<BinaryNode> binary;
+        binary.reserve(primitives.size() / 2 + 1);
+        BuildBinary(primitives, binary);
+        bounds = binary[0].bounds;
+
+        nodes.reserve(binary.size() / 4 + 1);
+        EmitWide(binary, 0);
+    }
+
+    // Recompute every box bottom-up after primitive bounds moved; topology is kept
+    void Refit(const std::vector<BvhBounds>& primitives) {
+        for (size_t n = nodes.size(); n-- > 0;) {
+            BvhNode& node = nodes[n];
+            for (uint32_t slot = 0; slot < BVH_WIDTH; ++slot) {
+                uint32_t child = node.child[slot];
+                if (child == BVH_EMPTY_CHILD) {
+                    continue;
+                }
+                BvhBounds box;
+                if (child & BVH_LEAF_BIT) {
+                    const BvhLeaf& leaf = leaves[child & ~BVH_LEAF_BIT];
+                    for (uint32_t i = 0; i < leaf.count; ++i) {
+                        box.Grow(primitives[order[leaf.first + i]]);
+                    }
+                } else {
+                    box = NodeBounds(nodes[child]);
+                }
+                SetSlot(node, slot, box);
+            }
+        }
+        bounds = nodes.empty() ? BvhBounds() : NodeBounds(nodes[0]);
+    }
+
+    // Closest-first traversal; leafFn(leafIndex, tMax&) may shrink tMax
+    template <typename LeafFn>
+    void Traverse(const BvhRay& ray, float& tMax, LeafFn&& leafFn) const {
+        // Guard: empty tree
+        if (nodes.empty()) {
+            return;
+        }
+
+        struct Entry { uint32_t child; float tNear; };
+        Entry stack[64 * BVH_WIDTH];
+        int top = 0;
+        stack[top++] = { 0, 0.0f };
+
+        const Float8 origin[3] = { Float8::Broadcast(ray.origin[0]), Float8::Broadcast(ray.origin[1]),
+                                   Float8::Broadcast(ray.origin[2]) };
+        const Float8 inverse[3] = { Float8::Broadcast(ray.inverse[0]), Float8::Broadcast(ray.inverse[1]),
+                                    Float8::Broadcast(ray.inverse[2]) };
+
+        while (top > 0) {
+            Entry entry = stack[--top];
+            if (entry.tNear > tMax) {
+                continue;
+            }
+            if (entry.child & BVH_LEAF_BIT) {
+                leafFn(entry.child & ~BVH_LEAF_BIT, tMax);
+                continue;
+            }
+
+            const BvhNode& node = nodes[entry.child];
+            Float8 tNear = Float8::Broadcast(0.0f);
+            Float8 tFar = Float8::Broadcast(tMax);
+            for (int c = 0; c < 3; ++c) {
+                int nearRow = ray.nearPlane[c];
+                int farRow = nearRow < 3 ? nearRow + 3 : nearRow - 3;
+                tNear = Float8::Max(tNear, (Float8::Load(node.bounds[nearRow]) - origin[c]) * inverse[c]);
+                tFar = Float8::Min(tFar, (Float8::Load(node.bounds[farRow]) - origin[c]) * inverse[c]);
+            }
+            alignas(32) float nearLanes[8];
+            alignas(32) float farLanes[8];
+            tNear.Store(nearLanes);
+            tFar.Store(farLanes);
+
+            // Push hits far-to-near so the nearest child is popped first
+            Entry hits[BVH_WIDTH];
+            int hitCount = 0;
+            for (uint32_t slot = 0; slot < BVH_WIDTH; ++slot) {
+                if (node.child[slot] != BVH_EMPTY_CHILD && nearLanes[slot] <= farLanes[slot]) {
+                    Entry hit = { node.child[slot], nearLanes[slot] };
+                    int i = hitCount++;
+                    while (i > 0 && hits[i - 1].tNear < hit.tNear) {
+                        hits[i] = hits[i - 1];
+                        --i;
+                    }
+                    hits[i] = hit;
+                }
+            }
+            for (int i = 0; i < hitCount; ++i) {
+                stack[top++] = hits[i];
+            }
+        }
+    }
+
+    // Children classified against a frustum: -1 outside, 0 straddling, 1 inside
+    static void ClassifyChildren(const BvhNode& node, const PickFrustum& frustum, int out[8]) {
+        Float8 outside = Float8::Broadcast(0.0f);
+        Float8 straddle = Float8::Broadcast(0.0f);
+        const Float8 zero = Float8::Broadcast(0.0f);
+        for (const float* plane : frustum.planes) {
+            // Farthest corner along the normal decides outside, nearest decides inside
+            Float8 farthest = Float8::Broadcast(plane[3]);
+            Float8 nearest = Float8::Broadcast(plane[3]);
+            for (int c = 0; c < 3; ++c) {
+                Float8 n = Float8::Broadcast(plane[c]);
+                Float8 low = Float8::Load(node.bounds[c]) * n;
+                Float8 high = Float8::Load(node.bounds[c + 3]) * n;
+                farthest = farthest + Float8::Max(low, high);
+                nearest = nearest + Float8::Min(low, high);
+            }
+            outside = Float8::Select(Float8::Greater(zero, farthest), Float8::Broadcast(1.0f), outside);
+            straddle = Float8::Select(Float8::Greater(zero, nearest), Float8::Broadcast(1.0f), straddle);
+        }
+        alignas(32) float outsideLanes[8];
+        alignas(32) float straddleLanes[8];
+        outside.Store(outsideLanes);
+        straddle.Store(straddleLanes);
+        for (uint32_t slot = 0; slot < BVH_WIDTH; ++slot) {
+            bool empty = node.child[slot] == BVH_EMPTY_CHILD || node.bounds[0][slot] > node.bounds[3][slot];
+            out[slot] = (empty || outsideLanes[slot] != 0.0f) ? -1 : (straddleLanes[slot] != 0.0f ? 0 : 1);
+        }
+    }
+
+private:
+    struct BinaryNode {
+        BvhBounds bounds;
+        uint32_t left = 0;   // Inner: child indices; leaf: left == right == 0
+        uint32_t right = 0;
+        uint32_t first = 0;
+        uint32_t count = 0;
+
+        bool IsLeaf() const { return left == 0 && right == 0; }
+    };
+
+    void BuildBinary(const std::vector<BvhBounds>& primitives, std::vector<BinaryNode>& binary) {
+        struct Task { uint32_t node; uint32_t first; uint32_t count; };
+        std::vector<Task> tasks;
+        binary.emplace_back();
+        tasks.push_back({ 0, 0, static_cast<uint32_t>(primitives.size()) });
+
+        while (!tasks.empty()) {
+            Task task = tasks.back();
+            tasks.pop_back();
+
+            BvhBounds box;
+            BvhBounds centroids;
+            for (uint32_t i = 0; i < task.count; ++i) {
+                const BvhBounds& primitive = primitives[order[task.first + i]];
+                box.Grow(primitive);
+                float c[3] = { primitive.Centroid(0), primitive.Centroid(1), primitive.Centroid(2) };
+                centroids.Grow(c);
+            }
+            binary[task.node].bounds = box;
+            binary[task.node].first = task.first;
+            binary[task.node].count = task.count;
+
+            uint32_t split = FindSplit(primitives, task.first, task.count, box, centroids);
+            if (split == 0) {
+                continue; // Leaf
+            }
+
+            uint32_t left = static_cast<uint32_t>(binary.size());
+            binary.emplace_back();
+            binary.emplace_back();
+            binary[task.node].left = left;
+            binary[task.node].right = left + 1;
+            tasks.push_back({ left, task.first, split });
+            tasks.push_back({ left + 1, task.first + split, task.count - split });
+        }
+    }
+
+    // Partitions order[first, first + count) and returns the left count, or 0 for a leaf
+    uint32_t FindSplit(const std::vector<BvhBounds>& primitives, uint32_t first, uint32_t count,
+                       const BvhBounds& box, const BvhBounds& centroids) {
+        if (count <= 2) {
+            return 0;
+        }
+
+        struct Bin { BvhBounds bounds; uint32_t count = 0; };
+        float bestCost = INFINITY;
+        int bestAxis = -1;
+        uint32_t bestBin = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            float extent = centroids.max[axis] - centroids.min[axis];
+            if (extent <= 0.0f) {
+                continue;
+            }
+            float scale = BVH_SAH_BINS / extent;
+            Bin bins[BVH_SAH_BINS];
+            for (uint32_t i = 0; i < count; ++i) {
+                const BvhBounds& primitive = primitives[order[first + i]];
+                uint32_t b = std::min(BVH_SAH_BINS - 1,
+                    static_cast<uint32_t>((primitive.Centroid(axis) - centroids.min[axis]) * scale));
+                bins[b].bounds.Grow(primitive);
+                ++bins[b].count;
+            }
+
+            // Sweep: right-to-left suffix areas, then left-to-right costs
+            float rightArea[BVH_SAH_BINS];
+            uint32_t rightCount[BVH_SAH_BINS];
+            BvhBounds accumulated;
+            uint32_t accumulatedCount = 0;
+            for (uint32_t b = BVH_SAH_BINS - 1; b > 0; --b) {
+                accumulated.Grow(bins[b].bounds);
+                accumulatedCount += bins[b].count;
+                rightArea[b] = accumulated.SurfaceArea();
+                rightCount[b] = accumulatedCount;
+            }
+            accumulated = BvhBounds();
+            accumulatedCount = 0;
+            for (uint32_t b = 0; b + 1 < BVH_SAH_BINS; ++b) {
+                accumulated.Grow(bins[b].bounds);
+                accumulatedCount += bins[b].count;
+                if (accumulatedCount == 0 || rightCount[b + 1] == 0) {
+                    continue;
+                }
+                float cost = accumulated.SurfaceArea() * accumulatedCount + rightArea[b + 1] * rightCount[b + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = b;
+                }
+            }
+        }
+
+        // Leaf when it fits and splitting is no cheaper (traversal step costs ~1 triangle test)
+        float area = box.SurfaceArea();
+        float leafCost = static_cast<float>(count);
+        if (count <= BVH_LEAF_SIZE && (bestAxis < 0 || area <= 0.0f || 1.0f + bestCost / area >= leafCost)) {
+            return 0;
+        }
+
+        uint32_t* begin = order.data() + first;
+        uint32_t* end = begin + count;
+        uint32_t* middle;
+        if (bestAxis < 0) {
+            // Coincident centroids: any even split is as good as another
+            middle = begin + count / 2;
+        } else {
+            float extent = centroids.max[bestAxis] - centroids.min[bestAxis];
+            float scale = BVH_SAH_BINS / extent;
+            float minCentroid = centroids.min[bestAxis];
+            middle = std::partition(begin, end, [&](uint32_t index) {
+                uint32_t b = std::min(BVH_SAH_BINS - 1,
+                    static_cast<uint32_t>((primitives[index].Centroid(bestAxis) - minCentroid) * scale));
+                return b <= bestBin;
+            });
+        }
+        return static_cast<uint32_t>(middle - begin);
+    }
+
+    // Open the largest inner children until the node has BVH_WIDTH slots, then recurse
+    uint32_t EmitWide(const std::vector<BinaryNode>& binary, uint32_t root) {
+        uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+
+        uint32_t children[BVH_WIDTH];
+        uint32_t childCount = 0;
+        if (binary[root].IsLeaf()) {
+            children[childCount++] = root;
+        } else {
+            children[childCount++] = binary[root].left;
+            children[childCount++] = binary[root].right;
+        }
+        while (childCount < BVH_WIDTH) {
+            int largest = -1;
+            float largestArea = -1.0f;
+            for (uint32_t i = 0; i < childCount; ++i) {
+                const BinaryNode& child = binary[children[i]];
+                if (!child.IsLeaf() && child.bounds.SurfaceArea() > largestArea) {
+                    largestArea = child.bounds.SurfaceArea();
+                    largest = static_cast<int>(i);
+                }
+            }
+            if (largest < 0) {
+                break;
+            }
+            const BinaryNode& opened = binary[children[largest]];
+            children[largest] = opened.left;
+            children[childCount++] = opened.right;
+        }
+
+        uint32_t encoded[BVH_WIDTH];
+        for (uint32_t slot = 0; slot < BVH_WIDTH; ++slot) {
+            if (slot >= childCount) {
+                encoded[slot] = BVH_EMPTY_CHILD;
+                continue;
+            }
+            const BinaryNode& child = binary[children[slot]];
+            if (child.IsLeaf()) {
+                encoded[slot] = BVH_LEAF_BIT | static_cast<uint32_t>(leaves.size());
+                leaves.push_back({ child.first, child.count });
+            } else {
+                encoded[slot] = EmitWide(binary, children[slot]);
+            }
+        }
+
+        // nodes may have reallocated during recursion; write through the index
+        BvhNode& node = nodes[index];
+        for (uint32_t slot = 0; slot < BVH_WIDTH; ++slot) {
+            node.child[slot] = encoded[slot];
+            SetSlot(node, slot, slot < childCount ? binary[children[slot]].bounds : BvhBounds());
+        }
+        return index;
+    }
+
+    static void SetSlot(BvhNode& node, uint32_t slot, const BvhBounds& box) {
+        for (int c = 0; c < 3; ++c) {
+            node.bounds[c][slot] = box.min[c];
+            node.bounds[c + 3][slot] = box.max[c];
+        }
+    }
+
+    static BvhBounds NodeBounds(const BvhNode& node) {
+        BvhBounds box;
+        for (uint32_t slot = 0; slot < BVH_WIDTH; ++slot) {
+            if (node.child[slot] == BVH_EMPTY_CHILD) {
+                continue;
+            }
+            for (int c = 0; c < 3; ++c) {
+                box.min[c] = std::min(box.min[c], node.bounds[c][slot]);
+                box.max[c] = std::max(box.max[c], node.bounds[c + 3][slot]);
+            }
+        }
+        return box;
+    }
+};
+
+// Object-space hit within one mesh
+struct MeshHit {
+    uint32_t triangle = 0;
+    float distance = INFINITY; // Ray parameter t
+    float barycentric[2] = { 0.0f, 0.0f };
+};
+
+// Per-mesh BLAS; built once at load, shared by every instance of the mesh
+class MeshBvh {
+public:
+    static std::shared_ptr<const MeshBvh> Build(const SoftwareMesh& mesh) {
+        auto bvh = std::make_shared<MeshBvh>();
+        const uint32_t stride = mesh.vertexStride;
+        const size_t triangleCount = mesh.indices.size() / 3;
+        // Guard: malformed stride
+        if (stride < 3) {
+            return bvh;
+        }
+
+        std::vector<BvhBounds> bounds(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int corner = 0; corner < 3; ++corner) {
+                size_t vertex = mesh.indices[t * 3 + corner];
+                if ((vertex + 1) * stride > mesh.vertices.size()) {
+                    bounds[t] = BvhBounds(); // Out-of-range index: never hit
+                    break;
+                }
+                bounds[t].Grow(&mesh.vertices[vertex * stride]);
+            }
+        }
+        bvh->mTree.Build(bounds);
+
+        // One triangle block per leaf, in leaf order
+        bvh->mBlocks.resize(bvh->mTree.leaves.size());
+        for (size_t l = 0; l < bvh->mTree.leaves.size(); ++l) {
+            const BvhLeaf& leaf = bvh->mTree.leaves[l];
+            TriangleBlock& block = bvh->mBlocks[l];
+            std::memset(&block, 0, sizeof(block));
+            for (uint32_t lane = 0; lane < leaf.count; ++lane) {
+                uint32_t triangle = bvh->mTree.order[leaf.first + lane];
+                block.triangle[lane] = triangle;
+                if (bounds[triangle].Empty()) {
+                    continue; // Zero edges: determinant 0, never hits
+                }
+                const float* p0 = &mesh.vertices[mesh.indices[triangle * 3 + 0] * stride];
+                const float* p1 = &mesh.vertices[mesh.indices[triangle * 3 + 1] * stride];
+                const float* p2 = &mesh.vertices[mesh.indices[triangle * 3 + 2] * stride];
+                for (int c = 0; c < 3; ++c) {
+                    block.v0[c][lane] = p0[c];
+                    block.e1[c][lane] = p1[c] - p0[c];
+                    block.e2[c][lane] = p2[c] - p0[c];
+                }
+            }
+        }
+        return bvh;
+    }
+
+    // Heap bytes held by the tree and triangle blocks
+    size_t MemoryBytes() const {
+        return mTree.nodes.capacity() * sizeof(BvhNode) + mTree.leaves.capacity() * sizeof(BvhLeaf) +
+               mTree.order.capacity() * sizeof(uint32_t) + mBlocks.capacity() * sizeof(TriangleBlock);
+    }
+
+    // Nearest hit with t in [0, tMax); direction need not be unit length
+    bool Intersect(const float origin[3], const float direction[3], float tMax, MeshHit& hit) const {
+        BvhRay ray = BvhRay::Make(origin, direction);
+        const Float8 o[3] = { Float8::Broadcast(origin[0]), Float8::Broadcast(origin[1]), Float8::Broadcast(origin[2]) };
+        const Float8 d[3] = { Float8::Broadcast(direction[0]), Float8::Broadcast(direction[1]),
+                              Float8::Broadcast(direction[2]) };
+        bool found = false;
+
+        mTree.Traverse(ray, tMax, [&](uint32_t leaf, float& limit) {
+            // Moller-Trumbore on 8 triangles at once; padded lanes have det 0 and yield NaN
+            const TriangleBlock& block = mBlocks[leaf];
+            Float8 e1[3], e2[3], s[3];
+            for (int c = 0; c < 3; ++c) {
+                e1[c] = Float8::Load(block.e1[c]);
+                e2[c] = Float8::Load(block.e2[c]);
+                s[c] = o[c] - Float8::Load(block.v0[c]);
+            }
+            Float8 p[3], q[3];
+            Cross(d, e2, p);
+            Cross(s, e1, q);
+            Float8 inverseDet = Float8::Broadcast(1.0f) / Dot(e1, p);
+            Float8 u = Dot(s, p) * inverseDet;
+            Float8 v = Dot(d, q) * inverseDet;
+            Float8 t = Dot(e2, q) * inverseDet;
+
+            alignas(32) float uLanes[8], vLanes[8], tLanes[8];
+            u.Store(uLanes);
+            v.Store(vLanes);
+            t.Store(tLanes);
+            uint32_t count = mTree.leaves[leaf].count;
+            for (uint32_t lane = 0; lane < count; ++lane) {
+                if (uLanes[lane] >= 0.0f && vLanes[lane] >= 0.0f && uLanes[lane] + vLanes[lane] <= 1.0f &&
+                    tLanes[lane] >= 0.0f && tLanes[lane] < limit) {
+                    limit = tLanes[lane];
+                    hit.triangle = block.triangle[lane];
+                    hit.distance = tLanes[lane];
+                    hit.barycentric[0] = uLanes[lane];
+                    hit.barycentric[1] = vLanes[lane];
+                    found = true;
+                }
+            }
+        });
+        return found;
+    }
+
+    // True if any triangle may lie inside the frustum (object-space planes).
+    // Triangles are rejected only when one plane separates all three corners,
+    // so long slivers across a frustum corner can be accepted conservatively.
+    bool OverlapsFrustum(const PickFrustum& frustum) const {
+        if (mTree.nodes.empty()) {
+            return false;
+        }
+        std::vector<uint32_t> stack(1, 0u);
+        while (!stack.empty()) {
+            const BvhNode& node = mTree.nodes[stack.back()];
+            stack.pop_back();
+            int classes[BVH_WIDTH];
+            WideBvh::ClassifyChildren(node, frustum, classes);
+            for (uint32_t slot = 0; slot < BVH_WIDTH; ++slot) {
+                if (classes[slot] < 0) {
+                    continue;
+                }
+                uint32_t child = node.child[slot];
+                if (!(child & BVH_LEAF_BIT)) {
+                    if (classes[slot] > 0) {
+                        return true;
+                    }
+                    stack.push_back(child);
+                    continue;
+                }
+                uint32_t leaf = child & ~BVH_LEAF_BIT;
+                for (uint32_t lane = 0; lane < mTree.leaves[leaf].count; ++lane) {
+                    if (TriangleInFrustum(leaf, lane, frustum)) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    const BvhBounds& Bounds() const { return mTree.bounds; }
+    size_t TriangleCount() const { return mTree.order.size(); }
+
+private:
+    struct TriangleBlock {
+        alignas(32) float v0[3][8];
+        alignas(32) float e1[3][8];
+        alignas(32) float e2[3][8];
+        uint32_t triangle[8];
+    };
+
+    bool TriangleInFrustum(uint32_t leaf, uint32_t lane, const PickFrustum& frustum) const {
+        const TriangleBlock& block = mBlocks[leaf];
+        float corners[3][3];
+        for (int c = 0; c < 3; ++c) {
+            corners[0][c] = block.v0[c][lane];
+            corners[1][c] = block.v0[c][lane] + block.e1[c][lane];
+            corners[2][c] = block.v0[c][lane] + block.e2[c][lane];
+        }
+        for (const float* plane : frustum.planes) {
+            bool allOutside = true;
+            for (const float* corner : corners) {
+                if (plane[0] * corner[0] + plane[1] * corner[1] + plane[2] * corner[2] + plane[3] >= 0.0f) {
+                    allOutside = false;
+                    break;
+                }
+            }
+            if (allOutside) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static Float8 Dot(const Float8 a[3], const Float8 b[3]) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    static void Cross(const Float8 a[3], const Float8 b[3], Float8 out[3]) {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    WideBvh mTree;
+    std::vector<TriangleBlock> mBlocks;
+};
+
+// World-space pick result
+struct PickHit {
+    uint32_t instance = 0;
+    uint32_t triangle = 0;
+    float distance = INFINITY; // Along the pick ray's (non-normalized) direction
+    float position[3] = { 0.0f, 0.0f, 0.0f };
+    float barycentric[2] = { 0.0f, 0.0f };
+};
+
+// Scene TLAS over mesh instances. Adding or removing instances rebuilds it on the next
+// query; transform changes only refit the existing tree.
+class PickingScene {
+public:
+    PickingScene() = default;
+
+    uint32_t AddInstance(const std::string& objectId, std::shared_ptr<const MeshBvh> mesh, const Transform& transform) {
+        uint32_t id;
+        if (!mFreeInstances.empty()) {
+            id = mFreeInstances.back();
+            mFreeInstances.pop_back();
+        } else {
+            id = static_cast<uint32_t>(mInstances.size());
+            mInstances.emplace_back();
+        }
+        Instance& instance = mInstances[id];
+        instance.objectId = objectId;
+        instance.mesh = std::move(mesh);
+        instance.alive = true;
+        SetMatrices(instance, transform);
+        mNeedsRebuild = true;
+        return id;
+    }
+
+    void RemoveInstance(uint32_t id) {
+        // Guard: unknown or already removed
+        if (id >= mInstances.size() || !mInstances[id].alive) {
+            return;
+        }
+        mInstances[id] = Instance();
+        mFreeInstances.push_back(id);
+        mNeedsRebuild = true;
+    }
+
+    void SetTransform(uint32_t id, const Transform& transform) {
+        // Guard: unknown or removed
+        if (id >= mInstances.size() || !mInstances[id].alive) {
+            return;
+        }
+        SetMatrices(mInstances[id], transform);
+        mNeedsRefit = true;
+    }
+
+    const std::string& ObjectId(uint32_t id) const {
+        static const std::string empty;
+        return id < mInstances.size() ? mInstances[id].objectId : empty;
+    }
+
+    // Nearest triangle along the ray
+    bool Pick(const PickRay& ray, PickHit& hit) {
+        Update();
+        float tMax = INFINITY;
+        bool found = false;
+        BvhRay worldRay = BvhRay::Make(ray.origin, ray.direction);
+
+        mTopLevel.Traverse(worldRay, tMax, [&](uint32_t leaf, float& limit) {
+            const BvhLeaf& range = mTopLevel.leaves[leaf];
+            for (uint32_t i = 0; i < range.count; ++i) {
+                uint32_t id = mTopLevelIds[mTopLevel.order[range.first + i]];
+                const Instance& instance = mInstances[id];
+                float origin[3], direction[3];
+                TransformPoint(instance.objectFromWorld, ray.origin, origin);
+                TransformVector(instance.objectFromWorld, ray.direction, direction);
+
+                MeshHit meshHit;
+                if (instance.mesh->Intersect(origin, direction, limit, meshHit)) {
+                    limit = meshHit.distance;
+                    hit.instance = id;
+                    hit.triangle = meshHit.triangle;
+                    hit.distance = meshHit.distance;
+                    hit.barycentric[0] = meshHit.barycentric[0];
+                    hit.barycentric[1] = meshHit.barycentric[1];
+                    found = true;
+                }
+            }
+        });
+
+        if (found) {
+            for (int c = 0; c < 3; ++c) {
+                hit.position[c] = ray.origin[c] + ray.direction[c] * hit.distance;
+            }
+        }
+        return found;
+    }
+
+    // Instances with geometry inside the frustum (marquee selection), ascending ids
+    std::vector<uint32_t> QueryFrustum(const PickFrustum& frustum) {
+        Update();
+        std::vector<uint32_t> selected;
+        // Guard: empty scene
+        if (mTopLevel.nodes.empty()) {
+            return selected;
+        }
+
+        std::vector<uint32_t> stack(1, 0u);
+        while (!stack.empty()) {
+            const BvhNode& node = mTopLevel.nodes[stack.back()];
+            stack.pop_back();
+            int classes[BVH_WIDTH];
+            WideBvh::ClassifyChildren(node, frustum, classes);
+            for (uint32_t slot = 0; slot < BVH_WIDTH; ++slot) {
+                uint32_t child = node.child[slot];
+                if (classes[slot] < 0) {
+                    continue;
+                }
+                if (!(child & BVH_LEAF_BIT)) {
+                    stack.push_back(child);
+                    continue;
+                }
+                const BvhLeaf& range = mTopLevel.leaves[child & ~BVH_LEAF_BIT];
+                for (uint32_t i = 0; i < range.count; ++i) {
+                    uint32_t id = mTopLevelIds[mTopLevel.order[range.first + i]];
+                    if (InstanceInFrustum(mInstances[id], frustum)) {
+                        selected.push_back(id);
+                    }
+                }
+            }
+        }
+        std::sort(selected.begin(), selected.end());
+        return selected;
+    }
+
+    // Rebuild or refit now instead of on the next query
+    void Update() {
+        if (mNeedsRebuild) {
+            mTopLevelIds.clear();
+            for (uint32_t id = 0; id < mInstances.size(); ++id) {
+                if (mInstances[id].alive && !mInstances[id].mesh->Bounds().Empty()) {
+                    mTopLevelIds.push_back(id);
+                }
+            }
+            mTopLevel.Build(GatherBounds());
+        } else if (mNeedsRefit) {
+            mTopLevel.Refit(GatherBounds());
+        }
+        mNeedsRebuild = false;
+        mNeedsRefit = false;
+    }
+
+    // BLAS build, TLAS refit and picks against brute force
+    static void RegisterTests();
+    static void RegisterBenchmarks();
+
+    // Prevent copy/move
+    PickingScene(const PickingScene&) = delete;
+    PickingScene& operator=(const PickingScene&) = delete;
+    PickingScene(PickingScene&&) = delete;
+    PickingScene& operator=(PickingScene&&) = delete;
+
+private:
+    struct Instance {
+        std::string objectId;
+        std::shared_ptr<const MeshBvh> mesh;
+        float worldFromObject[12] = {};
+        float objectFromWorld[12] = {};
+        BvhBounds worldBounds;
+        bool alive = false;
+    };
+
+    // Row-major 3x4; T * Rz * Ry * Rx * S with Euler angles in degrees
+    static void SetMatrices(Instance& instance, const Transform& transform) {
+        const float toRadians = 3.14159265359f / 180.0f;
+        float cx = std::cos(transform.rotX * toRadians), sx = std::sin(transform.rotX * toRadians);
+        float cy = std::cos(transform.rotY * toRadians), sy = std::sin(transform.rotY * toRadians);
+        float cz = std::cos(transform.rotZ * toRadians), sz = std::sin(transform.rotZ * toRadians);
+        float rotation[3][3] = {
+            { cz * cy, cz * sy * sx - sz * cx, cz * sy * cx + sz * sx },
+            { sz * cy, sz * sy * sx + cz * cx, sz * sy * cx - cz * sx },
+            { -sy, cy * sx, cy * cx }
+        };
+        float scale[3] = { transform.scaleX, transform.scaleY, transform.scaleZ };
+        float translation[3] = { transform.posX, transform.posY, transform.posZ };
+
+        float* m = instance.worldFromObject;
+        float* inv = instance.objectFromWorld;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                m[r * 4 + c] = rotation[r][c] * scale[c];
+                // Inverse: S^-1 * R^T; zero scale collapses the instance instead of dividing by 0
+                float inverseScale = std::fabs(scale[r]) > 1e-12f ? 1.0f / scale[r] : 0.0f;
+                inv[r * 4 + c] = rotation[c][r] * inverseScale;
+            }
+            m[r * 4 + 3] = translation[r];
+        }
+        for (int r = 0; r < 3; ++r) {
+            inv[r * 4 + 3] = -(inv[r * 4 + 0] * translation[0] + inv[r * 4 + 1] * translation[1] +
+                               inv[r * 4 + 2] * translation[2]);
+        }
+
+        // World box of the transformed object box (all eight corners)
+        const BvhBounds& local = instance.mesh->Bounds();
+        instance.worldBounds = BvhBounds();
+        if (local.Empty()) {
+            return;
+        }
+        for (int corner = 0; corner < 8; ++corner) {
+            float p[3] = { (corner & 1) ? local.max[0] : local.min[0], (corner & 2) ? local.max[1] : local.min[1],
+                           (corner & 4) ? local.max[2] : local.min[2] };
+            float world[3];
+            TransformPoint(m, p, world);
+            instance.worldBounds.Grow(world);
+        }
+    }
+
+    static void TransformPoint(const float m[12], const float p[3], float out[3]) {
+        for (int r = 0; r < 3; ++r) {
+            out[r] = m[r * 4] * p[0] + m[r * 4 + 1] * p[1] + m[r * 4 + 2] * p[2] + m[r * 4 + 3];
+        }
+    }
+
+    static void TransformVector(const float m[12], const float v[3], float out[3]) {
+        for (int r = 0; r < 3; ++r) {
+            out[r] = m[r * 4] * v[0] + m[r * 4 + 1] * v[1] + m[r * 4 + 2] * v[2];
+        }
+    }
+
+    std::vector<BvhBounds> GatherBounds() const {
+        std::vector<BvhBounds> bounds;
+        bounds.reserve(mTopLevelIds.size());
+        for (uint32_t id : mTopLevelIds) {
+            bounds.push_back(mInstances[id].worldBounds);
+        }
+        return bounds;
+    }
+
+    // World box classification first; straddling instances test their BLAS with the
+    // planes pulled into object space (n' = A^T n, d' = n.t + d; sign-preserving)
+    static bool InstanceInFrustum(const Instance& instance, const PickFrustum& frustum) {
+        bool inside = true;
+        for (const float* plane : frustum.planes) {
+            float farthest = plane[3];
+            float nearest = plane[3];
+            for (int c = 0; c < 3; ++c) {
+                float low = instance.worldBounds.min[c] * plane[c];
+                float high = instance.worldBounds.max[c] * plane[c];
+                farthest += std::max(low, high);
+                nearest += std::min(low, high);
+            }
+            if (farthest < 0.0f) {
+                return false;
+            }
+            inside = inside && nearest >= 0.0f;
+        }
+        if (inside) {
+            return true;
+        }
+
+        PickFrustum local;
+        const float* m = instance.worldFromObject;
+        for (int p = 0; p < 6; ++p) {
+            const float* plane = frustum.planes[p];
+            for (int c = 0; c < 3; ++c) {
+                local.planes[p][c] = plane[0] * m[c] + plane[1] * m[4 + c] + plane[2] * m[8 + c];
+            }
+            local.planes[p][3] = plane[0] * m[3] + plane[1] * m[7] + plane[2] * m[11] + plane[3];
+        }
+        return instance.mesh->OverlapsFrustum(local);
+    }
+
+    std::vector<Instance> mInstances;
+    std::vector<uint32_t> mFreeInstances;
+    std::vector<uint32_t> mTopLevelIds; // TLAS primitive -> instance id
+    WideBvh mTopLevel;
+    bool mNeedsRebuild = false;
+    bool mNeedsRefit = false;
+};
+
+namespace PickingTestScene {
+
+// Random triangle soup in the unit cube; small triangles like a real dense mesh
+inline SoftwareMesh MakeSoup(size_t triangleCount, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> jitter(-0.08f, 0.08f);
+    SoftwareMesh mesh;
+    mesh.vertexStride = 3;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        float center[3] = { unit(rng), unit(rng), unit(rng) };
+        for (int corner = 0; corner < 3; ++corner) {
+            for (int c = 0; c < 3; ++c) {
+                mesh.vertices.push_back(center[c] + jitter(rng));
+            }
+            mesh.indices.push_back(static_cast<uint32_t>(t * 3 + corner));
+        }
+    }
+    return mesh;
+}
+
+// Heightfield grid of (side - 1)^2 * 2 triangles spanning [-1, 1] in x/z
+inline SoftwareMesh MakeTerrain(uint32_t side) {
+    SoftwareMesh mesh;
+    for (uint32_t z = 0; z < side; ++z) {
+        for (uint32_t x = 0; x < side; ++x) {
+            float u = 2.0f * x / (side - 1) - 1.0f;
+            float v = 2.0f * z / (side - 1) - 1.0f;
+            float vertex[SOFTWARE_MESH_STRIDE] = { u, 0.1f * std::sin(7.0f * u) * std::cos(5.0f * v), v,
+                                                   0.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+            mesh.vertices.insert(mesh.vertices.end(), vertex, vertex + SOFTWARE_MESH_STRIDE);
+        }
+    }
+    for (uint32_t z = 0; z + 1 < side; ++z) {
+        for (uint32_t x = 0; x + 1 < side; ++x) {
+            uint32_t i = z * side + x;
+            uint32_t quad[6] = { i, i + side, i + 1, i + 1, i + side, i + side + 1 };
+            mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+        }
+    }
+    return mesh;
+}
+
+// Reference: every triangle of every instance, no acceleration
+inline bool BruteForcePick(const std::vector<SoftwareMesh>& meshes, const std::vector<Transform>& transforms,
+                           const std::vector<uint32_t>& meshOf, const PickRay& ray, uint32_t& instance, float& distance) {
+    distance = INFINITY;
+    bool found = false;
+    for (size_t id = 0; id < transforms.size(); ++id) {
+        const SoftwareMesh& mesh = meshes[meshOf[id]];
+        // World-space triangles via the scene's own transform convention
+        const float toRadians = 3.14159265359f / 180.0f;
+        const Transform& t = transforms[id];
+        float cx = std::cos(t.rotX * toRadians), sx = std::sin(t.rotX * toRadians);
+        float cy = std::cos(t.rotY * toRadians), sy = std::sin(t.rotY * toRadians);
+        float cz = std::cos(t.rotZ * toRadians), sz = std::sin(t.rotZ * toRadians);
+        float r[3][3] = {
+            { cz * cy, cz * sy * sx - sz * cx, cz * sy * cx + sz * sx },
+            { sz * cy, sz * sy * sx + cz * cx, sz * sy * cx - cz * sx },
+            { -sy, cy * sx, cy * cx }
+        };
+        float s[3] = { t.scaleX, t.scaleY, t.scaleZ };
+        float p[3] = { t.posX, t.posY, t.posZ };
+        for (size_t tri = 0; tri < mesh.indices.size() / 3; ++tri) {
+            double v[3][3];
+            for (int corner = 0; corner < 3; ++corner) {
+                const float* local = &mesh.vertices[mesh.indices[tri * 3 + corner] * mesh.vertexStride];
+                for (int row = 0; row < 3; ++row) {
+                    v[corner][row] = r[row][0] * s[0] * local[0] + r[row][1] * s[1] * local[1] +
+                                     r[row][2] * s[2] * local[2] + p[row];
+                }
+            }
+            double e1[3], e2[3], o[3], d[3];
+            for (int c = 0; c < 3; ++c) {
+                e1[c] = v[1][c] - v[0][c];
+                e2[c] = v[2][c] - v[0][c];
+                o[c] = ray.origin[c] - v[0][c];
+                d[c] = ray.direction[c];
+            }
+            double pv[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+            double det = e1[0] * pv[0] + e1[1] * pv[1] + e1[2] * pv[2];
+            if (std::fabs(det) < 1e-14) {
+                continue;
+            }
+            double u = (o[0] * pv[0] + o[1] * pv[1] + o[2] * pv[2]) / det;
+            double qv[3] = { o[1] * e1[2] - o[2] * e1[1], o[2] * e1[0] - o[0] * e1[2], o[0] * e1[1] - o[1] * e1[0] };
+            double w = (d[0] * qv[0] + d[1] * qv[1] + d[2] * qv[2]) / det;
+            double hitT = (e2[0] * qv[0] + e2[1] * qv[1] + e2[2] * qv[2]) / det;
+            if (u >= 0.0 && w >= 0.0 && u + w <= 1.0 && hitT >= 0.0 && hitT < distance) {
+                distance = static_cast<float>(hitT);
+                instance = static_cast<uint32_t>(id);
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+} // namespace PickingTestScene
+
+inline void PickingScene::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("PickingBvh");
+
+    tests.AddTest("PickingBvh", "Picks match brute force before and after refit", []() {
+        std::vector<SoftwareMesh> meshes = { PickingTestScene::MakeSoup(1500, 1), PickingTestScene::MakeTerrain(30) };
+        std::vector<std::shared_ptr<const MeshBvh>> blas = { MeshBvh::Build(meshes[0]), MeshBvh::Build(meshes[1]) };
+
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> spread(-4.0f, 4.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+        std::uniform_real_distribution<float> size(1.0f, 2.5f);
+        auto randomTransform = [&]() {
+            Transform t;
+            t.posX = spread(rng);
+            t.posY = spread(rng) * 0.5f;
+            t.posZ = spread(rng);
+            t.rotX = angle(rng);
+            t.rotY = angle(rng);
+            t.rotZ = angle(rng);
+            t.scaleX = size(rng);
+            t.scaleY = size(rng);
+            t.scaleZ = size(rng);
+            return t;
+        };
+
+        PickingScene scene;
+        std::vector<Transform> transforms;
+        std::vector<uint32_t> meshOf;
+        for (uint32_t i = 0; i < 24; ++i) {
+            transforms.push_back(randomTransform());
+            meshOf.push_back(i % 2);
+            scene.AddInstance("object" + std::to_string(i), blas[i % 2], transforms.back());
+        }
+
+        CameraData camera;
+        camera.positionY = 4.0f;
+        camera.positionZ = 18.0f;
+        PickCamera view = PickCamera::FromCamera(camera, 320.0f, 200.0f);
+        std::uniform_int_distribution<uint32_t> anyInstance(0, 23);
+        std::uniform_real_distribution<float> jitter(-20.0f, 20.0f);
+
+        for (int pass = 0; pass < 2; ++pass) {
+            int hits = 0;
+            for (int i = 0; i < 150; ++i) {
+                // Aim near a random instance so most rays have something to find
+                const Transform& target = transforms[anyInstance(rng)];
+                float center[3] = { target.posX, target.posY, target.posZ };
+                float x = 0.0f, y = 0.0f;
+                view.Project(center, x, y);
+                PickRay ray = view.RayThrough(x + jitter(rng), y + jitter(rng));
+                PickHit hit;
+                uint32_t expectedInstance = 0;
+                float expectedDistance = 0.0f;
+                bool found = scene.Pick(ray, hit);
+                bool expected = PickingTestScene::BruteForcePick(meshes, transforms, meshOf, ray,
+                                                                 expectedInstance, expectedDistance);
+                if (found != expected) {
+                    return false;
+                }
+                if (found) {
+                    ++hits;
+                    if (std::fabs(hit.distance - expectedDistance) > 1e-3f * (1.0f + expectedDistance)) {
+                        return false;
+                    }
+                }
+            }
+            if (hits < 80) {
+                return false;
+            }
+
+            // Move everything: the TLAS is refit, not rebuilt
+            for (uint32_t id = 0; id < transforms.size(); ++id) {
+                transforms[id] = randomTransform();
+                scene.SetTransform(id, transforms[id]);
+            }
+        }
+        return true;
+    });
+
+    tests.AddTest("PickingBvh", "Marquee selects exactly the instances in view", []() {
+        // 10x10 grid of small terrain tiles viewed from above
+        auto tile = MeshBvh::Build(PickingTestScene::MakeTerrain(8));
+        PickingScene scene;
+        for (int z = 0; z < 10; ++z) {
+            for (int x = 0; x < 10; ++x) {
+                Transform t;
+                t.posX = (x - 4.5f) * 3.0f;
+                t.posZ = (z - 4.5f) * 3.0f;
+                scene.AddInstance("tile", tile, t);
+            }
+        }
+
+        CameraData camera;
+        camera.positionY = 40.0f;
+        camera.positionZ = 0.0f;
+        camera.upY = 0.0f;
+        camera.upZ = -1.0f;
+        PickCamera view = PickCamera::FromCamera(camera, 400.0f, 400.0f);
+
+        // A thin band in the gap between tile rows 4 and 5 selects nothing; a wider one
+        // reaching into both rows selects exactly those 20 tiles
+        float sx0, sy0, sx1, sy1;
+        float a[3] = { -100.0f, 0.0f, -0.3f };
+        float b[3] = { 100.0f, 0.0f, 0.3f };
+        view.Project(a, sx0, sy0);
+        view.Project(b, sx1, sy1);
+        if (!scene.QueryFrustum(view.FrustumFor(sx0, sy0, sx1, sy1)).empty()) {
+            return false;
+        }
+
+        float c[3] = { -100.0f, 0.0f, -2.0f };
+        float d[3] = { 100.0f, 0.0f, 2.0f };
+        view.Project(c, sx0, sy0);
+        view.Project(d, sx1, sy1);
+        std::vector<uint32_t> band = scene.QueryFrustum(view.FrustumFor(sx0, sy0, sx1, sy1));
+        if (band.size() != 20) {
+            return false;
+        }
+        for (uint32_t id : band) {
+            uint32_t row = id / 10;
+            if (row != 4 && row != 5) {
+                return false;
+            }
+        }
+
+        // Full screen sees all 100; dragging off-screen sees none
+        return scene.QueryFrustum(view.FrustumFor(0.0f, 0.0f, 400.0f, 400.0f)).size() == 100 &&
+               scene.QueryFrustum(view.FrustumFor(500.0f, 500.0f, 600.0f, 600.0f)).empty();
+    });
+}
+
+inline void PickingScene::RegisterBenchmarks() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    TestManagerNew::BenchmarkOptions options;
+    options.warmupIterations = 1;
+    options.sampleCount = 9;
+
+    TestManagerNew::BenchmarkOptions buildOptions;
+    buildOptions.warmupIterations = 0;
+    buildOptions.sampleCount = 3;
+
+    // 2M triangles as one terrain mesh instanced 16 times (32M triangles in the scene)
+    auto terrain = std::make_shared<SoftwareMesh>(PickingTestScene::MakeTerrain(1001));
+    tests.AddBenchmark("PickingBvh", "Build BLAS 2M triangles", [terrain]() {
+        auto bvh = MeshBvh::Build(*terrain);
+        TestManagerNew::DoNotOptimize(bvh.get());
+    }, buildOptions);
+
+    auto scene = std::make_shared<PickingScene>();
+    auto blas = MeshBvh::Build(*terrain);
+    for (int i = 0; i < 16; ++i) {
+        Transform t;
+        t.posX = (i % 4 - 1.5f) * 2.1f;
+        t.posZ = (i / 4 - 1.5f) * 2.1f;
+        t.rotY = i * 20.0f;
+        scene->AddInstance("terrain" + std::to_string(i), blas, t);
+    }
+    CameraData camera;
+    camera.positionY = 3.0f;
+    camera.positionZ = 7.0f;
+    auto view = std::make_shared<PickCamera>(PickCamera::FromCamera(camera, 1920.0f, 1080.0f));
+
+    tests.AddBenchmark("PickingBvh", "1000 picks, 32M triangle scene", [scene, view]() {
+        uint32_t x = 12345;
+        float total = 0.0f;
+        for (int i = 0; i < 1000; ++i) {
+            x = x * 1664525u + 1013904223u;
+            PickHit hit;
+            if (scene->Pick(view->RayThrough(static_cast<float>(x % 1920), static_cast<float>((x >> 11) % 1080)), hit)) {
+                total += hit.distance;
+            }
+        }
+        TestManagerNew::DoNotOptimize(total);
+    }, options);
+
+    tests.AddBenchmark("PickingBvh", "Refit TLAS + marquee", [scene, view]() {
+        static float angle = 0.0f;
+        angle += 1.0f;
+        Transform t;
+        t.rotY = angle;
+        scene->SetTransform(0, t);
+        std::vector<uint32_t> selected = scene->QueryFrustum(view->FrustumFor(600.0f, 300.0f, 1300.0f, 800.0f));
+        TestManagerNew::DoNotOptimize(selected.data());
+    }, options);
+}
+
+// Note on usage:
+// SoftwareRenderService builds a MeshBvh per mesh in LoadMesh(); the editor keeps one
+// PickingScene for placed objects and hands it to Viewport::SetPickingScene(). Viewport
+// turns right clicks into PickCamera::RayThrough() picks and right-drags into
+// FrustumFor() marquee queries.
@@ -0,0 +1,713 @@
+/** PngCodec - PNG reader and parallel PNG writer for TextureImage
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "TextureOps.h"
+#include "../core/Parallel.h"
+#include "../core/TestManagerNew.h"
+#include "../filesystem/Inflate.h"
+#include "../filesystem/Deflate.h"
+#include "../filesystem/MappedFile.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+// Per-row filter applied before compression; ADAPTIVE picks per row by the minimum
+// sum of absolute differences (the libpng heuristic)
+enum class PngFilter : uint8_t {
+    NONE = 0,
+    SUB = 1,
+    UP = 2,
+    AVERAGE = 3,
+    PAETH = 4,
+    ADAPTIVE = 5
+};
+
+struct PngWriteOptions {
+    BrightForge::DeflateLevel level;    // FAST for export passes, HIGH for shipping, STORE for scratch
+    PngFilter filter;
+    size_t workerCount;                 // 0 = hardware concurrency
+
+    PngWriteOptions() : level(BrightForge::DeflateLevel::FAST), filter(PngFilter::ADAPTIVE), workerCount(0) {}
+};
+
+// PngCodec - stateless entry points
+// Decode: chunks are CRC-checked and IDAT data inflated straight into the filtered row
+// buffer; unfiltering is sequential (UP/AVERAGE/PAETH read the previous row), the
+// conversion to 8-bit interleaved pixels runs in parallel row blocks.
+// Encode: rows filter in parallel (each needs only the unfiltered row above), the
+// stream deflates in independent slices (Deflate::CompressZlibParallel) and is written
+// as ~1 MiB IDAT chunks whose CRCs are computed in parallel.
+// Reads every non-interlaced color type and bit depth; writes 8-bit gray, gray + alpha,
+// RGB or RGBA according to the image's channel count.
+class PngCodec {
+public:
+    static bool Load(const std::string& path, TextureImage& outImage, std::string* error = nullptr,
+                     size_t workerCount = 0) {
+        BrightForge::MappedFile file;
+        if (!file.Open(path)) {
+            return Fail(error, file.GetError());
+        }
+        return Decode(file.Data(), file.Size(), outImage, error, workerCount);
+    }
+
+    static bool Decode(const uint8_t* data, size_t size, TextureImage& outImage, std::string* error = nullptr,
+                       size_t workerCount = 0) {
+        outImage = TextureImage();
+        if (data == nullptr || size < sizeof(SIGNATURE) || std::memcmp(data, SIGNATURE, sizeof(SIGNATURE)) != 0) {
+            return Fail(error, "not a PNG file (bad signature)");
+        }
+
+        Layout layout;
+        std::vector<uint8_t> compressed;
+        size_t offset = sizeof(SIGNATURE);
+        bool haveHeader = false;
+        bool ended = false;
+        while (!ended) {
+            if (size - offset < 12) {
+                return Fail(error, "PNG is truncated (no IEND chunk)");
+            }
+            uint32_t length = ReadU32(data + offset);
+            const uint8_t* type = data + offset + 4;
+            const uint8_t* body = type + 4;
+            if (length > size - offset - 12) {
+                return Fail(error, "PNG chunk " + std::string(reinterpret_cast<const char*>(type), 4) +
+                    " runs past the end of the file");
+            }
+            std::string name(reinterpret_cast<const char*>(type), 4);
+            if (Crc32(type, static_cast<size_t>(length) + 4) != ReadU32(body + length)) {
+                return Fail(error, "PNG chunk " + name + " fails its CRC");
+            }
+            offset += static_cast<size_t>(length) + 12;
+
+            if (name == "IHDR") {
+                if (haveHeader || length != 13) {
+                    return Fail(error, "PNG IHDR chunk is malformed");
+                }
+                if (!ParseHeader(body, layout, error)) {
+                    return false;
+                }
+                haveHeader = true;
+            } else if (!haveHeader) {
+                return Fail(error, "PNG does not start with an IHDR chunk");
+            } else if (name == "PLTE") {
+                if (length % 3 != 0 || length == 0 || length > 256 * 3 || !compressed.empty()) {
+                    return Fail(error, "PNG PLTE chunk is malformed");
+                }
+                layout.paletteSize = length / 3;
+                for (uint32_t i = 0; i < layout.paletteSize; ++i) {
+                    std::memcpy(&layout.palette[i * 4], body + i * 3, 3);
+                }
+            } else if (name == "tRNS") {
+                if (!ParseTransparency(body, length, layout)) {
+                    return Fail(error, "PNG tRNS chunk is malformed");
+                }
+            } else if (name == "IDAT") {
+                compressed.insert(compressed.end(), body, body + length);
+            } else if (name == "IEND") {
+                ended = true;
+            } else if ((type[0] & 0x20) == 0) {
+                return Fail(error, "PNG uses unsupported critical chunk " + name);
+            }
+        }
+        if (layout.colorType == COLOR_PALETTE && layout.paletteSize == 0) {
+            return Fail(error, "palette PNG has no PLTE chunk");
+        }
+
+        // Filtered rows: one filter byte + stride bytes each
+        size_t rowBytes = layout.stride + 1;
+        std::vector<uint8_t> rows(rowBytes * layout.height);
+        size_t written = 0;
+        if (!BrightForge::Inflate::DecompressZlib(compressed.data(), compressed.size(), rows.data(), rows.size(),
+                                                  &written) || written != rows.size()) {
+            return Fail(error, "PNG image data is corrupt or truncated");
+        }
+        for (uint32_t y = 0; y < layout.height; ++y) {
+            uint8_t* row = rows.data() + y * rowBytes;
+            if (row[0] > static_cast<uint8_t>(PngFilter::PAETH)) {
+                return Fail(error, "PNG row " + std::to_string(y) + " has unknown filter " + std::to_string(row[0]));
+            }
+            Unfilter(row[0], row + 1, y > 0 ? row + 1 - rowBytes : nullptr, layout.stride, layout.filterStep);
+        }
+
+        TextureImage image;
+        image.width = layout.width;
+        image.height = layout.height;
+        image.channels = layout.outputChannels;
+        image.pixels.resize(image.PixelCount() * image.channels);
+        size_t outStride = static_cast<size_t>(image.width) * image.channels;
+        Parallel::ForRange(layout.height, ROWS_PER_TASK, [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y) {
+                ConvertRow(layout, rows.data() + y * rowBytes + 1, image.pixels.data() + y * outStride);
+            }
+        }, workerCount);
+        outImage = std::move(image);
+        return true;
+    }
+
+    static bool Encode(const TextureImage& image, std::vector<uint8_t>& out,
+                       const PngWriteOptions& options = PngWriteOptions(), std::string* error = nullptr) {
+        if (!image.IsValid()) {
+            return Fail(error, "texture is empty or malformed");
+        }
+
+        size_t stride = static_cast<size_t>(image.width) * image.channels;
+        size_t rowBytes = stride + 1;
+        std::vector<uint8_t> rows(rowBytes * image.height);
+        Parallel::ForRange(image.height, ROWS_PER_TASK, [&](size_t begin, size_t end) {
+            std::vector<uint8_t> scratch(options.filter == PngFilter::ADAPTIVE ? stride : 0);
+            for (size_t y = begin; y < end; ++y) {
+                const uint8_t* current = image.pixels.data() + y * stride;
+                const uint8_t* previous = y > 0 ? current - stride : nullptr;
+                uint8_t* target = rows.data() + y * rowBytes;
+                if (options.filter != PngFilter::ADAPTIVE) {
+                    target[0] = static_cast<uint8_t>(options.filter);
+                    Filter(target[0], current, previous, stride, image.channels, target + 1);
+                    continue;
+                }
+
+                uint64_t best = UINT64_MAX;
+                for (uint8_t filter = 0; filter <= static_cast<uint8_t>(PngFilter::PAETH); ++filter) {
+                    Filter(filter, current, previous, stride, image.channels, scratch.data());
+                    uint64_t cost = FilterCost(scratch.data(), stride, best);
+                    if (cost < best) {
+                        best = cost;
+                        target[0] = filter;
+                        std::memcpy(target + 1, scratch.data(), stride);
+                    }
+                }
+            }
+        }, options.workerCount);
+
+        std::vector<uint8_t> stream;
+        BrightForge::Deflate::CompressZlibParallel(rows.data(), rows.size(), stream, options.level, options.workerCount);
+        rows = std::vector<uint8_t>();
+
+        size_t chunkCount = (stream.size() + IDAT_CHUNK - 1) / IDAT_CHUNK;
+        std::vector<uint32_t> crcs(chunkCount);
+        Parallel::For(chunkCount, [&](size_t c) {
+            size_t size = std::min(IDAT_CHUNK, stream.size() - c * IDAT_CHUNK);
+            crcs[c] = Crc32(stream.data() + c * IDAT_CHUNK, size, Crc32(IDAT_TYPE, 4));
+        }, options.workerCount);
+
+        static const uint8_t COLOR_TYPES[5] = { 0, 0, 4, 2, 6 };
+        uint8_t header[13];
+        WriteU32(header, image.width);
+        WriteU32(header + 4, image.height);
+        header[8] = 8;
+        header[9] = COLOR_TYPES[image.channels];
+        header[10] = header[11] = header[12] = 0;
+
+        out.clear();
+        out.reserve(sizeof(SIGNATURE) + 25 + stream.size() + chunkCount * 12 + 12);
+        out.insert(out.end(), SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+        AppendChunk(out, "IHDR", header, sizeof(header), Crc32(header, sizeof(header), Crc32(IHDR_TYPE, 4)));
+        for (size_t c = 0; c < chunkCount; ++c) {
+            size_t size = std::min(IDAT_CHUNK, stream.size() - c * IDAT_CHUNK);
+            AppendChunk(out, "IDAT", stream.data() + c * IDAT_CHUNK, size, crcs[c]);
+        }
+        AppendChunk(out, "IEND", nullptr, 0, Crc32(IEND_TYPE, 4));
+        return true;
+    }
+
+    static bool Save(const TextureImage& image, const std::string& path,
+                     const PngWriteOptions& options = PngWriteOptions(), std::string* error = nullptr) {
+        std::vector<uint8_t> bytes;
+        if (!Encode(image, bytes, options, error)) {
+            return false;
+        }
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return Fail(error, "cannot write " + path);
+        }
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return out.good() ? true : Fail(error, "failed writing " + path);
+    }
+
+    // CRC-32 (IEEE 802.3, reflected 0xEDB88320) as PNG chunks use it, slice-by-8.
+    // Pass a previous result as `crc` to continue it over more bytes.
+    static uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+        const CrcTables& tables = GetCrcTables();
+        uint32_t state = ~crc;
+        while (size >= 8) {
+            uint32_t low;
+            uint32_t high;
+            std::memcpy(&low, data, 4);
+            std::memcpy(&high, data + 4, 4);
+            low ^= state;
+            state = tables.t[7][low & 0xFF] ^ tables.t[6][(low >> 8) & 0xFF] ^
+                    tables.t[5][(low >> 16) & 0xFF] ^ tables.t[4][low >> 24] ^
+                    tables.t[3][high & 0xFF] ^ tables.t[2][(high >> 8) & 0xFF] ^
+                    tables.t[1][(high >> 16) & 0xFF] ^ tables.t[0][high >> 24];
+            data += 8;
+            size -= 8;
+        }
+        while (size-- > 0) {
+            state = tables.t[0][(state ^ *data++) & 0xFF] ^ (state >> 8);
+        }
+        return ~state;
+    }
+
+    // Round trips over every layout, filter and level; foreign-encoder features; corruption
+    static void RegisterTests();
+    // Encode/decode an edge x edge RGBA texture at each level
+    static void RegisterBenchmarks(uint32_t edge = 2048);
+
+    // Prevent instantiation (static API)
+    PngCodec() = delete;
+
+private:
+    static constexpr uint8_t SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    static constexpr uint8_t IHDR_TYPE[4] = { 'I', 'H', 'D', 'R' };
+    static constexpr uint8_t IDAT_TYPE[4] = { 'I', 'D', 'A', 'T' };
+    static constexpr uint8_t IEND_TYPE[4] = { 'I', 'E', 'N', 'D' };
+    static constexpr size_t ROWS_PER_TASK = 32;
+    static constexpr size_t IDAT_CHUNK = 1u << 20;
+    static constexpr uint32_t MAX_DIMENSION = 1u << 16;
+    static constexpr uint64_t MAX_PIXELS = 1ull << 28;       // 256 MP; larger headers are treated as hostile
+
+    static constexpr uint8_t COLOR_GRAY = 0;
+    static constexpr uint8_t COLOR_RGB = 2;
+    static constexpr uint8_t COLOR_PALETTE = 3;
+    static constexpr uint8_t COLOR_GRAY_ALPHA = 4;
+    static constexpr uint8_t COLOR_RGBA = 6;
+
+    // Everything row conversion needs, filled from IHDR / PLTE / tRNS
+    struct Layout {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint8_t bitDepth = 0;
+        uint8_t colorType = 0;
+        uint32_t samples = 0;           // Samples per pixel in the file (a palette index is one)
+        size_t stride = 0;              // Bytes per unfiltered row
+        uint32_t filterStep = 0;        // Bytes per complete pixel, minimum 1 (the filters' "bpp")
+        uint32_t outputChannels = 0;
+        uint32_t paletteSize = 0;
+        uint8_t palette[256 * 4] = {};  // RGBA; entries past paletteSize stay opaque black
+        bool hasKey = false;            // tRNS color key on gray / RGB images
+        uint16_t key[3] = {};
+    };
+
+    struct CrcTables {
+        uint32_t t[8][256];
+
+        CrcTables() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0);
+                }
+                t[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (int slice = 1; slice < 8; ++slice) {
+                    t[slice][i] = (t[slice - 1][i] >> 8) ^ t[0][t[slice - 1][i] & 0xFF];
+                }
+            }
+        }
+    };
+
+    static const CrcTables& GetCrcTables() {
+        static const CrcTables tables;
+        return tables;
+    }
+
+    static bool Fail(std::string* error, const std::string& message) {
+        if (error != nullptr) {
+            *error = message;
+        }
+        return false;
+    }
+
+    static uint32_t ReadU32(const uint8_t* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | p[3];
+    }
+
+    static void WriteU32(uint8_t* p, uint32_t value) {
+        p[0] = static_cast<uint8_t>(value >> 24);
+        p[1] = static_cast<uint8_t>(value >> 16);
+        p[2] = static_cast<uint8_t>(value >> 8);
+        p[3] = static_cast<uint8_t>(value);
+    }
+
+    static void AppendChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* body, size_t size,
+                            uint32_t crc) {
+        uint8_t word[4];
+        WriteU32(word, static_cast<uint32_t>(size));
+        out.insert(out.end(), word, word + 4);
+        out.insert(out.end(), type, type + 4);
+        if (size > 0) {
+            out.insert(out.end(), body, body + size);
+        }
+        WriteU32(word, crc);
+        out.insert(out.end(), word, word + 4);
+    }
+
+    static bool ParseHeader(const uint8_t* body, Layout& layout, std::string* error) {
+        layout.width = ReadU32(body);
+        layout.height = ReadU32(body + 4);
+        layout.bitDepth = body[8];
+        layout.colorType = body[9];
+        if (layout.width == 0 || layout.height == 0 || layout.width > MAX_DIMENSION ||
+            layout.height > MAX_DIMENSION || static_cast<uint64_t>(layout.width) * layout.height > MAX_PIXELS) {
+            return Fail(error, "PNG size " + std::to_string(layout.width) + "x" + std::to_string(layout.height) +
+                " is out of range");
+        }
+        if (body[10] != 0 || body[11] != 0) {
+            return Fail(error, "PNG uses an unknown compression or filter method");
+        }
+        if (body[12] != 0) {
+            return Fail(error, "interlaced PNGs are not supported");
+        }
+
+        uint8_t depth = layout.bitDepth;
+        bool wide = depth == 8 || depth == 16;
+        bool valid = false;
+        switch (layout.colorType) {
+            case COLOR_GRAY:       layout.samples = 1; valid = wide || depth == 1 || depth == 2 || depth == 4; break;
+            case COLOR_RGB:        layout.samples = 3; valid = wide; break;
+            case COLOR_PALETTE:    layout.samples = 1; valid = depth == 8 || depth == 1 || depth == 2 || depth == 4; break;
+            case COLOR_GRAY_ALPHA: layout.samples = 2; valid = wide; break;
+            case COLOR_RGBA:       layout.samples = 4; valid = wide; break;
+            default: break;
+        }
+        if (!valid) {
+            return Fail(error, "PNG color type " + std::to_string(layout.colorType) + " with bit depth " +
+                std::to_string(depth) + " is invalid");
+        }
+
+        size_t bitsPerPixel = static_cast<size_t>(layout.samples) * depth;
+        layout.stride = (static_cast<size_t>(layout.width) * bitsPerPixel + 7) / 8;
+        layout.filterStep = static_cast<uint32_t>(std::max<size_t>(1, bitsPerPixel / 8));
+        layout.outputChannels = layout.colorType == COLOR_PALETTE ? 3 : layout.samples;
+        for (uint32_t i = 0; i < 256; ++i) {
+            layout.palette[i * 4 + 3] = 255;
+        }
+        return true;
+    }
+
+    static bool ParseTransparency(const uint8_t* body, uint32_t length, Layout& layout) {
+        switch (layout.colorType) {
+            case COLOR_PALETTE:
+                if (layout.paletteSize == 0 || length > layout.paletteSize) {
+                    return false;
+                }
+                for (uint32_t i = 0; i < length; ++i) {
+                    layout.palette[i * 4 + 3] = body[i];
+                }
+                layout.outputChannels = 4;
+                return true;
+            case COLOR_GRAY:
+            case COLOR_RGB:
+                if (length != layout.samples * 2) {
+                    return false;
+                }
+                for (uint32_t s = 0; s < layout.samples; ++s) {
+                    layout.key[s] = static_cast<uint16_t>((body[s * 2] << 8) | body[s * 2 + 1]);
+                }
+                layout.hasKey = true;
+                layout.outputChannels = layout.samples + 1;
+                return true;
+            default:
+                return false;   // Alpha color types cannot carry tRNS
+        }
+    }
+
+    static uint8_t Paeth(int left, int up, int upLeft) {
+        int estimate = left + up - upLeft;
+        int dl = std::abs(estimate - left);
+        int du = std::abs(estimate - up);
+        int dul = std::abs(estimate - upLeft);
+        return static_cast<uint8_t>(dl <= du && dl <= dul ? left : du <= dul ? up : upLeft);
+    }
+
+    // PNG filter `filter` of `current` into `out`; previous is null on the first row
+    static void Filter(uint8_t filter, const uint8_t* current, const uint8_t* previous, size_t size, uint32_t step,
+                       uint8_t* out) {
+        for (size_t i = 0; i < size; ++i) {
+            int left = i >= step ? current[i - step] : 0;
+            int up = previous != nullptr ? previous[i] : 0;
+            int upLeft = previous != nullptr && i >= step ? previous[i - step] : 0;
+            int predicted = 0;
+            switch (static_cast<PngFilter>(filter)) {
+                case PngFilter::SUB:     predicted = left; break;
+                case PngFilter::UP:      predicted = up; break;
+                case PngFilter::AVERAGE: predicted = (left + up) >> 1; break;
+                case PngFilter::PAETH:   predicted = Paeth(left, up, upLeft); break;
+                default: break;
+            }
+            out[i] = static_cast<uint8_t>(current[i] - predicted);
+        }
+    }
+
+    // Inverse of Filter(), in place; `previous` is the already unfiltered row above
+    static void Unfilter(uint8_t filter, uint8_t* current, const uint8_t* previous, size_t size, uint32_t step) {
+        switch (static_cast<PngFilter>(filter)) {
+            case PngFilter::SUB:
+                for (size_t i = step; i < size; ++i) {
+                    current[i] = static_cast<uint8_t>(current[i] + current[i - step]);
+                }
+                break;
+            case PngFilter::UP:
+                for (size_t i = 0; previous != nullptr && i < size; ++i) {
+                    current[i] = static_cast<uint8_t>(current[i] + previous[i]);
+                }
+                break;
+            case PngFilter::AVERAGE:
+                for (size_t i = 0; i < size; ++i) {
+                    int left = i >= step ? current[i - step] : 0;
+                    int up = previous != nullptr ? previous[i] : 0;
+                    current[i] = static_cast<uint8_t>(current[i] + ((left + up) >> 1));
+                }
+                break;
+            case PngFilter::PAETH:
+                for (size_t i = 0; i < size; ++i) {
+                    int left = i >= step ? current[i - step] : 0;
+                    int up = previous != nullptr ? previous[i] : 0;
+                    int upLeft = previous != nullptr && i >= step ? previous[i - step] : 0;
+                    current[i] = static_cast<uint8_t>(current[i] + Paeth(left, up, upLeft));
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Sum of |signed residual|, stopping once it can no longer beat `limit`
+    static uint64_t FilterCost(const uint8_t* row, size_t size, uint64_t limit) {
+        uint64_t cost = 0;
+        for (size_t i = 0; i < size; ++i) {
+            cost += static_cast<uint64_t>(std::abs(static_cast<int>(static_cast<int8_t>(row[i]))));
+            if ((i & 255) == 255 && cost >= limit) {
+                return cost;
+            }
+        }
+        return cost;
+    }
+
+    static uint32_t Sample(const uint8_t* row, size_t index, uint8_t depth) {
+        if (depth == 8) {
+            return row[index];
+        }
+        if (depth == 16) {
+            return (static_cast<uint32_t>(row[index * 2]) << 8) | row[index * 2 + 1];
+        }
+        size_t bit = index * depth;
+        uint32_t shift = static_cast<uint32_t>(8 - depth - (bit & 7));
+        return (row[bit >> 3] >> shift) & ((1u << depth) - 1);
+    }
+
+    // One unfiltered row to 8-bit interleaved output (16-bit keeps the high byte,
+    // low-depth gray scales to 0-255, palettes expand, color keys become alpha)
+    static void ConvertRow(const Layout& layout, const uint8_t* in, uint8_t* out) {
+        if (layout.bitDepth == 8 && layout.colorType != COLOR_PALETTE && !layout.hasKey) {
+            std::memcpy(out, in, layout.stride);
+            return;
+        }
+
+        uint8_t depth = layout.bitDepth;
+        uint32_t scale = depth < 8 ? 255 / ((1u << depth) - 1) : 1;
+        for (uint32_t x = 0; x < layout.width; ++x) {
+            uint8_t* pixel = out + static_cast<size_t>(x) * layout.outputChannels;
+            if (layout.colorType == COLOR_PALETTE) {
+                std::memcpy(pixel, &layout.palette[Sample(in, x, depth) * 4], layout.outputChannels);
+                continue;
+            }
+
+            bool keyed = layout.hasKey;
+            for (uint32_t s = 0; s < layout.samples; ++s) {
+                uint32_t value = Sample(in, static_cast<size_t>(x) * layout.samples + s, depth);
+                keyed = keyed && value == layout.key[s];
+                pixel[s] = static_cast<uint8_t>(depth == 16 ? value >> 8 : value * scale);
+            }
+            if (layout.hasKey) {
+                pixel[layout.samples] = keyed ? 0 : 255;
+            }
+        }
+    }
+};
+
+inline void PngCodec::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("PngCodec");
+
+    auto makeImage = [](uint32_t width, uint32_t height, uint32_t channels) {
+        TextureImage image;
+        image.width = width;
+        image.height = height;
+        image.channels = channels;
+        image.pixels.resize(image.PixelCount() * channels);
+        for (size_t i = 0; i < image.pixels.size(); ++i) {
+            // Gradients plus noise so every filter wins somewhere
+            size_t pixel = i / channels;
+            image.pixels[i] = static_cast<uint8_t>((pixel % width) * 3 + (pixel / width) + ((i * 2654435761u) >> 29));
+        }
+        return image;
+    };
+
+    tests.AddTest("PngCodec", "Round trip every layout, filter and level", [makeImage]() {
+        const PngFilter filters[] = { PngFilter::NONE, PngFilter::SUB, PngFilter::UP, PngFilter::AVERAGE,
+                                      PngFilter::PAETH, PngFilter::ADAPTIVE };
+        const BrightForge::DeflateLevel levels[] = { BrightForge::DeflateLevel::FAST, BrightForge::DeflateLevel::HIGH,
+                                                     BrightForge::DeflateLevel::STORE };
+        for (uint32_t channels = 1; channels <= 4; ++channels) {
+            TextureImage image = makeImage(37, 13, channels);
+            for (PngFilter filter : filters) {
+                for (BrightForge::DeflateLevel level : levels) {
+                    PngWriteOptions options;
+                    options.filter = filter;
+                    options.level = level;
+                    std::vector<uint8_t> file;
+                    TextureImage decoded;
+                    if (!Encode(image, file, options) || !Decode(file.data(), file.size(), decoded) ||
+                        decoded.channels != channels || decoded.width != 37 || decoded.pixels != image.pixels) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    });
+
+    tests.AddTest("PngCodec", "Multi-slice stream decodes and matches serial deflate", [makeImage]() {
+        // ~720 KB of filtered rows: three parallel deflate slices
+        TextureImage image = makeImage(600, 400, 3);
+        std::vector<uint8_t> file;
+        TextureImage decoded;
+        if (!Encode(image, file) || !Decode(file.data(), file.size(), decoded, nullptr, 3) ||
+            decoded.pixels != image.pixels) {
+            return false;
+        }
+
+        // The joined stream's Adler-32 is the combined one Inflate verifies
+        std::vector<uint8_t> parallel;
+        std::vector<uint8_t> restored(image.pixels.size());
+        size_t written = 0;
+        BrightForge::Deflate::CompressZlibParallel(image.pixels.data(), image.pixels.size(), parallel);
+        return BrightForge::Inflate::DecompressZlib(parallel.data(), parallel.size(), restored.data(),
+                                                    restored.size(), &written) &&
+               written == restored.size() && restored == image.pixels;
+    });
+
+    tests.AddTest("PngCodec", "Decodes palette, low bit depth and 16-bit files", []() {
+        // Hand-built files: 4-bit palette with tRNS, 2-bit gray, 16-bit RGB with a color key
+        auto build = [](uint32_t width, uint32_t height, uint8_t depth, uint8_t colorType,
+                        const std::vector<std::pair<std::string, std::vector<uint8_t>>>& extra,
+                        const std::vector<uint8_t>& rows) {
+            std::vector<uint8_t> file(SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+            uint8_t header[13] = {};
+            WriteU32(header, width);
+            WriteU32(header + 4, height);
+            header[8] = depth;
+            header[9] = colorType;
+            auto chunk = [&file](const char* type, const uint8_t* body, size_t size) {
+                std::vector<uint8_t> typed(type, type + 4);
+                typed.insert(typed.end(), body, body + size);
+                AppendChunk(file, type, body, size, Crc32(typed.data(), typed.size()));
+            };
+            chunk("IHDR", header, sizeof(header));
+            for (const auto& item : extra) {
+                chunk(item.first.c_str(), item.second.data(), item.second.size());
+            }
+            std::vector<uint8_t> stream;
+            BrightForge::Deflate::CompressZlib(rows.data(), rows.size(), stream);
+            chunk("IDAT", stream.data(), stream.size());
+            chunk("IEND", nullptr, 0);
+            return file;
+        };
+
+        // 3x2 palette image, 4 bits per index: row 0 = 0,1,2 (SUB filtered), row 1 = 2,1,0 (UP filtered)
+        std::vector<uint8_t> palette = { 255, 0, 0, 0, 255, 0, 0, 0, 255 };
+        std::vector<uint8_t> alpha = { 128 };
+        std::vector<uint8_t> rows = { 1, 0x01, 0x1F, 2, 0x20, 0xE0 };
+        std::vector<uint8_t> file = build(3, 2, 4, COLOR_PALETTE, { { "PLTE", palette }, { "tRNS", alpha } }, rows);
+        TextureImage image;
+        if (!Decode(file.data(), file.size(), image) || image.channels != 4 ||
+            image.pixels != std::vector<uint8_t>({ 255, 0, 0, 128, 0, 255, 0, 255, 0, 0, 255, 255,
+                                                   0, 0, 255, 255, 0, 255, 0, 255, 255, 0, 0, 128 })) {
+            return false;
+        }
+
+        // 5x1 2-bit gray: 0,1,2,3,0 -> 0,85,170,255,0
+        file = build(5, 1, 2, COLOR_GRAY, {}, { 0, 0x1B, 0x00 });
+        if (!Decode(file.data(), file.size(), image) || image.channels != 1 ||
+            image.pixels != std::vector<uint8_t>({ 0, 85, 170, 255, 0 })) {
+            return false;
+        }
+
+        // 2x1 16-bit RGB, second pixel matches the tRNS key
+        std::vector<uint8_t> key = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC };
+        file = build(2, 1, 16, COLOR_RGB, { { "tRNS", key } },
+                     { 0, 0xFF, 0x00, 0x80, 0x01, 0x00, 0xFF, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC });
+        return Decode(file.data(), file.size(), image) && image.channels == 4 &&
+               image.pixels == std::vector<uint8_t>({ 0xFF, 0x80, 0x00, 255, 0x12, 0x56, 0x9A, 0 });
+    });
+
+    tests.AddTest("PngCodec", "Rejects corrupt files", [makeImage]() {
+        TextureImage image = makeImage(64, 64, 4);
+        std::vector<uint8_t> file;
+        TextureImage decoded;
+        std::string error;
+        if (!Encode(image, file)) {
+            return false;
+        }
+
+        std::vector<uint8_t> flipped = file;
+        flipped[flipped.size() / 2] ^= 0x40;
+        std::vector<uint8_t> truncated(file.begin(), file.begin() + static_cast<std::ptrdiff_t>(file.size() - 20));
+        std::vector<uint8_t> interlaced = file;
+        interlaced[8 + 8 + 12] = 1;
+        WriteU32(&interlaced[8 + 8 + 13], Crc32(&interlaced[8 + 4], 17));
+        return !Decode(flipped.data(), flipped.size(), decoded, &error) && error.find("CRC") != std::string::npos &&
+               !Decode(truncated.data(), truncated.size(), decoded) &&
+               !Decode(interlaced.data(), interlaced.size(), decoded, &error) &&
+               error.find("interlaced") != std::string::npos && !Decode(file.data(), 7, decoded);
+    });
+}
+
+inline void PngCodec::RegisterBenchmarks(uint32_t edge) {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    static TextureImage image;
+    static std::vector<uint8_t> encoded;
+    image.width = image.height = edge;
+    image.channels = 4;
+    image.pixels.resize(image.PixelCount() * 4);
+    for (size_t i = 0; i < image.pixels.size(); ++i) {
+        size_t pixel = i / 4;
+        image.pixels[i] = static_cast<uint8_t>((pixel % edge) / 4 + (pixel / edge) / 3 + ((i * 2654435761u) >> 30));
+    }
+    Encode(image, encoded);
+
+    std::string size = std::to_string(edge) + "x" + std::to_string(edge);
+    tests.AddBenchmark("PngCodec", "Encode RGBA " + size + " (fast)", []() {
+        std::vector<uint8_t> out;
+        Encode(image, out);
+        TestManagerNew::DoNotOptimize(out.size());
+    });
+    tests.AddBenchmark("PngCodec", "Encode RGBA " + size + " (high)", []() {
+        PngWriteOptions options;
+        options.level = BrightForge::DeflateLevel::HIGH;
+        std::vector<uint8_t> out;
+        Encode(image, out, options);
+        TestManagerNew::DoNotOptimize(out.size());
+    });
+    tests.AddBenchmark("PngCodec", "Decode RGBA " + size, []() {
+        TextureImage decoded;
+        Decode(encoded.data(), encoded.size(), decoded);
+        TestManagerNew::DoNotOptimize(decoded.pixels.data());
+    });
+}
+
+// Note on usage:
+// PngCodec::Load / Save move textures in and out of TextureOps; tools/bf-texture.cpp is
+// the batch front end the Python exporter calls. Encoded files are plain zlib PNGs any
+// viewer reads.
@@ -8,17 +8,33 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <array>
+#include <cstdint>
 #include "../core/QuoteSystem.h"
+#include "../core/JsonBinding.h"
+
+struct RenderConfig;
+
+// Subsystems that must react when a RenderConfig field changes
+// Combined as a bitmask so a hot reload rebuilds only what actually changed
+enum ConfigChangeFlags : uint32_t {
+    CONFIG_CHANGE_NONE       = 0,
+    CONFIG_CHANGE_SWAPCHAIN  = 1u << 0, // window size, fullscreen, vsync
+    CONFIG_CHANGE_PIPELINES  = 1u << 1, // raster state, MSAA, depth mode, debug views
+    CONFIG_CHANGE_LIGHTING   = 1u << 2, // lighting uniforms only
+    CONFIG_CHANGE_CAMERA     = 1u << 3, // projection and camera controls
+    CONFIG_CHANGE_CLEAR      = 1u << 4, // clear color
+    CONFIG_CHANGE_ENVIRONMENT = 1u << 5, // IBL source (.hdr), re-fetched through IblCache
+    CONFIG_CHANGE_RESIDENCY  = 1u << 6  // asset residency budgets (ResidencyManager)
+};
 
-// Forward declaration for JSON parsing - would normally use a library like nlohmann/json
-// For now we use simple key-value parsing
+// JSON I/O goes through the shared single-pass tokenizer in JsonBinding.h
+// The field table below RenderConfig is the only place keys are listed
 namespace RenderConfigIO {
     std::string LoadFileToString(const std::string& path);
     void SaveStringToFile(const std::string& path, const std::string& content);
-    std::string ExtractValue(const std::string& json, const std::string& key);
-    int ParseInt(const std::string& value);
-    float ParseFloat(const std::string& value);
-    bool ParseBool(const std::string& value);
+    bool ParseJson(const std::string& json, RenderConfig& outConfig, std::string& outError);
+    std::string WriteJson(const RenderConfig& config);
 }
 
 struct RenderConfig {
@@ -32,9 +48,17 @@ struct RenderConfig {
     bool enableVSync = true;
     float renderScale = 1.0f;
 
+    // Dynamic resolution: scale the internal render size per frame to hold the target
+    // render time, within [minRenderScale, maxRenderScale] (see DynamicResolution.h)
+    bool dynamicResolution = false;
+    float targetFrameTimeMs = 16.6f;
+    float minRenderScale = 0.5f;
+    float maxRenderScale = 1.0f;
+
     // Lighting configuration
     float ambientIntensity = 0.3f;
     float sunIntensity = 1.0f;
+    std::string environmentMap = ""; // Equirect .hdr for IBL; empty disables it
 
     // Debug visualization
     bool wireframeMode = false;
@@ -53,6 +77,10 @@ struct RenderConfig {
     // Clear color
     std::string clearColorHex = "#800000";
 
+    // Residency budgets in MB; least recently used assets are demoted past these (0 = unlimited)
+    int meshBudgetMB = 0;
+    int textureBudgetMB = 0;
+
     // Load configuration from JSON file
     // Returns true on success, false on failure
     static bool LoadFromFile(const std::string& path, RenderConfig& outConfig) {
@@ -71,27 +99,12 @@ struct RenderConfig {
                 return false;
             }
 
-            // Parse each field with defaults as fallback
-            outConfig.windowWidth = RenderConfigIO::ParseInt(RenderConfigIO::ExtractValue(json, "windowWidth"));
-            outConfig.windowHeight = RenderConfigIO::ParseInt(RenderConfigIO::ExtractValue(json, "windowHeight"));
-            outConfig.fullscreen = RenderConfigIO::ParseBool(RenderConfigIO::ExtractValue(json, "fullscreen"));
-            outConfig.msaaSamples = RenderConfigIO::ParseInt(RenderConfigIO::ExtractValue(json, "msaaSamples"));
-            outConfig.enableVSync = RenderConfigIO::ParseBool(RenderConfigIO::ExtractValue(json, "enableVSync"));
-            outConfig.renderScale = RenderConfigIO::ParseFloat(RenderConfigIO::ExtractValue(json, "renderScale"));
-            outConfig.ambientIntensity = RenderConfigIO::ParseFloat(RenderConfigIO::ExtractValue(json, "ambientIntensity"));
-            outConfig.sunIntensity = RenderConfigIO::ParseFloat(RenderConfigIO::ExtractValue(json, "sunIntensity"));
-            outConfig.wireframeMode = RenderConfigIO::ParseBool(RenderConfigIO::ExtractValue(json, "wireframeMode"));
-            outConfig.showNormals = RenderConfigIO::ParseBool(RenderConfigIO::ExtractValue(json, "showNormals"));
-            outConfig.showDepthBuffer = RenderConfigIO::ParseBool(RenderConfigIO::ExtractValue(json, "showDepthBuffer"));
-            outConfig.nearPlane = RenderConfigIO::ParseFloat(RenderConfigIO::ExtractValue(json, "nearPlane"));
-            outConfig.farPlane = RenderConfigIO::ParseFloat(RenderConfigIO::ExtractValue(json, "farPlane"));
-            outConfig.fovDegrees = RenderConfigIO::ParseFloat(RenderConfigIO::ExtractValue(json, "fovDegrees"));
-            outConfig.cameraSpeed = RenderConfigIO::ParseFloat(RenderConfigIO::ExtractValue(json, "cameraSpeed"));
-            outConfig.useReversedZ = RenderConfigIO::ParseBool(RenderConfigIO::ExtractValue(json, "useReversedZ"));
-
-            std::string colorHex = RenderConfigIO::ExtractValue(json, "clearColorHex");
-            if (!colorHex.empty()) {
-                outConfig.clearColorHex = colorHex;
+            // Parse all fields in one pass; keys missing from the file keep their current values
+            std::string parseError;
+            if (!RenderConfigIO::ParseJson(json, outConfig, parseError)) {
+                QuoteSystem::Instance().Log("LoadFromFile: parse error in " + path + " - " + parseError,
+                    QuoteSystem::MessageType::ERROR_MSG);
+                return false;
             }
 
             // Validation checks
@@ -119,28 +132,7 @@ struct RenderConfig {
         }
 
         try {
-            std::stringstream ss;
-            ss << "{\n";
-            ss << "  \"windowWidth\": " << config.windowWidth << ",\n";
-            ss << "  \"windowHeight\": " << config.windowHeight << ",\n";
-            ss << "  \"fullscreen\": " << (config.fullscreen ? "true" : "false") << ",\n";
-            ss << "  \"msaaSamples\": " << config.msaaSamples << ",\n";
-            ss << "  \"enableVSync\": " << (config.enableVSync ? "true" : "false") << ",\n";
-            ss << "  \"renderScale\": " << config.renderScale << ",\n";
-            ss << "  \"ambientIntensity\": " << config.ambientIntensity << ",\n";
-            ss << "  \"sunIntensity\": " << config.sunIntensity << ",\n";
-            ss << "  \"wireframeMode\": " << (config.wireframeMode ? "true" : "false") << ",\n";
-            ss << "  \"showNormals\": " << (config.showNormals ? "true" : "false") << ",\n";
-            ss << "  \"showDepthBuffer\": " << (config.showDepthBuffer ? "true" : "false") << ",\n";
-            ss << "  \"nearPlane\": " << config.nearPlane << ",\n";
-            ss << "  \"farPlane\": " << config.farPlane << ",\n";
-            ss << "  \"fovDegrees\": " << config.fovDegrees << ",\n";
-            ss << "  \"cameraSpeed\": " << config.cameraSpeed << ",\n";
-            ss << "  \"useReversedZ\": " << (config.useReversedZ ? "true" : "false") << ",\n";
-            ss << "  \"clearColorHex\": \"" << config.clearColorHex << "\"\n";
-            ss << "}\n";
-
-            RenderConfigIO::SaveStringToFile(path, ss.str());
+            RenderConfigIO::SaveStringToFile(path, RenderConfigIO::WriteJson(config));
             QuoteSystem::Instance().Log("RenderConfig saved to " + path, QuoteSystem::MessageType::SUCCESS);
             return true;
 
@@ -150,6 +142,53 @@ struct RenderConfig {
         }
     }
 
+    // Compare two configs and report which subsystems need to be rebuilt
+    // Returns a ConfigChangeFlags bitmask (CONFIG_CHANGE_NONE when identical)
+    static uint32_t Diff(const RenderConfig& before, const RenderConfig& after) {
+        uint32_t changes = CONFIG_CHANGE_NONE;
+
+        if (before.windowWidth != after.windowWidth || before.windowHeight != after.windowHeight ||
+            before.fullscreen != after.fullscreen || before.enableVSync != after.enableVSync ||
+            before.renderScale != after.renderScale || before.dynamicResolution != after.dynamicResolution ||
+            before.targetFrameTimeMs != after.targetFrameTimeMs || before.minRenderScale != after.minRenderScale ||
+            before.maxRenderScale != after.maxRenderScale) {
+            changes |= CONFIG_CHANGE_SWAPCHAIN;
+        }
+
+        // MSAA changes both the attachments and the pipeline multisample state
+        if (before.msaaSamples != after.msaaSamples) {
+            changes |= CONFIG_CHANGE_SWAPCHAIN | CONFIG_CHANGE_PIPELINES;
+        }
+
+        if (before.wireframeMode != after.wireframeMode || before.showNormals != after.showNormals ||
+            before.showDepthBuffer != after.showDepthBuffer || before.useReversedZ != after.useReversedZ) {
+            changes |= CONFIG_CHANGE_PIPELINES;
+        }
+
+        if (before.ambientIntensity != after.ambientIntensity || before.sunIntensity != after.sunIntensity) {
+            changes |= CONFIG_CHANGE_LIGHTING;
+        }
+
+        if (before.environmentMap != after.environmentMap) {
+            changes |= CONFIG_CHANGE_ENVIRONMENT;
+        }
+
+        if (before.nearPlane != after.nearPlane || before.farPlane != after.farPlane ||
+            before.fovDegrees != after.fovDegrees || before.cameraSpeed != after.cameraSpeed) {
+            changes |= CONFIG_CHANGE_CAMERA;
+        }
+
+        if (before.clearColorHex != after.clearColorHex) {
+            changes |= CONFIG_CHANGE_CLEAR;
+        }
+
+        if (before.meshBudgetMB != after.meshBudgetMB || before.textureBudgetMB != after.textureBudgetMB) {
+            changes |= CONFIG_CHANGE_RESIDENCY;
+        }
+
+        return changes;
+    }
+
     // Validate configuration values are within acceptable ranges
     static bool ValidateConfig(const RenderConfig& config) {
         bool valid = true;
@@ -178,6 +217,20 @@ struct RenderConfig {
             valid = false;
         }
 
+        // Validate dynamic resolution bounds and target
+        if (config.minRenderScale <= 0.0f || config.maxRenderScale > 2.0f ||
+            config.minRenderScale > config.maxRenderScale) {
+            QuoteSystem::Instance().Log("Invalid dynamic resolution bounds (need 0 < min <= max <= 2): min=" +
+                std::to_string(config.minRenderScale) + " max=" + std::to_string(config.maxRenderScale),
+                QuoteSystem::MessageType::WARNING);
+            valid = false;
+        }
+        if (config.targetFrameTimeMs <= 0.0f) {
+            QuoteSystem::Instance().Log("Invalid target frame time (must be > 0 ms): " +
+                std::to_string(config.targetFrameTimeMs), QuoteSystem::MessageType::WARNING);
+            valid = false;
+        }
+
         // Validate camera planes
         if (config.nearPlane <= 0.0f || config.farPlane <= config.nearPlane) {
             QuoteSystem::Instance().Log("Invalid near/far planes: near=" +
@@ -193,14 +246,49 @@ struct RenderConfig {
             valid = false;
         }
 
+        // Validate residency budgets
+        if (config.meshBudgetMB < 0 || config.textureBudgetMB < 0) {
+            QuoteSystem::Instance().Log("Invalid residency budget (must be >= 0 MB): mesh=" +
+                std::to_string(config.meshBudgetMB) + " texture=" + std::to_string(config.textureBudgetMB),
+                QuoteSystem::MessageType::WARNING);
+            valid = false;
+        }
+
         return valid;
     }
 };
 
-// Simple JSON parsing utilities
+// Field table binding JSON keys to RenderConfig members (also defines SaveToFile key order)
 namespace RenderConfigIO {
+    inline constexpr std::array<JsonField<RenderConfig>, 24> FIELDS = {{
+        { "windowWidth",      &RenderConfig::windowWidth },
+        { "windowHeight",     &RenderConfig::windowHeight },
+        { "fullscreen",       &RenderConfig::fullscreen },
+        { "msaaSamples",      &RenderConfig::msaaSamples },
+        { "enableVSync",      &RenderConfig::enableVSync },
+        { "renderScale",      &RenderConfig::renderScale },
+        { "dynamicResolution", &RenderConfig::dynamicResolution },
+        { "targetFrameTimeMs", &RenderConfig::targetFrameTimeMs },
+        { "minRenderScale",   &RenderConfig::minRenderScale },
+        { "maxRenderScale",   &RenderConfig::maxRenderScale },
+        { "ambientIntensity", &RenderConfig::ambientIntensity },
+        { "sunIntensity",     &RenderConfig::sunIntensity },
+        { "environmentMap",   &RenderConfig::environmentMap },
+        { "wireframeMode",    &RenderConfig::wireframeMode },
+        { "showNormals",      &RenderConfig::showNormals },
+        { "showDepthBuffer",  &RenderConfig::showDepthBuffer },
+        { "nearPlane",        &RenderConfig::nearPlane },
+        { "farPlane",         &RenderConfig::farPlane },
+        { "fovDegrees",       &RenderConfig::fovDegrees },
+        { "cameraSpeed",      &RenderConfig::cameraSpeed },
+        { "useReversedZ",     &RenderConfig::useReversedZ },
+        { "clearColorHex",    &RenderConfig::clearColorHex },
+        { "meshBudgetMB",     &RenderConfig::meshBudgetMB },
+        { "textureBudgetMB",  &RenderConfig::textureBudgetMB }
+    }};
+
     inline std::string LoadFileToString(const std::string& path) {
-        std::ifstream file(path);
+        std::ifstream file(path, std::ios::binary);
         if (!file.is_open()) {
             return "";
         }
@@ -214,55 +302,11 @@ namespace RenderConfigIO {
         file << content;
     }
 
-    inline std::string ExtractValue(const std::string& json, const std::string& key) {
-        std::string searchKey = "\"" + key + "\":";
-        size_t pos = json.find(searchKey);
-        if (pos == std::string::npos) {
-            return "";
-        }
-
-        pos += searchKey.length();
-        while (pos < json.length() && std::isspace(json[pos])) {
-            ++pos;
-        }
-
-        size_t endPos = pos;
-        if (json[pos] == '"') {
-            // String value
-            ++pos;
-            endPos = json.find('"', pos);
-            return json.substr(pos, endPos - pos);
-        } else {
-            // Numeric or boolean value
-            while (endPos < json.length() && json[endPos] != ',' && json[endPos] != '}' && json[endPos] != '\n') {
-                ++endPos;
-            }
-            std::string value = json.substr(pos, endPos - pos);
-            // Trim whitespace
-            size_t start = 0;
-            while (start < value.length() && std::isspace(value[start])) {
-                ++start;
-            }
-            size_t end = value.length();
-            while (end > start && std::isspace(value[end - 1])) {
-                --end;
-            }
-            return value.substr(start, end - start);
-        }
-    }
-
-    inline int ParseInt(const std::string& value) {
-        if (value.empty()) return 0;
-        return std::stoi(value);
-    }
-
-    inline float ParseFloat(const std::string& value) {
-        if (value.empty()) return 0.0f;
-        return std::stof(value);
+    inline bool ParseJson(const std::string& json, RenderConfig& outConfig, std::string& outError) {
+        return JsonBinding::Read(json, FIELDS, outConfig, &outError);
     }
 
-    inline bool ParseBool(const std::string& value) {
-        if (value.empty()) return false;
-        return value == "true" || value == "1";
+    inline std::string WriteJson(const RenderConfig& config) {
+        return JsonBinding::Write(config, FIELDS);
     }
 }
@@ -11,6 +11,7 @@
 #include <mutex>
 #include <thread>
 #include <chrono>
+#include <cstdint>
 #include "../core/QuoteSystem.h"
 #include "../core/DebugWindow.h"
 
@@ -26,6 +27,10 @@ struct ShaderOptions {
     std::string entryPoint = "main";
     bool enableOptimization = true;
     std::vector<std::string> defines;
+
+    // Combined content hash of every #include the source pulls in
+    // Lets an edit to a Common/*.hlsli header invalidate dependents in the cache
+    uint64_t includeHash = 0;
 };
 
 // ShaderCompiler handles SPIR-V compilation from HLSL source
@@ -128,6 +133,16 @@ public:
         return mCache.size();
     }
 
+    // 64-bit FNV-1a content hash (also used by HotReloadService for include tracking)
+    static uint64_t HashSource(const std::string& source) {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : source) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
     // Prevent copy/move
     ShaderCompiler(const ShaderCompiler&) = delete;
     ShaderCompiler& operator=(const ShaderCompiler&) = delete;
@@ -144,15 +159,14 @@ private:
         const std::string& sourcePath, const ShaderOptions& options) const;
 
     // Compute cache key from shader source content and options
-    // Uses simple hash to detect when source has changed
+    // Hashes the full source so edits anywhere in the file miss the cache
     std::string ComputeCacheKey(const std::string& source, ShaderType type, const ShaderOptions& options) const {
-        // Simple hash: combine source length, first 32 chars, and type
-        // In production, use a proper hash like SHA256
-        std::string key = std::to_string(source.length()) + "_";
-        key += (source.length() > 32) ? source.substr(0, 32) : source;
+        std::string key = std::to_string(HashSource(source)) + "_";
+        key += std::to_string(source.length());
         key += "_" + std::to_string(static_cast<int>(type));
         key += "_" + options.entryPoint;
-        key += "_" + (options.enableOptimization ? "opt" : "noopt");
+        key += "_" + std::string(options.enableOptimization ? "opt" : "noopt");
+        key += "_" + std::to_string(options.includeHash);
         for (const auto& define : options.defines) {
             key += "_" + define;
         }
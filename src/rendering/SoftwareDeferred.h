@@ -0,0 +1,780 @@
+/** SoftwareDeferred - Compact G-buffer and tiled light culling for the software renderer
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "SoftwareShading.h"
+#include "../core/Parallel.h"
+#include "../core/TestManagerNew.h"
+#include <vector>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+// Screen tile edge in pixels; lights are binned and shaded per tile
+constexpr uint32_t DEFERRED_TILE_SIZE = 16;
+
+// Tile light lists hold point indices as-is and spot indices with this bit set
+constexpr uint32_t DEFERRED_SPOT_BIT = 0x80000000u;
+
+// Point light (PointLight in lighting_common.hlsli); intensity is folded into color
+struct PointLight {
+    float position[3] = { 0.0f, 0.0f, 0.0f };
+    float radius = 10.0f;       // No contribution at or beyond this distance
+    float color[3] = { 1.0f, 1.0f, 1.0f };
+    float attenuation = 2.0f;   // Falloff exponent (1 = linear, 2 = quadratic)
+};
+
+// Spot light (SpotLight in lighting_common.hlsli)
+// The shader still hardcodes a 100 unit range (its TODO); radius defaults to match
+struct SpotLight {
+    float position[3] = { 0.0f, 0.0f, 0.0f };
+    float innerAngle = 0.3f;    // Radians
+    float direction[3] = { 0.0f, -1.0f, 0.0f };
+    float outerAngle = 0.5f;    // Radians
+    float color[3] = { 1.0f, 1.0f, 1.0f };
+    float attenuation = 2.0f;
+    float radius = 100.0f;
+};
+
+struct LocalLights {
+    std::vector<PointLight> points;
+    std::vector<SpotLight> spots;
+};
+
+// Camera basis for view-space binning and position reconstruction
+struct DeferredView {
+    float position[3] = { 0.0f, 0.0f, 5.0f };
+    float right[3] = { 1.0f, 0.0f, 0.0f };
+    float up[3] = { 0.0f, 1.0f, 0.0f };
+    float forward[3] = { 0.0f, 0.0f, -1.0f };
+    float tanHalfFovY = 0.637f;
+    float aspect = 1.0f;
+    uint32_t width = 1;
+    uint32_t height = 1;
+
+    static DeferredView FromCamera(const CameraData& camera, uint32_t width, uint32_t height) {
+        DeferredView view;
+        view.position[0] = camera.positionX;
+        view.position[1] = camera.positionY;
+        view.position[2] = camera.positionZ;
+
+        float forward[3] = { camera.lookAtX - camera.positionX, camera.lookAtY - camera.positionY,
+                             camera.lookAtZ - camera.positionZ };
+        Normalize(forward);
+        float worldUp[3] = { camera.upX, camera.upY, camera.upZ };
+        float right[3];
+        Cross(forward, worldUp, right);
+        Normalize(right);
+        float up[3];
+        Cross(right, forward, up);
+
+        for (int c = 0; c < 3; ++c) {
+            view.forward[c] = forward[c];
+            view.right[c] = right[c];
+            view.up[c] = up[c];
+        }
+        view.tanHalfFovY = std::tan(camera.fovDegrees * 0.5f * SHADING_PI / 180.0f);
+        view.aspect = static_cast<float>(width) / static_cast<float>(std::max(1u, height));
+        view.width = width;
+        view.height = height;
+        return view;
+    }
+
+    // World -> (x right, y up, z forward)
+    void WorldToView(const float world[3], float out[3]) const {
+        float d[3] = { world[0] - position[0], world[1] - position[1], world[2] - position[2] };
+        out[0] = d[0] * right[0] + d[1] * right[1] + d[2] * right[2];
+        out[1] = d[0] * up[0] + d[1] * up[1] + d[2] * up[2];
+        out[2] = d[0] * forward[0] + d[1] * forward[1] + d[2] * forward[2];
+    }
+
+    // Ray through the pixel centre with unit forward component (scale by view depth)
+    void PixelRay(uint32_t x, uint32_t y, float out[3]) const {
+        float ndcX = 2.0f * (x + 0.5f) / width - 1.0f;
+        float ndcY = 1.0f - 2.0f * (y + 0.5f) / height;
+        float rx = ndcX * tanHalfFovY * aspect;
+        float ry = ndcY * tanHalfFovY;
+        for (int c = 0; c < 3; ++c) {
+            out[c] = right[c] * rx + up[c] * ry + forward[c];
+        }
+    }
+
+private:
+    static void Normalize(float v[3]) {
+        float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (length > 0.0f) {
+            v[0] /= length;
+            v[1] /= length;
+            v[2] /= length;
+        }
+    }
+
+    static void Cross(const float a[3], const float b[3], float out[3]) {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+};
+
+// 20 bytes per pixel; world position is rebuilt from depth and the pixel ray
+// - depth: view-space distance along forward, 0 = no surface
+// - normal: octahedral, two snorm16
+// - albedoAo: RGB stored as sqrt (more precision in darks), AO linear, 8 bits each
+// - material: roughness | metallic << 8
+// - emissive: RGB9E5 shared exponent (HDR range)
+struct GBuffer {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<float> depth;
+    std::vector<uint32_t> normal;
+    std::vector<uint32_t> albedoAo;
+    std::vector<uint32_t> material;
+    std::vector<uint32_t> emissive;
+
+    void Resize(uint32_t newWidth, uint32_t newHeight) {
+        width = newWidth;
+        height = newHeight;
+        depth.assign(PixelCount(), 0.0f);
+        normal.assign(PixelCount(), 0);
+        albedoAo.assign(PixelCount(), 0);
+        material.assign(PixelCount(), 0);
+        emissive.assign(PixelCount(), 0);
+    }
+
+    // Only depth needs resetting; the other planes are never read for empty pixels
+    void Clear() {
+        std::fill(depth.begin(), depth.end(), 0.0f);
+    }
+
+    size_t PixelCount() const {
+        return static_cast<size_t>(width) * height;
+    }
+
+    bool Covered(size_t pixel) const {
+        return depth[pixel] > 0.0f;
+    }
+
+    // Called by the rasterizer for every fragment that passes the depth test
+    void Write(size_t pixel, float viewDepth, const float worldNormal[3], const PbrMaterial& surface) {
+        depth[pixel] = viewDepth;
+        normal[pixel] = EncodeOctahedral(worldNormal);
+        albedoAo[pixel] = PackUnorm8(std::sqrt(Clamp01(surface.albedo[0])), 0) |
+                          PackUnorm8(std::sqrt(Clamp01(surface.albedo[1])), 8) |
+                          PackUnorm8(std::sqrt(Clamp01(surface.albedo[2])), 16) |
+                          PackUnorm8(Clamp01(surface.ao), 24);
+        material[pixel] = PackUnorm8(Clamp01(surface.roughness), 0) | PackUnorm8(Clamp01(surface.metallic), 8);
+        emissive[pixel] = EncodeRgb9e5(surface.emissive);
+    }
+
+    // Unpack one pixel into the SurfacePlane layout used by SoftwareShading
+    void Decode(uint32_t x, uint32_t y, const DeferredView& view, float sample[SURFACE_PLANE_COUNT]) const {
+        size_t pixel = static_cast<size_t>(y) * width + x;
+        float ray[3];
+        view.PixelRay(x, y, ray);
+        for (int c = 0; c < 3; ++c) {
+            sample[SURFACE_POSITION_X + c] = view.position[c] + ray[c] * depth[pixel];
+        }
+
+        DecodeOctahedral(normal[pixel], sample + SURFACE_NORMAL_X);
+
+        uint32_t packed = albedoAo[pixel];
+        for (int c = 0; c < 3; ++c) {
+            float encoded = UnpackUnorm8(packed, c * 8);
+            sample[SURFACE_ALBEDO_R + c] = encoded * encoded;
+        }
+        sample[SURFACE_AO] = UnpackUnorm8(packed, 24);
+        sample[SURFACE_ROUGHNESS] = UnpackUnorm8(material[pixel], 0);
+        sample[SURFACE_METALLIC] = UnpackUnorm8(material[pixel], 8);
+        DecodeRgb9e5(emissive[pixel], sample + SURFACE_EMISSIVE_R);
+    }
+
+    // Octahedral mapping (Cigolle et al. 2014), 16 bits per axis
+    static uint32_t EncodeOctahedral(const float n[3]) {
+        float sum = std::fabs(n[0]) + std::fabs(n[1]) + std::fabs(n[2]);
+        if (sum <= 0.0f) {
+            return PackSnorm16(0.0f, 0.0f);
+        }
+        float u = n[0] / sum;
+        float v = n[1] / sum;
+        if (n[2] < 0.0f) {
+            float foldedU = (1.0f - std::fabs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+            float foldedV = (1.0f - std::fabs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+            u = foldedU;
+            v = foldedV;
+        }
+        return PackSnorm16(u, v);
+    }
+
+    static void DecodeOctahedral(uint32_t packed, float out[3]) {
+        float u = static_cast<int16_t>(packed & 0xFFFFu) / 32767.0f;
+        float v = static_cast<int16_t>(packed >> 16) / 32767.0f;
+        float n[3] = { u, v, 1.0f - std::fabs(u) - std::fabs(v) };
+        float t = std::max(-n[2], 0.0f);
+        n[0] += n[0] >= 0.0f ? -t : t;
+        n[1] += n[1] >= 0.0f ? -t : t;
+        float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        for (int c = 0; c < 3; ++c) {
+            out[c] = n[c] / length;
+        }
+    }
+
+    // Shared-exponent RGB (as DXGI_FORMAT_R9G9B9E5_SHAREDEXP)
+    static uint32_t EncodeRgb9e5(const float rgb[3]) {
+        const float maxValue = 65408.0f; // (511 / 512) * 2^16
+        float r = std::min(std::max(rgb[0], 0.0f), maxValue);
+        float g = std::min(std::max(rgb[1], 0.0f), maxValue);
+        float b = std::min(std::max(rgb[2], 0.0f), maxValue);
+        float largest = std::max(r, std::max(g, b));
+        if (largest < 1.0f / 65536.0f / 512.0f) {
+            return 0;
+        }
+
+        // Biased exponent (bias 15) such that largest < 2^(exponent - 15)
+        int exponent = std::max(-16, static_cast<int>(std::floor(std::log2(largest)))) + 16;
+        float scale = std::ldexp(1.0f, exponent - 15 - 9);
+        if (static_cast<int>(std::floor(largest / scale + 0.5f)) == 512) {
+            scale *= 2.0f;
+            ++exponent;
+        }
+        uint32_t mr = static_cast<uint32_t>(std::floor(r / scale + 0.5f));
+        uint32_t mg = static_cast<uint32_t>(std::floor(g / scale + 0.5f));
+        uint32_t mb = static_cast<uint32_t>(std::floor(b / scale + 0.5f));
+        return mr | (mg << 9) | (mb << 18) | (static_cast<uint32_t>(exponent) << 27);
+    }
+
+    static void DecodeRgb9e5(uint32_t packed, float out[3]) {
+        float scale = std::ldexp(1.0f, static_cast<int>(packed >> 27) - 15 - 9);
+        out[0] = (packed & 0x1FFu) * scale;
+        out[1] = ((packed >> 9) & 0x1FFu) * scale;
+        out[2] = ((packed >> 18) & 0x1FFu) * scale;
+    }
+
+private:
+    static float Clamp01(float v) {
+        return v > 0.0f ? (v < 1.0f ? v : 1.0f) : 0.0f;
+    }
+
+    static uint32_t PackUnorm8(float v, int shift) {
+        return static_cast<uint32_t>(v * 255.0f + 0.5f) << shift;
+    }
+
+    static float UnpackUnorm8(uint32_t packed, int shift) {
+        return ((packed >> shift) & 0xFFu) / 255.0f;
+    }
+
+    static uint32_t PackSnorm16(float u, float v) {
+        auto quantize = [](float x) {
+            x = std::min(std::max(x, -1.0f), 1.0f);
+            return static_cast<uint32_t>(static_cast<uint16_t>(static_cast<int16_t>(std::lround(x * 32767.0f))));
+        };
+        return quantize(u) | (quantize(v) << 16);
+    }
+};
+
+// Per-tile light lists, rebuilt each frame; keep one instance to reuse allocations
+// Each light is scattered only into tiles under its screen-space bounds, then rejected
+// against the tile's depth range and side planes, so build cost follows overlap.
+class TiledLightGrid {
+public:
+    void Build(const GBuffer& gbuffer, const DeferredView& view, const LocalLights& lights, bool cullLights = true) {
+        mTilesX = (gbuffer.width + DEFERRED_TILE_SIZE - 1) / DEFERRED_TILE_SIZE;
+        mTilesY = (gbuffer.height + DEFERRED_TILE_SIZE - 1) / DEFERRED_TILE_SIZE;
+        const size_t tileCount = static_cast<size_t>(mTilesX) * mTilesY;
+        mMinDepth.resize(tileCount);
+        mMaxDepth.resize(tileCount);
+        mTileLights.resize(tileCount);
+        mOverlapCount = 0;
+
+        // Depth bounds of the surfaces actually in each tile (min > max means empty)
+        Parallel::For(tileCount, [&](size_t tile) {
+            mTileLights[tile].clear();
+            uint32_t x0, y0, x1, y1;
+            TileRect(tile, gbuffer.width, gbuffer.height, x0, y0, x1, y1);
+            float minDepth = INFINITY;
+            float maxDepth = -INFINITY;
+            for (uint32_t y = y0; y < y1; ++y) {
+                const float* row = gbuffer.depth.data() + static_cast<size_t>(y) * gbuffer.width;
+                for (uint32_t x = x0; x < x1; ++x) {
+                    if (row[x] > 0.0f) {
+                        minDepth = std::min(minDepth, row[x]);
+                        maxDepth = std::max(maxDepth, row[x]);
+                    }
+                }
+            }
+            mMinDepth[tile] = minDepth;
+            mMaxDepth[tile] = maxDepth;
+        });
+
+        // Points first, then spots, each in index order, so lists are deterministic
+        for (size_t i = 0; i < lights.points.size(); ++i) {
+            const PointLight& light = lights.points[i];
+            Scatter(view, light.position, light.radius, static_cast<uint32_t>(i), cullLights);
+        }
+        for (size_t i = 0; i < lights.spots.size(); ++i) {
+            const SpotLight& light = lights.spots[i];
+            Scatter(view, light.position, light.radius, static_cast<uint32_t>(i) | DEFERRED_SPOT_BIT, cullLights);
+        }
+    }
+
+    const std::vector<uint32_t>& TileLights(size_t tile) const {
+        return mTileLights[tile];
+    }
+
+    uint32_t TilesX() const { return mTilesX; }
+    uint32_t TilesY() const { return mTilesY; }
+
+    // Total light-tile pairs after culling (the shading cost driver)
+    size_t OverlapCount() const { return mOverlapCount; }
+
+    static void TileRect(size_t tile, uint32_t width, uint32_t height, uint32_t& x0, uint32_t& y0, uint32_t& x1, uint32_t& y1) {
+        uint32_t tilesX = (width + DEFERRED_TILE_SIZE - 1) / DEFERRED_TILE_SIZE;
+        x0 = static_cast<uint32_t>(tile % tilesX) * DEFERRED_TILE_SIZE;
+        y0 = static_cast<uint32_t>(tile / tilesX) * DEFERRED_TILE_SIZE;
+        x1 = std::min(x0 + DEFERRED_TILE_SIZE, width);
+        y1 = std::min(y0 + DEFERRED_TILE_SIZE, height);
+    }
+
+private:
+    void Scatter(const DeferredView& view, const float worldPosition[3], float radius, uint32_t id, bool cullLights) {
+        float center[3];
+        view.WorldToView(worldPosition, center);
+
+        int tx0 = 0;
+        int ty0 = 0;
+        int tx1 = static_cast<int>(mTilesX) - 1;
+        int ty1 = static_cast<int>(mTilesY) - 1;
+        float scaleX = view.tanHalfFovY * view.aspect;
+        float scaleY = view.tanHalfFovY;
+
+        if (cullLights) {
+            // Entirely behind the camera
+            if (center[2] + radius <= 0.0f) {
+                return;
+            }
+
+            // Conservative screen bounds from the view-space box; x/z is monotonic in
+            // x and extreme at the box's z faces, so the four ratios bound the sphere
+            const float nearLimit = 1e-4f;
+            if (center[2] - radius > nearLimit) {
+                float zNear = center[2] - radius;
+                float zFar = center[2] + radius;
+                float minX = std::min((center[0] - radius) / zNear, (center[0] - radius) / zFar) / scaleX;
+                float maxX = std::max((center[0] + radius) / zNear, (center[0] + radius) / zFar) / scaleX;
+                float minY = std::min((center[1] - radius) / zNear, (center[1] - radius) / zFar) / scaleY;
+                float maxY = std::max((center[1] + radius) / zNear, (center[1] + radius) / zFar) / scaleY;
+                if (minX > 1.0f || maxX < -1.0f || minY > 1.0f || maxY < -1.0f) {
+                    return;
+                }
+
+                float pixelX0 = (minX + 1.0f) * 0.5f * view.width;
+                float pixelX1 = (maxX + 1.0f) * 0.5f * view.width;
+                float pixelY0 = (1.0f - maxY) * 0.5f * view.height;
+                float pixelY1 = (1.0f - minY) * 0.5f * view.height;
+                tx0 = std::max(tx0, static_cast<int>(std::floor(pixelX0 / DEFERRED_TILE_SIZE)));
+                tx1 = std::min(tx1, static_cast<int>(std::floor(pixelX1 / DEFERRED_TILE_SIZE)));
+                ty0 = std::max(ty0, static_cast<int>(std::floor(pixelY0 / DEFERRED_TILE_SIZE)));
+                ty1 = std::min(ty1, static_cast<int>(std::floor(pixelY1 / DEFERRED_TILE_SIZE)));
+            }
+        }
+
+        for (int ty = ty0; ty <= ty1; ++ty) {
+            for (int tx = tx0; tx <= tx1; ++tx) {
+                size_t tile = static_cast<size_t>(ty) * mTilesX + tx;
+                // Guard: no surfaces in this tile
+                if (mMinDepth[tile] > mMaxDepth[tile]) {
+                    continue;
+                }
+                if (cullLights && !Overlaps(view, tx, ty, tile, center, radius)) {
+                    continue;
+                }
+                mTileLights[tile].push_back(id);
+                ++mOverlapCount;
+            }
+        }
+    }
+
+    // Sphere against the tile's depth slab and its four side planes (through the eye)
+    bool Overlaps(const DeferredView& view, int tx, int ty, size_t tile, const float center[3], float radius) const {
+        if (center[2] + radius < mMinDepth[tile] || center[2] - radius > mMaxDepth[tile]) {
+            return false;
+        }
+
+        float scaleX = view.tanHalfFovY * view.aspect;
+        float scaleY = view.tanHalfFovY;
+        float left = (2.0f * tx * DEFERRED_TILE_SIZE / view.width - 1.0f) * scaleX;
+        float right = (2.0f * std::min((tx + 1) * DEFERRED_TILE_SIZE, view.width) / view.width - 1.0f) * scaleX;
+        float top = (1.0f - 2.0f * ty * DEFERRED_TILE_SIZE / view.height) * scaleY;
+        float bottom = (1.0f - 2.0f * std::min((ty + 1) * DEFERRED_TILE_SIZE, view.height) / view.height) * scaleY;
+
+        // Inward normals (1, 0, -left), (-1, 0, right), (0, 1, -bottom), (0, -1, top)
+        auto outside = [&](float nx, float ny, float nz) {
+            float distance = (nx * center[0] + ny * center[1] + nz * center[2]) / std::sqrt(nx * nx + ny * ny + nz * nz);
+            return distance < -radius;
+        };
+        return !outside(1.0f, 0.0f, -left) && !outside(-1.0f, 0.0f, right) &&
+               !outside(0.0f, 1.0f, -bottom) && !outside(0.0f, -1.0f, top);
+    }
+
+    uint32_t mTilesX = 0;
+    uint32_t mTilesY = 0;
+    size_t mOverlapCount = 0;
+    std::vector<float> mMinDepth;
+    std::vector<float> mMaxDepth;
+    std::vector<std::vector<uint32_t>> mTileLights;
+};
+
+// SoftwareDeferred - per-tile shading of a GBuffer
+class SoftwareDeferred {
+public:
+    // Bin lights, then shade each tile's covered pixels in 8-lane batches with only
+    // that tile's lights; pixels without a surface keep their clear colour
+    static void Shade(const GBuffer& gbuffer, const DeferredView& view, const ShadingEnvironment& env,
+                      const LocalLights& lights, TiledLightGrid& grid, uint32_t* pixels,
+                      bool cullLights = true, size_t workerCount = 0) {
+        grid.Build(gbuffer, view, lights, cullLights);
+
+        ShadingEnvironment frame = env;
+        for (int c = 0; c < 3; ++c) {
+            frame.cameraPosition[c] = view.position[c];
+        }
+
+        const size_t tileCount = static_cast<size_t>(grid.TilesX()) * grid.TilesY();
+        Parallel::For(tileCount, [&](size_t tile) {
+            uint32_t x0, y0, x1, y1;
+            TiledLightGrid::TileRect(tile, gbuffer.width, gbuffer.height, x0, y0, x1, y1);
+            const std::vector<uint32_t>& tileLights = grid.TileLights(tile);
+
+            alignas(32) float lanes[SURFACE_PLANE_COUNT][8];
+            size_t indices[8];
+            int filled = 0;
+
+            auto flush = [&]() {
+                // Pad the tail with lane 0 so unused lanes stay finite
+                for (int lane = filled; lane < 8; ++lane) {
+                    for (uint32_t plane = 0; plane < SURFACE_PLANE_COUNT; ++plane) {
+                        lanes[plane][lane] = lanes[plane][0];
+                    }
+                }
+
+                float rgb[3][8];
+                ShadeBatch(lanes, frame, lights, tileLights, rgb);
+                for (int lane = 0; lane < filled; ++lane) {
+                    pixels[indices[lane]] = SoftwareShading::ResolvePixel(rgb[0][lane], rgb[1][lane], rgb[2][lane]);
+                }
+                filled = 0;
+            };
+
+            float sample[SURFACE_PLANE_COUNT];
+            for (uint32_t y = y0; y < y1; ++y) {
+                for (uint32_t x = x0; x < x1; ++x) {
+                    size_t pixel = static_cast<size_t>(y) * gbuffer.width + x;
+                    if (!gbuffer.Covered(pixel)) {
+                        continue;
+                    }
+                    gbuffer.Decode(x, y, view, sample);
+                    for (uint32_t plane = 0; plane < SURFACE_PLANE_COUNT; ++plane) {
+                        lanes[plane][filled] = sample[plane];
+                    }
+                    indices[filled++] = pixel;
+                    if (filled == 8) {
+                        flush();
+                    }
+                }
+            }
+            if (filled > 0) {
+                flush();
+            }
+        }, workerCount);
+    }
+
+    // pbr_ps terms plus every listed local light, before tone mapping
+    static void ShadeBatch(const float lanes[SURFACE_PLANE_COUNT][8], const ShadingEnvironment& env,
+                           const LocalLights& lights, const std::vector<uint32_t>& lightIds, float outRgb[3][8]) {
+        SoftwareShading::SurfaceLanes s = SoftwareShading::PrepareSurface(lanes, env);
+        Float8 position[3] = { Float8::Load(lanes[SURFACE_POSITION_X]), Float8::Load(lanes[SURFACE_POSITION_Y]),
+                               Float8::Load(lanes[SURFACE_POSITION_Z]) };
+
+        Float8 color[3] = { Float8::Broadcast(0.0f), Float8::Broadcast(0.0f), Float8::Broadcast(0.0f) };
+        SoftwareShading::AccumulateSun(s, env, color);
+        SoftwareShading::AccumulateAmbient(s, Float8::Load(lanes[SURFACE_AO]), env, color);
+
+        for (uint32_t id : lightIds) {
+            if (id & DEFERRED_SPOT_BIT) {
+                const SpotLight& light = lights.spots[id & ~DEFERRED_SPOT_BIT];
+                AccumulateLocal(s, position, light.position, light.radius, light.attenuation, light.color, &light, color);
+            } else {
+                const PointLight& light = lights.points[id];
+                AccumulateLocal(s, position, light.position, light.radius, light.attenuation, light.color, nullptr, color);
+            }
+        }
+
+        for (int c = 0; c < 3; ++c) {
+            (color[c] + Float8::Load(lanes[SURFACE_EMISSIVE_R + c])).Store(outRgb[c]);
+        }
+    }
+
+    // Packing fidelity and culling exactness
+    static void RegisterTests() {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        tests.RegisterSuite("SoftwareDeferred");
+
+        tests.AddTest("SoftwareDeferred", "G-buffer round trip", []() {
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> signedUnit(-1.0f, 1.0f);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            CameraData camera;
+            camera.positionX = 1.0f;
+            camera.positionY = 2.0f;
+            camera.lookAtZ = -3.0f;
+            DeferredView view = DeferredView::FromCamera(camera, 64, 48);
+            GBuffer gbuffer;
+            gbuffer.Resize(64, 48);
+
+            for (int i = 0; i < 2000; ++i) {
+                float n[3] = { signedUnit(rng), signedUnit(rng), signedUnit(rng) };
+                float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (length < 1e-3f) {
+                    continue;
+                }
+                for (float& c : n) {
+                    c /= length;
+                }
+
+                PbrMaterial surface;
+                surface.albedo[0] = unit(rng);
+                surface.roughness = unit(rng);
+                surface.emissive[1] = unit(rng) * 100.0f;
+
+                uint32_t x = static_cast<uint32_t>(i % 64);
+                uint32_t y = static_cast<uint32_t>((i / 64) % 48);
+                float depth = 0.5f + unit(rng) * 50.0f;
+                gbuffer.Write(static_cast<size_t>(y) * 64 + x, depth, n, surface);
+
+                float sample[SURFACE_PLANE_COUNT];
+                gbuffer.Decode(x, y, view, sample);
+                float dot = n[0] * sample[SURFACE_NORMAL_X] + n[1] * sample[SURFACE_NORMAL_Y] + n[2] * sample[SURFACE_NORMAL_Z];
+
+                float ray[3];
+                view.PixelRay(x, y, ray);
+                float expectedX = view.position[0] + ray[0] * depth;
+                bool ok = dot > 0.99999f &&
+                          std::fabs(std::sqrt(sample[SURFACE_ALBEDO_R]) - std::sqrt(surface.albedo[0])) <= 0.5f / 255.0f + 1e-6f &&
+                          std::fabs(sample[SURFACE_ROUGHNESS] - surface.roughness) <= 0.5f / 255.0f + 1e-6f &&
+                          std::fabs(sample[SURFACE_EMISSIVE_G] - surface.emissive[1]) <= surface.emissive[1] / 256.0f + 1e-6f &&
+                          std::fabs(sample[SURFACE_POSITION_X] - expectedX) <= 1e-4f * (1.0f + std::fabs(expectedX));
+                if (!ok) {
+                    return false;
+                }
+            }
+            return true;
+        });
+
+        tests.AddTest("SoftwareDeferred", "Tiled culling matches all-lights shading", []() {
+            GBuffer gbuffer;
+            DeferredView view;
+            BuildTestScene(160, 96, gbuffer, view);
+            LocalLights lights = MakeTestLights(150, 50, 11);
+
+            ShadingEnvironment env;
+            const uint32_t clear = 0xFF102030u;
+            std::vector<uint32_t> culled(gbuffer.PixelCount(), clear);
+            std::vector<uint32_t> reference(gbuffer.PixelCount(), clear);
+            TiledLightGrid grid;
+            Shade(gbuffer, view, env, lights, grid, culled.data(), true);
+            size_t culledPairs = grid.OverlapCount();
+            Shade(gbuffer, view, env, lights, grid, reference.data(), false);
+
+            // Culled lights contribute exactly zero and list order is preserved, so the
+            // images must match bit for bit while binning drops most light-tile pairs
+            bool sawSky = false;
+            for (size_t pixel = 0; pixel < culled.size(); ++pixel) {
+                sawSky = sawSky || (!gbuffer.Covered(pixel) && culled[pixel] == clear);
+            }
+            return culled == reference && sawSky && culledPairs * 4 < grid.OverlapCount();
+        });
+    }
+
+    // 1080p ground plane: sun only, IBL, and 256 local lights
+    static void RegisterBenchmarks() {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        TestManagerNew::BenchmarkOptions options;
+        options.warmupIterations = 1;
+        options.sampleCount = 7;
+
+        auto gbuffer = std::make_shared<GBuffer>();
+        auto view = std::make_shared<DeferredView>();
+        BuildTestScene(1920, 1080, *gbuffer, *view);
+        auto pixels = std::make_shared<std::vector<uint32_t>>(gbuffer->PixelCount());
+        auto grid = std::make_shared<TiledLightGrid>();
+        auto noLights = std::make_shared<LocalLights>();
+        auto manyLights = std::make_shared<LocalLights>(MakeTestLights(192, 64, 3));
+
+        tests.AddBenchmark("SoftwareDeferred", "Shade 1080p sun", [=]() {
+            ShadingEnvironment env;
+            Shade(*gbuffer, *view, env, *noLights, *grid, pixels->data());
+            TestManagerNew::DoNotOptimize(pixels->data());
+        }, options);
+
+        std::shared_ptr<const IblData> ibl = SoftwareShading::MakeTestEnvironment();
+        tests.AddBenchmark("SoftwareDeferred", "Shade 1080p IBL", [=]() {
+            ShadingEnvironment env;
+            env.ibl = ibl;
+            Shade(*gbuffer, *view, env, *noLights, *grid, pixels->data());
+            TestManagerNew::DoNotOptimize(pixels->data());
+        }, options);
+
+        tests.AddBenchmark("SoftwareDeferred", "Shade 1080p 256 lights", [=]() {
+            ShadingEnvironment env;
+            Shade(*gbuffer, *view, env, *manyLights, *grid, pixels->data());
+            TestManagerNew::DoNotOptimize(pixels->data());
+        }, options);
+    }
+
+    // Prevent instantiation (static API)
+    SoftwareDeferred() = delete;
+
+private:
+    // CalculateAttenuation (and the spot cone of CalculateSpotLight) per lane, then the
+    // shared Cook-Torrance term; batches where no lane is lit skip the BRDF entirely
+    static void AccumulateLocal(const SoftwareShading::SurfaceLanes& s, const Float8 position[3],
+                                const float lightPosition[3], float radius, float exponent, const float lightColor[3],
+                                const SpotLight* spot, Float8 color[3]) {
+        const Float8 zero = Float8::Broadcast(0.0f);
+        const Float8 one = Float8::Broadcast(1.0f);
+        const Float8 epsilon = Float8::Broadcast(SHADING_EPSILON);
+
+        Float8 toLight[3];
+        for (int c = 0; c < 3; ++c) {
+            toLight[c] = Float8::Broadcast(lightPosition[c]) - position[c];
+        }
+        Float8 distance = Float8::Sqrt(toLight[0] * toLight[0] + toLight[1] * toLight[1] + toLight[2] * toLight[2]);
+        Float8 inRange = Float8::Greater(Float8::Broadcast(radius), distance);
+        if (!Float8::Any(inRange)) {
+            return;
+        }
+
+        Float8 inverse = Float8::Select(Float8::Greater(distance, epsilon), one / distance, zero);
+        for (int c = 0; c < 3; ++c) {
+            toLight[c] = toLight[c] * inverse;
+        }
+
+        Float8 normalized = distance * Float8::Broadcast(1.0f / radius);
+        Float8 falloff;
+        if (exponent == 2.0f) {
+            falloff = normalized * normalized;
+        } else if (exponent == 1.0f) {
+            falloff = normalized;
+        } else {
+            float values[8];
+            normalized.Store(values);
+            for (float& v : values) {
+                v = std::pow(v, exponent);
+            }
+            falloff = Float8::Load(values);
+        }
+        Float8 attenuation = Float8::Select(inRange, Float8::Saturate(one - falloff), zero);
+
+        if (spot) {
+            float direction[3] = { spot->direction[0], spot->direction[1], spot->direction[2] };
+            float length = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+            float scale = length > 0.0f ? 1.0f / length : 0.0f;
+            Float8 cosAngle = zero;
+            for (int c = 0; c < 3; ++c) {
+                cosAngle = cosAngle - toLight[c] * Float8::Broadcast(direction[c] * scale);
+            }
+            float edge0 = std::cos(spot->outerAngle);
+            float edge1 = std::cos(spot->innerAngle);
+            Float8 t = Float8::Saturate((cosAngle - Float8::Broadcast(edge0)) * Float8::Broadcast(1.0f / (edge1 - edge0)));
+            attenuation = attenuation * t * t * (Float8::Broadcast(3.0f) - Float8::Broadcast(2.0f) * t);
+        }
+
+        Float8 lit = Float8::Greater(attenuation, epsilon);
+        if (!Float8::Any(lit)) {
+            return;
+        }
+        attenuation = Float8::Select(lit, attenuation, zero);
+
+        Float8 radiance[3];
+        for (int c = 0; c < 3; ++c) {
+            radiance[c] = Float8::Broadcast(lightColor[c]) * attenuation;
+        }
+        SoftwareShading::AccumulateDirect(s, toLight, radiance, color);
+    }
+
+    // Camera above a ground plane at y = 0, looking down at the horizon so the top rows are sky
+    static void BuildTestScene(uint32_t width, uint32_t height, GBuffer& gbuffer, DeferredView& view) {
+        CameraData camera;
+        camera.positionX = 0.0f;
+        camera.positionY = 3.0f;
+        camera.positionZ = 10.0f;
+        camera.lookAtY = 0.5f;
+        camera.fovDegrees = 70.0f;
+        view = DeferredView::FromCamera(camera, width, height);
+
+        gbuffer.Resize(width, height);
+        const float up[3] = { 0.0f, 1.0f, 0.0f };
+        PbrMaterial surface;
+        surface.albedo[0] = 0.7f;
+        surface.albedo[1] = 0.6f;
+        surface.albedo[2] = 0.5f;
+        surface.roughness = 0.4f;
+
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                float ray[3];
+                view.PixelRay(x, y, ray);
+                // Guard: ray never reaches the ground
+                if (ray[1] >= -1e-4f) {
+                    continue;
+                }
+                float depth = -view.position[1] / ray[1];
+                if (depth < 200.0f) {
+                    surface.metallic = ((x / 32 + y / 32) % 2) ? 1.0f : 0.0f;
+                    gbuffer.Write(static_cast<size_t>(y) * width + x, depth, up, surface);
+                }
+            }
+        }
+    }
+
+    static LocalLights MakeTestLights(size_t pointCount, size_t spotCount, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> spread(-25.0f, 25.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        LocalLights lights;
+        for (size_t i = 0; i < pointCount; ++i) {
+            PointLight light;
+            light.position[0] = spread(rng);
+            light.position[1] = 0.2f + unit(rng) * 1.5f;
+            light.position[2] = spread(rng) - 15.0f;
+            light.radius = 1.0f + unit(rng) * 3.0f;
+            light.color[0] = 4.0f * unit(rng);
+            light.color[1] = 4.0f * unit(rng);
+            light.color[2] = 4.0f * unit(rng);
+            light.attenuation = i % 3 == 0 ? 1.5f : 2.0f;
+            lights.points.push_back(light);
+        }
+        for (size_t i = 0; i < spotCount; ++i) {
+            SpotLight light;
+            light.position[0] = spread(rng);
+            light.position[1] = 2.0f + unit(rng) * 2.0f;
+            light.position[2] = spread(rng) - 15.0f;
+            light.direction[0] = unit(rng) - 0.5f;
+            light.radius = 6.0f;
+            light.color[1] = 6.0f;
+            lights.spots.push_back(light);
+        }
+        return lights;
+    }
+};
+
+// Note on usage:
+// The rasterizer calls GBuffer::Write() with the fragment's view depth on every depth-test
+// pass; Shade() then bins lights and shades each visible pixel once. Cost is roughly
+// pixels x (sun + ambient) plus the light-tile overlap, not pixels x lights.
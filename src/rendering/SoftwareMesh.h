@@ -0,0 +1,20 @@
+/** SoftwareMesh - CPU-side mesh data shared by the software renderer and asset loaders
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+// Interleaved vertex layout: position (3), normal (3), uv (2)
+constexpr uint32_t SOFTWARE_MESH_STRIDE = 8;
+
+// Software mesh data
+// vertexStride counts floats per vertex (SOFTWARE_MESH_STRIDE for loader output)
+struct SoftwareMesh {
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    uint32_t vertexStride = SOFTWARE_MESH_STRIDE;
+};
@@ -6,11 +6,31 @@
 #pragma once
 
 #include "IRenderService.h"
+#include "SoftwareMesh.h"
+#include "GltfLoader.h"
+#include "FbxLoader.h"
+#include "SoftwareDeferred.h"
+#include "DynamicResolution.h"
+#include "PickingBvh.h"
+#include "MeshLod.h"
+#include "MeshCook.h"
+#include "../core/AssetCooker.h"
+#include "../core/HandlePool.h"
+#include "../core/JobSystem.h"
+#include "../core/FrameArena.h"
+#include "../core/MemoryBudget.h"
+#include "../core/ResidencyManager.h"
+#include "../core/StringInterner.h"
 #include "../core/QuoteSystem.h"
 #include "../core/DebugWindow.h"
 #include <memory>
 #include <vector>
-#include <unordered_map>
+#include <string>
+#include <functional>
+#include <filesystem>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 
 // Forward declarations for existing software rasterizer components
 // These will be included in the .cpp file
@@ -23,17 +43,30 @@ enum class DepthMode {
     REVERSED    // Clear to 0, compare GREATER (modern, matches Vulkan path)
 };
 
-// Software mesh data
-struct SoftwareMesh {
-    std::vector<float> vertices;
-    std::vector<uint32_t> indices;
-    uint32_t vertexStride;
-};
-
 // Draw command for software rasterizer
 struct SoftwareDrawCommand {
     MeshHandle mesh;
     Transform transform;
+    PbrMaterial material;
+};
+
+// Mesh residency levels: 0 = full detail, 1 = MeshLod proxy, 2 = evicted (data dropped)
+constexpr uint32_t SOFTWARE_MESH_LOD_LEVELS = 2;
+
+// Version of the "mesh.import" cook step; bump when GltfLoader, FbxLoader or
+// ParseMeshFile change what they produce for the same file
+constexpr uint32_t SOFTWARE_MESH_IMPORT_VERSION = 1;
+
+// Everything keyed by a mesh handle lives in one pooled record. The handle stays valid
+// across eviction; the data is re-read from `source` when the mesh is drawn again.
+struct SoftwareMeshRecord {
+    SoftwareMesh mesh;
+    PbrMaterial material;
+    std::shared_ptr<const MeshBvh> bvh; // Picking BLAS for the resident level (null when evicted)
+    size_t trackedBytes = 0;            // Reported to MemoryTracker under MESH_CACHE
+    PathId source = INVALID_PATH_ID;
+    ResidencyId residency = INVALID_RESIDENCY_ID;
+    uint32_t level = 0;
 };
 
 // SoftwareRenderService bridges the existing software rasterizer into IRenderService
@@ -44,13 +77,24 @@ public:
     SoftwareRenderService()
         : mGraphicsHelper(nullptr)
         , mRenderer(nullptr)
-        , mNextMeshHandle(1)
-        , mNextTextureHandle(1)
         , mIsInitialized(false)
         , mDepthMode(DepthMode::STANDARD)
         , mFrameNumber(0)
     {
         DebugWindow::Instance().RegisterChannel("Renderer");
+
+        // Mesh imports are cooked: unchanged files load from the content-addressed store
+        MeshCook::RegisterSteps(mCooker);
+        mCooker.RegisterStep(MESH_COOK_IMPORT_STEP, MeshCook::StepVersion(SOFTWARE_MESH_IMPORT_VERSION),
+            [this](const CookInput& input, CookBlob& output, std::string& error) {
+                SoftwareMesh mesh;
+                if (!ParseMeshSource(input.sourcePath, mesh)) {
+                    error = "parse failed";
+                    return false;
+                }
+                output = MeshCook::Serialize(mesh);
+                return true;
+            });
     }
 
     ~SoftwareRenderService() override {
@@ -94,6 +138,17 @@ public:
         // Initialize shader state
         InitializeShaderState();
 
+        // Residency budgets (0 MB = unlimited)
+        mResidency.SetBudget(ResidencyClass::MESH, static_cast<size_t>(config.meshBudgetMB) << 20);
+        mResidency.SetBudget(ResidencyClass::TEXTURE, static_cast<size_t>(config.textureBudgetMB) << 20);
+
+        // Deferred shading inputs: one G-buffer texel per rendered pixel, IBL if configured
+        mDynamicResolution.Configure(config);
+        ApplyRenderScale(mDynamicResolution.GetScale());
+        if (!config.environmentMap.empty()) {
+            mShadingEnvironment.ibl = mIblCache.Get(config.environmentMap);
+        }
+
         // Initialize camera with config values
         mCameraData.fovDegrees = config.fovDegrees;
         mCameraData.nearPlane = config.nearPlane;
@@ -122,14 +177,14 @@ public:
         QuoteSystem::Instance().Log("SoftwareRenderService shutdown starting...",
             QuoteSystem::MessageType::INFO);
 
-        // Unload all meshes
-        for (auto& pair : mMeshes) {
-            // Mesh data will be cleaned up by RAII
+        // Unload all meshes and textures; outstanding handles go stale
+        for (const SoftwareMeshRecord& record : mMeshes) {
+            MemoryTracker::Instance().Release(MemoryTag::MESH_CACHE, record.trackedBytes);
+            mResidency.Unregister(record.residency);
         }
-        mMeshes.clear();
-
-        // Unload all textures
-        mTextures.clear();
+        MemoryTracker::Instance().Release(MemoryTag::TEXTURE_CACHE, mTextures.Size() * sizeof(PathId));
+        mMeshes.Clear();
+        mTextures.Clear();
 
         // Destroy renderer and graphics helper (RAII)
         mRenderer.reset();
@@ -148,9 +203,15 @@ public:
 
         // Clear the pixel buffer with configured color
         ClearFramebuffer();
-
-        // Clear draw list from previous frame
-        mDrawList.clear();
+        mGBuffer.Clear();
+
+        // Restart the per-frame lists in a fresh arena frame. Last frame's memory stays
+        // valid until the next BeginFrame, and reserving its count avoids regrowth.
+        size_t lastDrawCount = mDrawList.size();
+        FrameArena::Instance().BeginFrame();
+        mDrawList = FrameVector<SoftwareDrawCommand>();
+        mDrawList.reserve(lastDrawCount);
+        mVisibleDraws = FrameVector<uint32_t>();
     }
 
     void EndFrame() override {
@@ -159,19 +220,34 @@ public:
             return;
         }
 
-        // Render all submitted meshes
-        RenderDrawList();
+        // Cull, bin, rasterize and stat the frame as a task graph so host work
+        // queued with AddFrameTask() overlaps the render stages
+        auto renderStart = std::chrono::steady_clock::now();
+        RunFrameGraph();
+        float renderMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - renderStart).count();
+
+        // The render time picks next frame's internal resolution; targets resize
+        // here, between frames, when the scale moves
+        mFrameStats.renderScale = mDynamicResolution.GetScale();
+        float nextScale = mDynamicResolution.Update(renderMs);
+        if (nextScale != mFrameStats.renderScale) {
+            ApplyRenderScale(nextScale);
+        }
+
+        // Re-stream meshes drawn this frame and demote stale ones past the budget.
+        // Runs after the graph, so no raster worker reads a record while it changes.
+        mResidency.Update();
 
-        // Update frame stats
-        UpdateFrameStats();
+        // Refresh memory high-water marks and budget warnings once per frame
+        MemoryBudget::Instance().Poll();
 
         // Increment frame counter
         mFrameNumber++;
     }
 
+    // Matrices are rebuilt by the frame graph's camera stage
     void SetCamera(const CameraData& camera) override {
         mCameraData = camera;
-        UpdateCameraMatrices();
     }
 
     void SubmitMesh(MeshHandle mesh, const Transform& transform) override {
@@ -180,17 +256,25 @@ public:
             return;
         }
 
-        // Guard: mesh not loaded
-        if (mMeshes.find(mesh) == mMeshes.end()) {
+        // Guard: mesh not loaded (or unloaded since)
+        const SoftwareMeshRecord* record = mMeshes.Get(mesh);
+        if (record == nullptr) {
             QuoteSystem::Instance().Log("SubmitMesh: mesh handle not found",
                 QuoteSystem::MessageType::WARNING);
             return;
         }
 
+        // Evicted meshes are skipped this frame; the touch re-streams them in EndFrame
+        mResidency.Touch(record->residency);
+        if (record->level >= SOFTWARE_MESH_LOD_LEVELS) {
+            return;
+        }
+
         // Add to draw list
         SoftwareDrawCommand cmd;
         cmd.mesh = mesh;
         cmd.transform = transform;
+        cmd.material = record->material;
         mDrawList.push_back(cmd);
     }
 
@@ -206,24 +290,29 @@ public:
             return INVALID_MESH_HANDLE;
         }
 
-        // Parse mesh file (GLTF, OBJ, etc.)
         SoftwareMesh mesh;
-        if (!ParseMeshFile(path, mesh)) {
-            QuoteSystem::Instance().Log("LoadMesh: failed to parse - " + path,
-                QuoteSystem::MessageType::ERROR_MSG);
-            DebugWindow::Instance().Post("Renderer", "Mesh load failed: " + path, DebugWindow::DebugLevel::ERR);
-            return INVALID_MESH_HANDLE;
-        }
-
-        // Assign handle and store
-        MeshHandle handle = mNextMeshHandle++;
-        mMeshes[handle] = mesh;
+        bool parsed = CookMesh(path, 0, mesh);
+        return AddMesh(path, parsed, std::move(mesh));
+    }
 
-        QuoteSystem::Instance().Log("Mesh loaded: " + path + " (handle " + std::to_string(handle) + ")",
-            QuoteSystem::MessageType::SUCCESS);
-        DebugWindow::Instance().Post("Renderer", "Mesh loaded: " + path, DebugWindow::DebugLevel::INFO);
+    // Load several meshes at once; the cook (parse or store lookup) of each file runs
+    // in parallel on the JobSystem. Handles line up with `paths`.
+    std::vector<MeshHandle> LoadMeshes(const std::vector<std::string>& paths) override {
+        std::vector<SoftwareMesh> meshes(paths.size());
+        std::vector<uint8_t> parsed(paths.size(), 0);
+        JobSystem::Instance().ParallelFor(paths.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                parsed[i] = !paths[i].empty() && CookMesh(paths[i], 0, meshes[i]);
+            }
+        });
 
-        return handle;
+        std::vector<MeshHandle> handles(paths.size(), INVALID_MESH_HANDLE);
+        for (size_t i = 0; i < paths.size(); ++i) {
+            if (!paths[i].empty()) {
+                handles[i] = AddMesh(paths[i], parsed[i] != 0, std::move(meshes[i]));
+            }
+        }
+        return handles;
     }
 
     TextureHandle LoadTexture(const std::string& path) override {
@@ -235,8 +324,11 @@ public:
 
         // Parse texture file (PNG, JPG, etc.)
         // For now, just assign a handle
-        TextureHandle handle = mNextTextureHandle++;
-        mTextures[handle] = path;
+        TextureHandle handle = mTextures.Insert(PathInterner::Instance().Intern(path));
+        if (handle == INVALID_TEXTURE_HANDLE) {
+            return INVALID_TEXTURE_HANDLE;
+        }
+        MemoryTracker::Instance().Add(MemoryTag::TEXTURE_CACHE, sizeof(PathId));
 
         QuoteSystem::Instance().Log("Texture loaded: " + path + " (handle " + std::to_string(handle) + ")",
             QuoteSystem::MessageType::SUCCESS);
@@ -251,9 +343,11 @@ public:
             return;
         }
 
-        auto it = mMeshes.find(handle);
-        if (it != mMeshes.end()) {
-            mMeshes.erase(it);
+        const SoftwareMeshRecord* record = mMeshes.Get(handle);
+        if (record != nullptr) {
+            MemoryTracker::Instance().Release(MemoryTag::MESH_CACHE, record->trackedBytes);
+            mResidency.Unregister(record->residency);
+            mMeshes.Remove(handle);
             DebugWindow::Instance().Post("Renderer", "Mesh unloaded (handle " +
                 std::to_string(handle) + ")",
                 DebugWindow::DebugLevel::TRACE);
@@ -266,9 +360,9 @@ public:
             return;
         }
 
-        auto it = mTextures.find(handle);
-        if (it != mTextures.end()) {
-            mTextures.erase(it);
+        if (mTextures.Contains(handle)) {
+            MemoryTracker::Instance().Release(MemoryTag::TEXTURE_CACHE, sizeof(PathId));
+            mTextures.Remove(handle);
             DebugWindow::Instance().Post("Renderer", "Texture unloaded (handle " +
                 std::to_string(handle) + ")",
                 DebugWindow::DebugLevel::TRACE);
@@ -292,6 +386,52 @@ public:
         return mDepthMode;
     }
 
+    // Material used for every later SubmitMesh of this mesh (default: PbrMaterial())
+    void SetMaterial(MeshHandle mesh, const PbrMaterial& material) {
+        // Guard: unknown or unloaded mesh
+        SoftwareMeshRecord* record = mMeshes.Get(mesh);
+        if (record == nullptr) {
+            return;
+        }
+        record->material = material;
+    }
+
+    // Budgets (from RenderConfig) and per-class residency stats
+    ResidencyManager& GetResidency() {
+        return mResidency;
+    }
+
+    // Frame-time driven render scale (RenderConfig::dynamicResolution)
+    const DynamicResolution& GetDynamicResolution() const {
+        return mDynamicResolution;
+    }
+
+    // Size the scene is rasterized and shaded at before the upscale to the window
+    uint32_t GetRenderWidth() const {
+        return mGBuffer.width;
+    }
+
+    uint32_t GetRenderHeight() const {
+        return mGBuffer.height;
+    }
+
+    // Picking BLAS for a loaded mesh (null for unknown or evicted handles); see PickingScene
+    std::shared_ptr<const MeshBvh> GetMeshBvh(MeshHandle mesh) const {
+        const SoftwareMeshRecord* record = mMeshes.Get(mesh);
+        return record != nullptr ? record->bvh : nullptr;
+    }
+
+    // Point and spot lights shaded on top of the sun; replaced wholesale each call
+    void SetLocalLights(const LocalLights& lights) {
+        mLocalLights = lights;
+    }
+
+    // Run `work` during the next EndFrame() alongside the render stages (e.g. UI
+    // Update calls). It must not touch renderer state; frame stats wait for it.
+    void AddFrameTask(const std::string& name, std::function<void()> work) {
+        mFrameTasks.push_back(FrameTask{name, std::move(work)});
+    }
+
     // Prevent copy/move
     SoftwareRenderService(const SoftwareRenderService&) = delete;
     SoftwareRenderService& operator=(const SoftwareRenderService&) = delete;
@@ -306,8 +446,41 @@ private:
 
     // Frame rendering
     void ClearFramebuffer();
+    void CullDrawList();
+    void BinDrawList();
     void RenderDrawList();
 
+    // camera -> cull -> bin -> raster -> stats, host frame tasks beside them
+    void RunFrameGraph() {
+        mFrameGraph.Clear();
+        TaskGraph::TaskId camera = mFrameGraph.Add("camera", [this]() { UpdateCameraMatrices(); });
+        TaskGraph::TaskId cull = mFrameGraph.Then(camera, "cull", [this]() { CullDrawList(); });
+        TaskGraph::TaskId bin = mFrameGraph.Then(cull, "bin", [this]() { BinDrawList(); });
+        TaskGraph::TaskId raster = mFrameGraph.Then(bin, "raster", [this]() { RenderDrawList(); });
+        TaskGraph::TaskId stats = mFrameGraph.Then(raster, "stats", [this]() { UpdateFrameStats(); });
+        for (FrameTask& task : mFrameTasks) {
+            mFrameGraph.Precede(mFrameGraph.Add(task.name, std::move(task.work)), stats);
+        }
+        mFrameTasks.clear();
+
+        mFrameGraph.Run();
+    }
+
+    // Size the G-buffer (and the scaled colour target below window size) for `scale`
+    void ApplyRenderScale(float scale) {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        DynamicResolution::RenderExtent(static_cast<uint32_t>(mConfig.windowWidth),
+            static_cast<uint32_t>(mConfig.windowHeight), scale, width, height);
+        if (width == mGBuffer.width && height == mGBuffer.height) {
+            return;
+        }
+        mGBuffer.Resize(width, height);
+        bool scaled = width != static_cast<uint32_t>(mConfig.windowWidth) ||
+                      height != static_cast<uint32_t>(mConfig.windowHeight);
+        mScaledColor.assign(scaled ? mGBuffer.PixelCount() : 0, 0);
+    }
+
     // Update functions
     void UpdateCameraMatrices();
     void UpdateLightingState();
@@ -316,6 +489,107 @@ private:
     // Mesh parsing
     bool ParseMeshFile(const std::string& path, SoftwareMesh& outMesh);
 
+    // glTF/GLB and binary FBX have dedicated loaders; other formats go through ParseMeshFile
+    bool ParseMeshSource(const std::string& path, SoftwareMesh& outMesh) {
+        if (GltfLoader::IsGltfPath(path)) {
+            return GltfLoader::Load(path, outMesh);
+        }
+        if (FbxLoader::IsFbxPath(path)) {
+            return FbxLoader::Load(path, outMesh);
+        }
+        return ParseMeshFile(path, outMesh);
+    }
+
+    // Store a parsed mesh under a new handle and register it for residency
+    MeshHandle AddMesh(const std::string& path, bool parsed, SoftwareMesh mesh) {
+        if (!parsed) {
+            QuoteSystem::Instance().Log("LoadMesh: failed to parse - " + path,
+                QuoteSystem::MessageType::ERROR_MSG);
+            DebugWindow::Instance().Post("Renderer", "Mesh load failed: " + path, DebugWindow::DebugLevel::ERR);
+            return INVALID_MESH_HANDLE;
+        }
+
+        // Assign handle and store; the picking BLAS is built once here and shared by instances
+        SoftwareMeshRecord record;
+        record.bvh = MeshBvh::Build(mesh);
+        record.mesh = std::move(mesh);
+        record.trackedBytes = MeshLod::MemoryBytes(record.mesh) + record.bvh->MemoryBytes();
+        record.source = PathInterner::Instance().Intern(path);
+        size_t trackedBytes = record.trackedBytes;
+        MeshHandle handle = mMeshes.Insert(std::move(record));
+        if (handle == INVALID_MESH_HANDLE) {
+            return INVALID_MESH_HANDLE;
+        }
+        MemoryTracker::Instance().Add(MemoryTag::MESH_CACHE, trackedBytes);
+        mMeshes.Get(handle)->residency = mResidency.Register(ResidencyClass::MESH, SOFTWARE_MESH_LOD_LEVELS, 0,
+            trackedBytes, [this, handle](uint32_t level) { return SetMeshLevel(handle, level); });
+
+        QuoteSystem::Instance().Log("Mesh loaded: " + path + " (handle " + std::to_string(handle) + ")",
+            QuoteSystem::MessageType::SUCCESS);
+        DebugWindow::Instance().Post("Renderer", "Mesh loaded: " + path, DebugWindow::DebugLevel::INFO);
+
+        return handle;
+    }
+
+    // Full detail (level 0) or the MeshLod proxy (level 1) through the cooker.
+    // Text .gltf files reference external buffers the cooker does not hash, so they
+    // always parse directly.
+    bool CookMesh(const std::string& path, uint32_t level, SoftwareMesh& outMesh) {
+        std::string extension = std::filesystem::path(path).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (extension == ".gltf") {
+            if (!ParseMeshSource(path, outMesh)) {
+                return false;
+            }
+            if (level > 0) {
+                outMesh = MeshLod::Cluster(outMesh);
+            }
+            return true;
+        }
+
+        std::vector<CookStage> pipeline = { { MESH_COOK_IMPORT_STEP, "" } };
+        if (level > 0) {
+            pipeline.push_back({ MESH_COOK_CLUSTER_STEP, std::to_string(MESH_LOD_PROXY_CELLS) });
+        }
+        CookResult cooked = mCooker.Cook(path, pipeline);
+        return cooked.success && MeshCook::Deserialize(*cooked.data, outMesh);
+    }
+
+    // ResidencyManager callback: move a mesh to `level` and return its resident bytes.
+    // Demoting from full detail clusters the data in memory; anything finer than what
+    // is resident is re-read from the source file.
+    size_t SetMeshLevel(MeshHandle handle, uint32_t level) {
+        SoftwareMeshRecord* record = mMeshes.Get(handle);
+        if (record == nullptr) {
+            return RESIDENCY_LOAD_FAILED;
+        }
+
+        if (level >= SOFTWARE_MESH_LOD_LEVELS) {
+            record->mesh = SoftwareMesh();
+            record->bvh.reset();
+        } else if (level > record->level) {
+            record->mesh = MeshLod::Cluster(record->mesh);
+            record->bvh = MeshBvh::Build(record->mesh);
+        } else {
+            SoftwareMesh mesh;
+            std::string path = PathInterner::Instance().Resolve(record->source);
+            if (!CookMesh(path, level, mesh)) {
+                DebugWindow::Instance().Post("Renderer", "Mesh re-stream failed: " + path, DebugWindow::DebugLevel::ERR);
+                return RESIDENCY_LOAD_FAILED;
+            }
+            record->mesh = std::move(mesh);
+            record->bvh = MeshBvh::Build(record->mesh);
+        }
+        record->level = level;
+
+        size_t bytes = record->bvh ? MeshLod::MemoryBytes(record->mesh) + record->bvh->MemoryBytes() : 0;
+        MemoryTracker::Instance().Release(MemoryTag::MESH_CACHE, record->trackedBytes);
+        MemoryTracker::Instance().Add(MemoryTag::MESH_CACHE, bytes);
+        record->trackedBytes = bytes;
+        return bytes;
+    }
+
     // Depth mode conversion
     static std::string DepthModeToString(DepthMode mode) {
         switch (mode) {
@@ -335,22 +609,41 @@ private:
     std::unique_ptr<GraphicsHelper> mGraphicsHelper;
     std::unique_ptr<Renderer> mRenderer;
 
-    // Resource storage
-    std::unordered_map<MeshHandle, SoftwareMesh> mMeshes;
-    std::unordered_map<TextureHandle, std::string> mTextures;
-
-    // Handle counters
-    MeshHandle mNextMeshHandle;
-    TextureHandle mNextTextureHandle;
+    // Resource storage (generational handles)
+    HandlePool<SoftwareMeshRecord> mMeshes;
+    ResidencyManager mResidency;
+    HandlePool<PathId> mTextures; // Interned source path until pixels are decoded
 
     // Draw state
-    std::vector<SoftwareDrawCommand> mDrawList;
+    FrameVector<SoftwareDrawCommand> mDrawList;       // Frame arena memory, rebuilt in BeginFrame()
+    FrameVector<uint32_t> mVisibleDraws;              // mDrawList indices that pass CullDrawList()
+    std::vector<std::vector<uint32_t>> mBinnedDraws;  // Per screen tile, filled by BinDrawList()
+
+    // Frame scheduling (JobSystem.h)
+    struct FrameTask {
+        std::string name;
+        std::function<void()> work;
+    };
+    TaskGraph mFrameGraph;
+    std::vector<FrameTask> mFrameTasks;
     uint64_t mFrameNumber;
     bool mIsInitialized;
 
     // Depth configuration
     DepthMode mDepthMode;
 
+    // Deferred PBR shading (SoftwareDeferred.h), at the dynamic render size
+    GBuffer mGBuffer;
+    DynamicResolution mDynamicResolution;
+    std::vector<uint32_t> mScaledColor; // Shaded frame when the render size is below the window
+    TiledLightGrid mLightGrid;
+    LocalLights mLocalLights;
+    ShadingEnvironment mShadingEnvironment;
+    IblCache mIblCache;
+
+    // Content-addressed mesh import cache (AssetCooker.h, MeshCook.h)
+    AssetCooker mCooker;
+
     // Shader state (encapsulated, no globals)
     // These replace the global mutable state from the original Shaders.h
     struct ShaderState {
@@ -392,16 +685,40 @@ private:
 // ClearFramebuffer() will call GraphicsHelper::clearBuffer() with the clear color
 // parsed from mConfig.clearColorHex.
 //
-// RenderDrawList() will iterate mDrawList and for each command:
-// - Look up the mesh data from mMeshes
+// EndFrame() runs RunFrameGraph() on JobSystem::Instance(). Each stage may fan out
+// further with Parallel::For; the graph only orders the stages.
+//
+// CullDrawList() will transform each record's MeshBvh root bounds by the draw transform
+// and keep the draws whose boxes touch PickCamera::FrustumFor(0, 0, width, height),
+// writing their indices to mVisibleDraws.
+//
+// BinDrawList() will project each visible draw's bounds to a screen rect and append
+// the draw index to every DEFERRED_TILE_SIZE * 4 tile in mBinnedDraws it overlaps, so
+// raster workers own disjoint tiles and never share a depth or G-buffer row.
+//
+// RenderDrawList() will Parallel::For over mBinnedDraws and, for each command in a bin:
+// - Look up the mesh record from mMeshes
 // - Build a world matrix from the transform
-// - Call Renderer::renderMesh() with the mesh data and matrices
+// - Call Renderer::renderMesh() with the mesh data and matrices, scissored to the bin's
+//   tile; on each depth-test pass the pixel stage calls mGBuffer.Write() with the
+//   fragment's view depth, interpolated normal and cmd.material instead of writing a colour
+// Once every draw is rasterized it calls SoftwareDeferred::Shade(mGBuffer,
+// DeferredView::FromCamera(mCameraData, width, height), mShadingEnvironment, mLocalLights,
+// mLightGrid, pixels) on the GraphicsHelper pixel buffer, so each visible pixel runs the
+// pbr_ps BRDF once for the sun and once per light binned to its tile.
+//
+// Culling, binning, rasterization and shading all work at GetRenderWidth() x
+// GetRenderHeight(). When that is below the window size (mScaledColor is non-empty)
+// ClearFramebuffer() also fills mScaledColor, Shade() writes into it instead, and
+// RenderDrawList() ends with DynamicResolution::Upscale(mScaledColor -> GraphicsHelper
+// pixels). EndFrame() times the frame graph and resizes the targets between frames.
 //
 // UpdateCameraMatrices() will compute view and projection matrices from mCameraData
 // and store them in mShaderState for use by the vertex shader.
 //
 // UpdateLightingState() will copy mLightingData into mShaderState for use by the
-// pixel shader.
+// pixel shader, and refresh mShadingEnvironment via ShadingEnvironment::FromFrame()
+// (keeping its ibl pointer). UpdateCameraMatrices() updates its cameraPosition.
 //
 // The depth mode switching logic from BRIGHTFORGE_MASTER.md will be implemented in
 // GraphicsHelper by adding a setDepthMode() method that controls clearBuffer() and
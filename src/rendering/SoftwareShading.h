@@ -0,0 +1,474 @@
+/** SoftwareShading - CPU port of pbr_ps.hlsl over 8-wide SoA fragment batches
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "IRenderService.h"
+#include "IblBaker.h"
+#include "../core/Float8.h"
+#include "../core/TestManagerNew.h"
+#include <vector>
+#include <array>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+// Same constants as math_utils.hlsli so CPU and GPU clamp identically
+constexpr float SHADING_PI = 3.14159265359f;
+constexpr float SHADING_EPSILON = 1e-6f;
+
+// Metallic-roughness material; defaults match an untextured pbr_ps draw
+struct PbrMaterial {
+    float albedo[3] = { 1.0f, 1.0f, 1.0f };
+    float metallic = 0.0f;
+    float roughness = 0.5f;
+    float ao = 1.0f;
+    float emissive[3] = { 0.0f, 0.0f, 0.0f };
+};
+
+// Frame-constant inputs (LightingUniforms in pbr_ps.hlsl)
+struct ShadingEnvironment {
+    float sunDirection[3] = { -0.5f, -1.0f, -0.5f }; // Points away from the sun
+    float sunColor[3] = { 1.0f, 1.0f, 1.0f };
+    float sunIntensity = 1.0f;
+    float cameraPosition[3] = { 0.0f, 0.0f, 5.0f };
+    float ambientColor[3] = { 1.0f, 1.0f, 1.0f };
+    float ambientIntensity = 0.3f;
+    std::shared_ptr<const IblData> ibl; // null selects the flat ambient fallback
+
+    static ShadingEnvironment FromFrame(const LightingData& lighting, const CameraData& camera) {
+        ShadingEnvironment env;
+        env.sunDirection[0] = lighting.sunDirectionX;
+        env.sunDirection[1] = lighting.sunDirectionY;
+        env.sunDirection[2] = lighting.sunDirectionZ;
+        env.sunColor[0] = lighting.sunColorR;
+        env.sunColor[1] = lighting.sunColorG;
+        env.sunColor[2] = lighting.sunColorB;
+        env.sunIntensity = lighting.sunIntensity;
+        env.cameraPosition[0] = camera.positionX;
+        env.cameraPosition[1] = camera.positionY;
+        env.cameraPosition[2] = camera.positionZ;
+        env.ambientColor[0] = lighting.ambientColorR;
+        env.ambientColor[1] = lighting.ambientColorG;
+        env.ambientColor[2] = lighting.ambientColorB;
+        env.ambientIntensity = lighting.ambientIntensity;
+        return env;
+    }
+};
+
+// Unpacked attributes of one fragment; batches hold one 8-lane row per plane
+enum SurfacePlane : uint32_t {
+    SURFACE_POSITION_X, SURFACE_POSITION_Y, SURFACE_POSITION_Z,
+    SURFACE_NORMAL_X, SURFACE_NORMAL_Y, SURFACE_NORMAL_Z,
+    SURFACE_ALBEDO_R, SURFACE_ALBEDO_G, SURFACE_ALBEDO_B,
+    SURFACE_METALLIC, SURFACE_ROUGHNESS, SURFACE_AO,
+    SURFACE_EMISSIVE_R, SURFACE_EMISSIVE_G, SURFACE_EMISSIVE_B,
+    SURFACE_PLANE_COUNT
+};
+
+// SoftwareShading - stateless shading kernels
+// Each BRDF term is a line-for-line port of lighting_common.hlsli evaluated on 8 lanes.
+class SoftwareShading {
+public:
+    // Shading-space values derived once per batch and reused for every light
+    struct SurfaceLanes {
+        Float8 normal[3];
+        Float8 view[3];
+        Float8 albedo[3];
+        Float8 f0[3];
+        Float8 metallic;
+        Float8 roughness;
+        Float8 nDotV;
+    };
+
+    // Gather 8 lanes (lanes[plane][lane]) into shading space
+    static SurfaceLanes PrepareSurface(const float lanes[SURFACE_PLANE_COUNT][8], const ShadingEnvironment& env) {
+        SurfaceLanes s;
+        for (int c = 0; c < 3; ++c) {
+            s.normal[c] = Float8::Load(lanes[SURFACE_NORMAL_X + c]);
+            s.view[c] = Float8::Broadcast(env.cameraPosition[c]) - Float8::Load(lanes[SURFACE_POSITION_X + c]);
+            s.albedo[c] = Float8::Load(lanes[SURFACE_ALBEDO_R + c]);
+        }
+        SafeNormalize(s.normal);
+        SafeNormalize(s.view);
+
+        s.metallic = Float8::Load(lanes[SURFACE_METALLIC]);
+        s.roughness = Float8::Load(lanes[SURFACE_ROUGHNESS]);
+        for (int c = 0; c < 3; ++c) {
+            s.f0[c] = Float8::Lerp(Float8::Broadcast(0.04f), s.albedo[c], s.metallic);
+        }
+        s.nDotV = Float8::Saturate(Dot(s.normal, s.view));
+        return s;
+    }
+
+    // Cook-Torrance + Lambert for one light direction per lane; adds into lo
+    // radiance is the incoming light colour after intensity and attenuation
+    static void AccumulateDirect(const SurfaceLanes& s, const Float8 light[3], const Float8 radiance[3], Float8 lo[3]) {
+        const Float8 one = Float8::Broadcast(1.0f);
+        const Float8 epsilon = Float8::Broadcast(SHADING_EPSILON);
+
+        Float8 half[3] = { s.view[0] + light[0], s.view[1] + light[1], s.view[2] + light[2] };
+        SafeNormalize(half);
+
+        Float8 nDotL = Float8::Saturate(Dot(s.normal, light));
+        Float8 nDotH = Float8::Saturate(Dot(s.normal, half));
+        Float8 hDotV = Float8::Saturate(Dot(half, s.view));
+
+        Float8 ndf = DistributionGgx(nDotH, s.roughness);
+        Float8 g = GeometrySchlickGgx(s.nDotV, s.roughness) * GeometrySchlickGgx(nDotL, s.roughness);
+        Float8 fresnelWeight = Pow5(one - hDotV);
+        Float8 denominator = Float8::Max(Float8::Broadcast(4.0f) * s.nDotV * nDotL, epsilon);
+        Float8 specularScale = ndf * g / denominator;
+        Float8 diffuseScale = (one - s.metallic) * Float8::Broadcast(1.0f / SHADING_PI);
+
+        for (int c = 0; c < 3; ++c) {
+            Float8 f = s.f0[c] + (one - s.f0[c]) * fresnelWeight;
+            Float8 kD = (one - f) * diffuseScale;
+            lo[c] = lo[c] + (kD * s.albedo[c] + specularScale * f) * radiance[c] * nDotL;
+        }
+    }
+
+    // The directional light of ShadingEnvironment
+    static void AccumulateSun(const SurfaceLanes& s, const ShadingEnvironment& env, Float8 lo[3]) {
+        Float8 light[3];
+        SunDirection(env, light);
+        Float8 radiance[3];
+        for (int c = 0; c < 3; ++c) {
+            radiance[c] = Float8::Broadcast(env.sunColor[c] * env.sunIntensity);
+        }
+        AccumulateDirect(s, light, radiance, lo);
+    }
+
+    // IBL (SH irradiance + prefiltered specular) or the flat ambient fallback
+    static void AccumulateAmbient(const SurfaceLanes& s, const Float8& ao, const ShadingEnvironment& env, Float8 color[3]) {
+        if (!env.ibl) {
+            Float8 scale = ao * Float8::Broadcast(env.ambientIntensity);
+            for (int c = 0; c < 3; ++c) {
+                color[c] = color[c] + Float8::Broadcast(env.ambientColor[c]) * s.albedo[c] * scale;
+            }
+            return;
+        }
+
+        const IblData& ibl = *env.ibl;
+        const Float8 one = Float8::Broadcast(1.0f);
+        Float8 fresnelWeight = Pow5(one - s.nDotV);
+        Float8 smooth = one - s.roughness;
+
+        // SH9 irradiance, already divided by pi at bake time
+        const Float8& x = s.normal[0];
+        const Float8& y = s.normal[1];
+        const Float8& z = s.normal[2];
+        Float8 basis[9] = {
+            Float8::Broadcast(0.282095f),
+            Float8::Broadcast(0.488603f) * y,
+            Float8::Broadcast(0.488603f) * z,
+            Float8::Broadcast(0.488603f) * x,
+            Float8::Broadcast(1.092548f) * x * y,
+            Float8::Broadcast(1.092548f) * y * z,
+            Float8::Broadcast(0.315392f) * (Float8::Broadcast(3.0f) * z * z - one),
+            Float8::Broadcast(1.092548f) * x * z,
+            Float8::Broadcast(0.546274f) * (x * x - y * y)
+        };
+
+        // R = reflect(-V, N); cube lookups are gathers, so they stay scalar per lane
+        Float8 twoNDotV = Float8::Broadcast(2.0f) * Dot(s.normal, s.view);
+        float reflected[3][8];
+        for (int c = 0; c < 3; ++c) {
+            (twoNDotV * s.normal[c] - s.view[c]).Store(reflected[c]);
+        }
+        float roughness[8];
+        s.roughness.Store(roughness);
+
+        // pbr_ps hardcodes maxReflectionLOD = 4 for the default 5-mip bake
+        float maxLod = static_cast<float>(ibl.prefiltered.empty() ? 0 : ibl.prefiltered.size() - 1);
+        float prefiltered[3][8];
+        for (int lane = 0; lane < 8; ++lane) {
+            float sample[3];
+            ibl.SamplePrefiltered(reflected[0][lane], reflected[1][lane], reflected[2][lane],
+                                  roughness[lane] * maxLod, sample);
+            prefiltered[0][lane] = sample[0];
+            prefiltered[1][lane] = sample[1];
+            prefiltered[2][lane] = sample[2];
+        }
+
+        for (int c = 0; c < 3; ++c) {
+            Float8 irradiance = Float8::Broadcast(0.0f);
+            for (int i = 0; i < 9; ++i) {
+                irradiance = irradiance + Float8::Broadcast(ibl.sh[i * 3 + c]) * basis[i];
+            }
+            irradiance = Float8::Max(irradiance, Float8::Broadcast(0.0f));
+
+            // FresnelSchlickRoughness
+            Float8 f = s.f0[c] + (Float8::Max(smooth, s.f0[c]) - s.f0[c]) * fresnelWeight;
+            Float8 kD = (one - f) * (one - s.metallic);
+            Float8 specular = Float8::Load(prefiltered[c]) * f;
+            color[c] = color[c] + (kD * irradiance * s.albedo[c] + specular) * ao;
+        }
+    }
+
+    // Full pbr_ps evaluation before tone mapping: ambient + sun + emissive
+    static void ShadeBatch(const float lanes[SURFACE_PLANE_COUNT][8], const ShadingEnvironment& env, float outRgb[3][8]) {
+        SurfaceLanes s = PrepareSurface(lanes, env);
+
+        Float8 color[3] = { Float8::Broadcast(0.0f), Float8::Broadcast(0.0f), Float8::Broadcast(0.0f) };
+        AccumulateSun(s, env, color);
+        AccumulateAmbient(s, Float8::Load(lanes[SURFACE_AO]), env, color);
+
+        for (int c = 0; c < 3; ++c) {
+            (color[c] + Float8::Load(lanes[SURFACE_EMISSIVE_R + c])).Store(outRgb[c]);
+        }
+    }
+
+    // Reinhard + gamma 2.2 as at the end of pbr_ps, packed to 0xAARRGGBB
+    // Rather than pow per channel, the tone-mapped value's float bits index a table of
+    // lower-bound bytes, and one boundary compare finishes the rounding exactly
+    static uint32_t ResolvePixel(float r, float g, float b) {
+        static const GammaTable table = MakeGammaTable();
+        auto channel = [](float value) {
+            value = value > 0.0f ? value : 0.0f; // also maps NaN to black
+            float mapped = value / (value + 1.0f);
+            mapped = mapped <= 1.0f ? mapped : 1.0f; // inf / inf
+            uint32_t bits;
+            std::memcpy(&bits, &mapped, sizeof(bits));
+            uint32_t byte = table.guess[bits >> 16];
+            while (byte < 255 && mapped >= table.boundaries[byte + 1]) {
+                ++byte;
+            }
+            return byte;
+        };
+        return 0xFF000000u | (channel(r) << 16) | (channel(g) << 8) | channel(b);
+    }
+
+    // Batch kernel checked against a scalar transcription of pbr_ps.hlsl
+    static void RegisterTests() {
+        TestManagerNew& tests = TestManagerNew::Instance();
+        tests.RegisterSuite("SoftwareShading");
+
+        tests.AddTest("SoftwareShading", "Batch matches scalar pbr_ps", []() {
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            std::uniform_real_distribution<float> signedUnit(-1.0f, 1.0f);
+
+            ShadingEnvironment flat;
+            flat.sunColor[1] = 0.8f;
+            flat.sunIntensity = 3.0f;
+            flat.cameraPosition[0] = 2.0f;
+
+            ShadingEnvironment lit = flat;
+            lit.ibl = MakeTestEnvironment();
+
+            for (const ShadingEnvironment* env : { &flat, &lit }) {
+                for (int batch = 0; batch < 64; ++batch) {
+                    alignas(32) float lanes[SURFACE_PLANE_COUNT][8];
+                    for (int lane = 0; lane < 8; ++lane) {
+                        for (uint32_t plane = 0; plane < SURFACE_PLANE_COUNT; ++plane) {
+                            bool signedPlane = plane <= SURFACE_NORMAL_Z;
+                            lanes[plane][lane] = signedPlane ? signedUnit(rng) : unit(rng);
+                        }
+                        // Include the clamped edges of the material range
+                        if (lane == 0) {
+                            lanes[SURFACE_ROUGHNESS][lane] = 0.0f;
+                            lanes[SURFACE_METALLIC][lane] = 1.0f;
+                        }
+                    }
+
+                    float rgb[3][8];
+                    ShadeBatch(lanes, *env, rgb);
+                    for (int lane = 0; lane < 8; ++lane) {
+                        float sample[SURFACE_PLANE_COUNT];
+                        for (uint32_t plane = 0; plane < SURFACE_PLANE_COUNT; ++plane) {
+                            sample[plane] = lanes[plane][lane];
+                        }
+                        float reference[3];
+                        ShadeScalar(sample, *env, reference);
+                        for (int c = 0; c < 3; ++c) {
+                            float tolerance = 1e-4f * std::max(1.0f, std::fabs(reference[c]));
+                            if (!(std::fabs(rgb[c][lane] - reference[c]) <= tolerance)) {
+                                return false;
+                            }
+                        }
+                    }
+                }
+            }
+            return true;
+        });
+    }
+
+    // Small gradient sky so SH and prefilter lookups vary with direction (tests and benchmarks)
+    static std::shared_ptr<const IblData> MakeTestEnvironment() {
+        HdrImage sky;
+        sky.width = 32;
+        sky.height = 16;
+        sky.pixels.resize(32 * 16 * 4);
+        for (uint32_t y = 0; y < sky.height; ++y) {
+            for (uint32_t x = 0; x < sky.width; ++x) {
+                float* texel = sky.pixels.data() + (static_cast<size_t>(y) * sky.width + x) * 4;
+                texel[0] = 2.0f * (1.0f - y / 16.0f);
+                texel[1] = 0.5f + x / 32.0f;
+                texel[2] = 0.25f;
+                texel[3] = 1.0f;
+            }
+        }
+
+        IblSettings settings;
+        settings.cubeSize = 8;
+        settings.specularSamples = 16;
+        settings.lutSize = 4;
+        settings.lutSamples = 4;
+
+        auto data = std::make_shared<IblData>();
+        IblBaker::Bake(sky, settings, *data);
+        return data;
+    }
+
+    // Prevent instantiation (static API)
+    SoftwareShading() = delete;
+
+private:
+    static Float8 Dot(const Float8 a[3], const Float8 b[3]) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    // length > EPSILON ? v / length : 0, as in math_utils.hlsli
+    static void SafeNormalize(Float8 v[3]) {
+        Float8 length = Float8::Sqrt(Dot(v, v));
+        Float8 valid = Float8::Greater(length, Float8::Broadcast(SHADING_EPSILON));
+        Float8 inverse = Float8::Select(valid, Float8::Broadcast(1.0f) / length, Float8::Broadcast(0.0f));
+        for (int c = 0; c < 3; ++c) {
+            v[c] = v[c] * inverse;
+        }
+    }
+
+    // boundaries[k] = ((k - 0.5) / 255)^2.2, the smallest linear value that rounds to k
+    // guess[bits >> 16] = the byte at the low edge of each 2^-7 relative-width bucket;
+    // a bucket spans less than one output step, so a single correction suffices
+    struct GammaTable {
+        std::array<float, 256> boundaries;
+        std::array<uint8_t, (0x3F800000u >> 16) + 1> guess;
+    };
+
+    static GammaTable MakeGammaTable() {
+        GammaTable table;
+        table.boundaries[0] = 0.0f;
+        for (int k = 1; k < 256; ++k) {
+            table.boundaries[k] = static_cast<float>(std::pow((k - 0.5) / 255.0, 2.2));
+        }
+        uint32_t byte = 0;
+        for (uint32_t bucket = 0; bucket < table.guess.size(); ++bucket) {
+            uint32_t bits = bucket << 16;
+            float low;
+            std::memcpy(&low, &bits, sizeof(low));
+            while (byte < 255 && low >= table.boundaries[byte + 1]) {
+                ++byte;
+            }
+            table.guess[bucket] = static_cast<uint8_t>(byte);
+        }
+        return table;
+    }
+
+    static Float8 Pow5(Float8 x) {
+        Float8 x2 = x * x;
+        return x2 * x2 * x;
+    }
+
+    static Float8 DistributionGgx(Float8 nDotH, Float8 roughness) {
+        Float8 a = roughness * roughness;
+        Float8 a2 = a * a;
+        Float8 denominator = nDotH * nDotH * (a2 - Float8::Broadcast(1.0f)) + Float8::Broadcast(1.0f);
+        denominator = Float8::Broadcast(SHADING_PI) * denominator * denominator;
+        return a2 / Float8::Max(denominator, Float8::Broadcast(SHADING_EPSILON));
+    }
+
+    static Float8 GeometrySchlickGgx(Float8 nDotV, Float8 roughness) {
+        Float8 r = roughness + Float8::Broadcast(1.0f);
+        Float8 k = r * r * Float8::Broadcast(0.125f);
+        Float8 denominator = nDotV * (Float8::Broadcast(1.0f) - k) + k;
+        return nDotV / Float8::Max(denominator, Float8::Broadcast(SHADING_EPSILON));
+    }
+
+    static void SunDirection(const ShadingEnvironment& env, Float8 out[3]) {
+        const float* d = env.sunDirection;
+        float length = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        float inverse = length > 0.0f ? -1.0f / length : 0.0f;
+        for (int c = 0; c < 3; ++c) {
+            out[c] = Float8::Broadcast(d[c] * inverse);
+        }
+    }
+
+    // Straight transcription of pbr_ps.hlsl for one fragment (test reference only)
+    static void ShadeScalar(const float sample[SURFACE_PLANE_COUNT], const ShadingEnvironment& env, float out[3]) {
+        auto dot = [](const float* a, const float* b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+        auto saturate = [](float v) { return std::min(std::max(v, 0.0f), 1.0f); };
+        auto safeNormalize = [&](float* v) {
+            float length = std::sqrt(dot(v, v));
+            float scale = length > SHADING_EPSILON ? 1.0f / length : 0.0f;
+            v[0] *= scale;
+            v[1] *= scale;
+            v[2] *= scale;
+        };
+
+        float n[3] = { sample[SURFACE_NORMAL_X], sample[SURFACE_NORMAL_Y], sample[SURFACE_NORMAL_Z] };
+        safeNormalize(n);
+        float v[3];
+        for (int c = 0; c < 3; ++c) {
+            v[c] = env.cameraPosition[c] - sample[SURFACE_POSITION_X + c];
+        }
+        safeNormalize(v);
+
+        const float* albedo = sample + SURFACE_ALBEDO_R;
+        float metallic = sample[SURFACE_METALLIC];
+        float roughness = sample[SURFACE_ROUGHNESS];
+        float f0[3];
+        for (int c = 0; c < 3; ++c) {
+            f0[c] = 0.04f + (albedo[c] - 0.04f) * metallic;
+        }
+
+        float l[3] = { -env.sunDirection[0], -env.sunDirection[1], -env.sunDirection[2] };
+        safeNormalize(l);
+        float h[3] = { v[0] + l[0], v[1] + l[1], v[2] + l[2] };
+        safeNormalize(h);
+
+        float a2 = roughness * roughness * roughness * roughness;
+        float nDotH = saturate(dot(n, h));
+        float ndfDenominator = nDotH * nDotH * (a2 - 1.0f) + 1.0f;
+        float ndf = a2 / std::max(SHADING_PI * ndfDenominator * ndfDenominator, SHADING_EPSILON);
+
+        float k = (roughness + 1.0f) * (roughness + 1.0f) / 8.0f;
+        float nDotV = saturate(dot(n, v));
+        float nDotL = saturate(dot(n, l));
+        float g = nDotV / std::max(nDotV * (1.0f - k) + k, SHADING_EPSILON) *
+                  nDotL / std::max(nDotL * (1.0f - k) + k, SHADING_EPSILON);
+        float hDotV = saturate(dot(h, v));
+
+        for (int c = 0; c < 3; ++c) {
+            float f = f0[c] + (1.0f - f0[c]) * std::pow(1.0f - hDotV, 5.0f);
+            float specular = ndf * g * f / std::max(4.0f * nDotV * nDotL, SHADING_EPSILON);
+            float kD = (1.0f - f) * (1.0f - metallic);
+            float lo = (kD * albedo[c] / SHADING_PI + specular) * env.sunColor[c] * env.sunIntensity * nDotL;
+
+            float ambient;
+            if (env.ibl) {
+                float fr = f0[c] + (std::max(1.0f - roughness, f0[c]) - f0[c]) * std::pow(1.0f - nDotV, 5.0f);
+                float kDr = (1.0f - fr) * (1.0f - metallic);
+                float irradiance[3];
+                env.ibl->EvaluateIrradiance(n[0], n[1], n[2], irradiance);
+                float r[3] = { 2.0f * dot(n, v) * n[0] - v[0], 2.0f * dot(n, v) * n[1] - v[1], 2.0f * dot(n, v) * n[2] - v[2] };
+                float prefiltered[3];
+                env.ibl->SamplePrefiltered(r[0], r[1], r[2], roughness * (env.ibl->prefiltered.size() - 1), prefiltered);
+                ambient = (kDr * irradiance[c] * albedo[c] + prefiltered[c] * fr) * sample[SURFACE_AO];
+            } else {
+                ambient = env.ambientColor[c] * albedo[c] * env.ambientIntensity * sample[SURFACE_AO];
+            }
+            out[c] = ambient + lo + sample[SURFACE_EMISSIVE_R + c];
+        }
+    }
+};
+
+// Note on usage:
+// Kernels take fragments already unpacked into lanes[plane][lane]; SoftwareDeferred.h
+// decodes its G-buffer into that layout. AccumulateDirect() takes per-lane light vectors
+// so point and spot lights reuse the same BRDF as the sun.
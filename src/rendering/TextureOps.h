@@ -0,0 +1,548 @@
+/** TextureOps - Channel split, pack and swizzle on decoded 8-bit textures
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "../core/Parallel.h"
+#include "../core/TestManagerNew.h"
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <tmmintrin.h>
+    #define BF_TEXTURE_SSSE3 1
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define BF_TEXTURE_NEON 1
+#endif
+
+// pshufb is SSSE3; GCC/Clang compile that path for the target only and pick it at
+// runtime, so the engine keeps its baseline -march
+#if defined(BF_TEXTURE_SSSE3) && (defined(__GNUC__) || defined(__clang__))
+    #define BF_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+    #define BF_TARGET_SSSE3
+#endif
+
+// 8-bit texture, channels interleaved (1 = gray, 2 = gray + alpha, 3 = RGB, 4 = RGBA);
+// rows top to bottom with no padding
+struct TextureImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t channels = 0;
+    std::vector<uint8_t> pixels;
+
+    size_t PixelCount() const { return static_cast<size_t>(width) * height; }
+
+    bool IsValid() const {
+        return width > 0 && height > 0 && channels >= 1 && channels <= 4 && pixels.size() == PixelCount() * channels;
+    }
+};
+
+// Where one destination channel gets its bytes
+struct ChannelSelect {
+    enum class Source : uint8_t {
+        CHANNEL,        // A channel of the source pixel
+        CONSTANT,       // A fixed byte
+        KEEP            // Whatever the destination already holds
+    };
+
+    Source source = Source::KEEP;
+    uint8_t value = 0;          // Source channel index for CHANNEL, the byte for CONSTANT
+
+    static ChannelSelect Channel(uint8_t channel) { return { Source::CHANNEL, channel }; }
+    static ChannelSelect Constant(uint8_t value) { return { Source::CONSTANT, value }; }
+    static ChannelSelect Keep() { return { Source::KEEP, 0 }; }
+};
+
+// One channel of a Pack() result: `channel` of `image`, or `constant` when image is null
+struct PackInput {
+    const TextureImage* image = nullptr;
+    uint32_t channel = 0;
+    uint8_t constant = 0;
+};
+
+// TextureOps - stateless entry points
+// Every operation is one kernel, Remap(): each destination channel is picked from a
+// source channel, a constant, or left alone. On SSSE3 / NEON one step gathers 16
+// destination bytes from up to four 16-byte source loads with byte shuffles and blends
+// them over the destination, so split (4 -> 1), pack (1 -> 4) and swizzle (4 -> 4) all
+// run without per-byte branches. Images are processed in parallel pixel ranges.
+class TextureOps {
+public:
+    // Remap `count` pixels. CHANNEL indices must be below srcChannels; both channel counts are 1-4.
+    // allowSimd = false forces the scalar path (tests compare the two).
+    static void Remap(const uint8_t* src, uint32_t srcChannels, uint8_t* dst, uint32_t dstChannels,
+                      const ChannelSelect* select, size_t count, bool allowSimd = true) {
+        size_t done = 0;
+#if defined(BF_TEXTURE_SSSE3) || defined(BF_TEXTURE_NEON)
+        if (allowSimd && HasSimd() && count >= 16) {
+            RemapPlan plan = BuildPlan(srcChannels, dstChannels, select);
+    #if defined(BF_TEXTURE_SSSE3)
+            done = RemapSsse3(src, dst, plan, count);
+    #else
+            done = RemapNeon(src, dst, plan, count);
+    #endif
+        }
+#else
+        (void)allowSimd;
+#endif
+        RemapScalar(src + done * srcChannels, srcChannels, dst + done * dstChannels, dstChannels, select, count - done);
+    }
+
+    // True when Remap() runs on byte shuffles
+    static bool HasSimd() {
+#if defined(BF_TEXTURE_NEON)
+        return true;
+#elif defined(BF_TEXTURE_SSSE3)
+        static const bool supported = DetectSsse3();
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    // Reorder channels by pattern, one character per output channel: r/g/b/a (or x/y/z/w)
+    // read a source channel, '0' and '1' write 0 and 255. "bgra" swaps red and blue,
+    // "rgb1" adds opaque alpha, "g" extracts green. `out` may alias `src`.
+    static bool Swizzle(const TextureImage& src, const std::string& pattern, TextureImage& out,
+                        std::string* error = nullptr, size_t workerCount = 0) {
+        if (!src.IsValid()) {
+            return Fail(error, "source texture is empty or malformed");
+        }
+        if (pattern.empty() || pattern.size() > 4) {
+            return Fail(error, "swizzle pattern must have 1-4 characters, got \"" + pattern + "\"");
+        }
+
+        ChannelSelect select[4];
+        for (size_t k = 0; k < pattern.size(); ++k) {
+            if (!ParseSwizzle(pattern[k], src.channels, select[k])) {
+                return Fail(error, std::string("swizzle character '") + pattern[k] + "' is not valid for a " +
+                    std::to_string(src.channels) + "-channel texture");
+            }
+        }
+
+        TextureImage result;
+        result.width = src.width;
+        result.height = src.height;
+        result.channels = static_cast<uint32_t>(pattern.size());
+        result.pixels.resize(result.PixelCount() * result.channels);
+        Parallel::ForRange(src.PixelCount(), PIXELS_PER_TASK, [&](size_t begin, size_t end) {
+            Remap(src.pixels.data() + begin * src.channels, src.channels,
+                  result.pixels.data() + begin * result.channels, result.channels, select, end - begin);
+        }, workerCount);
+        out = std::move(result);
+        return true;
+    }
+
+    // One gray plane per source channel; empty when the source is malformed
+    static std::vector<TextureImage> Split(const TextureImage& src, size_t workerCount = 0) {
+        std::vector<TextureImage> planes;
+        if (!src.IsValid()) {
+            return planes;
+        }
+
+        planes.resize(src.channels);
+        for (TextureImage& plane : planes) {
+            plane.width = src.width;
+            plane.height = src.height;
+            plane.channels = 1;
+            plane.pixels.resize(src.PixelCount());
+        }
+        // All planes per range, so each source range is read from cache after the first plane
+        Parallel::ForRange(src.PixelCount(), PIXELS_PER_TASK, [&](size_t begin, size_t end) {
+            for (uint32_t c = 0; c < src.channels; ++c) {
+                ChannelSelect select = ChannelSelect::Channel(static_cast<uint8_t>(c));
+                Remap(src.pixels.data() + begin * src.channels, src.channels, planes[c].pixels.data() + begin, 1,
+                      &select, end - begin);
+            }
+        }, workerCount);
+        return planes;
+    }
+
+    // Build a texture with one output channel per input. All source images must share
+    // one size; constants fill the remaining channels.
+    static bool Pack(const std::vector<PackInput>& inputs, TextureImage& out, std::string* error = nullptr,
+                     size_t workerCount = 0) {
+        if (inputs.empty() || inputs.size() > 4) {
+            return Fail(error, "pack needs 1-4 channels, got " + std::to_string(inputs.size()));
+        }
+
+        // Distinct source images in first-use order; each becomes one Remap pass
+        std::vector<const TextureImage*> sources;
+        for (size_t k = 0; k < inputs.size(); ++k) {
+            const TextureImage* image = inputs[k].image;
+            if (image == nullptr) {
+                continue;
+            }
+            if (!image->IsValid()) {
+                return Fail(error, "pack input " + std::to_string(k) + " is empty or malformed");
+            }
+            if (inputs[k].channel >= image->channels) {
+                return Fail(error, "pack input " + std::to_string(k) + " reads channel " +
+                    std::to_string(inputs[k].channel) + " of a " + std::to_string(image->channels) + "-channel texture");
+            }
+            if (!sources.empty() && (image->width != sources[0]->width || image->height != sources[0]->height)) {
+                return Fail(error, "pack inputs differ in size (" + std::to_string(sources[0]->width) + "x" +
+                    std::to_string(sources[0]->height) + " vs " + std::to_string(image->width) + "x" +
+                    std::to_string(image->height) + ")");
+            }
+            if (std::find(sources.begin(), sources.end(), image) == sources.end()) {
+                sources.push_back(image);
+            }
+        }
+        if (sources.empty()) {
+            return Fail(error, "pack needs at least one source texture");
+        }
+
+        // The first pass writes every channel (constants included, later sources as
+        // placeholders); later passes write their own channels and keep the rest
+        std::vector<std::array<ChannelSelect, 4>> passes(sources.size());
+        for (size_t s = 0; s < sources.size(); ++s) {
+            for (size_t k = 0; k < inputs.size(); ++k) {
+                if (inputs[k].image == sources[s]) {
+                    passes[s][k] = ChannelSelect::Channel(static_cast<uint8_t>(inputs[k].channel));
+                } else if (s == 0) {
+                    passes[s][k] = ChannelSelect::Constant(inputs[k].image == nullptr ? inputs[k].constant : 0);
+                }
+            }
+        }
+
+        TextureImage result;
+        result.width = sources[0]->width;
+        result.height = sources[0]->height;
+        result.channels = static_cast<uint32_t>(inputs.size());
+        result.pixels.resize(result.PixelCount() * result.channels);
+        Parallel::ForRange(result.PixelCount(), PIXELS_PER_TASK, [&](size_t begin, size_t end) {
+            for (size_t s = 0; s < sources.size(); ++s) {
+                Remap(sources[s]->pixels.data() + begin * sources[s]->channels, sources[s]->channels,
+                      result.pixels.data() + begin * result.channels, result.channels, passes[s].data(), end - begin);
+            }
+        }, workerCount);
+        out = std::move(result);
+        return true;
+    }
+
+    // SIMD == scalar for every channel combination, split/pack round trip, swizzle rules
+    static void RegisterTests();
+    // Split, pack and swizzle over an edge x edge RGBA texture
+    static void RegisterBenchmarks(uint32_t edge = 4096);
+
+    // Prevent instantiation (static API)
+    TextureOps() = delete;
+
+private:
+    static constexpr size_t PIXELS_PER_TASK = 1u << 16;
+
+    // Shuffle tables for one SIMD step: `pixels` pixels fill one 16-byte destination
+    // vector, gathered from `loads` consecutive 16-byte source vectors. Indices with the
+    // high bit set produce zero (pshufb and tbl agree on that), so the per-load results
+    // OR together; `write` marks the bytes the step owns, everything else is blended back.
+    struct RemapPlan {
+        uint32_t srcChannels = 0;
+        uint32_t dstChannels = 0;
+        uint32_t pixels = 0;
+        uint32_t loads = 0;
+        alignas(16) uint8_t shuffle[4][16];
+        alignas(16) uint8_t fill[16];
+        alignas(16) uint8_t write[16];
+    };
+
+    static bool Fail(std::string* error, const std::string& message) {
+        if (error != nullptr) {
+            *error = message;
+        }
+        return false;
+    }
+
+    static bool ParseSwizzle(char c, uint32_t channels, ChannelSelect& select) {
+        static const char NAMES[] = "rgba";
+        static const char ALIASES[] = "xyzw";
+        if (c == '0' || c == '1') {
+            select = ChannelSelect::Constant(c == '1' ? 255 : 0);
+            return true;
+        }
+        for (uint32_t i = 0; i < 4; ++i) {
+            if (c == NAMES[i] || c == ALIASES[i]) {
+                select = ChannelSelect::Channel(static_cast<uint8_t>(i));
+                return i < channels;
+            }
+        }
+        return false;
+    }
+
+    static RemapPlan BuildPlan(uint32_t srcChannels, uint32_t dstChannels, const ChannelSelect* select) {
+        RemapPlan plan;
+        plan.srcChannels = srcChannels;
+        plan.dstChannels = dstChannels;
+        plan.pixels = 16 / dstChannels;
+        plan.loads = (plan.pixels * srcChannels + 15) / 16;
+        std::memset(plan.shuffle, 0x80, sizeof(plan.shuffle));
+        std::memset(plan.fill, 0, sizeof(plan.fill));
+        std::memset(plan.write, 0, sizeof(plan.write));
+
+        for (uint32_t p = 0; p < plan.pixels; ++p) {
+            for (uint32_t k = 0; k < dstChannels; ++k) {
+                uint32_t byte = p * dstChannels + k;
+                if (select[k].source == ChannelSelect::Source::CHANNEL) {
+                    uint32_t from = p * srcChannels + select[k].value;
+                    plan.shuffle[from / 16][byte] = static_cast<uint8_t>(from % 16);
+                    plan.write[byte] = 0xFF;
+                } else if (select[k].source == ChannelSelect::Source::CONSTANT) {
+                    plan.fill[byte] = select[k].value;
+                    plan.write[byte] = 0xFF;
+                }
+            }
+        }
+        return plan;
+    }
+
+    static void RemapScalar(const uint8_t* src, uint32_t srcChannels, uint8_t* dst, uint32_t dstChannels,
+                            const ChannelSelect* select, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t* in = src + i * srcChannels;
+            uint8_t* out = dst + i * dstChannels;
+            for (uint32_t k = 0; k < dstChannels; ++k) {
+                if (select[k].source == ChannelSelect::Source::CHANNEL) {
+                    out[k] = in[select[k].value];
+                } else if (select[k].source == ChannelSelect::Source::CONSTANT) {
+                    out[k] = select[k].value;
+                }
+            }
+        }
+    }
+
+    // Pixels a SIMD loop may take: every step reads `loads` whole source vectors and
+    // rewrites one whole destination vector, all of which must stay inside this call's range
+    static size_t SimdPixelLimit(const RemapPlan& plan, size_t count) {
+        size_t srcBytes = count * plan.srcChannels;
+        size_t dstBytes = count * plan.dstChannels;
+        size_t bySource = srcBytes >= plan.loads * 16 ? (srcBytes - plan.loads * 16) / plan.srcChannels + 1 : 0;
+        size_t byDestination = dstBytes >= 16 ? (dstBytes - 16) / plan.dstChannels + 1 : 0;
+        return std::min(bySource, byDestination);
+    }
+
+#if defined(BF_TEXTURE_SSSE3)
+    static bool DetectSsse3() {
+    #if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 9)) != 0;
+    #else
+        return __builtin_cpu_supports("ssse3");
+    #endif
+    }
+
+    // Returns the number of pixels remapped; the caller finishes the tail
+    BF_TARGET_SSSE3
+    static size_t RemapSsse3(const uint8_t* src, uint8_t* dst, const RemapPlan& plan, size_t count) {
+        __m128i shuffle[4];
+        for (uint32_t r = 0; r < plan.loads; ++r) {
+            shuffle[r] = _mm_load_si128(reinterpret_cast<const __m128i*>(plan.shuffle[r]));
+        }
+        const __m128i fill = _mm_load_si128(reinterpret_cast<const __m128i*>(plan.fill));
+        const __m128i write = _mm_load_si128(reinterpret_cast<const __m128i*>(plan.write));
+
+        size_t limit = SimdPixelLimit(plan, count);
+        size_t i = 0;
+        for (; i + plan.pixels <= limit; i += plan.pixels) {
+            const uint8_t* in = src + i * plan.srcChannels;
+            uint8_t* out = dst + i * plan.dstChannels;
+            __m128i value = fill;
+            for (uint32_t r = 0; r < plan.loads; ++r) {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + r * 16));
+                value = _mm_or_si128(value, _mm_shuffle_epi8(bytes, shuffle[r]));
+            }
+            __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(out));
+            value = _mm_or_si128(_mm_and_si128(write, value), _mm_andnot_si128(write, previous));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), value);
+        }
+        return i;
+    }
+#endif
+
+#if defined(BF_TEXTURE_NEON)
+    static size_t RemapNeon(const uint8_t* src, uint8_t* dst, const RemapPlan& plan, size_t count) {
+        uint8x16_t shuffle[4];
+        for (uint32_t r = 0; r < plan.loads; ++r) {
+            shuffle[r] = vld1q_u8(plan.shuffle[r]);
+        }
+        const uint8x16_t fill = vld1q_u8(plan.fill);
+        const uint8x16_t write = vld1q_u8(plan.write);
+
+        size_t limit = SimdPixelLimit(plan, count);
+        size_t i = 0;
+        for (; i + plan.pixels <= limit; i += plan.pixels) {
+            const uint8_t* in = src + i * plan.srcChannels;
+            uint8_t* out = dst + i * plan.dstChannels;
+            uint8x16_t value = fill;
+            for (uint32_t r = 0; r < plan.loads; ++r) {
+                value = vorrq_u8(value, vqtbl1q_u8(vld1q_u8(in + r * 16), shuffle[r]));
+            }
+            vst1q_u8(out, vbslq_u8(write, value, vld1q_u8(out)));
+        }
+        return i;
+    }
+#endif
+};
+
+inline void TextureOps::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("TextureOps");
+
+    tests.AddTest("TextureOps", "SIMD remap matches scalar for every channel layout", []() {
+        uint32_t seed = 12345;
+        auto next = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return seed >> 8;
+        };
+
+        for (uint32_t srcChannels = 1; srcChannels <= 4; ++srcChannels) {
+            for (uint32_t dstChannels = 1; dstChannels <= 4; ++dstChannels) {
+                for (size_t count : { 1u, 15u, 16u, 33u, 257u, 1001u }) {
+                    ChannelSelect select[4];
+                    for (uint32_t k = 0; k < dstChannels; ++k) {
+                        uint32_t kind = next() % 4;
+                        select[k] = kind == 0 ? ChannelSelect::Constant(static_cast<uint8_t>(next())) :
+                                    kind == 1 ? ChannelSelect::Keep() :
+                                    ChannelSelect::Channel(static_cast<uint8_t>(next() % srcChannels));
+                    }
+
+                    std::vector<uint8_t> src(count * srcChannels);
+                    std::vector<uint8_t> fast(count * dstChannels);
+                    for (uint8_t& byte : src) {
+                        byte = static_cast<uint8_t>(next());
+                    }
+                    for (uint8_t& byte : fast) {
+                        byte = static_cast<uint8_t>(next());
+                    }
+                    std::vector<uint8_t> reference = fast;
+                    Remap(src.data(), srcChannels, fast.data(), dstChannels, select, count, true);
+                    Remap(src.data(), srcChannels, reference.data(), dstChannels, select, count, false);
+                    if (fast != reference) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    });
+
+    tests.AddTest("TextureOps", "Split then pack round-trips", []() {
+        TextureImage orm;
+        orm.width = 131;
+        orm.height = 77;
+        orm.channels = 4;
+        orm.pixels.resize(orm.PixelCount() * 4);
+        for (size_t i = 0; i < orm.pixels.size(); ++i) {
+            orm.pixels[i] = static_cast<uint8_t>((i * 2654435761u) >> 11);
+        }
+
+        std::vector<TextureImage> planes = Split(orm, 3);
+        if (planes.size() != 4 || planes[2].pixels[5] != orm.pixels[5 * 4 + 2]) {
+            return false;
+        }
+
+        TextureImage packed;
+        std::vector<PackInput> inputs = { { &planes[0], 0, 0 }, { &planes[1], 0, 0 }, { &planes[2], 0, 0 },
+                                          { &planes[3], 0, 0 } };
+        if (!Pack(inputs, packed, nullptr, 3) || packed.pixels != orm.pixels) {
+            return false;
+        }
+
+        // Channels of one source image plus a constant, in a different order
+        TextureImage mixed;
+        inputs = { { &orm, 2, 0 }, { nullptr, 0, 200 }, { &planes[0], 0, 0 } };
+        if (!Pack(inputs, mixed) || mixed.channels != 3) {
+            return false;
+        }
+        for (size_t i = 0; i < orm.PixelCount(); ++i) {
+            const uint8_t* p = mixed.pixels.data() + i * 3;
+            if (p[0] != orm.pixels[i * 4 + 2] || p[1] != 200 || p[2] != orm.pixels[i * 4]) {
+                return false;
+            }
+        }
+
+        // Size mismatch and constant-only packs are errors
+        TextureImage small;
+        small.width = small.height = small.channels = 1;
+        small.pixels = { 7 };
+        std::string error;
+        return !Pack({ { &orm, 0, 0 }, { &small, 0, 0 } }, mixed, &error) && !error.empty() &&
+               !Pack({ { nullptr, 0, 1 } }, mixed);
+    });
+
+    tests.AddTest("TextureOps", "Swizzle patterns", []() {
+        TextureImage rgb;
+        rgb.width = 19;
+        rgb.height = 3;
+        rgb.channels = 3;
+        rgb.pixels.resize(rgb.PixelCount() * 3);
+        for (size_t i = 0; i < rgb.pixels.size(); ++i) {
+            rgb.pixels[i] = static_cast<uint8_t>(i);
+        }
+
+        TextureImage bgra;
+        TextureImage gray;
+        if (!Swizzle(rgb, "bgr1", bgra) || !Swizzle(rgb, "y", gray) || bgra.channels != 4 || gray.channels != 1) {
+            return false;
+        }
+        for (size_t i = 0; i < rgb.PixelCount(); ++i) {
+            const uint8_t* s = rgb.pixels.data() + i * 3;
+            const uint8_t* d = bgra.pixels.data() + i * 4;
+            if (d[0] != s[2] || d[1] != s[1] || d[2] != s[0] || d[3] != 255 || gray.pixels[i] != s[1]) {
+                return false;
+            }
+        }
+
+        // In place, and the failure cases: no alpha to read, bad characters, bad length
+        TextureImage copy = rgb;
+        return Swizzle(copy, "bgr", copy) && copy.pixels[0] == 2 && copy.pixels[2] == 0 &&
+               !Swizzle(rgb, "rgba", copy) && !Swizzle(rgb, "rq", copy) && !Swizzle(rgb, "", copy) &&
+               !Swizzle(rgb, "rgbar", copy);
+    });
+}
+
+inline void TextureOps::RegisterBenchmarks(uint32_t edge) {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    static TextureImage orm;
+    orm.width = orm.height = edge;
+    orm.channels = 4;
+    orm.pixels.resize(orm.PixelCount() * 4);
+    for (size_t i = 0; i < orm.pixels.size(); ++i) {
+        orm.pixels[i] = static_cast<uint8_t>(i * 7 + (i >> 9));
+    }
+
+    std::string size = std::to_string(edge) + "x" + std::to_string(edge);
+    tests.AddBenchmark("TextureOps", "Split RGBA " + size, []() {
+        TestManagerNew::DoNotOptimize(Split(orm).size());
+    });
+    tests.AddBenchmark("TextureOps", "Swizzle bgra " + size, []() {
+        TextureImage out;
+        Swizzle(orm, "bgra", out);
+        TestManagerNew::DoNotOptimize(out.pixels.data());
+    });
+    tests.AddBenchmark("TextureOps", "Swizzle bgra " + size + " (scalar)", []() {
+        ChannelSelect select[4] = { ChannelSelect::Channel(2), ChannelSelect::Channel(1), ChannelSelect::Channel(0),
+                                    ChannelSelect::Channel(3) };
+        std::vector<uint8_t> out(orm.pixels.size());
+        Parallel::ForRange(orm.PixelCount(), PIXELS_PER_TASK, [&](size_t begin, size_t end) {
+            Remap(orm.pixels.data() + begin * 4, 4, out.data() + begin * 4, 4, select, end - begin, false);
+        });
+        TestManagerNew::DoNotOptimize(out.data());
+    });
+}
+
+// Note on usage:
+// Decode with PngCodec, run the op, encode with PngCodec; tools/bf-texture.cpp wires the
+// three together for the export pipeline (ORM split, channel packing, swizzles).
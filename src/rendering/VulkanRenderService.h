@@ -10,8 +10,12 @@
 #include "ShaderCompiler.h"
 #include "DescriptorManager.h"
 #include "BufferAllocator.h"
+#include "HotReloadService.h"
+#include "IblBaker.h"
 #include "../core/QuoteSystem.h"
 #include "../core/DebugWindow.h"
+#include "../core/FrameArena.h"
+#include "../core/MemoryBudget.h"
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -190,6 +194,9 @@ public:
         DestroyDescriptorLayouts();
         DestroyRenderPass();
 
+        // Stop watching before the compiler it references goes away
+        mHotReload.reset();
+
         // Destroy subsystems (RAII will handle cleanup)
         mBufferAllocator.reset();
         mDescriptorManager.reset();
@@ -207,6 +214,15 @@ public:
             return;
         }
 
+        // Apply config and shader edits at the frame boundary, before any recording
+        ApplyHotReload();
+
+        // Start a fresh draw list in the frame arena, sized from last frame
+        size_t lastDrawCount = mDrawList.size();
+        FrameArena::Instance().BeginFrame();
+        mDrawList = FrameVector<DrawCommand>();
+        mDrawList.reserve(lastDrawCount);
+
         // Acquire next swap chain image
         AcquireNextImage();
 
@@ -241,6 +257,9 @@ public:
         // Update frame counter and stats
         mFrameNumber++;
         UpdateFrameStats();
+
+        // Refresh memory high-water marks and budget warnings once per frame
+        MemoryBudget::Instance().Poll();
     }
 
     void SetCamera(const CameraData& camera) override {
@@ -316,6 +335,94 @@ public:
         return mFrameStats;
     }
 
+    // Watch the config file and shader tree; edits are applied at the next BeginFrame
+    // Call after Initialize so the watcher starts from the running config
+    bool EnableHotReload(const std::string& configPath, const std::string& shaderRoot) {
+        // Guard: not initialized
+        if (!mIsInitialized) {
+            QuoteSystem::Instance().Log("EnableHotReload: renderer not initialized",
+                QuoteSystem::MessageType::WARNING);
+            return false;
+        }
+
+        mHotReload = std::make_unique<HotReloadService>(*mShaderCompiler);
+        if (!configPath.empty()) {
+            mHotReload->WatchConfig(configPath, mConfig);
+        }
+        if (!shaderRoot.empty()) {
+            mHotReload->WatchShaderTree(shaderRoot);
+            RegisterHotReloadShaders(shaderRoot);
+        }
+        return mHotReload->Start();
+    }
+
+    void DisableHotReload() {
+        mHotReload.reset();
+    }
+
+    // Switch the IBL environment; an empty path disables IBL
+    // Bakes are cached in memory and under Cache/IBL, so repeat switches cost an upload only
+    bool SetEnvironmentMap(const std::string& hdrPath) {
+        if (hdrPath.empty()) {
+            mEnvironment.reset();
+            ReleaseEnvironment();
+            return true;
+        }
+
+        if (!mIblCache) {
+            mIblCache = std::make_unique<IblCache>();
+        }
+
+        std::shared_ptr<const IblData> data = mIblCache->Get(hdrPath);
+        // Guard: keep the previous environment when the new one cannot be loaded
+        if (!data) {
+            return false;
+        }
+
+        mEnvironment = data;
+        return UploadEnvironment(*mEnvironment);
+    }
+
+    // Apply a new config, rebuilding only what the diff requires
+    // Also the target of OnConfigChanged() for config.changed events
+    void ApplyConfig(const RenderConfig& config) {
+        uint32_t changes = RenderConfig::Diff(mConfig, config);
+
+        // Guard: nothing to do
+        if (changes == CONFIG_CHANGE_NONE) {
+            return;
+        }
+
+        mConfig = config;
+        WaitForDeviceIdle();
+
+        if (changes & CONFIG_CHANGE_SWAPCHAIN) {
+            RecreateSwapchainResources();
+        }
+        if (changes & CONFIG_CHANGE_PIPELINES) {
+            DestroyGraphicsPipeline();
+            CreateGraphicsPipeline();
+        }
+        if (changes & CONFIG_CHANGE_LIGHTING) {
+            mLightingData.ambientIntensity = config.ambientIntensity;
+            mLightingData.sunIntensity = config.sunIntensity;
+            UpdateLightingUniforms();
+        }
+        if (changes & CONFIG_CHANGE_CAMERA) {
+            mCameraData.fovDegrees = config.fovDegrees;
+            mCameraData.nearPlane = config.nearPlane;
+            mCameraData.farPlane = config.farPlane;
+            UpdateCameraMatrices();
+        }
+        if (changes & CONFIG_CHANGE_ENVIRONMENT) {
+            SetEnvironmentMap(config.environmentMap);
+        }
+        // CONFIG_CHANGE_CLEAR needs no rebuild: clear values are read from mConfig in BeginRenderPass
+
+        DebugWindow::Instance().Post("Renderer", "Config applied (flags " + std::to_string(changes) + ")",
+            DebugWindow::DebugLevel::INFO);
+    }
+
     // Prevent copy/move
     VulkanRenderService(const VulkanRenderService&) = delete;
     VulkanRenderService& operator=(const VulkanRenderService&) = delete;
@@ -358,6 +465,41 @@ private:
     void UpdateLightingUniforms();
     void UpdateFrameStats();
 
+    // Image-based lighting
+    bool UploadEnvironment(const IblData& data);
+    void ReleaseEnvironment();
+
+    // Hot reload
+    void ApplyHotReload() {
+        // Guard: hot reload disabled
+        if (!mHotReload) {
+            return;
+        }
+
+        ReloadBatch batch;
+        if (!mHotReload->ConsumePending(batch)) {
+            return;
+        }
+
+        if (batch.configChanged) {
+            ApplyConfig(batch.config);
+        }
+
+        // New modules go live together so a VS/PS pair never mixes old and new code
+        if (!batch.shaders.empty()) {
+            WaitForDeviceIdle();
+            for (const ReloadedShader& shader : batch.shaders) {
+                ReplaceShaderModule(shader.path, shader.type, shader.spirv);
+            }
+            DestroyGraphicsPipeline();
+            CreateGraphicsPipeline();
+        }
+    }
+
+    void RegisterHotReloadShaders(const std::string& shaderRoot);
+    void ReplaceShaderModule(const std::string& path, ShaderType type, const std::vector<uint32_t>& spirv);
+    bool RecreateSwapchainResources();
+
     // Event system integration
     void SubscribeToEvents();
     void OnCameraUpdated();
@@ -375,6 +517,9 @@ private:
     std::unique_ptr<ShaderCompiler> mShaderCompiler;
     std::unique_ptr<DescriptorManager> mDescriptorManager;
     std::unique_ptr<BufferAllocator> mBufferAllocator;
+    std::unique_ptr<HotReloadService> mHotReload;
+    std::unique_ptr<IblCache> mIblCache;
+    std::shared_ptr<const IblData> mEnvironment;
 
     // Vulkan objects
     VkPipeline mPipeline;
@@ -384,7 +529,7 @@ private:
     std::vector<VkFramebuffer> mFramebuffers;
 
     // Draw state
-    std::vector<DrawCommand> mDrawList;
+    FrameVector<DrawCommand> mDrawList; // Frame arena memory, rebuilt in BeginFrame()
     uint64_t mFrameNumber;
     bool mIsInitialized;
 };
@@ -403,7 +548,23 @@ private:
 // - Viewport with minDepth=1.0f, maxDepth=0.0f (reversed-Z)
 // - Cull mode BACK, front face COUNTER_CLOCKWISE
 //
+// RegisterHotReloadShaders() will register the same shader paths CompileShaders() uses
+// (Vertex/standard_vs.hlsl, Fragment/pbr_ps.hlsl, ...) and CompileShaders() will pass
+// HotReloadService::GetIncludeHash() in ShaderOptions so Common/*.hlsli edits miss the cache.
+//
+// ReplaceShaderModule() will vkDestroyShaderModule the old module for that path and
+// vkCreateShaderModule from the new SPIR-V. ApplyHotReload() then rebuilds the pipeline.
+//
+// RecreateSwapchainResources() will destroy and recreate framebuffers and depth/MSAA
+// attachments for the new window size and sample count.
+//
+// Initialize() will call SetEnvironmentMap(mConfig.environmentMap) after the pipeline exists.
+// UploadEnvironment() will expand IblData::sh into a small irradiance cube (t5, irradianceMap),
+// copy IblData::prefiltered into a cube image with one mip per entry (t6, prefilteredMap), and
+// set useIBL. brdfLut stays CPU-side until pbr_ps moves to the split-sum specular term.
+// ReleaseEnvironment() destroys both images and clears useIBL.
+//
 // Event subscriptions will use EventBus:
 // - Subscribe to "camera.updated" → OnCameraUpdated()
-// - Subscribe to "config.changed" → OnConfigChanged()
+// - Subscribe to "config.changed" → OnConfigChanged() → ApplyConfig()
 // - Publish "render.frame_end" after PresentFrame()
@@ -0,0 +1,971 @@
+/** WorldStreamer - Camera-driven chunk streaming for generated worlds
+ * @author Marcus Daley
+ * @date April 2026
+ */
+
+#pragma once
+
+#include "IRenderService.h"
+#include "../filesystem/FileService.h"
+#include "../core/MemoryBudget.h"
+#include "../core/QuoteSystem.h"
+#include "../core/TestManagerNew.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+
+// Weight of the newest frame in the smoothed camera velocity
+constexpr float WORLD_STREAM_VELOCITY_SMOOTHING = 0.25f;
+
+// Frames a chunk waits before a failed load is retried
+constexpr uint64_t WORLD_STREAM_RETRY_FRAMES = 120;
+
+// Streaming settings; defaults match the streaming section of config/world-defaults.yaml.
+// Distances are in region grid cells, the unit streaming-layout.js uses for chunk
+// bounds and load priority.
+struct WorldStreamingSettings {
+    float chunkSize;             // Grid cells per chunk edge (default_chunk_size)
+    float regionWorldSize;       // World units per grid cell (region_world_size)
+    float loadRadius;            // Chunks whose center is this close start loading
+    float unloadRadius;          // Loaded chunks stay until their center is farther than this
+    uint32_t lodLevels;          // Distance rings inside loadRadius; the nearest ring gets LOD 0
+    float predictionSeconds;     // Chunks around the camera's position this far ahead load too
+    uint64_t memoryBudgetBytes;  // Cap on resident plus in-flight bytes (0 = unlimited)
+    uint32_t maxLoadsInFlight;   // Chunk loads outstanding at once
+    uint32_t maxCommitsPerFrame; // Loaded chunks handed to the render service per Update()
+    bool respectEngineBudget;    // Stop loading while MemoryBudget reports MESH_CACHE over its hard limit
+
+    WorldStreamingSettings()
+        : chunkSize(2.0f)
+        , regionWorldSize(100.0f)
+        , loadRadius(2.0f)
+        , unloadRadius(4.0f)
+        , lodLevels(3)
+        , predictionSeconds(1.0f)
+        , memoryBudgetBytes(0)
+        , maxLoadsInFlight(4)
+        , maxCommitsPerFrame(2)
+        , respectEngineBudget(true)
+    {}
+};
+
+// One placed asset; lods[0] is full detail, later entries are coarser files.
+// Assets with fewer files than the chunk's LOD reuse their coarsest one.
+struct WorldChunkAsset {
+    std::vector<std::string> lods;
+    Transform transform;
+};
+
+// A chunk in streaming-layout.js coordinates: chunk_X_Y covers grid cells
+// [X * chunkSize, (X + 1) * chunkSize) on world X and the same for Y on world Z
+struct WorldChunkDesc {
+    int32_t x = 0;
+    int32_t z = 0;
+    std::vector<WorldChunkAsset> assets;
+    uint64_t estimatedBytes = 0; // Budget estimate until the chunk's files have been loaded once
+};
+
+struct WorldStreamingStats {
+    size_t chunks = 0;
+    size_t residentChunks = 0;
+    size_t loadingChunks = 0;     // Loads in flight or loaded and waiting to be committed
+    uint64_t residentBytes = 0;
+    uint64_t inFlightBytes = 0;
+    uint64_t loadsStarted = 0;
+    uint64_t commits = 0;
+    uint64_t unloads = 0;
+    uint64_t evictions = 0;       // Unloads made to fit the memory budget
+    uint64_t cancelled = 0;       // Loads whose chunk left the unload radius before they finished
+    uint64_t failed = 0;
+    uint64_t budgetStalls = 0;    // Frames that had chunks to load but no budget for them
+};
+
+// WorldStreamer keeps the chunks around the camera resident:
+// - Chunks sit in a sparse grid on the XZ plane (Y up, as CameraData). Each Update()
+//   scores chunks by the distance from their center to the camera or to where the
+//   camera will be predictionSeconds from now (smoothed velocity), whichever is nearer
+// - Chunks within loadRadius queue for loading, nearest first; resident chunks stay
+//   until both distances pass unloadRadius, so a camera that hovers on a boundary
+//   does not thrash. LOD follows distance rings, coarsening only half a ring late.
+// - Files load through FileService::LoadAsync on the JobSystem; finished chunks are
+//   committed on the calling thread (render service LoadMeshes) a few per frame
+// - Under the memory budget, the farthest chunks in the hysteresis band are evicted
+//   to make room for nearer ones; loads that still do not fit wait
+// Everything except the load callbacks runs on the thread that calls Update().
+// The FileService and render service (either may be null) must outlive the streamer.
+class WorldStreamer {
+public:
+    WorldStreamer(const WorldStreamingSettings& settings, BrightForge::FileService* files, IRenderService* render)
+        : mSettings(Sanitized(settings))
+        , mFiles(files)
+        , mRender(render)
+    {}
+
+    ~WorldStreamer() {
+        if (mFiles != nullptr) {
+            mFiles->WaitForAsyncLoads();
+        }
+        UnloadAll();
+        DrainCompleted(); // Releases the files of loads cancelled above
+    }
+
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    // Read the streaming section of a world-defaults.yaml. Keys that are absent keep
+    // the values already in `out`; returns false (with a message) for unreadable files
+    // or malformed values.
+    static bool LoadSettings(const std::string& path, WorldStreamingSettings& out, std::string* error = nullptr) {
+        std::ifstream file(path);
+        if (!file) {
+            return Fail(error, "cannot open " + path);
+        }
+
+        WorldStreamingSettings settings = out;
+        bool inSection = false;
+        std::string line;
+        while (std::getline(file, line)) {
+            line = line.substr(0, line.find('#'));
+            size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos) {
+                continue;
+            }
+            if (first == 0) {
+                inSection = line.compare(0, 10, "streaming:") == 0;
+                continue;
+            }
+            size_t colon = line.find(':');
+            if (!inSection || colon == std::string::npos) {
+                continue;
+            }
+
+            std::string key = line.substr(first, colon - first);
+            std::string text = line.substr(colon + 1);
+            char* end = nullptr;
+            double value = std::strtod(text.c_str(), &end);
+            bool numeric = end != text.c_str() && text.find_first_not_of(" \t\r", end - text.c_str()) == std::string::npos;
+            if (!numeric || value < 0.0) {
+                return Fail(error, "streaming." + key + ": expected a non-negative number");
+            }
+
+            if (key == "default_chunk_size") {
+                settings.chunkSize = static_cast<float>(value);
+            } else if (key == "region_world_size") {
+                settings.regionWorldSize = static_cast<float>(value);
+            } else if (key == "load_radius") {
+                settings.loadRadius = static_cast<float>(value);
+            } else if (key == "unload_radius") {
+                settings.unloadRadius = static_cast<float>(value);
+            } else if (key == "lod_levels") {
+                settings.lodLevels = static_cast<uint32_t>(value);
+            } else if (key == "prediction_seconds") {
+                settings.predictionSeconds = static_cast<float>(value);
+            } else if (key == "memory_budget_mb") {
+                settings.memoryBudgetBytes = static_cast<uint64_t>(value * 1024.0 * 1024.0);
+            } else if (key == "max_loads_in_flight") {
+                settings.maxLoadsInFlight = static_cast<uint32_t>(value);
+            }
+        }
+
+        if (settings.chunkSize <= 0.0f || settings.regionWorldSize <= 0.0f || settings.loadRadius <= 0.0f) {
+            return Fail(error, "streaming: chunk size, region size and load radius must be positive");
+        }
+        out = Sanitized(settings);
+        return true;
+    }
+
+    // Chunk holding a region grid cell (floor division, as streaming-layout.js)
+    static void ChunkOfRegion(int32_t gridX, int32_t gridY, const WorldStreamingSettings& settings, int32_t& outX,
+                              int32_t& outZ) {
+        outX = static_cast<int32_t>(std::floor(static_cast<float>(gridX) / settings.chunkSize));
+        outZ = static_cast<int32_t>(std::floor(static_cast<float>(gridY) / settings.chunkSize));
+    }
+
+    // Register a chunk; false for duplicates and assets without files
+    bool AddChunk(const WorldChunkDesc& desc) {
+        uint32_t lodCount = 1;
+        for (const WorldChunkAsset& asset : desc.assets) {
+            if (asset.lods.empty()) {
+                return false;
+            }
+            lodCount = std::max(lodCount, static_cast<uint32_t>(asset.lods.size()));
+        }
+
+        Chunk chunk;
+        chunk.desc = desc;
+        chunk.lodCount = lodCount;
+        return mChunks.emplace(Key(desc.x, desc.z), std::move(chunk)).second;
+    }
+
+    // Once per frame: pick up finished loads, move the camera, unload what fell out of
+    // range, commit loaded chunks and start the next loads
+    void Update(const CameraData& camera, float deltaSeconds) {
+        ++mFrame;
+        DrainCompleted();
+        UpdateMotion(camera, deltaSeconds);
+
+        // Unload what both the camera and its prediction have left behind
+        std::vector<uint64_t> active(mActive.begin(), mActive.end());
+        for (uint64_t key : active) {
+            Chunk& chunk = mChunks.at(key);
+            chunk.priority = Priority(chunk);
+            if (chunk.priority > mSettings.unloadRadius) {
+                Drop(chunk);
+            }
+        }
+
+        std::vector<Candidate> candidates;
+        CollectCandidates(mCameraX, mCameraZ, candidates);
+        CollectCandidates(mPredictedX, mPredictedZ, candidates);
+
+        CommitReady();
+
+        if (mSettings.respectEngineBudget &&
+            MemoryBudget::Instance().GetState(MemoryTag::MESH_CACHE) == BudgetState::HARD) {
+            // The engine is out of mesh memory: give back the band, load nothing new
+            EvictBand(mSettings.loadRadius, UINT64_MAX);
+            if (!candidates.empty()) {
+                ++mStats.budgetStalls;
+            }
+            return;
+        }
+
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate& a, const Candidate& b) { return a.chunk->priority < b.chunk->priority; });
+        for (const Candidate& candidate : candidates) {
+            if (mLoadsInFlight >= mSettings.maxLoadsInFlight) {
+                break;
+            }
+            uint64_t bytes = EstimateBytes(*candidate.chunk, candidate.lod);
+            if (!MakeRoom(bytes, candidate.chunk->priority)) {
+                ++mStats.budgetStalls;
+                break;
+            }
+            StartLoad(*candidate.chunk, candidate.lod, bytes);
+        }
+    }
+
+    // Draw every resident chunk through the bound render service
+    void Submit() const {
+        if (mRender == nullptr) {
+            return;
+        }
+        for (uint64_t key : mActive) {
+            const Chunk& chunk = mChunks.at(key);
+            if (!chunk.resident) {
+                continue;
+            }
+            for (size_t i = 0; i < chunk.meshes.size(); ++i) {
+                if (chunk.meshes[i] != INVALID_MESH_HANDLE) {
+                    mRender->SubmitMesh(chunk.meshes[i], chunk.desc.assets[i].transform);
+                }
+            }
+        }
+    }
+
+    // Unload everything and cancel loads in flight (their files are released when they land)
+    void UnloadAll() {
+        std::vector<uint64_t> active(mActive.begin(), mActive.end());
+        for (uint64_t key : active) {
+            Drop(mChunks.at(key));
+        }
+    }
+
+    bool IsResident(int32_t x, int32_t z) const {
+        auto found = mChunks.find(Key(x, z));
+        return found != mChunks.end() && found->second.resident;
+    }
+
+    // LOD of a resident chunk; lodLevels when it is not resident
+    uint32_t ResidentLod(int32_t x, int32_t z) const {
+        auto found = mChunks.find(Key(x, z));
+        return found != mChunks.end() && found->second.resident ? found->second.residentLod : mSettings.lodLevels;
+    }
+
+    WorldStreamingStats GetStats() const {
+        WorldStreamingStats stats = mStats;
+        stats.chunks = mChunks.size();
+        stats.residentBytes = mResidentBytes;
+        stats.inFlightBytes = mRequestBytes;
+        for (uint64_t key : mActive) {
+            const Chunk& chunk = mChunks.at(key);
+            stats.residentChunks += chunk.resident ? 1 : 0;
+            stats.loadingChunks += chunk.request != Request::NONE ? 1 : 0;
+        }
+        return stats;
+    }
+
+    const WorldStreamingSettings& GetSettings() const { return mSettings; }
+
+    static void RegisterTests();
+
+private:
+    enum class Request {
+        NONE,
+        LOADING,   // Files loading
+        READY      // Files loaded, waiting for CommitReady()
+    };
+
+    struct Chunk {
+        WorldChunkDesc desc;
+        uint32_t lodCount = 1;
+        float priority = 0.0f;
+        uint64_t seenFrame = 0;
+        uint64_t retryFrame = 0;
+        uint64_t generation = 0;                  // Bumped on cancel so late completions are dropped
+        std::vector<uint64_t> knownBytes;         // Loaded bytes per LOD, 0 until loaded once
+
+        bool resident = false;
+        uint32_t residentLod = 0;
+        uint64_t residentBytes = 0;
+        std::vector<MeshHandle> meshes;
+        std::vector<BrightForge::AssetHandle> files;
+
+        Request request = Request::NONE;
+        uint32_t requestLod = 0;
+        uint64_t requestBytes = 0;
+        std::vector<BrightForge::AssetHandle> pendingFiles;
+    };
+
+    // Shared with the load callbacks; each callback writes only its own file slot
+    struct LoadTicket {
+        uint64_t key = 0;
+        uint64_t generation = 0;
+        std::vector<BrightForge::AssetHandle> files;
+        std::atomic<size_t> remaining{ 0 };
+        std::atomic<bool> failed{ false };
+    };
+
+    struct Candidate {
+        Chunk* chunk;
+        uint32_t lod;
+    };
+
+    WorldStreamingSettings mSettings;
+    BrightForge::FileService* mFiles;
+    IRenderService* mRender;
+    std::unordered_map<uint64_t, Chunk> mChunks;
+    std::unordered_set<uint64_t> mActive;         // Chunks resident or with a request
+    std::vector<uint64_t> mReadyKeys;
+    uint64_t mFrame = 0;
+    uint64_t mResidentBytes = 0;
+    uint64_t mRequestBytes = 0;
+    uint32_t mLoadsInFlight = 0;
+    WorldStreamingStats mStats;
+
+    bool mHasCamera = false;
+    float mCameraX = 0.0f;
+    float mCameraZ = 0.0f;
+    float mVelocityX = 0.0f;
+    float mVelocityZ = 0.0f;
+    float mPredictedX = 0.0f;
+    float mPredictedZ = 0.0f;
+
+    std::mutex mCompletedMutex;
+    std::vector<std::shared_ptr<LoadTicket>> mCompleted;
+
+    static bool Fail(std::string* error, const std::string& message) {
+        if (error != nullptr) {
+            *error = message;
+        }
+        return false;
+    }
+
+    static WorldStreamingSettings Sanitized(WorldStreamingSettings settings) {
+        settings.chunkSize = std::max(settings.chunkSize, 1e-3f);
+        settings.regionWorldSize = std::max(settings.regionWorldSize, 1e-3f);
+        settings.unloadRadius = std::max(settings.unloadRadius, settings.loadRadius);
+        settings.lodLevels = std::max<uint32_t>(settings.lodLevels, 1);
+        settings.predictionSeconds = std::max(settings.predictionSeconds, 0.0f);
+        settings.maxLoadsInFlight = std::max<uint32_t>(settings.maxLoadsInFlight, 1);
+        settings.maxCommitsPerFrame = std::max<uint32_t>(settings.maxCommitsPerFrame, 1);
+        return settings;
+    }
+
+    static uint64_t Key(int32_t x, int32_t z) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+    }
+
+    void UpdateMotion(const CameraData& camera, float deltaSeconds) {
+        float x = camera.positionX / mSettings.regionWorldSize;
+        float z = camera.positionZ / mSettings.regionWorldSize;
+        if (mHasCamera && deltaSeconds > 0.0f) {
+            float dx = x - mCameraX;
+            float dz = z - mCameraZ;
+            if (std::sqrt(dx * dx + dz * dz) > mSettings.unloadRadius) {
+                // Teleport: a jump says nothing about where the camera goes next
+                mVelocityX = 0.0f;
+                mVelocityZ = 0.0f;
+            } else {
+                mVelocityX += (dx / deltaSeconds - mVelocityX) * WORLD_STREAM_VELOCITY_SMOOTHING;
+                mVelocityZ += (dz / deltaSeconds - mVelocityZ) * WORLD_STREAM_VELOCITY_SMOOTHING;
+            }
+        }
+        mHasCamera = true;
+        mCameraX = x;
+        mCameraZ = z;
+        mPredictedX = x + mVelocityX * mSettings.predictionSeconds;
+        mPredictedZ = z + mVelocityZ * mSettings.predictionSeconds;
+    }
+
+    // Distance from the chunk center to the camera or its prediction, whichever is nearer
+    float Priority(const Chunk& chunk) const {
+        float centerX = (static_cast<float>(chunk.desc.x) + 0.5f) * mSettings.chunkSize;
+        float centerZ = (static_cast<float>(chunk.desc.z) + 0.5f) * mSettings.chunkSize;
+        float now = std::hypot(centerX - mCameraX, centerZ - mCameraZ);
+        float ahead = std::hypot(centerX - mPredictedX, centerZ - mPredictedZ);
+        return std::min(now, ahead);
+    }
+
+    uint32_t RingLod(float distance) const {
+        float ring = std::max(distance, 0.0f) / mSettings.loadRadius * static_cast<float>(mSettings.lodLevels);
+        return std::min(static_cast<uint32_t>(ring), mSettings.lodLevels - 1);
+    }
+
+    // LOD a chunk at `distance` should have; coarsening waits half a ring
+    uint32_t WantedLod(const Chunk& chunk, float distance) const {
+        uint32_t wanted = std::min(RingLod(distance), chunk.lodCount - 1);
+        if (chunk.resident && wanted > chunk.residentLod) {
+            float halfRing = mSettings.loadRadius / static_cast<float>(mSettings.lodLevels) * 0.5f;
+            wanted = std::max(chunk.residentLod, std::min(RingLod(distance - halfRing), chunk.lodCount - 1));
+        }
+        return wanted;
+    }
+
+    // Chunks within loadRadius of (x, z) that need a load or a LOD change
+    void CollectCandidates(float x, float z, std::vector<Candidate>& out) {
+        const float size = mSettings.chunkSize;
+        const float radius = mSettings.loadRadius;
+        int32_t minX = static_cast<int32_t>(std::floor((x - radius) / size));
+        int32_t maxX = static_cast<int32_t>(std::floor((x + radius) / size));
+        int32_t minZ = static_cast<int32_t>(std::floor((z - radius) / size));
+        int32_t maxZ = static_cast<int32_t>(std::floor((z + radius) / size));
+        for (int32_t cz = minZ; cz <= maxZ; ++cz) {
+            for (int32_t cx = minX; cx <= maxX; ++cx) {
+                auto found = mChunks.find(Key(cx, cz));
+                if (found == mChunks.end() || found->second.seenFrame == mFrame) {
+                    continue;
+                }
+                Chunk& chunk = found->second;
+                chunk.seenFrame = mFrame;
+                chunk.priority = Priority(chunk);
+                if (chunk.priority > radius || chunk.request != Request::NONE || chunk.retryFrame > mFrame) {
+                    continue;
+                }
+                uint32_t lod = WantedLod(chunk, chunk.priority);
+                if (!chunk.resident || lod != chunk.residentLod) {
+                    out.push_back({ &chunk, lod });
+                }
+            }
+        }
+    }
+
+    uint64_t EstimateBytes(const Chunk& chunk, uint32_t lod) const {
+        return lod < chunk.knownBytes.size() && chunk.knownBytes[lod] > 0 ? chunk.knownBytes[lod]
+                                                                           : chunk.desc.estimatedBytes;
+    }
+
+    // Fit `bytes` more under the budget by evicting resident band chunks farther than
+    // `priority`, farthest first. Evicts nothing unless that makes enough room.
+    bool MakeRoom(uint64_t bytes, float priority) {
+        const uint64_t budget = mSettings.memoryBudgetBytes;
+        uint64_t used = mResidentBytes + mRequestBytes;
+        if (budget == 0 || used + bytes <= budget) {
+            return true;
+        }
+        if (bytes > budget) {
+            return false;
+        }
+        return EvictBand(std::max(priority, mSettings.loadRadius), used + bytes - budget);
+    }
+
+    // Evict idle resident chunks farther than `distance`, farthest first, until `needed`
+    // bytes are freed; returns whether they were (nothing is evicted when they cannot be)
+    bool EvictBand(float distance, uint64_t needed) {
+        std::vector<Chunk*> victims;
+        uint64_t freeable = 0;
+        for (uint64_t key : mActive) {
+            Chunk& chunk = mChunks.at(key);
+            if (chunk.resident && chunk.request == Request::NONE && chunk.priority > distance) {
+                victims.push_back(&chunk);
+                freeable += chunk.residentBytes;
+            }
+        }
+        if (needed != UINT64_MAX && freeable < needed) {
+            return false;
+        }
+
+        std::sort(victims.begin(), victims.end(), [](const Chunk* a, const Chunk* b) { return a->priority > b->priority; });
+        uint64_t freed = 0;
+        for (Chunk* victim : victims) {
+            if (freed >= needed) {
+                break;
+            }
+            freed += victim->residentBytes;
+            ReleaseResident(*victim);
+            ++mStats.evictions;
+            Deactivate(*victim);
+        }
+        return freed >= needed;
+    }
+
+    void StartLoad(Chunk& chunk, uint32_t lod, uint64_t bytes) {
+        const uint64_t key = Key(chunk.desc.x, chunk.desc.z);
+        chunk.request = Request::LOADING;
+        chunk.requestLod = lod;
+        chunk.requestBytes = bytes;
+        mRequestBytes += bytes;
+        ++mLoadsInFlight;
+        ++mStats.loadsStarted;
+        mActive.insert(key);
+
+        auto ticket = std::make_shared<LoadTicket>();
+        ticket->key = key;
+        ticket->generation = ++chunk.generation;
+        ticket->files.assign(mFiles != nullptr ? chunk.desc.assets.size() : 0, BrightForge::INVALID_HANDLE);
+        ticket->remaining.store(ticket->files.size() + 1);
+
+        for (size_t i = 0; i < ticket->files.size(); ++i) {
+            const WorldChunkAsset& asset = chunk.desc.assets[i];
+            const std::string& path = asset.lods[std::min<size_t>(lod, asset.lods.size() - 1)];
+            mFiles->LoadAsync(path, [this, ticket, i](BrightForge::AssetHandle handle, bool success, const std::string&) {
+                ticket->files[i] = handle;
+                if (!success) {
+                    ticket->failed.store(true);
+                }
+                FinishFile(ticket);
+            });
+        }
+        FinishFile(ticket); // The issuing reference; chunks without assets complete here
+    }
+
+    // Any thread: the last file of a ticket queues it for the next DrainCompleted()
+    void FinishFile(const std::shared_ptr<LoadTicket>& ticket) {
+        if (ticket->remaining.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(mCompletedMutex);
+            mCompleted.push_back(ticket);
+        }
+    }
+
+    void DrainCompleted() {
+        std::vector<std::shared_ptr<LoadTicket>> completed;
+        {
+            std::lock_guard<std::mutex> lock(mCompletedMutex);
+            completed.swap(mCompleted);
+        }
+
+        for (const std::shared_ptr<LoadTicket>& ticket : completed) {
+            auto found = mChunks.find(ticket->key);
+            bool current = found != mChunks.end() && found->second.generation == ticket->generation &&
+                           found->second.request == Request::LOADING;
+            if (!current || ticket->failed.load()) {
+                ReleaseFiles(ticket->files);
+            }
+            if (!current) {
+                continue; // Cancelled; counted when it was dropped
+            }
+
+            Chunk& chunk = found->second;
+            if (ticket->failed.load()) {
+                QuoteSystem::Instance().Log("WorldStreamer: chunk " + std::to_string(chunk.desc.x) + "," +
+                    std::to_string(chunk.desc.z) + " failed to load", QuoteSystem::MessageType::WARNING);
+                ++mStats.failed;
+                chunk.retryFrame = mFrame + WORLD_STREAM_RETRY_FRAMES;
+                EndRequest(chunk);
+                Deactivate(chunk);
+                continue;
+            }
+
+            // Measured bytes replace the estimate from here on
+            uint64_t bytes = chunk.desc.estimatedBytes;
+            if (mFiles != nullptr) {
+                bytes = 0;
+                for (BrightForge::AssetHandle handle : ticket->files) {
+                    BrightForge::AssetInfo info;
+                    if (mFiles->GetAssetInfo(handle, info)) {
+                        bytes += info.sizeBytes;
+                    }
+                }
+            }
+            if (chunk.knownBytes.size() <= chunk.requestLod) {
+                chunk.knownBytes.resize(chunk.requestLod + 1, 0);
+            }
+            chunk.knownBytes[chunk.requestLod] = bytes;
+            mRequestBytes = mRequestBytes - chunk.requestBytes + bytes;
+            chunk.requestBytes = bytes;
+            chunk.pendingFiles = ticket->files;
+            chunk.request = Request::READY;
+            --mLoadsInFlight;
+            mReadyKeys.push_back(ticket->key);
+        }
+    }
+
+    // Hand loaded chunks to the render service, nearest first, swapping out any older LOD
+    void CommitReady() {
+        std::vector<Chunk*> ready;
+        for (uint64_t key : mReadyKeys) {
+            Chunk& chunk = mChunks.at(key);
+            if (chunk.request == Request::READY) {
+                ready.push_back(&chunk);
+            }
+        }
+        std::sort(ready.begin(), ready.end(), [](const Chunk* a, const Chunk* b) { return a->priority < b->priority; });
+        if (ready.size() > mSettings.maxCommitsPerFrame) {
+            ready.resize(mSettings.maxCommitsPerFrame);
+        }
+
+        for (Chunk* chunk : ready) {
+            std::vector<std::string> paths;
+            for (const WorldChunkAsset& asset : chunk->desc.assets) {
+                paths.push_back(asset.lods[std::min<size_t>(chunk->requestLod, asset.lods.size() - 1)]);
+            }
+            std::vector<MeshHandle> meshes =
+                mRender != nullptr ? mRender->LoadMeshes(paths) : std::vector<MeshHandle>(paths.size(), INVALID_MESH_HANDLE);
+
+            ReleaseResident(*chunk);
+            chunk->resident = true;
+            chunk->residentLod = chunk->requestLod;
+            chunk->residentBytes = chunk->requestBytes;
+            chunk->meshes = std::move(meshes);
+            chunk->files = std::move(chunk->pendingFiles);
+            mResidentBytes += chunk->residentBytes;
+            EndRequest(*chunk);
+            ++mStats.commits;
+        }
+
+        mReadyKeys.erase(std::remove_if(mReadyKeys.begin(), mReadyKeys.end(),
+                                        [this](uint64_t key) { return mChunks.at(key).request != Request::READY; }),
+                         mReadyKeys.end());
+    }
+
+    // Clear the request and its byte reservation (a committed request's bytes move to
+    // residentBytes first)
+    void EndRequest(Chunk& chunk) {
+        if (chunk.request == Request::LOADING) {
+            --mLoadsInFlight;
+        }
+        mRequestBytes -= chunk.requestBytes;
+        chunk.requestBytes = 0;
+        chunk.pendingFiles.clear();
+        chunk.request = Request::NONE;
+    }
+
+    void ReleaseResident(Chunk& chunk) {
+        if (!chunk.resident) {
+            return;
+        }
+        if (mRender != nullptr) {
+            for (MeshHandle mesh : chunk.meshes) {
+                if (mesh != INVALID_MESH_HANDLE) {
+                    mRender->UnloadMesh(mesh);
+                }
+            }
+        }
+        ReleaseFiles(chunk.files);
+        mResidentBytes -= chunk.residentBytes;
+        chunk.meshes.clear();
+        chunk.files.clear();
+        chunk.residentBytes = 0;
+        chunk.resident = false;
+        ++mStats.unloads;
+    }
+
+    void ReleaseFiles(const std::vector<BrightForge::AssetHandle>& files) {
+        if (mFiles == nullptr) {
+            return;
+        }
+        for (BrightForge::AssetHandle handle : files) {
+            if (handle != BrightForge::INVALID_HANDLE) {
+                mFiles->Unload(handle);
+            }
+        }
+    }
+
+    // Unload the chunk and cancel its request; a load still in flight releases its files
+    // when it lands
+    void Drop(Chunk& chunk) {
+        if (chunk.request != Request::NONE) {
+            if (chunk.request == Request::READY) {
+                ReleaseFiles(chunk.pendingFiles);
+            }
+            ++chunk.generation;
+            ++mStats.cancelled;
+            EndRequest(chunk);
+        }
+        ReleaseResident(chunk);
+        Deactivate(chunk);
+    }
+
+    void Deactivate(Chunk& chunk) {
+        if (!chunk.resident && chunk.request == Request::NONE) {
+            mActive.erase(Key(chunk.desc.x, chunk.desc.z));
+        }
+    }
+};
+
+inline void WorldStreamer::RegisterTests() {
+    TestManagerNew& tests = TestManagerNew::Instance();
+    tests.RegisterSuite("WorldStreamer");
+
+    // Render service double: hands out handles and remembers what it loaded, in order
+    class RecordingRender : public IRenderService {
+    public:
+        std::vector<std::string> loaded;
+        std::unordered_set<MeshHandle> live;
+        MeshHandle next = 1;
+
+        bool Initialize(const RenderConfig&) override { return true; }
+        void Shutdown() override {}
+        void BeginFrame() override {}
+        void EndFrame() override {}
+        void SetCamera(const CameraData&) override {}
+        void SubmitMesh(MeshHandle, const Transform&) override {}
+        void SetLighting(const LightingData&) override {}
+        MeshHandle LoadMesh(const std::string& path) override {
+            loaded.push_back(path);
+            live.insert(next);
+            return next++;
+        }
+        TextureHandle LoadTexture(const std::string&) override { return INVALID_TEXTURE_HANDLE; }
+        void UnloadMesh(MeshHandle handle) override { live.erase(handle); }
+        void UnloadTexture(TextureHandle) override {}
+        FrameStats GetFrameStats() const override { return FrameStats(); }
+    };
+
+    // Square of chunks [-half, half]^2 with one asset each, LOD files "<x>_<z>_<lod>"
+    auto addGrid = [](WorldStreamer& streamer, int32_t half, uint64_t bytes) {
+        for (int32_t z = -half; z <= half; ++z) {
+            for (int32_t x = -half; x <= half; ++x) {
+                WorldChunkDesc desc;
+                desc.x = x;
+                desc.z = z;
+                desc.estimatedBytes = bytes;
+                WorldChunkAsset asset;
+                for (int lod = 0; lod < 3; ++lod) {
+                    asset.lods.push_back(std::to_string(x) + "_" + std::to_string(z) + "_" + std::to_string(lod));
+                }
+                desc.assets.push_back(asset);
+                streamer.AddChunk(desc);
+            }
+        }
+    };
+
+    // Grid units equal world units in these tests; chunk (x, z) is centered on (2x + 1, 2z + 1)
+    auto cameraAt = [](float x, float z) {
+        CameraData camera;
+        camera.positionX = x;
+        camera.positionZ = z;
+        return camera;
+    };
+
+    auto baseSettings = []() {
+        WorldStreamingSettings settings;
+        settings.regionWorldSize = 1.0f;
+        settings.predictionSeconds = 0.0f;
+        settings.respectEngineBudget = false;
+        return settings;
+    };
+
+    tests.AddTest("WorldStreamer", "Loads chunks within the load radius nearest first, LOD by distance", [=]() {
+        WorldStreamingSettings settings = baseSettings();
+        settings.loadRadius = 4.5f;
+        settings.unloadRadius = 6.0f;
+        settings.maxLoadsInFlight = 64;
+        settings.maxCommitsPerFrame = 1;
+        RecordingRender render;
+        WorldStreamer streamer(settings, nullptr, &render);
+        addGrid(streamer, 4, 100);
+
+        for (int frame = 0; frame < 40; ++frame) {
+            streamer.Update(cameraAt(1.0f, 1.0f), 1.0f / 60.0f);
+        }
+
+        // Centers within 4.5: the chunk itself, 4 at 2, 4 at 2.83, 4 at 4 and 8 at 4.47
+        bool ok = streamer.GetStats().residentChunks == 21 && render.live.size() == 21 &&
+                  render.loaded.size() == 21 && render.loaded[0] == "0_0_0";
+        for (int32_t z = -4; z <= 4; ++z) {
+            for (int32_t x = -4; x <= 4; ++x) {
+                float distance = 2.0f * std::sqrt(static_cast<float>(x * x + z * z));
+                ok = ok && streamer.IsResident(x, z) == (distance <= 4.5f);
+            }
+        }
+        ok = ok && streamer.ResidentLod(0, 0) == 0 && streamer.ResidentLod(1, 0) == 1 && streamer.ResidentLod(2, 0) == 2;
+
+        // Commits came nearest first: distances never decrease along the load order
+        float last = 0.0f;
+        for (const std::string& path : render.loaded) {
+            int x = std::atoi(path.c_str());
+            int z = std::atoi(path.c_str() + path.find('_') + 1);
+            float distance = std::sqrt(static_cast<float>(x * x + z * z));
+            ok = ok && distance >= last;
+            last = distance;
+        }
+
+        // Walking onto chunk (2, 0) refines it to LOD 0 and frees the LOD 2 meshes
+        for (int frame = 0; frame < 40; ++frame) {
+            streamer.Update(cameraAt(5.0f, 1.0f), 1.0f / 60.0f);
+        }
+        WorldStreamingStats stats = streamer.GetStats();
+        return ok && streamer.ResidentLod(2, 0) == 0 && render.live.size() == stats.residentChunks &&
+               stats.residentBytes == stats.residentChunks * 100 && stats.loadingChunks == 0;
+    });
+
+    tests.AddTest("WorldStreamer", "Hysteresis keeps chunks between the load and unload radii", [=]() {
+        WorldStreamingSettings settings = baseSettings();
+        RecordingRender render;
+        WorldStreamer streamer(settings, nullptr, &render);
+        addGrid(streamer, 6, 100);
+
+        auto settle = [&](float x) {
+            for (int frame = 0; frame < 10; ++frame) {
+                streamer.Update(cameraAt(x, 1.0f), 1.0f / 60.0f);
+            }
+        };
+
+        settle(1.0f);
+        bool ok = streamer.IsResident(0, 0) && streamer.IsResident(1, 0) && !streamer.IsResident(2, 0);
+
+        // Chunk 0 is 3 away: outside the load radius, inside the unload radius
+        settle(4.0f);
+        ok = ok && streamer.IsResident(0, 0) && streamer.IsResident(2, 0);
+
+        settle(5.5f);
+        ok = ok && !streamer.IsResident(0, 0);
+
+        // Hovering on a boundary settles LODs once, then loads nothing new
+        settle(5.9f);
+        settle(6.1f);
+        uint64_t loads = streamer.GetStats().loadsStarted;
+        for (int i = 0; i < 20; ++i) {
+            settle(i % 2 == 0 ? 5.9f : 6.1f);
+        }
+        WorldStreamingStats stats = streamer.GetStats();
+        return ok && stats.loadsStarted == loads && stats.unloads + stats.residentChunks == stats.commits;
+    });
+
+    tests.AddTest("WorldStreamer", "Velocity prediction loads chunks ahead of a moving camera", [=]() {
+        auto run = [&](float predictionSeconds) {
+            WorldStreamingSettings settings = baseSettings();
+            settings.predictionSeconds = predictionSeconds;
+            RecordingRender render;
+            WorldStreamer streamer(settings, nullptr, &render);
+            addGrid(streamer, 8, 100);
+
+            // 4 units per second along +X, ending at x = 5
+            for (int frame = 0; frame <= 20; ++frame) {
+                streamer.Update(cameraAt(1.0f + frame * 0.2f, 1.0f), 0.05f);
+            }
+            return streamer.IsResident(4, 0) && !streamer.IsResident(-1, 0);
+        };
+        // Chunk 4 is 4 units ahead, beyond the load radius unless the camera's path is predicted
+        return run(1.0f) && !run(0.0f);
+    });
+
+    tests.AddTest("WorldStreamer", "Memory budget caps residency and evicts the farthest band chunks", [=]() {
+        WorldStreamingSettings settings = baseSettings();
+        settings.loadRadius = 4.5f;
+        settings.unloadRadius = 9.0f;
+        settings.memoryBudgetBytes = 500;
+        settings.maxLoadsInFlight = 64;
+        RecordingRender render;
+        WorldStreamer streamer(settings, nullptr, &render);
+        addGrid(streamer, 6, 100);
+
+        bool ok = true;
+        for (int frame = 0; frame < 30; ++frame) {
+            streamer.Update(cameraAt(1.0f, 1.0f), 1.0f / 60.0f);
+            WorldStreamingStats stats = streamer.GetStats();
+            ok = ok && stats.residentBytes + stats.inFlightBytes <= 500;
+        }
+        // The five nearest fit: the chunk and its four edge neighbours
+        ok = ok && streamer.GetStats().residentChunks == 5 && streamer.IsResident(0, 0) && streamer.IsResident(-1, 0);
+
+        // Three chunks over, the chunks left in the band make room for the new ones
+        for (int frame = 0; frame < 30; ++frame) {
+            streamer.Update(cameraAt(7.0f, 1.0f), 1.0f / 60.0f);
+            WorldStreamingStats stats = streamer.GetStats();
+            ok = ok && stats.residentBytes + stats.inFlightBytes <= 500;
+        }
+        WorldStreamingStats stats = streamer.GetStats();
+        return ok && stats.residentChunks == 5 && streamer.IsResident(3, 0) && !streamer.IsResident(-1, 0) &&
+               !streamer.IsResident(0, 0) && stats.evictions > 0 && stats.budgetStalls > 0 && render.live.size() == stats.residentChunks;
+    });
+
+    tests.AddTest("WorldStreamer", "Loads files through FileService and releases them on unload", [=]() {
+        std::error_code ec;
+        std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / "brightforge_world_streamer";
+        std::filesystem::create_directories(dir, ec);
+
+        WorldStreamingSettings settings = baseSettings();
+        BrightForge::FileService files;
+        RecordingRender render;
+        bool ok = true;
+        {
+            WorldStreamer streamer(settings, &files, &render);
+            for (int32_t x = 0; x < 2; ++x) {
+                std::string path = (dir / ("chunk_" + std::to_string(x) + ".glb")).string();
+                std::ofstream(path, std::ios::binary) << "glTF" << std::string(60 + x * 40, '\0');
+                WorldChunkDesc desc;
+                desc.x = x;
+                desc.assets.push_back({ { path }, Transform() });
+                ok = ok && streamer.AddChunk(desc);
+            }
+
+            for (int frame = 0; frame < 20 && streamer.GetStats().residentChunks < 2; ++frame) {
+                streamer.Update(cameraAt(1.0f, 1.0f), 1.0f / 60.0f);
+                files.WaitForAsyncLoads();
+            }
+            WorldStreamingStats stats = streamer.GetStats();
+            ok = ok && stats.residentChunks == 2 && stats.residentBytes == 64 + 104 && files.GetLoadedCount() == 2 &&
+                 render.live.size() == 2;
+
+            // Far away: both chunks go, with their files and meshes
+            for (int frame = 0; frame < 3; ++frame) {
+                streamer.Update(cameraAt(100.0f, 100.0f), 1.0f / 60.0f);
+            }
+            ok = ok && streamer.GetStats().residentChunks == 0 && files.GetLoadedCount() == 0 && render.live.empty();
+
+            streamer.Update(cameraAt(1.0f, 1.0f), 1.0f / 60.0f);
+        }
+        // Destroyed with loads in flight: nothing left behind
+        ok = ok && files.GetLoadedCount() == 0 && render.live.empty();
+        std::filesystem::remove_all(dir, ec);
+        return ok;
+    });
+
+    tests.AddTest("WorldStreamer", "Reads the streaming section of world-defaults.yaml", []() {
+        std::error_code ec;
+        std::filesystem::path path = std::filesystem::temp_directory_path(ec) / "brightforge_world_defaults.yaml";
+        std::ofstream(path.string()) << "world:\n  max_regions: 16\n  load_radius: 99\n"
+                                     << "streaming:\n  default_chunk_size: 4   # cells\n  load_radius: 3\n"
+                                     << "  unload_radius: 1\n  lod_levels: 2\n  memory_budget_mb: 64\n"
+                                     << "export:\n  include_streaming_metadata: true\n";
+        WorldStreamingSettings settings;
+        bool ok = LoadSettings(path.string(), settings) && settings.chunkSize == 4.0f && settings.loadRadius == 3.0f &&
+                  settings.unloadRadius == 3.0f && settings.lodLevels == 2 &&
+                  settings.memoryBudgetBytes == 64ull * 1024 * 1024 && settings.regionWorldSize == 100.0f;
+
+        std::ofstream(path.string()) << "streaming:\n  load_radius: near\n";
+        std::string error;
+        ok = ok && !LoadSettings(path.string(), settings, &error) && error.find("load_radius") != std::string::npos &&
+             settings.loadRadius == 3.0f;
+        std::filesystem::remove(path, ec);
+        return ok;
+    });
+}
+
+// Note on usage:
+// Load settings with WorldStreamer::LoadSettings("config/world-defaults.yaml", settings),
+// AddChunk() every chunk of the world's streaming manifest (ChunkOfRegion maps region
+// grid positions the same way streaming-layout.js does), then call Update(camera, dt)
+// and Submit() each frame.
@@ -0,0 +1,185 @@
+// engine_tests.cpp
+// Developer: Marcus Daley
+// Date: April 2026
+// Purpose: Test runner for the native engine headers. Registers every subsystem's suites
+//          with TestManagerNew and runs them in parallel; --bench adds the microbenchmarks.
+//
+// Usage: engine_tests [--bench] [--samples <dir>] [--baseline <file>] [--save-baseline <file>]
+//   --samples        directory of .glb/.gltf files for the loader and converter benchmarks
+//   --baseline       fail the run when a benchmark regressed against this file
+//   --save-baseline  write this run's benchmark results as the new baseline
+// Exit code is 0 only when every test passed and no benchmark regressed.
+
+#include "../core/TestManagerNew.h"
+#include "../core/HandlePool.h"
+#include "../core/JobSystem.h"
+#include "../core/FrameArena.h"
+#include "../core/MemoryTracker.h"
+#include "../core/MemoryBudget.h"
+#include "../core/StringInterner.h"
+#include "../core/ResidencyManager.h"
+#include "../core/AssetCooker.h"
+#include "../core/Checksum.h"
+#include "../core/JsonBinding.h"
+#include "../filesystem/BatchIO.h"
+#include "../filesystem/PakArchive.h"
+#include "../filesystem/VirtualFileSystem.h"
+#include "../filesystem/FileService.h"
+#include "../rendering/GltfLoader.h"
+#include "../rendering/FbxLoader.h"
+#include "../rendering/HdrLoader.h"
+#include "../rendering/IblBaker.h"
+#include "../rendering/SoftwareShading.h"
+#include "../rendering/SoftwareDeferred.h"
+#include "../rendering/PickingBvh.h"
+#include "../rendering/MeshLod.h"
+#include "../rendering/MeshCook.h"
+#include "../rendering/FbxWriter.h"
+#include "../rendering/MeshDecimator.h"
+#include "../rendering/MeshValidator.h"
+#include "../rendering/TextureOps.h"
+#include "../rendering/PngCodec.h"
+#include "../rendering/WorldStreamer.h"
+#include "../rendering/DynamicResolution.h"
+#include "../rendering/HotReloadService.h"
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replacement global allocation functions so TestManagerNew::HeapAllocations() sees every
+// heap allocation made by threads that opted in (e.g. the FrameArena steady-state test).
+// Every form is replaced so allocations and releases always pair up in malloc/free.
+static void* CountedAllocate(std::size_t size, std::size_t alignment) {
+    TestManagerNew::NoteHeapAllocation();
+    size = std::max<std::size_t>(size, 1);
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+static void* CountedAllocateOrThrow(std::size_t size, std::size_t alignment) {
+    if (void* p = CountedAllocate(size, alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size) { return CountedAllocateOrThrow(size, 0); }
+void* operator new[](std::size_t size) { return CountedAllocateOrThrow(size, 0); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size, 0); }
+void* operator new(std::size_t size, std::align_val_t align) {
+    return CountedAllocateOrThrow(size, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return CountedAllocateOrThrow(size, static_cast<std::size_t>(align));
+}
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+static void RegisterEngineTests() {
+    TestManagerNew::RegisterTests();
+    GltfLoader::RegisterTests();
+    FbxLoader::RegisterTests();
+    HdrLoader::RegisterTests();
+    IblBaker::RegisterTests();
+    IblCache::RegisterTests();
+    SoftwareShading::RegisterTests();
+    SoftwareDeferred::RegisterTests();
+    PickingScene::RegisterTests();
+    HandlePool<int>::RegisterTests(); // The tests do not depend on T
+    JobSystem::RegisterTests();
+    FrameArena::RegisterTests();
+    MemoryTracker::RegisterTests();
+    MemoryBudget::RegisterTests();
+    StringInterner::RegisterTests();
+    ResidencyManager::RegisterTests();
+    MeshLod::RegisterTests();
+    AssetCooker::RegisterTests();
+    MeshCook::RegisterTests();
+    BrightForge::IoBackend::RegisterTests();
+    BrightForge::PakArchive::RegisterTests();
+    BrightForge::VirtualFileSystem::RegisterTests();
+    BrightForge::FileService::RegisterTests();
+    Checksum::RegisterTests();
+    JsonBinding::RegisterTests(TestManagerNew::Instance());
+    FbxWriter::RegisterTests();
+    MeshDecimator::RegisterTests();
+    MeshValidator::RegisterTests();
+    TextureOps::RegisterTests();
+    PngCodec::RegisterTests();
+    WorldStreamer::RegisterTests();
+    DynamicResolution::RegisterTests();
+    HotReloadService::RegisterTests();
+}
+
+static void RegisterEngineBenchmarks(const std::string& sampleDir) {
+    GltfLoader::RegisterBenchmarks(sampleDir);
+    SoftwareDeferred::RegisterBenchmarks();
+    PickingScene::RegisterBenchmarks();
+    JobSystem::RegisterBenchmarks();
+    BrightForge::IoBackend::RegisterBenchmarks();
+    Checksum::RegisterBenchmarks();
+    FbxWriter::RegisterBenchmarks(sampleDir);
+    TextureOps::RegisterBenchmarks();
+    PngCodec::RegisterBenchmarks();
+    DynamicResolution::RegisterBenchmarks();
+}
+
+int main(int argc, char** argv) {
+    bool runBenchmarks = false;
+    std::string sampleDir;
+    std::string baselinePath;
+    std::string saveBaselinePath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--bench") {
+            runBenchmarks = true;
+        } else if (arg == "--samples" && hasValue) {
+            sampleDir = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            baselinePath = argv[++i];
+        } else if (arg == "--save-baseline" && hasValue) {
+            saveBaselinePath = argv[++i];
+        } else {
+            std::cerr << "Usage: engine_tests [--bench] [--samples <dir>] [--baseline <file>] [--save-baseline <file>]\n";
+            return 2;
+        }
+    }
+
+    TestManagerNew& tests = TestManagerNew::Instance();
+    RegisterEngineTests();
+    bool ok = tests.RunAll();
+
+    if (runBenchmarks) {
+        RegisterEngineBenchmarks(sampleDir);
+        ok = tests.RunBenchmarks(baselinePath) && ok;
+        if (!saveBaselinePath.empty()) {
+            ok = tests.SaveBenchmarkBaseline(saveBaselinePath) && ok;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+/**
+ * bf-convert - Convert glTF/GLB assets to binary FBX 7.4 for Unreal
+ * @author Marcus Daley
+ * @date April 2026
+ *
+ * Build: g++ -std=c++17 -O2 -pthread src/tools/bf-convert.cpp -o bf-convert
+ *
+ *   bf-convert <input.glb> <output.fbx> [options]
+ *   bf-convert <input-dir> <output-dir> [options]     (every .glb/.gltf, converted concurrently)
+ *
+ *   --scale <factor>            Position scale (default 100: metres -> centimetres)
+ *   --high                      Smaller arrays, slower export
+ *   --compare-python <script>   Also run the inputs through python/fbx_converter.py and
+ *                               report both timings (Python timed in-process, as the server runs it)
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include "../rendering/FbxWriter.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Job {
+    std::string input;
+    std::string output;
+};
+
+int Usage() {
+    std::cerr << "usage:\n"
+              << "  bf-convert <input.glb> <output.fbx> [--scale <factor>] [--high] [--compare-python <script>]\n"
+              << "  bf-convert <input-dir> <output-dir> [--scale <factor>] [--high] [--compare-python <script>]\n";
+    return 2;
+}
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string Quote(const std::string& text) {
+    return "\"" + text + "\"";
+}
+
+bool CollectJobs(const std::string& input, const std::string& output, std::vector<Job>& jobs) {
+    std::error_code ec;
+    if (!fs::is_directory(input, ec)) {
+        jobs.push_back({ input, output });
+        return true;
+    }
+
+    for (auto it = fs::recursive_directory_iterator(input, ec); !ec && it != fs::recursive_directory_iterator();
+         it.increment(ec)) {
+        if (!it->is_regular_file(ec) || !GltfLoader::IsGltfPath(it->path().string())) {
+            continue;
+        }
+        fs::path target = fs::path(output) / fs::relative(it->path(), input, ec);
+        target.replace_extension(".fbx");
+        jobs.push_back({ it->path().string(), target.string() });
+    }
+    std::sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) { return a.input < b.input; });
+    return !ec;
+}
+
+// One Python process converts every input back to back, so interpreter start-up and
+// backend detection are excluded just as they are for the long-running server
+bool RunPython(const std::string& script, const std::vector<Job>& jobs, double& seconds, size_t& converted,
+               std::string& backend) {
+    std::error_code ec;
+    fs::path scratch = fs::temp_directory_path(ec) / "bf-convert-python";
+    fs::create_directories(scratch, ec);
+
+    fs::path list = scratch / "inputs.txt";
+    fs::path driver = scratch / "driver.py";
+    fs::path result = scratch / "result.txt";
+    {
+        std::ofstream out(list);
+        for (const Job& job : jobs) {
+            out << fs::absolute(job.input, ec).string() << "\n";
+        }
+    }
+    {
+        std::ofstream out(driver);
+        out << "import os, sys, time\n"
+               "sys.path.insert(0, os.path.dirname(os.path.abspath(sys.argv[1])))\n"
+               "from fbx_converter import fbx_converter\n"
+               "paths = [line.rstrip('\\n') for line in open(sys.argv[2]) if line.strip()]\n"
+               "ok = 0\n"
+               "start = time.perf_counter()\n"
+               "for i, path in enumerate(paths):\n"
+               "    r = fbx_converter.convert_glb_to_fbx(path, os.path.join(sys.argv[3], f'{i}.fbx'))\n"
+               "    ok += 1 if r['success'] else 0\n"
+               "elapsed = time.perf_counter() - start\n"
+               "open(sys.argv[4], 'w').write(f'{ok} {elapsed} {fbx_converter.backend}')\n";
+    }
+
+    fs::remove(result, ec);
+    std::string command = "python3 " + Quote(driver.string()) + " " + Quote(script) + " " + Quote(list.string()) +
+                          " " + Quote(scratch.string()) + " " + Quote(result.string());
+    if (std::system(command.c_str()) != 0) {
+        return false;
+    }
+
+    std::ifstream in(result);
+    return static_cast<bool>(in >> converted >> seconds >> backend);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        return Usage();
+    }
+
+    FbxWriteOptions options;
+    std::string pythonScript;
+    for (int i = 3; i < argc; ++i) {
+        std::string flag = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (flag == "--high") {
+            options.level = BrightForge::DeflateLevel::HIGH;
+        } else if (flag == "--scale" && hasValue) {
+            char* end = nullptr;
+            options.scaleFactor = std::strtod(argv[++i], &end);
+            if (*end != '\0' || !(options.scaleFactor > 0.0)) {
+                return Usage();
+            }
+        } else if (flag == "--compare-python" && hasValue) {
+            pythonScript = argv[++i];
+        } else {
+            return Usage();
+        }
+    }
+
+    std::vector<Job> jobs;
+    if (!CollectJobs(argv[1], argv[2], jobs) || jobs.empty()) {
+        std::cerr << "bf-convert: no glTF/GLB inputs under " << argv[1] << "\n";
+        return 1;
+    }
+
+    // Files convert concurrently; each conversion also fans its arrays out over the pool
+    std::mutex printMutex;
+    std::atomic<size_t> failures{ 0 };
+    auto start = std::chrono::steady_clock::now();
+    JobSystem::Instance().ParallelFor(jobs.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Job& job = jobs[i];
+            std::error_code ec;
+            fs::path parent = fs::path(job.output).parent_path();
+            if (!parent.empty()) {
+                fs::create_directories(parent, ec);
+            }
+
+            auto fileStart = std::chrono::steady_clock::now();
+            FbxWriteStats stats;
+            std::string error;
+            bool ok = FbxWriter::ConvertGltf(job.input, job.output, options, &stats, &error);
+            double ms = Seconds(fileStart) * 1000.0;
+
+            std::ostringstream line;
+            if (ok) {
+                line << job.input << " -> " << job.output << ": " << stats.models << " models, " << stats.triangles
+                     << " tris, " << stats.fileBytes << " bytes (arrays " << stats.arrayBytes << " -> "
+                     << stats.packedArrayBytes << ") in " << ms << " ms\n";
+            } else {
+                failures.fetch_add(1);
+                line << "bf-convert: " << job.input << ": " << error << "\n";
+            }
+            std::lock_guard<std::mutex> lock(printMutex);
+            (ok ? std::cout : std::cerr) << line.str();
+        }
+    });
+    double nativeSeconds = Seconds(start);
+
+    size_t converted = jobs.size() - failures.load();
+    std::cout << converted << " of " << jobs.size() << " converted in " << nativeSeconds << " s\n";
+
+    if (!pythonScript.empty()) {
+        double pythonSeconds = 0.0;
+        size_t pythonConverted = 0;
+        std::string backend;
+        if (!RunPython(pythonScript, jobs, pythonSeconds, pythonConverted, backend)) {
+            std::cerr << "bf-convert: python comparison failed to run " << pythonScript << "\n";
+            return 1;
+        }
+        std::cout << "python (" << backend << "): " << pythonConverted << " of " << jobs.size() << " converted in "
+                  << pythonSeconds << " s";
+        if (pythonConverted > 0 && nativeSeconds > 0.0) {
+            std::cout << " - native is " << pythonSeconds / nativeSeconds << "x faster";
+        }
+        std::cout << "\n";
+    }
+
+    return failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+/**
+ * bf-decimate - Quadric decimation of glTF/GLB assets to one or more face budgets
+ * @author Marcus Daley
+ * @date April 2026
+ *
+ * Build: g++ -std=c++17 -O2 -pthread src/tools/bf-decimate.cpp -o bf-decimate
+ *
+ *   bf-decimate <input.glb> <output-dir> [options]
+ *
+ *   --targets <n,n,...>     Face budgets (default: every preset)
+ *   --preset <name,...>     mobile, web, desktop, unreal (combines with --targets)
+ *   --lock-borders          Keep open-boundary vertices in place
+ *   --max-error <fraction>  Stop early past this error (fraction of the bounds)
+ *
+ * Writes <output-dir>/<stem>_<preset|faces>.glb per budget and prints one JSON report
+ * on stdout, which src/forge3d/pipeline/stages/optimize-mesh.js reads.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include "../rendering/GltfLoader.h"
+#include "../rendering/MeshDecimator.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Target {
+    std::string label;          // Preset name or the face count
+    uint32_t faces = 0;
+};
+
+int Usage() {
+    std::cerr << "usage: bf-decimate <input.glb> <output-dir> [--targets <n,n,...>] [--preset <name,...>]\n"
+              << "                   [--lock-borders] [--max-error <fraction>]\n";
+    return 2;
+}
+
+std::vector<std::string> SplitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+void AddTarget(std::vector<Target>& targets, const std::string& label, uint32_t faces) {
+    for (const Target& target : targets) {
+        if (target.faces == faces) {
+            return;
+        }
+    }
+    targets.push_back({ label, faces });
+}
+
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        return Usage();
+    }
+
+    MeshDecimateOptions options;
+    std::vector<Target> targets;
+    for (int i = 3; i < argc; ++i) {
+        std::string flag = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (flag == "--lock-borders") {
+            options.lockBorders = true;
+        } else if (flag == "--targets" && hasValue) {
+            for (const std::string& item : SplitList(argv[++i])) {
+                char* end = nullptr;
+                unsigned long faces = std::strtoul(item.c_str(), &end, 10);
+                if (*end != '\0' || faces == 0 || faces > UINT32_MAX) {
+                    return Usage();
+                }
+                AddTarget(targets, item, static_cast<uint32_t>(faces));
+            }
+        } else if (flag == "--preset" && hasValue) {
+            for (const std::string& name : SplitList(argv[++i])) {
+                uint32_t faces = MeshDecimator::PresetTriangles(name);
+                if (faces == 0) {
+                    std::cerr << "bf-decimate: unknown preset " << name << "\n";
+                    return 2;
+                }
+                AddTarget(targets, name, faces);
+            }
+        } else if (flag == "--max-error" && hasValue) {
+            char* end = nullptr;
+            options.maxError = std::strtof(argv[++i], &end);
+            if (*end != '\0' || !(options.maxError >= 0.0f)) {
+                return Usage();
+            }
+        } else {
+            return Usage();
+        }
+    }
+    if (targets.empty()) {
+        for (const MeshDecimatePreset& preset : MESH_DECIMATE_PRESETS) {
+            AddTarget(targets, preset.name, preset.triangles);
+        }
+    }
+
+    // Preset budgets that were asked for by number still get their preset name
+    for (Target& target : targets) {
+        for (const MeshDecimatePreset& preset : MESH_DECIMATE_PRESETS) {
+            if (target.faces == preset.triangles) {
+                target.label = preset.name;
+            }
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::string input = argv[1];
+    GltfDocument doc;
+    std::vector<SoftwareMesh> primitives;
+    std::vector<GltfPrimitiveRef> sources;
+    std::string error;
+    if (!GltfLoader::Parse(input, doc, &error) || !GltfLoader::DecodePrimitives(doc, primitives, &sources)) {
+        std::cerr << "bf-decimate: " << input << ": " << (error.empty() ? "primitives failed to decode" : error) << "\n";
+        return 1;
+    }
+
+    size_t originalFaces = 0;
+    for (const SoftwareMesh& mesh : primitives) {
+        originalFaces += mesh.indices.size() / 3;
+    }
+    if (originalFaces == 0) {
+        std::cerr << "bf-decimate: " << input << ": no triangles\n";
+        return 1;
+    }
+
+    // Each primitive gets its share of every budget and walks its own chain; the
+    // chains are independent, so primitives decimate in parallel
+    std::vector<std::vector<MeshDecimateLevel>> chains(primitives.size());
+    Parallel::For(primitives.size(), [&](size_t p) {
+        double share = static_cast<double>(primitives[p].indices.size() / 3) / static_cast<double>(originalFaces);
+        std::vector<uint32_t> budgets;
+        for (const Target& target : targets) {
+            budgets.push_back(static_cast<uint32_t>(std::floor(target.faces * share)));
+        }
+        MeshDecimateOptions primitiveOptions = options;
+        primitiveOptions.workerCount = 1;
+        chains[p] = MeshDecimator::DecimateChain(primitives[p], budgets, primitiveOptions);
+    });
+
+    std::vector<GltfMaterial> materials = doc.materials;
+    std::error_code ec;
+    fs::create_directories(argv[2], ec);
+    std::string stem = fs::path(input).stem().string();
+
+    std::ostringstream report;
+    report << "{\"input\":" << JsonBinding::StringLiteral(input) << ",\"originalFaces\":" << originalFaces
+           << ",\"levels\":[";
+    bool failed = false;
+    bool first = true;
+    for (size_t t = 0; t < targets.size(); ++t) {
+        std::vector<GltfExportMesh> meshes;
+        size_t faces = 0;
+        float levelError = 0.0f;
+        for (size_t p = 0; p < primitives.size(); ++p) {
+            const MeshDecimateLevel& level = chains[p][t];
+            if (level.mesh.indices.empty()) {
+                continue;
+            }
+            const GltfMesh& source = doc.meshes[sources[p].mesh];
+            GltfExportMesh mesh;
+            mesh.name = source.name.empty() ? "Mesh_" + std::to_string(sources[p].mesh) : source.name;
+            if (source.primitives.size() > 1) {
+                mesh.name += "_" + std::to_string(sources[p].primitive);
+            }
+            mesh.mesh = &level.mesh;
+            int32_t material = source.primitives[sources[p].primitive].material;
+            mesh.material = material >= 0 && static_cast<size_t>(material) < materials.size() ? material : -1;
+            meshes.push_back(std::move(mesh));
+            faces += level.mesh.indices.size() / 3;
+            levelError = std::max(levelError, level.error);
+        }
+
+        std::string path = (fs::path(argv[2]) / (stem + "_" + targets[t].label + ".glb")).string();
+        if (meshes.empty() || !GltfLoader::WriteGlb(path, meshes, materials, &error)) {
+            std::cerr << "bf-decimate: " << path << ": " << (meshes.empty() ? "nothing left to write" : error) << "\n";
+            failed = true;
+            continue;
+        }
+        report << (first ? "" : ",") << "{\"name\":" << JsonBinding::StringLiteral(targets[t].label)
+               << ",\"target\":" << targets[t].faces << ",\"faces\":" << faces << ",\"error\":" << levelError
+               << ",\"path\":" << JsonBinding::StringLiteral(path) << "}";
+        first = false;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report << "],\"seconds\":" << seconds << "}";
+    std::cout << report.str() << "\n";
+    return failed ? 1 : 0;
+}
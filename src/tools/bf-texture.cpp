@@ -0,0 +1,314 @@
+/**
+ * bf-texture - Texture channel split, pack and swizzle for the export pipeline
+ * @author Marcus Daley
+ * @date April 2026
+ *
+ * Build: g++ -std=c++17 -O2 -pthread src/tools/bf-texture.cpp -o bf-texture
+ *
+ *   bf-texture split <png|dir>... -o <dir> [--names ao,roughness,metallic] [--all]
+ *   bf-texture pack <out.png> <in.png[:r|g|b|a] | 0-255>...
+ *   bf-texture swizzle <in.png> <out.png> <pattern>        (e.g. bgra, rgb1, g)
+ *
+ *   --level fast|high|store   Deflate effort for every written PNG (default fast)
+ *
+ * split writes <dir>/<stem>_<name>.png, one gray PNG per name, channel by channel
+ * (gray sources count as RGB, as Pillow's convert('RGB') does). Directories are
+ * searched for ORM / metallic-roughness PNGs, or every PNG with --all. Inputs are
+ * processed concurrently; one JSON line per input goes to stdout in input order
+ * (python/material_extractor.py reads them). Exits 1 when any input fails.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include "../core/JsonBinding.h"
+#include "../rendering/PngCodec.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+int Usage() {
+    std::cerr << "usage: bf-texture split <png|dir>... -o <dir> [--names ao,roughness,metallic] [--all]\n"
+              << "       bf-texture pack <out.png> <in.png[:r|g|b|a] | 0-255>...\n"
+              << "       bf-texture swizzle <in.png> <out.png> <pattern>\n"
+              << "       (all commands) [--level fast|high|store]\n";
+    return 2;
+}
+
+
+std::vector<std::string> SplitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+std::string Lower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+// Packed occlusion/roughness/metallic maps, by the names exporters give them
+bool IsOrmName(const fs::path& path) {
+    std::string stem = Lower(path.stem().string());
+    if (stem.find("metallic") != std::string::npos || stem.find("occlusionroughness") != std::string::npos) {
+        return true;
+    }
+    // "orm" only as a whole word, so "normal" does not match
+    for (size_t at = stem.find("orm"); at != std::string::npos; at = stem.find("orm", at + 1)) {
+        bool startOk = at == 0 || !std::isalnum(static_cast<unsigned char>(stem[at - 1]));
+        bool endOk = at + 3 == stem.size() || !std::isalnum(static_cast<unsigned char>(stem[at + 3]));
+        if (startOk && endOk) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CollectInputs(const std::string& input, bool all, std::vector<std::string>& files) {
+    std::error_code ec;
+    if (!fs::is_directory(input, ec)) {
+        files.push_back(input);
+        return;
+    }
+
+    std::vector<std::string> found;
+    for (auto it = fs::recursive_directory_iterator(input, ec); !ec && it != fs::recursive_directory_iterator();
+         it.increment(ec)) {
+        if (it->is_regular_file(ec) && Lower(it->path().extension().string()) == ".png" &&
+            (all || IsOrmName(it->path()))) {
+            found.push_back(it->path().string());
+        }
+    }
+    std::sort(found.begin(), found.end());
+    files.insert(files.end(), found.begin(), found.end());
+}
+
+std::string SplitOne(const std::string& input, const std::string& outputDir, const std::vector<std::string>& names,
+                     const PngWriteOptions& options, bool& ok) {
+    auto start = std::chrono::steady_clock::now();
+    std::string error;
+    TextureImage image;
+    ok = PngCodec::Load(input, image, &error, options.workerCount);
+    if (ok && image.channels < 3) {
+        ok = TextureOps::Swizzle(image, "rrr", image, &error, options.workerCount);
+    }
+    if (ok && names.size() > image.channels) {
+        ok = false;
+        error = "texture has " + std::to_string(image.channels) + " channels, " + std::to_string(names.size()) +
+                " names given";
+    }
+    if (!ok) {
+        return "{\"input\":" + JsonBinding::StringLiteral(input) + ",\"error\":" +
+               JsonBinding::StringLiteral(error) + "}";
+    }
+
+    std::vector<TextureImage> planes = TextureOps::Split(image, options.workerCount);
+    std::string stem = fs::path(input).stem().string();
+    std::string outputs;
+    for (size_t c = 0; c < names.size() && ok; ++c) {
+        std::string path = (fs::path(outputDir) / (stem + "_" + names[c] + ".png")).string();
+        ok = PngCodec::Save(planes[c], path, options, &error);
+        outputs += (c == 0 ? "" : ",") + JsonBinding::StringLiteral(names[c]) + ":" + JsonBinding::StringLiteral(path);
+    }
+    if (!ok) {
+        return "{\"input\":" + JsonBinding::StringLiteral(input) + ",\"error\":" +
+               JsonBinding::StringLiteral(error) + "}";
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::ostringstream line;
+    line << "{\"input\":" << JsonBinding::StringLiteral(input) << ",\"outputs\":{" << outputs << "}"
+         << ",\"width\":" << image.width << ",\"height\":" << image.height << ",\"ms\":" << ms << "}";
+    return line.str();
+}
+
+int RunSplit(const std::vector<std::string>& args, const PngWriteOptions& options) {
+    std::vector<std::string> inputs;
+    std::vector<std::string> names = { "ao", "roughness", "metallic" };
+    std::string outputDir;
+    bool all = false;
+    for (size_t i = 0; i < args.size(); ++i) {
+        bool hasValue = i + 1 < args.size();
+        if (args[i] == "-o" && hasValue) {
+            outputDir = args[++i];
+        } else if (args[i] == "--names" && hasValue) {
+            names = SplitList(args[++i]);
+        } else if (args[i] == "--all") {
+            all = true;
+        } else if (args[i].rfind("--", 0) == 0) {
+            return Usage();
+        } else {
+            inputs.push_back(args[i]);
+        }
+    }
+    if (inputs.empty() || outputDir.empty() || names.empty() || names.size() > 4) {
+        return Usage();
+    }
+
+    std::vector<std::string> files;
+    for (const std::string& input : inputs) {
+        CollectInputs(input, all, files);
+    }
+    std::error_code ec;
+    fs::create_directories(outputDir, ec);
+
+    // Textures split concurrently; each split also fans out over the pool
+    std::vector<std::string> lines(files.size());
+    std::atomic<size_t> failed{ 0 };
+    auto start = std::chrono::steady_clock::now();
+    JobSystem::Instance().ParallelFor(files.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            bool ok = false;
+            lines[i] = SplitOne(files[i], outputDir, names, options, ok);
+            if (!ok) {
+                failed.fetch_add(1);
+            }
+        }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const std::string& line : lines) {
+        std::cout << line << "\n";
+    }
+    std::cerr << "bf-texture: split " << files.size() - failed.load() << " of " << files.size() << " textures in "
+              << seconds << " s\n";
+    return failed.load() == 0 ? 0 : 1;
+}
+
+int RunPack(const std::vector<std::string>& args, const PngWriteOptions& options) {
+    if (args.size() < 2 || args.size() > 5) {
+        return Usage();
+    }
+
+    // Each distinct file loads once, however many channels it feeds
+    std::vector<std::string> paths;
+    std::vector<TextureImage> images;
+    std::vector<std::pair<int, uint32_t>> sources;     // (image index or -1, channel or constant)
+    for (size_t i = 1; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        char* end = nullptr;
+        unsigned long constant = std::strtoul(arg.c_str(), &end, 10);
+        if (!arg.empty() && *end == '\0' && constant <= 255) {
+            sources.push_back({ -1, static_cast<uint32_t>(constant) });
+            continue;
+        }
+
+        std::string path = arg;
+        uint32_t channel = 0;
+        size_t colon = arg.rfind(':');
+        if (colon != std::string::npos && colon + 2 == arg.size() &&
+            std::string("rgba").find(arg[colon + 1]) != std::string::npos) {
+            path = arg.substr(0, colon);
+            channel = static_cast<uint32_t>(std::string("rgba").find(arg[colon + 1]));
+        }
+        auto found = std::find(paths.begin(), paths.end(), path);
+        if (found == paths.end()) {
+            paths.push_back(path);
+            found = paths.end() - 1;
+        }
+        sources.push_back({ static_cast<int>(found - paths.begin()), channel });
+    }
+
+    std::string error;
+    images.resize(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (!PngCodec::Load(paths[i], images[i], &error, options.workerCount)) {
+            std::cerr << "bf-texture: " << paths[i] << ": " << error << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<PackInput> inputs;
+    for (const auto& source : sources) {
+        PackInput input;
+        if (source.first >= 0) {
+            input.image = &images[static_cast<size_t>(source.first)];
+            input.channel = source.second;
+        } else {
+            input.constant = static_cast<uint8_t>(source.second);
+        }
+        inputs.push_back(input);
+    }
+
+    TextureImage packed;
+    if (!TextureOps::Pack(inputs, packed, &error, options.workerCount) ||
+        !PngCodec::Save(packed, args[0], options, &error)) {
+        std::cerr << "bf-texture: " << args[0] << ": " << error << "\n";
+        return 1;
+    }
+    std::cout << "{\"output\":" << JsonBinding::StringLiteral(args[0]) << ",\"width\":" << packed.width
+              << ",\"height\":" << packed.height << ",\"channels\":" << packed.channels << "}\n";
+    return 0;
+}
+
+int RunSwizzle(const std::vector<std::string>& args, const PngWriteOptions& options) {
+    if (args.size() != 3) {
+        return Usage();
+    }
+    std::string error;
+    TextureImage image;
+    if (!PngCodec::Load(args[0], image, &error, options.workerCount) ||
+        !TextureOps::Swizzle(image, args[2], image, &error, options.workerCount) ||
+        !PngCodec::Save(image, args[1], options, &error)) {
+        std::cerr << "bf-texture: " << args[0] << ": " << error << "\n";
+        return 1;
+    }
+    std::cout << "{\"output\":" << JsonBinding::StringLiteral(args[1]) << ",\"width\":" << image.width
+              << ",\"height\":" << image.height << ",\"channels\":" << image.channels << "}\n";
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return Usage();
+    }
+
+    PngWriteOptions options;
+    std::vector<std::string> args;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--level" && i + 1 < argc) {
+            std::string level = argv[++i];
+            if (level == "fast") {
+                options.level = BrightForge::DeflateLevel::FAST;
+            } else if (level == "high") {
+                options.level = BrightForge::DeflateLevel::HIGH;
+            } else if (level == "store") {
+                options.level = BrightForge::DeflateLevel::STORE;
+            } else {
+                return Usage();
+            }
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    std::string command = argv[1];
+    if (command == "split") {
+        return RunSplit(args, options);
+    }
+    if (command == "pack") {
+        return RunPack(args, options);
+    }
+    if (command == "swizzle") {
+        return RunSwizzle(args, options);
+    }
+    return Usage();
+}
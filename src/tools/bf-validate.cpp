@@ -0,0 +1,127 @@
+/**
+ * bf-validate - Validate glTF/GLB meshes: topology, NaNs, UV range, UV overlap, texel density
+ * @author Marcus Daley
+ * @date April 2026
+ *
+ * Build: g++ -std=c++17 -O2 -pthread src/tools/bf-validate.cpp -o bf-validate
+ *
+ *   bf-validate <file|dir>... [options]     (directories are searched for .glb/.gltf)
+ *
+ *   --texture-size <n>      Texture edge length texel density is quoted for (default 1024)
+ *   --uv-grid <n>           UV overlap raster resolution (default 256)
+ *   --min-bytes <n>         Reject smaller files (default 100)
+ *
+ * Prints one JSON report per line on stdout, in input order (the keys match
+ * python/mesh_utils.py validate_mesh()), and a throughput summary on stderr.
+ * Exits 1 when any file is invalid.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include "../rendering/MeshValidator.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+int Usage() {
+    std::cerr << "usage: bf-validate <file|dir>... [--texture-size <n>] [--uv-grid <n>] [--min-bytes <n>]\n";
+    return 2;
+}
+
+bool ParseCount(const char* text, uint64_t limit, uint64_t& out) {
+    char* end = nullptr;
+    unsigned long long value = std::strtoull(text, &end, 10);
+    if (*end != '\0' || value == 0 || value > limit) {
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+void CollectInputs(const std::string& input, std::vector<std::string>& files) {
+    std::error_code ec;
+    if (!fs::is_directory(input, ec)) {
+        // Missing files still get a report saying so
+        files.push_back(input);
+        return;
+    }
+
+    std::vector<std::string> found;
+    for (auto it = fs::recursive_directory_iterator(input, ec); !ec && it != fs::recursive_directory_iterator();
+         it.increment(ec)) {
+        if (it->is_regular_file(ec) && GltfLoader::IsGltfPath(it->path().string())) {
+            found.push_back(it->path().string());
+        }
+    }
+    std::sort(found.begin(), found.end());
+    files.insert(files.end(), found.begin(), found.end());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MeshValidationOptions options;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        bool hasValue = i + 1 < argc;
+        uint64_t value = 0;
+        if (flag == "--texture-size" && hasValue) {
+            if (!ParseCount(argv[++i], 1u << 16, value)) {
+                return Usage();
+            }
+            options.textureSize = static_cast<uint32_t>(value);
+        } else if (flag == "--uv-grid" && hasValue) {
+            if (!ParseCount(argv[++i], 8192, value)) {
+                return Usage();
+            }
+            options.uvGridSize = static_cast<uint32_t>(value);
+        } else if (flag == "--min-bytes" && hasValue) {
+            if (!ParseCount(argv[++i], UINT64_MAX, value)) {
+                return Usage();
+            }
+            options.minFileBytes = value;
+        } else if (flag.rfind("--", 0) == 0) {
+            return Usage();
+        } else {
+            CollectInputs(flag, files);
+        }
+    }
+    if (files.empty()) {
+        return Usage();
+    }
+
+    // Files validate concurrently and each validation also fans out over the pool;
+    // lines are printed in input order so callers can zip them with their inputs
+    std::vector<std::string> lines(files.size());
+    std::atomic<size_t> invalid{ 0 };
+    auto start = std::chrono::steady_clock::now();
+    JobSystem::Instance().ParallelFor(files.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            MeshValidationReport report = MeshValidator::ValidateFile(files[i], options);
+            if (!report.valid) {
+                invalid.fetch_add(1);
+            }
+            lines[i] = MeshValidator::ToJson(report);
+        }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const std::string& line : lines) {
+        std::cout << line << "\n";
+    }
+    std::cerr << "bf-validate: " << files.size() - invalid.load() << " of " << files.size() << " valid in "
+              << seconds << " s";
+    if (seconds > 0.0) {
+        std::cerr << " (" << static_cast<uint64_t>(files.size() * 60.0 / seconds) << " files/min)";
+    }
+    std::cerr << "\n";
+    return invalid.load() == 0 ? 0 : 1;
+}
@@ -7,27 +7,34 @@
 
 #include "UITypes.h"
 #include "../core/EventBus.h"
+#include "../core/MemoryTracker.h"
+#include "../core/StringInterner.h"
 #include <string>
 #include <vector>
 
 namespace BrightForge {
 namespace UI {
 
-// Asset information structure for display
+// Asset information structure for display. Strings are interned ids, so result
+// lists of 500k items copy as plain integers; resolve text only when drawing or publishing.
 struct AssetInfo {
-    std::string path;
-    std::string name;
-    std::string format;
+    PathId path;
+    StringId name;
+    StringId format;
     size_t vertexCount;
     size_t faceCount;
     size_t fileSizeBytes;
-    std::string thumbnailPath;
+    PathId thumbnailPath;
     bool hasErrors;
 
     AssetInfo()
-        : vertexCount(0)
+        : path(INVALID_PATH_ID)
+        , name(INVALID_STRING_ID)
+        , format(INVALID_STRING_ID)
+        , vertexCount(0)
         , faceCount(0)
         , fileSizeBytes(0)
+        , thumbnailPath(INVALID_PATH_ID)
         , hasErrors(false)
     {}
 };
@@ -96,6 +103,7 @@ private:
 
     // Items and selection
     std::vector<AssetInfo> m_items;
+    size_t m_itemBytes; // Reported to MemoryTracker under UI
     int m_selectedIndex;
     int m_hoveredIndex;
 
@@ -152,6 +160,7 @@ inline FileList::FileList(Core::EventBus& eventBus, const Rect& bounds, DisplayM
     : m_eventBus(eventBus)
     , m_bounds(bounds)
     , m_displayMode(mode)
+    , m_itemBytes(0)
     , m_selectedIndex(-1)
     , m_hoveredIndex(-1)
     , m_itemWidth(GRID_ITEM_WIDTH)
@@ -172,6 +181,7 @@ inline FileList::FileList(Core::EventBus& eventBus, const Rect& bounds, DisplayM
 }
 
 inline FileList::~FileList() {
+    MemoryTracker::Instance().Release(MemoryTag::UI, m_itemBytes);
     m_eventBus.Unsubscribe("search.query", m_searchQuerySubscription);
     m_eventBus.Unsubscribe("index.updated", m_indexUpdatedSubscription);
 }
@@ -179,6 +189,12 @@ inline FileList::~FileList() {
 inline void FileList::SetItems(const std::vector<AssetInfo>& items) {
     m_items = items;
 
+    // Item copies are the bulk of UI memory on large projects (their text is interned)
+    size_t itemBytes = m_items.capacity() * sizeof(AssetInfo);
+    MemoryTracker::Instance().Release(MemoryTag::UI, m_itemBytes);
+    MemoryTracker::Instance().Add(MemoryTag::UI, itemBytes);
+    m_itemBytes = itemBytes;
+
     // Preserve selection if item still exists
     if (m_selectedIndex >= static_cast<int>(m_items.size())) {
         m_selectedIndex = -1;
@@ -244,14 +260,15 @@ inline void FileList::OnDoubleClick(int index) {
     const AssetInfo& item = m_items[index];
 
     // Publish asset selection event for viewport to load
+    const StringInterner& strings = StringInterner::Instance();
     Core::EventData data;
-    data.SetString("path", item.path);
-    data.SetString("name", item.name);
-    data.SetString("format", item.format);
+    data.SetString("path", PathInterner::Instance().Resolve(item.path));
+    data.SetString("name", strings.Str(item.name));
+    data.SetString("format", strings.Str(item.format));
     m_eventBus.Publish("asset.selected", data);
 
     Core::EventData logData;
-    logData.SetString("message", "Asset selected: " + item.name);
+    logData.SetString("message", "Asset selected: " + strings.Str(item.name));
     logData.SetString("level", "INFO");
     m_eventBus.Publish("log.message", logData);
 }
@@ -428,7 +445,7 @@ inline void FileList::HandleContextMenuAction(ContextMenuAction action, int item
     const AssetInfo& item = m_items[itemIndex];
 
     Core::EventData data;
-    data.SetString("path", item.path);
+    data.SetString("path", PathInterner::Instance().Resolve(item.path));
     data.SetInt("itemIndex", itemIndex);
 
     switch (action) {
@@ -459,10 +476,11 @@ inline void FileList::HandleContextMenuAction(ContextMenuAction action, int item
 }
 
 inline void FileList::PublishSelectionEvent(const AssetInfo& item) {
+    const StringInterner& strings = StringInterner::Instance();
     Core::EventData data;
-    data.SetString("path", item.path);
-    data.SetString("name", item.name);
-    data.SetString("format", item.format);
+    data.SetString("path", PathInterner::Instance().Resolve(item.path));
+    data.SetString("name", strings.Str(item.name));
+    data.SetString("format", strings.Str(item.format));
     data.SetInt("vertexCount", static_cast<int>(item.vertexCount));
     data.SetInt("faceCount", static_cast<int>(item.faceCount));
     m_eventBus.Publish("file.selected", data);
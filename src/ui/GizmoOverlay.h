@@ -7,6 +7,7 @@
 
 #include "UITypes.h"
 #include "../core/EventBus.h"
+#include "../rendering/PickingBvh.h"
 #include <string>
 
 namespace BrightForge {
@@ -102,10 +103,17 @@ private:
     bool m_snapEnabled;
     float m_snapIncrement;
 
+    // Viewport camera, mirrored from camera.updated / viewport.resized for hit testing
+    ::CameraData m_viewCamera;
+    float m_viewWidth;
+    float m_viewHeight;
+
     // Event subscriptions
     size_t m_assetSelectedSubscription;
     size_t m_toolChangedSubscription;
     size_t m_transformChangedSubscription;
+    size_t m_cameraUpdatedSubscription;
+    size_t m_viewportResizedSubscription;
 
     // Internal helpers
     GizmoAxis HitTestGizmo(float x, float y) const;
@@ -116,7 +124,10 @@ private:
     void OnAssetSelected(const Core::Event& event);
     void OnToolChanged(const Core::Event& event);
     void OnTransformChanged(const Core::Event& event);
+    void OnCameraUpdated(const Core::Event& event);
+    void OnViewportResized(const Core::Event& event);
     float SnapValue(float value) const;
+    static float DistanceToSegment(float px, float py, float ax, float ay, float bx, float by);
 
     // Visual feedback
     float m_highlightPulse;
@@ -130,6 +141,7 @@ private:
     static constexpr float TRANSLATE_SENSITIVITY = 0.1f;
     static constexpr float ROTATE_SENSITIVITY = 0.5f;
     static constexpr float HIGHLIGHT_PULSE_SPEED = 4.0f;
+    static constexpr int ROTATE_RING_SEGMENTS = 32;
 };
 
 // Implementation
@@ -146,6 +158,8 @@ inline GizmoOverlay::GizmoOverlay(Core::EventBus& eventBus)
     , m_gizmoSize(DEFAULT_GIZMO_SIZE)
     , m_snapEnabled(false)
     , m_snapIncrement(DEFAULT_SNAP_INCREMENT)
+    , m_viewWidth(0.0f)
+    , m_viewHeight(0.0f)
     , m_highlightPulse(0.0f)
 {
     // Subscribe to asset selection to attach gizmo
@@ -159,12 +173,21 @@ inline GizmoOverlay::GizmoOverlay(Core::EventBus& eventBus)
     // Subscribe to external transform changes
     m_transformChangedSubscription = m_eventBus.Subscribe("transform.changed",
         [this](const Core::Event& e) { OnTransformChanged(e); });
+
+    // Track the viewport camera so handles can be projected for hit testing
+    m_cameraUpdatedSubscription = m_eventBus.Subscribe("camera.updated",
+        [this](const Core::Event& e) { OnCameraUpdated(e); });
+
+    m_viewportResizedSubscription = m_eventBus.Subscribe("viewport.resized",
+        [this](const Core::Event& e) { OnViewportResized(e); });
 }
 
 inline GizmoOverlay::~GizmoOverlay() {
     m_eventBus.Unsubscribe("asset.selected", m_assetSelectedSubscription);
     m_eventBus.Unsubscribe("tool.changed", m_toolChangedSubscription);
     m_eventBus.Unsubscribe("transform.changed", m_transformChangedSubscription);
+    m_eventBus.Unsubscribe("camera.updated", m_cameraUpdatedSubscription);
+    m_eventBus.Unsubscribe("viewport.resized", m_viewportResizedSubscription);
 }
 
 inline void GizmoOverlay::SetMode(GizmoMode mode) {
@@ -284,13 +307,76 @@ inline void GizmoOverlay::Update(float deltaTime) {
 }
 
 inline GizmoAxis GizmoOverlay::HitTestGizmo(float x, float y) const {
-    // Simplified hit testing - production would use proper ray-gizmo intersection
-    // For now, use screen-space distance approximation
+    // Guard: viewport size not known yet
+    if (m_viewWidth <= 0.0f || m_viewHeight <= 0.0f) {
+        return GizmoAxis::NONE;
+    }
+
+    // Project the handles with the viewport camera and compare in screen space
+    PickCamera camera = PickCamera::FromCamera(m_viewCamera, m_viewWidth, m_viewHeight);
+    float origin[3] = { m_targetTransform.positionX, m_targetTransform.positionY, m_targetTransform.positionZ };
+    float originX, originY;
+    if (!camera.Project(origin, originX, originY)) {
+        return GizmoAxis::NONE;
+    }
 
-    // Would need viewport projection to convert 3D gizmo to 2D screen coords
-    // Returning placeholder logic
+    // Centre handle is the uniform scale
+    if (m_mode == GizmoMode::SCALE &&
+        std::hypot(x - originX, y - originY) <= HANDLE_SELECT_THRESHOLD) {
+        return GizmoAxis::XYZ;
+    }
+
+    static const GizmoAxis axes[3] = { GizmoAxis::X, GizmoAxis::Y, GizmoAxis::Z };
+    GizmoAxis bestAxis = GizmoAxis::NONE;
+    float bestDistance = HANDLE_SELECT_THRESHOLD;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        float distance = bestDistance + 1.0f;
+        if (m_mode == GizmoMode::ROTATE) {
+            // Ring of radius m_gizmoSize around the axis, as a closed polyline
+            int u = (axis + 1) % 3;
+            int v = (axis + 2) % 3;
+            float previousX = 0.0f, previousY = 0.0f;
+            bool previousVisible = false;
+            for (int i = 0; i <= ROTATE_RING_SEGMENTS; ++i) {
+                float angle = 6.28318530718f * i / ROTATE_RING_SEGMENTS;
+                float point[3] = { origin[0], origin[1], origin[2] };
+                point[u] += std::cos(angle) * m_gizmoSize;
+                point[v] += std::sin(angle) * m_gizmoSize;
+                float screenX, screenY;
+                bool visible = camera.Project(point, screenX, screenY);
+                if (visible && previousVisible) {
+                    distance = std::min(distance, DistanceToSegment(x, y, previousX, previousY, screenX, screenY));
+                }
+                previousX = screenX;
+                previousY = screenY;
+                previousVisible = visible;
+            }
+        } else {
+            float tip[3] = { origin[0], origin[1], origin[2] };
+            tip[axis] += m_gizmoSize;
+            float tipX, tipY;
+            if (camera.Project(tip, tipX, tipY)) {
+                distance = DistanceToSegment(x, y, originX, originY, tipX, tipY);
+            }
+        }
 
-    return GizmoAxis::NONE;
+        if (distance <= bestDistance) {
+            bestDistance = distance;
+            bestAxis = axes[axis];
+        }
+    }
+
+    return bestAxis;
+}
+
+inline float GizmoOverlay::DistanceToSegment(float px, float py, float ax, float ay, float bx, float by) {
+    float dx = bx - ax;
+    float dy = by - ay;
+    float lengthSquared = dx * dx + dy * dy;
+    float t = lengthSquared > 0.0f ? ((px - ax) * dx + (py - ay) * dy) / lengthSquared : 0.0f;
+    t = std::max(0.0f, std::min(1.0f, t));
+    return std::hypot(px - (ax + t * dx), py - (ay + t * dy));
 }
 
 inline void GizmoOverlay::ApplyTranslation(float deltaX, float deltaY) {
@@ -473,6 +559,27 @@ inline void GizmoOverlay::OnTransformChanged(const Core::Event& event) {
     m_targetTransform.scaleZ = data.GetFloat("scaleZ");
 }
 
+inline void GizmoOverlay::OnCameraUpdated(const Core::Event& event) {
+    const Core::EventData& data = event.GetData();
+
+    m_viewCamera.positionX = data.GetFloat("posX");
+    m_viewCamera.positionY = data.GetFloat("posY");
+    m_viewCamera.positionZ = data.GetFloat("posZ");
+    m_viewCamera.lookAtX = data.GetFloat("targetX");
+    m_viewCamera.lookAtY = data.GetFloat("targetY");
+    m_viewCamera.lookAtZ = data.GetFloat("targetZ");
+    m_viewCamera.upX = data.GetFloat("upX");
+    m_viewCamera.upY = data.GetFloat("upY");
+    m_viewCamera.upZ = data.GetFloat("upZ");
+    m_viewCamera.fovDegrees = data.GetFloat("fov");
+}
+
+inline void GizmoOverlay::OnViewportResized(const Core::Event& event) {
+    const Core::EventData& data = event.GetData();
+    m_viewWidth = data.GetFloat("width");
+    m_viewHeight = data.GetFloat("height");
+}
+
 inline float GizmoOverlay::SnapValue(float value) const {
     return std::round(value / m_snapIncrement) * m_snapIncrement;
 }
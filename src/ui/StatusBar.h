@@ -7,6 +7,7 @@
 
 #include "UITypes.h"
 #include "../core/EventBus.h"
+#include "../core/MemoryBudget.h"
 #include <string>
 #include <chrono>
 #include <queue>
@@ -84,6 +85,8 @@ public:
     void SetWidth(float width) { m_width = width; }
     Color GetMessageColor() const;
     float GetMessageOpacity() const;
+    std::string GetMemoryText() const;
+    BudgetState GetMemoryBudgetState() const { return m_memoryBudgetState; }
 
     // Update method
     void Update(float deltaTime);
@@ -98,6 +101,7 @@ private:
     int m_selectionCount;
     float m_fps;
     size_t m_memoryUsageBytes;
+    BudgetState m_memoryBudgetState;
 
     // Message queue
     std::queue<StatusMessage> m_messageQueue;
@@ -116,6 +120,7 @@ private:
     // Internal helpers
     void ProcessMessageQueue(float deltaTime);
     void UpdateMessageFade(float deltaTime);
+    void UpdateMemoryUsage();
     void OnToolChanged(const Core::Event& event);
     void OnRenderFrameEnd(const Core::Event& event);
     void OnFileError(const Core::Event& event);
@@ -141,6 +146,7 @@ inline StatusBar::StatusBar(Core::EventBus& eventBus, float height)
     , m_selectionCount(0)
     , m_fps(0.0f)
     , m_memoryUsageBytes(0)
+    , m_memoryBudgetState(BudgetState::OK)
     , m_hasMessage(false)
     , m_messageOpacity(0.0f)
 {
@@ -255,9 +261,29 @@ inline float StatusBar::GetMessageOpacity() const {
     return m_messageOpacity;
 }
 
+inline std::string StatusBar::GetMemoryText() const {
+    std::string text = FormatMemorySize(m_memoryUsageBytes);
+    return m_memoryBudgetState == BudgetState::OK ? text : text + " (over budget)";
+}
+
 inline void StatusBar::Update(float deltaTime) {
     ProcessMessageQueue(deltaTime);
     UpdateMessageFade(deltaTime);
+    UpdateMemoryUsage();
+}
+
+inline void StatusBar::UpdateMemoryUsage() {
+    SetMemoryUsage(MemoryTracker::Instance().TotalBytes());
+
+    // Announce escalations only; the DebugWindow "Memory" page has the breakdown
+    BudgetState state = MemoryBudget::Instance().WorstState();
+    if (state > m_memoryBudgetState) {
+        bool hard = state == BudgetState::HARD;
+        ShowMessage(std::string("Memory over ") + (hard ? "hard" : "soft") + " budget: " +
+                    FormatMemorySize(m_memoryUsageBytes),
+                    hard ? MessageSeverity::ERROR : MessageSeverity::WARNING, 0.0f);
+    }
+    m_memoryBudgetState = state;
 }
 
 inline void StatusBar::ProcessMessageQueue(float deltaTime) {
@@ -309,7 +335,6 @@ inline void StatusBar::OnToolChanged(const Core::Event& event) {
 inline void StatusBar::OnRenderFrameEnd(const Core::Event& event) {
     const Core::EventData& data = event.GetData();
     m_fps = data.GetFloat("fps");
-    m_memoryUsageBytes = static_cast<size_t>(data.GetInt("memoryUsage"));
 }
 
 inline void StatusBar::OnFileError(const Core::Event& event) {
@@ -7,7 +7,9 @@
 
 #include "UITypes.h"
 #include "../core/EventBus.h"
+#include "../rendering/PickingBvh.h"
 #include <string>
+#include <vector>
 
 namespace BrightForge {
 namespace UI {
@@ -99,6 +101,11 @@ public:
     void SetHighlightedObject(const std::string& objectId);
     void ClearHighlight();
 
+    // Scene picking (right click picks, right drag marquee-selects); null disables it
+    void SetPickingScene(PickingScene* scene) { m_pickingScene = scene; }
+    bool PickAt(float x, float y, PickHit& outHit);
+    std::vector<uint32_t> SelectInRect(float x0, float y0, float x1, float y1);
+
     // Update method
     void Update(float deltaTime);
 
@@ -129,6 +136,11 @@ private:
     std::string m_highlightedObjectId;
     bool m_hasHighlight;
 
+    // Picking (not owned)
+    PickingScene* m_pickingScene;
+    float m_selectStartX;
+    float m_selectStartY;
+
     // Event subscriptions
     size_t m_toolChangedSubscription;
     size_t m_assetSelectedSubscription;
@@ -141,6 +153,8 @@ private:
     void UpdateFlyCamera(float deltaTime);
     void PublishCameraUpdate();
     void PublishViewportResized();
+    void FinishSelection(float x, float y);
+    PickCamera MakePickCamera() const;
     void OnToolChanged(const Core::Event& event);
     void OnAssetSelected(const Core::Event& event);
     void OnRenderFrameEnd(const Core::Event& event);
@@ -161,6 +175,9 @@ private:
     static constexpr float FLY_SENSITIVITY = 5.0f;
     static constexpr float MIN_ZOOM_DISTANCE = 1.0f;
     static constexpr float MAX_ZOOM_DISTANCE = 100.0f;
+
+    // Right-drags shorter than this (pixels) count as a click
+    static constexpr float MARQUEE_MIN_DRAG = 4.0f;
 };
 
 // Implementation
@@ -180,6 +197,9 @@ inline Viewport::Viewport(Core::EventBus& eventBus, const Rect& bounds)
     , m_keyQ(false), m_keyE(false)
     , m_showFPS(true)
     , m_hasHighlight(false)
+    , m_pickingScene(nullptr)
+    , m_selectStartX(0.0f)
+    , m_selectStartY(0.0f)
 {
     // Subscribe to tool changes
     m_toolChangedSubscription = m_eventBus.Subscribe("tool.changed",
@@ -242,6 +262,8 @@ inline void Viewport::OnMouseDown(int button, float x, float y) {
         m_isPanning = true;
     } else if (button == MOUSE_RIGHT) {
         m_isSelecting = true;
+        m_selectStartX = x;
+        m_selectStartY = y;
 
         // Publish viewport click for object selection
         Core::EventData data;
@@ -260,6 +282,9 @@ inline void Viewport::OnMouseUp(int button, float x, float y) {
     } else if (button == MOUSE_MIDDLE) {
         m_isPanning = false;
     } else if (button == MOUSE_RIGHT) {
+        if (m_isSelecting) {
+            FinishSelection(x, y);
+        }
         m_isSelecting = false;
     }
 }
@@ -380,6 +405,25 @@ inline void Viewport::ClearHighlight() {
     m_eventBus.Publish("viewport.highlight", data);
 }
 
+inline bool Viewport::PickAt(float x, float y, PickHit& outHit) {
+    // Guard: no scene attached
+    if (!m_pickingScene) {
+        return false;
+    }
+    PickRay ray = MakePickCamera().RayThrough(x - m_bounds.x, y - m_bounds.y);
+    return m_pickingScene->Pick(ray, outHit);
+}
+
+inline std::vector<uint32_t> Viewport::SelectInRect(float x0, float y0, float x1, float y1) {
+    // Guard: no scene attached
+    if (!m_pickingScene) {
+        return {};
+    }
+    PickFrustum frustum = MakePickCamera().FrustumFor(x0 - m_bounds.x, y0 - m_bounds.y,
+                                                      x1 - m_bounds.x, y1 - m_bounds.y);
+    return m_pickingScene->QueryFrustum(frustum);
+}
+
 inline void Viewport::Update(float deltaTime) {
     // Update fly camera if in fly mode
     if (m_controlMode == CameraControlMode::FLY) {
@@ -480,6 +524,66 @@ inline void Viewport::PublishViewportResized() {
     m_eventBus.Publish("viewport.resized", data);
 }
 
+inline void Viewport::FinishSelection(float x, float y) {
+    // Guard: nothing to pick against
+    if (!m_pickingScene) {
+        return;
+    }
+
+    float dragX = x - m_selectStartX;
+    float dragY = y - m_selectStartY;
+    if (std::sqrt(dragX * dragX + dragY * dragY) >= MARQUEE_MIN_DRAG) {
+        std::vector<uint32_t> selected = SelectInRect(m_selectStartX, m_selectStartY, x, y);
+        std::string objectIds;
+        for (uint32_t instance : selected) {
+            if (!objectIds.empty()) {
+                objectIds += ",";
+            }
+            objectIds += m_pickingScene->ObjectId(instance);
+        }
+
+        Core::EventData data;
+        data.SetInt("count", static_cast<int>(selected.size()));
+        data.SetString("objectIds", objectIds);
+        m_eventBus.Publish("viewport.marquee_select", data);
+        return;
+    }
+
+    PickHit hit;
+    if (!PickAt(x, y, hit)) {
+        ClearHighlight();
+        return;
+    }
+
+    const std::string& objectId = m_pickingScene->ObjectId(hit.instance);
+    SetHighlightedObject(objectId);
+
+    Core::EventData data;
+    data.SetString("objectId", objectId);
+    data.SetInt("triangle", static_cast<int>(hit.triangle));
+    data.SetFloat("hitX", hit.position[0]);
+    data.SetFloat("hitY", hit.position[1]);
+    data.SetFloat("hitZ", hit.position[2]);
+    m_eventBus.Publish("viewport.pick", data);
+}
+
+inline PickCamera Viewport::MakePickCamera() const {
+    ::CameraData camera;
+    camera.positionX = m_camera.positionX;
+    camera.positionY = m_camera.positionY;
+    camera.positionZ = m_camera.positionZ;
+    camera.lookAtX = m_camera.targetX;
+    camera.lookAtY = m_camera.targetY;
+    camera.lookAtZ = m_camera.targetZ;
+    camera.upX = m_camera.upX;
+    camera.upY = m_camera.upY;
+    camera.upZ = m_camera.upZ;
+    camera.fovDegrees = m_camera.fov;
+    camera.nearPlane = m_camera.nearPlane;
+    camera.farPlane = m_camera.farPlane;
+    return PickCamera::FromCamera(camera, m_bounds.width, m_bounds.height);
+}
+
 inline void Viewport::OnToolChanged(const Core::Event& event) {
     const Core::EventData& data = event.GetData();
     int toolType = data.GetInt("tool");